@@ -114,6 +114,7 @@ QMAKE_INFO_PLIST = MediaElch.plist
 SOURCES += src/main.cpp \
     src/concerts/ConcertController.cpp \
     src/data/MediaInfoFile.cpp \
+    src/data/MediaInfoIndexer.cpp \
     src/data/MediaStatusColumn.cpp \
     src/data/RatingModel.cpp \
     src/export/CsvExport.cpp \
@@ -124,9 +125,15 @@ SOURCES += src/main.cpp \
     src/music/AllMusicId.cpp \
     src/music/MusicBrainzId.cpp \
     src/music/TheAudioDbId.cpp \
+    src/network/DownloadScheduler.cpp \
+    src/network/HostBackoff.cpp \
+    src/network/HttpCache.cpp \
     src/network/HttpStatusCodes.cpp \
+    src/network/ImagePreviewDownloader.cpp \
     src/network/NetworkRequest.cpp \
     src/network/NetworkManager.cpp \
+    src/network/RequestDispatcher.cpp \
+    src/scrapers/ScrapeScheduler.cpp \
     src/scrapers/ScraperError.cpp \
     src/scrapers/music/AllMusic.cpp \
     src/scrapers/music/Discogs.cpp \
@@ -144,6 +151,7 @@ SOURCES += src/main.cpp \
     src/concerts/ConcertModel.cpp \
     src/concerts/ConcertProxyModel.cpp \
     src/data/Database.cpp \
+    src/data/DatabaseRecord.cpp \
     src/data/ImageCache.cpp \
     src/data/ResumeTime.cpp \
     src/movies/Movie.cpp \
@@ -160,6 +168,7 @@ SOURCES += src/main.cpp \
     src/data/Subtitle.cpp \
     src/tv_shows/TvShow.cpp \
     src/tv_shows/TvShowEpisode.cpp \
+    src/tv_shows/TvShowDirectorySearcher.cpp \
     src/tv_shows/TvShowFileSearcher.cpp \
     src/ui/export/CsvExportDialog.cpp \
     src/ui/imports/ImportActions.cpp \
@@ -174,14 +183,22 @@ SOURCES += src/main.cpp \
     src/imports/FileWorker.cpp \
     src/imports/DownloadFileSearcher.cpp \
     src/log/Log.cpp \
+    src/export/CompiledTemplate.cpp \
+    src/export/CsvWriter.cpp \
+    src/export/ExportImageCache.cpp \
     src/export/ExportTemplate.cpp \
     src/export/ExportTemplateLoader.cpp \
+    src/export/GzipDevice.cpp \
     src/export/MediaExport.cpp \
     src/export/SimpleEngine.cpp \
+    src/file/DirectoryManifest.cpp \
+    src/file/DirectoryWatcher.cpp \
     src/file/FileFilter.cpp \
     src/file/FilenameUtils.cpp \
     src/file/Path.cpp \
+    src/file/SavedDirectories.cpp \
     src/data/Actor.cpp \
+    src/globals/CachedSortKey.cpp \
     src/globals/ComboDelegate.cpp \
     src/globals/DownloadManager.cpp \
     src/globals/DownloadManagerElement.cpp \
@@ -190,6 +207,7 @@ SOURCES += src/main.cpp \
     src/globals/Helper.cpp \
     src/globals/ImageDialog.cpp \
     src/globals/ImagePreviewDialog.cpp \
+    src/globals/LibraryWatcher.cpp \
     src/globals/Manager.cpp \
     src/globals/MessageIds.cpp \
     src/globals/Math.cpp \
@@ -206,6 +224,7 @@ SOURCES += src/main.cpp \
     src/globals/VersionInfo.cpp \
     src/image/Image.cpp \
     src/image/ImageCapture.cpp \
+    src/image/ImageCaptureBatch.cpp \
     src/image/ImageModel.cpp \
     src/image/ImageProxyModel.cpp \
     src/image/ThumbnailDimensions.cpp \
@@ -233,6 +252,8 @@ SOURCES += src/main.cpp \
     src/media_centers/kodi/TvShowXmlWriter.cpp \
     src/media_centers/KodiVersion.cpp \
     src/media_centers/KodiXml.cpp \
+    src/media_centers/SaveJob.cpp \
+    src/media_centers/SaveQueue.cpp \
     src/ui/movies/CertificationWidget.cpp \
     src/ui/movies/GenreWidget.cpp \
     src/movies/MovieController.cpp \
@@ -425,6 +446,7 @@ SOURCES += src/main.cpp \
     src/tv_shows/EpisodeMap.cpp \
     src/tv_shows/TvShowModel.cpp \
     src/tv_shows/TvShowProxyModel.cpp \
+    src/tv_shows/TvShowTreeFilter.cpp \
     src/tv_shows/model/TvShowModelItem.cpp \
     src/tv_shows/model/TvShowBaseModelItem.cpp \
     src/tv_shows/model/TvShowRootModelItem.cpp \
@@ -440,6 +462,7 @@ SOURCES += src/main.cpp \
     src/tv_shows/SeasonOrder.cpp \
     src/data/Certification.cpp \
     src/movies/MovieCrew.cpp \
+    src/movies/MovieDuplicateIndex.cpp \
     src/movies/MovieSet.cpp \
     src/scrapers/movie/MovieIdentifier.cpp
 
@@ -450,6 +473,7 @@ macx {
 HEADERS  += Version.h \
     src/concerts/ConcertController.h \
     src/data/MediaInfoFile.h \
+    src/data/MediaInfoIndexer.h \
     src/data/MediaStatusColumn.h \
     src/data/RatingModel.h \
     src/export/CsvExport.h \
@@ -460,9 +484,15 @@ HEADERS  += Version.h \
     src/music/AllMusicId.h \
     src/music/MusicBrainzId.h \
     src/music/TheAudioDbId.h \
+    src/network/DownloadScheduler.h \
+    src/network/HostBackoff.h \
+    src/network/HttpCache.h \
     src/network/HttpStatusCodes.h \
+    src/network/ImagePreviewDownloader.h \
     src/network/NetworkRequest.h \
     src/network/NetworkManager.h \
+    src/network/RequestDispatcher.h \
+    src/scrapers/ScrapeScheduler.h \
     src/scrapers/ScraperError.h \
     src/scrapers/music/AllMusic.h \
     src/scrapers/music/Discogs.h \
@@ -480,6 +510,7 @@ HEADERS  += Version.h \
     src/concerts/ConcertProxyModel.h \
     src/ui/concerts/ConcertStreamDetailsWidget.h \
     src/data/Database.h \
+    src/data/DatabaseRecord.h \
     src/data/ImageCache.h \
     src/data/ResumeTime.h \
     src/media_centers/MediaCenterInterface.h \
@@ -504,6 +535,7 @@ HEADERS  += Version.h \
     src/data/Subtitle.h \
     src/tv_shows/TvShow.h \
     src/tv_shows/TvShowEpisode.h \
+    src/tv_shows/TvShowDirectorySearcher.h \
     src/tv_shows/TvShowFileSearcher.h \
     src/imports/DownloadFileSearcher.h \
     src/imports/Extractor.h \
@@ -518,14 +550,22 @@ HEADERS  += Version.h \
     src/ui/imports/ImportDialog.h \
     src/ui/imports/MakeMkvDialog.h \
     src/ui/imports/UnpackButtons.h \
+    src/export/CompiledTemplate.h \
+    src/export/CsvWriter.h \
+    src/export/ExportImageCache.h \
     src/export/ExportTemplate.h \
     src/export/ExportTemplateLoader.h \
+    src/export/GzipDevice.h \
     src/export/MediaExport.h \
     src/export/SimpleEngine.h \
+    src/file/DirectoryManifest.h \
+    src/file/DirectoryWatcher.h \
     src/file/FileFilter.h \
     src/file/FilenameUtils.h \
     src/file/Path.h \
+    src/file/SavedDirectories.h \
     src/data/Actor.h \
+    src/globals/CachedSortKey.h \
     src/globals/ComboDelegate.h \
     src/globals/DownloadManager.h \
     src/globals/DownloadManagerElement.h \
@@ -534,6 +574,7 @@ HEADERS  += Version.h \
     src/globals/Helper.h \
     src/globals/ImageDialog.h \
     src/globals/ImagePreviewDialog.h \
+    src/globals/LibraryWatcher.h \
     src/globals/LocaleStringCompare.h \
     src/globals/Manager.h \
     src/globals/MessageIds.h \
@@ -551,6 +592,7 @@ HEADERS  += Version.h \
     src/globals/VersionInfo.h \
     src/image/Image.h \
     src/image/ImageCapture.h \
+    src/image/ImageCaptureBatch.h \
     src/image/ImageModel.h \
     src/image/ImageProxyModel.h \
     src/image/ThumbnailDimensions.h \
@@ -584,6 +626,8 @@ HEADERS  += Version.h \
     src/media_centers/KodiVersion.h \
     src/media_centers/KodiVersion.h \
     src/media_centers/KodiXml.h \
+    src/media_centers/SaveJob.h \
+    src/media_centers/SaveQueue.h \
     src/ui/movies/CertificationWidget.h \
     src/ui/movies/GenreWidget.h \
     src/movies/MovieController.h \
@@ -764,6 +808,7 @@ HEADERS  += Version.h \
     src/tv_shows/EpisodeMap.h \
     src/tv_shows/TvShowModel.h \
     src/tv_shows/TvShowProxyModel.h \
+    src/tv_shows/TvShowTreeFilter.h \
     src/tv_shows/model/TvShowModelItem.h \
     src/tv_shows/model/TvShowBaseModelItem.h \
     src/tv_shows/model/TvShowRootModelItem.h \
@@ -782,6 +827,7 @@ HEADERS  += Version.h \
     src/tv_shows/SeasonOrder.h \
     src/data/Certification.h \
     src/movies/MovieCrew.h \
+    src/movies/MovieDuplicateIndex.h \
     src/movies/MovieSet.h \
     src/scrapers/movie/MovieIdentifier.h
 
@@ -11,6 +11,8 @@
 #include "music/Album.h"
 #include "settings/Settings.h"
 
+#include <QEventLoop>
+#include <QTimer>
 #include <iomanip>
 #include <iostream>
 
@@ -126,7 +128,12 @@ void listTvShows()
     // The global TvShowFilesWidget instance is set in its constructor...
     // TODO: Don't implicitly expect that it is instantiated somewhere.
     TvShowFilesWidget filesWidget;
-    Manager::instance()->tvShowFileSearcher()->reload(false);
+    // The TV show file searcher loads shows in other threads. Wait until it's done.
+    QEventLoop loop;
+    QObject::connect(
+        Manager::instance()->tvShowFileSearcher(), &TvShowFileSearcher::tvShowsLoaded, &loop, &QEventLoop::quit);
+    QTimer::singleShot(0, []() { Manager::instance()->tvShowFileSearcher()->reload(false); });
+    loop.exec();
     TvShowModel* tvShowModel = Manager::instance()->tvShowModel();
 
     TableLayout layout;
@@ -3,6 +3,8 @@
 #include "globals/Manager.h"
 #include "movies/file_searcher/MovieFileSearcher.h"
 
+#include <QEventLoop>
+#include <QTimer>
 #include <iostream>
 
 namespace mediaelch {
@@ -23,7 +25,12 @@ void reloadTvShows()
     // The global TvShowFilesWidget instance is set in its constructor...
     // TODO: Don't implicitly expect that it is instantiated somewhere.
     TvShowFilesWidget filesWidget;
-    Manager::instance()->tvShowFileSearcher()->reload(true);
+    // The TV show file searcher loads shows in other threads. Wait until it's done.
+    QEventLoop loop;
+    QObject::connect(
+        Manager::instance()->tvShowFileSearcher(), &TvShowFileSearcher::tvShowsLoaded, &loop, &QEventLoop::quit);
+    QTimer::singleShot(0, []() { Manager::instance()->tvShowFileSearcher()->reload(true); });
+    loop.exec();
     std::cout << "Concerts reloaded." << std::endl;
 }
 
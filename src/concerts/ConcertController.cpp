@@ -6,11 +6,13 @@
 
 #include "concerts/Concert.h"
 #include "data/ImageCache.h"
+#include "data/MediaInfoIndexer.h"
 #include "file/NameFormatter.h"
 #include "globals/DownloadManager.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "media_centers/MediaCenterInterface.h"
+#include "media_centers/SaveQueue.h"
 #include "scrapers/concert/ConcertScraper.h"
 #include "settings/Settings.h"
 
@@ -40,6 +42,23 @@ bool ConcertController::saveData(MediaCenterInterface* mediaCenterInterface)
         loadStreamDetailsFromFile();
     }
     const bool saved = mediaCenterInterface->saveConcert(m_concert);
+    onSaved(saved);
+    return saved;
+}
+
+int ConcertController::saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue)
+{
+    if (!m_concert->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
+        loadStreamDetailsFromFile();
+    }
+    mediaelch::SaveJob job;
+    const bool created = mediaCenterInterface->createSaveJob(m_concert, job);
+    onSaved(created);
+    return created ? queue.enqueue(std::move(job)) : -1;
+}
+
+void ConcertController::onSaved(bool saved)
+{
     if (!m_infoLoaded) {
         m_infoLoaded = saved;
     }
@@ -47,7 +66,6 @@ bool ConcertController::saveData(MediaCenterInterface* mediaCenterInterface)
     m_concert->clearImages();
     m_concert->clearExtraFanartData();
     m_concert->setSyncNeeded(true);
-    return saved;
 }
 
 bool ConcertController::loadData(MediaCenterInterface* mediaCenterInterface, bool force, bool reloadFromNfo)
@@ -126,9 +144,14 @@ void ConcertController::loadData(TmdbId id,
 }
 
 void ConcertController::loadStreamDetailsFromFile()
+{
+    applyStreamDetails(mediaelch::MediaInfoIndexer::load(m_concert->streamDetails()->files()));
+}
+
+void ConcertController::applyStreamDetails(const StreamDetails::Values& values)
 {
     using namespace std::chrono;
-    m_concert->streamDetails()->loadStreamDetails();
+    m_concert->streamDetails()->setValues(values);
     seconds runtime(
         m_concert->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds).toInt());
     m_concert->setRuntime(duration_cast<minutes>(runtime));
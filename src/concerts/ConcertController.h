@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/StreamDetails.h"
 #include "data/TmdbId.h"
 #include "globals/DownloadManagerElement.h"
 #include "globals/Poster.h"
@@ -13,6 +14,7 @@ class DownloadManager;
 class MediaCenterInterface;
 
 namespace mediaelch {
+class SaveQueue;
 namespace scraper {
 class ConcertScraper;
 }
@@ -27,9 +29,13 @@ public:
     Concert* concert();
 
     bool saveData(MediaCenterInterface* mediaCenterInterface);
+    /// \brief Saves the concert in a worker thread of the given queue; see MovieController::saveDataInBackground().
+    int saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue);
     bool loadData(MediaCenterInterface* mediaCenterInterface, bool force = false, bool reloadFromNfo = true);
     void loadData(TmdbId id, mediaelch::scraper::ConcertScraper* scraperInterface, QSet<ConcertScraperInfo> infos);
     void loadStreamDetailsFromFile();
+    /// \brief Sets stream details loaded by MediaInfoIndexer; see MovieController::applyStreamDetails().
+    void applyStreamDetails(const StreamDetails::Values& values);
     void scraperLoadDone(mediaelch::scraper::ConcertScraper* scraper);
     QSet<ConcertScraperInfo> infosToLoad();
     bool infoLoaded() const;
@@ -55,6 +61,8 @@ private slots:
     void onDownloadFinished(DownloadManagerElement elem);
 
 private:
+    void onSaved(bool saved);
+
     Concert* m_concert = nullptr;
     bool m_infoLoaded = false;
     bool m_infoFromNfoLoaded = false;
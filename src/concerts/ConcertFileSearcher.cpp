@@ -1,14 +1,17 @@
 #include "ConcertFileSearcher.h"
 
+#include "concerts/ConcertModel.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
 #include "log/Log.h"
 
 #include <QApplication>
+#include <QHash>
 #include <QRegularExpression>
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include <algorithm>
 
 ConcertFileSearcher::ConcertFileSearcher(QObject* parent) :
     QObject(parent), m_progressMessageId{Constants::ConcertFileSearcherProgressMessageId}
@@ -45,6 +48,7 @@ void ConcertFileSearcher::setConcertDirectories(QVector<SettingsDir> directories
 void ConcertFileSearcher::reload(bool force)
 {
     m_aborted = false;
+    m_running = true;
 
     clearOldConcerts(force);
 
@@ -59,11 +63,111 @@ void ConcertFileSearcher::reload(bool force)
     addConcertsToGui(loadConcertsFromDatabase());
 
     qCDebug(generic) << "Searching for concerts done";
+    m_running = false;
     if (!m_aborted) {
         emit concertsLoaded();
     }
 }
 
+bool ConcertFileSearcher::updateDirectory(const mediaelch::DirectoryPath& root, const QSet<QString>& changedDirs)
+{
+    if (m_running) {
+        return false;
+    }
+
+    const auto dir = std::find_if(m_directories.cbegin(), m_directories.cend(), [&root](const SettingsDir& d) {
+        return !d.disabled && mediaelch::DirectoryPath(d.path) == root;
+    });
+    if (dir == m_directories.cend()) {
+        qCDebug(generic) << "[ConcertFileSearcher] Not a concert directory, nothing to update:" << root;
+        return true;
+    }
+
+    qCInfo(generic) << "[ConcertFileSearcher] Updating concerts in directory:" << root;
+    m_aborted = false;
+    m_running = true;
+
+    QVector<QStringList> contents;
+    scanDir(root.toString(), root.toString(), contents, dir->separateFolders, true);
+    emit currentDir("");
+
+    // Concerts are identified by their first file.
+    QHash<QString, QStringList> newContents;
+    for (const QStringList& files : asConst(contents)) {
+        newContents.insert(files.first(), files);
+    }
+
+    auto* mci = Manager::instance()->mediaCenterInterface();
+    ConcertModel* model = Manager::instance()->concertModel();
+    QVector<Concert*> removedConcerts;
+    int updatedCount = 0;
+
+    database().transaction();
+    const QVector<Concert*> concerts = model->concerts();
+    for (Concert* concert : concerts) {
+        if (m_aborted) {
+            break;
+        }
+        if (concert->files().isEmpty() || !root.isParentFolderOf(concert->files().first().dir())) {
+            continue;
+        }
+
+        const QString firstFile = concert->files().first().toString();
+        if (!newContents.contains(firstFile)) {
+            removedConcerts.append(concert);
+            continue;
+        }
+        const QStringList files = newContents.take(firstFile);
+        if (files != concert->files().toStringList()) {
+            // Parts were added or removed: Treat it as a new concert.
+            removedConcerts.append(concert);
+            newContents.insert(firstFile, files);
+            continue;
+        }
+
+        // DVD and BluRay concerts are located in a sub-directory of the concert's directory.
+        const QString concertDir = concert->files().first().dir().toString();
+        const QString parentDir = concertDir.left(concertDir.lastIndexOf('/'));
+        const bool isChanged = changedDirs.contains(concertDir)
+                               || (concert->discType() != DiscType::Single && changedDirs.contains(parentDir));
+        if (!isChanged || concert->hasChanged()) {
+            continue;
+        }
+        concert->controller()->loadData(mci, true);
+        database().update(concert);
+        model->updateConcert(concert);
+        ++updatedCount;
+    }
+
+    for (Concert* concert : asConst(removedConcerts)) {
+        database().removeConcert(concert->databaseId());
+        model->removeConcert(concert);
+    }
+
+    int addedCount = 0;
+    for (const QStringList& files : asConst(newContents)) {
+        if (m_aborted) {
+            break;
+        }
+        auto* concert = new Concert(files, this);
+        concert->setInSeparateFolder(dir->separateFolders);
+        concert->controller()->loadData(mci);
+        database().add(concert, root);
+        model->addConcert(concert);
+        ++addedCount;
+    }
+    database().commit();
+
+    qCInfo(generic) << "[ConcertFileSearcher] Updated directory" << root << "| added:" << addedCount
+                    << "| removed:" << removedConcerts.size() << "| updated:" << updatedCount;
+
+    m_running = false;
+    if (!m_aborted) {
+        emit concertsLoaded();
+    }
+    return true;
+}
+
 /**
  * \brief Scans the given path for concert files.
  * Results are in a list which contains a QStringList for every concert.
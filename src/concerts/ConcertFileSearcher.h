@@ -3,6 +3,7 @@
 #include "data/Database.h"
 
 #include <QDir>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QVector>
@@ -13,6 +14,13 @@ class ConcertFileSearcher : public QObject
 public:
     explicit ConcertFileSearcher(QObject* parent = nullptr);
     void setConcertDirectories(QVector<SettingsDir> directories);
+    bool isRunning() const { return m_running; }
+    /// \brief Rescans the given concert directory (a root) and updates the model and database.
+    /// \details Concerts that were removed from disk are removed, new ones are added. Concerts in
+    ///          one of the changed directories are reloaded unless they have unsaved changes.
+    ///          All other concerts are left untouched.
+    /// \return False if the searcher is running and the update has to be retried later.
+    bool updateDirectory(const mediaelch::DirectoryPath& root, const QSet<QString>& changedDirs);
 
 public slots:
     void reload(bool force);
@@ -28,6 +36,7 @@ private:
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
     bool m_aborted = false;
+    bool m_running = false;
 
 private:
     Database& database();
@@ -30,6 +30,24 @@ void ConcertModel::addConcert(Concert* concert)
     connect(concert, &Concert::sigChanged, this, &ConcertModel::onConcertChanged, Qt::UniqueConnection);
 }
 
+void ConcertModel::removeConcert(Concert* concert)
+{
+    const int row = m_concerts.indexOf(concert);
+    if (row < 0) {
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row);
+    m_concerts.removeAt(row);
+    endRemoveRows();
+    emit sigConcertRemoved(concert);
+    concert->deleteLater();
+}
+
+void ConcertModel::updateConcert(Concert* concert)
+{
+    onConcertChanged(concert);
+}
+
 /**
  * \brief Called when a concerts data has changed
  * Emits dataChanged
@@ -19,6 +19,10 @@ public:
     };
     explicit ConcertModel(QObject* parent = nullptr);
     void addConcert(Concert* concert);
+    /// \brief Removes the concert from the model and deletes it (deleteLater).
+    void removeConcert(Concert* concert);
+    /// \brief Notify views that the given concert's data has changed.
+    void updateConcert(Concert* concert);
     void clear();
     QVector<Concert*> concerts();
     Concert* concert(int row);
@@ -30,6 +34,10 @@ public:
     int countNewConcerts() const;
     void update();
 
+signals:
+    /// \brief Emitted by removeConcert() before the concert is deleted. Views must no longer use it.
+    void sigConcertRemoved(Concert* concert);
+
 private slots:
     void onConcertChanged(Concert* concert);
 
@@ -1,6 +1,7 @@
 #include "Database.h"
 
 #include "concerts/Concert.h"
+#include "data/DatabaseRecord.h"
 #include "data/Subtitle.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
@@ -126,6 +127,8 @@ void Database::clearAllMovies()
     query.exec();
     query.prepare("DELETE FROM sqlite_sequence WHERE name='movieSubtitles'");
     query.exec();
+    query.prepare("DELETE FROM movieDirectoryManifest");
+    query.exec();
 }
 
 void Database::clearMoviesInDirectory(DirectoryPath path)
@@ -140,93 +143,256 @@ void Database::clearMoviesInDirectory(DirectoryPath path)
     query.prepare("DELETE FROM movies WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
+    query.prepare("DELETE FROM movieDirectoryManifest WHERE path=:path");
+    query.bindValue(":path", path.toString().toUtf8());
+    query.exec();
 }
 
-void Database::addMovie(Movie* movie, DirectoryPath path)
+void Database::removeMovie(int idMovie)
+{
+    QSqlQuery query(db());
+    query.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", idMovie);
+    query.exec();
+    query.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", idMovie);
+    query.exec();
+    query.prepare("DELETE FROM movies WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", idMovie);
+    query.exec();
+}
+
+DirectoryManifest Database::movieDirectoryManifest(DirectoryPath path)
 {
     QSqlQuery query(db());
-    query.prepare("INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, "
-                  "hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, path) "
-                  "VALUES(:content, :lastModified, :inSeparateFolder, :hasPoster, :hasBackdrop, :hasLogo, "
-                  ":hasClearArt, :hasCdArt, :hasBanner, :hasThumb, :hasExtraFanarts, :discType, :path)");
-    query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent().toUtf8());
-    query.bindValue(
-        ":lastModified", movie->fileLastModified().isNull() ? QDateTime::currentDateTime() : movie->fileLastModified());
-    query.bindValue(":inSeparateFolder", (movie->inSeparateFolder() ? 1 : 0));
-    query.bindValue(":hasPoster", movie->hasImage(ImageType::MoviePoster) ? 1 : 0);
-    query.bindValue(":hasBackdrop", movie->hasImage(ImageType::MovieBackdrop) ? 1 : 0);
-    query.bindValue(":hasLogo", movie->hasImage(ImageType::MovieLogo) ? 1 : 0);
-    query.bindValue(":hasClearArt", movie->hasImage(ImageType::MovieClearArt) ? 1 : 0);
-    query.bindValue(":hasCdArt", movie->hasImage(ImageType::MovieCdArt) ? 1 : 0);
-    query.bindValue(":hasBanner", movie->hasImage(ImageType::MovieBanner) ? 1 : 0);
-    query.bindValue(":hasThumb", movie->hasImage(ImageType::MovieThumb) ? 1 : 0);
-    query.bindValue(":hasExtraFanarts", movie->images().hasExtraFanarts() ? 1 : 0);
-    query.bindValue(":discType", static_cast<int>(movie->discType()));
+    query.prepare("SELECT dir, lastModified, size, inode, metadataFiles, metadataModified, metadataSize "
+                  "FROM movieDirectoryManifest WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
-    int insertId = query.lastInsertId().toInt();
 
-    for (const mediaelch::FilePath& file : movie->files()) {
-        query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
-        query.bindValue(":idMovie", insertId);
-        query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+    DirectoryManifest manifest;
+    while (query.next()) {
+        DirectoryState state;
+        state.lastModified = query.value(1).toLongLong();
+        state.size = query.value(2).toLongLong();
+        state.inode = query.value(3).toULongLong();
+        // File names cannot contain slashes.
+        state.metadataFiles =
+            QString::fromUtf8(query.value(4).toByteArray()).split('/', ElchSplitBehavior::SkipEmptyParts);
+        state.metadataModified = query.value(5).toLongLong();
+        state.metadataSize = query.value(6).toLongLong();
+        manifest.insert(QString::fromUtf8(query.value(0).toByteArray()), state);
     }
+    return manifest;
+}
 
-    for (const Subtitle* subtitle : movie->subtitles()) {
-        query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
-                      ":language, :forced)");
-        query.bindValue(":idMovie", insertId);
-        query.bindValue(":files", subtitle->files().join("%§%"));
-        query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
-        query.bindValue(":forced", subtitle->forced() ? 1 : 0);
+void Database::setMovieDirectoryManifest(DirectoryPath path, const DirectoryManifest& manifest)
+{
+    QSqlQuery query(db());
+    query.prepare("DELETE FROM movieDirectoryManifest WHERE path=:path");
+    query.bindValue(":path", path.toString().toUtf8());
+    query.exec();
+
+    query.prepare("INSERT INTO movieDirectoryManifest(path, dir, lastModified, size, inode, metadataFiles, "
+                  "metadataModified, metadataSize) "
+                  "VALUES(:path, :dir, :lastModified, :size, :inode, :metadataFiles, :metadataModified, "
+                  ":metadataSize)");
+    for (auto it = manifest.cbegin(); it != manifest.cend(); ++it) {
+        query.bindValue(":path", path.toString().toUtf8());
+        query.bindValue(":dir", it.key().toUtf8());
+        query.bindValue(":lastModified", it.value().lastModified);
+        query.bindValue(":size", it.value().size);
+        query.bindValue(":inode", it.value().inode);
+        query.bindValue(":metadataFiles", it.value().metadataFiles.join('/').toUtf8());
+        query.bindValue(":metadataModified", it.value().metadataModified);
+        query.bindValue(":metadataSize", it.value().metadataSize);
         query.exec();
     }
+}
 
-    setLabel(movie->files(), movie->label());
-
-    movie->setDatabaseId(insertId);
+void Database::addMovie(Movie* movie, DirectoryPath path)
+{
+    addMovies({movie}, path);
 }
 
-void Database::update(Movie* movie)
+void Database::addMovies(const QVector<Movie*>& movies, DirectoryPath path)
 {
+    if (movies.isEmpty()) {
+        return;
+    }
+
+    // Each statement is prepared only once.  Files, subtitles and labels are
+    // collected and inserted using execBatch() after all movies were added.
     QSqlQuery query(db());
-    query.prepare("UPDATE movies SET content=:content WHERE idMovie=:idMovie");
-    query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent());
-    query.bindValue(":idMovie", movie->databaseId());
-    query.exec();
+    query.prepare("INSERT INTO movies(content, record, lastModified, inSeparateFolder, hasPoster, hasBackdrop, "
+                  "hasLogo, hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, hasLocalTrailer, discType, "
+                  "path) "
+                  "VALUES(:content, :record, :lastModified, :inSeparateFolder, :hasPoster, :hasBackdrop, "
+                  ":hasLogo, :hasClearArt, :hasCdArt, :hasBanner, :hasThumb, :hasExtraFanarts, :hasLocalTrailer, "
+                  ":discType, :path)");
+
+    const QByteArray pathValue = path.toString().toUtf8();
+    QVariantList fileMovieIds;
+    QVariantList files;
+    QVariantList subtitleMovieIds;
+    QVariantList subtitleFiles;
+    QVariantList subtitleLanguages;
+    QVariantList subtitleForced;
+    mediaelch::FileList labelFiles;
+    QVector<ColorLabel> labelColors;
+
+    for (Movie* movie : movies) {
+        query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent().toUtf8());
+        query.bindValue(":record", movieRecord(movie));
+        query.bindValue(":lastModified",
+            movie->fileLastModified().isNull() ? QDateTime::currentDateTime() : movie->fileLastModified());
+        query.bindValue(":inSeparateFolder", (movie->inSeparateFolder() ? 1 : 0));
+        query.bindValue(":hasPoster", movie->hasImage(ImageType::MoviePoster) ? 1 : 0);
+        query.bindValue(":hasBackdrop", movie->hasImage(ImageType::MovieBackdrop) ? 1 : 0);
+        query.bindValue(":hasLogo", movie->hasImage(ImageType::MovieLogo) ? 1 : 0);
+        query.bindValue(":hasClearArt", movie->hasImage(ImageType::MovieClearArt) ? 1 : 0);
+        query.bindValue(":hasCdArt", movie->hasImage(ImageType::MovieCdArt) ? 1 : 0);
+        query.bindValue(":hasBanner", movie->hasImage(ImageType::MovieBanner) ? 1 : 0);
+        query.bindValue(":hasThumb", movie->hasImage(ImageType::MovieThumb) ? 1 : 0);
+        query.bindValue(":hasExtraFanarts", movie->images().hasExtraFanarts() ? 1 : 0);
+        query.bindValue(":hasLocalTrailer", movie->hasLocalTrailer() ? 1 : 0);
+        query.bindValue(":discType", static_cast<int>(movie->discType()));
+        query.bindValue(":path", pathValue);
+        if (!query.exec()) {
+            qCWarning(generic) << "[Database] Could not add movie:" << query.lastError().text();
+            continue;
+        }
+        const int insertId = query.lastInsertId().toInt();
 
-    query.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
-    query.bindValue(":idMovie", movie->databaseId());
-    query.exec();
-    for (const mediaelch::FilePath& file : movie->files()) {
+        for (const mediaelch::FilePath& file : movie->files()) {
+            fileMovieIds << insertId;
+            files << file.toString().toUtf8();
+            labelFiles << file;
+            labelColors << movie->label();
+        }
+
+        for (const Subtitle* subtitle : movie->subtitles()) {
+            subtitleMovieIds << insertId;
+            subtitleFiles << subtitle->files().join("%§%");
+            subtitleLanguages << (subtitle->language().isEmpty() ? "" : subtitle->language());
+            subtitleForced << (subtitle->forced() ? 1 : 0);
+        }
+
+        movie->setDatabaseId(insertId);
+    }
+
+    if (!files.isEmpty()) {
         query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
-        query.bindValue(":idMovie", movie->databaseId());
-        query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+        query.bindValue(":idMovie", fileMovieIds);
+        query.bindValue(":file", files);
+        query.execBatch();
     }
 
-    query.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
-    query.bindValue(":idMovie", movie->databaseId());
-    query.exec();
-    for (const Subtitle* subtitle : movie->subtitles()) {
+    if (!subtitleMovieIds.isEmpty()) {
         query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
                       ":language, :forced)");
-        query.bindValue(":idMovie", movie->databaseId());
-        query.bindValue(":files", subtitle->files().join("%§%"));
-        query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
-        query.bindValue(":forced", subtitle->forced() ? 1 : 0);
+        query.bindValue(":idMovie", subtitleMovieIds);
+        query.bindValue(":files", subtitleFiles);
+        query.bindValue(":language", subtitleLanguages);
+        query.bindValue(":forced", subtitleForced);
+        query.execBatch();
+    }
+
+    setLabels(labelFiles, labelColors);
+}
+
+void Database::update(Movie* movie)
+{
+    updateFor(movie)(*this);
+}
+
+Database::Update Database::updateFor(Movie* movie)
+{
+    const int idMovie = movie->databaseId();
+    const QString content = movie->nfoContent();
+    const QByteArray record = movieRecord(movie);
+    const bool hasLocalTrailer = movie->hasLocalTrailer();
+    const mediaelch::FileList files = movie->files();
+
+    QVariantList movieIds;
+    QVariantList subtitleFiles;
+    QVariantList languages;
+    QVariantList forced;
+    for (const Subtitle* subtitle : movie->subtitles()) {
+        movieIds << idMovie;
+        subtitleFiles << subtitle->files().join("%§%");
+        languages << (subtitle->language().isEmpty() ? "" : subtitle->language());
+        forced << (subtitle->forced() ? 1 : 0);
+    }
+
+    return [=](Database& database) {
+        QSqlQuery query(database.db());
+        query.prepare("UPDATE movies SET content=:content, record=:record, hasLocalTrailer=:hasLocalTrailer "
+                      "WHERE idMovie=:idMovie");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":record", record);
+        query.bindValue(":hasLocalTrailer", hasLocalTrailer ? 1 : 0);
+        query.bindValue(":idMovie", idMovie);
+        query.exec();
+
+        query.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
+        query.bindValue(":idMovie", idMovie);
         query.exec();
+        database.insertFiles("movieFiles", "idMovie", idMovie, files);
+
+        query.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
+        query.bindValue(":idMovie", idMovie);
+        query.exec();
+
+        if (!movieIds.isEmpty()) {
+            query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
+                          ":language, :forced)");
+            query.bindValue(":idMovie", movieIds);
+            query.bindValue(":files", subtitleFiles);
+            query.bindValue(":language", languages);
+            query.bindValue(":forced", forced);
+            query.execBatch();
+        }
+    };
+}
+
+QByteArray Database::movieRecord(Movie* movie)
+{
+    // Movies without NFO file are not "loaded"; their details are guessed from the filename.
+    return movie->controller()->infoLoaded() ? serializeMovieRecord(*movie) : QByteArray();
+}
+
+QByteArray Database::episodeRecord(TvShowEpisode* episode)
+{
+    return episode->infoLoaded() ? serializeEpisodeRecord(*episode) : QByteArray();
+}
+
+void Database::insertFiles(const QString& table, const QString& idColumn, int id, const mediaelch::FileList& files)
+{
+    if (files.isEmpty()) {
+        return;
     }
+    QVariantList ids;
+    QVariantList fileNames;
+    for (const mediaelch::FilePath& file : files) {
+        ids << id;
+        fileNames << file.toString().toUtf8();
+    }
+    QSqlQuery query(db());
+    query.prepare(QStringLiteral("INSERT INTO %1(%2, file) VALUES(:id, :file)").arg(table, idColumn));
+    query.bindValue(":id", ids);
+    query.bindValue(":file", fileNames);
+    query.execBatch();
 }
 
 QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, QObject* movieParent)
 {
     transaction();
     QSqlQuery query(db());
-    query.prepare("SELECT M.idMovie, M.content, M.lastModified, M.inSeparateFolder, M.hasPoster, M.hasBackdrop, "
-                  "M.hasLogo, M.hasClearArt, "
-                  "M.hasCdArt, M.hasBanner, M.hasThumb, M.hasExtraFanarts, M.discType, MF.file, L.color "
+    query.prepare("SELECT M.idMovie, M.content, M.record, M.lastModified, M.inSeparateFolder, M.hasPoster, "
+                  "M.hasBackdrop, M.hasLogo, M.hasClearArt, "
+                  "M.hasCdArt, M.hasBanner, M.hasThumb, M.hasExtraFanarts, M.hasLocalTrailer, M.discType, MF.file, "
+                  "L.color "
                   "FROM movies M "
                   "LEFT JOIN movieFiles MF ON MF.idMovie=M.idMovie "
                   "LEFT JOIN labels L ON MF.file=L.fileName "
@@ -236,6 +402,7 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, QObject* moviePa
     query.exec();
 
     QMap<int, Movie*> movies;
+    QVector<Movie*> moviesWithoutTrailerInfo;
     while (query.next()) {
         Movie* movie = nullptr;
         if (movies.contains(query.value(query.record().indexOf("idMovie")).toInt())) {
@@ -252,7 +419,11 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, QObject* moviePa
             movie->setDatabaseId(query.value(query.record().indexOf("idMovie")).toInt());
             movie->setFileLastModified(query.value(query.record().indexOf("lastModified")).toDateTime());
             movie->setInSeparateFolder(query.value(query.record().indexOf("inSeparateFolder")).toInt() == 1);
-            movie->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+            const QString nfoContent = QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray());
+            // Use the pre-parsed record if possible.  Otherwise the loader parses the NFO content.
+            if (!movie->controller()->loadDataFromRecord(query.value(query.record().indexOf("record")).toByteArray())) {
+                movie->setNfoContent(nfoContent);
+            }
             movie->images().setHasImage(
                 ImageType::MoviePoster, query.value(query.record().indexOf("hasPoster")).toInt() == 1);
             movie->images().setHasImage(
@@ -268,6 +439,13 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, QObject* moviePa
             movie->images().setHasImage(
                 ImageType::MovieThumb, query.value(query.record().indexOf("hasThumb")).toInt() == 1);
             movie->images().setHasExtraFanarts(query.value(query.record().indexOf("hasExtraFanarts")).toInt() == 1);
+            const QVariant hasLocalTrailer = query.value(query.record().indexOf("hasLocalTrailer"));
+            if (hasLocalTrailer.isNull()) {
+                // Entries of older versions; determined below once the movie's files are known.
+                moviesWithoutTrailerInfo.append(movie);
+            } else {
+                movie->setHasLocalTrailer(hasLocalTrailer.toInt() == 1);
+            }
             movie->setDiscType(static_cast<DiscType>(query.value(query.record().indexOf("discType")).toInt()));
             movie->setLabel(label);
             movie->setChanged(false);
@@ -279,6 +457,21 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, QObject* moviePa
         movie->setFiles(files);
     }
 
+    if (!moviesWithoutTrailerInfo.isEmpty()) {
+        // Only necessary once after updating MediaElch; the result is stored.
+        QVariantList movieIds;
+        QVariantList hasLocalTrailer;
+        for (Movie* movie : asConst(moviesWithoutTrailerInfo)) {
+            movie->updateHasLocalTrailer();
+            movieIds << movie->databaseId();
+            hasLocalTrailer << (movie->hasLocalTrailer() ? 1 : 0);
+        }
+        query.prepare("UPDATE movies SET hasLocalTrailer=:hasLocalTrailer WHERE idMovie=:idMovie");
+        query.bindValue(":hasLocalTrailer", hasLocalTrailer);
+        query.bindValue(":idMovie", movieIds);
+        query.execBatch();
+    }
+
     query.prepare("SELECT idMovie, files, language, forced FROM movieSubtitles");
     query.exec();
     while (query.next()) {
@@ -335,32 +528,44 @@ void Database::add(Concert* concert, DirectoryPath path)
     query.exec();
     int insertId = query.lastInsertId().toInt();
 
-    for (const FilePath& file : concert->files()) {
-        query.prepare("INSERT INTO concertFiles(idConcert, file) VALUES(:idConcert, :file)");
-        query.bindValue(":idConcert", insertId);
-        query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
-    }
+    insertFiles("concertFiles", "idConcert", insertId, concert->files());
     concert->setDatabaseId(insertId);
 }
 
-void Database::update(Concert* concert)
+void Database::removeConcert(int idConcert)
 {
     QSqlQuery query(db());
-    query.prepare("UPDATE concerts SET content=:content WHERE idConcert=:id");
-    query.bindValue(":content", concert->nfoContent().isEmpty() ? "" : concert->nfoContent());
-    query.bindValue(":id", concert->databaseId());
-    query.exec();
-
     query.prepare("DELETE FROM concertFiles WHERE idConcert=:idConcert");
-    query.bindValue(":idConcert", concert->databaseId());
+    query.bindValue(":idConcert", idConcert);
     query.exec();
-    for (const FilePath& file : concert->files()) {
-        query.prepare("INSERT INTO concertFiles(idConcert, file) VALUES(:idConcert, :file)");
-        query.bindValue(":idConcert", concert->databaseId());
-        query.bindValue(":file", file.toString().toUtf8());
+    query.prepare("DELETE FROM concerts WHERE idConcert=:idConcert");
+    query.bindValue(":idConcert", idConcert);
+    query.exec();
+}
+
+void Database::update(Concert* concert)
+{
+    updateFor(concert)(*this);
+}
+
+Database::Update Database::updateFor(Concert* concert)
+{
+    const int idConcert = concert->databaseId();
+    const QString content = concert->nfoContent();
+    const mediaelch::FileList files = concert->files();
+
+    return [=](Database& database) {
+        QSqlQuery query(database.db());
+        query.prepare("UPDATE concerts SET content=:content WHERE idConcert=:id");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":id", idConcert);
         query.exec();
-    }
+
+        query.prepare("DELETE FROM concertFiles WHERE idConcert=:idConcert");
+        query.bindValue(":idConcert", idConcert);
+        query.exec();
+        database.insertFiles("concertFiles", "idConcert", idConcert, files);
+    };
 }
 
 QVector<Concert*> Database::concertsInDirectory(DirectoryPath path)
@@ -472,63 +677,110 @@ void Database::setHideSpecialsInMissingEpisodes(TvShow* show, bool hideSpecials)
 
 void Database::add(TvShowEpisode* episode, DirectoryPath path, int idShow)
 {
+    addEpisodes({episode}, path, idShow);
+}
+
+void Database::addEpisodes(const QVector<TvShowEpisode*>& episodes, DirectoryPath path, int idShow)
+{
+    if (episodes.isEmpty()) {
+        return;
+    }
+
     QSqlQuery query(db());
-    query.prepare("INSERT INTO episodes(content, idShow, path, seasonNumber, episodeNumber) "
-                  "VALUES(:content, :idShow, :path, :seasonNumber, :episodeNumber)");
-    query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent().toUtf8());
-    query.bindValue(":idShow", idShow);
-    query.bindValue(":path", path.toString().toUtf8());
-    query.bindValue(":seasonNumber", episode->seasonNumber().toInt());
-    query.bindValue(":episodeNumber", episode->episodeNumber().toInt());
-    query.exec();
-    int insertId = query.lastInsertId().toInt();
-    for (const FilePath& file : episode->files()) {
+    query.prepare("INSERT INTO episodes(content, record, idShow, path, seasonNumber, episodeNumber) "
+                  "VALUES(:content, :record, :idShow, :path, :seasonNumber, :episodeNumber)");
+
+    const QByteArray pathValue = path.toString().toUtf8();
+    QVariantList episodeIds;
+    QVariantList files;
+
+    for (TvShowEpisode* episode : episodes) {
+        query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent().toUtf8());
+        query.bindValue(":record", episodeRecord(episode));
+        query.bindValue(":idShow", idShow);
+        query.bindValue(":path", pathValue);
+        query.bindValue(":seasonNumber", episode->seasonNumber().toInt());
+        query.bindValue(":episodeNumber", episode->episodeNumber().toInt());
+        if (!query.exec()) {
+            qCWarning(generic) << "[Database] Could not add episode:" << query.lastError().text();
+            continue;
+        }
+        const int insertId = query.lastInsertId().toInt();
+        for (const FilePath& file : episode->files()) {
+            episodeIds << insertId;
+            files << file.toString().toUtf8();
+        }
+        episode->setDatabaseId(insertId);
+    }
+
+    if (!files.isEmpty()) {
         query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
-        query.bindValue(":idEpisode", insertId);
-        query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+        query.bindValue(":idEpisode", episodeIds);
+        query.bindValue(":file", files);
+        query.execBatch();
     }
-    episode->setDatabaseId(insertId);
 }
 
 void Database::update(TvShow* show)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE shows SET content=:content, dir=:dir WHERE idShow=:id");
-    query.bindValue(":content", show->nfoContent().isEmpty() ? "" : show->nfoContent());
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.bindValue(":id", show->databaseId());
-    query.exec();
+    updateFor(show)(*this);
+}
 
-    int id = showsSettingsId(show);
-    query.prepare("UPDATE showsSettings SET showMissingEpisodes=:show, hideSpecialsInMissingEpisodes=:hide, url=:url, "
-                  "tvdbid=:tvdbid WHERE idShow=:idShow");
-    query.bindValue(":show", show->showMissingEpisodes());
-    query.bindValue(":hide", show->hideSpecialsInMissingEpisodes());
-    query.bindValue(":idShow", id);
-    query.bindValue(":tvdbid", show->tvdbId().toString());
-    query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
-    query.exec();
+Database::Update Database::updateFor(TvShow* show)
+{
+    const int idShow = show->databaseId();
+    const QString content = show->nfoContent();
+    const mediaelch::DirectoryPath dir = show->dir();
+    const bool showMissingEpisodes = show->showMissingEpisodes();
+    const bool hideSpecialsInMissingEpisodes = show->hideSpecialsInMissingEpisodes();
+    const QString tvdbId = show->tvdbId().toString();
+    const QString episodeGuideUrl = show->episodeGuideUrl();
+
+    return [=](Database& database) {
+        QSqlQuery query(database.db());
+        query.prepare("UPDATE shows SET content=:content, dir=:dir WHERE idShow=:id");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":dir", dir.toString().toUtf8());
+        query.bindValue(":id", idShow);
+        query.exec();
+
+        int id = database.showsSettingsId(dir);
+        query.prepare("UPDATE showsSettings SET showMissingEpisodes=:show, hideSpecialsInMissingEpisodes=:hide, "
+                      "url=:url, tvdbid=:tvdbid WHERE idShow=:idShow");
+        query.bindValue(":show", showMissingEpisodes);
+        query.bindValue(":hide", hideSpecialsInMissingEpisodes);
+        query.bindValue(":idShow", id);
+        query.bindValue(":tvdbid", tvdbId);
+        query.bindValue(":url", episodeGuideUrl.isEmpty() ? "" : episodeGuideUrl);
+        query.exec();
+    };
 }
 
 void Database::update(TvShowEpisode* episode)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE episodes SET content=:content WHERE idEpisode=:id");
-    query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent());
-    query.bindValue(":id", episode->databaseId());
-    query.exec();
+    updateFor(episode)(*this);
+}
 
-    query.prepare("DELETE FROM episodeFiles WHERE idEpisode=:idEpisode");
-    query.bindValue(":idEpisode", episode->databaseId());
-    query.exec();
+Database::Update Database::updateFor(TvShowEpisode* episode)
+{
+    const int idEpisode = episode->databaseId();
+    const QString content = episode->nfoContent();
+    const QByteArray record = episodeRecord(episode);
+    const mediaelch::FileList files = episode->files();
+
+    return [=](Database& database) {
+        QSqlQuery query(database.db());
+        query.prepare("UPDATE episodes SET content=:content, record=:record WHERE idEpisode=:id");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":record", record);
+        query.bindValue(":id", idEpisode);
+        query.exec();
 
-    for (const FilePath& file : episode->files()) {
-        query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
-        query.bindValue(":idEpisode", episode->databaseId());
-        query.bindValue(":file", file.toString().toUtf8());
+        query.prepare("DELETE FROM episodeFiles WHERE idEpisode=:idEpisode");
+        query.bindValue(":idEpisode", idEpisode);
         query.exec();
-    }
+        database.insertFiles("episodeFiles", "idEpisode", idEpisode, files);
+    };
 }
 
 int Database::showCount(DirectoryPath path)
@@ -545,7 +797,7 @@ int Database::showCount(DirectoryPath path)
     return ok ? numberOfShows : 0;
 }
 
-QVector<TvShow*> Database::showsInDirectory(DirectoryPath path)
+QVector<TvShow*> Database::showsInDirectory(DirectoryPath path, QObject* showParent)
 {
     QVector<TvShow*> shows;
     QSqlQuery query(db());
@@ -554,7 +806,7 @@ QVector<TvShow*> Database::showsInDirectory(DirectoryPath path)
     query.exec();
     while (query.next()) {
         mediaelch::DirectoryPath dir(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()));
-        auto* show = new TvShow(dir, Manager::instance()->tvShowFileSearcher());
+        auto* show = new TvShow(dir, showParent);
         show->setDatabaseId(query.value(query.record().indexOf("idShow")).toInt());
         show->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
         shows.append(show);
@@ -580,7 +832,8 @@ QVector<TvShowEpisode*> Database::episodes(int idShow)
     QVector<TvShowEpisode*> episodes;
     QSqlQuery query(db());
     QSqlQuery queryFiles(db());
-    query.prepare("SELECT idEpisode, content, seasonNumber, episodeNumber FROM episodes WHERE idShow=:idShow");
+    query.prepare(
+        "SELECT idEpisode, content, record, seasonNumber, episodeNumber FROM episodes WHERE idShow=:idShow");
     query.bindValue(":idShow", idShow);
     query.exec();
     while (query.next()) {
@@ -596,7 +849,10 @@ QVector<TvShowEpisode*> Database::episodes(int idShow)
         episode->setSeason(SeasonNumber(query.value(query.record().indexOf("seasonNumber")).toInt()));
         episode->setEpisode(EpisodeNumber(query.value(query.record().indexOf("episodeNumber")).toInt()));
         episode->setDatabaseId(query.value(query.record().indexOf("idEpisode")).toInt());
-        episode->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        const QString nfoContent = QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray());
+        if (!episode->loadDataFromRecord(query.value(query.record().indexOf("record")).toByteArray())) {
+            episode->setNfoContent(nfoContent);
+        }
         episodes.append(episode);
     }
     return episodes;
@@ -667,10 +923,15 @@ int Database::episodeCount()
 }
 
 int Database::showsSettingsId(TvShow* show)
+{
+    return showsSettingsId(show->dir());
+}
+
+int Database::showsSettingsId(const mediaelch::DirectoryPath& dir)
 {
     QSqlQuery query(db());
     query.prepare("SELECT idShow FROM showsSettings WHERE dir=:dir");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
+    query.bindValue(":dir", dir.toString().toUtf8());
     query.exec();
     if (query.next()) {
         return query.value(0).toInt();
@@ -678,7 +939,7 @@ int Database::showsSettingsId(TvShow* show)
 
     query.prepare("INSERT INTO showsSettings(showMissingEpisodes, hideSpecialsInMissingEpisodes, dir) VALUES(:show, "
                   ":hide, :dir)");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
+    query.bindValue(":dir", dir.toString().toUtf8());
     query.bindValue(":show", 0);
     query.bindValue(":hide", 0);
     query.exec();
@@ -749,6 +1010,60 @@ QVector<TvShowEpisode*> Database::showsEpisodes(TvShow* show)
     return episodes;
 }
 
+QByteArray Database::fileHash(const QString& filePath, qint64 size, qint64 lastModified)
+{
+    QSqlQuery query(db());
+    query.prepare("SELECT hash FROM fileHashes WHERE path=:path AND size=:size AND lastModified=:lastModified");
+    query.bindValue(":path", filePath.toUtf8());
+    query.bindValue(":size", size);
+    query.bindValue(":lastModified", lastModified);
+    query.exec();
+    return query.next() ? query.value(0).toByteArray() : QByteArray();
+}
+
+void Database::setFileHash(const QString& filePath, qint64 size, qint64 lastModified, const QByteArray& hash)
+{
+    QSqlQuery query(db());
+    query.prepare("INSERT OR REPLACE INTO fileHashes(path, size, lastModified, hash) "
+                  "VALUES(:path, :size, :lastModified, :hash)");
+    query.bindValue(":path", filePath.toUtf8());
+    query.bindValue(":size", size);
+    query.bindValue(":lastModified", lastModified);
+    query.bindValue(":hash", hash);
+    query.exec();
+}
+
+void Database::removeFileHash(const QString& filePath)
+{
+    QSqlQuery query(db());
+    query.prepare("DELETE FROM fileHashes WHERE path=:path");
+    query.bindValue(":path", filePath.toUtf8());
+    query.exec();
+}
+
+QByteArray Database::mediaInfo(const QString& filePath, qint64 size, qint64 lastModified)
+{
+    QSqlQuery query(db());
+    query.prepare("SELECT record FROM mediaInfo WHERE path=:path AND size=:size AND lastModified=:lastModified");
+    query.bindValue(":path", filePath.toUtf8());
+    query.bindValue(":size", size);
+    query.bindValue(":lastModified", lastModified);
+    query.exec();
+    return query.next() ? query.value(0).toByteArray() : QByteArray();
+}
+
+void Database::setMediaInfo(const QString& filePath, qint64 size, qint64 lastModified, const QByteArray& record)
+{
+    QSqlQuery query(db());
+    query.prepare("INSERT OR REPLACE INTO mediaInfo(path, size, lastModified, record) "
+                  "VALUES(:path, :size, :lastModified, :record)");
+    query.bindValue(":path", filePath.toUtf8());
+    query.bindValue(":size", size);
+    query.bindValue(":lastModified", lastModified);
+    query.bindValue(":record", record);
+    query.exec();
+}
+
 void Database::addImport(QString fileName, QString type, DirectoryPath path)
 {
     int id = 1;
@@ -788,33 +1103,30 @@ bool Database::guessImport(QString fileName, QString& type, QString& path)
 
 void Database::setLabel(const mediaelch::FileList& fileNames, ColorLabel colorLabel)
 {
-    // no locker, as this function is called by add()
-
-    int color = static_cast<int>(colorLabel);
-    QSqlQuery query(db());
-    int id = 1;
-    query.prepare("SELECT MAX(idLabel) FROM labels");
-    query.exec();
-    if (query.next()) {
-        id = query.value(0).toInt() + 1;
-    }
+    setLabels(fileNames, QVector<ColorLabel>(fileNames.size(), colorLabel));
+}
 
-    for (const mediaelch::FilePath& fileName : fileNames) {
-        query.prepare("SELECT idLabel FROM labels WHERE fileName=:fileName");
-        query.bindValue(":fileName", fileName.toString().toUtf8());
-        query.exec();
-        if (query.next()) {
-            int idLabel = query.value(query.record().indexOf("idLabel")).toInt();
-            query.prepare("UPDATE labels SET color=:color WHERE idLabel=:idLabel");
-            query.bindValue(":idLabel", idLabel);
-            query.bindValue(":color", color);
-            query.exec();
-        } else {
-            query.prepare("INSERT INTO labels(idLabel, color, fileName) VALUES(:idLabel, :color, :fileName)");
-            query.bindValue(":idLabel", id);
-            query.bindValue(":color", color);
-            query.bindValue(":fileName", fileName.toString().toUtf8());
-            query.exec();
+void Database::setLabels(const mediaelch::FileList& fileNames, const QVector<ColorLabel>& colorLabels)
+{
+    // no locker, as this function is called by add()
+    Q_ASSERT(fileNames.size() == colorLabels.size());
+
+    QSqlQuery update(db());
+    update.prepare("UPDATE labels SET color=:color WHERE fileName=:fileName");
+    QSqlQuery insert(db());
+    insert.prepare("INSERT INTO labels(color, fileName) VALUES(:color, :fileName)");
+
+    for (int i = 0; i < fileNames.size(); ++i) {
+        const int color = static_cast<int>(colorLabels[i]);
+        const QByteArray fileName = fileNames[i].toString().toUtf8();
+        update.bindValue(":color", color);
+        update.bindValue(":fileName", fileName);
+        update.exec();
+        // Files without label don't need an entry, see getLabel().
+        if (update.numRowsAffected() <= 0 && colorLabels[i] != ColorLabel::NoLabel) {
+            insert.bindValue(":color", color);
+            insert.bindValue(":fileName", fileName);
+            insert.exec();
         }
     }
 }
@@ -1022,11 +1334,112 @@ void Database::setupDatabase()
         query.exec();
 
         myDbVersion = 16;
-        Q_UNUSED(myDbVersion);
         updateDbVersion(16);
     }
 
-    query.prepare("PRAGMA synchronous=0;");
+    if (myDbVersion < 17) {
+        query.prepare("CREATE TABLE IF NOT EXISTS movieDirectoryManifest( "
+                      "\"idEntry\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
+                      "\"path\" text NOT NULL, "
+                      "\"dir\" text NOT NULL, "
+                      "\"lastModified\" integer NOT NULL, "
+                      "\"size\" integer NOT NULL, "
+                      "\"inode\" integer NOT NULL "
+                      ");");
+        query.exec();
+        query.prepare("CREATE INDEX id_movie_manifest_path_idx ON movieDirectoryManifest(path);");
+        query.exec();
+
+        myDbVersion = 17;
+        updateDbVersion(17);
+    }
+
+    if (myDbVersion < 18) {
+        // The label index of version 14 was created on a non-existing table.
+        query.prepare("CREATE INDEX IF NOT EXISTS id_label_filename_idx ON labels(fileName);");
+        query.exec();
+        query.prepare("CREATE INDEX IF NOT EXISTS id_movie_path_idx ON movies(path);");
+        query.exec();
+        query.prepare("CREATE INDEX IF NOT EXISTS id_episode_show_idx ON episodes(idShow);");
+        query.exec();
+
+        myDbVersion = 18;
+        updateDbVersion(18);
+    }
+
+    if (myDbVersion < 19) {
+        // Pre-parsed NFO contents, see DatabaseRecord.h; NULL for existing entries.
+        query.prepare("ALTER TABLE movies ADD COLUMN \"record\" blob;");
+        query.exec();
+        query.prepare("ALTER TABLE episodes ADD COLUMN \"record\" blob;");
+        query.exec();
+
+        myDbVersion = 19;
+        updateDbVersion(19);
+    }
+
+    if (myDbVersion < 20) {
+        // Cached result of Movie::hasLocalTrailer(); NULL for existing entries.
+        query.prepare("ALTER TABLE movies ADD COLUMN \"hasLocalTrailer\" integer;");
+        query.exec();
+
+        myDbVersion = 20;
+        updateDbVersion(20);
+    }
+
+    if (myDbVersion < 21) {
+        // Content hashes of written NFO files and images, see SaveJob.
+        query.prepare("CREATE TABLE IF NOT EXISTS fileHashes( "
+                      "\"path\" text NOT NULL PRIMARY KEY, "
+                      "\"size\" integer NOT NULL, "
+                      "\"lastModified\" integer NOT NULL, "
+                      "\"hash\" blob NOT NULL "
+                      ");");
+        query.exec();
+
+        myDbVersion = 21;
+        updateDbVersion(21);
+    }
+
+    if (myDbVersion < 22) {
+        // Stream details read by libmediainfo, see MediaInfoIndexer.  Like fileHashes, this table
+        // is not cleared when reloading the library.
+        query.prepare("CREATE TABLE IF NOT EXISTS mediaInfo( "
+                      "\"path\" text NOT NULL PRIMARY KEY, "
+                      "\"size\" integer NOT NULL, "
+                      "\"lastModified\" integer NOT NULL, "
+                      "\"record\" blob NOT NULL "
+                      ");");
+        query.exec();
+
+        myDbVersion = 22;
+        updateDbVersion(22);
+    }
+
+    if (myDbVersion < 23) {
+        // NFO and image files of each directory, so that files edited in place are detected.
+        // Existing manifests don't know these files; all movie directories are scanned once.
+        query.prepare("ALTER TABLE movieDirectoryManifest ADD COLUMN \"metadataFiles\" text NOT NULL DEFAULT '';");
+        query.exec();
+        query.prepare(
+            "ALTER TABLE movieDirectoryManifest ADD COLUMN \"metadataModified\" integer NOT NULL DEFAULT 0;");
+        query.exec();
+        query.prepare("ALTER TABLE movieDirectoryManifest ADD COLUMN \"metadataSize\" integer NOT NULL DEFAULT 0;");
+        query.exec();
+        query.prepare("DELETE FROM movieDirectoryManifest;");
+        query.exec();
+
+        myDbVersion = 23;
+        Q_UNUSED(myDbVersion);
+        updateDbVersion(23);
+    }
+
+    // Write-ahead logging: Readers (e.g. the database loaders in other threads) don't block
+    // writers and vice versa.  With WAL, "NORMAL" only syncs on checkpoints, not on each commit.
+    query.prepare("PRAGMA journal_mode=WAL;");
+    query.exec();
+
+    query.prepare("PRAGMA synchronous=NORMAL;");
     query.exec();
 
     query.prepare("PRAGMA cache_size=20000;");
@@ -1052,6 +1465,17 @@ void Database::clearArtistsInDirectory(DirectoryPath path)
     clearAlbumsInDirectory(path);
 }
 
+void Database::clearArtistInDirectory(DirectoryPath dir)
+{
+    QSqlQuery query(db());
+    query.prepare("DELETE FROM albums WHERE idArtist IN (SELECT idArtist FROM artists WHERE dir=:dir)");
+    query.bindValue(":dir", dir.toString().toUtf8());
+    query.exec();
+    query.prepare("DELETE FROM artists WHERE dir=:dir");
+    query.bindValue(":dir", dir.toString().toUtf8());
+    query.exec();
+}
+
 void Database::add(Artist* artist, DirectoryPath path)
 {
     QSqlQuery query(db());
@@ -1066,11 +1490,21 @@ void Database::add(Artist* artist, DirectoryPath path)
 
 void Database::update(Artist* artist)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE artists SET content=:content WHERE idArtist=:id");
-    query.bindValue(":content", artist->nfoContent().isEmpty() ? "" : artist->nfoContent());
-    query.bindValue(":id", artist->databaseId());
-    query.exec();
+    updateFor(artist)(*this);
+}
+
+Database::Update Database::updateFor(Artist* artist)
+{
+    const int id = artist->databaseId();
+    const QString content = artist->nfoContent();
+
+    return [=](Database& database) {
+        QSqlQuery query(database.db());
+        query.prepare("UPDATE artists SET content=:content WHERE idArtist=:id");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":id", id);
+        query.exec();
+    };
 }
 
 QVector<Artist*> Database::artistsInDirectory(DirectoryPath path)
@@ -1122,11 +1556,21 @@ void Database::add(Album* album, DirectoryPath path)
 
 void Database::update(Album* album)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE albums SET content=:content WHERE idAlbum=:id");
-    query.bindValue(":content", album->nfoContent().isEmpty() ? "" : album->nfoContent());
-    query.bindValue(":id", album->databaseId());
-    query.exec();
+    updateFor(album)(*this);
+}
+
+Database::Update Database::updateFor(Album* album)
+{
+    const int id = album->databaseId();
+    const QString content = album->nfoContent();
+
+    return [=](Database& database) {
+        QSqlQuery query(database.db());
+        query.prepare("UPDATE albums SET content=:content WHERE idAlbum=:id");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":id", id);
+        query.exec();
+    };
 }
 
 QVector<Album*> Database::albums(Artist* artist)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "file/DirectoryManifest.h"
 #include "file/Path.h"
 #include "globals/Globals.h"
 #include "tv_shows/TvDbId.h"
@@ -9,6 +10,7 @@
 #include <QString>
 #include <QStringList>
 #include <QVector>
+#include <functional>
 
 class Album;
 class Artist;
@@ -21,6 +23,11 @@ class Database : public QObject
 {
     Q_OBJECT
 public:
+    /// \brief   Writes the details of a single item using the given connection.
+    /// \details Created by updateFor() which copies all details, so that it can be
+    ///          called with the connection of another thread, see SaveQueue.
+    using Update = std::function<void(Database&)>;
+
     explicit Database(QObject* parent = nullptr);
     ~Database() override;
 
@@ -33,24 +40,38 @@ public:
     void clearAllMovies();
     void clearMoviesInDirectory(mediaelch::DirectoryPath path);
     void addMovie(Movie* movie, mediaelch::DirectoryPath path);
+    /// \brief   Adds all given movies using one prepared statement per table.
+    /// \details Should be called inside a transaction.  Movie labels are stored as well.
+    void addMovies(const QVector<Movie*>& movies, mediaelch::DirectoryPath path);
+    void removeMovie(int idMovie);
     void update(Movie* movie);
+    static Update updateFor(Movie* movie);
     QVector<Movie*> moviesInDirectory(mediaelch::DirectoryPath path, QObject* movieParent);
+    /// \brief Directory states of the given movie directory at the time of its last scan.
+    mediaelch::DirectoryManifest movieDirectoryManifest(mediaelch::DirectoryPath path);
+    void setMovieDirectoryManifest(mediaelch::DirectoryPath path, const mediaelch::DirectoryManifest& manifest);
 
     void clearAllConcerts();
     void clearConcertsInDirectory(mediaelch::DirectoryPath path);
     void add(Concert* concert, mediaelch::DirectoryPath path);
+    void removeConcert(int idConcert);
     void update(Concert* concert);
+    static Update updateFor(Concert* concert);
     QVector<Concert*> concertsInDirectory(mediaelch::DirectoryPath path);
 
     void add(TvShow* show, mediaelch::DirectoryPath path);
     void add(TvShowEpisode* episode, mediaelch::DirectoryPath path, int idShow);
+    /// \brief Adds all given episodes using one prepared statement per table.
+    void addEpisodes(const QVector<TvShowEpisode*>& episodes, mediaelch::DirectoryPath path, int idShow);
     void update(TvShow* show);
+    static Update updateFor(TvShow* show);
     void update(TvShowEpisode* episode);
+    static Update updateFor(TvShowEpisode* episode);
     void clearAllTvShows();
     void clearTvShowsInDirectory(mediaelch::DirectoryPath path);
     void clearTvShowInDirectory(mediaelch::DirectoryPath path);
     int showCount(mediaelch::DirectoryPath path);
-    QVector<TvShow*> showsInDirectory(mediaelch::DirectoryPath path);
+    QVector<TvShow*> showsInDirectory(mediaelch::DirectoryPath path, QObject* showParent);
     QVector<TvShowEpisode*> episodes(int idShow);
     int episodeCount();
 
@@ -64,24 +85,47 @@ public:
 
     void clearAllArtists();
     void clearArtistsInDirectory(mediaelch::DirectoryPath path);
+    /// \brief Removes the artist in the given directory (not the music root) and its albums.
+    void clearArtistInDirectory(mediaelch::DirectoryPath dir);
     void add(Artist* artist, mediaelch::DirectoryPath path);
     void update(Artist* artist);
+    static Update updateFor(Artist* artist);
     QVector<Artist*> artistsInDirectory(mediaelch::DirectoryPath path);
 
     void clearAllAlbums();
     void clearAlbumsInDirectory(mediaelch::DirectoryPath path);
     void add(Album* album, mediaelch::DirectoryPath path);
     void update(Album* album);
+    static Update updateFor(Album* album);
     QVector<Album*> albums(Artist* artist);
 
+    /// \brief   Hash of the file's content when it was last written by MediaElch, see SaveJob.
+    /// \details Empty if unknown or if the file's size or modification time changed since.
+    QByteArray fileHash(const QString& filePath, qint64 size, qint64 lastModified);
+    void setFileHash(const QString& filePath, qint64 size, qint64 lastModified, const QByteArray& hash);
+    void removeFileHash(const QString& filePath);
+
+    /// \brief   Stream details of the file as read by libmediainfo, see MediaInfoIndexer.
+    /// \details Empty if unknown or if the file's size or modification time changed since.
+    QByteArray mediaInfo(const QString& filePath, qint64 size, qint64 lastModified);
+    void setMediaInfo(const QString& filePath, qint64 size, qint64 lastModified, const QByteArray& record);
+
     void addImport(QString fileName, QString type, mediaelch::DirectoryPath path);
     bool guessImport(QString fileName, QString& type, QString& path);
 
     void setLabel(const mediaelch::FileList& fileNames, ColorLabel color);
+    /// \brief Sets the label for each file. Both lists must have the same size.
+    void setLabels(const mediaelch::FileList& fileNames, const QVector<ColorLabel>& colors);
     ColorLabel getLabel(const mediaelch::FileList& fileNames);
 
 private:
     void setupDatabase();
+    int showsSettingsId(const mediaelch::DirectoryPath& dir);
+    /// \brief Record of the movie's NFO details or an empty byte array if it has no NFO.
+    static QByteArray movieRecord(Movie* movie);
+    static QByteArray episodeRecord(TvShowEpisode* episode);
+    /// \brief Inserts all files into the given file table (e.g. movieFiles) using execBatch().
+    void insertFiles(const QString& table, const QString& idColumn, int id, const mediaelch::FileList& files);
 
 private:
     mediaelch::DirectoryPath m_dataLocation;
@@ -0,0 +1,471 @@
+#include "data/DatabaseRecord.h"
+
+#include "globals/Meta.h"
+#include "movies/Movie.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QDataStream>
+#include <QIODevice>
+#include <array>
+
+namespace {
+
+/// \brief Identifies MediaElch records, ASCII "MERC".
+constexpr quint32 RECORD_MAGIC = 0x4d455243;
+/// \brief Increase these versions if a record's layout changes.
+///        Records of other versions are ignored and the NFO is parsed instead.
+constexpr quint16 MOVIE_RECORD_VERSION = 1;
+constexpr quint16 EPISODE_RECORD_VERSION = 1;
+constexpr quint16 MEDIA_INFO_RECORD_VERSION = 1;
+/// \brief Fixed so that records do not depend on the Qt version they were written with.
+constexpr QDataStream::Version STREAM_VERSION = QDataStream::Qt_5_6;
+
+// Same order as in KodiXml::readStreamDetails() so that the loaded state is identical.
+const std::array<StreamDetails::AudioDetails, 3> AUDIO_DETAILS{
+    StreamDetails::AudioDetails::Codec, StreamDetails::AudioDetails::Language, StreamDetails::AudioDetails::Channels};
+
+void writeHeader(QDataStream& out, quint16 version)
+{
+    out.setVersion(STREAM_VERSION);
+    out << RECORD_MAGIC << version;
+}
+
+bool readHeader(QDataStream& in, quint16 expectedVersion)
+{
+    in.setVersion(STREAM_VERSION);
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    return in.status() == QDataStream::Ok && magic == RECORD_MAGIC && version == expectedVersion;
+}
+
+void writeRatings(QDataStream& out, const Ratings& ratings)
+{
+    out << static_cast<qint32>(ratings.size());
+    for (const Rating& rating : ratings) {
+        out << rating.source << rating.rating << rating.maxRating << rating.minRating
+            << static_cast<qint32>(rating.voteCount);
+    }
+}
+
+void readRatings(QDataStream& in, Ratings& ratings)
+{
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        Rating rating;
+        qint32 voteCount = 0;
+        in >> rating.source >> rating.rating >> rating.maxRating >> rating.minRating >> voteCount;
+        rating.voteCount = voteCount;
+        ratings.addRating(rating);
+    }
+}
+
+void writeActors(QDataStream& out, const Actors& actors)
+{
+    const QVector<const Actor*> actorList = actors.actors();
+    out << static_cast<qint32>(actorList.size());
+    for (const Actor* actor : actorList) {
+        out << actor->name << actor->role << actor->thumb << actor->id << static_cast<qint32>(actor->order);
+    }
+}
+
+QVector<Actor> readActors(QDataStream& in)
+{
+    QVector<Actor> actors;
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        Actor actor;
+        qint32 order = 0;
+        in >> actor.name >> actor.role >> actor.thumb >> actor.id >> order;
+        actor.order = order;
+        actor.imageHasChanged = false;
+        actors.append(actor);
+    }
+    return actors;
+}
+
+void writePosters(QDataStream& out, const QVector<Poster>& posters)
+{
+    out << static_cast<qint32>(posters.size());
+    for (const Poster& poster : posters) {
+        out << poster.originalUrl << poster.thumbUrl << poster.aspect;
+    }
+}
+
+QVector<Poster> readPosters(QDataStream& in)
+{
+    QVector<Poster> posters;
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        Poster poster;
+        in >> poster.originalUrl >> poster.thumbUrl >> poster.aspect;
+        posters.append(poster);
+    }
+    return posters;
+}
+
+void writeStreamValues(QDataStream& out, const StreamDetails::Values& values)
+{
+    out << static_cast<qint32>(values.video.size());
+    for (auto it = values.video.cbegin(); it != values.video.cend(); ++it) {
+        out << static_cast<qint32>(it.key()) << it.value();
+    }
+
+    // Streams are stored with their index because the vectors may contain empty entries.
+    out << static_cast<qint32>(values.audio.size());
+    for (const auto& stream : values.audio) {
+        for (const auto detail : AUDIO_DETAILS) {
+            out << stream.contains(detail) << stream.value(detail);
+        }
+    }
+
+    out << static_cast<qint32>(values.subtitles.size());
+    for (const auto& stream : values.subtitles) {
+        out << stream.contains(StreamDetails::SubtitleDetails::Language)
+            << stream.value(StreamDetails::SubtitleDetails::Language);
+    }
+}
+
+StreamDetails::Values readStreamValues(QDataStream& in)
+{
+    StreamDetails::Values values;
+
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        qint32 key = 0;
+        QString value;
+        in >> key >> value;
+        values.video.insert(static_cast<StreamDetails::VideoDetails>(key), value);
+    }
+
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QMap<StreamDetails::AudioDetails, QString> stream;
+        for (const auto detail : AUDIO_DETAILS) {
+            bool hasValue = false;
+            QString value;
+            in >> hasValue >> value;
+            if (hasValue) {
+                stream.insert(detail, value);
+            }
+        }
+        values.audio.push_back(stream);
+    }
+
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QMap<StreamDetails::SubtitleDetails, QString> stream;
+        bool hasValue = false;
+        QString value;
+        in >> hasValue >> value;
+        if (hasValue) {
+            stream.insert(StreamDetails::SubtitleDetails::Language, value);
+        }
+        values.subtitles.push_back(stream);
+    }
+    return values;
+}
+
+void writeStreamDetails(QDataStream& out, bool loaded, const StreamDetails* details)
+{
+    // Movies without files have no stream details object.
+    loaded = loaded && details != nullptr;
+    out << loaded;
+    if (loaded) {
+        writeStreamValues(out, details->values());
+    }
+}
+
+bool readStreamDetails(QDataStream& in, StreamDetails* details)
+{
+    bool loaded = false;
+    in >> loaded;
+    if (details != nullptr) {
+        details->clear();
+    }
+    if (!loaded || details == nullptr) {
+        // Records with stream details are only written for items with files.
+        return false;
+    }
+    details->setValues(readStreamValues(in));
+    return true;
+}
+
+} // namespace
+
+namespace mediaelch {
+
+QByteArray serializeMovieRecord(Movie& movie)
+{
+    QByteArray record;
+    QDataStream out(&record, QIODevice::WriteOnly);
+    writeHeader(out, MOVIE_RECORD_VERSION);
+
+    const MovieSet set = movie.set();
+    const ResumeTime resume = movie.resumeTime();
+
+    out << movie.name() << movie.originalName() << movie.sortTitle() << movie.overview() << movie.outline()
+        << movie.tagline();
+    out << set.tmdbId.toString() << set.name << set.overview;
+    out << static_cast<qint32>(movie.playcount()) << static_cast<qint32>(movie.top250()) << movie.userRating();
+    out << movie.tags() << movie.studios() << movie.genres() << movie.countries();
+    out << movie.dateAdded() << movie.lastPlayed() << movie.released();
+    out << static_cast<qint64>(movie.runtime().count()) << resume.position << resume.total;
+    out << movie.certification().toString() << movie.imdbId().toString() << movie.tmdbId().toString();
+    out << movie.trailer() << movie.writer() << movie.director();
+    writeRatings(out, movie.ratings());
+    writeActors(out, movie.actors());
+    writePosters(out, movie.images().posters());
+    writePosters(out, movie.images().backdrops());
+    writeStreamDetails(out, movie.streamDetailsLoaded(), movie.streamDetails());
+
+    return record;
+}
+
+bool deserializeMovieRecord(const QByteArray& record, Movie& movie)
+{
+    if (record.isEmpty()) {
+        return false;
+    }
+
+    QDataStream in(record);
+    if (!readHeader(in, MOVIE_RECORD_VERSION)) {
+        return false;
+    }
+
+    // Same as KodiXml::loadMovie()
+    movie.clear();
+    movie.setChanged(false);
+
+    QString name;
+    QString originalName;
+    QString sortTitle;
+    QString overview;
+    QString outline;
+    QString tagline;
+    in >> name >> originalName >> sortTitle >> overview >> outline >> tagline;
+
+    QString setTmdbId;
+    MovieSet set;
+    in >> setTmdbId >> set.name >> set.overview;
+    set.tmdbId = TmdbId(setTmdbId);
+
+    qint32 playcount = 0;
+    qint32 top250 = 0;
+    double userRating = 0.0;
+    in >> playcount >> top250 >> userRating;
+
+    QStringList tags;
+    QStringList studios;
+    QStringList genres;
+    QStringList countries;
+    in >> tags >> studios >> genres >> countries;
+
+    QDateTime dateAdded;
+    QDateTime lastPlayed;
+    QDate released;
+    in >> dateAdded >> lastPlayed >> released;
+
+    qint64 runtime = 0;
+    ResumeTime resume;
+    in >> runtime >> resume.position >> resume.total;
+
+    QString certification;
+    QString imdbId;
+    QString tmdbId;
+    in >> certification >> imdbId >> tmdbId;
+
+    QUrl trailer;
+    QString writer;
+    QString director;
+    in >> trailer >> writer >> director;
+
+    movie.setName(name);
+    movie.setOriginalName(originalName);
+    movie.setSortTitle(sortTitle);
+    movie.setOverview(overview);
+    movie.setOutline(outline);
+    movie.setTagline(tagline);
+    movie.setSet(set);
+    movie.setPlayCount(playcount);
+    movie.setTop250(top250);
+    movie.setUserRating(userRating);
+    for (const QString& tag : asConst(tags)) {
+        movie.addTag(tag);
+    }
+    for (const QString& studio : asConst(studios)) {
+        movie.addStudio(studio);
+    }
+    for (const QString& genre : asConst(genres)) {
+        movie.addGenre(genre);
+    }
+    for (const QString& country : asConst(countries)) {
+        movie.addCountry(country);
+    }
+    movie.setDateAdded(dateAdded);
+    movie.setLastPlayed(lastPlayed);
+    movie.setReleased(released);
+    movie.setRuntime(std::chrono::minutes(runtime));
+    movie.setResumeTime(resume);
+    movie.setCertification(Certification(certification));
+    movie.setImdbId(ImdbId(imdbId));
+    movie.setTmdbId(TmdbId(tmdbId));
+    movie.setTrailer(trailer);
+    movie.setWriter(writer);
+    movie.setDirector(director);
+
+    readRatings(in, movie.ratings());
+    movie.setActors(readActors(in));
+    const QVector<Poster> posters = readPosters(in);
+    for (const Poster& poster : posters) {
+        movie.images().addPoster(poster);
+    }
+    const QVector<Poster> backdrops = readPosters(in);
+    for (const Poster& backdrop : backdrops) {
+        movie.images().addBackdrop(backdrop);
+    }
+    movie.setStreamDetailsLoaded(readStreamDetails(in, movie.streamDetails()));
+
+    return in.status() == QDataStream::Ok;
+}
+
+QByteArray serializeEpisodeRecord(TvShowEpisode& episode)
+{
+    QByteArray record;
+    QDataStream out(&record, QIODevice::WriteOnly);
+    writeHeader(out, EPISODE_RECORD_VERSION);
+
+    out << episode.imdbId().toString() << episode.tvdbId().toString() << episode.tmdbId().toString()
+        << episode.tvmazeId().toString();
+    out << episode.title() << episode.showTitle() << episode.overview() << episode.network();
+    out << static_cast<qint32>(episode.seasonNumber().toInt()) << static_cast<qint32>(episode.episodeNumber().toInt())
+        << static_cast<qint32>(episode.displaySeason().toInt())
+        << static_cast<qint32>(episode.displayEpisode().toInt());
+    out << static_cast<qint32>(episode.top250()) << episode.userRating() << static_cast<qint32>(episode.playCount());
+    out << episode.certification().toString() << episode.firstAired() << episode.lastPlayed()
+        << episode.epBookmark();
+    out << episode.tags() << episode.writers() << episode.directors() << episode.thumbnail();
+    writeRatings(out, episode.ratings());
+    writeActors(out, episode.actors());
+    writeStreamDetails(out, episode.streamDetailsLoaded(), episode.streamDetails());
+
+    return record;
+}
+
+bool deserializeEpisodeRecord(const QByteArray& record, TvShowEpisode& episode)
+{
+    if (record.isEmpty()) {
+        return false;
+    }
+
+    QDataStream in(record);
+    if (!readHeader(in, EPISODE_RECORD_VERSION)) {
+        return false;
+    }
+
+    // Same as KodiXml::loadTvShowEpisode()
+    episode.clear();
+    episode.setChanged(false);
+
+    QString imdbId;
+    QString tvdbId;
+    QString tmdbId;
+    QString tvmazeId;
+    in >> imdbId >> tvdbId >> tmdbId >> tvmazeId;
+
+    QString title;
+    QString showTitle;
+    QString overview;
+    QString network;
+    in >> title >> showTitle >> overview >> network;
+
+    qint32 season = 0;
+    qint32 episodeNumber = 0;
+    qint32 displaySeason = 0;
+    qint32 displayEpisode = 0;
+    in >> season >> episodeNumber >> displaySeason >> displayEpisode;
+
+    qint32 top250 = 0;
+    double userRating = 0.0;
+    qint32 playCount = 0;
+    in >> top250 >> userRating >> playCount;
+
+    QString certification;
+    QDate firstAired;
+    QDateTime lastPlayed;
+    QTime epBookmark;
+    in >> certification >> firstAired >> lastPlayed >> epBookmark;
+
+    QStringList tags;
+    QStringList writers;
+    QStringList directors;
+    QUrl thumbnail;
+    in >> tags >> writers >> directors >> thumbnail;
+
+    episode.setImdbId(ImdbId(imdbId));
+    episode.setTvdbId(TvDbId(tvdbId));
+    episode.setTmdbId(TmdbId(tmdbId));
+    episode.setTvMazeId(TvMazeId(tvmazeId));
+    episode.setTitle(title);
+    episode.setShowTitle(showTitle);
+    episode.setOverview(overview);
+    episode.setNetwork(network);
+    episode.setSeason(SeasonNumber(season));
+    episode.setEpisode(EpisodeNumber(episodeNumber));
+    episode.setDisplaySeason(SeasonNumber(displaySeason));
+    episode.setDisplayEpisode(EpisodeNumber(displayEpisode));
+    episode.setTop250(top250);
+    episode.setUserRating(userRating);
+    episode.setPlayCount(playCount);
+    episode.setCertification(Certification(certification));
+    episode.setFirstAired(firstAired);
+    episode.setLastPlayed(lastPlayed);
+    episode.setEpBookmark(epBookmark);
+    for (const QString& tag : asConst(tags)) {
+        episode.addTag(tag);
+    }
+    episode.setWriters(writers);
+    episode.setDirectors(directors);
+    episode.setThumbnail(thumbnail);
+
+    readRatings(in, episode.ratings());
+    const QVector<Actor> actors = readActors(in);
+    for (const Actor& actor : actors) {
+        episode.addActor(actor);
+    }
+    episode.setStreamDetailsLoaded(readStreamDetails(in, episode.streamDetails()));
+
+    return in.status() == QDataStream::Ok;
+}
+
+QByteArray serializeMediaInfoRecord(const StreamDetails::Values& values)
+{
+    QByteArray record;
+    QDataStream out(&record, QIODevice::WriteOnly);
+    writeHeader(out, MEDIA_INFO_RECORD_VERSION);
+    writeStreamValues(out, values);
+    return record;
+}
+
+bool deserializeMediaInfoRecord(const QByteArray& record, StreamDetails::Values& values)
+{
+    if (record.isEmpty()) {
+        return false;
+    }
+    QDataStream in(record);
+    if (!readHeader(in, MEDIA_INFO_RECORD_VERSION)) {
+        return false;
+    }
+    StreamDetails::Values loaded = readStreamValues(in);
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+    values = loaded;
+    return true;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "data/StreamDetails.h"
+
+#include <QByteArray>
+
+class Movie;
+class TvShowEpisode;
+
+namespace mediaelch {
+
+/// \brief   Serializes all details of the given movie that are stored in its NFO file.
+/// \details The record is a compact, versioned binary blob that is stored in the
+///          database alongside the raw NFO content.  Loading a record is much faster
+///          than parsing the NFO's XML, see deserializeMovieRecord().
+QByteArray serializeMovieRecord(Movie& movie);
+
+/// \brief   Loads the movie's details from a record created by serializeMovieRecord().
+/// \details Returns false if the record is empty, was created by an incompatible
+///          version of MediaElch or is corrupt.  In that case the NFO content has to
+///          be parsed instead.  The movie is only cleared if the record's header is valid.
+bool deserializeMovieRecord(const QByteArray& record, Movie& movie);
+
+/// \brief Serializes all details of the given episode that are stored in its NFO file.
+/// \see serializeMovieRecord()
+QByteArray serializeEpisodeRecord(TvShowEpisode& episode);
+
+/// \brief Loads the episode's details from a record created by serializeEpisodeRecord().
+/// \see deserializeMovieRecord()
+bool deserializeEpisodeRecord(const QByteArray& record, TvShowEpisode& episode);
+
+/// \brief Serializes stream details read by libmediainfo, see MediaInfoIndexer.
+QByteArray serializeMediaInfoRecord(const StreamDetails::Values& values);
+
+/// \brief Loads stream details from a record created by serializeMediaInfoRecord().
+/// \details Returns false if the record is empty, incompatible or corrupt.  In that case
+///          the file has to be read again.  The values are only changed on success.
+bool deserializeMediaInfoRecord(const QByteArray& record, StreamDetails::Values& values);
+
+} // namespace mediaelch
@@ -1,34 +1,64 @@
 #include "ImageCache.h"
 
+#include <QCoreApplication>
 #include <QCryptographicHash>
+#include <QDataStream>
 #include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
+#include <QSaveFile>
+
+#include <algorithm>
 
 #include "globals/Globals.h"
 #include "globals/Helper.h"
 #include "log/Log.h"
 #include "settings/Settings.h"
 
-ImageCache::ImageCache(QObject* parent) : QObject(parent)
+namespace {
+
+// Index file format. Increase the version if the layout of the index changes.
+// An unknown version results in an empty cache.
+const quint32 INDEX_MAGIC = 0x454C4943; // "ELIC"
+const quint32 INDEX_VERSION = 1;
+const char* const INDEX_FILE_NAME = "index.dat";
+
+// Quality used for thumbnails without alpha channel.
+const int JPEG_QUALITY = 85;
+
+} // namespace
+
+ImageCache::ImageCache(QObject* parent) :
+    ImageCache(Settings::instance()->imageCacheDir().subDir("images"), DEFAULT_MAX_CACHE_SIZE, parent)
 {
-    mediaelch::DirectoryPath location = Settings::instance()->imageCacheDir();
-    QDir dir(location.dir());
-    if (!dir.exists()) {
-        dir.mkdir(location.toString());
-    }
-    location = location.subDir("images");
-    dir.setPath(location.toString());
-    bool exists = dir.exists();
-    if (!exists) {
-        exists = dir.mkdir(location.toString());
-    }
-    if (exists) {
-        m_cacheDir = location;
+    m_forceCache = Settings::instance()->advanced()->forceCache();
+}
+
+ImageCache::ImageCache(mediaelch::DirectoryPath cacheDir, qint64 maxCacheSize, QObject* parent) :
+    QObject(parent), m_maxCacheSize{maxCacheSize}
+{
+    if (cacheDir.isValid() && QDir().mkpath(cacheDir.toString())) {
+        m_cacheDir = cacheDir;
     }
     qCDebug(generic) << "[ImageCache] Using cache dir:" << m_cacheDir;
 
-    m_forceCache = Settings::instance()->advanced()->forceCache();
+    // Writing the index is debounced: Many thumbnails are created when a list of
+    // movies is shown for the first time and we don't want to write the index each time.
+    // Cache hits only mark the index as changed; it is written with the next insertion,
+    // eviction or at shutdown.
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(5000);
+    connect(&m_saveTimer, &QTimer::timeout, this, &ImageCache::saveIndex);
+    if (QCoreApplication::instance() != nullptr) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &ImageCache::saveIndex);
+    }
+
+    loadIndex();
+}
+
+ImageCache::~ImageCache()
+{
+    saveIndex();
 }
 
 ImageCache* ImageCache::instance(QObject* parent)
@@ -37,47 +67,75 @@ ImageCache* ImageCache::instance(QObject* parent)
     return s_instance;
 }
 
+constexpr qint64 ImageCache::DEFAULT_MAX_CACHE_SIZE;
+
 QImage ImageCache::image(mediaelch::FilePath path, int width, int height, int& origWidth, int& origHeight)
 {
     if (!m_cacheDir.isValid()) {
-        return scaledImage(helper::getImage(path), width, height);
-    }
-
-    QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QString baseName = QString("%1_%2_%3_").arg(md5).arg(width).arg(height);
-
-    bool update = true;
-    QDir dir = m_cacheDir.dir();
-    QStringList files = dir.entryList(QStringList() << baseName + "*");
-    if (!files.isEmpty()) {
-        QString fileName = files.first();
-        QStringList parts = fileName.split("_");
-        if (parts.count() > 6) {
-            origWidth = parts.at(3).toInt();
-            origHeight = parts.at(4).toInt();
-            if (m_forceCache || (parts.at(5).toInt() > 0 && parts.at(5).toUInt() == getLastModified(path))) {
-                update = false;
+        QImage origImg = helper::getImage(path);
+        origWidth = origImg.width();
+        origHeight = origImg.height();
+        return scaledImage(origImg, width, height);
+    }
+
+    const QByteArray hash = pathHash(path);
+
+    auto entryIt = m_index.find(hash);
+    if (entryIt != m_index.end() && isUpToDate(entryIt.value(), path)) {
+        for (Thumbnail& thumbnail : entryIt->thumbnails) {
+            if (thumbnail.width != width || thumbnail.height != height) {
+                continue;
+            }
+            QImage img = helper::getImage(mediaelch::FilePath(m_cacheDir.filePath(thumbnail.blobName)));
+            if (img.isNull()) {
+                // The blob was removed behind our back; recreate it below.
+                break;
             }
+            origWidth = entryIt->originalSize.width();
+            origHeight = entryIt->originalSize.height();
+            // Only the access time changed: Don't rewrite the index while scrolling.
+            thumbnail.lastAccess = ++m_accessCounter;
+            m_indexChanged = true;
+            return img;
         }
+
+    } else if (entryIt != m_index.end()) {
+        // Source image has changed: All thumbnails are outdated.
+        removeSource(hash);
+        entryIt = m_index.end();
     }
 
-    if (update) {
-        QImage origImg = helper::getImage(path);
-        origWidth = origImg.width();
-        origHeight = origImg.height();
-        QImage img = scaledImage(origImg, width, height);
-        QString fileName = QString("%1_%2_%3_%4_%5_%6_.png")
-                               .arg(md5)
-                               .arg(width)
-                               .arg(height)
-                               .arg(origWidth)
-                               .arg(origHeight)
-                               .arg(getLastModified(path));
-        img.save(m_cacheDir.filePath(fileName), "png", -1);
+    QImage origImg = helper::getImage(path);
+    origWidth = origImg.width();
+    origHeight = origImg.height();
+    QImage img = scaledImage(origImg, width, height);
+    if (img.isNull()) {
         return img;
     }
 
-    return helper::getImage(mediaelch::FilePath(m_cacheDir.filePath(files.first())));
+    SourceEntry& entry = m_index[hash];
+    entry.originalSize = origImg.size();
+    entry.lastModified = getLastModified(path);
+
+    // Remove a possibly existing thumbnail with the same size whose blob is gone.
+    for (auto it = entry.thumbnails.begin(); it != entry.thumbnails.end();) {
+        if (it->width == width && it->height == height) {
+            m_totalBlobSize -= it->blobSize;
+            it = entry.thumbnails.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    Thumbnail thumbnail = storeThumbnail(hash, img, width, height);
+    if (!thumbnail.blobName.isEmpty()) {
+        entry.thumbnails.push_back(thumbnail);
+        m_totalBlobSize += thumbnail.blobSize;
+        evictIfRequired();
+    }
+    scheduleSaveIndex();
+
+    return img;
 }
 
 QImage ImageCache::scaledImage(QImage img, int width, int height)
@@ -99,13 +157,11 @@ void ImageCache::invalidateImages(mediaelch::FilePath path)
     if (!m_cacheDir.isValid()) {
         return;
     }
-
-    QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QDir dir = m_cacheDir.dir();
-    const QStringList entries = dir.entryList(QStringList() << md5 + "*");
-    for (const QString& file : entries) {
-        QFile f(dir.absolutePath() + "/" + file);
-        f.remove();
+    m_lastModifiedTimes.remove(path);
+    const QByteArray hash = pathHash(path);
+    if (m_index.contains(hash)) {
+        removeSource(hash);
+        scheduleSaveIndex();
     }
 }
 
@@ -115,20 +171,12 @@ QSize ImageCache::imageSize(mediaelch::FilePath path)
         return helper::getImage(path).size();
     }
 
-    QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QString baseName = QString("%1_").arg(md5);
-    QDir dir = m_cacheDir.dir();
-    QStringList files = dir.entryList(QStringList() << baseName + "*");
-    if (files.isEmpty() || files.first().split("_").count() < 7) {
+    auto entryIt = m_index.constFind(pathHash(path));
+    if (entryIt == m_index.constEnd() || !isUpToDate(entryIt.value(), path)) {
         return helper::getImage(path).size();
     }
 
-    QStringList parts = files.first().split("_");
-    if (!m_forceCache && parts.at(5).toInt() > 0 && getLastModified(path) != parts.at(5).toUInt()) {
-        return helper::getImage(path).size();
-    }
-
-    return {parts.at(3).toInt(), parts.at(4).toInt()};
+    return entryIt->originalSize;
 }
 
 qint64 ImageCache::getLastModified(const mediaelch::FilePath& fileName)
@@ -147,8 +195,223 @@ void ImageCache::clearCache()
     if (!m_cacheDir.isValid() || !Settings::instance()->advanced()->forceCache()) {
         return;
     }
+    m_saveTimer.stop();
+    m_index.clear();
+    m_totalBlobSize = 0;
+    m_accessCounter = 0;
+    m_indexChanged = false;
+
     const auto entries = m_cacheDir.dir().entryInfoList(QDir::Files | QDir::NoDotAndDotDot);
     for (const QFileInfo& file : entries) {
         QFile(file.absoluteFilePath()).remove();
     }
 }
+
+void ImageCache::saveIndex()
+{
+    m_saveTimer.stop();
+    if (!m_cacheDir.isValid() || !m_indexChanged) {
+        return;
+    }
+
+    QSaveFile file(m_cacheDir.filePath(INDEX_FILE_NAME));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(generic) << "[ImageCache] Could not open index for writing:" << file.fileName();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_6);
+    out << INDEX_MAGIC << INDEX_VERSION << m_accessCounter << static_cast<quint32>(m_index.size());
+    for (auto it = m_index.constBegin(); it != m_index.constEnd(); ++it) {
+        const SourceEntry& entry = it.value();
+        out << it.key() << entry.originalSize << entry.lastModified << static_cast<quint32>(entry.thumbnails.size());
+        for (const Thumbnail& thumbnail : entry.thumbnails) {
+            out << static_cast<qint32>(thumbnail.width) << static_cast<qint32>(thumbnail.height) << thumbnail.blobName
+                << thumbnail.blobSize << thumbnail.lastAccess;
+        }
+    }
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(generic) << "[ImageCache] Could not write index:" << file.fileName();
+        return;
+    }
+    m_indexChanged = false;
+}
+
+void ImageCache::loadIndex()
+{
+    if (!m_cacheDir.isValid()) {
+        return;
+    }
+
+    QFile file(m_cacheDir.filePath(INDEX_FILE_NAME));
+    bool loaded = false;
+    if (file.open(QIODevice::ReadOnly)) {
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_5_6);
+        quint32 magic = 0;
+        quint32 version = 0;
+        quint32 sourceCount = 0;
+        in >> magic >> version;
+        if (magic == INDEX_MAGIC && version == INDEX_VERSION) {
+            in >> m_accessCounter >> sourceCount;
+            for (quint32 i = 0; i < sourceCount && in.status() == QDataStream::Ok; ++i) {
+                QByteArray hash;
+                SourceEntry entry;
+                quint32 thumbnailCount = 0;
+                in >> hash >> entry.originalSize >> entry.lastModified >> thumbnailCount;
+                for (quint32 j = 0; j < thumbnailCount && in.status() == QDataStream::Ok; ++j) {
+                    Thumbnail thumbnail;
+                    qint32 width = 0;
+                    qint32 height = 0;
+                    in >> width >> height >> thumbnail.blobName >> thumbnail.blobSize >> thumbnail.lastAccess;
+                    thumbnail.width = width;
+                    thumbnail.height = height;
+                    m_totalBlobSize += thumbnail.blobSize;
+                    entry.thumbnails.push_back(thumbnail);
+                }
+                m_index.insert(hash, entry);
+            }
+            loaded = (in.status() == QDataStream::Ok);
+        }
+        file.close();
+    }
+
+    if (loaded) {
+        qCDebug(generic) << "[ImageCache] Loaded index with" << m_index.size() << "images," << m_totalBlobSize
+                         << "bytes";
+        return;
+    }
+
+    // No (valid) index: Blobs in the directory are unknown to us, e.g. files from
+    // an older MediaElch version. Start with a fresh cache.
+    qCDebug(generic) << "[ImageCache] No valid index found, clearing cache directory";
+    m_index.clear();
+    m_totalBlobSize = 0;
+    m_accessCounter = 0;
+    const auto entries = m_cacheDir.dir().entryInfoList(QDir::Files | QDir::NoDotAndDotDot);
+    for (const QFileInfo& fileInfo : entries) {
+        QFile(fileInfo.absoluteFilePath()).remove();
+    }
+}
+
+void ImageCache::scheduleSaveIndex()
+{
+    m_indexChanged = true;
+    if (!m_saveTimer.isActive()) {
+        m_saveTimer.start();
+    }
+}
+
+QByteArray ImageCache::pathHash(const mediaelch::FilePath& path)
+{
+    return QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
+}
+
+bool ImageCache::isUpToDate(const SourceEntry& entry, const mediaelch::FilePath& path)
+{
+    return m_forceCache || (entry.lastModified > 0 && entry.lastModified == getLastModified(path));
+}
+
+ImageCache::Thumbnail ImageCache::storeThumbnail(const QByteArray& hash, const QImage& img, int width, int height)
+{
+    // JPEG is a lot smaller than PNG but does not support transparency which
+    // is required for e.g. clear arts and logos.
+    const bool hasAlpha = img.hasAlphaChannel();
+    const char* format = hasAlpha ? "png" : "jpg";
+
+    Thumbnail thumbnail;
+    thumbnail.width = width;
+    thumbnail.height = height;
+    thumbnail.lastAccess = ++m_accessCounter;
+
+    const QString blobName = QStringLiteral("%1_%2_%3.%4")
+                                 .arg(QString::fromLatin1(hash))
+                                 .arg(width)
+                                 .arg(height)
+                                 .arg(QString::fromLatin1(format));
+    const QString blobPath = m_cacheDir.filePath(blobName);
+
+    QFile file(blobPath);
+    if (!file.open(QIODevice::WriteOnly) || !img.save(&file, format, hasAlpha ? -1 : JPEG_QUALITY)) {
+        qCWarning(generic) << "[ImageCache] Could not write thumbnail:" << blobPath;
+        file.remove();
+        return thumbnail;
+    }
+    thumbnail.blobSize = file.size();
+    thumbnail.blobName = blobName;
+    return thumbnail;
+}
+
+void ImageCache::removeThumbnailBlob(const Thumbnail& thumbnail)
+{
+    QFile::remove(m_cacheDir.filePath(thumbnail.blobName));
+    m_totalBlobSize -= thumbnail.blobSize;
+}
+
+void ImageCache::removeSource(const QByteArray& hash)
+{
+    auto entryIt = m_index.find(hash);
+    if (entryIt == m_index.end()) {
+        return;
+    }
+    for (const Thumbnail& thumbnail : asConst(entryIt->thumbnails)) {
+        removeThumbnailBlob(thumbnail);
+    }
+    m_index.erase(entryIt);
+}
+
+void ImageCache::evictIfRequired()
+{
+    if (m_totalBlobSize <= maxCacheSize()) {
+        return;
+    }
+
+    // Eviction is rare. Instead of keeping a linked list for LRU ordering,
+    // collect all thumbnails and remove the least recently used ones until
+    // we're below 90% of the maximum size so that we don't evict on each insert.
+    struct Candidate
+    {
+        quint64 lastAccess;
+        QByteArray hash;
+        int width;
+        int height;
+    };
+    QVector<Candidate> candidates;
+    for (auto it = m_index.constBegin(); it != m_index.constEnd(); ++it) {
+        for (const Thumbnail& thumbnail : it->thumbnails) {
+            candidates.push_back({thumbnail.lastAccess, it.key(), thumbnail.width, thumbnail.height});
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+        return lhs.lastAccess < rhs.lastAccess;
+    });
+
+    const qint64 targetSize = maxCacheSize() / 10 * 9;
+    int removed = 0;
+    for (const Candidate& candidate : asConst(candidates)) {
+        if (m_totalBlobSize <= targetSize) {
+            break;
+        }
+        auto entryIt = m_index.find(candidate.hash);
+        if (entryIt == m_index.end()) {
+            continue;
+        }
+        QVector<Thumbnail>& thumbnails = entryIt->thumbnails;
+        for (auto it = thumbnails.begin(); it != thumbnails.end(); ++it) {
+            if (it->width == candidate.width && it->height == candidate.height) {
+                removeThumbnailBlob(*it);
+                thumbnails.erase(it);
+                ++removed;
+                break;
+            }
+        }
+        if (thumbnails.isEmpty()) {
+            m_index.erase(entryIt);
+        }
+    }
+    qCDebug(generic) << "[ImageCache] Evicted" << removed << "thumbnails, cache size is now" << m_totalBlobSize
+                     << "bytes";
+    m_indexChanged = true;
+}
@@ -2,27 +2,84 @@
 
 #include "file/Path.h"
 
+#include <QByteArray>
 #include <QHash>
 #include <QImage>
 #include <QSize>
 #include <QString>
+#include <QTimer>
 #include <QVector>
 
+/// \brief On-disk cache for scaled images (thumbnails).
+///
+/// All cached thumbnails are tracked by an in-memory index that maps the
+/// hash of the source image's path to the source's size, its last modified
+/// time and the thumbnails' blob files.  The index is persisted next to the
+/// blobs so that a cache hit never needs to list the cache directory.
+/// If the blobs exceed maxCacheSize(), the least recently used thumbnails
+/// are removed.
 class ImageCache : public QObject
 {
     Q_OBJECT
 public:
+    static constexpr qint64 DEFAULT_MAX_CACHE_SIZE = 512LL * 1024 * 1024;
+
+    /// \brief Cache in the "images" directory of Settings::imageCacheDir().
     explicit ImageCache(QObject* parent = nullptr);
+    /// \brief Cache in the given directory that is created if it does not exist.
+    ImageCache(mediaelch::DirectoryPath cacheDir, qint64 maxCacheSize, QObject* parent = nullptr);
+    ~ImageCache() override;
     static ImageCache* instance(QObject* parent = nullptr);
     QImage image(mediaelch::FilePath path, int width, int height, int& origWidth, int& origHeight);
     QSize imageSize(mediaelch::FilePath path);
     void invalidateImages(mediaelch::FilePath path);
     void clearCache();
+    /// \brief Writes the cache index to disk if it has changed.
+    void saveIndex();
+
+    /// \brief Maximum size of all thumbnail blobs in bytes.
+    qint64 maxCacheSize() const { return m_maxCacheSize; }
+    /// \brief Size of all thumbnail blobs in bytes.
+    qint64 cacheSize() const { return m_totalBlobSize; }
 
 private:
-    mediaelch::DirectoryPath m_cacheDir;
-    QHash<mediaelch::FilePath, QVector<qint64>> m_lastModifiedTimes;
+    struct Thumbnail
+    {
+        int width = 0;
+        int height = 0;
+        QString blobName;
+        qint64 blobSize = 0;
+        quint64 lastAccess = 0;
+    };
+
+    struct SourceEntry
+    {
+        QSize originalSize;
+        qint64 lastModified = 0;
+        QVector<Thumbnail> thumbnails;
+    };
+
+    static QByteArray pathHash(const mediaelch::FilePath& path);
+
+    void loadIndex();
+    void scheduleSaveIndex();
+    /// \brief Removes all blobs of the given source from disk and the index.
+    void removeSource(const QByteArray& hash);
+    void removeThumbnailBlob(const Thumbnail& thumbnail);
+    void evictIfRequired();
+    bool isUpToDate(const SourceEntry& entry, const mediaelch::FilePath& path);
+    Thumbnail storeThumbnail(const QByteArray& hash, const QImage& img, int width, int height);
+
     QImage scaledImage(QImage img, int width, int height);
     qint64 getLastModified(const mediaelch::FilePath& fileName);
-    bool m_forceCache;
+
+    mediaelch::DirectoryPath m_cacheDir;
+    QHash<mediaelch::FilePath, QVector<qint64>> m_lastModifiedTimes;
+    QHash<QByteArray, SourceEntry> m_index;
+    qint64 m_maxCacheSize = DEFAULT_MAX_CACHE_SIZE;
+    qint64 m_totalBlobSize = 0;
+    quint64 m_accessCounter = 0;
+    bool m_indexChanged = false;
+    QTimer m_saveTimer;
+    bool m_forceCache = false;
 };
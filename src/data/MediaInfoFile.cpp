@@ -9,6 +9,8 @@
 #include <ZenLib/Ztring.h>
 #include <ZenLib/ZtringListList.h>
 
+#include <QMutex>
+#include <QMutexLocker>
 #include <QRegularExpression>
 #include <QStringList>
 
@@ -20,21 +22,39 @@
 #    define MI2QString(_DATA) QString((_DATA).c_str())
 #endif
 
-MediaInfoFile::MediaInfoFile(const QString& filepath) : m_mediaInfo{std::make_unique<MediaInfoDLL::MediaInfo>()}
+namespace {
+
+/// \brief MediaInfoDLL loads and unloads the library when objects are created and deleted,
+///        which is not thread-safe.  Opening files is, see MediaInfoIndexer.
+QMutex s_libraryMutex;
+
+} // namespace
+
+MediaInfoFile::MediaInfoFile(const QString& filepath)
 {
+    {
+        QMutexLocker locker(&s_libraryMutex);
+        m_mediaInfo = std::make_unique<MediaInfoDLL::MediaInfo>();
+    }
     // VERSION;APP_NAME;APP_VERSION"
     m_mediaInfo->Option(__T("Info_Version"), __T("20.03;MediaElch;2.6"));
     m_mediaInfo->Option(__T("Internet"), __T("no"));
     m_mediaInfo->Option(__T("Complete"), __T("1"));
-    m_mediaInfo->Open(QString2MI(filepath));
+    const std::size_t openedFiles = m_mediaInfo->Open(QString2MI(filepath));
     if (!m_mediaInfo->IsReady()) {
         qCCritical(generic) << "[MediaInfo] Unable to load libmediainfo!";
+    } else if (openedFiles == 0) {
+        qCWarning(generic) << "[MediaInfo] Unable to open file:" << filepath;
+    } else {
+        m_isReady = true;
     }
 }
 
 MediaInfoFile::~MediaInfoFile()
 {
     m_mediaInfo->Close();
+    QMutexLocker locker(&s_libraryMutex);
+    m_mediaInfo.reset();
 }
 
 int MediaInfoFile::subtitleCount() const
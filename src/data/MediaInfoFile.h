@@ -16,6 +16,10 @@ public:
     MediaInfoFile(const QString& filepath);
     ~MediaInfoFile();
 
+    /// \brief True if libmediainfo is loaded and the file could be opened.
+    ///        Otherwise all values are empty.
+    bool isReady() const { return m_isReady; }
+
     int subtitleCount() const;
     int videoStreamCount() const;
     int audioStreamCount() const;
@@ -49,4 +53,5 @@ private:
     // We don't want the MediaInfoLib include here so we avoid it by
     // using the forward declaration of the class MediaInfo
     std::unique_ptr<MediaInfoDLL::MediaInfo> m_mediaInfo;
+    bool m_isReady = false;
 };
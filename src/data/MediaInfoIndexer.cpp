@@ -0,0 +1,166 @@
+#include "data/MediaInfoIndexer.h"
+
+#include "data/Database.h"
+#include "data/DatabaseRecord.h"
+#include "log/Log.h"
+
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QStorageInfo>
+#include <QThread>
+#include <QThreadStorage>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+/// \brief Upper limit of files read in parallel, even if they are on different devices.
+constexpr int MAX_INDEXER_THREADS = 4;
+
+/// \brief Database connection of the calling thread. Deleted when the thread exits.
+Database& threadDatabase()
+{
+    static QThreadStorage<Database*> s_connections;
+    if (!s_connections.hasLocalData()) {
+        s_connections.setLocalData(Database::newConnection(nullptr));
+    }
+    return *s_connections.localData();
+}
+
+} // namespace
+
+namespace mediaelch {
+
+StreamDetails::Values MediaInfoIndexer::loadFile(Database& database, const QString& filePath, const ReadFunction& read)
+{
+    const QFileInfo fileInfo(filePath);
+    const qint64 size = fileInfo.size();
+    const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    StreamDetails::Values values;
+    if (mediaelch::deserializeMediaInfoRecord(database.mediaInfo(filePath, size, lastModified), values)) {
+        return values;
+    }
+
+    // Failed reads, e.g. of locked files or because libmediainfo could not be loaded,
+    // are not stored so that the file is read again next time.
+    if (read(filePath, values) && fileInfo.exists()) {
+        database.setMediaInfo(filePath, size, lastModified, mediaelch::serializeMediaInfoRecord(values));
+    }
+    return values;
+}
+
+StreamDetails::Values MediaInfoIndexer::load(const mediaelch::FileList& files)
+{
+    const mediaelch::FileList mediaFiles = StreamDetails::mediaInfoFiles(files);
+    if (mediaFiles.isEmpty()) {
+        return {};
+    }
+
+    Database& database = threadDatabase();
+    StreamDetails::Values values = loadFile(database, mediaFiles.first().toString(), StreamDetails::readFile);
+    if (mediaFiles.size() > 1) {
+        qint64 duration = values.video.value(StreamDetails::VideoDetails::DurationInSeconds).toLongLong();
+        for (int i = 1; i < mediaFiles.size(); ++i) {
+            const StreamDetails::Values part = loadFile(database, mediaFiles[i].toString(), StreamDetails::readFile);
+            duration += part.video.value(StreamDetails::VideoDetails::DurationInSeconds).toLongLong();
+        }
+        values.video.insert(StreamDetails::VideoDetails::DurationInSeconds, QString::number(duration));
+    }
+    return values;
+}
+
+MediaInfoIndexer::MediaInfoIndexer(QObject* parent) : QObject(parent)
+{
+    m_threadPool.setMaxThreadCount(std::max(1, std::min(QThread::idealThreadCount(), MAX_INDEXER_THREADS)));
+    // Keep the threads and with them their database connections.
+    m_threadPool.setExpiryTimeout(-1);
+}
+
+MediaInfoIndexer::~MediaInfoIndexer()
+{
+    cancel();
+    m_threadPool.waitForDone();
+}
+
+int MediaInfoIndexer::enqueue(const mediaelch::FileList& files)
+{
+    const int jobId = ++m_lastJobId;
+    m_pendingJobs.push_back({jobId, deviceOf(files), files});
+    startJobs();
+    return jobId;
+}
+
+void MediaInfoIndexer::cancel()
+{
+    m_pendingJobs.clear();
+    m_cancelledJobId = m_lastJobId;
+}
+
+int MediaInfoIndexer::jobCount() const
+{
+    return static_cast<int>(m_pendingJobs.size()) + m_runningDevices.size();
+}
+
+QString MediaInfoIndexer::deviceOf(const mediaelch::FileList& files)
+{
+    if (files.isEmpty()) {
+        return {};
+    }
+    // QStorageInfo reads the list of mount points; items are mostly in few directories.
+    const QString dir = files.first().dir().toString();
+    auto it = m_devices.constFind(dir);
+    if (it != m_devices.constEnd()) {
+        return it.value();
+    }
+    const QStorageInfo storage(dir);
+    // Unknown device: Treat the directory as independent.
+    const QString device =
+        (storage.isValid() && !storage.device().isEmpty()) ? QString::fromUtf8(storage.device()) : dir;
+    m_devices.insert(dir, device);
+    return device;
+}
+
+void MediaInfoIndexer::startJobs()
+{
+    auto it = m_pendingJobs.begin();
+    while (it != m_pendingJobs.end() && m_runningDevices.size() < m_threadPool.maxThreadCount()) {
+        if (m_runningDevices.contains(it->device)) {
+            // Reading several files of one disk in parallel is slower because of seeking.
+            ++it;
+            continue;
+        }
+        PendingJob pendingJob = std::move(*it);
+        it = m_pendingJobs.erase(it);
+        startJob(std::move(pendingJob));
+    }
+}
+
+void MediaInfoIndexer::startJob(PendingJob pendingJob)
+{
+    const int jobId = pendingJob.id;
+    const QString device = pendingJob.device;
+    m_runningDevices.insert(device);
+
+    auto* watcher = new QFutureWatcher<StreamDetails::Values>(this);
+    connect(watcher, &QFutureWatcher<StreamDetails::Values>::finished, this, [this, watcher, jobId, device]() {
+        onJobFinished(jobId, device, watcher->result());
+        watcher->deleteLater();
+    });
+    const mediaelch::FileList files = pendingJob.files;
+    watcher->setFuture(QtConcurrent::run(&m_threadPool, [files]() { return MediaInfoIndexer::load(files); }));
+}
+
+void MediaInfoIndexer::onJobFinished(int jobId, const QString& device, const StreamDetails::Values& values)
+{
+    m_runningDevices.remove(device);
+    if (jobId > m_cancelledJobId) {
+        emit sigLoaded(jobId, values);
+    }
+    startJobs();
+    if (isIdle()) {
+        emit sigAllLoaded();
+    }
+}
+
+} // namespace mediaelch
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "data/StreamDetails.h"
+#include "file/Path.h"
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QThreadPool>
+#include <deque>
+#include <functional>
+
+class Database;
+
+namespace mediaelch {
+
+/// \brief   Loads stream details of items using libmediainfo in worker threads.
+/// \details Results are stored per file in the database, keyed by the file's path, size
+///          and modification time.  Unchanged files are not read again, not even after
+///          the library was reloaded.  Files that could not be read are not stored.
+///
+///          Reading a file is mostly limited by the disk, especially for network shares
+///          and optical drives, so only one file per storage device is read at a time.
+///          sigLoaded() is emitted for each job in the thread of the indexer.
+class MediaInfoIndexer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// \brief Loads the stream details of an item with the given files in the calling thread.
+    /// \details Uses a database connection of the calling thread.  For multiple files (e.g. a
+    ///          stacked movie), the duration is the sum of all files' durations and all other
+    ///          details are the first file's.
+    static StreamDetails::Values load(const mediaelch::FileList& files);
+
+    using ReadFunction = std::function<bool(const QString&, StreamDetails::Values&)>;
+    /// \brief Stream details of a single file, either from the database or read using \p read,
+    ///        e.g. StreamDetails::readFile().  Only successful reads are stored in the database.
+    static StreamDetails::Values loadFile(Database& database, const QString& filePath, const ReadFunction& read);
+
+public:
+    explicit MediaInfoIndexer(QObject* parent = nullptr);
+    ~MediaInfoIndexer() override;
+
+    /// \brief Enqueues the item's files and returns the job's ID that is passed to sigLoaded().
+    int enqueue(const mediaelch::FileList& files);
+    /// \brief Removes all pending jobs.  Running jobs are finished but not reported.
+    void cancel();
+    /// \brief Number of jobs that are either pending or running.
+    int jobCount() const;
+    bool isIdle() const { return jobCount() == 0; }
+
+signals:
+    void sigLoaded(int jobId, StreamDetails::Values values);
+    void sigAllLoaded();
+
+private:
+    struct PendingJob
+    {
+        int id;
+        QString device;
+        mediaelch::FileList files;
+    };
+
+    QString deviceOf(const mediaelch::FileList& files);
+    void startJobs();
+    void startJob(PendingJob pendingJob);
+    void onJobFinished(int jobId, const QString& device, const StreamDetails::Values& values);
+
+    QThreadPool m_threadPool;
+    std::deque<PendingJob> m_pendingJobs;
+    /// \brief Devices that are currently read, see QStorageInfo::device().
+    QSet<QString> m_runningDevices;
+    /// \brief Cached devices of directories.
+    QHash<QString, QString> m_devices;
+    int m_lastJobId = 0;
+    /// \brief Jobs with an ID up to this one were cancelled.
+    int m_cancelledJobId = 0;
+};
+
+} // namespace mediaelch
@@ -1,6 +1,7 @@
 #include "StreamDetails.h"
 
 #include "data/MediaInfoFile.h"
+#include "data/MediaInfoIndexer.h"
 #include "log/Log.h"
 
 #include <QApplication>
@@ -70,13 +71,17 @@ void StreamDetails::clear()
  */
 void StreamDetails::loadStreamDetails()
 {
-    clear();
-    if (m_files.isEmpty()) {
-        return;
+    setValues(mediaelch::MediaInfoIndexer::load(m_files));
+}
+
+mediaelch::FileList StreamDetails::mediaInfoFiles(const mediaelch::FileList& files)
+{
+    if (files.isEmpty()) {
+        return {};
     }
-    const QString firstFile = m_files.first().toString();
+    const QString firstFile = files.first().toString();
     if (firstFile.endsWith(".iso", Qt::CaseInsensitive) || firstFile.endsWith(".img", Qt::CaseInsensitive)) {
-        return;
+        return {};
     }
 
     // If it's a DVD structure, compute the biggest part (main movie) and use this IFO file
@@ -104,64 +109,85 @@ void StreamDetails::loadStreamDetails()
         if (!biggest.isEmpty()) {
             QFileInfo fiNew(fi.absolutePath() + "/VTS_" + biggest + "_0.IFO");
             if (fiNew.isFile() && fiNew.exists()) {
-                m_files = mediaelch::FileList({mediaelch::FilePath(fiNew.absoluteFilePath())});
+                return mediaelch::FileList({mediaelch::FilePath(fiNew.absoluteFilePath())});
             }
         }
     }
 
-    loadWithLibrary();
-}
-
-void StreamDetails::loadWithLibrary()
-{
-    mediaelch::FilePath filePath = m_files.first();
-    if (m_files.size() == 1 && filePath.toString().endsWith("index.bdmv")) {
-        QFileInfo fi(filePath.toString());
+    if (files.size() == 1 && firstFile.endsWith("index.bdmv")) {
+        QFileInfo fi(firstFile);
         QDir dir(fi.absolutePath() + "/STREAM");
-        QStringList files = dir.entryList(QStringList() << "*.m2ts", QDir::NoDotAndDotDot | QDir::Files, QDir::Name);
-        if (!files.isEmpty()) {
-            filePath = mediaelch::FilePath(dir.absolutePath() + "/" + files.first());
+        QStringList streams = dir.entryList(QStringList() << "*.m2ts", QDir::NoDotAndDotDot | QDir::Files, QDir::Name);
+        if (!streams.isEmpty()) {
+            return mediaelch::FileList({mediaelch::FilePath(dir.absolutePath() + "/" + streams.first())});
         }
     }
 
-    MediaInfoFile mi(filePath.toString());
-
-    std::chrono::seconds duration{0};
-    QString scanType;
+    return files;
+}
 
-    if (m_files.size() > 1) {
-        for (const mediaelch::FilePath& file : m_files) {
-            const MediaInfoFile mediaFile(file.toString());
-            duration += std::chrono::seconds(qRound(mediaFile.duration(0).count() / 1000.));
-        }
-    } else {
-        duration += std::chrono::seconds(qRound(mi.duration(0).count() / 1000.));
+bool StreamDetails::readFile(const QString& filePath, Values& values)
+{
+    const MediaInfoFile mi(filePath);
+    values = Values();
+    if (!mi.isReady()) {
+        return false;
     }
 
-    setVideoDetail(StreamDetails::VideoDetails::DurationInSeconds, QString::number(duration.count()));
+    const std::chrono::seconds duration(qRound(mi.duration(0).count() / 1000.));
+    values.video.insert(VideoDetails::DurationInSeconds, QString::number(duration.count()));
 
     if (mi.videoStreamCount() > 0) {
-        setVideoDetail(VideoDetails::Codec, mi.format(0));
-        setVideoDetail(VideoDetails::Aspect, QString::number(mi.aspectRatio(0)));
-        setVideoDetail(VideoDetails::Width, QString::number(mi.videoWidth(0)));
-        setVideoDetail(VideoDetails::Height, QString::number(mi.videoHeight(0)));
-        setVideoDetail(VideoDetails::ScanType, mi.scanType(0));
-        setVideoDetail(VideoDetails::StereoMode, mi.stereoFormat(0));
+        values.video.insert(VideoDetails::Codec, mi.format(0));
+        values.video.insert(VideoDetails::Aspect, QString::number(mi.aspectRatio(0)));
+        values.video.insert(VideoDetails::Width, QString::number(mi.videoWidth(0)));
+        values.video.insert(VideoDetails::Height, QString::number(mi.videoHeight(0)));
+        values.video.insert(VideoDetails::ScanType, mi.scanType(0));
+        values.video.insert(VideoDetails::StereoMode, mi.stereoFormat(0));
     }
 
     const int audioCount = mi.audioStreamCount();
     for (int i = 0; i < audioCount; ++i) {
-        setAudioDetail(i, AudioDetails::Language, mi.audioLanguage(i));
-        setAudioDetail(i, AudioDetails::Codec, mi.audioCodec(i));
-        setAudioDetail(i, AudioDetails::Channels, mi.audioChannels(i));
+        values.audio.push_back({{AudioDetails::Language, mi.audioLanguage(i)},
+            {AudioDetails::Codec, mi.audioCodec(i)},
+            {AudioDetails::Channels, mi.audioChannels(i)}});
     }
 
-    int textCount = mi.subtitleCount();
+    const int textCount = mi.subtitleCount();
     for (int i = 0; i < textCount; ++i) {
-        setSubtitleDetail(i, StreamDetails::SubtitleDetails::Language, mi.subtitleLang(i));
+        values.subtitles.push_back({{SubtitleDetails::Language, mi.subtitleLang(i)}});
     }
+    return true;
+}
+
+StreamDetails::Values StreamDetails::values() const
+{
+    Values values;
+    values.video = m_videoDetails;
+    values.audio = m_audioDetails;
+    values.subtitles = m_subtitles;
+    return values;
 }
 
+void StreamDetails::setValues(const Values& values)
+{
+    clear();
+    for (auto it = values.video.cbegin(); it != values.video.cend(); ++it) {
+        setVideoDetail(it.key(), it.value());
+    }
+    for (int i = 0; i < values.audio.size(); ++i) {
+        const auto& stream = values.audio[i];
+        for (auto it = stream.cbegin(); it != stream.cend(); ++it) {
+            setAudioDetail(i, it.key(), it.value());
+        }
+    }
+    for (int i = 0; i < values.subtitles.size(); ++i) {
+        const auto& stream = values.subtitles[i];
+        for (auto it = stream.cbegin(); it != stream.cend(); ++it) {
+            setSubtitleDetail(i, it.key(), it.value());
+        }
+    }
+}
 
 /**
  * \brief Sets a video detail
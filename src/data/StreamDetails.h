@@ -35,11 +35,33 @@ public:
         Language
     };
 
+    /// \brief Stream details independent of any item.  Can be read in any thread,
+    ///        see MediaInfoIndexer.
+    struct Values
+    {
+        QMap<VideoDetails, QString> video;
+        QVector<QMap<AudioDetails, QString>> audio;
+        QVector<QMap<SubtitleDetails, QString>> subtitles;
+    };
+
     static QString detailToString(VideoDetails details);
     static QString detailToString(AudioDetails details);
     static QString detailToString(SubtitleDetails details);
 
+    /// \brief Files that are read using libmediainfo for an item with the given files.
+    /// \details E.g. the main title's IFO file for DVD structures.  Empty for disc images.
+    static mediaelch::FileList mediaInfoFiles(const mediaelch::FileList& files);
+    /// \brief Reads the stream details of a single file using libmediainfo.
+    /// \return False if libmediainfo is not available or the file could not be opened.
+    static bool readFile(const QString& filePath, Values& values);
+
+    /// \brief Loads stream details from the files.  Unchanged files are not read again,
+    ///        see MediaInfoIndexer.
     void loadStreamDetails();
+    const mediaelch::FileList& files() const { return m_files; }
+    Values values() const;
+    /// \brief Replaces all details, e.g. with details loaded by MediaInfoIndexer.
+    void setValues(const Values& values);
     void setVideoDetail(VideoDetails key, QString value);
     void setAudioDetail(int streamNumber, AudioDetails key, QString value);
     void setSubtitleDetail(int streamNumber, SubtitleDetails key, QString value);
@@ -62,8 +84,6 @@ public:
     QStringList allSubtitleLanguages() const;
 
 private:
-    void loadWithLibrary();
-
     mediaelch::FileList m_files;
     QMap<VideoDetails, QString> m_videoDetails;
     QVector<QMap<AudioDetails, QString>> m_audioDetails;
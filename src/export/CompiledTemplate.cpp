@@ -0,0 +1,210 @@
+#include "export/CompiledTemplate.h"
+
+#include <QRegularExpression>
+
+namespace {
+
+const QString TAG_START = QStringLiteral("{{ ");
+const QString TAG_END = QStringLiteral(" }}");
+const QString BLOCK_START = QStringLiteral("BEGIN_BLOCK_");
+const QString BLOCK_END = QStringLiteral("END_BLOCK_");
+
+} // namespace
+
+namespace mediaelch {
+
+CompiledTemplate::CompiledTemplate(const QString& text) : m_nodes{parse(text)}, m_textSize{text.size()}
+{
+}
+
+bool CompiledTemplate::isEmpty() const
+{
+    return m_nodes.isEmpty();
+}
+
+bool CompiledTemplate::containsBlock(const QString& name) const
+{
+    return containsBlock(m_nodes, name);
+}
+
+CompiledTemplate CompiledTemplate::block(const QString& name) const
+{
+    CompiledTemplate result;
+    for (const Node& node : m_nodes) {
+        if (node.type == Node::Type::Block && node.value == name) {
+            result.m_nodes = node.children;
+            result.m_textSize = node.source.size();
+            break;
+        }
+    }
+    return result;
+}
+
+QString CompiledTemplate::render(const TemplateData& data) const
+{
+    QString out;
+    // Values are usually short; avoid most reallocations.
+    out.reserve(m_textSize + m_textSize / 2);
+    QVector<const TemplateData*> scopes{&data};
+    render(m_nodes, scopes, out);
+    return out;
+}
+
+QVector<CompiledTemplate::Node> CompiledTemplate::parse(const QString& text)
+{
+    static const QRegularExpression imageRx(R"(^IMAGE.(.*)\[(\d*), ?(\d*)\]$)",
+        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
+
+    QVector<Node> nodes;
+    const auto appendText = [&nodes](const QString& str) {
+        if (str.isEmpty()) {
+            return;
+        }
+        if (!nodes.isEmpty() && nodes.last().type == Node::Type::Text) {
+            nodes.last().value += str;
+        } else {
+            Node node;
+            node.value = str;
+            nodes.push_back(node);
+        }
+    };
+
+    int pos = 0;
+    while (pos < text.size()) {
+        int start = text.indexOf(TAG_START, pos);
+        const int end = (start < 0) ? -1 : text.indexOf(TAG_END, start + TAG_START.size());
+        if (start < 0 || end < 0) {
+            break;
+        }
+        // For "{{ a {{ NAME }}" only the inner tag is a placeholder.
+        const int nestedStart = text.lastIndexOf(TAG_START, end - 1);
+        if (nestedStart > start && nestedStart + TAG_START.size() <= end) {
+            start = nestedStart;
+        }
+
+        const int tagEnd = end + TAG_END.size();
+        const QString name = text.mid(start + TAG_START.size(), end - start - TAG_START.size());
+        appendText(text.mid(pos, start - pos));
+
+        Node node;
+        node.source = text.mid(start, tagEnd - start);
+
+        if (name.startsWith(BLOCK_START)) {
+            const QString blockName = name.mid(BLOCK_START.size());
+            const QString endTag = TAG_START + BLOCK_END + blockName + TAG_END;
+            const int endTagStart = text.indexOf(endTag, tagEnd);
+            if (endTagStart < 0) {
+                appendText(node.source);
+                pos = tagEnd;
+                continue;
+            }
+            node.type = Node::Type::Block;
+            node.value = blockName;
+            node.source = text.mid(start, endTagStart + endTag.size() - start);
+            node.children = parse(text.mid(tagEnd, endTagStart - tagEnd).trimmed());
+            nodes.push_back(node);
+            pos = endTagStart + endTag.size();
+            continue;
+        }
+
+        const QRegularExpressionMatch match = imageRx.match(name);
+        if (match.hasMatch()) {
+            node.imageSize = QSize(match.captured(2).toInt(), match.captured(3).toInt());
+            if (node.imageSize.isEmpty()) {
+                appendText(node.source);
+                pos = tagEnd;
+                continue;
+            }
+            node.type = Node::Type::Image;
+            node.value = match.captured(1).toLower();
+
+        } else {
+            node.type = Node::Type::Variable;
+            node.value = name;
+        }
+        nodes.push_back(node);
+        pos = tagEnd;
+    }
+
+    appendText(text.mid(pos));
+    return nodes;
+}
+
+bool CompiledTemplate::containsBlock(const QVector<Node>& nodes, const QString& name)
+{
+    for (const Node& node : nodes) {
+        if (node.type == Node::Type::Block && (node.value == name || containsBlock(node.children, name))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CompiledTemplate::render(const QVector<Node>& nodes, QVector<const TemplateData*>& scopes, QString& out)
+{
+    for (const Node& node : nodes) {
+        switch (node.type) {
+        case Node::Type::Text: {
+            out += node.value;
+            break;
+        }
+        case Node::Type::Variable: {
+            const QString* value = nullptr;
+            for (int i = scopes.size() - 1; i >= 0 && value == nullptr; --i) {
+                auto it = scopes[i]->variables.constFind(node.value);
+                if (it != scopes[i]->variables.constEnd()) {
+                    value = &it.value();
+                }
+            }
+            out += (value != nullptr) ? *value : node.source;
+            break;
+        }
+        case Node::Type::Block: {
+            const QString* rendered = nullptr;
+            for (int i = scopes.size() - 1; i >= 0 && rendered == nullptr; --i) {
+                auto it = scopes[i]->renderedBlocks.constFind(node.value);
+                if (it != scopes[i]->renderedBlocks.constEnd()) {
+                    rendered = &it.value();
+                }
+            }
+            if (rendered != nullptr) {
+                out += *rendered;
+                break;
+            }
+            const TemplateData::Block* block = nullptr;
+            for (int i = scopes.size() - 1; i >= 0 && block == nullptr; --i) {
+                auto it = scopes[i]->blocks.constFind(node.value);
+                if (it != scopes[i]->blocks.constEnd()) {
+                    block = &it.value();
+                }
+            }
+            if (block == nullptr) {
+                out += node.source;
+                break;
+            }
+            for (int i = 0; i < block->items.size(); ++i) {
+                if (i > 0) {
+                    out += block->separator;
+                }
+                scopes.push_back(&block->items[i]);
+                render(node.children, scopes, out);
+                scopes.pop_back();
+            }
+            break;
+        }
+        case Node::Type::Image: {
+            bool isPlaceholderUsed = false;
+            QString path;
+            for (int i = scopes.size() - 1; i >= 0 && !isPlaceholderUsed; --i) {
+                if (scopes[i]->images) {
+                    path = scopes[i]->images(node.value, node.imageSize, &isPlaceholderUsed);
+                }
+            }
+            out += isPlaceholderUsed ? path : node.source;
+            break;
+        }
+        }
+    }
+}
+
+} // namespace mediaelch
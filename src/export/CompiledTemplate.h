@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QHash>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Values of one item (e.g. a movie) that are inserted into a CompiledTemplate.
+struct TemplateData
+{
+    struct Block
+    {
+        QVector<TemplateData> items;
+        /// \brief Inserted between the rendered items.
+        QString separator = " ";
+    };
+
+    /// \brief Returns the path of an image with the given type and size.  Sets the flag to
+    ///        false if the item has no such image type; the placeholder is kept in that case.
+    using ImageResolver = std::function<QString(const QString& type, const QSize& size, bool* isPlaceholderUsed)>;
+
+    /// \brief Values by placeholder name, e.g. "MOVIE.TITLE" for "{{ MOVIE.TITLE }}".
+    QHash<QString, QString> variables;
+    /// \brief Items by block name, e.g. "ACTORS" for "{{ BEGIN_BLOCK_ACTORS }}".
+    QHash<QString, Block> blocks;
+    /// \brief Content of blocks that were rendered separately, e.g. in parallel.
+    QHash<QString, QString> renderedBlocks;
+    ImageResolver images;
+};
+
+/// \brief   Export template that is parsed once and can then be rendered for many items.
+/// \details The SimpleEngine's template syntax consists of placeholders "{{ NAME }}", images
+///          "{{ IMAGE.type[width, height] }}" and blocks "{{ BEGIN_BLOCK_NAME }}" ... "{{ END_BLOCK_NAME }}"
+///          whose trimmed content is rendered for each item of the block.  Placeholders inside a
+///          block are looked up in the block's item first and then in the enclosing items.
+///          Unknown placeholders and blocks are kept as they are.
+///
+///          Rendering is const and thread-safe.
+class CompiledTemplate
+{
+public:
+    CompiledTemplate() = default;
+    explicit CompiledTemplate(const QString& text);
+
+    QString render(const TemplateData& data) const;
+
+    /// \brief Whether the template contains the given block at any level.  Allows to skip
+    ///        collecting data that is not needed.
+    bool containsBlock(const QString& name) const;
+    /// \brief Content of the first top-level block with the given name.
+    CompiledTemplate block(const QString& name) const;
+    bool isEmpty() const;
+
+private:
+    struct Node
+    {
+        enum class Type
+        {
+            Text,
+            Variable,
+            Block,
+            Image
+        };
+        Type type = Type::Text;
+        /// \brief Text, variable name, block name or image type.
+        QString value;
+        /// \brief Original text that is used if the variable, block or image is unknown.
+        QString source;
+        QSize imageSize;
+        QVector<Node> children;
+    };
+
+    static QVector<Node> parse(const QString& text);
+    static bool containsBlock(const QVector<Node>& nodes, const QString& name);
+    static void render(const QVector<Node>& nodes, QVector<const TemplateData*>& scopes, QString& out);
+
+    QVector<Node> m_nodes;
+    int m_textSize = 0;
+};
+
+} // namespace mediaelch
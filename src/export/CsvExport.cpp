@@ -2,6 +2,7 @@
 
 #include "concerts/Concert.h"
 #include "data/Rating.h"
+#include "export/CsvWriter.h"
 #include "movies/Movie.h"
 #include "music/Album.h"
 #include "music/Artist.h"
@@ -98,75 +99,74 @@ static QString getStreamDetails(const StreamDetails* streamDetails, StreamDetail
 
 namespace mediaelch {
 
-CsvMovieExport::CsvMovieExport(QTextStream& outStream, QVector<CsvMovieExport::Field> fields, QObject* parent) :
-    CsvMediaExport(outStream, parent), m_fields{fields}
+template<class T, class Detail>
+static typename CsvWriter<T*>::Column streamDetailsColumn(Detail detail)
 {
+    return [detail](T* item) { return getStreamDetails(item->streamDetails(), detail); };
 }
 
-void CsvMovieExport::exportMovies(const QVector<Movie*>& movies, std::function<void()> callback)
+static CsvWriter<Movie*>::Column movieColumn(CsvMovieExport::Field field)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Movie* movie : asConst(movies)) {
-        const auto* st = movie->streamDetails();
-        csv.addRow({
-            {s(Field::Imdbid), movie->imdbId().toString()},
-            {s(Field::Tmdbid), movie->tmdbId().toString()},
-            {s(Field::Title), movie->name()},
-            {s(Field::OriginalTitle), movie->originalName()},
-            {s(Field::SortTitle), movie->sortTitle()},
-            {s(Field::Overview), movie->overview()},
-            {s(Field::Outline), movie->outline()},
-            {s(Field::Ratings), ratingsToString(movie->ratings())},
-            {s(Field::UserRating), QString::number(movie->userRating())},
-            {s(Field::IsImdbTop250), QString::number(movie->top250())},
-            {s(Field::ReleaseDate), movie->released().isValid() ? movie->released().toString(Qt::ISODate) : ""},
-            {s(Field::Tagline), movie->tagline()},
-            {s(Field::Runtime), QString::number(movie->runtime().count())},
-            {s(Field::Certification), movie->certification().toString()},
-            {s(Field::Writers), movie->writer()},
-            {s(Field::Directors), movie->director()},
-            {s(Field::Genres), movie->genres().join(", ")},
-            {s(Field::Countries), movie->countries().join(", ")},
-            {s(Field::Studios), movie->studios().join(", ")},
-            {s(Field::Tags), movie->tags().join(", ")},
-            {s(Field::Trailer), movie->trailer().toString()},
-            {s(Field::Actors), actorsToString(movie->actors())},
-            {s(Field::PlayCount), QString::number(movie->playcount())},
-            {s(Field::LastPlayed), movie->lastPlayed().toString(Qt::ISODate)},
-            {s(Field::MovieSet), movie->set().name},
-            {s(Field::Directory), dirFromFileList(movie->files())},
-            {s(Field::Filenames), filesToString(movie->files())},
-            {s(Field::StreamDetails_Video_DurationInSeconds),
-                getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-            {s(Field::StreamDetails_Video_Aspect), getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-            {s(Field::StreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-            {s(Field::StreamDetails_Video_Height), getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-            {s(Field::StreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Language), getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-            {s(Field::StreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Channels), getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-            {s(Field::StreamDetails_Subtitle_Language),
-                getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-        });
-        callback();
+    using Field = CsvMovieExport::Field;
+    switch (field) {
+    case Field::Imdbid: return [](Movie* movie) { return movie->imdbId().toString(); };
+    case Field::Tmdbid: return [](Movie* movie) { return movie->tmdbId().toString(); };
+    case Field::Title: return [](Movie* movie) { return movie->name(); };
+    case Field::OriginalTitle: return [](Movie* movie) { return movie->originalName(); };
+    case Field::SortTitle: return [](Movie* movie) { return movie->sortTitle(); };
+    case Field::Overview: return [](Movie* movie) { return movie->overview(); };
+    case Field::Outline: return [](Movie* movie) { return movie->outline(); };
+    case Field::Ratings: return [](Movie* movie) { return ratingsToString(movie->ratings()); };
+    case Field::UserRating: return [](Movie* movie) { return QString::number(movie->userRating()); };
+    case Field::IsImdbTop250: return [](Movie* movie) { return QString::number(movie->top250()); };
+    case Field::ReleaseDate:
+        return [](Movie* movie) {
+            return movie->released().isValid() ? movie->released().toString(Qt::ISODate) : QString{};
+        };
+    case Field::Tagline: return [](Movie* movie) { return movie->tagline(); };
+    case Field::Runtime: return [](Movie* movie) { return QString::number(movie->runtime().count()); };
+    case Field::Certification: return [](Movie* movie) { return movie->certification().toString(); };
+    case Field::Writers: return [](Movie* movie) { return movie->writer(); };
+    case Field::Directors: return [](Movie* movie) { return movie->director(); };
+    case Field::Genres: return [](Movie* movie) { return movie->genres().join(", "); };
+    case Field::Countries: return [](Movie* movie) { return movie->countries().join(", "); };
+    case Field::Studios: return [](Movie* movie) { return movie->studios().join(", "); };
+    case Field::Tags: return [](Movie* movie) { return movie->tags().join(", "); };
+    case Field::Trailer: return [](Movie* movie) { return movie->trailer().toString(); };
+    case Field::Actors: return [](Movie* movie) { return actorsToString(movie->actors()); };
+    case Field::PlayCount: return [](Movie* movie) { return QString::number(movie->playcount()); };
+    case Field::LastPlayed: return [](Movie* movie) { return movie->lastPlayed().toString(Qt::ISODate); };
+    case Field::MovieSet: return [](Movie* movie) { return movie->set().name; };
+    case Field::Directory: return [](Movie* movie) { return dirFromFileList(movie->files()); };
+    case Field::Filenames: return [](Movie* movie) { return filesToString(movie->files()); };
+    case Field::StreamDetails_Video_DurationInSeconds:
+        return streamDetailsColumn<Movie>(StreamDetails::VideoDetails::DurationInSeconds);
+    case Field::StreamDetails_Video_Aspect: return streamDetailsColumn<Movie>(StreamDetails::VideoDetails::Aspect);
+    case Field::StreamDetails_Video_Width: return streamDetailsColumn<Movie>(StreamDetails::VideoDetails::Width);
+    case Field::StreamDetails_Video_Height: return streamDetailsColumn<Movie>(StreamDetails::VideoDetails::Height);
+    case Field::StreamDetails_Video_Codec: return streamDetailsColumn<Movie>(StreamDetails::VideoDetails::Codec);
+    case Field::StreamDetails_Audio_Language: return streamDetailsColumn<Movie>(StreamDetails::AudioDetails::Language);
+    case Field::StreamDetails_Audio_Codec: return streamDetailsColumn<Movie>(StreamDetails::AudioDetails::Codec);
+    case Field::StreamDetails_Audio_Channels: return streamDetailsColumn<Movie>(StreamDetails::AudioDetails::Channels);
+    case Field::StreamDetails_Subtitle_Language:
+        return streamDetailsColumn<Movie>(StreamDetails::SubtitleDetails::Language);
     }
+    return [](Movie*) { return QString{}; };
 }
 
-QVector<QString> CsvMovieExport::fieldsToStrings() const
+CsvMovieExport::CsvMovieExport(QTextStream& outStream, QVector<CsvMovieExport::Field> fields, QObject* parent) :
+    CsvMediaExport(outStream, parent), m_fields{fields}
+{
+}
+
+void CsvMovieExport::exportMovies(const QVector<Movie*>& movies, std::function<void()> callback)
 {
-    QVector<QString> out;
+    CsvWriter<Movie*> csv(m_out, CsvFormat(m_separator, m_replacement));
     for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
+        csv.addColumn(fieldToString(field), movieColumn(field));
     }
-    return out;
+    csv.writeHeader();
+    csv.writeRows(movies, [&callback](Movie* const&) { callback(); });
 }
 
 QString CsvMovieExport::fieldToString(Field field)
@@ -212,56 +212,46 @@ QString CsvMovieExport::fieldToString(Field field)
     return "unknown";
 }
 
-CsvTvShowExport::CsvTvShowExport(QTextStream& outStream, QVector<CsvTvShowExport::Field> fields, QObject* parent) :
-    CsvMediaExport(outStream, parent), m_fields{fields}
+static CsvWriter<TvShow*>::Column tvShowColumn(CsvTvShowExport::Field field)
 {
+    using Field = CsvTvShowExport::Field;
+    switch (field) {
+    case Field::ShowImdbId: return [](TvShow* show) { return show->imdbId().toString(); };
+    case Field::ShowTmdbId: return [](TvShow* show) { return show->tmdbId().toString(); };
+    case Field::ShowTvDbId: return [](TvShow* show) { return show->tvdbId().toString(); };
+    case Field::ShowTvMazeId: return [](TvShow* show) { return show->tvmazeId().toString(); };
+    case Field::ShowTitle: return [](TvShow* show) { return show->title(); };
+    case Field::ShowSortTitle: return [](TvShow* show) { return show->sortTitle(); };
+    case Field::ShowOriginalTitle: return [](TvShow* show) { return show->originalTitle(); };
+    case Field::ShowFirstAired: return [](TvShow* show) { return show->firstAired().toString(Qt::ISODate); };
+    case Field::ShowNetwork: return [](TvShow* show) { return show->network(); };
+    case Field::ShowGenres: return [](TvShow* show) { return show->genres().join(", "); };
+    case Field::ShowCertification: return [](TvShow* show) { return show->certification().toString(); };
+    case Field::ShowActors: return [](TvShow* show) { return actorsToString(show->actors()); };
+    case Field::ShowTags: return [](TvShow* show) { return show->tags().join(", "); };
+    case Field::ShowRuntime: return [](TvShow* show) { return QString::number(show->runtime().count()); };
+    case Field::ShowRatings: return [](TvShow* show) { return ratingsToString(show->ratings()); };
+    case Field::ShowUserRating: return [](TvShow* show) { return QString::number(show->userRating()); };
+    case Field::ShowIsImdbTop250: return [](TvShow* show) { return QString::number(show->top250()); };
+    case Field::ShowOverview: return [](TvShow* show) { return show->overview(); };
+    case Field::ShowDirectory: return [](TvShow* show) { return show->dir().toNativePathString(); };
+    }
+    return [](TvShow*) { return QString{}; };
 }
 
-void CsvTvShowExport::exportTvShows(const QVector<TvShow*>& shows, std::function<void()> callback)
+CsvTvShowExport::CsvTvShowExport(QTextStream& outStream, QVector<CsvTvShowExport::Field> fields, QObject* parent) :
+    CsvMediaExport(outStream, parent), m_fields{fields}
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (TvShow* show : shows) {
-        csv.addRow({
-            {s(Field::ShowTmdbId), show->tmdbId().toString()},
-            {s(Field::ShowImdbId), show->imdbId().toString()},
-            {s(Field::ShowTvDbId), show->tvdbId().toString()},
-            {s(Field::ShowTvMazeId), show->tvmazeId().toString()},
-            {s(Field::ShowTitle), show->title()},
-            {s(Field::ShowSortTitle), show->sortTitle()},
-            {s(Field::ShowOriginalTitle), show->originalTitle()},
-            {s(Field::ShowFirstAired), show->firstAired().toString(Qt::ISODate)},
-            {s(Field::ShowNetwork), show->network()},
-            {s(Field::ShowCertification), show->certification().toString()},
-            {s(Field::ShowGenres), show->genres().join(", ")},
-            {s(Field::ShowTags), show->tags().join(", ")},
-            {s(Field::ShowRuntime), QString::number(show->runtime().count())},
-            {s(Field::ShowRatings), ratingsToString(show->ratings())},
-            {s(Field::ShowUserRating), QString::number(show->userRating())},
-            {s(Field::ShowActors), actorsToString(show->actors())},
-            {s(Field::ShowOverview), show->overview()},
-            {s(Field::ShowIsImdbTop250), QString::number(show->top250())},
-            {s(Field::ShowDirectory), show->dir().toNativePathString()} //
-        });
-
-        callback();
-    }
 }
 
-QVector<QString> CsvTvShowExport::fieldsToStrings() const
+void CsvTvShowExport::exportTvShows(const QVector<TvShow*>& shows, std::function<void()> callback)
 {
-    QVector<QString> out;
+    CsvWriter<TvShow*> csv(m_out, CsvFormat(m_separator, m_replacement));
     for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
+        csv.addColumn(fieldToString(field), tvShowColumn(field));
     }
-    return out;
+    csv.writeHeader();
+    csv.writeRows(shows, [&callback](TvShow* const&) { callback(); });
 }
 
 QString CsvTvShowExport::fieldToString(CsvTvShowExport::Field field)
@@ -291,6 +281,68 @@ QString CsvTvShowExport::fieldToString(CsvTvShowExport::Field field)
 }
 
 
+namespace {
+
+struct EpisodeRow
+{
+    TvShow* show = nullptr;
+    TvShowEpisode* episode = nullptr;
+    bool isLastOfShow = false;
+};
+
+} // namespace
+
+template<class Detail>
+static CsvWriter<EpisodeRow>::Column episodeStreamDetailsColumn(Detail detail)
+{
+    return [detail](const EpisodeRow& row) { return getStreamDetails(row.episode->streamDetails(), detail); };
+}
+
+static CsvWriter<EpisodeRow>::Column episodeColumn(CsvTvEpisodeExport::Field field)
+{
+    using Field = CsvTvEpisodeExport::Field;
+    using Row = EpisodeRow;
+    switch (field) {
+    case Field::ShowImdbId: return [](const Row& row) { return row.show->imdbId().toString(); };
+    case Field::ShowTmdbId: return [](const Row& row) { return row.show->tmdbId().toString(); };
+    case Field::ShowTvDbId: return [](const Row& row) { return row.show->tvdbId().toString(); };
+    case Field::ShowTvMazeId: return [](const Row& row) { return row.show->tvmazeId().toString(); };
+    case Field::ShowTitle: return [](const Row& row) { return row.show->title(); };
+    case Field::EpisodeSeason: return [](const Row& row) { return row.episode->seasonNumber().toString(); };
+    case Field::EpisodeNumber: return [](const Row& row) { return row.episode->episodeNumber().toString(); };
+    case Field::EpisodeImdbId: return [](const Row& row) { return row.episode->imdbId().toString(); };
+    case Field::EpisodeTmdbId: return [](const Row& row) { return row.episode->tmdbId().toString(); };
+    case Field::EpisodeTvDbId: return [](const Row& row) { return row.episode->tvdbId().toString(); };
+    case Field::EpisodeTvMazeId: return [](const Row& row) { return row.episode->tvmazeId().toString(); };
+    case Field::EpisodeFirstAired:
+        return [](const Row& row) { return row.episode->firstAired().toString(Qt::ISODate); };
+    case Field::EpisodeTitle: return [](const Row& row) { return row.episode->title(); };
+    case Field::EpisodeOverview: return [](const Row& row) { return row.episode->overview(); };
+    case Field::EpisodeUserRating: return [](const Row& row) { return QString::number(row.episode->userRating()); };
+    case Field::EpisodeWriters: return [](const Row& row) { return row.episode->writers().join(", "); };
+    case Field::EpisodeDirectors: return [](const Row& row) { return row.episode->directors().join(", "); };
+    case Field::EpisodeActors: return [](const Row& row) { return actorsToString(row.episode->actors()); };
+    case Field::EpisodeFilenames: return [](const Row& row) { return filesToString(row.episode->files()); };
+    case Field::EpisodeDirectory: return [](const Row& row) { return dirFromFileList(row.episode->files()); };
+    case Field::EpisodeStreamDetails_Video_DurationInSeconds:
+        return episodeStreamDetailsColumn(StreamDetails::VideoDetails::DurationInSeconds);
+    case Field::EpisodeStreamDetails_Video_Aspect:
+        return episodeStreamDetailsColumn(StreamDetails::VideoDetails::Aspect);
+    case Field::EpisodeStreamDetails_Video_Width: return episodeStreamDetailsColumn(StreamDetails::VideoDetails::Width);
+    case Field::EpisodeStreamDetails_Video_Height:
+        return episodeStreamDetailsColumn(StreamDetails::VideoDetails::Height);
+    case Field::EpisodeStreamDetails_Video_Codec: return episodeStreamDetailsColumn(StreamDetails::VideoDetails::Codec);
+    case Field::EpisodeStreamDetails_Audio_Language:
+        return episodeStreamDetailsColumn(StreamDetails::AudioDetails::Language);
+    case Field::EpisodeStreamDetails_Audio_Codec: return episodeStreamDetailsColumn(StreamDetails::AudioDetails::Codec);
+    case Field::EpisodeStreamDetails_Audio_Channels:
+        return episodeStreamDetailsColumn(StreamDetails::AudioDetails::Channels);
+    case Field::EpisodeStreamDetails_Subtitle_Language:
+        return episodeStreamDetailsColumn(StreamDetails::SubtitleDetails::Language);
+    }
+    return [](const Row&) { return QString{}; };
+}
+
 CsvTvEpisodeExport::CsvTvEpisodeExport(QTextStream& outStream,
     QVector<CsvTvEpisodeExport::Field> fields,
     QObject* parent) :
@@ -300,66 +352,28 @@ CsvTvEpisodeExport::CsvTvEpisodeExport(QTextStream& outStream,
 
 void CsvTvEpisodeExport::exportEpisodes(const QVector<TvShow*>& shows, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
+    CsvWriter<EpisodeRow> csv(m_out, CsvFormat(m_separator, m_replacement));
+    for (const Field field : asConst(m_fields)) {
+        csv.addColumn(fieldToString(field), episodeColumn(field));
+    }
     csv.writeHeader();
 
+    // Rows only point to the episodes; the text of at most two chunks is kept in memory.
+    QVector<EpisodeRow> rows;
     for (TvShow* show : shows) {
-        for (TvShowEpisode* episode : asConst(show->episodes())) {
-            const auto* st = episode->streamDetails();
-            csv.addRow({
-                {s(Field::ShowTmdbId), show->tmdbId().toString()},
-                {s(Field::ShowImdbId), show->imdbId().toString()},
-                {s(Field::ShowTvDbId), show->tvdbId().toString()},
-                {s(Field::ShowTvMazeId), show->tvmazeId().toString()},
-                {s(Field::ShowTitle), show->title()},
-                {s(Field::EpisodeSeason), episode->seasonNumber().toString()},
-                {s(Field::EpisodeNumber), episode->episodeNumber().toString()},
-                {s(Field::EpisodeTmdbId), episode->tmdbId().toString()},
-                {s(Field::EpisodeImdbId), episode->imdbId().toString()},
-                {s(Field::EpisodeTvDbId), episode->tvdbId().toString()},
-                {s(Field::EpisodeTvMazeId), episode->tvmazeId().toString()},
-                {s(Field::EpisodeFirstAired), episode->firstAired().toString(Qt::ISODate)},
-                {s(Field::EpisodeTitle), episode->title()},
-                {s(Field::EpisodeOverview), episode->overview()},
-                {s(Field::EpisodeTitle), episode->title()},
-                {s(Field::EpisodeUserRating), QString::number(episode->userRating())},
-                {s(Field::EpisodeActors), actorsToString(episode->actors())},
-                {s(Field::EpisodeDirectory), dirFromFileList(episode->files())},
-                {s(Field::EpisodeFilenames), filesToString(episode->files())},
-                {s(Field::EpisodeStreamDetails_Video_DurationInSeconds),
-                    getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-                {s(Field::EpisodeStreamDetails_Video_Aspect),
-                    getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-                {s(Field::EpisodeStreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-                {s(Field::EpisodeStreamDetails_Video_Height),
-                    getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-                {s(Field::EpisodeStreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-                {s(Field::EpisodeStreamDetails_Audio_Language),
-                    getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-                {s(Field::EpisodeStreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-                {s(Field::EpisodeStreamDetails_Audio_Channels),
-                    getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-                {s(Field::EpisodeStreamDetails_Subtitle_Language),
-                    getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-            });
+        const QVector<TvShowEpisode*>& episodes = show->episodes();
+        if (episodes.isEmpty()) {
+            callback();
+        }
+        for (TvShowEpisode* episode : episodes) {
+            rows.push_back({show, episode, episode == episodes.last()});
         }
-        callback();
-    }
-}
-
-QVector<QString> CsvTvEpisodeExport::fieldsToStrings() const
-{
-    QVector<QString> out;
-    for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
     }
-    return out;
+    csv.writeRows(rows, [&callback](const EpisodeRow& row) {
+        if (row.isLastOfShow) {
+            callback();
+        }
+    });
 }
 
 QString CsvTvEpisodeExport::fieldToString(CsvTvEpisodeExport::Field field)
@@ -398,69 +412,60 @@ QString CsvTvEpisodeExport::fieldToString(CsvTvEpisodeExport::Field field)
     return "unknown";
 }
 
-CsvConcertExport::CsvConcertExport(QTextStream& outStream, QVector<CsvConcertExport::Field> fields, QObject* parent) :
-    CsvMediaExport(outStream, parent), m_fields{fields}
+static CsvWriter<Concert*>::Column concertColumn(CsvConcertExport::Field field)
 {
+    using Field = CsvConcertExport::Field;
+    switch (field) {
+    case Field::TmdbId: return [](Concert* concert) { return concert->tmdbId().toString(); };
+    case Field::ImdbId: return [](Concert* concert) { return concert->imdbId().toString(); };
+    case Field::Title: return [](Concert* concert) { return concert->title(); };
+    case Field::OriginalTitle: return [](Concert* concert) { return concert->originalTitle(); };
+    case Field::Artist: return [](Concert* concert) { return concert->artist(); };
+    case Field::Album: return [](Concert* concert) { return concert->album(); };
+    case Field::Overview: return [](Concert* concert) { return concert->overview(); };
+    case Field::Ratings: return [](Concert* concert) { return ratingsToString(concert->ratings()); };
+    case Field::UserRating: return [](Concert* concert) { return QString::number(concert->userRating()); };
+    case Field::ReleaseDate: return [](Concert* concert) { return concert->released().toString(Qt::ISODate); };
+    case Field::Tagline: return [](Concert* concert) { return concert->tagline(); };
+    case Field::Runtime: return [](Concert* concert) { return QString::number(concert->runtime().count()); };
+    case Field::Certification: return [](Concert* concert) { return concert->certification().toString(); };
+    case Field::Genres: return [](Concert* concert) { return concert->genres().join(", "); };
+    case Field::Tags: return [](Concert* concert) { return concert->tags().join(", "); };
+    case Field::TrailerUrl: return [](Concert* concert) { return concert->trailer().toString(); };
+    case Field::Playcount: return [](Concert* concert) { return QString::number(concert->playcount()); };
+    case Field::LastPlayed: return [](Concert* concert) { return concert->lastPlayed().toString(Qt::ISODate); };
+    case Field::Filenames: return [](Concert* concert) { return filesToString(concert->files()); };
+    case Field::Directory: return [](Concert* concert) { return dirFromFileList(concert->files()); };
+    case Field::StreamDetails_Video_DurationInSeconds:
+        return streamDetailsColumn<Concert>(StreamDetails::VideoDetails::DurationInSeconds);
+    case Field::StreamDetails_Video_Aspect: return streamDetailsColumn<Concert>(StreamDetails::VideoDetails::Aspect);
+    case Field::StreamDetails_Video_Width: return streamDetailsColumn<Concert>(StreamDetails::VideoDetails::Width);
+    case Field::StreamDetails_Video_Height: return streamDetailsColumn<Concert>(StreamDetails::VideoDetails::Height);
+    case Field::StreamDetails_Video_Codec: return streamDetailsColumn<Concert>(StreamDetails::VideoDetails::Codec);
+    case Field::StreamDetails_Audio_Language:
+        return streamDetailsColumn<Concert>(StreamDetails::AudioDetails::Language);
+    case Field::StreamDetails_Audio_Codec: return streamDetailsColumn<Concert>(StreamDetails::AudioDetails::Codec);
+    case Field::StreamDetails_Audio_Channels:
+        return streamDetailsColumn<Concert>(StreamDetails::AudioDetails::Channels);
+    case Field::StreamDetails_Subtitle_Language:
+        return streamDetailsColumn<Concert>(StreamDetails::SubtitleDetails::Language);
+    }
+    return [](Concert*) { return QString{}; };
 }
 
-void CsvConcertExport::exportConcerts(const QVector<Concert*>& concerts, std::function<void()> callback)
+CsvConcertExport::CsvConcertExport(QTextStream& outStream, QVector<CsvConcertExport::Field> fields, QObject* parent) :
+    CsvMediaExport(outStream, parent), m_fields{fields}
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Concert* concert : asConst(concerts)) {
-        const auto* st = concert->streamDetails();
-        csv.addRow({
-            {s(Field::TmdbId), concert->tmdbId().toString()},
-            {s(Field::ImdbId), concert->imdbId().toString()},
-            {s(Field::Title), concert->title()},
-            {s(Field::OriginalTitle), concert->originalTitle()},
-            {s(Field::Artist), concert->artist()},
-            {s(Field::Album), concert->album()},
-            {s(Field::Overview), concert->overview()},
-            {s(Field::Ratings), ratingsToString(concert->ratings())},
-            {s(Field::UserRating), QString::number(concert->userRating())},
-            {s(Field::ReleaseDate), concert->released().toString(Qt::ISODate)},
-            {s(Field::Tagline), concert->tagline()},
-            {s(Field::Runtime), QString::number(concert->runtime().count())},
-            {s(Field::Certification), concert->certification().toString()},
-            {s(Field::Genres), concert->genres().join(", ")},
-            {s(Field::Tags), concert->tags().join(", ")},
-            {s(Field::TrailerUrl), concert->trailer().toString()},
-            {s(Field::Playcount), QString::number(concert->playcount())},
-            {s(Field::LastPlayed), concert->lastPlayed().toString(Qt::ISODate)},
-            {s(Field::Directory), dirFromFileList(concert->files())},
-            {s(Field::Filenames), filesToString(concert->files())},
-            {s(Field::StreamDetails_Video_DurationInSeconds),
-                getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-            {s(Field::StreamDetails_Video_Aspect), getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-            {s(Field::StreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-            {s(Field::StreamDetails_Video_Height), getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-            {s(Field::StreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Language), getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-            {s(Field::StreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Channels), getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-            {s(Field::StreamDetails_Subtitle_Language),
-                getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-
-        });
-        callback();
-    }
 }
 
-QVector<QString> CsvConcertExport::fieldsToStrings() const
+void CsvConcertExport::exportConcerts(const QVector<Concert*>& concerts, std::function<void()> callback)
 {
-    QVector<QString> out;
+    CsvWriter<Concert*> csv(m_out, CsvFormat(m_separator, m_replacement));
     for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
+        csv.addColumn(fieldToString(field), concertColumn(field));
     }
-    return out;
+    csv.writeHeader();
+    csv.writeRows(concerts, [&callback](Concert* const&) { callback(); });
 }
 
 QString CsvConcertExport::fieldToString(CsvConcertExport::Field field)
@@ -499,49 +504,40 @@ QString CsvConcertExport::fieldToString(CsvConcertExport::Field field)
     return "unknown";
 }
 
-CsvArtistExport::CsvArtistExport(QTextStream& outStream, QVector<CsvArtistExport::Field> fields, QObject* parent) :
-    CsvMediaExport(outStream, parent), m_fields{fields}
+static CsvWriter<Artist*>::Column artistColumn(CsvArtistExport::Field field)
 {
+    using Field = CsvArtistExport::Field;
+    switch (field) {
+    case Field::ArtistName: return [](Artist* artist) { return artist->name(); };
+    case Field::ArtistGenres: return [](Artist* artist) { return artist->genres().join(", "); };
+    case Field::ArtistStyles: return [](Artist* artist) { return artist->styles().join(", "); };
+    case Field::ArtistMoods: return [](Artist* artist) { return artist->moods().join(", "); };
+    case Field::ArtistYearsActive: return [](Artist* artist) { return artist->yearsActive(); };
+    case Field::ArtistFormed: return [](Artist* artist) { return artist->formed(); };
+    case Field::ArtistBiography: return [](Artist* artist) { return artist->biography(); };
+    case Field::ArtistBorn: return [](Artist* artist) { return artist->born(); };
+    case Field::ArtistDied: return [](Artist* artist) { return artist->died(); };
+    case Field::ArtistDisbanded: return [](Artist* artist) { return artist->disbanded(); };
+    case Field::ArtistMusicBrainzId: return [](Artist* artist) { return artist->mbId().toString(); };
+    case Field::ArtistAllMusicId: return [](Artist* artist) { return artist->allMusicId().toString(); };
+    case Field::ArtistDirectory: return [](Artist* artist) { return artist->path().toNativePathString(); };
+    }
+    return [](Artist*) { return QString{}; };
 }
 
-void CsvArtistExport::exportArtists(const QVector<Artist*>& artists, std::function<void()> callback)
+CsvArtistExport::CsvArtistExport(QTextStream& outStream, QVector<CsvArtistExport::Field> fields, QObject* parent) :
+    CsvMediaExport(outStream, parent), m_fields{fields}
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Artist* artist : asConst(artists)) {
-        csv.addRow({
-            {s(Field::ArtistName), artist->name()},
-            {s(Field::ArtistGenres), artist->genres().join(", ")},
-            {s(Field::ArtistStyles), artist->styles().join(", ")},
-            {s(Field::ArtistMoods), artist->moods().join(", ")},
-            {s(Field::ArtistYearsActive), artist->yearsActive()},
-            {s(Field::ArtistFormed), artist->formed()},
-            {s(Field::ArtistBiography), artist->biography()},
-            {s(Field::ArtistBorn), artist->born()},
-            {s(Field::ArtistDied), artist->died()},
-            {s(Field::ArtistDisbanded), artist->disbanded()},
-            {s(Field::ArtistMusicBrainzId), artist->mbId().toString()},
-            {s(Field::ArtistAllMusicId), artist->allMusicId().toString()},
-            {s(Field::ArtistDirectory), artist->path().toNativePathString()} //
-        });
-        callback();
-    }
 }
 
-QVector<QString> CsvArtistExport::fieldsToStrings() const
+void CsvArtistExport::exportArtists(const QVector<Artist*>& artists, std::function<void()> callback)
 {
-    QVector<QString> out;
+    CsvWriter<Artist*> csv(m_out, CsvFormat(m_separator, m_replacement));
     for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
+        csv.addColumn(fieldToString(field), artistColumn(field));
     }
-    return out;
+    csv.writeHeader();
+    csv.writeRows(artists, [&callback](Artist* const&) { callback(); });
 }
 
 QString CsvArtistExport::fieldToString(CsvArtistExport::Field field)
@@ -565,6 +561,42 @@ QString CsvArtistExport::fieldToString(CsvArtistExport::Field field)
 }
 
 
+namespace {
+
+struct AlbumRow
+{
+    Artist* artist = nullptr;
+    Album* album = nullptr;
+    bool isLastOfArtist = false;
+};
+
+} // namespace
+
+static CsvWriter<AlbumRow>::Column albumColumn(CsvAlbumExport::Field field)
+{
+    using Field = CsvAlbumExport::Field;
+    using Row = AlbumRow;
+    switch (field) {
+    case Field::ArtistName: return [](const Row& row) { return row.artist->name(); };
+    case Field::AlbumTitle: return [](const Row& row) { return row.album->title(); };
+    case Field::AlbumArtistName: return [](const Row& row) { return row.album->artist(); };
+    case Field::AlbumGenres: return [](const Row& row) { return row.album->genres().join(", "); };
+    case Field::AlbumStyles: return [](const Row& row) { return row.album->styles().join(", "); };
+    case Field::AlbumMoods: return [](const Row& row) { return row.album->moods().join(", "); };
+    case Field::AlbumReview: return [](const Row& row) { return row.album->review(); };
+    case Field::AlbumReleaseDate: return [](const Row& row) { return row.album->releaseDate(); };
+    case Field::AlbumLabel: return [](const Row& row) { return row.album->label(); };
+    case Field::AlbumRating: return [](const Row& row) { return QString::number(row.album->rating()); };
+    case Field::AlbumYear: return [](const Row& row) { return QString::number(row.album->year()); };
+    case Field::AlbumMusicBrainzId: return [](const Row& row) { return row.album->mbAlbumId().toString(); };
+    case Field::AlbumMusicBrainzReleaseGroupId:
+        return [](const Row& row) { return row.album->mbReleaseGroupId().toString(); };
+    case Field::AlbumAllMusicId: return [](const Row& row) { return row.album->allMusicId().toString(); };
+    case Field::AlbumDirectory: return [](const Row& row) { return row.album->path().toNativePathString(); };
+    }
+    return [](const Row&) { return QString{}; };
+}
+
 CsvAlbumExport::CsvAlbumExport(QTextStream& outStream, QVector<CsvAlbumExport::Field> fields, QObject* parent) :
     CsvMediaExport(outStream, parent), m_fields{fields}
 {
@@ -572,47 +604,27 @@ CsvAlbumExport::CsvAlbumExport(QTextStream& outStream, QVector<CsvAlbumExport::F
 
 void CsvAlbumExport::exportAlbumsOfArtists(const QVector<Artist*>& artists, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
+    CsvWriter<AlbumRow> csv(m_out, CsvFormat(m_separator, m_replacement));
+    for (const Field field : asConst(m_fields)) {
+        csv.addColumn(fieldToString(field), albumColumn(field));
+    }
     csv.writeHeader();
 
-    for (Artist* artist : asConst(artists)) {
-        const auto albums = artist->albums();
+    QVector<AlbumRow> rows;
+    for (Artist* artist : artists) {
+        const QVector<Album*> albums = artist->albums();
+        if (albums.isEmpty()) {
+            callback();
+        }
         for (Album* album : albums) {
-            csv.addRow({
-                {s(Field::ArtistName), artist->name()},
-                {s(Field::AlbumTitle), album->title()},
-                {s(Field::AlbumArtistName), album->artist()},
-                {s(Field::AlbumGenres), album->genres().join(", ")},
-                {s(Field::AlbumStyles), album->styles().join(", ")},
-                {s(Field::AlbumMoods), album->moods().join(", ")},
-                {s(Field::AlbumReview), album->review()},
-                {s(Field::AlbumReleaseDate), album->releaseDate()},
-                {s(Field::AlbumLabel), album->label()},
-                {s(Field::AlbumRating), QString::number(album->rating())},
-                {s(Field::AlbumYear), QString::number(album->year())},
-                {s(Field::AlbumMusicBrainzId), album->mbAlbumId().toString()},
-                {s(Field::AlbumMusicBrainzReleaseGroupId), album->mbReleaseGroupId().toString()},
-                {s(Field::AlbumAllMusicId), album->allMusicId().toString()},
-                {s(Field::AlbumDirectory), album->path().toNativePathString()} //
-            });
+            rows.push_back({artist, album, album == albums.last()});
         }
-        callback();
     }
-}
-
-QVector<QString> CsvAlbumExport::fieldsToStrings() const
-{
-    QVector<QString> out;
-    for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
-    }
-    return out;
+    csv.writeRows(rows, [&callback](const AlbumRow& row) {
+        if (row.isLastOfArtist) {
+            callback();
+        }
+    });
 }
 
 QString CsvAlbumExport::fieldToString(CsvAlbumExport::Field field)
@@ -637,58 +649,4 @@ QString CsvAlbumExport::fieldToString(CsvAlbumExport::Field field)
     return "unknown";
 }
 
-void CsvExport::writeHeader()
-{
-    QVector<QString>::const_iterator i = m_fieldsInOrder.cbegin();
-    writeEscaped(*i);
-    ++i;
-
-    for (; i != m_fieldsInOrder.cend(); ++i) {
-        m_out << m_separator;
-        writeEscaped(*i);
-    }
-    m_out << "\n";
-}
-
-void CsvExport::addRow(const QMap<QString, QString>& values)
-{
-    if (m_fieldsInOrder.isEmpty()) {
-        return;
-    }
-
-    QVector<QString>::const_iterator i = m_fieldsInOrder.cbegin();
-    writeEscaped(values.value(*i));
-    ++i;
-
-    for (; i != m_fieldsInOrder.cend(); ++i) {
-        m_out << m_separator;
-        writeEscaped(values.value(*i));
-    }
-    m_out << "\n";
-}
-
-void CsvExport::writeEscaped(const QString& text)
-{
-    // See https://owasp.org/www-community/attacks/CSV_Injection
-    // Microsoft Excel and other tools are... bad with user provided data.  If a field starts with '=', it's
-    // interpreted as code.  So we prepend it with a '.
-    bool startsWithForbiddenCharacter = text.startsWith("=") || text.startsWith("@") || text.startsWith("\t")
-                                        || text.startsWith("\r") || text.startsWith("+") || text.startsWith("-");
-
-    if (!text.contains(m_separator) && !text.contains("\n") && !startsWithForbiddenCharacter) {
-        m_out << text;
-        return;
-    }
-
-    if (startsWithForbiddenCharacter) {
-        m_out << "'";
-    }
-
-    m_out << (QString(text)
-                  .replace(m_separator, m_replacement)
-                  .replace("\r\n", "\\n")
-                  .replace("\n", "\\n")
-                  .replace("\r", "\\n"));
-}
-
 } // namespace mediaelch
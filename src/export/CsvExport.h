@@ -3,7 +3,6 @@
 #include "data/Rating.h"
 #include "globals/Meta.h"
 
-#include <QMap>
 #include <QObject>
 #include <QRegularExpression>
 #include <QString>
@@ -19,6 +18,8 @@ class Artist;
 
 namespace mediaelch {
 
+/// \brief Base class of all CSV exporters.  Only the selected fields are formatted; rows are
+///        formatted in parallel and streamed to the output, see CsvWriter.
 class CsvMediaExport : public QObject
 {
     Q_OBJECT
@@ -92,9 +93,6 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
@@ -139,9 +137,6 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
@@ -195,9 +190,6 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
@@ -251,9 +243,6 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
@@ -291,9 +280,6 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
@@ -333,37 +319,8 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
 
-
-class CsvExport : public QObject
-{
-    Q_OBJECT
-
-public:
-    explicit CsvExport(QTextStream& outStream, QObject* parent = nullptr) : QObject(parent), m_out{outStream} {}
-
-    void setFieldsInOrder(QVector<QString> fieldsInOrder) { m_fieldsInOrder = std::move(fieldsInOrder); }
-    void setSeparator(QString separator) { m_separator = std::move(separator); }
-    void setReplacement(QString replacement) { m_replacement = std::move(replacement); }
-
-    /// \brief Writes a CSV header using the given fieldsInOrder
-    void writeHeader();
-    void addRow(const QMap<QString, QString>& values);
-
-private:
-    void writeEscaped(const QString& text);
-
-private:
-    QTextStream& m_out;
-    QVector<QString> m_fieldsInOrder;
-    QString m_separator;
-    QString m_replacement;
-};
-
 } // namespace mediaelch
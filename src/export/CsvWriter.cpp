@@ -0,0 +1,29 @@
+#include "export/CsvWriter.h"
+
+namespace mediaelch {
+
+void CsvFormat::appendEscaped(QString& out, const QString& text) const
+{
+    // See https://owasp.org/www-community/attacks/CSV_Injection
+    // Microsoft Excel and other tools are... bad with user provided data.  If a field starts with '=', it's
+    // interpreted as code.  So we prepend it with a '.
+    bool startsWithForbiddenCharacter = text.startsWith("=") || text.startsWith("@") || text.startsWith("\t")
+                                        || text.startsWith("\r") || text.startsWith("+") || text.startsWith("-");
+
+    if (!text.contains(m_separator) && !text.contains("\n") && !startsWithForbiddenCharacter) {
+        out += text;
+        return;
+    }
+
+    if (startsWithForbiddenCharacter) {
+        out += "'";
+    }
+
+    out += QString(text)
+               .replace(m_separator, m_replacement)
+               .replace("\r\n", "\\n")
+               .replace("\n", "\\n")
+               .replace("\r", "\\n");
+}
+
+} // namespace mediaelch
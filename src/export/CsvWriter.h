@@ -0,0 +1,130 @@
+#pragma once
+
+#include <QFuture>
+#include <QString>
+#include <QTextStream>
+#include <QVector>
+#include <QtConcurrent>
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Escapes values for CSV files.
+class CsvFormat
+{
+public:
+    CsvFormat(QString separator, QString replacement) :
+        m_separator{std::move(separator)}, m_replacement{std::move(replacement)}
+    {
+    }
+
+    const QString& separator() const { return m_separator; }
+
+    /// \brief Appends the text to the output.  Replaces separators and line breaks and
+    ///        prevents CSV injection.
+    void appendEscaped(QString& out, const QString& text) const;
+
+private:
+    QString m_separator;
+    QString m_replacement;
+};
+
+/// \brief   Streaming, column-oriented CSV writer.
+/// \details Each column is a function that returns the column's value for a row.  Rows are
+///          formatted in parallel in chunks of CHUNK_SIZE rows.  While a chunk is written,
+///          the next one is formatted.  Because at most two chunks are kept in memory,
+///          memory usage does not depend on the number of rows.
+///
+///          Row should be cheap to copy, e.g. a pointer.  Columns are called on worker
+///          threads, so the rows must not be modified while writing them.
+template<class Row>
+class CsvWriter
+{
+public:
+    using Column = std::function<QString(const Row& row)>;
+
+    static constexpr int CHUNK_SIZE = 256;
+
+public:
+    CsvWriter(QTextStream& out, CsvFormat format) : m_out{out}, m_format{std::move(format)} {}
+
+    void addColumn(const QString& heading, Column column)
+    {
+        m_headings.push_back(heading);
+        m_columns.push_back(std::move(column));
+    }
+
+    void writeHeader()
+    {
+        if (m_headings.isEmpty()) {
+            return;
+        }
+        QString line;
+        for (int i = 0; i < m_headings.size(); ++i) {
+            if (i > 0) {
+                line += m_format.separator();
+            }
+            m_format.appendEscaped(line, m_headings[i]);
+        }
+        m_out << line << "\n";
+    }
+
+    /// \brief Writes the rows in order.
+    /// \param rowWritten Called on the calling thread after each row was written.
+    void writeRows(const QVector<Row>& rows, const std::function<void(const Row& row)>& rowWritten)
+    {
+        if (m_columns.isEmpty()) {
+            for (const Row& row : rows) {
+                rowWritten(row);
+            }
+            return;
+        }
+
+        const std::function<QString(const Row&)> format = [this](const Row& row) { return formatRow(row); };
+        const auto formatChunk = [&rows, &format](int begin) {
+            const int end = qMin(begin + CHUNK_SIZE, rows.size());
+            return QtConcurrent::mapped(rows.constBegin() + begin, rows.constBegin() + end, format);
+        };
+
+        QFuture<QString> current = formatChunk(0);
+        for (int begin = 0; begin < rows.size(); begin += CHUNK_SIZE) {
+            const int next = begin + CHUNK_SIZE;
+            current.waitForFinished();
+            QFuture<QString> upcoming;
+            if (next < rows.size()) {
+                upcoming = formatChunk(next);
+            }
+            const int count = qMin(CHUNK_SIZE, rows.size() - begin);
+            for (int i = 0; i < count; ++i) {
+                m_out << current.resultAt(i);
+                rowWritten(rows[begin + i]);
+            }
+            current = upcoming;
+        }
+    }
+
+private:
+    QString formatRow(const Row& row) const
+    {
+        QString line;
+        for (int i = 0; i < m_columns.size(); ++i) {
+            if (i > 0) {
+                line += m_format.separator();
+            }
+            m_format.appendEscaped(line, m_columns[i](row));
+        }
+        line += '\n';
+        return line;
+    }
+
+private:
+    QTextStream& m_out;
+    CsvFormat m_format;
+    QVector<QString> m_headings;
+    QVector<Column> m_columns;
+};
+
+template<class Row>
+constexpr int CsvWriter<Row>::CHUNK_SIZE;
+
+} // namespace mediaelch
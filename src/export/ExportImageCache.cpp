@@ -0,0 +1,186 @@
+#include "export/ExportImageCache.h"
+
+#include "log/Log.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+namespace {
+
+qint64 currentSecsSinceEpoch()
+{
+    // QDateTime::currentSecsSinceEpoch() requires Qt 5.8
+    return QDateTime::currentMSecsSinceEpoch() / 1000;
+}
+
+} // namespace
+
+namespace mediaelch {
+
+constexpr int ExportImageCache::MAX_UNUSED_DAYS;
+
+QImage ExportImageCache::readScaled(const QString& imageFile, const QSize& size)
+{
+    QImageReader reader(imageFile);
+    const QSize originalSize = reader.size();
+    if (originalSize.isValid()) {
+        reader.setScaledSize(originalSize.scaled(size, Qt::KeepAspectRatio));
+        return reader.read();
+    }
+    // The format does not know the size without decoding the image.
+    const QImage image = reader.read();
+    return image.isNull() ? image : image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+ExportImageCache::ExportImageCache(const QString& directory) : m_directory{directory}
+{
+    if (!m_directory.isEmpty()) {
+        QDir().mkpath(m_directory);
+        load();
+    }
+}
+
+ExportImageCache::Result ExportImageCache::exportImage(const QString& sourceFile,
+    const QSize& size,
+    const QString& destinationFile,
+    int quality)
+{
+    const QFileInfo source(sourceFile);
+    if (!source.exists()) {
+        qCWarning(generic) << "[ExportImageCache] Source image does not exist:" << sourceFile;
+        return Result::Failed;
+    }
+    const qint64 lastModified = source.lastModified().toMSecsSinceEpoch();
+    const QString suffix = QFileInfo(destinationFile).suffix().toLower();
+    const QString key = QStringLiteral("%1|%2x%3|%4|%5")
+                            .arg(source.absoluteFilePath())
+                            .arg(size.width())
+                            .arg(size.height())
+                            .arg(suffix)
+                            .arg(quality);
+
+    if (!m_directory.isEmpty()) {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end() && it->sourceLastModified == lastModified && it->sourceSize == source.size()) {
+            const QString cachedFile = m_directory + "/" + it->fileName;
+            it->lastUsed = currentSecsSinceEpoch();
+            locker.unlock();
+            if (QFileInfo::exists(destinationFile) || copyFile(cachedFile, destinationFile)) {
+                return Result::Reused;
+            }
+            // The cached file was removed; encode it again.
+        }
+    }
+
+    const QImage image = readScaled(sourceFile, size);
+    if (image.isNull()) {
+        qCWarning(generic) << "[ExportImageCache] Cannot load image:" << sourceFile;
+        return Result::Failed;
+    }
+    if (!writeImage(image, destinationFile, quality)) {
+        qCWarning(generic) << "[ExportImageCache] Cannot write image:" << destinationFile;
+        return Result::Failed;
+    }
+
+    if (m_directory.isEmpty()) {
+        return Result::Encoded;
+    }
+
+    Entry entry;
+    entry.sourceLastModified = lastModified;
+    entry.sourceSize = source.size();
+    entry.fileName = QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex())
+                     + "." + suffix;
+    entry.lastUsed = currentSecsSinceEpoch();
+    if (copyFile(destinationFile, m_directory + "/" + entry.fileName)) {
+        QMutexLocker locker(&m_mutex);
+        m_entries.insert(key, entry);
+    }
+    return Result::Encoded;
+}
+
+void ExportImageCache::save()
+{
+    if (m_directory.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    const qint64 oldestUsage = currentSecsSinceEpoch() - MAX_UNUSED_DAYS * 24 * 60 * 60;
+    QJsonObject manifest;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->lastUsed < oldestUsage) {
+            QFile::remove(m_directory + "/" + it->fileName);
+            it = m_entries.erase(it);
+            continue;
+        }
+        QJsonObject entry;
+        entry.insert("sourceLastModified", QString::number(it->sourceLastModified));
+        entry.insert("sourceSize", QString::number(it->sourceSize));
+        entry.insert("file", it->fileName);
+        entry.insert("lastUsed", QString::number(it->lastUsed));
+        manifest.insert(it.key(), entry);
+        ++it;
+    }
+
+    QSaveFile file(manifestFile());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(generic) << "[ExportImageCache] Cannot write manifest:" << manifestFile();
+        return;
+    }
+    file.write(QJsonDocument(manifest).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+void ExportImageCache::load()
+{
+    QFile file(manifestFile());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const QJsonObject manifest = QJsonDocument::fromJson(file.readAll()).object();
+    for (auto it = manifest.begin(); it != manifest.end(); ++it) {
+        const QJsonObject object = it.value().toObject();
+        Entry entry;
+        // Stored as strings because JSON numbers are doubles.
+        entry.sourceLastModified = object.value("sourceLastModified").toString().toLongLong();
+        entry.sourceSize = object.value("sourceSize").toString().toLongLong();
+        entry.fileName = object.value("file").toString();
+        entry.lastUsed = object.value("lastUsed").toString().toLongLong();
+        if (!entry.fileName.isEmpty()) {
+            m_entries.insert(it.key(), entry);
+        }
+    }
+}
+
+QString ExportImageCache::manifestFile() const
+{
+    return m_directory + "/manifest.json";
+}
+
+bool ExportImageCache::writeImage(const QImage& image, const QString& fileName, int quality)
+{
+    QImageWriter writer(fileName);
+    writer.setQuality(quality);
+    return writer.write(image);
+}
+
+bool ExportImageCache::copyFile(const QString& from, const QString& to)
+{
+    if (QFile::exists(to)) {
+        QFile::remove(to);
+    }
+    return QFile::copy(from, to);
+}
+
+} // namespace mediaelch
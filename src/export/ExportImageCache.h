@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+
+namespace mediaelch {
+
+/// \brief   Scaled images of previous exports.
+/// \details Each export is written to a new directory, so without a cache every export has
+///          to decode and scale all posters and backdrops again.  Scaled images are stored
+///          in the cache directory together with a manifest of their source file's
+///          modification time and size.  If the source is unchanged, the cached image is
+///          copied instead.
+///
+///          exportImage() is thread-safe.  Call save() after the export to keep the manifest
+///          for the next export.
+class ExportImageCache
+{
+public:
+    enum class Result
+    {
+        Failed,
+        /// \brief The image was decoded, scaled and stored in the cache.
+        Encoded,
+        /// \brief The cached image was used.
+        Reused
+    };
+
+    /// \brief Entries that were not used for this long are removed by save().
+    static constexpr int MAX_UNUSED_DAYS = 90;
+
+    /// \brief Decodes the image and scales it to fit into the given size.  Only decodes
+    ///        as many pixels as necessary if the image format supports it (e.g. JPEG).
+    static QImage readScaled(const QString& imageFile, const QSize& size);
+
+public:
+    /// \param directory Cache directory.  An empty path disables the cache.
+    explicit ExportImageCache(const QString& directory);
+
+    /// \brief Writes the source image scaled to the given size to the destination file.
+    ///        The format is taken from the destination file's extension.
+    /// \param quality Quality as in QImageWriter::setQuality(), -1 for the default.
+    Result exportImage(const QString& sourceFile, const QSize& size, const QString& destinationFile, int quality = -1);
+
+    /// \brief Writes the manifest and removes entries that were not used for a long time.
+    void save();
+
+private:
+    struct Entry
+    {
+        qint64 sourceLastModified = 0;
+        qint64 sourceSize = 0;
+        QString fileName;
+        /// \brief Last export that used the entry in seconds since epoch.
+        qint64 lastUsed = 0;
+    };
+
+    void load();
+    QString manifestFile() const;
+    static bool writeImage(const QImage& image, const QString& fileName, int quality);
+    static bool copyFile(const QString& from, const QString& to);
+
+    QString m_directory;
+    QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+};
+
+} // namespace mediaelch
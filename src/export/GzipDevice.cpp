@@ -0,0 +1,119 @@
+#include "export/GzipDevice.h"
+
+#include "log/Log.h"
+
+#include <array>
+
+namespace {
+
+std::array<quint32, 256> crc32Table()
+{
+    std::array<quint32, 256> table{};
+    for (quint32 i = 0; i < 256; ++i) {
+        quint32 crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1U) != 0 ? (0xEDB88320U ^ (crc >> 1)) : (crc >> 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+void appendLittleEndian(QByteArray& out, quint32 value)
+{
+    for (int i = 0; i < 4; ++i) {
+        out.append(static_cast<char>((value >> (8 * i)) & 0xFFU));
+    }
+}
+
+} // namespace
+
+namespace mediaelch {
+
+constexpr int GzipDevice::MEMBER_SIZE;
+
+quint32 GzipDevice::crc32(const QByteArray& data)
+{
+    static const std::array<quint32, 256> table = crc32Table();
+    quint32 crc = 0xFFFFFFFFU;
+    for (const char c : data) {
+        crc = table[(crc ^ static_cast<quint8>(c)) & 0xFFU] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+GzipDevice::GzipDevice(QIODevice* target, QObject* parent) : QIODevice(parent), m_target{target}
+{
+}
+
+GzipDevice::~GzipDevice()
+{
+    GzipDevice::close();
+}
+
+bool GzipDevice::open(OpenMode mode)
+{
+    if (mode.testFlag(ReadOnly) || m_target == nullptr || !m_target->isWritable()) {
+        setErrorString(tr("GzipDevice can only be opened for writing to a writable device"));
+        return false;
+    }
+    m_pending.clear();
+    return QIODevice::open(mode);
+}
+
+void GzipDevice::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+    writeMember();
+    QIODevice::close();
+}
+
+qint64 GzipDevice::readData(char* data, qint64 maxSize)
+{
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+    return -1;
+}
+
+qint64 GzipDevice::writeData(const char* data, qint64 size)
+{
+    m_pending.append(data, static_cast<int>(size));
+    if (m_pending.size() >= MEMBER_SIZE && !writeMember()) {
+        return -1;
+    }
+    return size;
+}
+
+bool GzipDevice::writeMember()
+{
+    if (m_pending.isEmpty()) {
+        return true;
+    }
+
+    // qCompress() returns the uncompressed size (4 bytes) followed by a zlib stream: a 2 byte
+    // header, the raw deflate data and an Adler-32 checksum (4 bytes).  gzip uses the same
+    // deflate data with a different header and trailer.
+    const QByteArray compressed = qCompress(m_pending);
+    constexpr int prefixSize = 4 + 2;
+    constexpr int suffixSize = 4;
+
+    QByteArray member;
+    member.reserve(10 + compressed.size() - prefixSize - suffixSize + 8);
+    // ID1, ID2, deflate, no flags, no modification time, no extra flags, unknown OS
+    member.append("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10);
+    member.append(compressed.constData() + prefixSize, compressed.size() - prefixSize - suffixSize);
+    appendLittleEndian(member, crc32(m_pending));
+    appendLittleEndian(member, static_cast<quint32>(m_pending.size()));
+    m_pending.clear();
+
+    if (m_target->write(member) != member.size()) {
+        qCWarning(generic) << "[GzipDevice] Could not write compressed data:" << m_target->errorString();
+        setErrorString(m_target->errorString());
+        return false;
+    }
+    return true;
+}
+
+} // namespace mediaelch
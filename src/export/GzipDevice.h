@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+
+namespace mediaelch {
+
+/// \brief   Write-only device that compresses everything written to it in gzip format.
+/// \details Data is compressed in members of MEMBER_SIZE bytes which are written to the
+///          target device one after another.  A gzip file may consist of several members,
+///          so this is a valid gzip file while only one member has to be kept in memory.
+///          Uses qCompress(), i.e. Qt's zlib, so no additional library is required.
+///
+///          The target device must be open for writing and is not closed.
+class GzipDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    /// \brief Uncompressed size of one gzip member.
+    static constexpr int MEMBER_SIZE = 1024 * 1024;
+
+    /// \brief CRC-32 as used by gzip.
+    static quint32 crc32(const QByteArray& data);
+
+public:
+    explicit GzipDevice(QIODevice* target, QObject* parent = nullptr);
+    ~GzipDevice() override;
+
+    bool open(OpenMode mode) override;
+    /// \brief Writes the remaining data.
+    void close() override;
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 size) override;
+
+private:
+    bool writeMember();
+
+    QIODevice* m_target = nullptr;
+    QByteArray m_pending;
+};
+
+} // namespace mediaelch
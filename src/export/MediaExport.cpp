@@ -6,6 +6,7 @@
 #include "globals/Manager.h"
 #include "log/Log.h"
 #include "movies/Movie.h"
+#include "settings/Settings.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 
@@ -26,8 +27,11 @@ void MediaExport::doExport(ExportTemplate& exportTemplate,
 
     switch (exportTemplate.templateEngine()) {
     case ExportEngine::Simple:
-        SimpleEngine engine(exportTemplate, directory, m_canceled);
-        connect(&engine, &SimpleEngine::sigItemExported, [&]() { emit sigItemExported(); });
+        // Images of previous exports are reused if their source is unchanged.
+        ExportImageCache imageCache(Settings::instance()->exportImageCacheDir().toString());
+        SimpleEngine engine(exportTemplate, directory, imageCache, m_canceled);
+        // The engine emits sigItemExported from worker threads; queue it to this thread.
+        connect(&engine, &SimpleEngine::sigItemExported, this, &MediaExport::sigItemExported, Qt::QueuedConnection);
 
         if (!m_canceled && sections.contains(ExportTemplate::ExportSection::Movies)) {
             engine.exportMovies(Manager::instance()->movieModel()->movies());
@@ -40,6 +44,7 @@ void MediaExport::doExport(ExportTemplate& exportTemplate,
         if (!m_canceled && sections.contains(ExportTemplate::ExportSection::Concerts)) {
             engine.exportConcerts(Manager::instance()->concertModel()->concerts());
         }
+        imageCache.save();
         return;
     }
     qCCritical(generic) << "[MediaExport] Unknown template engine!";
@@ -7,8 +7,9 @@
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 
-#include <QApplication>
 #include <QEventLoop>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 static QString colorLabelToString(ColorLabel label)
 {
@@ -29,128 +30,176 @@ namespace mediaelch {
 
 SimpleEngine::SimpleEngine(ExportTemplate& exportTemplate,
     QDir directory,
+    ExportImageCache& imageCache,
     std::atomic_bool& cancelFlag,
     QObject* parent) :
-    QObject(parent), m_cancelFlag{cancelFlag}, m_template{&exportTemplate}, m_dir{directory}
+    QObject(parent),
+    m_imageCache{imageCache},
+    m_cancelFlag{cancelFlag},
+    m_template{&exportTemplate},
+    m_dir{directory}
 {
     // Create the base structure
     m_template->copyTo(mediaelch::DirectoryPath(m_dir));
 }
 
+template<class T>
+QStringList SimpleEngine::renderInParallel(const QVector<T>& items, std::function<QString(const T&)> renderItem)
+{
+    const auto render = [this, renderItem](const T& item) -> QString {
+        if (m_cancelFlag.load()) {
+            return {};
+        }
+        return renderItem(item);
+    };
+
+    QFutureWatcher<QString> watcher;
+    QEventLoop loop;
+    connect(&watcher, &QFutureWatcher<QString>::finished, &loop, &QEventLoop::quit);
+    watcher.setFuture(QtConcurrent::mapped(items, std::function<QString(const T&)>(render)));
+    if (!watcher.isFinished()) {
+        // sigItemExported is emitted by the worker threads, so receivers must use a queued
+        // connection.  This loop keeps the UI responsive and delivers the queued signals.
+        loop.exec();
+    }
+    return watcher.future().results();
+}
+
+TemplateData::ImageResolver SimpleEngine::imageResolver(const ItemImages& images, bool subDir) const
+{
+    return [this, images, subDir](const QString& type, const QSize& size, bool* isPlaceholderUsed) {
+        const QString prefix = subDir ? "../" : "";
+        const QString placeholder =
+            QString("defaults/%1_%2_%3x%4.png").arg(images.typeName).arg(type).arg(size.width()).arg(size.height());
+
+        const auto image = images.images.constFind(type);
+        if (image == images.images.cend()) {
+            *isPlaceholderUsed = false;
+            return prefix + placeholder;
+        }
+        *isPlaceholderUsed = true;
+        if (image->sourceFile.isEmpty()) {
+            return prefix + placeholder;
+        }
+
+        const QString destFile = QString("%1-%2_%3x%4.%5")
+                                     .arg(images.destPrefix)
+                                     .arg(type)
+                                     .arg(size.width())
+                                     .arg(size.height())
+                                     .arg(image->format);
+        const int imageQuality = (image->format == "jpg") ? 90 : -1;
+        saveImage(size, image->sourceFile, m_dir.path() + "/" + destFile, imageQuality);
+        return prefix + destFile;
+    };
+}
+
+void SimpleEngine::writeFile(const QString& fileName, const QString& content) const
+{
+    QFile file(m_dir.path() + "/" + fileName);
+    if (file.open(QFile::WriteOnly | QFile::Text)) {
+        file.write(content.toUtf8());
+        file.close();
+    }
+}
+
 void SimpleEngine::exportMovies(QVector<Movie*> movies)
 {
     std::sort(movies.begin(), movies.end(), Movie::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::Movies);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::Movie);
-
-    QString listMovieItem;
-    QString listMovieBlock;
-    QStringList movieList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_MOVIE \}\}(.*)\{\{ END_BLOCK_MOVIE \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listMovieBlock = match.captured(0);
-        listMovieItem = match.captured(1).trimmed();
-    }
+    const CompiledTemplate listContent(m_template->getTemplate(ExportTemplate::ExportSection::Movies));
+    const CompiledTemplate itemContent(m_template->getTemplate(ExportTemplate::ExportSection::Movie));
+    const CompiledTemplate listMovieItem = listContent.block("MOVIE");
 
     m_dir.mkdir("movies");
     m_dir.mkdir("movie_images");
 
-    for (Movie* movie : movies) {
-        if (m_cancelFlag.load()) {
-            return;
-        }
+    // Movies may be changed or deleted while rendering, so only copies of their data are used.
+    QVector<ItemData> movieData;
+    movieData.reserve(movies.size());
+    for (Movie* movie : asConst(movies)) {
+        movieData.push_back({movie->movieId(), templateData(movie), itemImages(movie)});
+    }
 
+    const QStringList movieList = renderInParallel<ItemData>(movieData, [&](const ItemData& movie) {
+        TemplateData data = movie.data;
+        if (!itemContent.isEmpty()) {
+            data.images = imageResolver(movie.images, true);
+            writeFile(QStringLiteral("movies/%1.html").arg(movie.id), itemContent.render(data));
+        }
         // We can't replace an empty block...
+        QString listItem;
         if (!listMovieItem.isEmpty()) {
-            QString m = listMovieItem;
-            replaceVars(m, movie);
-            movieList << m;
+            data.images = imageResolver(movie.images, false);
+            listItem = listMovieItem.render(data);
         }
-
-        if (!itemContent.isEmpty()) {
-            QString movieTemplate = itemContent;
-            replaceVars(movieTemplate, movie, true);
-            QFile file(m_dir.path() + QStringLiteral("/movies/%1.html").arg(movie->movieId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(movieTemplate.toUtf8());
-                file.close();
-            }
-        }
-
         emit sigItemExported();
-        QApplication::processEvents();
-    }
+        return listItem;
+    });
 
-    // If the movie block is empty, replacing it would result in add a line break after each character
-    if (!listMovieBlock.isEmpty()) {
-        listContent.replace(listMovieBlock, movieList.join("\n"));
+    if (m_cancelFlag.load()) {
+        return;
     }
 
-    QFile file(m_dir.path() + "/movies.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
-    }
+    TemplateData listData;
+    listData.renderedBlocks.insert("MOVIE", movieList.join("\n"));
+    writeFile("movies.html", listContent.render(listData));
 }
 
-void SimpleEngine::replaceVars(QString& m, Movie* movie, bool subDir)
+TemplateData SimpleEngine::templateData(Movie* movie) const
 {
-    m.replace("{{ MOVIE.ID }}", QString::number(movie->movieId(), 'f', 0));
-    m.replace("{{ MOVIE.LINK }}", QString("movies/%1.html").arg(movie->movieId()));
-    m.replace("{{ MOVIE.IMDB_ID }}", movie->imdbId().toString());
-    m.replace("{{ MOVIE.TMDB_ID }}", movie->tmdbId().toString());
-    m.replace("{{ MOVIE.TITLE }}", movie->name().toHtmlEscaped());
-    m.replace("{{ MOVIE.YEAR }}", movie->released().isValid() ? movie->released().toString("yyyy") : "");
-    m.replace("{{ MOVIE.ORIGINAL_TITLE }}", movie->originalName().toHtmlEscaped());
-    m.replace("{{ MOVIE.PLOT }}", movie->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ MOVIE.PLOT_SIMPLE }}", movie->outline().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ MOVIE.SET }}", movie->set().name.toHtmlEscaped());
-    m.replace("{{ MOVIE.TAGLINE }}", movie->tagline().toHtmlEscaped());
-    m.replace("{{ MOVIE.GENRES }}", movie->genres().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.COUNTRIES }}", movie->countries().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.STUDIOS }}", movie->studios().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.TAGS }}", movie->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.WRITER }}", movie->writer().toHtmlEscaped());
-    m.replace("{{ MOVIE.DIRECTOR }}", movie->director().toHtmlEscaped());
-    m.replace("{{ MOVIE.CERTIFICATION }}", movie->certification().toString().toHtmlEscaped());
-    m.replace("{{ MOVIE.TRAILER }}", movie->trailer().toString());
-    m.replace("{{ MOVIE.LABEL }}", colorLabelToString(movie->label()));
+    TemplateData data;
+    QHash<QString, QString>& m = data.variables;
+    m.insert("MOVIE.ID", QString::number(movie->movieId(), 'f', 0));
+    m.insert("MOVIE.LINK", QString("movies/%1.html").arg(movie->movieId()));
+    m.insert("MOVIE.IMDB_ID", movie->imdbId().toString());
+    m.insert("MOVIE.TMDB_ID", movie->tmdbId().toString());
+    m.insert("MOVIE.TITLE", movie->name().toHtmlEscaped());
+    m.insert("MOVIE.YEAR", movie->released().isValid() ? movie->released().toString("yyyy") : "");
+    m.insert("MOVIE.ORIGINAL_TITLE", movie->originalName().toHtmlEscaped());
+    m.insert("MOVIE.PLOT", movie->overview().toHtmlEscaped().replace("\n", "<br />"));
+    m.insert("MOVIE.PLOT_SIMPLE", movie->outline().toHtmlEscaped().replace("\n", "<br />"));
+    m.insert("MOVIE.SET", movie->set().name.toHtmlEscaped());
+    m.insert("MOVIE.TAGLINE", movie->tagline().toHtmlEscaped());
+    m.insert("MOVIE.GENRES", movie->genres().join(", ").toHtmlEscaped());
+    m.insert("MOVIE.COUNTRIES", movie->countries().join(", ").toHtmlEscaped());
+    m.insert("MOVIE.STUDIOS", movie->studios().join(", ").toHtmlEscaped());
+    m.insert("MOVIE.TAGS", movie->tags().join(", ").toHtmlEscaped());
+    m.insert("MOVIE.WRITER", movie->writer().toHtmlEscaped());
+    m.insert("MOVIE.DIRECTOR", movie->director().toHtmlEscaped());
+    m.insert("MOVIE.CERTIFICATION", movie->certification().toString().toHtmlEscaped());
+    m.insert("MOVIE.TRAILER", movie->trailer().toString());
+    m.insert("MOVIE.LABEL", colorLabelToString(movie->label()));
 
     // \todo multiple ratings
     if (!movie->ratings().isEmpty()) {
         double rating = movie->ratings().first().rating;
         int voteCount = movie->ratings().first().voteCount;
-        m.replace("{{ MOVIE.RATING }}", QString::number(rating, 'f', 1));
-        m.replace("{{ MOVIE.VOTES }}", QString::number(voteCount, 'f', 0));
+        m.insert("MOVIE.RATING", QString::number(rating, 'f', 1));
+        m.insert("MOVIE.VOTES", QString::number(voteCount, 'f', 0));
     } else {
-        m.replace("{{ MOVIE.RATING }}", "n/a");
-        m.replace("{{ MOVIE.VOTES }}", "n/a");
+        m.insert("MOVIE.RATING", "n/a");
+        m.insert("MOVIE.VOTES", "n/a");
     }
 
-    m.replace("{{ MOVIE.RUNTIME }}", QString::number(static_cast<double>(movie->runtime().count()), 'f', 0));
-    m.replace("{{ MOVIE.PLAY_COUNT }}", QString::number(movie->playcount(), 'f', 0));
-    m.replace("{{ MOVIE.LAST_PLAYED }}",
-        movie->lastPlayed().isValid() ? movie->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace(
-        "{{ MOVIE.DATE_ADDED }}", movie->dateAdded().isValid() ? movie->dateAdded().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ MOVIE.FILE_LAST_MODIFIED }}",
+    m.insert("MOVIE.RUNTIME", QString::number(static_cast<double>(movie->runtime().count()), 'f', 0));
+    m.insert("MOVIE.PLAY_COUNT", QString::number(movie->playcount(), 'f', 0));
+    m.insert(
+        "MOVIE.LAST_PLAYED", movie->lastPlayed().isValid() ? movie->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
+    m.insert("MOVIE.DATE_ADDED", movie->dateAdded().isValid() ? movie->dateAdded().toString("yyyy-MM-dd hh:mm") : "");
+    m.insert("MOVIE.FILE_LAST_MODIFIED",
         movie->fileLastModified().isValid() ? movie->fileLastModified().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ MOVIE.FILENAME }}", (!movie->files().isEmpty()) ? movie->files().first().toString() : "");
+    m.insert("MOVIE.FILENAME", (!movie->files().isEmpty()) ? movie->files().first().toString() : "");
     if (!movie->files().isEmpty()) {
         QFileInfo fi(movie->files().first().toString());
-        m.replace("{{ MOVIE.DIR }}", fi.absolutePath());
+        m.insert("MOVIE.DIR", fi.absolutePath());
     } else {
-        m.replace("{{ MOVIE.DIR }}", "");
+        m.insert("MOVIE.DIR", "");
     }
 
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", movie->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", movie->genres());
-    replaceSingleBlock(m, "COUNTRIES", "COUNTRY.NAME", movie->countries());
-    replaceSingleBlock(m, "STUDIOS", "STUDIO.NAME", movie->studios());
+    data.blocks.insert("TAGS", singleBlock("TAG.NAME", movie->tags()));
+    data.blocks.insert("GENRES", singleBlock("GENRE.NAME", movie->genres()));
+    data.blocks.insert("COUNTRIES", singleBlock("COUNTRY.NAME", movie->countries()));
+    data.blocks.insert("STUDIOS", singleBlock("STUDIO.NAME", movie->studios()));
 
     QStringList actorNames;
     QStringList actorRoles;
@@ -158,209 +207,195 @@ void SimpleEngine::replaceVars(QString& m, Movie* movie, bool subDir)
         actorNames << actor->name;
         actorRoles << actor->role;
     }
-    replaceMultiBlock(m, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, QVector<QStringList>() << actorNames << actorRoles);
+    data.blocks.insert("ACTORS", multiBlock({"ACTOR.NAME", "ACTOR.ROLE"}, {actorNames, actorRoles}));
 
-    replaceStreamDetailsVars(m, movie->streamDetails());
-    replaceImages(m, subDir, movie, nullptr, nullptr, nullptr);
+    addStreamDetails(data, movie->streamDetails());
+    return data;
 }
 
 void SimpleEngine::exportConcerts(QVector<Concert*> concerts)
 {
     std::sort(concerts.begin(), concerts.end(), Concert::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::Concerts);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::Concert);
-
-    QString listConcertItem;
-    QString listConcertBlock;
-    QStringList concertList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_CONCERT \}\}(.*)\{\{ END_BLOCK_CONCERT \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listConcertBlock = match.captured(0);
-        listConcertItem = match.captured(1).trimmed();
-    }
+    const CompiledTemplate listContent(m_template->getTemplate(ExportTemplate::ExportSection::Concerts));
+    const CompiledTemplate itemContent(m_template->getTemplate(ExportTemplate::ExportSection::Concert));
+    const CompiledTemplate listConcertItem = listContent.block("CONCERT");
 
     m_dir.mkdir("concerts");
     m_dir.mkdir("concert_images");
 
-    for (const Concert* concert : concerts) {
-        if (m_cancelFlag.load()) {
-            return;
-        }
+    // Concerts may be changed or deleted while rendering, so only copies of their data are used.
+    QVector<ItemData> concertData;
+    concertData.reserve(concerts.size());
+    for (const Concert* concert : asConst(concerts)) {
+        concertData.push_back({concert->concertId(), templateData(concert), itemImages(concert)});
+    }
 
-        QString concertTemplate = itemContent;
-        replaceVars(concertTemplate, concert, true);
-        QFile file(m_dir.path() + QString("/concerts/%1.html").arg(concert->concertId()));
-        if (file.open(QFile::WriteOnly | QFile::Text)) {
-            file.write(concertTemplate.toUtf8());
-            file.close();
-        }
+    const QStringList concertList = renderInParallel<ItemData>(concertData, [&](const ItemData& concert) {
+        TemplateData data = concert.data;
+        data.images = imageResolver(concert.images, true);
+        writeFile(QString("concerts/%1.html").arg(concert.id), itemContent.render(data));
 
-        QString c = listConcertItem;
-        replaceVars(c, concert);
-        concertList << c;
+        data.images = imageResolver(concert.images, false);
+        const QString listItem = listConcertItem.render(data);
         emit sigItemExported();
-        QApplication::processEvents();
-    }
+        return listItem;
+    });
 
-    listContent.replace(listConcertBlock, concertList.join("\n"));
-
-    QFile file(m_dir.path() + "/concerts.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
+    if (m_cancelFlag.load()) {
+        return;
     }
+
+    TemplateData listData;
+    listData.renderedBlocks.insert("CONCERT", concertList.join("\n"));
+    writeFile("concerts.html", listContent.render(listData));
 }
 
-void SimpleEngine::replaceVars(QString& m, const Concert* concert, bool subDir)
+TemplateData SimpleEngine::templateData(const Concert* concert) const
 {
-    m.replace("{{ CONCERT.ID }}", QString::number(concert->concertId(), 'f', 0));
-    m.replace("{{ CONCERT.LINK }}", QString("concerts/%1.html").arg(concert->concertId()));
-    m.replace("{{ CONCERT.TITLE }}", concert->title().toHtmlEscaped());
-    m.replace("{{ CONCERT.ARTIST }}", concert->artist().toHtmlEscaped());
-    m.replace("{{ CONCERT.ALBUM }}", concert->album().toHtmlEscaped());
-    m.replace("{{ CONCERT.TAGLINE }}", concert->tagline().toHtmlEscaped());
+    TemplateData data;
+    QHash<QString, QString>& m = data.variables;
+    m.insert("CONCERT.ID", QString::number(concert->concertId(), 'f', 0));
+    m.insert("CONCERT.LINK", QString("concerts/%1.html").arg(concert->concertId()));
+    m.insert("CONCERT.TITLE", concert->title().toHtmlEscaped());
+    m.insert("CONCERT.ARTIST", concert->artist().toHtmlEscaped());
+    m.insert("CONCERT.ALBUM", concert->album().toHtmlEscaped());
+    m.insert("CONCERT.TAGLINE", concert->tagline().toHtmlEscaped());
 
     if (concert->ratings().isEmpty()) {
-        m.replace("{{ CONCERT.RATING }}", "n/a");
+        m.insert("CONCERT.RATING", "n/a");
     } else {
-        m.replace("{{ CONCERT.RATING }}", QString::number(concert->ratings().first().rating, 'f', 1));
+        m.insert("CONCERT.RATING", QString::number(concert->ratings().first().rating, 'f', 1));
     }
 
-    m.replace("{{ CONCERT.YEAR }}", concert->released().isValid() ? concert->released().toString("yyyy") : "");
-    m.replace("{{ CONCERT.RUNTIME }}", QString::number(static_cast<double>(concert->runtime().count()), 'f', 0));
-    m.replace("{{ CONCERT.CERTIFICATION }}", concert->certification().toString().toHtmlEscaped());
-    m.replace("{{ CONCERT.TRAILER }}", concert->trailer().toString());
-    m.replace("{{ CONCERT.PLAY_COUNT }}", QString::number(concert->playcount(), 'f', 0));
-    m.replace("{{ CONCERT.LAST_PLAYED }}",
+    m.insert("CONCERT.YEAR", concert->released().isValid() ? concert->released().toString("yyyy") : "");
+    m.insert("CONCERT.RUNTIME", QString::number(static_cast<double>(concert->runtime().count()), 'f', 0));
+    m.insert("CONCERT.CERTIFICATION", concert->certification().toString().toHtmlEscaped());
+    m.insert("CONCERT.TRAILER", concert->trailer().toString());
+    m.insert("CONCERT.PLAY_COUNT", QString::number(concert->playcount(), 'f', 0));
+    m.insert("CONCERT.LAST_PLAYED",
         concert->lastPlayed().isValid() ? concert->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
 
-    m.replace("{{ CONCERT.FILENAME }}", (!concert->files().isEmpty()) ? concert->files().first().toString() : "");
+    m.insert("CONCERT.FILENAME", (!concert->files().isEmpty()) ? concert->files().first().toString() : "");
     if (!concert->files().isEmpty()) {
         QFileInfo fi(concert->files().first().toString());
-        m.replace("{{ CONCERT.DIR }}", fi.absolutePath());
+        m.insert("CONCERT.DIR", fi.absolutePath());
     } else {
-        m.replace("{{ CONCERT.DIR }}", "");
+        m.insert("CONCERT.DIR", "");
     }
 
-    m.replace("{{ CONCERT.PLOT }}", concert->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ CONCERT.TAGS }}", concert->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ CONCERT.GENRES }}", concert->genres().join(", ").toHtmlEscaped());
+    m.insert("CONCERT.PLOT", concert->overview().toHtmlEscaped().replace("\n", "<br />"));
+    m.insert("CONCERT.TAGS", concert->tags().join(", ").toHtmlEscaped());
+    m.insert("CONCERT.GENRES", concert->genres().join(", ").toHtmlEscaped());
 
-    replaceStreamDetailsVars(m, concert->streamDetails());
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", concert->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", concert->genres());
-    replaceImages(m, subDir, nullptr, concert, nullptr, nullptr);
+    addStreamDetails(data, concert->streamDetails());
+    data.blocks.insert("TAGS", singleBlock("TAG.NAME", concert->tags()));
+    data.blocks.insert("GENRES", singleBlock("GENRE.NAME", concert->genres()));
+    return data;
 }
 
 void SimpleEngine::exportTvShows(QVector<TvShow*> shows)
 {
     std::sort(shows.begin(), shows.end(), TvShow::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::TvShows);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::TvShow);
-    QString episodeContent = m_template->getTemplate(ExportTemplate::ExportSection::Episode);
-
-    QString listTvShowItem;
-    QString listTvShowBlock;
-    QStringList tvShowList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_TVSHOW \}\}(.*)\{\{ END_BLOCK_TVSHOW \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listTvShowBlock = match.captured(0);
-        listTvShowItem = match.captured(1).trimmed();
-    }
+    const CompiledTemplate listContent(m_template->getTemplate(ExportTemplate::ExportSection::TvShows));
+    const CompiledTemplate itemContent(m_template->getTemplate(ExportTemplate::ExportSection::TvShow));
+    const CompiledTemplate episodeContent(m_template->getTemplate(ExportTemplate::ExportSection::Episode));
+    const CompiledTemplate listTvShowItem = listContent.block("TVSHOW");
 
     m_dir.mkdir("tvshows");
     m_dir.mkdir("tvshow_images");
     m_dir.mkdir("episodes");
     m_dir.mkdir("episode_images");
 
-    for (TvShow* show : shows) {
-        if (m_cancelFlag.load()) {
-            return;
+    // Seasons and their episodes are only collected if they are used.
+    const bool itemHasSeasons = itemContent.containsBlock("SEASON");
+    const bool listItemHasSeasons = listTvShowItem.containsBlock("SEASON");
+
+    // TV shows may be changed or deleted while rendering, so only copies of their data are used.
+    QVector<TvShowData> tvShowData;
+    tvShowData.reserve(shows.size());
+    for (const TvShow* show : asConst(shows)) {
+        const ItemImages showImages = itemImages(show);
+        QHash<const TvShowEpisode*, ItemImages> episodeImages;
+        for (const TvShowEpisode* episode : show->episodes()) {
+            episodeImages.insert(episode, itemImages(episode));
         }
 
-        // tvshow.html - Single TV show
-        {
-            QString showTemplate = itemContent;
-            replaceVars(showTemplate, show, true);
-            QFile file(m_dir.path() + QString("/tvshows/%1.html").arg(show->showId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(showTemplate.toUtf8());
-                file.close();
+        TvShowData data;
+        data.id = show->showId();
+        data.item = templateData(show, showImages, true);
+        if (itemHasSeasons) {
+            addSeasons(data.item, show, episodeImages, true);
+        }
+        data.listItem = templateData(show, showImages, false);
+        if (listItemHasSeasons) {
+            addSeasons(data.listItem, show, episodeImages, false);
+        }
+        for (const TvShowEpisode* episode : show->episodes()) {
+            if (!episode->isDummy()) {
+                data.episodes.push_back(
+                    {episode->episodeId(), templateData(episode, episodeImages.value(episode), true)});
             }
-            QApplication::processEvents();
         }
+        tvShowData.push_back(data);
+    }
+
+    const QStringList tvShowList = renderInParallel<TvShowData>(tvShowData, [&](const TvShowData& show) {
+        // tvshow.html - Single TV show
+        writeFile(QString("tvshows/%1.html").arg(show.id), itemContent.render(show.item));
 
         // tvshows.html - All TV shows listed
-        {
-            QString showBlock = listTvShowItem;
-            replaceVars(showBlock, show, false);
-            tvShowList << showBlock;
-            emit sigItemExported();
-            QApplication::processEvents();
-        }
+        const QString showBlock = listTvShowItem.render(show.listItem);
+        emit sigItemExported();
 
         // episode.html - Single episode
-        for (TvShowEpisode* episode : show->episodes()) {
-            if (episode->isDummy()) {
-                continue;
-            }
-            QString episodeTemplate = episodeContent;
-            replaceVars(episodeTemplate, episode, true);
-            QFile file(m_dir.path() + QString("/episodes/%1.html").arg(episode->episodeId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(episodeTemplate.toUtf8());
-                file.close();
+        for (const auto& episode : show.episodes) {
+            if (m_cancelFlag.load()) {
+                break;
             }
+            writeFile(QString("episodes/%1.html").arg(episode.first), episodeContent.render(episode.second));
             emit sigItemExported();
-            QApplication::processEvents();
         }
-    }
-
-    listContent.replace(listTvShowBlock, tvShowList.join("\n"));
+        return showBlock;
+    });
 
-    QFile file(m_dir.path() + "/tvshows.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
+    if (m_cancelFlag.load()) {
+        return;
     }
+
+    TemplateData listData;
+    listData.renderedBlocks.insert("TVSHOW", tvShowList.join("\n"));
+    writeFile("tvshows.html", listContent.render(listData));
 }
 
-void SimpleEngine::replaceVars(QString& m, const TvShow* show, bool subDir)
+TemplateData SimpleEngine::templateData(const TvShow* show, const ItemImages& images, bool subDir) const
 {
-    m.replace("{{ TVSHOW.ID }}", QString::number(show->showId(), 'f', 0));
-    m.replace("{{ TVSHOW.LINK }}", QString("tvshows/%1.html").arg(show->showId()));
-    m.replace("{{ TVSHOW.IMDB_ID }}", show->imdbId().toString());
-    m.replace("{{ TVSHOW.TITLE }}", show->title().toHtmlEscaped());
-    m.replace("{{ TVSHOW.SORTTITLE }}", show->sortTitle().toHtmlEscaped());
-    m.replace("{{ TVSHOW.ORIGINALTITLE }}", show->originalTitle().toHtmlEscaped());
+    TemplateData data;
+    QHash<QString, QString>& m = data.variables;
+    m.insert("TVSHOW.ID", QString::number(show->showId(), 'f', 0));
+    m.insert("TVSHOW.LINK", QString("tvshows/%1.html").arg(show->showId()));
+    m.insert("TVSHOW.IMDB_ID", show->imdbId().toString());
+    m.insert("TVSHOW.TITLE", show->title().toHtmlEscaped());
+    m.insert("TVSHOW.SORTTITLE", show->sortTitle().toHtmlEscaped());
+    m.insert("TVSHOW.ORIGINALTITLE", show->originalTitle().toHtmlEscaped());
 
     // \todo multiple ratings
     if (!show->ratings().isEmpty()) {
         double rating = show->ratings().first().rating;
         int voteCount = show->ratings().first().voteCount;
-        m.replace("{{ TVSHOW.RATING }}", QString::number(rating, 'f', 1));
-        m.replace("{{ TVSHOW.VOTES }}", QString::number(voteCount, 'f', 0));
+        m.insert("TVSHOW.RATING", QString::number(rating, 'f', 1));
+        m.insert("TVSHOW.VOTES", QString::number(voteCount, 'f', 0));
     } else {
-        m.replace("{{ TVSHOW.RATING }}", "n/a");
-        m.replace("{{ TVSHOW.VOTES }}", "n/a");
+        m.insert("TVSHOW.RATING", "n/a");
+        m.insert("TVSHOW.VOTES", "n/a");
     }
 
-    m.replace("{{ TVSHOW.CERTIFICATION }}", show->certification().toString().toHtmlEscaped());
-    m.replace(
-        "{{ TVSHOW.FIRST_AIRED }}", show->firstAired().isValid() ? show->firstAired().toString("yyyy-MM-dd") : "");
-    m.replace("{{ TVSHOW.STUDIO }}", show->network().toHtmlEscaped());
-    m.replace("{{ TVSHOW.PLOT }}", show->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ TVSHOW.TAGS }}", show->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ TVSHOW.GENRES }}", show->genres().join(", ").toHtmlEscaped());
-    m.replace("{{ TVSHOW.SEASONS_AMOUNT }}", QString::number(show->seasons(false).size()));
+    m.insert("TVSHOW.CERTIFICATION", show->certification().toString().toHtmlEscaped());
+    m.insert("TVSHOW.FIRST_AIRED", show->firstAired().isValid() ? show->firstAired().toString("yyyy-MM-dd") : "");
+    m.insert("TVSHOW.STUDIO", show->network().toHtmlEscaped());
+    m.insert("TVSHOW.PLOT", show->overview().toHtmlEscaped().replace("\n", "<br />"));
+    m.insert("TVSHOW.TAGS", show->tags().join(", ").toHtmlEscaped());
+    m.insert("TVSHOW.GENRES", show->genres().join(", ").toHtmlEscaped());
+    m.insert("TVSHOW.SEASONS_AMOUNT", QString::number(show->seasons(false).size()));
 
     QStringList actorNames;
     QStringList actorRoles;
@@ -368,113 +403,90 @@ void SimpleEngine::replaceVars(QString& m, const TvShow* show, bool subDir)
         actorNames << actor->name;
         actorRoles << actor->role;
     }
-    replaceMultiBlock(m, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, {actorNames, actorRoles});
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", show->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", show->genres());
-
-    QString listSeasonItem;
-    QString listSeasonBlock;
-    QStringList seasonList;
-
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_SEASON \}\}(.*)\{\{ END_BLOCK_SEASON \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    {
-        QRegularExpressionMatchIterator matches = rx.globalMatch(m);
-        while (matches.hasNext()) {
-            QRegularExpressionMatch match = matches.next();
-            listSeasonBlock = match.captured(0);
-            listSeasonItem = match.captured(1).trimmed();
-        }
-    }
-
-    if (listSeasonBlock.isEmpty() || listSeasonItem.isEmpty()) {
-        replaceImages(m, subDir, nullptr, nullptr, show, nullptr);
-        return;
-    }
+    data.blocks.insert("ACTORS", multiBlock({"ACTOR.NAME", "ACTOR.ROLE"}, {actorNames, actorRoles}));
+    data.blocks.insert("TAGS", singleBlock("TAG.NAME", show->tags()));
+    data.blocks.insert("GENRES", singleBlock("GENRE.NAME", show->genres()));
+    data.images = imageResolver(images, subDir);
+    return data;
+}
 
+void SimpleEngine::addSeasons(TemplateData& data,
+    const TvShow* show,
+    const QHash<const TvShowEpisode*, ItemImages>& episodeImages,
+    bool subDir) const
+{
+    TemplateData::Block seasonBlock;
+    seasonBlock.separator = "\n";
     QVector<SeasonNumber> seasons = show->seasons(false);
     std::sort(seasons.begin(), seasons.end());
     for (const SeasonNumber& season : asConst(seasons)) {
         QVector<TvShowEpisode*> episodes = show->episodes(season);
         std::sort(episodes.begin(), episodes.end(), TvShowEpisode::lessThan);
-        QString s = listSeasonItem;
-        s.replace("{{ SEASON }}", season.toString());
-
-        QString listEpisodeItem;
-        QString listEpisodeBlock;
-        QStringList episodeList;
-
-        rx.setPattern(R"(\{\{ BEGIN_BLOCK_EPISODE \}\}(.*)\{\{ END_BLOCK_EPISODE \}\})");
-        QRegularExpressionMatchIterator matches = rx.globalMatch(s);
-        while (matches.hasNext()) {
-            QRegularExpressionMatch match = matches.next();
-            listEpisodeBlock = match.captured(0);
-            listEpisodeItem = match.captured(1).trimmed();
-        }
 
-        if (!listEpisodeItem.isEmpty()) {
-            for (TvShowEpisode* episode : asConst(episodes)) {
-                QString e = listEpisodeItem;
-                replaceVars(e, episode, subDir);
-                episodeList << e;
-            }
+        TemplateData seasonData;
+        seasonData.variables.insert("SEASON", season.toString());
+        TemplateData::Block episodeBlock;
+        episodeBlock.separator = "\n";
+        for (const TvShowEpisode* episode : asConst(episodes)) {
+            episodeBlock.items.push_back(templateData(episode, episodeImages.value(episode), subDir));
         }
-        s.replace(listEpisodeBlock, episodeList.join("\n"));
-        seasonList << s;
+        seasonData.blocks.insert("EPISODE", episodeBlock);
+        seasonBlock.items.push_back(seasonData);
     }
-
-    m.replace(listSeasonBlock, seasonList.join("\n"));
-    replaceImages(m, subDir, nullptr, nullptr, show, nullptr);
+    data.blocks.insert("SEASON", seasonBlock);
 }
 
-void SimpleEngine::replaceVars(QString& m, const TvShowEpisode* episode, bool subDir)
+TemplateData SimpleEngine::templateData(const TvShowEpisode* episode, const ItemImages& images, bool subDir) const
 {
-    m.replace("{{ SHOW.TITLE }}", episode->tvShow()->title().toHtmlEscaped());
-    m.replace("{{ SHOW.LINK }}", QString("../tvshows/%1.html").arg(episode->tvShow()->showId()));
-    m.replace("{{ EPISODE.LINK }}", QString("../episodes/%1.html").arg(episode->episodeId()));
-    m.replace("{{ EPISODE.TITLE }}", episode->title().toHtmlEscaped());
-    m.replace("{{ EPISODE.SEASON }}", episode->seasonString().toHtmlEscaped());
-    m.replace("{{ EPISODE.EPISODE }}", episode->episodeString().toHtmlEscaped());
+    TemplateData data;
+    QHash<QString, QString>& m = data.variables;
+    m.insert("SHOW.TITLE", episode->tvShow()->title().toHtmlEscaped());
+    m.insert("SHOW.LINK", QString("../tvshows/%1.html").arg(episode->tvShow()->showId()));
+    m.insert("EPISODE.LINK", QString("../episodes/%1.html").arg(episode->episodeId()));
+    m.insert("EPISODE.TITLE", episode->title().toHtmlEscaped());
+    m.insert("EPISODE.SEASON", episode->seasonString().toHtmlEscaped());
+    m.insert("EPISODE.EPISODE", episode->episodeString().toHtmlEscaped());
     if (episode->ratings().isEmpty()) {
-        m.replace("{{ EPISODE.RATING }}", "n/a");
+        m.insert("EPISODE.RATING", "n/a");
     } else {
-        m.replace("{{ EPISODE.RATING }}", QString::number(episode->ratings().first().rating, 'f', 1));
+        m.insert("EPISODE.RATING", QString::number(episode->ratings().first().rating, 'f', 1));
     }
-    m.replace("{{ EPISODE.CERTIFICATION }}", episode->certification().toString().toHtmlEscaped());
-    m.replace("{{ EPISODE.FIRST_AIRED }}",
-        episode->firstAired().isValid() ? episode->firstAired().toString("yyyy-MM-dd") : "");
-    m.replace("{{ EPISODE.LAST_PLAYED }}",
+    m.insert("EPISODE.CERTIFICATION", episode->certification().toString().toHtmlEscaped());
+    m.insert(
+        "EPISODE.FIRST_AIRED", episode->firstAired().isValid() ? episode->firstAired().toString("yyyy-MM-dd") : "");
+    m.insert("EPISODE.LAST_PLAYED",
         episode->lastPlayed().isValid() ? episode->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ EPISODE.STUDIO }}", episode->network().toHtmlEscaped());
-    m.replace("{{ EPISODE.PLOT }}", episode->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ EPISODE.WRITERS }}", episode->writers().join(", ").toHtmlEscaped());
-    m.replace("{{ EPISODE.DIRECTORS }}", episode->directors().join(", ").toHtmlEscaped());
+    m.insert("EPISODE.STUDIO", episode->network().toHtmlEscaped());
+    m.insert("EPISODE.PLOT", episode->overview().toHtmlEscaped().replace("\n", "<br />"));
+    m.insert("EPISODE.WRITERS", episode->writers().join(", ").toHtmlEscaped());
+    m.insert("EPISODE.DIRECTORS", episode->directors().join(", ").toHtmlEscaped());
 
     if (!episode->files().isEmpty()) {
         QFileInfo fi(episode->files().first().toString());
-        m.replace("{{ EPISODE.DIR }}", fi.absolutePath());
+        m.insert("EPISODE.DIR", fi.absolutePath());
     } else {
-        m.replace("{{ EPISODE.DIR }}", "");
+        m.insert("EPISODE.DIR", "");
     }
-    m.replace("{{ EPISODE.FILENAME }}", (!episode->files().isEmpty()) ? episode->files().first().toString() : "");
+    m.insert("EPISODE.FILENAME", (!episode->files().isEmpty()) ? episode->files().first().toString() : "");
 
-    replaceStreamDetailsVars(m, episode->streamDetails());
-    replaceSingleBlock(m, "WRITERS", "WRITER.NAME", episode->writers());
-    replaceSingleBlock(m, "DIRECTORS", "DIRECTOR.NAME", episode->directors());
-    replaceImages(m, subDir, nullptr, nullptr, nullptr, episode);
+    addStreamDetails(data, episode->streamDetails());
+    data.blocks.insert("WRITERS", singleBlock("WRITER.NAME", episode->writers()));
+    data.blocks.insert("DIRECTORS", singleBlock("DIRECTOR.NAME", episode->directors()));
+    data.images = imageResolver(images, subDir);
+    return data;
 }
 
-void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* details)
+void SimpleEngine::addStreamDetails(TemplateData& data, const StreamDetails* details)
 {
     const auto videoDetails = (details != nullptr) ? details->videoDetails() : decltype(details->videoDetails()){};
     const auto audioDetails = (details != nullptr) ? details->audioDetails() : decltype(details->audioDetails()){};
 
-    m.replace("{{ FILEINFO.WIDTH }}", videoDetails.value(StreamDetails::VideoDetails::Width, "0"));
-    m.replace("{{ FILEINFO.HEIGHT }}", videoDetails.value(StreamDetails::VideoDetails::Height, "0"));
-    m.replace("{{ FILEINFO.ASPECT }}", videoDetails.value(StreamDetails::VideoDetails::Aspect, "0"));
-    m.replace("{{ FILEINFO.CODEC }}", videoDetails.value(StreamDetails::VideoDetails::Codec, ""));
-    m.replace("{{ FILEINFO.DURATION }}", videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds, "0"));
+    QHash<QString, QString>& m = data.variables;
+    m.insert("FILEINFO.WIDTH", videoDetails.value(StreamDetails::VideoDetails::Width, "0"));
+    m.insert("FILEINFO.HEIGHT", videoDetails.value(StreamDetails::VideoDetails::Height, "0"));
+    m.insert("FILEINFO.ASPECT", videoDetails.value(StreamDetails::VideoDetails::Aspect, "0"));
+    m.insert("FILEINFO.CODEC", videoDetails.value(StreamDetails::VideoDetails::Codec, ""));
+    m.insert("FILEINFO.DURATION", videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds, "0"));
 
     QStringList audioCodecs;
     QStringList audioChannels;
@@ -484,9 +496,9 @@ void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* det
         audioChannels << audioDetails.at(i).value(StreamDetails::AudioDetails::Channels);
         audioLanguages << audioDetails.at(i).value(StreamDetails::AudioDetails::Language);
     }
-    m.replace("{{ FILEINFO.AUDIO.CODEC }}", audioCodecs.join("|"));
-    m.replace("{{ FILEINFO.AUDIO.CHANNELS }}", audioChannels.join("|"));
-    m.replace("{{ FILEINFO.AUDIO.LANGUAGE }}", audioLanguages.join("|"));
+    m.insert("FILEINFO.AUDIO.CODEC", audioCodecs.join("|"));
+    m.insert("FILEINFO.AUDIO.CHANNELS", audioChannels.join("|"));
+    m.insert("FILEINFO.AUDIO.LANGUAGE", audioLanguages.join("|"));
 
     QStringList subtitleLanguages;
     if (details != nullptr) {
@@ -494,284 +506,83 @@ void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* det
             subtitleLanguages << subtitle.value(StreamDetails::SubtitleDetails::Language);
         }
     }
-    m.replace("{{ FILEINFO.SUBTITLES.LANGUAGE }}", subtitleLanguages.join("|"));
+    m.insert("FILEINFO.SUBTITLES.LANGUAGE", subtitleLanguages.join("|"));
 }
 
-void SimpleEngine::replaceSingleBlock(QString& m, QString blockName, QString itemName, QStringList replaces)
+TemplateData::Block SimpleEngine::singleBlock(const QString& itemName, const QStringList& values)
 {
-    replaceMultiBlock(m, blockName, QStringList() << itemName, QVector<QStringList>() << replaces);
+    return multiBlock({itemName}, {values});
 }
 
-void SimpleEngine::replaceMultiBlock(QString& m,
-    QString blockName,
-    QStringList itemNames,
-    QVector<QStringList> replaces)
+TemplateData::Block SimpleEngine::multiBlock(const QStringList& itemNames, const QVector<QStringList>& values)
 {
-    QRegularExpression rx("\\{\\{ BEGIN_BLOCK_" + blockName + R"( \}\}(.*)\{\{ END_BLOCK_)" + blockName + " \\}\\}", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-    QRegularExpressionMatch match = rx.match(m);
-    if (match.hasMatch()) {
-        QString block = match.captured(0);
-        QString item = match.captured(1).trimmed();
-        QStringList list;
-        for (int i = 0, n = replaces.at(0).count(); i < n; ++i) {
-            QString subItem = item;
-            for (int x = 0, y = itemNames.count(); x < y; ++x) {
-                subItem.replace("{{ " + itemNames.at(x) + " }}", replaces.at(x).at(i).toHtmlEscaped());
-            }
-            list << subItem;
+    TemplateData::Block block;
+    for (int i = 0, n = values.at(0).count(); i < n; ++i) {
+        TemplateData item;
+        for (int x = 0, y = itemNames.count(); x < y; ++x) {
+            item.variables.insert(itemNames.at(x), values.at(x).at(i).toHtmlEscaped());
         }
-        m.replace(block, list.join(" "));
+        block.items.push_back(item);
     }
+    return block;
 }
 
-void SimpleEngine::saveImage(QSize size, QString imageFile, QString destinationFile, const char* format, int quality)
+void SimpleEngine::saveImage(QSize size, QString imageFile, QString destinationFile, int quality) const
 {
-    Q_UNUSED(format)
-    Q_UNUSED(quality)
-
-    QImage img(imageFile);
-    if (img.isNull()) {
-        qCWarning(generic) << "[Export][SimpleEngine] Cannot load image:" << imageFile;
-        return;
-    }
-
-    img = img.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-
-    if (!img.isNull()) {
-        img.save(destinationFile);
-    } else {
-        qCWarning(generic) << "[Export][SimpleEngine] Could not scale (result was empty):" << imageFile;
-    }
-}
-
-void SimpleEngine::replaceImages(QString& m,
-    const bool& subDir,
-    const Movie* movie,
-    const Concert* concert,
-    const TvShow* tvShow,
-    const TvShowEpisode* episode)
-{
-    QString item;
-    QSize size;
-    QRegularExpression rx(R"(\{\{ IMAGE.(.*)\[(\d*), ?(\d*)\] \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-    QRegularExpressionMatchIterator matches = rx.globalMatch(m);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        item = match.captured(0);
-        QString type = match.captured(1).toLower();
-        size.setWidth(match.captured(2).toInt());
-        size.setHeight(match.captured(3).toInt());
-
-        if (item.isEmpty() || size.isEmpty()) {
-            continue;
-        }
-
-        QString destFile;
-        bool imageSaved = false;
-        bool isPlaceholderUsed = true;
-        QString typeName;
-        if (movie != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, movie, &isPlaceholderUsed);
-            typeName = "movie";
-
-        } else if (concert != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, concert, &isPlaceholderUsed);
-            typeName = "concert";
-
-        } else if (tvShow != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, tvShow, &isPlaceholderUsed);
-            typeName = "tvshow";
-
-        } else if (episode != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, episode, &isPlaceholderUsed);
-            typeName = "episode";
-        }
-
-        if (!isPlaceholderUsed) {
-            continue;
-        }
-
-        if (imageSaved) {
-            m.replace(item, (subDir ? "../" : "") + destFile);
-        } else {
-            m.replace(item,
-                (subDir ? "../" : "")
-                    + QString("defaults/%1_%2_%3x%4.png").arg(typeName).arg(type).arg(size.width()).arg(size.height()));
-        }
-    }
+    m_imageCache.exportImage(imageFile, size, destinationFile, quality);
 }
 
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const Movie* movie,
-    bool* isPlaceHolderUsed)
+SimpleEngine::ItemImages SimpleEngine::itemImages(const Movie* movie)
 {
-    std::string imageFormat = "png";
-    ImageType imageType;
-
-    if (type == "poster") {
-        imageType = ImageType::MoviePoster;
-        imageFormat = "jpg";
-    } else if (type == "fanart") {
-        imageType = ImageType::MovieBackdrop;
-        imageFormat = "jpg";
-    } else if (type == "logo") {
-        imageType = ImageType::MovieLogo;
-    } else if (type == "clearart") {
-        imageType = ImageType::MovieClearArt;
-    } else if (type == "disc") {
-        imageType = ImageType::MovieCdArt;
-    } else {
-        *isPlaceHolderUsed = false;
-        return false;
-    }
-
-    *isPlaceHolderUsed = true;
-
-    QString file_ending = QString::fromStdString(imageFormat);
-    destFile = "movie_images/"
-               + QString("%1-%2_%3x%4.%5")
-                     .arg(movie->movieId())
-                     .arg(type)
-                     .arg(size.width())
-                     .arg(size.height())
-                     .arg(file_ending);
-
-    QString filename = Manager::instance()->mediaCenterInterface()->imageFileName(movie, imageType);
-    if (filename.isEmpty()) {
-        return false;
-    }
-
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
-
-    return true;
+    auto* mediaCenter = Manager::instance()->mediaCenterInterface();
+    ItemImages images;
+    images.typeName = "movie";
+    images.destPrefix = QString("movie_images/%1").arg(movie->movieId());
+    images.images.insert("poster", {mediaCenter->imageFileName(movie, ImageType::MoviePoster), "jpg"});
+    images.images.insert("fanart", {mediaCenter->imageFileName(movie, ImageType::MovieBackdrop), "jpg"});
+    images.images.insert("logo", {mediaCenter->imageFileName(movie, ImageType::MovieLogo), "png"});
+    images.images.insert("clearart", {mediaCenter->imageFileName(movie, ImageType::MovieClearArt), "png"});
+    images.images.insert("disc", {mediaCenter->imageFileName(movie, ImageType::MovieCdArt), "png"});
+    return images;
 }
 
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const Concert* concert,
-    bool* isPlaceHolderUsed)
+SimpleEngine::ItemImages SimpleEngine::itemImages(const Concert* concert)
 {
-    std::string imageFormat = "png";
-    ImageType imageType;
-
-    if (type == "poster") {
-        imageType = ImageType::ConcertPoster;
-        imageFormat = "jpg";
-    } else if (type == "fanart") {
-        imageType = ImageType::ConcertBackdrop;
-        imageFormat = "jpg";
-    } else if (type == "logo") {
-        imageType = ImageType::ConcertLogo;
-    } else if (type == "clearart") {
-        imageType = ImageType::ConcertClearArt;
-    } else if (type == "disc") {
-        imageType = ImageType::ConcertCdArt;
-    } else {
-        *isPlaceHolderUsed = false;
-        return false;
-    }
-
-    *isPlaceHolderUsed = true;
-
-    QString file_ending = QString::fromStdString(imageFormat);
-    destFile = "movie_images/"
-               + QString("%1-%2_%3x%4.%5")
-                     .arg(concert->concertId())
-                     .arg(type)
-                     .arg(size.width())
-                     .arg(size.height())
-                     .arg(file_ending);
-
-    QString filename = Manager::instance()->mediaCenterInterface()->imageFileName(concert, imageType);
-    if (filename.isEmpty()) {
-        return false;
-    }
-
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
-
-    return true;
+    auto* mediaCenter = Manager::instance()->mediaCenterInterface();
+    ItemImages images;
+    images.typeName = "concert";
+    images.destPrefix = QString("movie_images/%1").arg(concert->concertId());
+    images.images.insert("poster", {mediaCenter->imageFileName(concert, ImageType::ConcertPoster), "jpg"});
+    images.images.insert("fanart", {mediaCenter->imageFileName(concert, ImageType::ConcertBackdrop), "jpg"});
+    images.images.insert("logo", {mediaCenter->imageFileName(concert, ImageType::ConcertLogo), "png"});
+    images.images.insert("clearart", {mediaCenter->imageFileName(concert, ImageType::ConcertClearArt), "png"});
+    images.images.insert("disc", {mediaCenter->imageFileName(concert, ImageType::ConcertCdArt), "png"});
+    return images;
 }
 
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const TvShow* tvShow,
-    bool* isPlaceHolderUsed)
+SimpleEngine::ItemImages SimpleEngine::itemImages(const TvShow* tvShow)
 {
-    std::string imageFormat = "png";
-    ImageType imageType;
-
-    if (type == "poster") {
-        imageType = ImageType::TvShowPoster;
-        imageFormat = "jpg";
-    } else if (type == "fanart") {
-        imageType = ImageType::TvShowBackdrop;
-        imageFormat = "jpg";
-    } else if (type == "banner") {
-        imageType = ImageType::TvShowBanner;
-        imageFormat = "jpg";
-    } else if (type == "logo") {
-        imageType = ImageType::TvShowLogos;
-    } else if (type == "clearart") {
-        imageType = ImageType::TvShowClearArt;
-    } else if (type == "characterart") {
-        imageType = ImageType::TvShowCharacterArt;
-    } else {
-        *isPlaceHolderUsed = false;
-        return false;
-    }
-    *isPlaceHolderUsed = true;
-
-    QString file_ending = QString::fromStdString(imageFormat);
-    destFile = "tvshow_images/"
-               + QString("%1-%2_%3x%4.%5")
-                     .arg(tvShow->showId())
-                     .arg(type)
-                     .arg(size.width())
-                     .arg(size.height())
-                     .arg(file_ending);
-
-    QString filename = Manager::instance()->mediaCenterInterface()->imageFileName(tvShow, imageType);
-    if (filename.isEmpty()) {
-        return false;
-    }
-
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
-
-    return true;
+    auto* mediaCenter = Manager::instance()->mediaCenterInterface();
+    ItemImages images;
+    images.typeName = "tvshow";
+    images.destPrefix = QString("tvshow_images/%1").arg(tvShow->showId());
+    images.images.insert("poster", {mediaCenter->imageFileName(tvShow, ImageType::TvShowPoster), "jpg"});
+    images.images.insert("fanart", {mediaCenter->imageFileName(tvShow, ImageType::TvShowBackdrop), "jpg"});
+    images.images.insert("banner", {mediaCenter->imageFileName(tvShow, ImageType::TvShowBanner), "jpg"});
+    images.images.insert("logo", {mediaCenter->imageFileName(tvShow, ImageType::TvShowLogos), "png"});
+    images.images.insert("clearart", {mediaCenter->imageFileName(tvShow, ImageType::TvShowClearArt), "png"});
+    images.images.insert("characterart", {mediaCenter->imageFileName(tvShow, ImageType::TvShowCharacterArt), "png"});
+    return images;
 }
 
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const TvShowEpisode* episode,
-    bool* isPlaceHolderUsed)
+SimpleEngine::ItemImages SimpleEngine::itemImages(const TvShowEpisode* episode)
 {
-    destFile = "episode_images/"
-               + QString("%1-%2_%3x%4.jpg").arg(episode->episodeId()).arg(type).arg(size.width()).arg(size.height());
-
-    if (type == "thumbnail") {
-        *isPlaceHolderUsed = true;
-        QString filename =
-            Manager::instance()->mediaCenterInterface()->imageFileName(episode, ImageType::TvShowEpisodeThumb);
-        if (filename.isEmpty()) {
-            return false;
-        }
-        saveImage(size, filename, m_dir.path() + "/" + destFile, "jpg", 90);
-    } else {
-        *isPlaceHolderUsed = false;
-        return false;
-    }
-
-    return true;
+    auto* mediaCenter = Manager::instance()->mediaCenterInterface();
+    ItemImages images;
+    images.typeName = "episode";
+    images.destPrefix = QString("episode_images/%1").arg(episode->episodeId());
+    images.images.insert("thumbnail", {mediaCenter->imageFileName(episode, ImageType::TvShowEpisodeThumb), "jpg"});
+    return images;
 }
 
 } // namespace mediaelch
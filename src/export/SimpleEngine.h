@@ -1,10 +1,15 @@
 #pragma once
 
+#include "export/CompiledTemplate.h"
+#include "export/ExportImageCache.h"
 #include "export/ExportTemplate.h"
 
 #include <QDir>
+#include <QHash>
 #include <QObject>
+#include <QPair>
 #include <atomic>
+#include <functional>
 
 class Concert;
 class Movie;
@@ -16,18 +21,23 @@ namespace mediaelch {
 
 /// Default export engine for MediaElch. Simple find&replace semantics,
 /// only basic functionality (e.g. condintional block)
+///
+/// Templates are compiled once (see CompiledTemplate) and items are rendered in parallel.
+/// The items' data is collected on the calling (GUI) thread before rendering.
 class SimpleEngine : public QObject
 {
     Q_OBJECT
 public:
+    /// \param imageCache Used to scale images. Must outlive the engine.
     explicit SimpleEngine(ExportTemplate& exportTemplate,
         QDir directory,
+        ExportImageCache& imageCache,
         std::atomic_bool& cancelFlag,
         QObject* parent = nullptr);
 
 signals:
     /// Signal is emitted each time an item is exported (e.g. image, generated HTML, etc.)
-    /// Useful for progress bars.
+    /// Useful for progress bars.  Emitted from worker threads, so use a queued connection.
     void sigItemExported();
 
 public:
@@ -36,42 +46,70 @@ public:
     void exportTvShows(QVector<TvShow*> shows);
 
 private:
-    void saveImage(QSize size, QString imageFile, QString destinationFile, const char* format, int quality);
-    void replaceImages(QString& m,
-        const bool& subDir,
-        const Movie* movie,
-        const Concert* concert,
-        const TvShow* tvShow,
-        const TvShowEpisode* episode);
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const Movie* movie,
-        bool* isPlaceHolderUsed);
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const Concert* concert,
-        bool* isPlaceHolderUsed);
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const TvShow* tvShow,
-        bool* isPlaceHolderUsed);
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const TvShowEpisode* episode,
-        bool* isPlaceHolderUsed);
-    void replaceVars(QString& m, Movie* movie, bool subDir = false);
-    void replaceVars(QString& m, const Concert* concert, bool subDir = false);
-    void replaceVars(QString& m, const TvShow* show, bool subDir = false);
-    void replaceVars(QString& m, const TvShowEpisode* episode, bool subDir = false);
-    void replaceSingleBlock(QString& m, QString blockName, QString itemName, QStringList replaces);
-    void replaceMultiBlock(QString& m, QString blockName, QStringList itemNames, QVector<QStringList> replaces);
-    void replaceStreamDetailsVars(QString& m, const StreamDetails* details);
+    /// \brief Image files of an item.  Resolved on the GUI thread so that worker threads
+    ///        only scale and write images and never access the item itself.
+    struct ItemImages
+    {
+        struct Image
+        {
+            /// \brief Empty if the item has no such image.
+            QString sourceFile;
+            /// \brief File extension of the exported image, e.g. "jpg".
+            QString format;
+        };
+        /// \brief Used for placeholder images, e.g. "movie" for "defaults/movie_poster_200x300.png".
+        QString typeName;
+        /// \brief Exported images are named "<destPrefix>-<type>_<width>x<height>.<format>".
+        QString destPrefix;
+        /// \brief Images by template image type, e.g. "poster".  Other types are not supported.
+        QHash<QString, Image> images;
+    };
+
+    /// \brief Template data of a movie or concert, collected on the GUI thread.
+    struct ItemData
+    {
+        int id = 0;
+        TemplateData data;
+        ItemImages images;
+    };
+
+    /// \brief Template data of a TV show and its episodes, collected on the GUI thread.
+    struct TvShowData
+    {
+        int id = 0;
+        TemplateData item;
+        TemplateData listItem;
+        QVector<QPair<int, TemplateData>> episodes;
+    };
+
+    /// \brief Renders all items on worker threads.  Returns the results in the items' order.
+    ///        Blocks until all items are rendered but keeps the event loop running.  Items
+    ///        must be plain values: Media items may be changed or deleted in the meantime.
+    template<class T>
+    QStringList renderInParallel(const QVector<T>& items, std::function<QString(const T&)> renderItem);
+    void writeFile(const QString& fileName, const QString& content) const;
+
+    /// \brief Saves the scaled image.  Its format is given by the extension of destinationFile.
+    void saveImage(QSize size, QString imageFile, QString destinationFile, int quality) const;
+    TemplateData::ImageResolver imageResolver(const ItemImages& images, bool subDir) const;
+    static ItemImages itemImages(const Movie* movie);
+    static ItemImages itemImages(const Concert* concert);
+    static ItemImages itemImages(const TvShow* tvShow);
+    static ItemImages itemImages(const TvShowEpisode* episode);
+    TemplateData templateData(Movie* movie) const;
+    TemplateData templateData(const Concert* concert) const;
+    TemplateData templateData(const TvShow* show, const ItemImages& images, bool subDir) const;
+    void addSeasons(TemplateData& data,
+        const TvShow* show,
+        const QHash<const TvShowEpisode*, ItemImages>& episodeImages,
+        bool subDir) const;
+    TemplateData templateData(const TvShowEpisode* episode, const ItemImages& images, bool subDir) const;
+    static void addStreamDetails(TemplateData& data, const StreamDetails* details);
+    static TemplateData::Block singleBlock(const QString& itemName, const QStringList& values);
+    static TemplateData::Block multiBlock(const QStringList& itemNames, const QVector<QStringList>& values);
 
 private:
+    ExportImageCache& m_imageCache;
     std::atomic_bool& m_cancelFlag;
     ExportTemplate* m_template = nullptr;
     QDir m_dir;
@@ -0,0 +1,165 @@
+#include "file/DirectoryManifest.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QVector>
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+#    include <sys/stat.h>
+#endif
+
+namespace {
+
+QString parentPath(const QString& path)
+{
+    const int index = path.lastIndexOf('/');
+    return index > 0 ? path.left(index) : QString{};
+}
+
+/// \brief Modification time, size and inode of a file or directory.
+bool statPath(const QString& path, bool isDir, mediaelch::DirectoryState& state)
+{
+#ifdef Q_OS_UNIX
+    struct stat info = {};
+    if (::stat(QFile::encodeName(path).constData(), &info) != 0 || (S_ISDIR(info.st_mode) != isDir)) {
+        return false;
+    }
+#    ifdef Q_OS_MACOS
+    const qint64 nanoSeconds = info.st_mtimespec.tv_nsec;
+#    else
+    const qint64 nanoSeconds = info.st_mtim.tv_nsec;
+#    endif
+    state.lastModified = static_cast<qint64>(info.st_mtime) * 1000000000LL + nanoSeconds;
+    state.size = static_cast<qint64>(info.st_size);
+    state.inode = static_cast<quint64>(info.st_ino);
+    return true;
+#else
+    const QFileInfo info(path);
+    if (!info.exists() || info.isDir() != isDir) {
+        return false;
+    }
+    state.lastModified = info.lastModified().toMSecsSinceEpoch();
+    state.size = info.size();
+    return true;
+#endif
+}
+
+} // namespace
+
+namespace mediaelch {
+
+bool isMetadataFile(const QString& fileName)
+{
+    static const QStringList suffixes{".nfo", ".jpg", ".jpeg", ".png", ".tbn"};
+    for (const QString& suffix : suffixes) {
+        if (fileName.endsWith(suffix, Qt::CaseInsensitive)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+DirectoryState directoryState(const QString& path, const QStringList& metadataFiles, bool* ok)
+{
+    DirectoryState state;
+    const bool exists = statPath(path, true, state);
+    if (exists) {
+        state.metadataFiles = metadataFiles;
+        for (const QString& fileName : metadataFiles) {
+            DirectoryState file;
+            // Removed files change the directory's state anyway.
+            if (statPath(path + '/' + fileName, false, file)) {
+                state.metadataModified = std::max(state.metadataModified, file.lastModified);
+                state.metadataSize += file.size;
+            }
+        }
+    }
+    if (ok != nullptr) {
+        *ok = exists;
+    }
+    return state;
+}
+
+DirectoryManifestDiff diffDirectoryTree(const QString& root,
+    const DirectoryManifest& previous,
+    const std::function<bool()>& isAborted)
+{
+    DirectoryManifestDiff diff;
+
+    // Subdirectories of each known directory; used for directories that are unchanged.
+    QHash<QString, QStringList> previousChildren;
+    for (auto it = previous.cbegin(); it != previous.cend(); ++it) {
+        previousChildren[parentPath(it.key())].append(it.key());
+    }
+
+    QSet<QString> visitedSymLinkTargets;
+    QStringList pending{QDir::fromNativeSeparators(QDir::cleanPath(root))};
+
+    while (!pending.isEmpty()) {
+        if (isAborted && isAborted()) {
+            return diff;
+        }
+
+        const QString dir = pending.takeLast();
+        if (diff.current.contains(dir)) {
+            continue;
+        }
+
+        // If the directory is unchanged, so is the list of its metadata files.
+        const auto previousState = previous.constFind(dir);
+        const QStringList previousFiles =
+            previousState != previous.cend() ? previousState.value().metadataFiles : QStringList{};
+
+        bool exists = false;
+        DirectoryState state = directoryState(dir, previousFiles, &exists);
+        if (!exists) {
+            continue;
+        }
+
+        if (previousState != previous.cend() && previousState.value() == state) {
+            diff.current.insert(dir, state);
+            pending.append(previousChildren.value(dir));
+            continue;
+        }
+
+        diff.changedDirs.append(dir);
+
+        QStringList metadataFiles;
+        QVector<QFileInfo> subDirs;
+        const QFileInfoList entries = QDir(dir).entryInfoList(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot);
+        for (const QFileInfo& entry : entries) {
+            if (entry.isDir()) {
+                subDirs.append(entry);
+            } else if (isMetadataFile(entry.fileName())) {
+                metadataFiles.append(entry.fileName());
+            }
+        }
+        state = directoryState(dir, metadataFiles);
+        diff.current.insert(dir, state);
+
+        for (const QFileInfo& subDir : subDirs) {
+            if (subDir.isSymLink()) {
+                // Avoid endless loops through symlinks that point to a parent directory.
+                const QString target = subDir.canonicalFilePath();
+                if (target.isEmpty() || visitedSymLinkTargets.contains(target)) {
+                    continue;
+                }
+                visitedSymLinkTargets.insert(target);
+            }
+            pending.append(dir + '/' + subDir.fileName());
+        }
+    }
+
+    for (auto it = previous.cbegin(); it != previous.cend(); ++it) {
+        if (!diff.current.contains(it.key())) {
+            diff.removedDirs.append(it.key());
+        }
+    }
+
+    return diff;
+}
+
+} // namespace mediaelch
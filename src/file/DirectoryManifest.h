@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Filesystem state of a single directory.
+/// \details A directory's modification time changes whenever an entry is
+///          added, removed or renamed inside of it. If the state of a
+///          directory is unchanged, its list of entries is unchanged as well.
+///
+///          Files that are edited in place (e.g. an NFO file changed by another
+///          tool) do not change the directory's modification time.  Therefore the
+///          NFO and image files of each directory are tracked as well, see
+///          isMetadataFile().
+struct DirectoryState
+{
+    /// \brief Modification time in nanoseconds (milliseconds on systems without stat()).
+    qint64 lastModified = 0;
+    qint64 size = 0;
+    /// \brief Inode number or 0 if not available.
+    quint64 inode = 0;
+    /// \brief Names of the NFO and image files in the directory.
+    QStringList metadataFiles;
+    /// \brief Latest modification time of all metadataFiles, same unit as lastModified.
+    qint64 metadataModified = 0;
+    /// \brief Sum of the sizes of all metadataFiles.
+    qint64 metadataSize = 0;
+
+    bool operator==(const DirectoryState& other) const
+    {
+        return lastModified == other.lastModified && size == other.size && inode == other.inode
+               && metadataFiles == other.metadataFiles && metadataModified == other.metadataModified
+               && metadataSize == other.metadataSize;
+    }
+    bool operator!=(const DirectoryState& other) const { return !(*this == other); }
+};
+
+/// \brief Map of absolute directory paths to their state.
+using DirectoryManifest = QHash<QString, DirectoryState>;
+
+/// \brief Result of comparing a directory tree with a previous manifest.
+struct DirectoryManifestDiff
+{
+    /// \brief Manifest of the current directory tree.
+    DirectoryManifest current;
+    /// \brief Directories that are new or whose entries have changed.
+    QStringList changedDirs;
+    /// \brief Directories of the previous manifest that do no longer exist.
+    QStringList removedDirs;
+
+    bool hasChanges() const { return !changedDirs.isEmpty() || !removedDirs.isEmpty(); }
+};
+
+/// \brief Whether the file is an NFO or image file that is tracked by DirectoryState.
+bool isMetadataFile(const QString& fileName);
+
+/// \brief Returns the state of the given directory. If the directory
+///        does not exist, \p ok is set to false.
+/// \details The given metadata files are stat()ed; the directory is not listed.
+DirectoryState directoryState(const QString& path, const QStringList& metadataFiles = {}, bool* ok = nullptr);
+
+/// \brief   Walks the directory tree at \p root and compares it to \p previous.
+/// \details Unchanged directories and their metadata files (see DirectoryState)
+///          are stat()ed, only new or changed directories are listed.
+///          Subdirectories of unchanged directories are taken from \p previous.
+///          The walk stops early if \p isAborted returns true.
+DirectoryManifestDiff diffDirectoryTree(const QString& root,
+    const DirectoryManifest& previous,
+    const std::function<bool()>& isAborted = {});
+
+} // namespace mediaelch
@@ -0,0 +1,237 @@
+#include "file/DirectoryWatcher.h"
+
+#include "globals/Meta.h"
+#include "log/Log.h"
+
+#include <QDir>
+#include <QFutureWatcher>
+#include <QStorageInfo>
+#include <QtConcurrent>
+
+namespace {
+
+constexpr int DEFAULT_DEBOUNCE_INTERVAL_MS = 2000;
+constexpr int DEFAULT_POLL_INTERVAL_MS = 60 * 1000;
+
+bool isSameOrSubDirectory(const QString& dir, const QString& root)
+{
+    return dir == root || dir.startsWith(root + '/');
+}
+
+} // namespace
+
+namespace mediaelch {
+
+DirectoryWatcher::DirectoryWatcher(QObject* parent) : QObject(parent)
+{
+    m_debounceTimer.setSingleShot(true);
+    m_debounceTimer.setInterval(DEFAULT_DEBOUNCE_INTERVAL_MS);
+    m_pollTimer.setInterval(DEFAULT_POLL_INTERVAL_MS);
+
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &DirectoryWatcher::onDirectoryChanged);
+    connect(&m_debounceTimer, &QTimer::timeout, this, &DirectoryWatcher::onDebounceTimeout);
+    connect(&m_pollTimer, &QTimer::timeout, this, &DirectoryWatcher::onPollTimeout);
+}
+
+void DirectoryWatcher::setRootDirectories(const QStringList& roots)
+{
+    QStringList newRoots;
+    for (const QString& root : roots) {
+        newRoots.append(QDir::fromNativeSeparators(QDir::cleanPath(root)));
+    }
+
+    for (const QString& root : m_roots.keys()) {
+        if (!newRoots.contains(root)) {
+            unwatchRoot(root);
+            m_roots.remove(root);
+            m_dirtyRoots.remove(root);
+        }
+    }
+
+    bool hasPolledRoots = false;
+    for (const QString& root : asConst(newRoots)) {
+        if (!m_roots.contains(root)) {
+            Root state;
+            state.id = ++m_lastRootId;
+            state.isPolled = isNetworkFileSystem(root);
+            m_roots.insert(root, state);
+            qCInfo(generic) << "[DirectoryWatcher] Watching" << root << (state.isPolled ? "(polling)" : "");
+            // Initial scan; its result is used as reference for later changes.
+            scanRoot(root);
+        }
+        hasPolledRoots = hasPolledRoots || m_roots.value(root).isPolled;
+    }
+
+    if (hasPolledRoots && !m_pollTimer.isActive()) {
+        m_pollTimer.start();
+    } else if (!hasPolledRoots) {
+        m_pollTimer.stop();
+    }
+}
+
+bool DirectoryWatcher::isNetworkFileSystem(const QString& path)
+{
+    // UNC paths, e.g. "//server/share/Movies"
+    if (QDir::fromNativeSeparators(path).startsWith("//")) {
+        return true;
+    }
+
+    const QStorageInfo storage(path);
+    if (!storage.isValid()) {
+        return false;
+    }
+
+    const QString type = QString::fromUtf8(storage.fileSystemType()).toLower();
+    const QStringList networkTypes{
+        "nfs", "cifs", "smb", "9p", "afp", "fuse.sshfs", "fuse.rclone", "davfs", "webdav", "ncpfs", "afs", "coda"};
+    for (const QString& networkType : networkTypes) {
+        if (type.startsWith(networkType)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DirectoryWatcher::onDirectoryChanged(const QString& path)
+{
+    const QString root = rootOf(QDir::fromNativeSeparators(path));
+    if (root.isEmpty()) {
+        return;
+    }
+    m_dirtyRoots.insert(root);
+    // Restart the timer: Copying a movie creates many events in a short time.
+    m_debounceTimer.start();
+}
+
+void DirectoryWatcher::onDebounceTimeout()
+{
+    const QSet<QString> roots = m_dirtyRoots;
+    m_dirtyRoots.clear();
+    for (const QString& root : roots) {
+        scanRoot(root);
+    }
+}
+
+void DirectoryWatcher::onPollTimeout()
+{
+    for (auto it = m_roots.cbegin(); it != m_roots.cend(); ++it) {
+        if (it->isPolled && it->hasManifest) {
+            scanRoot(it.key());
+        }
+    }
+}
+
+QString DirectoryWatcher::rootOf(const QString& dir) const
+{
+    QString result;
+    for (auto it = m_roots.cbegin(); it != m_roots.cend(); ++it) {
+        // Use the innermost root if roots are nested.
+        if (isSameOrSubDirectory(dir, it.key()) && it.key().length() > result.length()) {
+            result = it.key();
+        }
+    }
+    return result;
+}
+
+void DirectoryWatcher::scanRoot(const QString& root)
+{
+    auto state = m_roots.find(root);
+    if (state == m_roots.end()) {
+        return;
+    }
+    if (state->isScanning) {
+        state->isDirty = true;
+        return;
+    }
+    state->isScanning = true;
+    state->isDirty = false;
+
+    const quint64 id = state->id;
+    const DirectoryManifest previous = state->manifest;
+
+    auto* watcher = new QFutureWatcher<DirectoryManifestDiff>(this);
+    connect(watcher, &QFutureWatcher<DirectoryManifestDiff>::finished, this, [this, watcher, root, id]() {
+        onRootScanned(root, id, watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([root, previous]() { return diffDirectoryTree(root, previous); }));
+}
+
+void DirectoryWatcher::onRootScanned(const QString& root, quint64 id, const DirectoryManifestDiff& diff)
+{
+    auto state = m_roots.find(root);
+    if (state == m_roots.end() || state->id != id) {
+        // The root was removed while it was scanned.
+        return;
+    }
+
+    const bool isInitialScan = !state->hasManifest;
+    QStringList newDirs;
+    if (isInitialScan) {
+        newDirs = diff.current.keys();
+    } else {
+        for (const QString& dir : diff.changedDirs) {
+            if (!state->manifest.contains(dir)) {
+                newDirs.append(dir);
+            }
+        }
+    }
+
+    state->manifest = diff.current;
+    state->hasManifest = true;
+    state->isScanning = false;
+    const bool isDirty = state->isDirty;
+
+    if (!state->isPolled) {
+        if (!diff.removedDirs.isEmpty()) {
+            m_watcher.removePaths(diff.removedDirs);
+        }
+        watchDirectories(root, newDirs);
+    }
+
+    if (!isInitialScan && diff.hasChanges()) {
+        qCDebug(generic) << "[DirectoryWatcher] Changes in" << root << "| changed:" << diff.changedDirs.size()
+                         << "| removed:" << diff.removedDirs.size();
+        emit directoriesChanged(root, diff.changedDirs, diff.removedDirs);
+    }
+
+    if (isDirty) {
+        scanRoot(root);
+    }
+}
+
+void DirectoryWatcher::watchDirectories(const QString& root, const QStringList& dirs)
+{
+    if (dirs.isEmpty()) {
+        return;
+    }
+    const QStringList failed = m_watcher.addPaths(dirs);
+    if (failed.isEmpty()) {
+        return;
+    }
+
+    // Most likely the inotify limit (fs.inotify.max_user_watches) was reached.
+    qCWarning(generic) << "[DirectoryWatcher] Could not watch" << failed.size() << "directories in" << root
+                       << "| Falling back to polling";
+    unwatchRoot(root);
+    m_roots[root].isPolled = true;
+    if (!m_pollTimer.isActive()) {
+        m_pollTimer.start();
+    }
+}
+
+void DirectoryWatcher::unwatchRoot(const QString& root)
+{
+    QStringList watched;
+    const QStringList directories = m_watcher.directories();
+    for (const QString& dir : directories) {
+        if (isSameOrSubDirectory(QDir::fromNativeSeparators(dir), root)) {
+            watched.append(dir);
+        }
+    }
+    if (!watched.isEmpty()) {
+        m_watcher.removePaths(watched);
+    }
+}
+
+} // namespace mediaelch
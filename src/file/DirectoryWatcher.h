@@ -0,0 +1,80 @@
+#pragma once
+
+#include "file/DirectoryManifest.h"
+
+#include <QFileSystemWatcher>
+#include <QMap>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+namespace mediaelch {
+
+/// \brief Watches directory trees for added, removed or renamed entries.
+///
+/// Local directories are watched using QFileSystemWatcher (inotify on Linux).
+/// Network mounts do not report changes of other clients, so they are polled
+/// instead. Polling only stat()s the directories of the tree, see diffDirectoryTree().
+/// Events are debounced and coalesced per root directory: directoriesChanged()
+/// is emitted once per root after no further event arrived for debounceInterval().
+class DirectoryWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DirectoryWatcher(QObject* parent = nullptr);
+    ~DirectoryWatcher() override = default;
+
+    /// \brief   Sets the root directories to watch.
+    /// \details Roots that are already watched keep their state. The directory
+    ///          trees of new roots are scanned in a background thread.
+    void setRootDirectories(const QStringList& roots);
+    QStringList rootDirectories() const { return m_roots.keys(); }
+
+    int debounceInterval() const { return m_debounceTimer.interval(); }
+    void setDebounceInterval(int milliseconds) { m_debounceTimer.setInterval(milliseconds); }
+    int pollInterval() const { return m_pollTimer.interval(); }
+    void setPollInterval(int milliseconds) { m_pollTimer.setInterval(milliseconds); }
+
+    /// \brief Whether the given directory is on a network file system (NFS, SMB, ...).
+    static bool isNetworkFileSystem(const QString& path);
+
+signals:
+    /// \brief Directories below the given root were added, changed or removed.
+    void directoriesChanged(QString root, QStringList changedDirs, QStringList removedDirs);
+
+private slots:
+    void onDirectoryChanged(const QString& path);
+    void onDebounceTimeout();
+    void onPollTimeout();
+
+private:
+    struct Root
+    {
+        bool isPolled = false;
+        bool isScanning = false;
+        bool hasManifest = false;
+        /// \brief Set if an event arrived while the root was scanned.
+        bool isDirty = false;
+        /// \brief Unique id; used to discard scans of roots that were removed in the meantime.
+        quint64 id = 0;
+        DirectoryManifest manifest;
+    };
+
+    QString rootOf(const QString& dir) const;
+    void scanRoot(const QString& root);
+    void onRootScanned(const QString& root, quint64 id, const DirectoryManifestDiff& diff);
+    void watchDirectories(const QString& root, const QStringList& dirs);
+    void unwatchRoot(const QString& root);
+
+private:
+    QFileSystemWatcher m_watcher;
+    QTimer m_debounceTimer;
+    QTimer m_pollTimer;
+    QMap<QString, Root> m_roots;
+    QSet<QString> m_dirtyRoots;
+    quint64 m_lastRootId = 0;
+};
+
+} // namespace mediaelch
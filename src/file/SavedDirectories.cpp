@@ -0,0 +1,96 @@
+#include "file/SavedDirectories.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace {
+
+struct SavedDirectory
+{
+    mediaelch::DirectoryState state;
+    qint64 savedAt = 0;
+};
+
+QMutex& savedDirectoriesMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+/// \brief Map of absolute directory paths to their state after MediaElch changed them.
+QHash<QString, SavedDirectory>& savedDirectories()
+{
+    static QHash<QString, SavedDirectory> directories;
+    return directories;
+}
+
+} // namespace
+
+namespace mediaelch {
+
+constexpr qint64 SavedDirectories::EXPIRY_MS;
+
+void SavedDirectories::add(const QString& path)
+{
+    const QFileInfo info(path);
+    const QString dir = QDir::cleanPath(QDir::fromNativeSeparators(info.absolutePath()));
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    QMutexLocker locker(&savedDirectoriesMutex());
+    auto& directories = savedDirectories();
+
+    for (auto it = directories.begin(); it != directories.end();) {
+        if (now - it->savedAt > EXPIRY_MS) {
+            it = directories.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Files of the same directory are usually written by a single job; keep all of them.
+    QStringList files = directories.value(dir).state.metadataFiles;
+    if (!files.contains(info.fileName())) {
+        files << info.fileName();
+    }
+    bool ok = false;
+    const DirectoryState state = directoryState(dir, files, &ok);
+    if (ok) {
+        directories.insert(dir, {state, now});
+    } else {
+        directories.remove(dir);
+    }
+}
+
+QStringList SavedDirectories::withoutOwnChanges(const QStringList& dirs)
+{
+    QStringList result;
+    QMutexLocker locker(&savedDirectoriesMutex());
+    auto& directories = savedDirectories();
+
+    for (const QString& dir : dirs) {
+        const auto saved = directories.constFind(dir);
+        if (saved == directories.cend()) {
+            result << dir;
+            continue;
+        }
+        bool ok = false;
+        const DirectoryState current = directoryState(dir, saved->state.metadataFiles, &ok);
+        if (!ok || current != saved->state) {
+            result << dir;
+        }
+        directories.remove(dir);
+    }
+    return result;
+}
+
+void SavedDirectories::clear()
+{
+    QMutexLocker locker(&savedDirectoriesMutex());
+    savedDirectories().clear();
+}
+
+} // namespace mediaelch
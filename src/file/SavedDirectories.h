@@ -0,0 +1,34 @@
+#pragma once
+
+#include "file/DirectoryManifest.h"
+
+#include <QString>
+#include <QStringList>
+
+namespace mediaelch {
+
+/// \brief   Directories that MediaElch itself has changed, e.g. by saving an NFO file.
+/// \details Used to ignore changes reported by DirectoryWatcher that were caused by
+///          saving items, see LibraryWatcher.  The state of each directory is recorded
+///          right after a file in it was written.  If the directory still has this state
+///          once the change is reported, nobody else has changed it in the meantime.
+///
+///          All functions are thread-safe; files are saved in worker threads, see SaveQueue.
+class SavedDirectories
+{
+public:
+    /// \brief Time after which recorded directories are forgotten.
+    static constexpr qint64 EXPIRY_MS = 10 * 60 * 1000;
+
+    /// \brief Records the state of the parent directory of the given file or directory
+    ///        that was just written, created or removed.
+    static void add(const QString& path);
+    /// \brief   Returns \p dirs without directories that were only changed by MediaElch.
+    /// \details Recorded directories are forgotten, i.e. each recorded state is only
+    ///          used to ignore a single change report.
+    static QStringList withoutOwnChanges(const QStringList& dirs);
+    /// \brief Forgets all recorded directories.
+    static void clear();
+};
+
+} // namespace mediaelch
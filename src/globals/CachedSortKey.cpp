@@ -0,0 +1,33 @@
+#include "globals/CachedSortKey.h"
+
+#include <QCollator>
+#include <QLocale>
+
+namespace {
+
+int s_generation = 0;
+
+const QCollator& collator()
+{
+    // Same locale as used by QString::localeAwareCompare().
+    static const QCollator collator(QLocale::system());
+    return collator;
+}
+
+} // namespace
+
+bool CachedSortKey::isValid() const
+{
+    return m_key != nullptr && m_generation == s_generation;
+}
+
+void CachedSortKey::update(const QString& text) const
+{
+    m_key = std::make_unique<QCollatorSortKey>(collator().sortKey(text));
+    m_generation = s_generation;
+}
+
+void CachedSortKey::invalidateAll()
+{
+    ++s_generation;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QCollatorSortKey>
+#include <QString>
+#include <memory>
+
+/// \brief   Lazily computed collation key of a string, e.g. a movie's sort title.
+/// \details Comparing two keys is much cheaper than QString::localeAwareCompare(),
+///          which has to collate both strings on each call.  Keys are only valid for
+///          the string they were computed for; owners must call invalidate() when it
+///          changes.  All keys are recomputed after invalidateAll(), e.g. if the
+///          sort settings change.  Not thread safe; only use it in the GUI thread.
+class CachedSortKey
+{
+public:
+    CachedSortKey() = default;
+    CachedSortKey(const CachedSortKey& other) = delete;
+    CachedSortKey& operator=(const CachedSortKey& other) = delete;
+
+    /// \brief   Returns the cached key.
+    /// \details If the key was invalidated, it is computed from the string returned
+    ///          by textFunction.  The function is not called otherwise.
+    template<class TextFunction>
+    const QCollatorSortKey& key(TextFunction textFunction) const
+    {
+        if (!isValid()) {
+            update(textFunction());
+        }
+        return *m_key;
+    }
+    void invalidate() { m_key.reset(); }
+
+    /// \brief Invalidates all existing keys.
+    static void invalidateAll();
+
+private:
+    bool isValid() const;
+    void update(const QString& text) const;
+
+    mutable std::unique_ptr<QCollatorSortKey> m_key;
+    mutable int m_generation = 0;
+};
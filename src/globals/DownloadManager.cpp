@@ -4,23 +4,42 @@
 #include "log/Log.h"
 #include "music/Album.h"
 #include "music/Artist.h"
-#include "network/NetworkReplyWatcher.h"
-#include "network/NetworkRequest.h"
 #include "tv_shows/TvShow.h"
 
 #include <QFile>
 #include <QTimer>
 
-static constexpr char PROP_DOWNLOAD_ELEMENT[] = "downloadElement";
+namespace {
 
-DownloadManager::DownloadManager(QObject* parent) : QObject(parent)
+template<class T>
+void addDownloadOf(QHash<T*, int>& downloadsLeft, T* item)
 {
+    if (item != nullptr) {
+        ++downloadsLeft[item];
+    }
 }
 
-mediaelch::network::NetworkManager* DownloadManager::network()
+/// \brief Returns true if it was the last download of the item.
+template<class T>
+bool removeDownloadOf(QHash<T*, int>& downloadsLeft, T* item)
+{
+    auto it = downloadsLeft.find(item);
+    if (item == nullptr || it == downloadsLeft.end()) {
+        return false;
+    }
+    if (--it.value() > 0) {
+        return false;
+    }
+    downloadsLeft.erase(it);
+    return true;
+}
+
+} // namespace
+
+using mediaelch::network::DownloadScheduler;
+
+DownloadManager::DownloadManager(QObject* parent) : QObject(parent)
 {
-    static auto* s_network = new mediaelch::network::NetworkManager();
-    return s_network;
 }
 
 bool DownloadManager::isLocalFile(const QUrl& url)
@@ -30,286 +49,162 @@ bool DownloadManager::isLocalFile(const QUrl& url)
 
 void DownloadManager::setDownloads(QVector<DownloadManagerElement> elements)
 {
-    if (!m_queue.isEmpty()) {
+    if (!m_downloads.isEmpty()) {
         abortDownloads();
     }
 
-    m_queue.clear();
-
-    for (const DownloadManagerElement& elem : elements) {
-        addDownload(elem);
+    for (DownloadManagerElement& elem : elements) {
+        enqueue(std::move(elem));
     }
 
-    if (m_queue.isEmpty()) {
+    if (m_downloads.isEmpty()) {
         QTimer::singleShot(0, this, &DownloadManager::allDownloadsFinished);
     }
 }
 
 void DownloadManager::addDownload(DownloadManagerElement elem)
 {
-    // TODO: Refactor
-    //
-    // I previously assumed that we had a threading issue.  But this is not
-    // the case because connect() calls methods of DownloadManager only in one
-    // thread, DownloadManager's thread.
-    // But I forgot that signals (e.g. "emit sigFinished") call their slots
-    // _immediately_ by default. This means we could end up in inconsistent
-    // states because member variables are changed while we are still inside a
-    // method that depends on them or has a previous state.  For example:
-    //
-    //  addDownload()
-    //    startNextDownload();
-    //     on finished: downloadFinished()
-    //       emit sigDownloadFinished(elem);
-    //         some slot calls addDownload, m_currentDownloadElement changes
-    //       emit sigElemDownloaded(elem);
-    //         may emit wrong element
-    //
-    // To avoid this, I've adapted all places where a connect() to this
-    // download manager is used.  Those places now all used a queued connection.
-    //
-    // But to be more robust, we should refactor this class and get rid of
-    // all member variables that may change state.
-    // Also, this would allow parallel downloads.
-    //
-    // The mutexes have been removed but the code still needs to be refactored.
-    //
-
-    qCDebug(generic) << "[DownloadManager] Enqueue download at pos " << downloadQueueSize() << "|" << elem.url;
-
-    m_queue.enqueue(elem);
-
-    const bool shouldStartDownloading = m_currentReplies.size() <= numberOfParellelDownloads;
-    if (shouldStartDownloading) {
-        startNextDownload();
+    // Note: Signals are emitted while member variables are changed.  All places where a
+    // connect() to this download manager is used therefore use a queued connection.
+    enqueue(std::move(elem));
+    if (m_downloads.isEmpty()) {
+        emit allDownloadsFinished();
     }
 }
 
-template<class T>
-bool DownloadManager::hasDownloadsLeft(T*& elementToCheck)
+void DownloadManager::enqueue(DownloadManagerElement elem)
 {
-    // Note: This code looks similar to numberOfDownloadsLeft() but does not require
-    // to run through all downloads.
-    for (int i = 0, n = m_queue.size(); i < n; ++i) {
-        if (m_queue[i].getElement<T>() == elementToCheck) {
-            return true;
-        }
-    }
-    // There may be currently running requests for this movie/tv show/...
-    for (auto& m_currentReplie : m_currentReplies) {
-        // TODO: No copy!
-        auto download = m_currentReplie->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
-        if (download.getElement<T>() == elementToCheck) {
-            return true;
-        }
+    if (DownloadManager::isLocalFile(elem.url)) {
+        loadLocalFile(std::move(elem));
+        return;
     }
-    return false;
-}
 
-template<class T>
-int DownloadManager::numberOfDownloadsLeft(T*& elementToCheck)
-{
-    int count = 0;
-    for (int i = 0, n = m_queue.size(); i < n; ++i) {
-        if (m_queue[i].getElement<T>() == elementToCheck) {
-            ++count;
-        }
-    }
-    // There may be currently running requests for this movie/tv show/...
-    for (auto& m_currentReplie : m_currentReplies) {
-        // TODO: No copy!
-        auto download = m_currentReplie->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
-        if (download.getElement<T>() == elementToCheck) {
-            ++count;
-        }
-    }
-    return count;
+    qCDebug(generic) << "[DownloadManager] Enqueue download at pos " << downloadQueueSize() << "|" << elem.url;
+
+    addDownloadOf(m_movieDownloadsLeft, elem.movie);
+    addDownloadOf(m_showDownloadsLeft, elem.show);
+    addDownloadOf(m_concertDownloadsLeft, elem.concert);
+    addDownloadOf(m_artistDownloadsLeft, elem.artist);
+    addDownloadOf(m_albumDownloadsLeft, elem.album);
+
+    const QUrl url = elem.url;
+    const DownloadScheduler::Id id = DownloadScheduler::instance()->enqueue(url,
+        m_priority,
+        this,
+        [this](DownloadScheduler::Id finishedId, const DownloadScheduler::Result& result) {
+            downloadFinished(finishedId, result);
+        });
+    m_downloads.insert(id, std::move(elem));
 }
 
-void DownloadManager::abortDownloads()
+void DownloadManager::loadLocalFile(DownloadManagerElement elem)
 {
-    qCInfo(generic) << "[DownloadsManager] Abort Downloads";
-
-    m_queue.clear();
-
-    QVector<QNetworkReply*> replies = m_currentReplies;
-    // clear before aborting because "abort" emits "finished" which we are connected to.
-    // Avoid that m_currentReplies is used elsewhere.
-    m_currentReplies.clear();
-
-    for (auto* reply : replies) {
-        // deleted in downloadFinished()
-        reply->abort();
+    QFile file(elem.url.toString());
+    if (file.open(QIODevice::ReadOnly)) {
+        elem.data = file.readAll();
+        file.close();
     }
+    // TODO: Also emit allXXXFinished() signal
+    finishElement(elem);
 }
 
-void DownloadManager::startNextDownload()
+void DownloadManager::finishElement(DownloadManagerElement& elem)
 {
-    if (m_queue.isEmpty()) {
-        if (m_currentReplies.isEmpty()) {
-            qCInfo(generic) << "[DownloadManager] All downloads finished";
-            emit allDownloadsFinished();
-        }
-        return;
-    }
-
-    DownloadManagerElement download = m_queue.dequeue();
-
-    if (download.imageType == ImageType::Actor || download.imageType == ImageType::TvShowEpisodeThumb) {
-        if (download.movie != nullptr) {
-            emit movieDownloadsLeft(numberOfDownloadsLeft<Movie>(download.movie), download);
+    if (elem.actor != nullptr && elem.imageType == ImageType::Actor && elem.movie == nullptr) {
+        elem.actor->image = elem.data;
 
-        } else if (download.show != nullptr) {
-            emit showDownloadsLeft(numberOfDownloadsLeft<TvShow>(download.show), download);
-
-        } else {
-            emit downloadsLeft(downloadQueueSize());
-        }
-    }
-
-    qCDebug(generic) << "[DownloadManager] Start next download | Files left:" << m_queue.size();
-
-    if (DownloadManager::isLocalFile(download.url)) {
-        QFile file(download.url.toString());
-        QByteArray data;
-        if (file.open(QIODevice::ReadOnly)) {
-            data = file.readAll();
-            file.close();
-        }
-
-        download.data = data;
-
-        if (download.actor != nullptr && download.imageType == ImageType::Actor && (download.movie == nullptr)) {
-            download.actor->image = data;
-
-        } else if (download.imageType == ImageType::TvShowEpisodeThumb && !download.directDownload) {
-            download.episode->setThumbnailImage(data);
-
-        } else {
-            emit sigDownloadFinished(download);
-        }
-        startNextDownload();
-        // TODO: Also emit allXXXFinished() signal
+    } else if (elem.imageType == ImageType::TvShowEpisodeThumb && !elem.directDownload) {
+        elem.episode->setThumbnailImage(elem.data);
 
     } else {
-        QNetworkReply* reply = network()->getWithWatcher(mediaelch::network::requestWithDefaults(download.url));
-        reply->setProperty(PROP_DOWNLOAD_ELEMENT, QVariant::fromValue(download));
-        m_currentReplies.push_back(reply);
-
-        connect(reply, &QNetworkReply::finished, this, &DownloadManager::downloadFinished);
-        connect(reply, &QNetworkReply::downloadProgress, this, &DownloadManager::downloadProgress);
-    }
-}
-
-void DownloadManager::downloadProgress(qint64 received, qint64 total)
-{
-    auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
-    if (reply == nullptr) {
-        qCCritical(generic) << "[DownloadManager] dynamic_cast<QNetworkReply*> failed for downloadProgress!";
-        return;
+        emit sigDownloadFinished(elem);
     }
-
-    auto element = reply->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
-    element.bytesReceived = received;
-    element.bytesTotal = total;
-
-    emit sigDownloadProgress(element);
 }
 
-void DownloadManager::restartDownloadAfterTimeout(QNetworkReply* reply)
+void DownloadManager::abortDownloads()
 {
-    auto download = reply->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
-    ++download.retries;
-    reply->deleteLater();
+    qCInfo(generic) << "[DownloadsManager] Abort Downloads";
 
-    qCWarning(generic) << "[DownloadManager] Download timed out:" << download.url;
+    DownloadScheduler::instance()->cancel(this);
+    const bool wasDownloading = !m_downloads.isEmpty();
+    m_downloads.clear();
 
-    if (download.retries < 3) {
-        qCDebug(generic) << "[DownloadManager] Re-enqueuing the download, tries:" << download.retries << "/ 3";
-        m_queue.prepend(download);
+    // Listeners wait for these signals, e.g. to stop showing a loading indicator.
+    const auto movies = std::move(m_movieDownloadsLeft);
+    const auto shows = std::move(m_showDownloadsLeft);
+    const auto concerts = std::move(m_concertDownloadsLeft);
+    const auto artists = std::move(m_artistDownloadsLeft);
+    const auto albums = std::move(m_albumDownloadsLeft);
 
-    } else {
-        qCDebug(generic) << "[DownloadManager] Giving up on this file, tried 3 times";
-    }
+    // clang-format off
+    for (Movie* movie : movies.keys())       { emit allMovieDownloadsFinished(movie); }
+    for (TvShow* show : shows.keys())        { emit allTvShowDownloadsFinished(show); }
+    for (Concert* concert : concerts.keys()) { emit allConcertDownloadsFinished(concert); }
+    for (Artist* artist : artists.keys())    { emit allArtistDownloadsFinished(artist); }
+    for (Album* album : albums.keys())       { emit allAlbumDownloadsFinished(album); }
+    // clang-format on
 
-    // Should always be true because we're replacing the previous request
-    // but just to be sure, we still check this.
-    if (m_currentReplies.size() <= numberOfParellelDownloads) {
-        startNextDownload();
+    if (wasDownloading) {
+        emit allDownloadsFinished();
     }
 }
 
-void DownloadManager::downloadFinished()
+void DownloadManager::downloadFinished(DownloadScheduler::Id id, const DownloadScheduler::Result& result)
 {
-    auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
-    if (reply == nullptr) {
-        qCCritical(generic) << "[DownloadManager] dynamic_cast<QNetworkReply*> failed for downloadFinished!";
+    auto it = m_downloads.find(id);
+    if (it == m_downloads.end()) {
+        qCCritical(generic) << "[DownloadManager] downloadFinished() called for download which wasn't tracked";
         return;
     }
+    DownloadManagerElement elem = std::move(it.value());
+    m_downloads.erase(it);
 
-    bool wasRemoved = m_currentReplies.removeOne(reply);
-    if (!wasRemoved) {
-        qCCritical(generic) << "[DownloadManager] downloadFinished() called for reply which wasn't tracked";
-    }
-
-    QByteArray data;
-    if (reply->error() != QNetworkReply::NoError) {
-        if (reply->property(NetworkReplyWatcher::TIMEOUT_PROP).toBool()) {
-            restartDownloadAfterTimeout(reply); // also deletes the reply
-            return;
-        }
-        qCWarning(generic) << "[DownloadManager] Network Error:" << reply->errorString() << "|" << reply->url();
-
-    } else {
-        data = reply->readAll();
-    }
-
-
-    DownloadManagerElement downloadElelement = reply->property(PROP_DOWNLOAD_ELEMENT).value<DownloadManagerElement>();
-    reply->deleteLater();
+    elem.data = result.data;
+    finishElement(elem);
+    emit sigElemDownloaded(elem);
 
-    downloadElelement.data = data;
+    if (elem.imageType == ImageType::Actor || elem.imageType == ImageType::TvShowEpisodeThumb) {
+        if (elem.movie != nullptr) {
+            emit movieDownloadsLeft(m_movieDownloadsLeft.value(elem.movie) - 1, elem);
 
-    if (downloadElelement.actor != nullptr && downloadElelement.imageType == ImageType::Actor
-        && downloadElelement.movie == nullptr) {
-        downloadElelement.actor->image = data;
+        } else if (elem.show != nullptr) {
+            emit showDownloadsLeft(m_showDownloadsLeft.value(elem.show) - 1, elem);
 
-    } else if (downloadElelement.imageType == ImageType::TvShowEpisodeThumb && !downloadElelement.directDownload) {
-        downloadElelement.episode->setThumbnailImage(data);
-
-    } else {
-        emit sigDownloadFinished(downloadElelement);
+        } else {
+            emit downloadsLeft(downloadQueueSize());
+        }
     }
 
-    emit sigElemDownloaded(downloadElelement);
-
-    if (downloadElelement.movie != nullptr && !hasDownloadsLeft<Movie>(downloadElelement.movie)) {
-        emit allMovieDownloadsFinished(downloadElelement.movie);
+    if (removeDownloadOf(m_movieDownloadsLeft, elem.movie)) {
+        emit allMovieDownloadsFinished(elem.movie);
     }
-    if (downloadElelement.show != nullptr && !hasDownloadsLeft<TvShow>(downloadElelement.show)) {
-        emit allTvShowDownloadsFinished(downloadElelement.show);
+    if (removeDownloadOf(m_showDownloadsLeft, elem.show)) {
+        emit allTvShowDownloadsFinished(elem.show);
     }
-    if (downloadElelement.concert != nullptr && !hasDownloadsLeft<Concert>(downloadElelement.concert)) {
-        emit allConcertDownloadsFinished(downloadElelement.concert);
+    if (removeDownloadOf(m_concertDownloadsLeft, elem.concert)) {
+        emit allConcertDownloadsFinished(elem.concert);
     }
-    if (downloadElelement.artist != nullptr && !hasDownloadsLeft<Artist>(downloadElelement.artist)) {
-        emit allArtistDownloadsFinished(downloadElelement.artist);
+    if (removeDownloadOf(m_artistDownloadsLeft, elem.artist)) {
+        emit allArtistDownloadsFinished(elem.artist);
     }
-    if (downloadElelement.album != nullptr && !hasDownloadsLeft<Album>(downloadElelement.album)) {
-        emit allAlbumDownloadsFinished(downloadElelement.album);
+    if (removeDownloadOf(m_albumDownloadsLeft, elem.album)) {
+        emit allAlbumDownloadsFinished(elem.album);
     }
 
-    startNextDownload();
+    if (m_downloads.isEmpty()) {
+        qCInfo(generic) << "[DownloadManager] All downloads finished";
+        emit allDownloadsFinished();
+    }
 }
 
 bool DownloadManager::isDownloading() const
 {
-    return !m_queue.isEmpty() || !m_currentReplies.isEmpty();
+    return !m_downloads.isEmpty();
 }
 
 int DownloadManager::downloadQueueSize()
 {
-    return m_queue.size() + m_currentReplies.size();
+    return m_downloads.size();
 }
 
 int DownloadManager::downloadsLeftForShow(TvShow* show)
@@ -318,5 +213,11 @@ int DownloadManager::downloadsLeftForShow(TvShow* show)
         qCCritical(generic) << "[DownloadManager] Cannot count downloads left for nullptr show";
         return 0;
     }
-    return numberOfDownloadsLeft<TvShow>(show);
+    return m_showDownloadsLeft.value(show);
+}
+
+void DownloadManager::setPriority(DownloadScheduler::Priority priority)
+{
+    m_priority = priority;
+    DownloadScheduler::instance()->setPriority(this, priority);
 }
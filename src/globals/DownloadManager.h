@@ -2,13 +2,10 @@
 
 #include "globals/DownloadManagerElement.h"
 #include "globals/Globals.h"
-#include "network/NetworkManager.h"
+#include "network/DownloadScheduler.h"
 
-#include <QMutex>
-#include <QNetworkReply>
+#include <QHash>
 #include <QObject>
-#include <QQueue>
-#include <QTimer>
 #include <QUrl>
 #include <QVector>
 
@@ -40,9 +37,11 @@ public:
     /// \param show Tv show to get number of downloads for
     /// \return Number of downloads left
     int downloadsLeftForShow(TvShow* show);
+    /// \brief Priority of this manager's downloads in the global DownloadScheduler.
+    ///        Also changes the priority of queued downloads.
+    void setPriority(mediaelch::network::DownloadScheduler::Priority priority);
 
 signals:
-    void sigDownloadProgress(DownloadManagerElement);
     void downloadsLeft(int);
     void movieDownloadsLeft(int, DownloadManagerElement);
     void showDownloadsLeft(int, DownloadManagerElement);
@@ -56,31 +55,27 @@ signals:
     void allArtistDownloadsFinished(Artist*);
     void allAlbumDownloadsFinished(Album*);
 
-private slots:
-    /// \param received Received bytes
-    /// \param total Total bytes
-    void downloadProgress(qint64 received, qint64 total);
-    /// \brief Starts the next download if there is one.
-    void downloadFinished();
-    void startNextDownload();
-    /// \brief Stops the current download and prepends it to the queue
-    void restartDownloadAfterTimeout(QNetworkReply* reply);
-
 private:
-    /// \brief Checks if all downloads of the given movie/tvshow/... have finished.
-    template<class T>
-    bool hasDownloadsLeft(T*& elementToCheck);
-    /// \brief Count all downloads of the given movie/tvshow/... have finished.
-    template<class T>
-    int numberOfDownloadsLeft(T*& elementToCheck);
+    /// \brief Enqueues the element in the scheduler or loads it if it is a local file.
+    void enqueue(DownloadManagerElement elem);
+    void loadLocalFile(DownloadManagerElement elem);
+    void downloadFinished(mediaelch::network::DownloadScheduler::Id id,
+        const mediaelch::network::DownloadScheduler::Result& result);
+    /// \brief Sets the element's data and emits the signals of a finished download.
+    void finishElement(DownloadManagerElement& elem);
 
-    /// \brief Returns the network access manager
-    /// \return Network access manager object
-    mediaelch::network::NetworkManager* network();
     static bool isLocalFile(const QUrl& url);
 
-    QVector<QNetworkReply*> m_currentReplies;
-    QQueue<DownloadManagerElement> m_queue;
+    /// \brief Downloads of this manager that are queued or running in the scheduler.
+    QHash<mediaelch::network::DownloadScheduler::Id, DownloadManagerElement> m_downloads;
+    /// \brief Number of downloads left per movie/tv show/..., so that checking whether
+    ///        all downloads of an item have finished does not require a look at all downloads.
+    QHash<Movie*, int> m_movieDownloadsLeft;
+    QHash<TvShow*, int> m_showDownloadsLeft;
+    QHash<Concert*, int> m_concertDownloadsLeft;
+    QHash<Artist*, int> m_artistDownloadsLeft;
+    QHash<Album*, int> m_albumDownloadsLeft;
 
-    int numberOfParellelDownloads = 5;
+    mediaelch::network::DownloadScheduler::Priority m_priority =
+        mediaelch::network::DownloadScheduler::Priority::Normal;
 };
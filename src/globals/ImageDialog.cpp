@@ -39,6 +39,9 @@ ImageDialog::ImageDialog(QWidget* parent) : QDialog(parent), ui(new Ui::ImageDia
     setWindowFlags((windowFlags() & ~Qt::WindowType_Mask) | Qt::Dialog);
 #endif
 
+    // The user waits for the previews, so send them before pending bulk downloads.
+    m_network.setPriority(QNetworkRequest::HighPriority);
+
     ui->gallery->setAlignment(Qt::Horizontal);
     ui->gallery->setShowZoomAndResolution(false);
 
@@ -59,6 +62,10 @@ ImageDialog::ImageDialog(QWidget* parent) : QDialog(parent), ui(new Ui::ImageDia
     connect(ui->gallery,       elchOverload<QString>(&ImageGallery::sigRemoveImage),  this, &ImageDialog::onImageClosed);
     connect(ui->imageProvider, elchOverload<int>(&QComboBox::currentIndexChanged),    this, &ImageDialog::onProviderChanged);
     connect(ui->comboLanguage, elchOverload<int>(&QComboBox::currentIndexChanged),    this, &ImageDialog::onLanguageChanged);
+
+    connect(&m_previewDownloader, &mediaelch::network::ImagePreviewDownloader::sigImageLoaded, this, &ImageDialog::onPreviewLoaded);
+    connect(&m_previewDownloader, &mediaelch::network::ImagePreviewDownloader::sigError,       this, &ImageDialog::onPreviewError);
+    connect(&m_previewDownloader, &mediaelch::network::ImagePreviewDownloader::sigFinished,    this, &ImageDialog::onPreviewsFinished);
     // clang-format on
 
     ui->btnAcceptImages->hide();
@@ -68,7 +75,6 @@ ImageDialog::ImageDialog(QWidget* parent) : QDialog(parent), ui(new Ui::ImageDia
     ui->labelSpinner->setMovie(movie);
 
     setImageType(ImageType::MoviePoster);
-    m_currentDownloadReply = nullptr;
     m_multiSelection = false;
 
     // create zoom out/in buttons and make them darker
@@ -234,13 +240,19 @@ void ImageDialog::setAndStartDownloads(QVector<Poster> downloads)
     renderTable();
     if (downloads.count() == 0) {
         ui->stackedWidget->setCurrentIndex(2);
+        onPreviewsFinished();
+        return;
     }
-    startNextDownload();
-}
 
-mediaelch::network::NetworkManager* ImageDialog::network()
-{
-    return &m_network;
+    // Decode previews for the largest preview size so that zooming in does not require a new download.
+    const int maxColumnWidth = ui->previewSizeSlider->maximum() * 16;
+    m_previewDownloader.setMaxWidth(static_cast<int>((maxColumnWidth - 10) * helper::devicePixelRatio(this)));
+    for (int i = 0, n = m_elements.size(); i < n; ++i) {
+        const DownloadElement& d = m_elements[i];
+        if (!d.downloaded) {
+            m_previewDownloader.download(i, d.thumbUrl.isValid() ? d.thumbUrl : d.originalUrl);
+        }
+    }
 }
 
 void ImageDialog::setupProviderCombo()
@@ -298,63 +310,41 @@ void ImageDialog::resizeAndReposition()
     }
 }
 
-void ImageDialog::startNextDownload()
+void ImageDialog::onPreviewLoaded(int index, QImage image)
 {
-    qCDebug(generic) << "[ImageDialog] Start next download";
-
-    int nextIndex = -1;
-    for (int i = 0, n = m_elements.size(); i < n; i++) {
-        if (!m_elements[i].downloaded) {
-            nextIndex = i;
-            break;
-        }
-    }
-
-    if (nextIndex == -1) {
-        ui->labelLoading->setVisible(false);
-        ui->labelSpinner->setVisible(false);
+    // It is possible that m_elements has been cleared by aborting all downloads
+    if (index >= m_elements.size()) {
         return;
     }
+    DownloadElement& element = m_elements[index];
+    element.downloaded = true;
+    element.pixmap = QPixmap::fromImage(image);
+    helper::setDevicePixelRatio(element.pixmap, helper::devicePixelRatio(this));
 
-    QUrl url =
-        m_elements[nextIndex].thumbUrl.isValid() ? m_elements[nextIndex].thumbUrl : m_elements[nextIndex].originalUrl;
-
-    m_currentDownloadIndex = nextIndex;
-    m_currentDownloadReply = network()->get(mediaelch::network::requestWithDefaults(url));
-    connect(m_currentDownloadReply, &QNetworkReply::finished, this, &ImageDialog::downloadFinished);
+    if (!element.pixmap.isNull() && element.cellWidget != nullptr) {
+        const int width = static_cast<int>((getColumnWidth() - 10) * helper::devicePixelRatio(this));
+        element.scaledPixmap = element.pixmap.scaledToWidth(width, Qt::SmoothTransformation);
+        helper::setDevicePixelRatio(element.scaledPixmap, helper::devicePixelRatio(this));
+        element.cellWidget->setImage(element.scaledPixmap);
+        element.cellWidget->setHint(element.resolution, element.hint);
+        ui->table->resizeRowToContents(index / qMax(1, ui->table->columnCount()));
+    }
 }
 
-void ImageDialog::downloadFinished()
+void ImageDialog::onPreviewError(int index, QUrl url, QString errorString)
 {
-    if (m_currentDownloadReply->error() == QNetworkReply::NoError) {
-        m_elements[m_currentDownloadIndex].pixmap.loadFromData(m_currentDownloadReply->readAll());
-        helper::setDevicePixelRatio(m_elements[m_currentDownloadIndex].pixmap, helper::devicePixelRatio(this));
-
-        if (!m_elements[m_currentDownloadIndex].pixmap.isNull()) {
-            const int width = static_cast<int>((getColumnWidth() - 10) * helper::devicePixelRatio(this));
-            m_elements[m_currentDownloadIndex].scaledPixmap =
-                m_elements[m_currentDownloadIndex].pixmap.scaledToWidth(width, Qt::SmoothTransformation);
-            helper::setDevicePixelRatio(
-                m_elements[m_currentDownloadIndex].scaledPixmap, helper::devicePixelRatio(this));
-            m_elements[m_currentDownloadIndex].cellWidget->setImage(m_elements[m_currentDownloadIndex].scaledPixmap);
-            m_elements[m_currentDownloadIndex].cellWidget->setHint(
-                m_elements[m_currentDownloadIndex].resolution, m_elements[m_currentDownloadIndex].hint);
-        }
-        ui->table->resizeRowsToContents();
-
-    } else {
-        showError(tr("Error while downloading one or more images: %1").arg(m_currentDownloadReply->errorString()));
-        qCWarning(generic) << "Network Error: " << m_currentDownloadReply->errorString() << " | "
-                           << m_currentDownloadReply->url();
+    Q_UNUSED(url)
+    showError(tr("Error while downloading one or more images: %1").arg(errorString));
+    if (index < m_elements.size()) {
+        // Mark item as downloaded even if there was an error.
+        m_elements[index].downloaded = true;
     }
+}
 
-    // It is possible that m_elements has been cleared by aborting all downloads
-    if (m_currentDownloadIndex < m_elements.size()) {
-        // Mark item as downloaded even if there was an error to avoid an infinite loop.
-        m_elements[m_currentDownloadIndex].downloaded = true;
-    }
-    m_currentDownloadReply->deleteLater();
-    startNextDownload();
+void ImageDialog::onPreviewsFinished()
+{
+    ui->labelLoading->setVisible(false);
+    ui->labelSpinner->setVisible(false);
 }
 
 void ImageDialog::renderTable()
@@ -491,17 +481,8 @@ void ImageDialog::cancelDownloads()
 {
     ui->labelLoading->setVisible(false);
     ui->labelSpinner->setVisible(false);
-    bool running = false;
-    for (const DownloadElement& d : asConst(m_elements)) {
-        if (!d.downloaded) {
-            running = true;
-            break;
-        }
-    }
+    m_previewDownloader.abortAll();
     m_elements.clear();
-    if (running) {
-        m_currentDownloadReply->abort();
-    }
 }
 
 /**
@@ -3,6 +3,7 @@
 #include "globals/Globals.h"
 #include "globals/Poster.h"
 #include "globals/ScraperResult.h"
+#include "network/ImagePreviewDownloader.h"
 #include "network/NetworkManager.h"
 #include "scrapers/image/ImageProvider.h"
 #include "tv_shows/EpisodeNumber.h"
@@ -65,10 +66,10 @@ protected:
     void resizeEvent(QResizeEvent* event) override;
 
 private slots:
-    /// \brief Called when a download has finished
-    /// \details Renders the table and displays the downloaded image and starts the next download
-    void downloadFinished();
-    void startNextDownload();
+    /// \brief Called when a preview was downloaded and decoded; displays the image.
+    void onPreviewLoaded(int index, QImage image);
+    void onPreviewError(int index, QUrl url, QString errorString);
+    void onPreviewsFinished();
     void imageClicked(int row, int col);
     void chooseLocalImage();
     void onImageDropped(QUrl url);
@@ -110,8 +111,7 @@ private:
     };
 
     mediaelch::network::NetworkManager m_network;
-    int m_currentDownloadIndex = 0;
-    QNetworkReply* m_currentDownloadReply = nullptr;
+    mediaelch::network::ImagePreviewDownloader m_previewDownloader{&m_network};
     ImageType m_imageType = ImageType::None;
     QVector<DownloadElement> m_elements;
     QUrl m_imageUrl;
@@ -134,7 +134,6 @@ private:
 private:
     void setAndStartDownloads(QVector<Poster> downloads);
 
-    mediaelch::network::NetworkManager* network();
     void setupProviderCombo();
     void resizeAndReposition();
     void renderTable();
@@ -0,0 +1,240 @@
+#include "globals/LibraryWatcher.h"
+
+#include "file/DirectoryWatcher.h"
+#include "file/SavedDirectories.h"
+#include "globals/Manager.h"
+#include "log/Log.h"
+#include "music/Album.h"
+#include "music/Artist.h"
+#include "settings/Settings.h"
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QFileInfo>
+#include <algorithm>
+
+namespace {
+
+constexpr int RETRY_INTERVAL_MS = 10 * 1000;
+
+bool hasUnsavedChanges(const TvShow* show)
+{
+    const auto& episodes = show->episodes();
+    return show->hasChanged()
+           || std::any_of(episodes.cbegin(), episodes.cend(), [](const TvShowEpisode* e) { return e->hasChanged(); });
+}
+
+bool hasUnsavedChanges(Artist* artist)
+{
+    const auto& albums = artist->albums();
+    return artist->hasChanged()
+           || std::any_of(albums.cbegin(), albums.cend(), [](const Album* album) { return album->hasChanged(); });
+}
+
+} // namespace
+
+namespace mediaelch {
+
+LibraryWatcher::LibraryWatcher(QObject* parent) : QObject(parent), m_watcher{new DirectoryWatcher(this)}
+{
+    m_retryTimer.setSingleShot(true);
+    m_retryTimer.setInterval(RETRY_INTERVAL_MS);
+
+    connect(m_watcher, &DirectoryWatcher::directoriesChanged, this, &LibraryWatcher::onDirectoriesChanged);
+    connect(&m_retryTimer, &QTimer::timeout, this, &LibraryWatcher::processPending);
+
+    // Continue with the next pending update once the previous one (or a reload) has finished.
+    auto* manager = Manager::instance();
+    connect(manager->movieFileSearcher(), &MovieFileSearcher::directoryUpdated, this, &LibraryWatcher::processPending);
+    connect(manager->movieFileSearcher(), &MovieFileSearcher::finished, this, &LibraryWatcher::processPending);
+    connect(manager->tvShowFileSearcher(), &TvShowFileSearcher::tvShowsLoaded, this, &LibraryWatcher::processPending);
+    // Queued: Concerts and music are updated synchronously, i.e. these are emitted while processing pending updates.
+    connect(manager->concertFileSearcher(),
+        &ConcertFileSearcher::concertsLoaded,
+        this,
+        &LibraryWatcher::processPending,
+        Qt::QueuedConnection);
+    connect(manager->musicFileSearcher(),
+        &MusicFileSearcher::musicLoaded,
+        this,
+        &LibraryWatcher::processPending,
+        Qt::QueuedConnection);
+}
+
+void LibraryWatcher::updateDirectories()
+{
+    m_rootTypes.clear();
+
+    if (!Settings::instance()->advanced()->watchLibrary()) {
+        m_watcher->setRootDirectories({});
+        return;
+    }
+
+    const auto& settings = Settings::instance()->directorySettings();
+    const auto addRoots = [this](const QVector<SettingsDir>& directories, SettingsDirType type) {
+        for (const SettingsDir& dir : directories) {
+            if (!dir.disabled && dir.path.exists()) {
+                m_rootTypes.insert(QDir::cleanPath(dir.path.absolutePath()), type);
+            }
+        }
+    };
+    addRoots(settings.movieDirectories(), SettingsDirType::Movies);
+    addRoots(settings.tvShowDirectories(), SettingsDirType::TvShows);
+    addRoots(settings.concertDirectories(), SettingsDirType::Concerts);
+    addRoots(settings.musicDirectories(), SettingsDirType::Music);
+
+    m_watcher->setRootDirectories(m_rootTypes.keys());
+}
+
+void LibraryWatcher::onDirectoriesChanged(QString root, QStringList changedDirs, QStringList removedDirs)
+{
+    if (!m_rootTypes.contains(root)) {
+        return;
+    }
+
+    // Saving an item writes its NFO file and images; those changes must not reload the item.
+    changedDirs = SavedDirectories::withoutOwnChanges(changedDirs);
+    if (changedDirs.isEmpty() && removedDirs.isEmpty()) {
+        qCDebug(generic) << "[LibraryWatcher] Ignoring changes made by MediaElch in" << root;
+        return;
+    }
+
+    switch (m_rootTypes.value(root)) {
+    case SettingsDirType::Movies: m_pendingMovieDirs.insert(root); break;
+    case SettingsDirType::TvShows:
+        addTopLevelDirectories(root, changedDirs, m_pendingShowDirs);
+        addTopLevelDirectories(root, removedDirs, m_pendingShowDirs);
+        break;
+    case SettingsDirType::Concerts: {
+        QSet<QString>& dirs = m_pendingConcertDirs[root];
+        for (const QString& dir : asConst(changedDirs)) {
+            dirs.insert(dir);
+        }
+        break;
+    }
+    case SettingsDirType::Music:
+        addTopLevelDirectories(root, changedDirs, m_pendingArtistDirs);
+        addTopLevelDirectories(root, removedDirs, m_pendingArtistDirs);
+        break;
+    case SettingsDirType::Downloads: break;
+    }
+
+    processPending();
+}
+
+void LibraryWatcher::addTopLevelDirectories(const QString& root, const QStringList& dirs, QSet<QString>& topLevelDirs)
+{
+    for (const QString& dir : dirs) {
+        if (dir.length() <= root.length() + 1) {
+            // The root itself changed: New and removed directories are reported separately.
+            continue;
+        }
+        const QString dirName = dir.mid(root.length() + 1).section('/', 0, 0);
+        if (Settings::instance()->advanced()->isFolderExcluded(dirName)) {
+            continue;
+        }
+        topLevelDirs.insert(root + '/' + dirName);
+    }
+}
+
+void LibraryWatcher::processPending()
+{
+    bool isPending = processMovies();
+    isPending = processTvShows() || isPending;
+    isPending = processConcerts() || isPending;
+    isPending = processMusic() || isPending;
+
+    if (isPending && !m_retryTimer.isActive()) {
+        m_retryTimer.start();
+    }
+}
+
+bool LibraryWatcher::processMovies()
+{
+    auto* searcher = Manager::instance()->movieFileSearcher();
+    if (!m_pendingMovieDirs.isEmpty() && !searcher->isRunning()) {
+        const QString root = *m_pendingMovieDirs.cbegin();
+        if (searcher->updateDirectory(DirectoryPath(root))) {
+            m_pendingMovieDirs.remove(root);
+        }
+    }
+    // Further directories are updated after directoryUpdated() was emitted.
+    return !m_pendingMovieDirs.isEmpty();
+}
+
+bool LibraryWatcher::processTvShows()
+{
+    auto* manager = Manager::instance();
+    auto* searcher = manager->tvShowFileSearcher();
+
+    while (!m_pendingShowDirs.isEmpty() && !searcher->isRunning()) {
+        const DirectoryPath showDir(*m_pendingShowDirs.cbegin());
+        m_pendingShowDirs.erase(m_pendingShowDirs.begin());
+
+        const QVector<TvShow*> shows = manager->tvShowModel()->tvShows();
+        const auto show = std::find_if(shows.cbegin(), shows.cend(), [&showDir](const TvShow* s) { //
+            return s->dir() == showDir;
+        });
+
+        if (show != shows.cend() && hasUnsavedChanges(*show)) {
+            qCInfo(generic) << "[LibraryWatcher] TV show has unsaved changes, not reloading it:" << showDir;
+            continue;
+        }
+
+        if (!QFileInfo(showDir.toString()).isDir()) {
+            qCInfo(generic) << "[LibraryWatcher] TV show was removed:" << showDir;
+            if (show != shows.cend()) {
+                manager->tvShowModel()->removeShow(*show);
+            }
+            manager->database()->clearTvShowInDirectory(showDir);
+            continue;
+        }
+
+        qCInfo(generic) << "[LibraryWatcher] Reloading TV show:" << showDir;
+        searcher->reloadEpisodes(showDir);
+    }
+    // Further shows are reloaded after tvShowsLoaded() was emitted.
+    return !m_pendingShowDirs.isEmpty();
+}
+
+bool LibraryWatcher::processConcerts()
+{
+    auto* searcher = Manager::instance()->concertFileSearcher();
+    while (!m_pendingConcertDirs.isEmpty() && !searcher->isRunning()) {
+        const QString root = m_pendingConcertDirs.firstKey();
+        const QSet<QString> changedDirs = m_pendingConcertDirs.take(root);
+        if (!searcher->updateDirectory(DirectoryPath(root), changedDirs)) {
+            m_pendingConcertDirs[root].unite(changedDirs);
+            break;
+        }
+    }
+    // Retried once concertsLoaded() was emitted.
+    return !m_pendingConcertDirs.isEmpty();
+}
+
+bool LibraryWatcher::processMusic()
+{
+    auto* manager = Manager::instance();
+    auto* searcher = manager->musicFileSearcher();
+
+    while (!m_pendingArtistDirs.isEmpty() && !searcher->isRunning()) {
+        const DirectoryPath artistDir(*m_pendingArtistDirs.cbegin());
+        m_pendingArtistDirs.erase(m_pendingArtistDirs.begin());
+
+        const QVector<Artist*> artists = manager->musicModel()->artists();
+        const auto artist = std::find_if(artists.cbegin(), artists.cend(), [&artistDir](Artist* a) { //
+            return a->path() == artistDir;
+        });
+        if (artist != artists.cend() && hasUnsavedChanges(*artist)) {
+            qCInfo(generic) << "[LibraryWatcher] Artist has unsaved changes, not reloading it:" << artistDir;
+            continue;
+        }
+
+        qCInfo(generic) << "[LibraryWatcher] Reloading artist:" << artistDir;
+        searcher->reloadArtist(artistDir);
+    }
+    // Further artists are reloaded after musicLoaded() was emitted.
+    return !m_pendingArtistDirs.isEmpty();
+}
+
+} // namespace mediaelch
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "globals/Globals.h"
+
+#include <QMap>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+namespace mediaelch {
+
+class DirectoryWatcher;
+
+/// \brief   Keeps the media models up to date while MediaElch is running.
+/// \details Watches all enabled media directories and updates only what has
+///          changed instead of reloading everything:
+///            - movies: changed directories are rescanned, see MovieFileSearcher::updateDirectory()
+///            - TV shows: changed shows are reloaded, removed shows are removed
+///            - concerts: changed directories are rescanned, see ConcertFileSearcher::updateDirectory()
+///            - music: changed artists are reloaded, removed artists are removed
+///          Updates are postponed while a file searcher is running or if there
+///          are unsaved changes that would be lost.  Changes made by MediaElch
+///          itself, e.g. by saving an item, are ignored, see SavedDirectories.
+class LibraryWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LibraryWatcher(QObject* parent = nullptr);
+    ~LibraryWatcher() override = default;
+
+public slots:
+    /// \brief Watch the directories of the current directory settings.
+    void updateDirectories();
+
+private slots:
+    void onDirectoriesChanged(QString root, QStringList changedDirs, QStringList removedDirs);
+    void processPending();
+
+private:
+    /// \brief Adds the first directory below the root of each given directory to the set.
+    static void addTopLevelDirectories(const QString& root, const QStringList& dirs, QSet<QString>& topLevelDirs);
+    bool processMovies();
+    bool processTvShows();
+    bool processConcerts();
+    bool processMusic();
+
+private:
+    DirectoryWatcher* m_watcher = nullptr;
+    QMap<QString, SettingsDirType> m_rootTypes;
+    /// \brief Movie directories (roots) that need to be updated.
+    QSet<QString> m_pendingMovieDirs;
+    /// \brief TV show directories (not roots) that need to be reloaded.
+    QSet<QString> m_pendingShowDirs;
+    /// \brief Concert directories (roots) that need to be updated and their changed directories.
+    QMap<QString, QSet<QString>> m_pendingConcertDirs;
+    /// \brief Artist directories (not roots) that need to be reloaded.
+    QSet<QString> m_pendingArtistDirs;
+    /// \brief Used to retry pending updates that had to be postponed.
+    QTimer m_retryTimer;
+};
+
+} // namespace mediaelch
@@ -30,6 +30,8 @@ Manager::Manager(QObject* parent) : QObject(parent)
     m_concertModel = new ConcertModel(this);
     m_musicModel = new MusicModel(this);
     m_database = new Database(this);
+    m_saveQueue = new mediaelch::SaveQueue(this);
+    m_mediaInfoIndexer = new mediaelch::MediaInfoIndexer(this);
 
     m_mediaCenters.append(new KodiXml(this));
     m_mediaCentersTvShow.append(new KodiXml(this));
@@ -180,6 +182,16 @@ Database* Manager::database()
     return m_database;
 }
 
+mediaelch::SaveQueue* Manager::saveQueue()
+{
+    return m_saveQueue;
+}
+
+mediaelch::MediaInfoIndexer* Manager::mediaInfoIndexer()
+{
+    return m_mediaInfoIndexer;
+}
+
 void Manager::setTvShowFilesWidget(TvShowFilesWidget* widget)
 {
     m_tvShowFilesWidget = widget;
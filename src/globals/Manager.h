@@ -3,8 +3,10 @@
 #include "concerts/ConcertFileSearcher.h"
 #include "concerts/ConcertModel.h"
 #include "data/Database.h"
+#include "data/MediaInfoIndexer.h"
 #include "globals/ScraperManager.h"
 #include "media_centers/MediaCenterInterface.h"
+#include "media_centers/SaveQueue.h"
 #include "movies/MovieModel.h"
 #include "movies/file_searcher/MovieFileSearcher.h"
 #include "music/MusicFileSearcher.h"
@@ -49,6 +51,8 @@ public:
     ELCH_NODISCARD ConcertFileSearcher* concertFileSearcher();
     ELCH_NODISCARD MusicFileSearcher* musicFileSearcher();
     ELCH_NODISCARD Database* database();
+    ELCH_NODISCARD mediaelch::SaveQueue* saveQueue();
+    ELCH_NODISCARD mediaelch::MediaInfoIndexer* mediaInfoIndexer();
     ELCH_NODISCARD MovieModel* movieModel();
     ELCH_NODISCARD TvShowModel* tvShowModel();
     ELCH_NODISCARD ConcertModel* concertModel();
@@ -78,6 +82,8 @@ private:
     ConcertModel* m_concertModel = nullptr;
     MusicModel* m_musicModel = nullptr;
     Database* m_database = nullptr;
+    mediaelch::SaveQueue* m_saveQueue = nullptr;
+    mediaelch::MediaInfoIndexer* m_mediaInfoIndexer = nullptr;
     TvShowFilesWidget* m_tvShowFilesWidget = nullptr;
     MusicFilesWidget* m_musicFilesWidget = nullptr;
     FileScannerDialog* m_fileScannerDialog = nullptr;
@@ -363,6 +363,7 @@ void TrailerDialog::downloadFinished()
         } else {
             file.rename(newFileName);
         }
+        m_currentMovie->updateHasLocalTrailer();
 
     } else if (m_downloadReply->error() == QNetworkReply::OperationCanceledError) {
         ui->progress->setText(tr("Download Canceled"));
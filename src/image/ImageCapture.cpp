@@ -1,13 +1,11 @@
 #include "ImageCapture.h"
 
 #include "globals/Random.h"
-#include "globals/Time.h"
 #include "log/Log.h"
 #include "ui/notifications/NotificationBox.h"
 
 #include <QCoreApplication>
 #include <QProcess>
-#include <QTemporaryFile>
 
 namespace mediaelch {
 
@@ -29,42 +27,17 @@ bool ImageCapture::captureImage(FilePath file,
         return false;
     }
 
-#ifdef Q_OS_OSX
-    QString ffmpegbin = QCoreApplication::applicationDirPath() + "/ffmpeg";
-#elif defined(Q_OS_WIN)
-    QString ffmpegbin = QCoreApplication::applicationDirPath() + "/vendor/ffmpeg.exe";
-#else
-    QString ffmpegbin = "ffmpeg";
-#endif
+    const std::chrono::seconds duration(
+        streamDetails->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds, nullptr).toUInt());
 
-    QProcess ffmpeg;
-
-    unsigned duration =
-        streamDetails->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds, nullptr).toUInt();
-
-    if (duration == 0) {
+    if (duration.count() == 0) {
         NotificationBox::instance()->showError(tr("Could not detect runtime of file"));
         return false;
     }
 
-    const unsigned t = mediaelch::randomUnsignedInt() % duration;
-    QString timeCode = mediaelch::secondsToTimeCode(t);
-
-    QTemporaryFile tmpFile;
-    if (!tmpFile.open()) {
-        NotificationBox::instance()->showError(tr("Temporary output file could not be opened"));
-        return false;
-    }
-    tmpFile.close();
-
-    ffmpeg.start(ffmpegbin,
-        QStringList() << "-y"
-                      << "-ss" << timeCode << "-i" << file.toNativePathString() << "-vframes"
-                      << "1"
-                      << "-q:v"
-                      << "2"
-                      << "-f"
-                      << "mjpeg" << tmpFile.fileName());
+    // The frame is written to stdout; QProcess buffers it until ffmpeg has finished.
+    QProcess ffmpeg;
+    ffmpeg.start(ffmpegBinary(), ffmpegArguments(file, randomPosition(duration)));
     if (!ffmpeg.waitForStarted()) {
 #if defined(Q_OS_WIN) || defined(Q_OS_OSX)
         NotificationBox::instance()->showError(tr("Could not start ffmpeg"));
@@ -76,40 +49,90 @@ bool ImageCapture::captureImage(FilePath file,
     }
 
     if (!ffmpeg.waitForFinished(10000)) {
+        ffmpeg.kill();
         NotificationBox::instance()->showError(tr("ffmpeg did not finish"));
         return false;
     }
-    if (!tmpFile.open()) {
-        NotificationBox::instance()->showError(tr("Temporary output file could not be opened"));
+
+    const QImage frame = QImage::fromData(ffmpeg.readAllStandardOutput());
+    if (frame.isNull()) {
+        qCWarning(generic) << "[ImageCapture] ffmpeg did not return an image:" << ffmpeg.readAllStandardError();
+        NotificationBox::instance()->showError(tr("ffmpeg did not return an image"));
         return false;
     }
+    img = scaleImage(frame, dim, cropFromCenter);
+    return true;
+}
+
+QString ImageCapture::ffmpegBinary()
+{
+#ifdef Q_OS_OSX
+    return QCoreApplication::applicationDirPath() + "/ffmpeg";
+#elif defined(Q_OS_WIN)
+    return QCoreApplication::applicationDirPath() + "/vendor/ffmpeg.exe";
+#else
+    return "ffmpeg";
+#endif
+}
 
-    img = QImage::fromData(tmpFile.readAll());
-    tmpFile.close();
+QStringList ImageCapture::ffmpegArguments(const FilePath& file, std::chrono::seconds position)
+{
+    // -ss before -i seeks in the input.  Without accurate seeking, ffmpeg uses the keyframe
+    // before the position instead of decoding all frames up to it.
+    return QStringList{"-nostdin",
+        "-loglevel",
+        "error",
+        "-noaccurate_seek",
+        "-ss",
+        QString::number(position.count()),
+        "-skip_frame",
+        "nokey",
+        "-i",
+        file.toNativePathString(),
+        "-an",
+        "-sn",
+        "-frames:v",
+        "1",
+        "-q:v",
+        "2",
+        "-f",
+        "image2pipe",
+        "-vcodec",
+        "mjpeg",
+        "pipe:1"};
+}
 
+std::chrono::seconds ImageCapture::randomPosition(std::chrono::seconds duration)
+{
+    if (duration.count() <= 0) {
+        return std::chrono::seconds(0);
+    }
+    return std::chrono::seconds(mediaelch::randomUnsignedInt() % static_cast<unsigned>(duration.count()));
+}
+
+QImage ImageCapture::scaleImage(const QImage& image, ThumbnailDimensions dim, bool cropFromCenter)
+{
     // 0 => no scaling
-    if (dim.width == 0 || dim.height == 0) {
-        return true;
+    if (image.isNull() || dim.width == 0 || dim.height == 0) {
+        return image;
     }
 
     if (cropFromCenter) {
-        img = img.scaled(dim.width, dim.height, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+        const QImage scaled =
+            image.scaled(dim.width, dim.height, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
 
-        int offsetLeft = (img.width() - dim.width) / 2;
+        int offsetLeft = (scaled.width() - dim.width) / 2;
         offsetLeft = (offsetLeft < 0) ? 0 : offsetLeft;
 
-        int offsetTop = (img.height() - dim.height) / 2;
+        int offsetTop = (scaled.height() - dim.height) / 2;
         offsetTop = (offsetTop < 0) ? 0 : offsetTop;
 
         // Crop the image
-        img = img.copy(QRect(offsetLeft, offsetTop, dim.width, dim.height));
-
-    } else {
-        // Only resize the image to the wanted dimensions and keep the aspect ratio.
-        img = img.scaled(dim.width, dim.height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        return scaled.copy(QRect(offsetLeft, offsetTop, dim.width, dim.height));
     }
 
-    return true;
+    // Only resize the image to the wanted dimensions and keep the aspect ratio.
+    return image.scaled(dim.width, dim.height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 }
 
 } // namespace mediaelch
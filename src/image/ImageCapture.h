@@ -4,7 +4,10 @@
 #include "file/Path.h"
 #include "image/ThumbnailDimensions.h"
 
+#include <QImage>
 #include <QObject>
+#include <QStringList>
+#include <chrono>
 
 namespace mediaelch {
 
@@ -22,11 +25,23 @@ public:
     /// the given dimensions and will crop a rectangle from the screenshot's
     /// center. Otherwise the resulting image may be smaller in size or height
     /// than the given dimensions.
+    /// \see ImageCaptureBatch for capturing images of many files.
     static bool captureImage(FilePath file,
         StreamDetails* streamDetails,
         ThumbnailDimensions dim,
         QImage& img,
         bool cropFromCenter = false);
+
+    /// \brief Path of the ffmpeg executable, either bundled or in $PATH.
+    static QString ffmpegBinary();
+    /// \brief Arguments for ffmpeg to write a single JPEG frame of the file to stdout.
+    /// \details Seeks to the keyframe before the given position without decoding
+    ///          the frames in between, which is fast even for large files.
+    static QStringList ffmpegArguments(const FilePath& file, std::chrono::seconds position);
+    /// \brief A random position in a video of the given duration.
+    static std::chrono::seconds randomPosition(std::chrono::seconds duration);
+    /// \brief Scales the captured frame as described in captureImage().
+    static QImage scaleImage(const QImage& image, ThumbnailDimensions dim, bool cropFromCenter);
 };
 
 } // namespace mediaelch
@@ -0,0 +1,230 @@
+#include "image/ImageCaptureBatch.h"
+
+#include "data/MediaInfoIndexer.h"
+#include "globals/Meta.h"
+#include "image/ImageCapture.h"
+#include "log/Log.h"
+
+#include <QFutureWatcher>
+#include <QProcess>
+#include <QThread>
+#include <QTimer>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace mediaelch {
+
+constexpr int ImageCaptureBatch::PROCESS_TIMEOUT_MS;
+constexpr int ImageCaptureBatch::MAX_PROCESSES;
+
+ImageCaptureBatch::ImageCaptureBatch(ThumbnailDimensions dim, bool cropFromCenter, QObject* parent) :
+    QObject(parent),
+    m_dimensions{dim},
+    m_cropFromCenter{cropFromCenter},
+    m_maxProcesses{std::max(1, std::min(QThread::idealThreadCount(), MAX_PROCESSES))}
+{
+    // Keep the threads and with them their database connections, see MediaInfoIndexer::load().
+    m_threadPool.setExpiryTimeout(-1);
+}
+
+ImageCaptureBatch::~ImageCaptureBatch()
+{
+    ++m_batchId;
+    m_pending.clear();
+    for (QProcess* process : asConst(m_processes)) {
+        process->disconnect(this);
+        process->kill();
+    }
+    m_threadPool.waitForDone();
+}
+
+void ImageCaptureBatch::start(const QVector<FilePath>& files)
+{
+    cancel();
+
+    m_files = files;
+    m_pending.clear();
+    for (int i = 0; i < files.size(); ++i) {
+        m_pending.push_back(i);
+    }
+    m_done = 0;
+    m_total = files.size();
+    m_ffmpegMissing = false;
+
+    if (m_total == 0) {
+        emit sigFinished();
+        return;
+    }
+    emit sigProgress(0, m_total);
+    for (int i = 0; i < m_maxProcesses; ++i) {
+        startNext();
+    }
+}
+
+void ImageCaptureBatch::cancel()
+{
+    ++m_batchId;
+    m_pending.clear();
+    for (QProcess* process : asConst(m_processes)) {
+        process->disconnect(this);
+        process->kill();
+        process->deleteLater();
+    }
+    m_processes.clear();
+    m_running = 0;
+
+    if (isRunning()) {
+        m_total = 0;
+        emit sigFinished();
+    }
+}
+
+void ImageCaptureBatch::startNext()
+{
+    if (m_pending.empty() || m_running >= m_maxProcesses) {
+        return;
+    }
+    const int index = m_pending.front();
+    m_pending.pop_front();
+    ++m_running;
+
+    // Durations of indexed files are read from the database, so this is cheap for most files.
+    const int batchId = m_batchId;
+    auto* watcher = new QFutureWatcher<qint64>(this);
+    connect(watcher, &QFutureWatcher<qint64>::finished, this, [this, watcher, batchId, index]() {
+        watcher->deleteLater();
+        if (batchId == m_batchId) {
+            startProcess(index, std::chrono::seconds(watcher->result()));
+        }
+    });
+    const FilePath file = m_files[index];
+    watcher->setFuture(QtConcurrent::run(&m_threadPool, [file]() {
+        const StreamDetails::Values values = MediaInfoIndexer::load(FileList({file}));
+        return values.video.value(StreamDetails::VideoDetails::DurationInSeconds).toLongLong();
+    }));
+}
+
+void ImageCaptureBatch::startProcess(int index, std::chrono::seconds duration)
+{
+    if (m_ffmpegMissing) {
+        releaseSlot();
+        failItem(index, tr("Could not start ffmpeg"));
+        return;
+    }
+    if (duration.count() <= 0) {
+        releaseSlot();
+        failItem(index, tr("Could not detect runtime of file"));
+        return;
+    }
+
+    auto* process = new QProcess(this);
+    m_processes.push_back(process);
+    // Only stdout is needed; ffmpeg's log level is set to "error".
+    process->setProcessChannelMode(QProcess::SeparateChannels);
+
+    connect(process,
+        elchOverload<int, QProcess::ExitStatus>(&QProcess::finished),
+        this,
+        [this, process, index](int exitCode, QProcess::ExitStatus exitStatus) {
+            onProcessFinished(process, index, exitCode, exitStatus);
+        });
+    connect(process, &QProcess::errorOccurred, this, [this, process, index](QProcess::ProcessError error) {
+        if (error != QProcess::FailedToStart) {
+            // Crashes and timeouts are handled once the process has finished.
+            return;
+        }
+        qCWarning(generic) << "[ImageCaptureBatch] Could not start ffmpeg:" << process->errorString();
+        m_ffmpegMissing = true;
+        m_processes.removeOne(process);
+        process->deleteLater();
+        releaseSlot();
+        failItem(index, tr("Could not start ffmpeg"));
+    });
+    // The timer is stopped if the process is deleted before.
+    QTimer::singleShot(PROCESS_TIMEOUT_MS, process, [process]() {
+        qCWarning(generic) << "[ImageCaptureBatch] ffmpeg did not finish, kill it:" << process->arguments();
+        process->kill();
+    });
+
+    process->start(ImageCapture::ffmpegBinary(),
+        ImageCapture::ffmpegArguments(m_files[index], ImageCapture::randomPosition(duration)));
+}
+
+bool ImageCaptureBatch::hasImage(int exitCode, QProcess::ExitStatus exitStatus, const QByteArray& output)
+{
+    return exitStatus == QProcess::NormalExit && exitCode == 0 && !output.isEmpty();
+}
+
+void ImageCaptureBatch::onProcessFinished(QProcess* process,
+    int index,
+    int exitCode,
+    QProcess::ExitStatus exitStatus)
+{
+    const QByteArray data = process->readAllStandardOutput();
+    const bool success = hasImage(exitCode, exitStatus, data);
+    if (!success) {
+        qCWarning(generic) << "[ImageCaptureBatch] ffmpeg did not return an image for" << m_files[index].toString()
+                           << "| exit code:" << exitCode
+                           << "| crashed or killed:" << (exitStatus != QProcess::NormalExit)
+                           << process->readAllStandardError();
+    }
+    m_processes.removeOne(process);
+    process->deleteLater();
+    releaseSlot();
+
+    if (!success) {
+        failItem(index, tr("ffmpeg did not return an image"));
+        return;
+    }
+
+    const int batchId = m_batchId;
+    auto* watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, batchId, index]() {
+        watcher->deleteLater();
+        if (batchId != m_batchId) {
+            return;
+        }
+        const QImage image = watcher->result();
+        if (image.isNull()) {
+            failItem(index, tr("ffmpeg did not return an image"));
+            return;
+        }
+        emit sigImageCaptured(index, image);
+        // Receivers may cancel the batch.
+        if (batchId == m_batchId) {
+            onItemDone();
+        }
+    });
+    const ThumbnailDimensions dim = m_dimensions;
+    const bool cropFromCenter = m_cropFromCenter;
+    watcher->setFuture(QtConcurrent::run(&m_threadPool, [data, dim, cropFromCenter]() {
+        return ImageCapture::scaleImage(QImage::fromData(data), dim, cropFromCenter);
+    }));
+}
+
+void ImageCaptureBatch::releaseSlot()
+{
+    --m_running;
+    startNext();
+}
+
+void ImageCaptureBatch::failItem(int index, const QString& error)
+{
+    const int batchId = m_batchId;
+    emit sigImageFailed(index, error);
+    if (batchId == m_batchId) {
+        onItemDone();
+    }
+}
+
+void ImageCaptureBatch::onItemDone()
+{
+    ++m_done;
+    emit sigProgress(m_done, m_total);
+    if (m_done == m_total) {
+        m_total = 0;
+        emit sigFinished();
+    }
+}
+
+} // namespace mediaelch
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "file/Path.h"
+#include "image/ThumbnailDimensions.h"
+
+#include <QImage>
+#include <QObject>
+#include <QProcess>
+#include <QThreadPool>
+#include <QVector>
+#include <chrono>
+#include <deque>
+
+namespace mediaelch {
+
+/// \brief   Captures one screenshot of each of many video files, e.g. episode thumbnails
+///          of a whole season.
+/// \details Runs up to maxProcesses() ffmpeg processes at the same time.  Frames are read
+///          from ffmpeg's stdout; no temporary files are used.  Durations are loaded using
+///          MediaInfoIndexer, so files that were indexed before are not read again.  Frames
+///          are decoded and scaled in worker threads.
+///
+///          Signals are emitted in the batch's thread.  sigImageCaptured() is emitted in the
+///          order the images are finished, not in the order of the files.
+class ImageCaptureBatch : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// \brief Time after which a single ffmpeg process is killed.
+    static constexpr int PROCESS_TIMEOUT_MS = 10000;
+    /// \brief ffmpeg processes are mostly limited by the disk; more do not help.
+    static constexpr int MAX_PROCESSES = 4;
+
+    /// \brief   Whether a finished ffmpeg process returned an image.
+    /// \details Processes that were killed, e.g. after PROCESS_TIMEOUT_MS, or that failed
+    ///          may have written a truncated image that must not be used.
+    static bool hasImage(int exitCode, QProcess::ExitStatus exitStatus, const QByteArray& output);
+
+public:
+    /// \see ImageCapture::captureImage() for the meaning of the dimensions and cropFromCenter.
+    ImageCaptureBatch(ThumbnailDimensions dim, bool cropFromCenter, QObject* parent = nullptr);
+    ~ImageCaptureBatch() override;
+
+    /// \brief Starts capturing an image of each file.  A running batch is cancelled.
+    void start(const QVector<FilePath>& files);
+    /// \brief Stops all ffmpeg processes.  No more images are reported, sigFinished() is emitted.
+    void cancel();
+
+    bool isRunning() const { return m_total > 0; }
+    int maxProcesses() const { return m_maxProcesses; }
+
+signals:
+    /// \brief The image of files[index] was captured.
+    void sigImageCaptured(int index, QImage image);
+    /// \brief No image could be captured for files[index].
+    void sigImageFailed(int index, QString error);
+    void sigProgress(int done, int total);
+    void sigFinished();
+
+private:
+    void startNext();
+    void startProcess(int index, std::chrono::seconds duration);
+    void onProcessFinished(QProcess* process, int index, int exitCode, QProcess::ExitStatus exitStatus);
+    /// \brief Allows the next file to be started once a process has finished.
+    void releaseSlot();
+    void onItemDone();
+    void failItem(int index, const QString& error);
+
+    ThumbnailDimensions m_dimensions;
+    bool m_cropFromCenter = false;
+    int m_maxProcesses = 1;
+    /// \brief Used to ignore results of cancelled batches.
+    int m_batchId = 0;
+
+    QVector<FilePath> m_files;
+    std::deque<int> m_pending;
+    QVector<QProcess*> m_processes;
+    int m_running = 0;
+    int m_done = 0;
+    int m_total = 0;
+    bool m_ffmpegMissing = false;
+
+    /// \brief Duration lookups and image decoding.
+    QThreadPool m_threadPool;
+};
+
+} // namespace mediaelch
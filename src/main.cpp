@@ -10,6 +10,7 @@
 
 #include "Version.h"
 #include "log/Log.h"
+#include "network/HttpCache.h"
 #include "settings/Settings.h"
 #include "ui/main/MainWindow.h"
 
@@ -120,6 +121,7 @@ int main(int argc, char* argv[])
 
     // Load the system's settings, e.g. window position, etc.
     Settings::instance()->loadSettings();
+    mediaelch::network::HttpCache::setDirectory(Settings::instance()->networkCacheDir().toString());
 
     initLogFile();
     loadStylesheet(app, Settings::instance()->advanced()->customStylesheet());
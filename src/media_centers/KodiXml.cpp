@@ -5,6 +5,7 @@
 #include "globals/Manager.h"
 #include "image/Image.h"
 #include "log/Log.h"
+#include "media_centers/SaveJob.h"
 #include "media_centers/kodi/AlbumXmlReader.h"
 #include "media_centers/kodi/AlbumXmlWriter.h"
 #include "media_centers/kodi/ArtistXmlReader.h"
@@ -28,6 +29,7 @@
 #include <QFileInfo>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
+#include <algorithm>
 #include <array>
 #include <memory>
 
@@ -59,6 +61,12 @@ QByteArray KodiXml::getMovieXml(Movie* movie)
 /// \return Saving success
 /// \see KodiXml::writeMovieXml
 bool KodiXml::saveMovie(Movie* movie)
+{
+    mediaelch::SaveJob job;
+    return createSaveJob(movie, job) && job.run(*Manager::instance()->database());
+}
+
+bool KodiXml::createSaveJob(Movie* movie, mediaelch::SaveJob& job)
 {
     qCDebug(generic) << "Save movie as Kodi NFO file; movie: " << movie->name();
     QByteArray xmlContent = getMovieXml(movie);
@@ -70,27 +78,13 @@ bool KodiXml::saveMovie(Movie* movie)
 
     movie->setNfoContent(xmlContent);
 
-    bool saved = false;
+    job = mediaelch::SaveJob(movie->name());
+    job.setKey(movie->files().first().toString());
+
     QFileInfo fi(movie->files().first().toString());
     for (auto dataFile : Settings::instance()->dataFiles(DataFileType::MovieNfo)) {
         QString saveFileName = dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, movie->files().count() > 1);
-        QString saveFilePath = fi.absolutePath() + "/" + saveFileName;
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        qCDebug(generic) << "Saving to" << file.fileName();
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "File could not be openend";
-        } else {
-            file.write(xmlContent);
-            file.close();
-            saved = true;
-        }
-    }
-    if (!saved) {
-        return false;
+        job.writeNfo(fi.absolutePath() + "/" + saveFileName, xmlContent);
     }
 
     for (const auto imageType : Movie::imageTypes()) {
@@ -107,7 +101,7 @@ bool KodiXml::saveMovie(Movie* movie)
                     && (movie->discType() == DiscType::BluRay || movie->discType() == DiscType::Dvd)) {
                     saveFileName = "fanart.jpg";
                 }
-                saveFile(getPath(movie).filePath(saveFileName), movie->images().image(imageType));
+                job.writeFile(getPath(movie).filePath(saveFileName), movie->images().image(imageType));
             }
         }
 
@@ -123,38 +117,30 @@ bool KodiXml::saveMovie(Movie* movie)
                     && (movie->discType() == DiscType::BluRay || movie->discType() == DiscType::Dvd)) {
                     saveFileName = "fanart.jpg";
                 }
-                QFile(getPath(movie).filePath(saveFileName)).remove();
+                job.removeFile(getPath(movie).filePath(saveFileName));
             }
         }
     }
 
     if (movie->inSeparateFolder() && !movie->files().isEmpty()) {
         for (const QString& file : movie->images().extraFanartsToRemove()) {
-            QFile::remove(file);
-        }
-        QDir dir(movie->files().first().dir().toString() + "/extrafanart");
-        if (!dir.exists() && !movie->images().extraFanartToAdd().isEmpty()) {
-            QDir(movie->files().first().dir().toString()).mkdir("extrafanart");
+            job.removeFile(file);
         }
+        const QString dir = movie->files().first().dir().toString() + "/extrafanart";
         for (const QByteArray& img : movie->images().extraFanartToAdd()) {
-            int num = 1;
-            while (QFileInfo(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num)).exists()) {
-                ++num;
-            }
-            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num), img);
+            job.addExtraFanart(dir, img);
         }
     }
 
     for (const Actor* actor : movie->actors()) {
         if (!actor->image.isNull()) {
-            QDir dir;
-            dir.mkdir(fi.absolutePath() + "/" + ".actors");
             QString actorName = actor->name;
             actorName = actorName.replace(" ", "_");
-            saveFile(fi.absolutePath() + "/" + ".actors" + "/" + actorName + ".jpg", actor->image);
+            job.writeFile(fi.absolutePath() + "/" + ".actors" + "/" + actorName + ".jpg", actor->image);
         }
     }
 
+    // Subtitles are renamed right away because their file names are stored in the movie.
     for (Subtitle* subtitle : movie->subtitles()) {
         if (subtitle->changed()) {
             QString subFileName = fi.completeBaseName();
@@ -182,8 +168,7 @@ bool KodiXml::saveMovie(Movie* movie)
         }
     }
 
-    // TODO: Multithreaded?
-    Manager::instance()->database()->update(movie);
+    job.addDatabaseUpdate(Database::updateFor(movie));
 
     return true;
 }
@@ -321,13 +306,15 @@ bool KodiXml::loadMovie(Movie* movie, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
+    movie->streamDetails()->clear();
+    movie->setStreamDetailsLoaded(false);
 
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::MovieXmlReader reader(*movie);
-    reader.parseNfoDom(domDoc);
-
-    movie->setStreamDetailsLoaded(loadStreamDetails(movie->streamDetails(), domDoc));
+    reader.parse(xml);
+    if (xml.hasError()) {
+        qCWarning(generic) << "[KodiXml] Error while parsing movie NFO:" << xml.errorString();
+    }
 
     // Existence of images
     if (initialNfoContent.isEmpty()) {
@@ -340,76 +327,85 @@ bool KodiXml::loadMovie(Movie* movie, QString initialNfoContent)
     return true;
 }
 
-/// \brief Loads the stream details from the dom document
+/// \brief Reads the <streamdetails> element that the reader is positioned at.
+/// \details External subtitles, i.e. <subtitle> elements with a <file> tag, are skipped
+///          because they are stored separately.
+/// \param reader XML stream at a <streamdetails> start element
 /// \param streamDetails StreamDetails object
-/// \param domDoc Nfo document
-/// \return Infos loaded
-bool KodiXml::loadStreamDetails(StreamDetails* streamDetails, QDomDocument domDoc)
+void KodiXml::readStreamDetails(QXmlStreamReader& reader, StreamDetails* streamDetails)
 {
-    streamDetails->clear();
-    QDomNodeList elements = domDoc.elementsByTagName("streamdetails");
-    if (elements.isEmpty()) {
-        return false;
-    }
-    QDomElement elem = elements.at(0).toElement();
-    loadStreamDetails(streamDetails, elem);
-    return true;
-}
-
-void KodiXml::loadStreamDetails(StreamDetails* streamDetails, QDomElement elem)
-{
-    if (!elem.elementsByTagName("video").isEmpty()) {
-        QDomElement videoElem = elem.elementsByTagName("video").at(0).toElement();
-
-        std::array<StreamDetails::VideoDetails, 7> details{StreamDetails::VideoDetails::Codec,
-            StreamDetails::VideoDetails::Aspect,
-            StreamDetails::VideoDetails::Width,
-            StreamDetails::VideoDetails::Height,
-            StreamDetails::VideoDetails::DurationInSeconds,
-            StreamDetails::VideoDetails::ScanType,
-            StreamDetails::VideoDetails::StereoMode};
-
-        for (const auto detail : details) {
-            const QString detailStr = StreamDetails::detailToString(detail);
-            QDomNodeList elements = videoElem.elementsByTagName(detailStr);
-            if (!elements.isEmpty()) {
-                streamDetails->setVideoDetail(detail, elements.at(0).toElement().text());
-            }
-        }
-    }
-
-    QDomNodeList audioElements = elem.elementsByTagName("audio");
-    std::array<StreamDetails::AudioDetails, 3> audioDetails{StreamDetails::AudioDetails::Codec,
+    const std::array<StreamDetails::VideoDetails, 7> videoDetails{StreamDetails::VideoDetails::Codec,
+        StreamDetails::VideoDetails::Aspect,
+        StreamDetails::VideoDetails::Width,
+        StreamDetails::VideoDetails::Height,
+        StreamDetails::VideoDetails::DurationInSeconds,
+        StreamDetails::VideoDetails::ScanType,
+        StreamDetails::VideoDetails::StereoMode};
+    // Audio details are stored in this order so that the result does not depend on the order of the tags.
+    const std::array<StreamDetails::AudioDetails, 3> audioDetails{StreamDetails::AudioDetails::Codec,
         StreamDetails::AudioDetails::Language,
         StreamDetails::AudioDetails::Channels};
 
-    for (int i = 0, n = audioElements.count(); i < n; ++i) {
-        QDomElement audioElem = audioElements.at(i).toElement();
-
-        for (const auto detail : audioDetails) {
-            const QString detailStr = StreamDetails::detailToString(detail);
-            QDomNodeList detailElements = audioElem.elementsByTagName(detailStr);
-
-            if (!detailElements.isEmpty()) {
-                streamDetails->setAudioDetail(i, detail, detailElements.at(0).toElement().text());
+    bool hasVideo = false;
+    int audioStreamNumber = 0;
+    int subtitleStreamNumber = 0;
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("video") && !hasVideo) {
+            hasVideo = true;
+            while (reader.readNextStartElement()) {
+                const auto detail = std::find_if(videoDetails.cbegin(), videoDetails.cend(), [&reader](auto d) {
+                    return reader.name() == StreamDetails::detailToString(d);
+                });
+                if (detail != videoDetails.cend()) {
+                    streamDetails->setVideoDetail(*detail, reader.readElementText());
+                } else {
+                    reader.skipCurrentElement();
+                }
             }
-        }
-    }
 
-    QDomNodeList subtitleElements = elem.elementsByTagName("subtitle");
-    std::array<StreamDetails::SubtitleDetails, 1> subtitleDetails{StreamDetails::SubtitleDetails::Language};
-
-    for (int i = 0, n = subtitleElements.count(); i < n; ++i) {
-        QDomElement subtitleElem = subtitleElements.at(i).toElement();
-        if (!subtitleElem.elementsByTagName("file").isEmpty()) {
-            continue;
-        }
-        for (const auto detail : subtitleDetails) {
-            const auto detailStr = StreamDetails::detailToString(detail);
-            if (!subtitleElem.elementsByTagName(detailStr).isEmpty()) {
+        } else if (reader.name() == QLatin1String("audio")) {
+            QMap<StreamDetails::AudioDetails, QString> values;
+            while (reader.readNextStartElement()) {
+                const auto detail = std::find_if(audioDetails.cbegin(), audioDetails.cend(), [&reader](auto d) {
+                    return reader.name() == StreamDetails::detailToString(d);
+                });
+                if (detail != audioDetails.cend()) {
+                    values.insert(*detail, reader.readElementText());
+                } else {
+                    reader.skipCurrentElement();
+                }
+            }
+            for (const auto detail : audioDetails) {
+                if (values.contains(detail)) {
+                    streamDetails->setAudioDetail(audioStreamNumber, detail, values.value(detail));
+                }
+            }
+            ++audioStreamNumber;
+
+        } else if (reader.name() == QLatin1String("subtitle")) {
+            bool isExternal = false;
+            bool hasLanguage = false;
+            QString language;
+            while (reader.readNextStartElement()) {
+                if (reader.name() == QLatin1String("file")) {
+                    isExternal = true;
+                    reader.skipCurrentElement();
+                } else if (reader.name() == StreamDetails::detailToString(StreamDetails::SubtitleDetails::Language)) {
+                    language = reader.readElementText();
+                    hasLanguage = true;
+                } else {
+                    reader.skipCurrentElement();
+                }
+            }
+            if (!isExternal && hasLanguage) {
                 streamDetails->setSubtitleDetail(
-                    i, detail, subtitleElem.elementsByTagName(detailStr).at(0).toElement().text());
+                    subtitleStreamNumber, StreamDetails::SubtitleDetails::Language, language);
             }
+            ++subtitleStreamNumber;
+
+        } else {
+            reader.skipCurrentElement();
         }
     }
 }
@@ -541,6 +537,12 @@ QByteArray KodiXml::getConcertXml(Concert* concert)
  * \see KodiXml::writeConcertXml
  */
 bool KodiXml::saveConcert(Concert* concert)
+{
+    mediaelch::SaveJob job;
+    return createSaveJob(concert, job) && job.run(*Manager::instance()->database());
+}
+
+bool KodiXml::createSaveJob(Concert* concert, mediaelch::SaveJob& job)
 {
     QByteArray xmlContent = getConcertXml(concert);
 
@@ -550,30 +552,15 @@ bool KodiXml::saveConcert(Concert* concert)
     }
 
     concert->setNfoContent(xmlContent);
-    Manager::instance()->database()->update(concert);
 
-    bool saved = false;
+    job = mediaelch::SaveJob(concert->title());
+    job.setKey(concert->files().first().toString());
+
     QFileInfo fi(concert->files().first().toString());
     for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::ConcertNfo)) {
         QString saveFileName =
             dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, concert->files().size() > 1);
-        QString saveFilePath = mediaelch::DirectoryPath(fi.absolutePath()).filePath(saveFileName);
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        qCDebug(generic) << "[KodiXml] Saving to" << file.fileName();
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "[KodiXml] File could not be openend";
-        } else {
-            file.write(xmlContent);
-            file.close();
-            saved = true;
-        }
-    }
-    if (!saved) {
-        return false;
+        job.writeNfo(mediaelch::DirectoryPath(fi.absolutePath()).filePath(saveFileName), xmlContent);
     }
 
     for (const auto imageType : Concert::imageTypes()) {
@@ -590,7 +577,7 @@ bool KodiXml::saveConcert(Concert* concert)
                     && (concert->discType() == DiscType::BluRay || concert->discType() == DiscType::Dvd)) {
                     saveFileName = "fanart.jpg";
                 }
-                saveFile(getPath(concert).filePath(saveFileName), concert->image(imageType));
+                job.writeFile(getPath(concert).filePath(saveFileName), concert->image(imageType));
             }
         }
         if (concert->imagesToRemove().contains(imageType)) {
@@ -605,28 +592,23 @@ bool KodiXml::saveConcert(Concert* concert)
                     && (concert->discType() == DiscType::BluRay || concert->discType() == DiscType::Dvd)) {
                     saveFileName = "fanart.jpg";
                 }
-                QFile(getPath(concert).filePath(saveFileName)).remove();
+                job.removeFile(getPath(concert).filePath(saveFileName));
             }
         }
     }
 
     if (concert->inSeparateFolder() && !concert->files().isEmpty()) {
         for (const QString& file : concert->extraFanartsToRemove()) {
-            QFile::remove(file);
-        }
-        QDir dir(QFileInfo(concert->files().first().toString()).absolutePath() + "/extrafanart");
-        if (!dir.exists() && !concert->extraFanartImagesToAdd().isEmpty()) {
-            QDir(QFileInfo(concert->files().first().toString()).absolutePath()).mkdir("extrafanart");
+            job.removeFile(file);
         }
+        const QString dir = fi.absolutePath() + "/extrafanart";
         for (const QByteArray& img : concert->extraFanartImagesToAdd()) {
-            int num = 1;
-            while (QFileInfo(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num)).exists()) {
-                ++num;
-            }
-            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num), img);
+            job.addExtraFanart(dir, img);
         }
     }
 
+    job.addDatabaseUpdate(Database::updateFor(concert));
+
     return true;
 }
 
@@ -755,11 +737,12 @@ bool KodiXml::loadTvShow(TvShow* show, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::TvShowXmlReader reader(*show);
-    reader.parseNfoDom(domDoc);
+    reader.parse(xml);
+    if (xml.hasError()) {
+        qCWarning(generic) << "[KodiXml] Error while parsing TV show NFO:" << xml.errorString();
+    }
 
     return true;
 }
@@ -797,49 +780,11 @@ bool KodiXml::loadTvShowEpisode(TvShowEpisode* episode, QString initialNfoConten
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(mediaelch::kodi::EpisodeXmlReader::makeValidEpisodeXml(nfoContent));
-
-    QDomNodeList episodeDetailsList = domDoc.elementsByTagName("episodedetails");
-    if (episodeDetailsList.isEmpty()) {
-        return false;
-    }
-
-    QDomElement episodeDetails;
-    if (episodeDetailsList.count() > 1) {
-        bool found = false;
-        for (int i = 0, n = episodeDetailsList.count(); i < n; ++i) {
-            episodeDetails = episodeDetailsList.at(i).toElement();
-            if (!episodeDetails.elementsByTagName("season").isEmpty()
-                && episodeDetails.elementsByTagName("season").at(0).toElement().text().toInt()
-                       == episode->seasonNumber().toInt()
-                && !episodeDetails.elementsByTagName("episode").isEmpty()
-                && episodeDetails.elementsByTagName("episode").at(0).toElement().text().toInt()
-                       == episode->episodeNumber().toInt()) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            return false;
-        }
-
-    } else {
-        episodeDetails = episodeDetailsList.at(0).toElement();
-    }
+    episode->streamDetails()->clear();
+    episode->setStreamDetailsLoaded(false);
 
     mediaelch::kodi::EpisodeXmlReader reader(*episode);
-    reader.parseNfoDom(episodeDetails);
-
-    if (episodeDetails.elementsByTagName("streamdetails").count() > 0) {
-        loadStreamDetails(
-            episode->streamDetails(), episodeDetails.elementsByTagName("streamdetails").at(0).toElement());
-        episode->setStreamDetailsLoaded(true);
-    } else {
-        episode->setStreamDetailsLoaded(false);
-    }
-
-    return true;
+    return reader.parseNfo(nfoContent);
 }
 
 /**
@@ -849,6 +794,12 @@ bool KodiXml::loadTvShowEpisode(TvShowEpisode* episode, QString initialNfoConten
  * \see KodiXml::writeTvShowXml
  */
 bool KodiXml::saveTvShow(TvShow* show)
+{
+    mediaelch::SaveJob job;
+    return createSaveJob(show, job) && job.run(*Manager::instance()->database());
+}
+
+bool KodiXml::createSaveJob(TvShow* show, mediaelch::SaveJob& job)
 {
     QByteArray xmlContent = getTvShowXml(show);
 
@@ -857,21 +808,12 @@ bool KodiXml::saveTvShow(TvShow* show)
     }
 
     show->setNfoContent(xmlContent);
-    Manager::instance()->database()->update(show);
+
+    job = mediaelch::SaveJob(show->title());
+    job.setKey(show->dir().toString());
 
     for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::TvShowNfo)) {
-        QString saveFilePath = show->dir().filePath(dataFile.saveFileName(""));
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "[KodiXml] NFO file could not be openend for writing" << file.fileName();
-            return false;
-        }
-        file.write(xmlContent);
-        file.close();
+        job.writeNfo(show->dir().filePath(dataFile.saveFileName("")), xmlContent);
     }
 
     for (const auto imageType : TvShow::imageTypes()) {
@@ -879,13 +821,13 @@ bool KodiXml::saveTvShow(TvShow* show)
         if (show->imageHasChanged(imageType) && !show->image(imageType).isNull()) {
             for (auto dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName("");
-                saveFile(show->dir().filePath(saveFileName), show->image(imageType));
+                job.writeFile(show->dir().filePath(saveFileName), show->image(imageType));
             }
         }
         if (show->imagesToRemove().contains(imageType)) {
             for (auto dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName("");
-                QFile(show->dir().filePath(saveFileName)).remove();
+                job.removeFile(show->dir().filePath(saveFileName));
             }
         }
     }
@@ -896,14 +838,14 @@ bool KodiXml::saveTvShow(TvShow* show)
             if (show->seasonImageHasChanged(season, imageType) && !show->seasonImage(season, imageType).isNull()) {
                 for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                     QString saveFileName = dataFile.saveFileName("", season);
-                    saveFile(show->dir().filePath(saveFileName), show->seasonImage(season, imageType));
+                    job.writeFile(show->dir().filePath(saveFileName), show->seasonImage(season, imageType));
                 }
             }
             if (show->imagesToRemove().contains(imageType)
                 && show->imagesToRemove().value(imageType).contains(season)) {
                 for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                     QString saveFileName = dataFile.saveFileName("", season);
-                    QFile(show->dir().filePath(saveFileName)).remove();
+                    job.removeFile(show->dir().filePath(saveFileName));
                 }
             }
         }
@@ -911,31 +853,23 @@ bool KodiXml::saveTvShow(TvShow* show)
 
     if (show->dir().isValid()) {
         for (const QString& file : show->extraFanartsToRemove()) {
-            QFile::remove(file);
-        }
-        QDir dir(show->dir().toString() + "/extrafanart");
-        if (!dir.exists() && !show->extraFanartImagesToAdd().isEmpty()) {
-            QDir(show->dir().toString()).mkdir("extrafanart");
+            job.removeFile(file);
         }
         for (const QByteArray& img : show->extraFanartImagesToAdd()) {
-            int num = 1;
-            while (QFileInfo(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num)).exists()) {
-                ++num;
-            }
-            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num), img);
+            job.addExtraFanart(show->dir().toString() + "/extrafanart", img);
         }
     }
 
     for (const Actor* actor : show->actors()) {
         if (!actor->image.isNull()) {
-            QDir dir;
-            dir.mkdir(show->dir().toString() + "/" + ".actors");
             QString actorName = actor->name;
             actorName = actorName.replace(" ", "_");
-            saveFile(show->dir().toString() + "/" + ".actors" + "/" + actorName + ".jpg", actor->image);
+            job.writeFile(show->dir().toString() + "/" + ".actors" + "/" + actorName + ".jpg", actor->image);
         }
     }
 
+    job.addDatabaseUpdate(Database::updateFor(show));
+
     return true;
 }
 
@@ -945,6 +879,12 @@ bool KodiXml::saveTvShow(TvShow* show)
  * \return Saving success
  */
 bool KodiXml::saveTvShowEpisode(TvShowEpisode* episode)
+{
+    mediaelch::SaveJob job;
+    return createSaveJob(episode, job) && job.run(*Manager::instance()->database());
+}
+
+bool KodiXml::createSaveJob(TvShowEpisode* episode, mediaelch::SaveJob& job)
 {
     // Multi-Episode handling
     QVector<TvShowEpisode*> episodes;
@@ -962,74 +902,62 @@ bool KodiXml::saveTvShowEpisode(TvShowEpisode* episode)
         return false;
     }
 
+    job = mediaelch::SaveJob(episode->completeEpisodeName());
+    // All episodes of a multi-episode file are saved by the same job.
+    job.setKey(episode->files().first().toString());
+
     const QByteArray xmlContent = getEpisodeXml(episodes);
     for (TvShowEpisode* subEpisode : episodes) {
         subEpisode->setNfoContent(xmlContent);
         subEpisode->setSyncNeeded(true);
         subEpisode->setChanged(false);
-        Manager::instance()->database()->update(subEpisode);
+        job.addDatabaseUpdate(Database::updateFor(subEpisode));
     }
 
     QFileInfo fi(episode->files().first().toString());
     for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::TvShowEpisodeNfo)) {
         QString saveFileName =
             dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, episode->files().count() > 1);
-        QString saveFilePath = fi.absolutePath() + "/" + saveFileName;
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "[KodiXml] NFO file could not be opened for writing" << saveFileName;
-            return false;
-        }
-        file.write(xmlContent);
-        file.close();
+        job.writeNfo(fi.absolutePath() + "/" + saveFileName, xmlContent);
     }
 
-    fi.setFile(episode->files().first().toString());
     if (episode->thumbnailImageChanged() && !episode->thumbnailImage().isNull()) {
         if (helper::isBluRay(episode->files().at(0)) || helper::isDvd(episode->files().first())) {
             QDir dir = fi.dir();
             dir.cdUp();
-            saveFile(dir.absolutePath() + "/thumb.jpg", episode->thumbnailImage());
+            job.writeFile(dir.absolutePath() + "/thumb.jpg", episode->thumbnailImage());
         } else if (helper::isDvd(episode->files().first(), true)) {
-            saveFile(fi.dir().absolutePath() + "/thumb.jpg", episode->thumbnailImage());
+            job.writeFile(fi.dir().absolutePath() + "/thumb.jpg", episode->thumbnailImage());
         } else {
             for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::TvShowEpisodeThumb)) {
                 QString saveFileName =
                     dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, episode->files().count() > 1);
-                saveFile(fi.absolutePath() + "/" + saveFileName, episode->thumbnailImage());
+                job.writeFile(fi.absolutePath() + "/" + saveFileName, episode->thumbnailImage());
             }
         }
     }
 
-    fi.setFile(episode->files().first().toString());
     if (episode->imagesToRemove().contains(ImageType::TvShowEpisodeThumb)) {
         if (helper::isBluRay(episode->files().first()) || helper::isDvd(episode->files().at(0))) {
             QDir dir = fi.dir();
             dir.cdUp();
-            QFile(dir.absolutePath() + "/thumb.jpg").remove();
+            job.removeFile(dir.absolutePath() + "/thumb.jpg");
         } else if (helper::isDvd(episode->files().first(), true)) {
-            QFile(fi.dir().absolutePath() + "/thumb.jpg").remove();
+            job.removeFile(fi.dir().absolutePath() + "/thumb.jpg");
         } else {
             for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::TvShowEpisodeThumb)) {
                 QString saveFileName =
                     dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, episode->files().count() > 1);
-                QFile(fi.absolutePath() + "/" + saveFileName).remove();
+                job.removeFile(fi.absolutePath() + "/" + saveFileName);
             }
         }
     }
 
-    fi.setFile(episode->files().first().toString());
     for (const Actor* actor : episode->actors()) {
         if (!actor->image.isNull()) {
-            QDir dir;
-            dir.mkdir(fi.absolutePath() + "/" + ".actors");
             QString actorName = actor->name;
             actorName = actorName.replace(" ", "_");
-            saveFile(fi.absolutePath() + "/" + ".actors" + "/" + actorName + ".jpg", actor->image);
+            job.writeFile(fi.absolutePath() + "/" + ".actors" + "/" + actorName + ".jpg", actor->image);
         }
     }
 
@@ -1163,22 +1091,6 @@ void KodiXml::saveMovieSetBackdrop(QString setName, QImage backdrop)
     }
 }
 
-bool KodiXml::saveFile(QString filename, QByteArray data)
-{
-    QDir saveFileDir = QFileInfo(filename).dir();
-    if (!saveFileDir.exists()) {
-        saveFileDir.mkpath(".");
-    }
-    QFile file(filename);
-
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(data);
-        file.close();
-        return true;
-    }
-    return false;
-}
-
 mediaelch::DirectoryPath KodiXml::getPath(const Movie* movie)
 {
     if (movie->files().isEmpty()) {
@@ -1462,11 +1374,12 @@ bool KodiXml::loadArtist(Artist* artist, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::ArtistXmlReader reader(*artist);
-    reader.parseNfoDom(domDoc);
+    reader.parse(xml);
+    if (xml.hasError()) {
+        qCWarning(generic) << "[KodiXml] Error while parsing artist NFO:" << xml.errorString();
+    }
 
     return true;
 }
@@ -1501,11 +1414,12 @@ bool KodiXml::loadAlbum(Album* album, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::AlbumXmlReader reader(*album);
-    reader.parseNfoDom(domDoc);
+    reader.parse(xml);
+    if (xml.hasError()) {
+        qCWarning(generic) << "[KodiXml] Error while parsing album NFO:" << xml.errorString();
+    }
 
     return true;
 }
@@ -1570,6 +1484,12 @@ QString KodiXml::nfoFilePath(Album* album)
 }
 
 bool KodiXml::saveArtist(Artist* artist)
+{
+    mediaelch::SaveJob job;
+    return createSaveJob(artist, job) && job.run(*Manager::instance()->database());
+}
+
+bool KodiXml::createSaveJob(Artist* artist, mediaelch::SaveJob& job)
 {
     QByteArray xmlContent = getArtistXml(artist);
 
@@ -1578,26 +1498,16 @@ bool KodiXml::saveArtist(Artist* artist)
     }
 
     artist->setNfoContent(xmlContent);
-    Manager::instance()->database()->update(artist);
 
     QString fileName = nfoFilePath(artist);
     if (fileName.isEmpty()) {
         return false;
     }
 
-    QDir saveFileDir = QFileInfo(fileName).dir();
-    if (!saveFileDir.exists()) {
-        saveFileDir.mkpath(".");
-    }
-    {
-        QFile file(fileName);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "[KodiXml] File could not be openend";
-            return false;
-        }
-        file.write(xmlContent);
-        file.close();
-    }
+    job = mediaelch::SaveJob(artist->name());
+    job.setKey(artist->path().toString());
+    job.writeNfo(fileName, xmlContent);
+
     for (const auto imageType : Artist::imageTypes()) {
         DataFileType dataFileType = DataFile::dataFileTypeForImageType(imageType);
 
@@ -1605,7 +1515,7 @@ bool KodiXml::saveArtist(Artist* artist)
             for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName(QString());
                 if (!saveFileName.isEmpty()) {
-                    QFile(artist->path().filePath(saveFileName)).remove();
+                    job.removeFile(artist->path().filePath(saveFileName));
                 }
             }
         }
@@ -1613,30 +1523,30 @@ bool KodiXml::saveArtist(Artist* artist)
         if (!artist->rawImage(imageType).isNull()) {
             for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName(QString());
-                saveFile(artist->path().filePath(saveFileName), artist->rawImage(imageType));
+                job.writeFile(artist->path().filePath(saveFileName), artist->rawImage(imageType));
             }
         }
     }
 
     for (const QString& file : artist->extraFanartsToRemove()) {
-        QFile::remove(file);
-    }
-    QDir dir(artist->path().subDir("extrafanart").toString());
-    if (!dir.exists() && !artist->extraFanartImagesToAdd().isEmpty()) {
-        QDir(artist->path().toString()).mkdir("extrafanart");
+        job.removeFile(file);
     }
     for (const QByteArray& img : artist->extraFanartImagesToAdd()) {
-        int num = 1;
-        while (QFileInfo(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num)).exists()) {
-            ++num;
-        }
-        saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num), img);
+        job.addExtraFanart(artist->path().subDir("extrafanart").toString(), img);
     }
 
+    job.addDatabaseUpdate(Database::updateFor(artist));
+
     return true;
 }
 
 bool KodiXml::saveAlbum(Album* album)
+{
+    mediaelch::SaveJob job;
+    return createSaveJob(album, job) && job.run(*Manager::instance()->database());
+}
+
+bool KodiXml::createSaveJob(Album* album, mediaelch::SaveJob& job)
 {
     QByteArray xmlContent = getAlbumXml(album);
 
@@ -1645,24 +1555,15 @@ bool KodiXml::saveAlbum(Album* album)
     }
 
     album->setNfoContent(xmlContent);
-    Manager::instance()->database()->update(album);
 
     QString nfoFileName = nfoFilePath(album);
     if (nfoFileName.isEmpty()) {
         return false;
     }
 
-    QDir saveFileDir = QFileInfo(nfoFileName).dir();
-    if (!saveFileDir.exists()) {
-        saveFileDir.mkpath(".");
-    }
-    QFile nfo(nfoFileName);
-    if (!nfo.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qCWarning(generic) << "[KodiXml] File could not be openend";
-        return false;
-    }
-    nfo.write(xmlContent);
-    nfo.close();
+    job = mediaelch::SaveJob(album->title());
+    job.setKey(album->path().toString());
+    job.writeNfo(nfoFileName, xmlContent);
 
     for (const auto imageType : Album::imageTypes()) {
         DataFileType dataFileType = DataFile::dataFileTypeForImageType(imageType);
@@ -1671,7 +1572,7 @@ bool KodiXml::saveAlbum(Album* album)
             for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName(QString());
                 if (!saveFileName.isEmpty()) {
-                    QFile(album->path().filePath(saveFileName)).remove();
+                    job.removeFile(album->path().filePath(saveFileName));
                 }
             }
         }
@@ -1679,21 +1580,16 @@ bool KodiXml::saveAlbum(Album* album)
         if (!album->rawImage(imageType).isNull()) {
             for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName(QString());
-                saveFile(album->path().filePath(saveFileName), album->rawImage(imageType));
+                job.writeFile(album->path().filePath(saveFileName), album->rawImage(imageType));
             }
         }
     }
 
     if (album->bookletModel()->hasChanged()) {
-        QDir dir(album->path().subDir("booklet").toString());
-        if (!dir.exists()) {
-            QDir(album->path().toString()).mkdir("booklet");
-        }
-
         // \todo: get filename from settings
         for (Image* image : album->bookletModel()->images()) {
             if (image->deletion() && !image->fileName().isEmpty()) {
-                QFile::remove(image->fileName());
+                job.removeFile(image->fileName());
             } else if (!image->deletion()) {
                 image->load();
             }
@@ -1702,17 +1598,14 @@ bool KodiXml::saveAlbum(Album* album)
         for (Image* image : album->bookletModel()->images()) {
             if (!image->deletion()) {
                 QString imageFileName = "booklet" + QString("%1").arg(bookletNum, 2, 10, QChar('0')) + ".jpg";
-                QString imageFilePath = album->path().subDir("booklet").filePath(imageFileName);
-                QFile file(imageFilePath);
-                if (file.open(QIODevice::WriteOnly)) {
-                    file.write(image->rawData());
-                    file.close();
-                }
+                job.writeFile(album->path().subDir("booklet").filePath(imageFileName), image->rawData());
                 bookletNum++;
             }
         }
     }
 
+    job.addDatabaseUpdate(Database::updateFor(album));
+
     return true;
 }
 
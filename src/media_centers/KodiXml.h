@@ -7,10 +7,10 @@
 #include "music/Artist.h"
 
 #include <QByteArray>
-#include <QDomDocument>
 #include <QObject>
 #include <QString>
 #include <QVector>
+#include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
 class Movie;
@@ -29,6 +29,7 @@ public:
 
     // movies
     bool saveMovie(Movie* movie) override;
+    bool createSaveJob(Movie* movie, mediaelch::SaveJob& job) override;
     bool loadMovie(Movie* movie, QString initialNfoContent = "") override;
     // movie images (e.g. posters)
     QImage movieSetPoster(QString setName) override;
@@ -38,6 +39,7 @@ public:
 
     // concerts
     bool saveConcert(Concert* concert) override;
+    bool createSaveJob(Concert* concert, mediaelch::SaveJob& job) override;
     bool loadConcert(Concert* concert, QString initialNfoContent = "") override;
     void loadConcertImages(Concert* concert);
 
@@ -46,6 +48,8 @@ public:
     bool loadTvShowEpisode(TvShowEpisode* episode, QString initialNfoContent = "") override;
     bool saveTvShow(TvShow* show) override;
     bool saveTvShowEpisode(TvShowEpisode* episode) override;
+    bool createSaveJob(TvShow* show, mediaelch::SaveJob& job) override;
+    bool createSaveJob(TvShowEpisode* episode, mediaelch::SaveJob& job) override;
 
     // fanart
     QStringList extraFanartNames(Movie* movie) override;
@@ -56,6 +60,8 @@ public:
     // music
     bool saveArtist(Artist* artist) override;
     bool saveAlbum(Album* album) override;
+    bool createSaveJob(Artist* artist, mediaelch::SaveJob& job) override;
+    bool createSaveJob(Album* album, mediaelch::SaveJob& job) override;
     bool loadArtist(Artist* artist, QString initialNfoContent = "") override;
     bool loadAlbum(Album* album, QString initialNfoContent = "") override;
 
@@ -101,6 +107,7 @@ public:
         StreamDetails* streamDetails,
         const QVector<Subtitle*>& subtitles,
         bool hasStreamDetails);
+    static void readStreamDetails(QXmlStreamReader& reader, StreamDetails* streamDetails);
 
     static void writeStringsAsOneTagEach(QXmlStreamWriter& xml, const QString& name, const QStringList& list);
 
@@ -113,9 +120,6 @@ private:
     QByteArray getEpisodeXml(const QVector<TvShowEpisode*>& episodes);
     QByteArray getArtistXml(Artist* artist);
     QByteArray getAlbumXml(Album* album);
-    bool loadStreamDetails(StreamDetails* streamDetails, QDomDocument domDoc);
-    void loadStreamDetails(StreamDetails* streamDetails, QDomElement elem);
-    bool saveFile(QString filename, QByteArray data);
     mediaelch::DirectoryPath getPath(const Movie* movie);
     mediaelch::DirectoryPath getPath(const Concert* concert);
     QString movieSetFileName(QString setName, DataFile* dataFile);
@@ -17,6 +17,10 @@ class Movie;
 class TvShow;
 class TvShowEpisode;
 
+namespace mediaelch {
+class SaveJob;
+}
+
 /// \brief The MediaCenterInterface class
 /// This class is the base for every MediaCenter.
 class MediaCenterInterface : public QObject
@@ -42,6 +46,15 @@ public:
     virtual bool saveTvShow(TvShow* show) = 0;
     virtual bool saveTvShowEpisode(TvShowEpisode* episode) = 0;
 
+    // Saving in another thread: Creates a job with all data that save*() would write.
+    // The job can be run using mediaelch::SaveQueue.  Returns false if the item cannot be saved.
+    virtual bool createSaveJob(Movie* movie, mediaelch::SaveJob& job) = 0;
+    virtual bool createSaveJob(Concert* concert, mediaelch::SaveJob& job) = 0;
+    virtual bool createSaveJob(TvShow* show, mediaelch::SaveJob& job) = 0;
+    virtual bool createSaveJob(TvShowEpisode* episode, mediaelch::SaveJob& job) = 0;
+    virtual bool createSaveJob(Artist* artist, mediaelch::SaveJob& job) = 0;
+    virtual bool createSaveJob(Album* album, mediaelch::SaveJob& job) = 0;
+
     // fanart
     virtual QStringList extraFanartNames(Movie* movie) = 0;
     virtual QStringList extraFanartNames(TvShow* show) = 0;
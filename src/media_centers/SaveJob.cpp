@@ -0,0 +1,190 @@
+#include "media_centers/SaveJob.h"
+
+#include "file/SavedDirectories.h"
+#include "log/Log.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+
+namespace mediaelch {
+
+SaveJob::SaveJob(QString name) : m_name{std::move(name)}
+{
+}
+
+void SaveJob::writeNfo(QString filePath, QByteArray content)
+{
+    m_operations.push_back({Operation::Type::WriteNfo, std::move(filePath), std::move(content)});
+}
+
+void SaveJob::writeFile(QString filePath, QByteArray content)
+{
+    m_operations.push_back({Operation::Type::WriteFile, std::move(filePath), std::move(content)});
+}
+
+void SaveJob::removeFile(QString filePath)
+{
+    m_operations.push_back({Operation::Type::RemoveFile, std::move(filePath), {}});
+}
+
+void SaveJob::addExtraFanart(QString directory, QByteArray image)
+{
+    m_operations.push_back({Operation::Type::AddExtraFanart, std::move(directory), std::move(image)});
+}
+
+void SaveJob::addDatabaseUpdate(Database::Update update)
+{
+    m_databaseUpdates.push_back(std::move(update));
+}
+
+bool SaveJob::run(Database& database) const
+{
+    QVector<FileHash> writtenFiles;
+    int nfoCount = 0;
+    bool nfoSaved = false;
+    for (const Operation& operation : m_operations) {
+        if (operation.type == Operation::Type::WriteNfo) {
+            ++nfoCount;
+            if (writeFileIfChanged(database, operation.path, operation.content, true, writtenFiles)) {
+                nfoSaved = true;
+            } else {
+                qCWarning(generic) << "[SaveJob] NFO file could not be written:" << operation.path;
+            }
+        }
+    }
+    if (nfoCount > 0 && !nfoSaved) {
+        return false;
+    }
+
+    QStringList removedFiles;
+    // Numbers of existing "fanartN.jpg" files, by directory.  Each directory is listed once.
+    QHash<QString, QSet<int>> extraFanartNumbersByDir;
+
+    for (const Operation& operation : m_operations) {
+        switch (operation.type) {
+        case Operation::Type::WriteNfo: break;
+        case Operation::Type::WriteFile:
+            writeFileIfChanged(database, operation.path, operation.content, false, writtenFiles);
+            break;
+        case Operation::Type::RemoveFile:
+            if (QFile::remove(operation.path)) {
+                SavedDirectories::add(operation.path);
+                removedFiles << operation.path;
+            }
+            break;
+        case Operation::Type::AddExtraFanart: {
+            auto numbers = extraFanartNumbersByDir.find(operation.path);
+            if (numbers == extraFanartNumbersByDir.end()) {
+                const QStringList fileNames = QDir(operation.path).entryList({"fanart*.jpg"}, QDir::Files);
+                numbers = extraFanartNumbersByDir.insert(operation.path, extraFanartNumbers(fileNames));
+            }
+            int num = 1;
+            while (numbers->contains(num)) {
+                ++num;
+            }
+            numbers->insert(num);
+            writeFileAtomically(operation.path + "/" + QString("fanart%1.jpg").arg(num), operation.content);
+            break;
+        }
+        }
+    }
+
+    if (!writtenFiles.isEmpty() || !removedFiles.isEmpty() || !m_databaseUpdates.isEmpty()) {
+        database.transaction();
+        for (const FileHash& file : writtenFiles) {
+            database.setFileHash(file.path, file.size, file.lastModified, file.hash);
+        }
+        for (const QString& file : removedFiles) {
+            database.removeFileHash(file);
+        }
+        for (const Database::Update& update : m_databaseUpdates) {
+            update(database);
+        }
+        database.commit();
+    }
+    return true;
+}
+
+bool SaveJob::writeFileIfChanged(Database& database,
+    const QString& filePath,
+    const QByteArray& content,
+    bool isText,
+    QVector<FileHash>& writtenFiles)
+{
+    const QByteArray hash = QCryptographicHash::hash(content, QCryptographicHash::Sha1);
+
+    QFileInfo existing(filePath);
+    if (existing.isFile()) {
+        const qint64 lastModified = existing.lastModified().toMSecsSinceEpoch();
+        bool unchanged = (database.fileHash(filePath, existing.size(), lastModified) == hash);
+        if (!unchanged && existing.size() == content.size()) {
+            // Not written by MediaElch or modified since; compare the content once.
+            QFile file(filePath);
+            const QIODevice::OpenMode mode = isText ? (QIODevice::ReadOnly | QIODevice::Text) : QIODevice::ReadOnly;
+            unchanged = file.open(mode) && file.readAll() == content;
+            if (unchanged) {
+                writtenFiles.push_back({filePath, existing.size(), lastModified, hash});
+            }
+        }
+        if (unchanged) {
+            qCDebug(generic) << "[SaveJob] File is unchanged, skip writing:" << filePath;
+            return true;
+        }
+    }
+
+    qCDebug(generic) << "[SaveJob] Writing" << filePath;
+    if (!writeFileAtomically(filePath, content, isText)) {
+        return false;
+    }
+    const QFileInfo written(filePath);
+    writtenFiles.push_back({filePath, written.size(), written.lastModified().toMSecsSinceEpoch(), hash});
+    return true;
+}
+
+bool SaveJob::writeFileAtomically(const QString& filePath, const QByteArray& content, bool isText)
+{
+    QDir saveFileDir = QFileInfo(filePath).dir();
+    if (!saveFileDir.exists() && saveFileDir.mkpath(".")) {
+        SavedDirectories::add(saveFileDir.absolutePath());
+    }
+
+    QSaveFile file(filePath);
+    // Some network shares do not allow creating the temporary file.
+    file.setDirectWriteFallback(true);
+    const QIODevice::OpenMode mode = isText ? (QIODevice::WriteOnly | QIODevice::Text) : QIODevice::WriteOnly;
+    if (!file.open(mode)) {
+        qCWarning(generic) << "[SaveJob] File could not be opened for writing:" << filePath << file.errorString();
+        return false;
+    }
+    file.write(content);
+    if (!file.commit()) {
+        return false;
+    }
+    // Do not reload the item because of its own changes, see LibraryWatcher.
+    SavedDirectories::add(filePath);
+    return true;
+}
+
+QSet<int> SaveJob::extraFanartNumbers(const QStringList& fileNames)
+{
+    QSet<int> numbers;
+    for (const QString& fileName : fileNames) {
+        // "fanart" + N + ".jpg"
+        if (!fileName.startsWith("fanart", Qt::CaseInsensitive) || !fileName.endsWith(".jpg", Qt::CaseInsensitive)) {
+            continue;
+        }
+        bool ok = false;
+        const int num = fileName.mid(6, fileName.length() - 10).toInt(&ok);
+        if (ok && num > 0) {
+            numbers.insert(num);
+        }
+    }
+    return numbers;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "data/Database.h"
+
+#include <QByteArray>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace mediaelch {
+
+/// \brief   File system operations and a database update that save a single item.
+/// \details Jobs are created by MediaCenterInterface in the GUI thread, which copies
+///          all data that is required.  They do not access any Movie, TvShow, etc.
+///          objects and can therefore be run in another thread, see SaveQueue.
+///
+///          Files are written atomically, i.e. to a temporary file that is renamed
+///          once it is complete.  NFO files are written first, all other operations
+///          are run in the order they were added.
+///
+///          Files whose content did not change are not written again: The hash of
+///          each written file is stored in the database together with the file's
+///          size and modification time.  This avoids waking up disks of NAS storage.
+class SaveJob
+{
+public:
+    SaveJob() = default;
+    explicit SaveJob(QString name);
+
+    /// \brief Name used in log messages, e.g. the title of the movie.
+    const QString& name() const { return m_name; }
+    /// \brief   Jobs with the same key are never run at the same time.
+    /// \details Defaults to the name.  Should be the item's directory or main file.
+    const QString& key() const { return m_key.isEmpty() ? m_name : m_key; }
+    void setKey(QString key) { m_key = std::move(key); }
+
+    /// \brief   Writes an NFO file.
+    /// \details If none of the job's NFO files can be written, the job fails and no
+    ///          other operations are run.
+    void writeNfo(QString filePath, QByteArray content);
+    void writeFile(QString filePath, QByteArray content);
+    void removeFile(QString filePath);
+    /// \brief Saves the image as the next unused "fanartN.jpg" in the given directory.
+    void addExtraFanart(QString directory, QByteArray image);
+    /// \brief Database update that is run after all files were written.
+    void addDatabaseUpdate(Database::Update update);
+
+    bool isEmpty() const { return m_operations.isEmpty() && m_databaseUpdates.isEmpty(); }
+
+    /// \brief   Runs all operations.
+    /// \details database must be a connection of the calling thread.
+    /// \return  False if no NFO file could be written.
+    bool run(Database& database) const;
+
+    /// \brief Writes the file using a temporary file. Creates the parent directory if required.
+    /// \param isText Whether line endings are converted, see QIODevice::Text.
+    static bool writeFileAtomically(const QString& filePath, const QByteArray& content, bool isText = false);
+
+    /// \brief Numbers N of all "fanartN.jpg" files in the given list of file names.
+    static QSet<int> extraFanartNumbers(const QStringList& fileNames);
+
+private:
+    struct Operation
+    {
+        enum class Type
+        {
+            WriteNfo,
+            WriteFile,
+            RemoveFile,
+            AddExtraFanart
+        };
+        Type type;
+        QString path;
+        QByteArray content;
+    };
+
+    struct FileHash
+    {
+        QString path;
+        qint64 size;
+        qint64 lastModified;
+        QByteArray hash;
+    };
+
+    /// \brief Writes the file unless it already has the given content.
+    /// \param writtenFiles Hashes of written files; stored in the database by run().
+    static bool writeFileIfChanged(Database& database,
+        const QString& filePath,
+        const QByteArray& content,
+        bool isText,
+        QVector<FileHash>& writtenFiles);
+
+    QString m_name;
+    QString m_key;
+    QVector<Operation> m_operations;
+    QVector<Database::Update> m_databaseUpdates;
+};
+
+} // namespace mediaelch
@@ -0,0 +1,107 @@
+#include "media_centers/SaveQueue.h"
+
+#include "log/Log.h"
+
+#include <QFutureWatcher>
+#include <QThread>
+#include <QThreadStorage>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+/// \brief Saving is mostly limited by the disk; more threads do not help.
+constexpr int MAX_SAVE_THREADS = 4;
+
+/// \brief Database connection of the calling thread. Deleted when the thread exits.
+Database& threadDatabase()
+{
+    static QThreadStorage<Database*> s_connections;
+    if (!s_connections.hasLocalData()) {
+        s_connections.setLocalData(Database::newConnection(nullptr));
+    }
+    return *s_connections.localData();
+}
+
+} // namespace
+
+namespace mediaelch {
+
+SaveQueue::SaveQueue(QObject* parent) : QObject(parent)
+{
+    m_threadPool.setMaxThreadCount(std::max(1, std::min(QThread::idealThreadCount(), MAX_SAVE_THREADS)));
+    // Keep the threads and with them their database connections.
+    m_threadPool.setExpiryTimeout(-1);
+}
+
+SaveQueue::~SaveQueue()
+{
+    m_threadPool.waitForDone();
+    // The event loop may not run anymore; finish pending jobs in this thread.
+    for (const PendingJob& pendingJob : m_pendingJobs) {
+        if (!pendingJob.job.run(threadDatabase())) {
+            qCWarning(generic) << "[SaveQueue] Could not save" << pendingJob.job.name();
+        }
+    }
+}
+
+int SaveQueue::enqueue(SaveJob job)
+{
+    const int jobId = ++m_lastJobId;
+    m_pendingJobs.push_back({jobId, std::move(job)});
+    startJobs();
+    return jobId;
+}
+
+int SaveQueue::jobCount() const
+{
+    return static_cast<int>(m_pendingJobs.size()) + m_runningKeys.size();
+}
+
+void SaveQueue::startJobs()
+{
+    auto it = m_pendingJobs.begin();
+    while (it != m_pendingJobs.end() && m_runningKeys.size() < m_threadPool.maxThreadCount()) {
+        if (m_runningKeys.contains(it->job.key())) {
+            // Keep the order of jobs that save the same item.
+            ++it;
+            continue;
+        }
+        PendingJob pendingJob = std::move(*it);
+        it = m_pendingJobs.erase(it);
+        startJob(std::move(pendingJob));
+    }
+}
+
+void SaveQueue::startJob(PendingJob pendingJob)
+{
+    const int jobId = pendingJob.id;
+    const QString key = pendingJob.job.key();
+    m_runningKeys.insert(key);
+
+    auto* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, jobId, key]() {
+        onJobFinished(jobId, key, watcher->result());
+        watcher->deleteLater();
+    });
+    SaveJob job = std::move(pendingJob.job);
+    watcher->setFuture(QtConcurrent::run(&m_threadPool, [job]() {
+        const bool success = job.run(threadDatabase());
+        if (!success) {
+            qCWarning(generic) << "[SaveQueue] Could not save" << job.name();
+        }
+        return success;
+    }));
+}
+
+void SaveQueue::onJobFinished(int jobId, const QString& key, bool success)
+{
+    m_runningKeys.remove(key);
+    emit sigJobFinished(jobId, success);
+    startJobs();
+    if (isIdle()) {
+        emit sigAllJobsFinished();
+    }
+}
+
+} // namespace mediaelch
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "media_centers/SaveJob.h"
+
+#include <QObject>
+#include <QSet>
+#include <QThreadPool>
+#include <deque>
+
+namespace mediaelch {
+
+/// \brief   Runs SaveJobs in worker threads.
+/// \details Each worker thread uses its own database connection.  Jobs with the same
+///          key are run one after another in the order they were enqueued, all other
+///          jobs may run in parallel.  sigJobFinished() is emitted for each job in the
+///          thread of the queue.  Pending jobs are finished before the queue is destroyed.
+class SaveQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SaveQueue(QObject* parent = nullptr);
+    ~SaveQueue() override;
+
+    /// \brief Enqueues the job and returns its ID that is passed to sigJobFinished().
+    int enqueue(SaveJob job);
+    /// \brief Number of jobs that are either pending or running.
+    int jobCount() const;
+    bool isIdle() const { return jobCount() == 0; }
+
+signals:
+    void sigJobFinished(int jobId, bool success);
+    void sigAllJobsFinished();
+
+private:
+    struct PendingJob
+    {
+        int id;
+        SaveJob job;
+    };
+
+    void startJobs();
+    void startJob(PendingJob pendingJob);
+    void onJobFinished(int jobId, const QString& key, bool success);
+
+    QThreadPool m_threadPool;
+    std::deque<PendingJob> m_pendingJobs;
+    QSet<QString> m_runningKeys;
+    int m_lastJobId = 0;
+};
+
+} // namespace mediaelch
@@ -5,6 +5,9 @@
 #include "music/AllMusicId.h"
 #include "music/MusicBrainzId.h"
 
+#include <QStringList>
+#include <QUrl>
+
 namespace mediaelch {
 namespace kodi {
 
@@ -12,80 +15,106 @@ AlbumXmlReader::AlbumXmlReader(Album& album) : m_album{album}
 {
 }
 
-void AlbumXmlReader::parseNfoDom(QDomDocument domDoc)
+void AlbumXmlReader::parse(QXmlStreamReader& reader)
 {
-    // v16 CamelCase tag
-    if (!domDoc.elementsByTagName("musicBrainzReleaseGroupID").isEmpty()) {
-        m_album.setMbReleaseGroupId(
-            MusicBrainzId(domDoc.elementsByTagName("musicBrainzReleaseGroupID").at(0).toElement().text()));
-    }
-    // v17 lowercase tag
-    if (!domDoc.elementsByTagName("musicbrainzreleasegroupid").isEmpty()) {
-        m_album.setMbReleaseGroupId(
-            MusicBrainzId(domDoc.elementsByTagName("musicbrainzreleasegroupid").at(0).toElement().text()));
+    if (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("album")) {
+            parseAlbum(reader);
+        } else {
+            reader.raiseError(QObject::tr("No valid album root entry found"));
+        }
     }
 
-    // v16 CamelCase tag
-    if (!domDoc.elementsByTagName("musicBrainzAlbumID").isEmpty()) {
-        m_album.setMbAlbumId(MusicBrainzId(domDoc.elementsByTagName("musicBrainzAlbumID").at(0).toElement().text()));
-    }
-    // v17 lowercase tag
-    if (!domDoc.elementsByTagName("musicbrainzalbumid").isEmpty()) {
-        m_album.setMbAlbumId(MusicBrainzId(domDoc.elementsByTagName("musicbrainzalbumid").at(0).toElement().text()));
-    }
+    m_album.setHasChanged(false);
+}
 
-    if (!domDoc.elementsByTagName("allmusicid").isEmpty()) {
-        m_album.setAllMusicId(AllMusicId(domDoc.elementsByTagName("allmusicid").at(0).toElement().text()));
-    }
-    if (!domDoc.elementsByTagName("title").isEmpty()) {
-        m_album.setTitle(domDoc.elementsByTagName("title").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("artist").isEmpty()) {
-        m_album.setArtist(domDoc.elementsByTagName("artist").at(0).toElement().text());
-    }
-    {
-        QDomNodeList genreElements = domDoc.elementsByTagName("genre");
-        QStringList genres;
-        for (int i = 0, n = genreElements.size(); i < n; i++) {
-            genres << genreElements.at(i).toElement().text().split(" / ", ElchSplitBehavior::SkipEmptyParts);
-        }
-        if (!genres.isEmpty()) {
-            m_album.setGenres(genres);
+void AlbumXmlReader::parseAlbum(QXmlStreamReader& reader)
+{
+    QStringList genres;
+    bool hasArtist = false;
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("musicBrainzReleaseGroupID")
+            || reader.name() == QLatin1String("musicbrainzreleasegroupid")) {
+            // v16 CamelCase tag and v17 lowercase tag
+            m_album.setMbReleaseGroupId(MusicBrainzId(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("musicBrainzAlbumID")
+                   || reader.name() == QLatin1String("musicbrainzalbumid")) {
+            // v16 CamelCase tag and v17 lowercase tag
+            m_album.setMbAlbumId(MusicBrainzId(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("allmusicid")) {
+            m_album.setAllMusicId(AllMusicId(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("title")) {
+            m_album.setTitle(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("artist") && !hasArtist) {
+            m_album.setArtist(reader.readElementText());
+            hasArtist = true;
+
+        } else if (reader.name() == QLatin1String("albumArtistCredits")) {
+            // Kodi v17+ only stores the artist in here.
+            parseArtistCredits(reader, hasArtist);
+
+        } else if (reader.name() == QLatin1String("genre")) {
+            genres << reader.readElementText().split(" / ", ElchSplitBehavior::SkipEmptyParts);
+
+        } else if (reader.name() == QLatin1String("style")) {
+            m_album.addStyle(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("mood")) {
+            m_album.addMood(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("review")) {
+            m_album.setReview(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("label")) {
+            m_album.setLabel(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("releasedate")) {
+            m_album.setReleaseDate(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("year")) {
+            m_album.setYear(reader.readElementText().toInt());
+
+        } else if (reader.name() == QLatin1String("rating")) {
+            m_album.setRating(reader.readElementText().replace(",", ".").toDouble());
+
+        } else if (reader.name() == QLatin1String("thumb")) {
+            parseThumb(reader);
+
+        } else {
+            reader.skipCurrentElement();
         }
     }
-    for (int i = 0, n = domDoc.elementsByTagName("style").size(); i < n; i++) {
-        m_album.addStyle(domDoc.elementsByTagName("style").at(i).toElement().text());
-    }
-    for (int i = 0, n = domDoc.elementsByTagName("mood").size(); i < n; i++) {
-        m_album.addMood(domDoc.elementsByTagName("mood").at(i).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("review").isEmpty()) {
-        m_album.setReview(domDoc.elementsByTagName("review").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("label").isEmpty()) {
-        m_album.setLabel(domDoc.elementsByTagName("label").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("releasedate").isEmpty()) {
-        m_album.setReleaseDate(domDoc.elementsByTagName("releasedate").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("year").isEmpty()) {
-        m_album.setYear(domDoc.elementsByTagName("year").at(0).toElement().text().toInt());
-    }
-    if (!domDoc.elementsByTagName("rating").isEmpty()) {
-        m_album.setRating(domDoc.elementsByTagName("rating").at(0).toElement().text().replace(",", ".").toDouble());
+
+    if (!genres.isEmpty()) {
+        m_album.setGenres(genres);
     }
-    for (int i = 0, n = domDoc.elementsByTagName("thumb").size(); i < n; i++) {
-        Poster p;
-        p.originalUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().text());
-        if (!domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview").isEmpty()) {
-            p.thumbUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview"));
+}
+
+void AlbumXmlReader::parseArtistCredits(QXmlStreamReader& reader, bool& hasArtist)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("artist") && !hasArtist) {
+            m_album.setArtist(reader.readElementText());
+            hasArtist = true;
         } else {
-            p.thumbUrl = p.originalUrl;
+            reader.skipCurrentElement();
         }
-        m_album.addImage(ImageType::AlbumThumb, p);
     }
+}
 
-    m_album.setHasChanged(false);
+void AlbumXmlReader::parseThumb(QXmlStreamReader& reader)
+{
+    const QString preview = reader.attributes().value("preview").toString();
+
+    Poster p;
+    p.originalUrl = QUrl(reader.readElementText());
+    p.thumbUrl = preview.isEmpty() ? p.originalUrl : QUrl(preview);
+    m_album.addImage(ImageType::AlbumThumb, p);
 }
 
 } // namespace kodi
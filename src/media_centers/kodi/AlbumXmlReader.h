@@ -1,6 +1,6 @@
 #pragma once
 
-#include <QDomElement>
+#include <QXmlStreamReader>
 
 class Album;
 
@@ -11,9 +11,13 @@ class AlbumXmlReader
 {
 public:
     explicit AlbumXmlReader(Album& album);
-    void parseNfoDom(QDomDocument domDoc);
+    void parse(QXmlStreamReader& reader);
 
 private:
+    void parseAlbum(QXmlStreamReader& reader);
+    void parseArtistCredits(QXmlStreamReader& reader, bool& hasArtist);
+    void parseThumb(QXmlStreamReader& reader);
+
     Album& m_album;
 };
 
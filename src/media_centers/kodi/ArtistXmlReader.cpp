@@ -3,10 +3,7 @@
 #include "globals/Globals.h"
 #include "music/Artist.h"
 
-#include <QDate>
-#include <QDomElement>
-#include <QFileInfo>
-#include <QTime>
+#include <QStringList>
 #include <QUrl>
 
 namespace mediaelch {
@@ -16,85 +13,114 @@ ArtistXmlReader::ArtistXmlReader(Artist& artist) : m_artist{artist}
 {
 }
 
-void ArtistXmlReader::parseNfoDom(QDomDocument domDoc)
+void ArtistXmlReader::parse(QXmlStreamReader& reader)
 {
-    if (!domDoc.elementsByTagName("musicBrainzArtistID").isEmpty()) {
-        m_artist.setMbId(MusicBrainzId(domDoc.elementsByTagName("musicBrainzArtistID").at(0).toElement().text()));
-    }
-    if (!domDoc.elementsByTagName("allmusicid").isEmpty()) {
-        m_artist.setAllMusicId(AllMusicId(domDoc.elementsByTagName("allmusicid").at(0).toElement().text()));
-    }
-    if (!domDoc.elementsByTagName("name").isEmpty()) {
-        m_artist.setName(domDoc.elementsByTagName("name").at(0).toElement().text());
-    }
-    {
-        QDomNodeList genreElements = domDoc.elementsByTagName("genre");
-        QStringList genres;
-        for (int i = 0, n = genreElements.size(); i < n; i++) {
-            genres << genreElements.at(i).toElement().text().split(" / ", ElchSplitBehavior::SkipEmptyParts);
+    if (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("artist")) {
+            parseArtist(reader);
+        } else {
+            reader.raiseError(QObject::tr("No valid artist root entry found"));
         }
-        if (!genres.isEmpty()) {
-            m_artist.setGenres(genres);
-        }
-    }
-    for (int i = 0, n = domDoc.elementsByTagName("style").size(); i < n; i++) {
-        m_artist.addStyle(domDoc.elementsByTagName("style").at(i).toElement().text());
-    }
-    for (int i = 0, n = domDoc.elementsByTagName("mood").size(); i < n; i++) {
-        m_artist.addMood(domDoc.elementsByTagName("mood").at(i).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("yearsactive").isEmpty()) {
-        m_artist.setYearsActive(domDoc.elementsByTagName("yearsactive").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("formed").isEmpty()) {
-        m_artist.setFormed(domDoc.elementsByTagName("formed").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("biography").isEmpty()) {
-        m_artist.setBiography(domDoc.elementsByTagName("biography").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("born").isEmpty()) {
-        m_artist.setBorn(domDoc.elementsByTagName("born").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("died").isEmpty()) {
-        m_artist.setDied(domDoc.elementsByTagName("died").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("disbanded").isEmpty()) {
-        m_artist.setDisbanded(domDoc.elementsByTagName("disbanded").at(0).toElement().text());
     }
 
-    QDomNodeList thumbElements = domDoc.elementsByTagName("thumb");
-    for (int i = 0, n = thumbElements.size(); i < n; i++) {
-        QString parentTag = thumbElements.at(i).parentNode().toElement().tagName();
-        QDomElement thumb = thumbElements.at(i).toElement();
+    m_artist.setHasChanged(false);
+}
+
+void ArtistXmlReader::parseArtist(QXmlStreamReader& reader)
+{
+    QStringList genres;
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("musicBrainzArtistID")) {
+            m_artist.setMbId(MusicBrainzId(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("allmusicid")) {
+            m_artist.setAllMusicId(AllMusicId(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("name")) {
+            m_artist.setName(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("genre")) {
+            genres << reader.readElementText().split(" / ", ElchSplitBehavior::SkipEmptyParts);
+
+        } else if (reader.name() == QLatin1String("style")) {
+            m_artist.addStyle(reader.readElementText());
 
-        Poster p;
-        p.originalUrl = thumb.text();
-        p.thumbUrl = thumb.attribute("preview").trimmed().isEmpty() ? p.originalUrl : thumb.attribute("preview");
-        p.aspect = thumb.attribute("aspect").trimmed();
+        } else if (reader.name() == QLatin1String("mood")) {
+            m_artist.addMood(reader.readElementText());
 
-        if (parentTag == "artist") {
-            m_artist.addImage(ImageType::ArtistThumb, p);
+        } else if (reader.name() == QLatin1String("yearsactive")) {
+            m_artist.setYearsActive(reader.readElementText());
 
-        } else if (parentTag == "fanart") {
-            m_artist.addImage(ImageType::ArtistFanart, p);
+        } else if (reader.name() == QLatin1String("formed")) {
+            m_artist.setFormed(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("biography")) {
+            m_artist.setBiography(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("born")) {
+            m_artist.setBorn(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("died")) {
+            m_artist.setDied(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("disbanded")) {
+            m_artist.setDisbanded(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("thumb")) {
+            parseImage(reader, ImageType::ArtistThumb);
+
+        } else if (reader.name() == QLatin1String("fanart")) {
+            parseFanart(reader);
+
+        } else if (reader.name() == QLatin1String("album")) {
+            parseDiscographyAlbum(reader);
+
+        } else {
+            reader.skipCurrentElement();
         }
     }
 
-    QDomNodeList albumElements = domDoc.elementsByTagName("album");
-    for (int i = 0, n = albumElements.size(); i < n; i++) {
-        QDomElement album = albumElements.at(i).toElement();
+    if (!genres.isEmpty()) {
+        m_artist.setGenres(genres);
+    }
+}
 
-        DiscographyAlbum a;
-        if (!album.elementsByTagName("title").isEmpty()) {
-            a.title = album.elementsByTagName("title").at(0).toElement().text();
-        }
-        if (!album.elementsByTagName("year").isEmpty()) {
-            a.year = album.elementsByTagName("year").at(0).toElement().text();
+void ArtistXmlReader::parseImage(QXmlStreamReader& reader, ImageType type)
+{
+    const QString preview = reader.attributes().value("preview").toString();
+
+    Poster p;
+    p.aspect = reader.attributes().value("aspect").toString().trimmed();
+    p.originalUrl = reader.readElementText();
+    p.thumbUrl = preview.trimmed().isEmpty() ? p.originalUrl : preview;
+    m_artist.addImage(type, p);
+}
+
+void ArtistXmlReader::parseFanart(QXmlStreamReader& reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("thumb")) {
+            parseImage(reader, ImageType::ArtistFanart);
+        } else {
+            reader.skipCurrentElement();
         }
-        m_artist.addDiscographyAlbum(a);
     }
+}
 
-    m_artist.setHasChanged(false);
+void ArtistXmlReader::parseDiscographyAlbum(QXmlStreamReader& reader)
+{
+    DiscographyAlbum a;
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("title")) {
+            a.title = reader.readElementText();
+        } else if (reader.name() == QLatin1String("year")) {
+            a.year = reader.readElementText();
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+    m_artist.addDiscographyAlbum(a);
 }
 
 } // namespace kodi
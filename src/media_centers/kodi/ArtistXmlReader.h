@@ -1,6 +1,8 @@
 #pragma once
 
-#include <QDomElement>
+#include "globals/Globals.h"
+
+#include <QXmlStreamReader>
 
 class Artist;
 
@@ -11,9 +13,14 @@ class ArtistXmlReader
 {
 public:
     explicit ArtistXmlReader(Artist& artist);
-    void parseNfoDom(QDomDocument domDoc);
+    void parse(QXmlStreamReader& reader);
 
 private:
+    void parseArtist(QXmlStreamReader& reader);
+    void parseImage(QXmlStreamReader& reader, ImageType type);
+    void parseFanart(QXmlStreamReader& reader);
+    void parseDiscographyAlbum(QXmlStreamReader& reader);
+
     Artist& m_artist;
 };
 
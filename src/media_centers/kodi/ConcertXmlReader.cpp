@@ -4,8 +4,6 @@
 #include "data/StreamDetails.h"
 
 #include <QDate>
-#include <QDomDocument>
-#include <QDomNodeList>
 #include <QStringList>
 #include <QUrl>
 #include <array>
@@ -2,13 +2,14 @@
 
 #include "globals/Globals.h"
 #include "log/Log.h"
+#include "media_centers/KodiXml.h"
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QDate>
-#include <QDomElement>
-#include <QFileInfo>
+#include <QPair>
 #include <QTime>
 #include <QUrl>
+#include <QVector>
 
 namespace mediaelch {
 namespace kodi {
@@ -17,207 +18,317 @@ EpisodeXmlReader::EpisodeXmlReader(TvShowEpisode& episode) : m_episode{episode}
 {
 }
 
-void EpisodeXmlReader::parseNfoDom(QDomElement episodeDetails)
+void EpisodeXmlReader::parse(QXmlStreamReader& reader)
 {
-    // v17/v18 TvDbId
-    if (!episodeDetails.elementsByTagName("id").isEmpty()) {
-        m_episode.setTvdbId(TvDbId(episodeDetails.elementsByTagName("id").at(0).toElement().text()));
+    if (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("episodedetails")) {
+            parseEpisodeDetails(reader);
+        } else {
+            reader.raiseError(QObject::tr("No valid episodedetails root entry found"));
+        }
     }
+}
 
-    // v16 TvDbId/ImdbId
-    if (!episodeDetails.elementsByTagName("tvdbid").isEmpty()) {
-        QString value = episodeDetails.elementsByTagName("tvdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_episode.setTvdbId(TvDbId(value));
-        }
+bool EpisodeXmlReader::parseNfo(const QString& nfoContent)
+{
+    const QString episodeXml = makeValidEpisodeXml(nfoContent);
+    const int index = indexOfEpisodeDetails(episodeXml, m_episode.seasonNumber(), m_episode.episodeNumber());
+    if (index < 0) {
+        return false;
     }
-    if (!episodeDetails.elementsByTagName("imdbid").isEmpty()) {
-        QString value = episodeDetails.elementsByTagName("imdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_episode.setImdbId(ImdbId(value));
+
+    QXmlStreamReader reader(episodeXml);
+    for (int currentIndex = 0; readNextEpisodeDetails(reader); ++currentIndex) {
+        if (currentIndex == index) {
+            parseEpisodeDetails(reader);
+            break;
         }
+        reader.skipCurrentElement();
     }
 
-    // v17 ids
-    auto uniqueIds = episodeDetails.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
+    if (reader.hasError()) {
+        qCWarning(generic) << "[EpisodeXmlReader] Error while parsing NFO:" << reader.errorString();
+    }
+    return true;
+}
 
-        if (value.isEmpty()) {
-            // Silently skip empty values; we wouldn't get any benefit from them
-            continue;
+int EpisodeXmlReader::indexOfEpisodeDetails(const QString& episodeXml, SeasonNumber season, EpisodeNumber episode)
+{
+    // Only <season> and <episode> are read; all other elements are skipped.
+    QXmlStreamReader reader(episodeXml);
+    int count = 0;
+    while (readNextEpisodeDetails(reader)) {
+        bool hasSeason = false;
+        bool hasEpisode = false;
+        bool matches = true;
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("season") && !hasSeason) {
+                hasSeason = true;
+                matches = matches && reader.readElementText().toInt() == season.toInt();
+            } else if (reader.name() == QLatin1String("episode") && !hasEpisode) {
+                hasEpisode = true;
+                matches = matches && reader.readElementText().toInt() == episode.toInt();
+            } else {
+                reader.skipCurrentElement();
+            }
         }
 
-        if (type == "imdb") {
-            m_episode.setImdbId(ImdbId(value));
-        } else if (type == "tvdb") {
-            m_episode.setTvdbId(TvDbId(value));
-        } else if (type == "tmdb") {
-            m_episode.setTmdbId(TmdbId(value));
-        } else if (type == "tvmaze") {
-            m_episode.setTvMazeId(TvMazeId(value));
-        } else {
-            qCWarning(generic) << "[EpisodeXmlReader] Unsupported unique id type:" << type << "with value" << value;
+        if (hasSeason && hasEpisode && matches) {
+            return count;
         }
+        ++count;
     }
 
-    if (!episodeDetails.elementsByTagName("title").isEmpty()) {
-        m_episode.setTitle(episodeDetails.elementsByTagName("title").at(0).toElement().text());
-    }
-    if (!episodeDetails.elementsByTagName("showtitle").isEmpty()) {
-        m_episode.setShowTitle(episodeDetails.elementsByTagName("showtitle").at(0).toElement().text());
-    }
-    if (!episodeDetails.elementsByTagName("season").isEmpty()) {
-        m_episode.setSeason(SeasonNumber(episodeDetails.elementsByTagName("season").at(0).toElement().text().toInt()));
-    }
-    if (!episodeDetails.elementsByTagName("episode").isEmpty()) {
-        m_episode.setEpisode(
-            EpisodeNumber(episodeDetails.elementsByTagName("episode").at(0).toElement().text().toInt()));
-    }
-    if (!episodeDetails.elementsByTagName("displayseason").isEmpty()) {
-        m_episode.setDisplaySeason(
-            SeasonNumber(episodeDetails.elementsByTagName("displayseason").at(0).toElement().text().toInt()));
-    }
-    if (!episodeDetails.elementsByTagName("displayepisode").isEmpty()) {
-        m_episode.setDisplayEpisode(
-            EpisodeNumber(episodeDetails.elementsByTagName("displayepisode").at(0).toElement().text().toInt()));
-    }
+    // Single-episode files are always used, even if their episode number differs.
+    return count == 1 ? 0 : -1;
+}
 
-    // check for new ratings syntax
-    if (!episodeDetails.elementsByTagName("ratings").isEmpty()) {
-        // <ratings>
-        //   <rating name="default" default="true">
-        //     <value>10</value>
-        //     <votes>10</votes>
-        //   </rating>
-        // </ratings>
-        auto ratings = episodeDetails.elementsByTagName("ratings").at(0).toElement().elementsByTagName("rating");
-        m_episode.ratings().clear();
+void EpisodeXmlReader::parseEpisodeDetails(QXmlStreamReader& reader)
+{
+    // IDs and v16 ratings depend on other tags and are applied after all tags were read.
+    QString id;
+    QString tvdbId;
+    QString imdbId;
+    QVector<QPair<QString, QString>> uniqueIds;
+    bool hasRatings = false;
+    QString ratingV16;
+    QString votesV16;
 
-        for (int i = 0; i < ratings.length(); ++i) {
-            Rating rating;
-            auto ratingElement = ratings.at(i).toElement();
-            rating.source = ratingElement.attribute("name", "default");
-            bool ok = false;
-            const int max = ratingElement.attribute("max", "0").toInt(&ok);
-            if (ok && max > 0) {
-                rating.maxRating = max;
-            }
-            rating.rating =
-                ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-            rating.voteCount = ratingElement.elementsByTagName("votes")
-                                   .at(0)
-                                   .toElement()
-                                   .text()
-                                   .replace(",", "")
-                                   .replace(".", "")
-                                   .toInt();
-            m_episode.ratings().setOrAddRating(rating);
-            m_episode.setChanged(true);
-        }
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("id")) {
+            // v17/v18 TvDbId
+            id = reader.readElementText();
 
-    } else if (!episodeDetails.elementsByTagName("rating").isEmpty()) {
-        // otherwise use "old" syntax:
-        // <rating>10.0</rating>
-        // <votes>10.0</votes>
-        QString value = episodeDetails.elementsByTagName("rating").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            Rating rating;
-            rating.rating = value.replace(",", ".").toDouble();
-            if (!episodeDetails.elementsByTagName("votes").isEmpty()) {
-                rating.voteCount = episodeDetails.elementsByTagName("votes")
-                                       .at(0)
-                                       .toElement()
-                                       .text()
-                                       .replace(",", "")
-                                       .replace(".", "")
-                                       .toInt();
-            }
-            // Note: We clear exiting ratings because there can only be one v16 rating tag.
-            m_episode.ratings().clear();
-            m_episode.ratings().setOrAddRating(rating);
-            m_episode.setChanged(true);
-        }
-    }
+        } else if (reader.name() == QLatin1String("tvdbid")) {
+            // v16 TvDbId
+            tvdbId = reader.readElementText();
 
-    if (!episodeDetails.elementsByTagName("top250").isEmpty()) {
-        m_episode.setTop250(episodeDetails.elementsByTagName("top250").at(0).toElement().text().toInt());
-    }
-    if (!episodeDetails.elementsByTagName("plot").isEmpty()) {
-        m_episode.setOverview(episodeDetails.elementsByTagName("plot").at(0).toElement().text());
-    }
-    if (!episodeDetails.elementsByTagName("mpaa").isEmpty()) {
-        m_episode.setCertification(Certification(episodeDetails.elementsByTagName("mpaa").at(0).toElement().text()));
-    }
-    if (!episodeDetails.elementsByTagName("aired").isEmpty()) {
-        const QDomElement aired = episodeDetails.elementsByTagName("aired").at(0).toElement();
-        if (!aired.isNull() && !aired.text().isEmpty()) {
-            const QDate date = QDate::fromString(aired.text(), "yyyy-MM-dd");
+        } else if (reader.name() == QLatin1String("imdbid")) {
+            // v16 ImdbId
+            imdbId = reader.readElementText();
+
+        } else if (reader.name() == QLatin1String("uniqueid")) {
+            // v17 ids
+            const QString type = reader.attributes().value("type").toString();
+            uniqueIds.append({type, reader.readElementText().trimmed()});
+
+        } else if (reader.name() == QLatin1String("title")) {
+            m_episode.setTitle(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("showtitle")) {
+            m_episode.setShowTitle(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("season")) {
+            m_episode.setSeason(SeasonNumber(reader.readElementText().toInt()));
+
+        } else if (reader.name() == QLatin1String("episode")) {
+            m_episode.setEpisode(EpisodeNumber(reader.readElementText().toInt()));
+
+        } else if (reader.name() == QLatin1String("displayseason")) {
+            m_episode.setDisplaySeason(SeasonNumber(reader.readElementText().toInt()));
+
+        } else if (reader.name() == QLatin1String("displayepisode")) {
+            m_episode.setDisplayEpisode(EpisodeNumber(reader.readElementText().toInt()));
+
+        } else if (reader.name() == QLatin1String("ratings")) {
+            // new ratings syntax; takes precedence over <rating> and <votes>
+            hasRatings = true;
+            parseRatings(reader);
+
+        } else if (reader.name() == QLatin1String("rating")) {
+            ratingV16 = reader.readElementText();
+
+        } else if (reader.name() == QLatin1String("votes")) {
+            votesV16 = reader.readElementText();
+
+        } else if (reader.name() == QLatin1String("top250")) {
+            m_episode.setTop250(reader.readElementText().toInt());
+
+        } else if (reader.name() == QLatin1String("plot")) {
+            m_episode.setOverview(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("mpaa")) {
+            m_episode.setCertification(Certification(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("aired")) {
+            const QDate date = QDate::fromString(reader.readElementText(), "yyyy-MM-dd");
             if (date.isValid()) {
                 m_episode.setFirstAired(date);
             }
-        }
-    }
-    if (!episodeDetails.elementsByTagName("playcount").isEmpty()) {
-        m_episode.setPlayCount(episodeDetails.elementsByTagName("playcount").at(0).toElement().text().toInt());
-    }
-    if (!episodeDetails.elementsByTagName("epbookmark").isEmpty()) {
-        m_episode.setEpBookmark(
-            QTime(0, 0, 0).addSecs(episodeDetails.elementsByTagName("epbookmark").at(0).toElement().text().toInt()));
-    }
-    if (!episodeDetails.elementsByTagName("lastplayed").isEmpty()) {
-        const QDomElement lastplayed = episodeDetails.elementsByTagName("lastplayed").at(0).toElement();
-        if (!lastplayed.isNull() && !lastplayed.text().isEmpty()) {
-            const QDateTime dateTime = QDateTime::fromString(lastplayed.text(), "yyyy-MM-dd HH:mm:ss");
+
+        } else if (reader.name() == QLatin1String("playcount")) {
+            m_episode.setPlayCount(reader.readElementText().toInt());
+
+        } else if (reader.name() == QLatin1String("epbookmark")) {
+            m_episode.setEpBookmark(QTime(0, 0, 0).addSecs(reader.readElementText().toInt()));
+
+        } else if (reader.name() == QLatin1String("lastplayed")) {
+            const QString value = reader.readElementText();
+            const QDateTime dateTime = QDateTime::fromString(value, "yyyy-MM-dd HH:mm:ss");
             if (dateTime.isValid()) {
                 m_episode.setLastPlayed(dateTime);
             } else {
-                const QDateTime date = QDateTime::fromString(lastplayed.text(), "yyyy-MM-dd");
+                const QDateTime date = QDateTime::fromString(value, "yyyy-MM-dd");
                 if (date.isValid()) {
                     m_episode.setLastPlayed(date);
                 }
             }
+
+        } else if (reader.name() == QLatin1String("studio")) {
+            m_episode.setNetwork(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("tag")) {
+            // tags are officially not yet supported, even by Kodi 19 but scraper providers start
+            // to support them
+            m_episode.addTag(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("thumb")) {
+            m_episode.setThumbnail(QUrl(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("credits")) {
+            m_episode.addWriter(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("director")) {
+            m_episode.addDirector(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("actor")) {
+            parseActor(reader);
+
+        } else if (reader.name() == QLatin1String("fileinfo")) {
+            parseFileInfo(reader);
+
+        } else {
+            reader.skipCurrentElement();
         }
     }
-    if (!episodeDetails.elementsByTagName("studio").isEmpty()) {
-        m_episode.setNetwork(episodeDetails.elementsByTagName("studio").at(0).toElement().text());
-    }
 
-    // tags are officially not yet supported, even by Kodi 19 but scraper providers start
-    // to support them
-    for (int i = 0, n = episodeDetails.elementsByTagName("tag").size(); i < n; i++) {
-        m_episode.addTag(episodeDetails.elementsByTagName("tag").at(i).toElement().text());
+    if (!id.isEmpty()) {
+        m_episode.setTvdbId(TvDbId(id));
+    }
+    if (!tvdbId.isEmpty()) {
+        m_episode.setTvdbId(TvDbId(tvdbId));
+    }
+    if (!imdbId.isEmpty()) {
+        m_episode.setImdbId(ImdbId(imdbId));
+    }
+    for (const auto& uniqueId : asConst(uniqueIds)) {
+        setUniqueId(uniqueId.first, uniqueId.second);
     }
 
-    if (!episodeDetails.elementsByTagName("thumb").isEmpty()) {
-        m_episode.setThumbnail(QUrl(episodeDetails.elementsByTagName("thumb").at(0).toElement().text()));
+    if (!hasRatings && !ratingV16.isEmpty()) {
+        // otherwise use "old" syntax:
+        // <rating>10.0</rating>
+        // <votes>10.0</votes>
+        Rating rating;
+        rating.rating = ratingV16.replace(",", ".").toDouble();
+        rating.voteCount = votesV16.replace(",", "").replace(".", "").toInt();
+        // Note: We clear exiting ratings because there can only be one v16 rating tag.
+        m_episode.ratings().clear();
+        m_episode.ratings().setOrAddRating(rating);
+        m_episode.setChanged(true);
     }
-    for (int i = 0, n = episodeDetails.elementsByTagName("credits").size(); i < n; i++) {
-        m_episode.addWriter(episodeDetails.elementsByTagName("credits").at(i).toElement().text());
+}
+
+void EpisodeXmlReader::setUniqueId(const QString& type, const QString& value)
+{
+    if (value.isEmpty()) {
+        // Silently skip empty values; we wouldn't get any benefit from them
+        return;
     }
-    for (int i = 0, n = episodeDetails.elementsByTagName("director").size(); i < n; i++) {
-        m_episode.addDirector(episodeDetails.elementsByTagName("director").at(i).toElement().text());
+
+    if (type == "imdb") {
+        m_episode.setImdbId(ImdbId(value));
+    } else if (type == "tvdb") {
+        m_episode.setTvdbId(TvDbId(value));
+    } else if (type == "tmdb") {
+        m_episode.setTmdbId(TmdbId(value));
+    } else if (type == "tvmaze") {
+        m_episode.setTvMazeId(TvMazeId(value));
+    } else {
+        qCWarning(generic) << "[EpisodeXmlReader] Unsupported unique id type:" << type << "with value" << value;
     }
-    for (int i = 0, n = episodeDetails.elementsByTagName("actor").size(); i < n; i++) {
-        QDomElement actorElement = episodeDetails.elementsByTagName("actor").at(i).toElement();
-        Actor a;
-        a.imageHasChanged = false;
-        if (!actorElement.elementsByTagName("name").isEmpty()) {
-            a.name = actorElement.elementsByTagName("name").at(0).toElement().text();
+}
+
+void EpisodeXmlReader::parseRatings(QXmlStreamReader& reader)
+{
+    // <ratings>
+    //   <rating name="default" default="true">
+    //     <value>10</value>
+    //     <votes>10</votes>
+    //   </rating>
+    // </ratings>
+    m_episode.ratings().clear();
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("rating")) {
+            reader.skipCurrentElement();
+            continue;
         }
-        if (!actorElement.elementsByTagName("role").isEmpty()) {
-            a.role = actorElement.elementsByTagName("role").at(0).toElement().text();
+
+        Rating rating;
+        const QXmlStreamAttributes attributes = reader.attributes();
+        rating.source = attributes.hasAttribute("name") ? attributes.value("name").toString() : "default";
+        bool ok = false;
+        const int max = attributes.value("max").toString().toInt(&ok);
+        if (ok && max > 0) {
+            rating.maxRating = max;
         }
-        if (!actorElement.elementsByTagName("thumb").isEmpty()) {
-            a.thumb = actorElement.elementsByTagName("thumb").at(0).toElement().text();
+
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("value")) {
+                rating.rating = reader.readElementText().replace(",", ".").toDouble();
+            } else if (reader.name() == QLatin1String("votes")) {
+                rating.voteCount = reader.readElementText().replace(",", "").replace(".", "").toInt();
+            } else {
+                reader.skipCurrentElement();
+            }
         }
-        if (!actorElement.elementsByTagName("order").isEmpty()) {
-            a.order = actorElement.elementsByTagName("order").at(0).toElement().text().toInt();
+
+        m_episode.ratings().setOrAddRating(rating);
+        m_episode.setChanged(true);
+    }
+}
+
+void EpisodeXmlReader::parseActor(QXmlStreamReader& reader)
+{
+    Actor a;
+    a.imageHasChanged = false;
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("name")) {
+            a.name = reader.readElementText();
+        } else if (reader.name() == QLatin1String("role")) {
+            a.role = reader.readElementText();
+        } else if (reader.name() == QLatin1String("thumb")) {
+            a.thumb = reader.readElementText();
+        } else if (reader.name() == QLatin1String("order")) {
+            a.order = reader.readElementText().toInt();
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+    m_episode.addActor(a);
+}
+
+void EpisodeXmlReader::parseFileInfo(QXmlStreamReader& reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("streamdetails")) {
+            KodiXml::readStreamDetails(reader, m_episode.streamDetails());
+            m_episode.setStreamDetailsLoaded(true);
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
+bool EpisodeXmlReader::readNextEpisodeDetails(QXmlStreamReader& reader)
+{
+    while (!reader.atEnd()) {
+        if (reader.readNext() == QXmlStreamReader::StartElement && reader.name() == QLatin1String("episodedetails")) {
+            return true;
         }
-        m_episode.addActor(a);
     }
+    return false;
 }
 
 QString EpisodeXmlReader::makeValidEpisodeXml(const QString& nfoContent)
@@ -1,7 +1,10 @@
 #pragma once
 
-#include <QDomElement>
+#include "tv_shows/EpisodeNumber.h"
+#include "tv_shows/SeasonNumber.h"
+
 #include <QString>
+#include <QXmlStreamReader>
 
 class TvShowEpisode;
 
@@ -12,11 +15,31 @@ class EpisodeXmlReader
 {
 public:
     explicit EpisodeXmlReader(TvShowEpisode& episode);
-    void parseNfoDom(QDomElement episodeDetails);
+    /// \brief Parses an NFO with a single <episodedetails> root element.
+    void parse(QXmlStreamReader& reader);
+    /// \brief Parses the <episodedetails> element that the reader is positioned at.
+    void parseEpisodeDetails(QXmlStreamReader& reader);
+    /// \brief   Parses the content of an episode's NFO file.
+    /// \details Multi-episode NFO files contain one <episodedetails> element per episode.
+    ///          The element with the episode's season and episode number is used.
+    ///          Returns false if there is no such element.
+    bool parseNfo(const QString& nfoContent);
 
     static QString makeValidEpisodeXml(const QString& nfoContent);
+    /// \brief Moves the reader to the next <episodedetails> start element, regardless of
+    ///        its depth.  Returns false if there is none.
+    static bool readNextEpisodeDetails(QXmlStreamReader& reader);
 
 private:
+    /// \brief Index of the <episodedetails> element in the given XML (see makeValidEpisodeXml())
+    ///        that should be loaded for the given episode or -1 if there is none.
+    static int indexOfEpisodeDetails(const QString& episodeXml, SeasonNumber season, EpisodeNumber episode);
+
+    void setUniqueId(const QString& type, const QString& value);
+    void parseRatings(QXmlStreamReader& reader);
+    void parseActor(QXmlStreamReader& reader);
+    void parseFileInfo(QXmlStreamReader& reader);
+
     TvShowEpisode& m_episode;
 };
 
@@ -1,15 +1,14 @@
 #include "media_centers/kodi/MovieXmlReader.h"
 
-#include "log/Log.h"
-#include "media_centers/kodi/KodiXmlWriter.h"
+#include "media_centers/KodiXml.h"
 #include "movies/Movie.h"
 
 #include <QDate>
-#include <QDomDocument>
-#include <QDomNodeList>
+#include <QPair>
 #include <QStringList>
 #include <QTextDocument>
 #include <QUrl>
+#include <QVector>
 
 namespace mediaelch {
 namespace kodi {
@@ -25,129 +24,174 @@ MovieXmlReader::MovieXmlReader(Movie& movie) : m_movie{movie}
 {
 }
 
-void MovieXmlReader::parseNfoDom(QDomDocument domDoc)
+void MovieXmlReader::parse(QXmlStreamReader& reader)
 {
-    if (domDoc.elementsByTagName("movie").isEmpty()) {
-        qCWarning(generic) << "[MovieXmlReader] No <movie> tag in the document";
-        return;
+    if (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("movie")) {
+            parseMovie(reader);
+        } else {
+            reader.raiseError(QObject::tr("No valid movie root entry found"));
+        }
     }
-    QDomElement movieElement = domDoc.elementsByTagName("movie").at(0).toElement();
-    QMap<QString, void (MovieXmlReader::*)(const QDomElement&)> tagParsers;
-    // clang-format off
-    tagParsers.insert("title",         &MovieXmlReader::simpleString<&Movie::setName>);
-    tagParsers.insert("originaltitle", &MovieXmlReader::simpleString<&Movie::setOriginalName>);
-    tagParsers.insert("sorttitle",     &MovieXmlReader::simpleString<&Movie::setSortTitle>);
-    tagParsers.insert("plot",          &MovieXmlReader::simpleString<&Movie::setOverview>);
-    tagParsers.insert("outline",       &MovieXmlReader::simpleString<&Movie::setOutline>);
-    tagParsers.insert("tagline",       &MovieXmlReader::simpleString<&Movie::setTagline>);
-    tagParsers.insert("set",           &MovieXmlReader::movieSet);
-    tagParsers.insert("actor",         &MovieXmlReader::movieActor);
-    tagParsers.insert("thumb",         &MovieXmlReader::movieThumbnail);
-    tagParsers.insert("fanart",        &MovieXmlReader::movieFanart);
-    tagParsers.insert("playcount",     &MovieXmlReader::simpleInt<&Movie::setPlayCount>);
-    tagParsers.insert("top250",        &MovieXmlReader::simpleInt<&Movie::setTop250>);
-    tagParsers.insert("tag",           &MovieXmlReader::simpleString<&Movie::addTag>);
-    tagParsers.insert("studio",        &MovieXmlReader::stringList<&Movie::addStudio, '/'>);
-    tagParsers.insert("genre",         &MovieXmlReader::stringList<&Movie::addGenre, '/'>);
-    tagParsers.insert("country",       &MovieXmlReader::stringList<&Movie::addCountry, '/'>);
-    tagParsers.insert("ratings",       &MovieXmlReader::movieRatingV17);
-    tagParsers.insert("rating",        &MovieXmlReader::movieRatingV16);
-    tagParsers.insert("userrating",    &MovieXmlReader::simpleDouble<&Movie::setUserRating>);
-    tagParsers.insert("votes",         &MovieXmlReader::movieVoteCountV16);
-    tagParsers.insert("dateadded",     &MovieXmlReader::simpleDateTime<&Movie::setDateAdded>);
-    tagParsers.insert("resume",        &MovieXmlReader::movieResumeTime);
-    // clang-format on
-
-    QDomNodeList nodes = movieElement.childNodes();
-    for (int i = 0; i < nodes.size(); ++i) {
-        if (nodes.at(i).isElement()) {
-            QDomElement element = nodes.at(i).toElement();
-            if (tagParsers.contains(element.tagName())) {
-                // call the stored method pointer
-                (this->*tagParsers[element.tagName()])(element);
+}
+
+void MovieXmlReader::parseMovie(QXmlStreamReader& reader)
+{
+    // These tags depend on others and are applied after all tags were read.
+    QString premiered;
+    QVector<QPair<QString, QString>> uniqueIds;
+    QStringList writers;
+    QStringList directors;
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("title")) {
+            m_movie.setName(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("originaltitle")) {
+            m_movie.setOriginalName(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("sorttitle")) {
+            m_movie.setSortTitle(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("plot")) {
+            m_movie.setOverview(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("outline")) {
+            m_movie.setOutline(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("tagline")) {
+            m_movie.setTagline(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("set")) {
+            movieSet(reader);
+
+        } else if (reader.name() == QLatin1String("actor")) {
+            movieActor(reader);
+
+        } else if (reader.name() == QLatin1String("thumb")) {
+            movieThumbnail(reader);
+
+        } else if (reader.name() == QLatin1String("fanart")) {
+            movieFanart(reader);
+
+        } else if (reader.name() == QLatin1String("playcount")) {
+            m_movie.setPlayCount(reader.readElementText().toInt());
+
+        } else if (reader.name() == QLatin1String("top250")) {
+            m_movie.setTop250(reader.readElementText().toInt());
+
+        } else if (reader.name() == QLatin1String("tag")) {
+            m_movie.addTag(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("studio")) {
+            stringList<&Movie::addStudio>(reader, '/');
+
+        } else if (reader.name() == QLatin1String("genre")) {
+            stringList<&Movie::addGenre>(reader, '/');
+
+        } else if (reader.name() == QLatin1String("country")) {
+            stringList<&Movie::addCountry>(reader, '/');
+
+        } else if (reader.name() == QLatin1String("ratings")) {
+            movieRatingV17(reader);
+
+        } else if (reader.name() == QLatin1String("rating")) {
+            movieRatingV16(reader);
+
+        } else if (reader.name() == QLatin1String("votes")) {
+            movieVoteCountV16(reader);
+
+        } else if (reader.name() == QLatin1String("userrating")) {
+            m_movie.setUserRating(reader.readElementText().toDouble());
+
+        } else if (reader.name() == QLatin1String("dateadded")) {
+            const QDateTime value = QDateTime::fromString(reader.readElementText(), "yyyy-MM-dd HH:mm:ss");
+            if (value.isValid()) {
+                m_movie.setDateAdded(value);
+            }
+
+        } else if (reader.name() == QLatin1String("resume")) {
+            movieResumeTime(reader);
+
+        } else if (reader.name() == QLatin1String("year")) {
+            m_movie.setReleased(QDate::fromString(reader.readElementText(), "yyyy"));
+
+        } else if (reader.name() == QLatin1String("premiered")) {
+            // will overwrite the release date set by <year>
+            premiered = reader.readElementText().trimmed();
+
+        } else if (reader.name() == QLatin1String("runtime")) {
+            m_movie.setRuntime(std::chrono::minutes(reader.readElementText().toInt()));
+
+        } else if (reader.name() == QLatin1String("mpaa")) {
+            m_movie.setCertification(Certification(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("lastplayed")) {
+            const QString value = reader.readElementText();
+            QDateTime lastPlayed = QDateTime::fromString(value, "yyyy-MM-dd HH:mm:ss");
+            if (!lastPlayed.isValid()) {
+                lastPlayed = QDateTime::fromString(value, "yyyy-MM-dd");
             }
+            m_movie.setLastPlayed(lastPlayed);
+
+        } else if (reader.name() == QLatin1String("id")) {
+            // v16 imdbid
+            m_movie.setImdbId(ImdbId(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("tmdbid")) {
+            // v16 tmdbid
+            m_movie.setTmdbId(TmdbId(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("uniqueid")) {
+            // >v17 ids; overwrite the v16 ones
+            const QString type = reader.attributes().value("type").toString();
+            uniqueIds.append({type, reader.readElementText().trimmed()});
+
+        } else if (reader.name() == QLatin1String("trailer")) {
+            m_movie.setTrailer(QUrl(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("credits")) {
+            const QStringList credits = reader.readElementText().split(",", ElchSplitBehavior::SkipEmptyParts);
+            for (const QString& writer : credits) {
+                writers.append(writer.trimmed());
+            }
+
+        } else if (reader.name() == QLatin1String("director")) {
+            const QStringList directorsFound =
+                reader.readElementText().split(",", ElchSplitBehavior::SkipEmptyParts);
+            for (const QString& director : directorsFound) {
+                directors.append(director.trimmed());
+            }
+
+        } else if (reader.name() == QLatin1String("fileinfo")) {
+            movieFileInfo(reader);
+
+        } else {
+            reader.skipCurrentElement();
         }
     }
 
-    if (!domDoc.elementsByTagName("year").isEmpty()) {
-        m_movie.setReleased(QDate::fromString(domDoc.elementsByTagName("year").at(0).toElement().text(), "yyyy"));
-    }
-    // will overwrite the release date set by <year>
-    if (!domDoc.elementsByTagName("premiered").isEmpty()) {
-        QString value = domDoc.elementsByTagName("premiered").at(0).toElement().text().trimmed();
-        QDate released = QDate::fromString(value, "yyyy-MM-dd");
+    if (!premiered.isEmpty()) {
+        QDate released = QDate::fromString(premiered, "yyyy-MM-dd");
         if (released.isValid()) {
             m_movie.setReleased(released);
         }
     }
 
-    if (!domDoc.elementsByTagName("runtime").isEmpty()) {
-        m_movie.setRuntime(std::chrono::minutes(domDoc.elementsByTagName("runtime").at(0).toElement().text().toInt()));
-    }
-    if (!domDoc.elementsByTagName("mpaa").isEmpty()) {
-        m_movie.setCertification(Certification(domDoc.elementsByTagName("mpaa").at(0).toElement().text()));
-    }
-    if (!domDoc.elementsByTagName("lastplayed").isEmpty()) {
-        QDateTime lastPlayed = QDateTime::fromString(
-            domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss");
-        if (!lastPlayed.isValid()) {
-            lastPlayed =
-                QDateTime::fromString(domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd");
-        }
-        m_movie.setLastPlayed(lastPlayed);
-    }
-
-    // v16 imdbid
-    if (!domDoc.elementsByTagName("id").isEmpty()) {
-        m_movie.setImdbId(ImdbId(domDoc.elementsByTagName("id").at(0).toElement().text()));
-    }
-    // v16 tmdbid
-    if (!domDoc.elementsByTagName("tmdbid").isEmpty()) {
-        m_movie.setTmdbId(TmdbId(domDoc.elementsByTagName("tmdbid").at(0).toElement().text()));
-    }
-    // >v17 ids
-    auto uniqueIds = domDoc.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
-        if (type == "imdb") {
-            m_movie.setImdbId(ImdbId(value));
-        } else if (type == "tmdb") {
-            m_movie.setTmdbId(TmdbId(value));
+    for (const auto& uniqueId : asConst(uniqueIds)) {
+        if (uniqueId.first == "imdb") {
+            m_movie.setImdbId(ImdbId(uniqueId.second));
+        } else if (uniqueId.first == "tmdb") {
+            m_movie.setTmdbId(TmdbId(uniqueId.second));
         }
     }
 
-    if (!domDoc.elementsByTagName("trailer").isEmpty()) {
-        m_movie.setTrailer(QUrl(domDoc.elementsByTagName("trailer").at(0).toElement().text()));
-    }
-
-    QStringList writers;
-    for (int i = 0, n = domDoc.elementsByTagName("credits").size(); i < n; i++) {
-        const auto credits =
-            domDoc.elementsByTagName("credits").at(i).toElement().text().split(",", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& writer : credits) {
-            writers.append(writer.trimmed());
-        }
-    }
     m_movie.setWriter(writers.join(", "));
-
-    QStringList directors;
-    for (int i = 0, n = domDoc.elementsByTagName("director").size(); i < n; i++) {
-        const auto directorsFound =
-            domDoc.elementsByTagName("director").at(i).toElement().text().split(",", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& director : directorsFound) {
-            directors.append(director.trimmed());
-        }
-    }
     m_movie.setDirector(directors.join(", "));
 }
 
-void MovieXmlReader::movieSet(const QDomElement& movieSetElement)
+void MovieXmlReader::movieSet(QXmlStreamReader& reader)
 {
-    const QDomNodeList setNameElements = movieSetElement.elementsByTagName("name");
-    const QDomNodeList setOverviewElements = movieSetElement.elementsByTagName("overview");
-
     // We need to support both the old and new XML syntax.
     //
     // New Kodi v17 XML Syntax:
@@ -160,60 +204,82 @@ void MovieXmlReader::movieSet(const QDomElement& movieSetElement)
     //   <set>Movie Set Name</set>
     //
     MovieSet set;
-    if (!setNameElements.isEmpty()) {
-        set.name = setNameElements.at(0).toElement().text();
-    } else {
-        set.name = movieSetElement.text();
+    QString text;
+    bool hasName = false;
+
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isCharacters()) {
+            text += reader.text();
+
+        } else if (reader.isStartElement()) {
+            if (reader.name() == QLatin1String("name") && !hasName) {
+                set.name = reader.readElementText();
+                hasName = true;
+            } else if (reader.name() == QLatin1String("overview") && set.overview.isEmpty()) {
+                set.overview = htmlUnescape(reader.readElementText());
+            } else {
+                reader.skipCurrentElement();
+            }
+
+        } else if (reader.isEndElement()) {
+            break;
+        }
     }
-    if (!setOverviewElements.isEmpty()) {
-        set.overview = htmlUnescape(setOverviewElements.at(0).toElement().text());
+
+    if (!hasName) {
+        set.name = text;
     }
     m_movie.setSet(set);
 }
 
-void MovieXmlReader::movieActor(const QDomElement& actorElement)
+void MovieXmlReader::movieActor(QXmlStreamReader& reader)
 {
     Actor a;
     a.imageHasChanged = false;
-    if (!actorElement.elementsByTagName("name").isEmpty()) {
-        a.name = actorElement.elementsByTagName("name").at(0).toElement().text();
-    }
-    if (!actorElement.elementsByTagName("role").isEmpty()) {
-        a.role = actorElement.elementsByTagName("role").at(0).toElement().text();
-    }
-    if (!actorElement.elementsByTagName("thumb").isEmpty()) {
-        a.thumb = actorElement.elementsByTagName("thumb").at(0).toElement().text();
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("name")) {
+            a.name = reader.readElementText();
+        } else if (reader.name() == QLatin1String("role")) {
+            a.role = reader.readElementText();
+        } else if (reader.name() == QLatin1String("thumb")) {
+            a.thumb = reader.readElementText();
+        } else {
+            reader.skipCurrentElement();
+        }
     }
     m_movie.addActor(a);
 }
 
-void MovieXmlReader::movieThumbnail(const QDomElement& thumbElement)
+void MovieXmlReader::movieThumbnail(QXmlStreamReader& reader)
 {
-    QString aspect = thumbElement.attribute("aspect").trimmed();
+    QString aspect = reader.attributes().value("aspect").toString().trimmed();
     // if (aspect == "set.poster") {
     //     // TODO: special handling of set-posters, etc.
     // }
 
     Poster p;
-    p.originalUrl = QUrl(thumbElement.text());
-    p.thumbUrl = QUrl(thumbElement.attribute("preview"));
+    p.thumbUrl = QUrl(reader.attributes().value("preview").toString());
     p.aspect = aspect;
+    p.originalUrl = QUrl(reader.readElementText());
     m_movie.images().addPoster(p);
 }
 
-void MovieXmlReader::movieFanart(const QDomElement& fanartElement)
+void MovieXmlReader::movieFanart(QXmlStreamReader& reader)
 {
-    QDomNodeList thumbs = fanartElement.elementsByTagName("thumb");
-    for (int i = 0; i < thumbs.size(); ++i) {
-        QDomElement thumbElement = thumbs.at(i).toElement();
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("thumb")) {
+            reader.skipCurrentElement();
+            continue;
+        }
         Poster p;
-        p.originalUrl = QUrl(thumbElement.text());
-        p.thumbUrl = QUrl(thumbElement.attribute("preview"));
+        p.thumbUrl = QUrl(reader.attributes().value("preview").toString());
+        p.originalUrl = QUrl(reader.readElementText());
         m_movie.images().addBackdrop(p);
     }
 }
 
-void MovieXmlReader::movieRatingV17(const QDomElement& element)
+void MovieXmlReader::movieRatingV17(QXmlStreamReader& reader)
 {
     // <ratings>
     //   <rating name="default" default="true">
@@ -221,35 +287,49 @@ void MovieXmlReader::movieRatingV17(const QDomElement& element)
     //     <votes>10</votes>
     //   </rating>
     // </ratings>
-    auto ratings = element.elementsByTagName("rating");
+    bool hasRatings = false;
 
-    // clear all ratings in case that there are <rating> tags to avoid
-    // duplicated and/or old ratings
-    if (ratings.length() > 0) {
-        m_movie.ratings().clear();
-    }
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("rating")) {
+            reader.skipCurrentElement();
+            continue;
+        }
+
+        // clear all ratings in case that there are <rating> tags to avoid
+        // duplicated and/or old ratings
+        if (!hasRatings) {
+            m_movie.ratings().clear();
+            hasRatings = true;
+        }
 
-    for (int i = 0; i < ratings.length(); ++i) {
         Rating rating;
-        auto ratingElement = ratings.at(i).toElement();
-        rating.source = ratingElement.attribute("name", "default");
+        const QXmlStreamAttributes attributes = reader.attributes();
+        rating.source = attributes.hasAttribute("name") ? attributes.value("name").toString() : "default";
         bool ok = false;
-        int max = ratingElement.attribute("max", "0").toInt(&ok);
+        const int max = attributes.value("max").toString().toInt(&ok);
         if (ok && max > 0) {
             rating.maxRating = max;
         }
-        rating.rating = ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-        rating.voteCount =
-            ratingElement.elementsByTagName("votes").at(0).toElement().text().replace(",", "").replace(".", "").toInt();
+
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("value")) {
+                rating.rating = reader.readElementText().replace(",", ".").toDouble();
+            } else if (reader.name() == QLatin1String("votes")) {
+                rating.voteCount = reader.readElementText().replace(",", "").replace(".", "").toInt();
+            } else {
+                reader.skipCurrentElement();
+            }
+        }
+
         m_movie.ratings().setOrAddRating(rating);
         m_movie.setChanged(true);
     }
 }
 
-void MovieXmlReader::movieRatingV16(const QDomElement& element)
+void MovieXmlReader::movieRatingV16(QXmlStreamReader& reader)
 {
     // <rating>10.0</rating>
-    QString value = element.text();
+    QString value = reader.readElementText();
     if (!value.isEmpty()) {
         if (m_movie.ratings().isEmpty()) {
             m_movie.ratings().setOrAddRating(Rating{});
@@ -259,10 +339,10 @@ void MovieXmlReader::movieRatingV16(const QDomElement& element)
     }
 }
 
-void MovieXmlReader::movieVoteCountV16(const QDomElement& element)
+void MovieXmlReader::movieVoteCountV16(QXmlStreamReader& reader)
 {
     // <votes>100</votes>
-    QString value = element.text();
+    QString value = reader.readElementText();
     if (!value.isEmpty()) {
         if (m_movie.ratings().isEmpty()) {
             m_movie.ratings().setOrAddRating(Rating{});
@@ -272,30 +352,42 @@ void MovieXmlReader::movieVoteCountV16(const QDomElement& element)
     }
 }
 
-void MovieXmlReader::movieResumeTime(const QDomElement& element)
+void MovieXmlReader::movieResumeTime(QXmlStreamReader& reader)
 {
-    auto positions = element.elementsByTagName("position");
-    auto totals = element.elementsByTagName("total");
-
     mediaelch::ResumeTime time;
 
-    if (!positions.isEmpty()) {
-        bool ok = false;
-        const double position = positions.at(0).toElement().text().replace(",", ".").toDouble(&ok);
-        if (ok) {
-            time.position = position;
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("position")) {
+            bool ok = false;
+            const double position = reader.readElementText().replace(",", ".").toDouble(&ok);
+            if (ok) {
+                time.position = position;
+            }
+        } else if (reader.name() == QLatin1String("total")) {
+            bool ok = false;
+            const double total = reader.readElementText().replace(",", ".").toDouble(&ok);
+            if (ok) {
+                time.total = total;
+            }
+        } else {
+            reader.skipCurrentElement();
         }
     }
 
-    if (!totals.isEmpty()) {
-        bool ok = false;
-        const double total = totals.at(0).toElement().text().replace(",", ".").toDouble(&ok);
-        if (ok) {
-            time.total = total;
+    m_movie.setResumeTime(time);
+}
+
+void MovieXmlReader::movieFileInfo(QXmlStreamReader& reader)
+{
+    while (reader.readNextStartElement()) {
+        // Movies without files have no stream details.
+        if (reader.name() == QLatin1String("streamdetails") && m_movie.streamDetails() != nullptr) {
+            KodiXml::readStreamDetails(reader, m_movie.streamDetails());
+            m_movie.setStreamDetailsLoaded(true);
+        } else {
+            reader.skipCurrentElement();
         }
     }
-
-    m_movie.setResumeTime(time);
 }
 
 } // namespace kodi
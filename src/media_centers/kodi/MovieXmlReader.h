@@ -2,9 +2,9 @@
 
 #include "globals/Globals.h"
 
-#include <QDate>
-#include <QDomDocument>
 #include <QString>
+#include <QStringList>
+#include <QXmlStreamReader>
 
 class Movie;
 
@@ -15,58 +15,33 @@ class MovieXmlReader
 {
 public:
     explicit MovieXmlReader(Movie& movie);
-    void parseNfoDom(QDomDocument domDoc);
+    void parse(QXmlStreamReader& reader);
 
 private:
+    void parseMovie(QXmlStreamReader& reader);
+
+    void movieSet(QXmlStreamReader& reader);
+    void movieActor(QXmlStreamReader& reader);
+    void movieThumbnail(QXmlStreamReader& reader);
+    void movieFanart(QXmlStreamReader& reader);
+    void movieRatingV17(QXmlStreamReader& reader);
+    void movieRatingV16(QXmlStreamReader& reader);
+    void movieVoteCountV16(QXmlStreamReader& reader);
+    void movieResumeTime(QXmlStreamReader& reader);
+    void movieFileInfo(QXmlStreamReader& reader);
+
     template<class T>
     using MovieStoreMethod = void (Movie::*)(T);
 
     template<MovieStoreMethod<QString> method>
-    void simpleString(const QDomElement& element)
-    {
-        const QString value = element.text();
-        (m_movie.*method)(value);
-    }
-
-    template<MovieStoreMethod<QString> method, const char splitChar>
-    void stringList(const QDomElement& element)
+    void stringList(QXmlStreamReader& reader, QChar splitChar)
     {
-        QStringList values = element.text().split(splitChar, ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& value : asConst(values)) {
+        const QStringList values = reader.readElementText().split(splitChar, ElchSplitBehavior::SkipEmptyParts);
+        for (const QString& value : values) {
             (m_movie.*method)(value.trimmed());
         }
     }
 
-    template<MovieStoreMethod<int> method>
-    void simpleInt(const QDomElement& element)
-    {
-        (m_movie.*method)(element.text().toInt());
-    }
-
-    template<MovieStoreMethod<double> method>
-    void simpleDouble(const QDomElement& element)
-    {
-        (m_movie.*method)(element.text().toDouble());
-    }
-
-    template<MovieStoreMethod<QDateTime> method>
-    void simpleDateTime(const QDomElement& element)
-    {
-        const QDateTime value = QDateTime::fromString(element.text(), "yyyy-MM-dd HH:mm:ss");
-        if (value.isValid()) {
-            (m_movie.*method)(value);
-        }
-    }
-
-    void movieSet(const QDomElement& element);
-    void movieActor(const QDomElement& element);
-    void movieThumbnail(const QDomElement& element);
-    void movieFanart(const QDomElement& element);
-    void movieRatingV17(const QDomElement& element);
-    void movieRatingV16(const QDomElement& element);
-    void movieVoteCountV16(const QDomElement& element);
-    void movieResumeTime(const QDomElement& element);
-
     Movie& m_movie;
 };
 
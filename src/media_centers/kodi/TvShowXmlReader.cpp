@@ -6,9 +6,10 @@
 
 #include <QDate>
 #include <QDateTime>
-#include <QDomDocument>
 #include <QFileInfo>
+#include <QPair>
 #include <QUrl>
+#include <QVector>
 
 namespace mediaelch {
 namespace kodi {
@@ -17,230 +18,281 @@ TvShowXmlReader::TvShowXmlReader(TvShow& tvShow) : m_show{tvShow}
 {
 }
 
-void TvShowXmlReader::parseNfoDom(QDomDocument domDoc)
+void TvShowXmlReader::parse(QXmlStreamReader& reader)
 {
-    // v17/v18 TvDbId
-    if (!domDoc.elementsByTagName("id").isEmpty()) {
-        m_show.setTvdbId(TvDbId(domDoc.elementsByTagName("id").at(0).toElement().text()));
-    }
-    // v16 TvDbId/ImdbId
-    if (!domDoc.elementsByTagName("tvdbid").isEmpty()) {
-        QString value = domDoc.elementsByTagName("tvdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_show.setTvdbId(TvDbId(value));
-        }
-    }
-    if (!domDoc.elementsByTagName("imdbid").isEmpty()) {
-        QString value = domDoc.elementsByTagName("imdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_show.setImdbId(ImdbId(value));
+    if (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("tvshow")) {
+            parseTvShow(reader);
+        } else {
+            reader.raiseError(QObject::tr("No valid tvshow root entry found"));
         }
     }
-    // v17 ids
-    auto uniqueIds = domDoc.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
-
-        if (value.isEmpty()) {
-            // Silently skip empty values; we wouldn't get any benefit from them
-            continue;
-        }
 
-        if (type == "imdb") {
-            m_show.setImdbId(ImdbId(value));
-        } else if (type == "tvdb") {
-            m_show.setTvdbId(TvDbId(value));
-        } else if (type == "tmdb") {
-            m_show.setTmdbId(TmdbId(value));
-        } else if (type == "tvmaze") {
-            m_show.setTvMazeId(TvMazeId(value));
-        } else if (type != "mediaelch_fallback") {
-            qCWarning(generic) << "[TvShowXmlReader] Unsupported unique id type:" << type << "with value" << value;
-        }
-    }
-    if (!domDoc.elementsByTagName("title").isEmpty()) {
-        m_show.setTitle(domDoc.elementsByTagName("title").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("sorttitle").isEmpty()) {
-        m_show.setSortTitle(domDoc.elementsByTagName("sorttitle").at(0).toElement().text());
-    }
-    // since v17
-    if (!domDoc.elementsByTagName("originaltitle").isEmpty()) {
-        m_show.setOriginalTitle(domDoc.elementsByTagName("originaltitle").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("showtitle").isEmpty()) {
-        m_show.setShowTitle(domDoc.elementsByTagName("showtitle").at(0).toElement().text());
-    }
-    QDomNodeList namedSeasons = domDoc.elementsByTagName("namedseason");
-    for (int i = 0; i < namedSeasons.size(); ++i) {
-        QDomElement seasonElement = namedSeasons.at(i).toElement();
-        SeasonNumber season(seasonElement.attribute("number", SeasonNumber::NoSeason.toString()).toInt());
-        QString name = seasonElement.text();
-        if (season != SeasonNumber::NoSeason) {
-            m_show.setSeasonName(season, name);
-        }
-    }
-    // check for new ratings syntax
-    if (!domDoc.elementsByTagName("ratings").isEmpty()) {
-        // <ratings>
-        //   <rating name="default" default="true">
-        //     <value>10</value>
-        //     <votes>10</votes>
-        //   </rating>
-        // </ratings>
-        auto ratings = domDoc.elementsByTagName("ratings").at(0).toElement().elementsByTagName("rating");
-        m_show.ratings().clear();
+    QFileInfo fi(m_show.dir().filePath("theme.mp3"));
+    m_show.setHasTune(fi.isFile());
+}
+
+void TvShowXmlReader::parseTvShow(QXmlStreamReader& reader)
+{
+    // IDs, ratings and dates depend on other tags and are applied after all tags were read.
+    QString id;
+    QString tvdbId;
+    QString imdbId;
+    QVector<QPair<QString, QString>> uniqueIds;
+    bool hasRatings = false;
+    QString ratingV16;
+    QString votesV16;
+    QString premiered;
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("id")) {
+            // v17/v18 TvDbId
+            id = reader.readElementText();
+
+        } else if (reader.name() == QLatin1String("tvdbid")) {
+            // v16 TvDbId
+            tvdbId = reader.readElementText();
+
+        } else if (reader.name() == QLatin1String("imdbid")) {
+            // v16 ImdbId
+            imdbId = reader.readElementText();
+
+        } else if (reader.name() == QLatin1String("uniqueid")) {
+            // v17 ids
+            const QString type = reader.attributes().value("type").toString();
+            uniqueIds.append({type, reader.readElementText().trimmed()});
+
+        } else if (reader.name() == QLatin1String("title")) {
+            m_show.setTitle(reader.readElementText());
 
-        for (int i = 0; i < ratings.length(); ++i) {
-            Rating rating;
-            auto ratingElement = ratings.at(i).toElement();
-            rating.source = ratingElement.attribute("name", "default");
-            bool ok = false;
-            const int max = ratingElement.attribute("max", "0").toInt(&ok);
-            if (ok && max > 0) {
-                rating.maxRating = max;
+        } else if (reader.name() == QLatin1String("sorttitle")) {
+            m_show.setSortTitle(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("originaltitle")) {
+            // since v17
+            m_show.setOriginalTitle(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("showtitle")) {
+            m_show.setShowTitle(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("namedseason")) {
+            const QXmlStreamAttributes attributes = reader.attributes();
+            const QString number = attributes.hasAttribute("number") ? attributes.value("number").toString()
+                                                                     : SeasonNumber::NoSeason.toString();
+            SeasonNumber season(number.toInt());
+            const QString name = reader.readElementText();
+            if (season != SeasonNumber::NoSeason) {
+                m_show.setSeasonName(season, name);
             }
-            rating.rating =
-                ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-            rating.voteCount = ratingElement.elementsByTagName("votes")
-                                   .at(0)
-                                   .toElement()
-                                   .text()
-                                   .replace(",", "")
-                                   .replace(".", "")
-                                   .toInt();
-            m_show.ratings().setOrAddRating(rating);
-            m_show.setChanged(true);
-        }
 
-    } else if (!domDoc.elementsByTagName("rating").isEmpty()) {
-        // otherwise use "old" syntax:
-        // <rating>10.0</rating>
-        // <votes>10.0</votes>
-        QString value = domDoc.elementsByTagName("rating").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            Rating rating;
-            rating.rating = value.replace(",", ".").toDouble();
-            if (!domDoc.elementsByTagName("votes").isEmpty()) {
-                rating.voteCount = domDoc.elementsByTagName("votes")
-                                       .at(0)
-                                       .toElement()
-                                       .text()
-                                       .replace(",", "")
-                                       .replace(".", "")
-                                       .toInt();
+        } else if (reader.name() == QLatin1String("ratings")) {
+            // new ratings syntax; takes precedence over <rating> and <votes>
+            hasRatings = true;
+            parseRatings(reader);
+
+        } else if (reader.name() == QLatin1String("rating")) {
+            ratingV16 = reader.readElementText();
+
+        } else if (reader.name() == QLatin1String("votes")) {
+            votesV16 = reader.readElementText();
+
+        } else if (reader.name() == QLatin1String("userrating")) {
+            m_show.setUserRating(reader.readElementText().toDouble());
+
+        } else if (reader.name() == QLatin1String("top250")) {
+            m_show.setTop250(reader.readElementText().toInt());
+
+        } else if (reader.name() == QLatin1String("plot")) {
+            m_show.setOverview(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("mpaa")) {
+            m_show.setCertification(Certification(reader.readElementText()));
+
+        } else if (reader.name() == QLatin1String("year")) {
+            m_show.setFirstAired(QDate::fromString(reader.readElementText(), "yyyy"));
+
+        } else if (reader.name() == QLatin1String("premiered")) {
+            // will override the first-aired date set by <year>
+            premiered = reader.readElementText().trimmed();
+
+        } else if (reader.name() == QLatin1String("dateadded")) {
+            m_show.setDateAdded(QDateTime::fromString(reader.readElementText(), "yyyy-MM-dd HH:mm:ss"));
+
+        } else if (reader.name() == QLatin1String("studio")) {
+            m_show.setNetwork(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("episodeguide")) {
+            parseEpisodeGuide(reader);
+
+        } else if (reader.name() == QLatin1String("runtime")) {
+            m_show.setRuntime(std::chrono::minutes(reader.readElementText().toInt()));
+
+        } else if (reader.name() == QLatin1String("status")) {
+            m_show.setStatus(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("genre")) {
+            const QStringList genres = reader.readElementText().split(" / ", ElchSplitBehavior::SkipEmptyParts);
+            for (const QString& genre : genres) {
+                m_show.addGenre(genre);
             }
-            m_show.ratings().clear();
-            m_show.ratings().setOrAddRating(rating);
-            m_show.setChanged(true);
+
+        } else if (reader.name() == QLatin1String("tag")) {
+            m_show.addTag(reader.readElementText());
+
+        } else if (reader.name() == QLatin1String("actor")) {
+            parseActor(reader);
+
+        } else if (reader.name() == QLatin1String("thumb")) {
+            showThumb(reader);
+
+        } else if (reader.name() == QLatin1String("fanart")) {
+            parseFanart(reader);
+
+        } else {
+            reader.skipCurrentElement();
         }
     }
-    if (!domDoc.elementsByTagName("userrating").isEmpty()) {
-        m_show.setUserRating(domDoc.elementsByTagName("userrating").at(0).toElement().text().toDouble());
+
+    if (!id.isEmpty()) {
+        m_show.setTvdbId(TvDbId(id));
     }
-    if (!domDoc.elementsByTagName("top250").isEmpty()) {
-        m_show.setTop250(domDoc.elementsByTagName("top250").at(0).toElement().text().toInt());
+    if (!tvdbId.isEmpty()) {
+        m_show.setTvdbId(TvDbId(tvdbId));
     }
-    if (!domDoc.elementsByTagName("plot").isEmpty()) {
-        m_show.setOverview(domDoc.elementsByTagName("plot").at(0).toElement().text());
+    if (!imdbId.isEmpty()) {
+        m_show.setImdbId(ImdbId(imdbId));
     }
-    if (!domDoc.elementsByTagName("mpaa").isEmpty()) {
-        m_show.setCertification(Certification(domDoc.elementsByTagName("mpaa").at(0).toElement().text()));
+    for (const auto& uniqueId : asConst(uniqueIds)) {
+        setUniqueId(uniqueId.first, uniqueId.second);
     }
-    if (!domDoc.elementsByTagName("year").isEmpty()) {
-        m_show.setFirstAired(QDate::fromString(domDoc.elementsByTagName("year").at(0).toElement().text(), "yyyy"));
+
+    if (!hasRatings && !ratingV16.isEmpty()) {
+        // otherwise use "old" syntax:
+        // <rating>10.0</rating>
+        // <votes>10.0</votes>
+        Rating rating;
+        rating.rating = ratingV16.replace(",", ".").toDouble();
+        rating.voteCount = votesV16.replace(",", "").replace(".", "").toInt();
+        m_show.ratings().clear();
+        m_show.ratings().setOrAddRating(rating);
+        m_show.setChanged(true);
     }
-    // will override the first-aired date set by <year>
-    if (!domDoc.elementsByTagName("premiered").isEmpty()) {
-        QString value = domDoc.elementsByTagName("premiered").at(0).toElement().text().trimmed();
-        QDate released = QDate::fromString(value, "yyyy-MM-dd");
+
+    if (!premiered.isEmpty()) {
+        QDate released = QDate::fromString(premiered, "yyyy-MM-dd");
         if (released.isValid()) {
             m_show.setFirstAired(released);
         }
     }
-    if (!domDoc.elementsByTagName("dateadded").isEmpty()) {
-        m_show.setDateAdded(QDateTime::fromString(
-            domDoc.elementsByTagName("dateadded").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss"));
-    }
-    if (!domDoc.elementsByTagName("studio").isEmpty()) {
-        m_show.setNetwork(domDoc.elementsByTagName("studio").at(0).toElement().text());
-    }
-    if (!domDoc.elementsByTagName("episodeguide").isEmpty()
-        && !domDoc.elementsByTagName("episodeguide").at(0).toElement().elementsByTagName("url").isEmpty()) {
-        m_show.setEpisodeGuideUrl(domDoc.elementsByTagName("episodeguide")
-                                      .at(0)
-                                      .toElement()
-                                      .elementsByTagName("url")
-                                      .at(0)
-                                      .toElement()
-                                      .text());
-    }
-    if (!domDoc.elementsByTagName("runtime").isEmpty()) {
-        m_show.setRuntime(std::chrono::minutes(domDoc.elementsByTagName("runtime").at(0).toElement().text().toInt()));
-    }
-    if (!domDoc.elementsByTagName("status").isEmpty()) {
-        m_show.setStatus(domDoc.elementsByTagName("status").at(0).toElement().text());
-    }
+}
 
-    for (int i = 0, n = domDoc.elementsByTagName("genre").size(); i < n; i++) {
-        const auto genres =
-            domDoc.elementsByTagName("genre").at(i).toElement().text().split(" / ", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& genre : genres) {
-            m_show.addGenre(genre);
-        }
+void TvShowXmlReader::setUniqueId(const QString& type, const QString& value)
+{
+    if (value.isEmpty()) {
+        // Silently skip empty values; we wouldn't get any benefit from them
+        return;
     }
-    for (int i = 0, n = domDoc.elementsByTagName("tag").size(); i < n; i++) {
-        m_show.addTag(domDoc.elementsByTagName("tag").at(i).toElement().text());
+
+    if (type == "imdb") {
+        m_show.setImdbId(ImdbId(value));
+    } else if (type == "tvdb") {
+        m_show.setTvdbId(TvDbId(value));
+    } else if (type == "tmdb") {
+        m_show.setTmdbId(TmdbId(value));
+    } else if (type == "tvmaze") {
+        m_show.setTvMazeId(TvMazeId(value));
+    } else if (type != "mediaelch_fallback") {
+        qCWarning(generic) << "[TvShowXmlReader] Unsupported unique id type:" << type << "with value" << value;
     }
-    for (int i = 0, n = domDoc.elementsByTagName("actor").size(); i < n; i++) {
-        QDomElement actorElement = domDoc.elementsByTagName("actor").at(i).toElement();
-        Actor a;
-        a.imageHasChanged = false;
-        if (!actorElement.elementsByTagName("name").isEmpty()) {
-            a.name = actorElement.elementsByTagName("name").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("role").isEmpty()) {
-            a.role = actorElement.elementsByTagName("role").at(0).toElement().text();
+}
+
+void TvShowXmlReader::parseRatings(QXmlStreamReader& reader)
+{
+    // <ratings>
+    //   <rating name="default" default="true">
+    //     <value>10</value>
+    //     <votes>10</votes>
+    //   </rating>
+    // </ratings>
+    m_show.ratings().clear();
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("rating")) {
+            reader.skipCurrentElement();
+            continue;
         }
-        if (!actorElement.elementsByTagName("thumb").isEmpty()) {
-            a.thumb = actorElement.elementsByTagName("thumb").at(0).toElement().text();
+
+        Rating rating;
+        const QXmlStreamAttributes attributes = reader.attributes();
+        rating.source = attributes.hasAttribute("name") ? attributes.value("name").toString() : "default";
+        bool ok = false;
+        const int max = attributes.value("max").toString().toInt(&ok);
+        if (ok && max > 0) {
+            rating.maxRating = max;
         }
-        if (!actorElement.elementsByTagName("order").isEmpty()) {
-            a.order = actorElement.elementsByTagName("order").at(0).toElement().text().toInt();
+
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("value")) {
+                rating.rating = reader.readElementText().replace(",", ".").toDouble();
+            } else if (reader.name() == QLatin1String("votes")) {
+                rating.voteCount = reader.readElementText().replace(",", "").replace(".", "").toInt();
+            } else {
+                reader.skipCurrentElement();
+            }
         }
-        m_show.addActor(a);
-    }
-    for (int i = 0, n = domDoc.elementsByTagName("thumb").size(); i < n; i++) {
-        QString parentTag = domDoc.elementsByTagName("thumb").at(i).parentNode().toElement().tagName();
-        QDomElement thumbElement = domDoc.elementsByTagName("thumb").at(i).toElement();
 
-        if (parentTag == "tvshow") {
-            showThumb(thumbElement);
+        m_show.ratings().setOrAddRating(rating);
+        m_show.setChanged(true);
+    }
+}
 
-        } else if (parentTag == "fanart") {
-            QString url = domDoc.elementsByTagName("thumb").at(i).parentNode().toElement().attribute("url");
-            showFanartThumb(thumbElement, url);
+void TvShowXmlReader::parseActor(QXmlStreamReader& reader)
+{
+    Actor a;
+    a.imageHasChanged = false;
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("name")) {
+            a.name = reader.readElementText();
+        } else if (reader.name() == QLatin1String("role")) {
+            a.role = reader.readElementText();
+        } else if (reader.name() == QLatin1String("thumb")) {
+            a.thumb = reader.readElementText();
+        } else if (reader.name() == QLatin1String("order")) {
+            a.order = reader.readElementText().toInt();
+        } else {
+            reader.skipCurrentElement();
         }
     }
+    m_show.addActor(a);
+}
 
-    QFileInfo fi(m_show.dir().filePath("theme.mp3"));
-    m_show.setHasTune(fi.isFile());
+void TvShowXmlReader::parseEpisodeGuide(QXmlStreamReader& reader)
+{
+    bool hasUrl = false;
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("url") && !hasUrl) {
+            m_show.setEpisodeGuideUrl(reader.readElementText());
+            hasUrl = true;
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
 }
 
-void TvShowXmlReader::showThumb(const QDomElement& element)
+void TvShowXmlReader::showThumb(QXmlStreamReader& reader)
 {
-    QString aspect = element.attribute("aspect", "poster").toLower().trimmed();
+    const QXmlStreamAttributes attributes = reader.attributes();
+    const QString aspect =
+        attributes.hasAttribute("aspect") ? attributes.value("aspect").toString().toLower().trimmed() : "poster";
 
     Poster p;
-    p.originalUrl = QUrl(element.text());
-    p.thumbUrl = element.attribute("preview");
-    p.language = element.attribute("language");
+    p.thumbUrl = attributes.value("preview").toString();
+    p.language = attributes.value("language").toString();
     p.aspect = aspect;
+    p.originalUrl = QUrl(reader.readElementText());
 
-    if (element.hasAttribute("type") && element.attribute("type").toLower() == "season") {
-        SeasonNumber season = SeasonNumber(element.attribute("season").toInt());
+    if (attributes.hasAttribute("type") && attributes.value("type").toString().toLower() == "season") {
+        SeasonNumber season = SeasonNumber(attributes.value("season").toString().toInt());
         if (season != SeasonNumber::NoSeason) {
             p.season = season;
             if (aspect == "banner") {
@@ -260,22 +312,32 @@ void TvShowXmlReader::showThumb(const QDomElement& element)
     m_show.addPoster(p);
 }
 
-void TvShowXmlReader::showFanartThumb(const QDomElement& element, QString thumbUrl)
+void TvShowXmlReader::parseFanart(QXmlStreamReader& reader)
 {
-    Poster p;
-    p.originalUrl = QUrl(thumbUrl + element.text());
-    if (!element.attribute("preview").isEmpty()) {
-        p.thumbUrl = QUrl(thumbUrl + element.attribute("preview"));
-    }
-    QStringList dimensions = element.attribute("dim").split("x");
-    if (dimensions.size() == 2) {
-        QSize size;
-        size.setWidth(dimensions.first().toInt());
-        size.setHeight(dimensions.last().toInt());
-        p.originalSize = size;
-    }
+    const QString thumbUrl = reader.attributes().value("url").toString();
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("thumb")) {
+            reader.skipCurrentElement();
+            continue;
+        }
+
+        const QXmlStreamAttributes attributes = reader.attributes();
+        Poster p;
+        if (!attributes.value("preview").isEmpty()) {
+            p.thumbUrl = QUrl(thumbUrl + attributes.value("preview").toString());
+        }
+        QStringList dimensions = attributes.value("dim").toString().split("x");
+        if (dimensions.size() == 2) {
+            QSize size;
+            size.setWidth(dimensions.first().toInt());
+            size.setHeight(dimensions.last().toInt());
+            p.originalSize = size;
+        }
+        p.originalUrl = QUrl(thumbUrl + reader.readElementText());
 
-    m_show.addBackdrop(p);
+        m_show.addBackdrop(p);
+    }
 }
 
 } // namespace kodi
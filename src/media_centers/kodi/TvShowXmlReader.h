@@ -1,7 +1,7 @@
 #pragma once
 
-#include <QDomDocument>
 #include <QString>
+#include <QXmlStreamReader>
 
 class TvShow;
 
@@ -12,11 +12,16 @@ class TvShowXmlReader
 {
 public:
     explicit TvShowXmlReader(TvShow& tvShow);
-    void parseNfoDom(QDomDocument domDoc);
+    void parse(QXmlStreamReader& reader);
 
 private:
-    void showThumb(const QDomElement& element);
-    void showFanartThumb(const QDomElement& element, QString thumbUrl);
+    void parseTvShow(QXmlStreamReader& reader);
+    void setUniqueId(const QString& type, const QString& value);
+    void parseRatings(QXmlStreamReader& reader);
+    void parseActor(QXmlStreamReader& reader);
+    void parseEpisodeGuide(QXmlStreamReader& reader);
+    void parseFanart(QXmlStreamReader& reader);
+    void showThumb(QXmlStreamReader& reader);
 
     TvShow& m_show;
 };
@@ -9,6 +9,7 @@
 #include "globals/Helper.h"
 #include "log/Log.h"
 #include "media_centers/MediaCenterInterface.h"
+#include "movies/MovieDuplicateIndex.h"
 #include "settings/Settings.h"
 
 using namespace std::chrono_literals;
@@ -520,6 +521,7 @@ QStringList Movie::tags() const
 void Movie::setName(QString name)
 {
     m_name = std::move(name);
+    m_sortKey.invalidate();
     setChanged(true);
 }
 
@@ -531,6 +533,7 @@ void Movie::setName(QString name)
 void Movie::setSortTitle(QString sortTitle)
 {
     m_sortTitle = std::move(sortTitle);
+    m_sortKey.invalidate();
     setChanged(true);
 }
 
@@ -947,9 +950,20 @@ void Movie::removeTag(QString tag)
 }
 
 bool Movie::hasLocalTrailer() const
+{
+    return m_hasLocalTrailer;
+}
+
+void Movie::setHasLocalTrailer(bool hasTrailer)
+{
+    m_hasLocalTrailer = hasTrailer;
+}
+
+void Movie::updateHasLocalTrailer()
 {
     if (files().isEmpty()) {
-        return false;
+        m_hasLocalTrailer = false;
+        return;
     }
     QFileInfo fi(files().first().toString());
     const QString baseName = fi.completeBaseName();
@@ -960,9 +974,14 @@ bool Movie::hasLocalTrailer() const
     QDir dir(fi.canonicalPath());
     const QStringList entries = dir.entryList({trailerFilter});
     const auto found = std::find_if(entries.cbegin(), entries.cend(), [&baseName](const QString& entry) { //
-        return entry.startsWith(baseName);
+        return isLocalTrailerOf(baseName, entry);
     });
-    return found != entries.cend();
+    m_hasLocalTrailer = (found != entries.cend());
+}
+
+bool Movie::isLocalTrailerOf(const QString& movieBaseName, const QString& fileName)
+{
+    return fileName.startsWith(movieBaseName) && fileName.contains(QStringLiteral("-trailer"), Qt::CaseInsensitive);
 }
 
 QString Movie::localTrailerFileName() const
@@ -1030,6 +1049,11 @@ bool Movie::lessThan(Movie* a, Movie* b)
     return (QString::localeAwareCompare(helper::appendArticle(a->name()), helper::appendArticle(b->name())) < 0);
 }
 
+const QCollatorSortKey& Movie::sortKey() const
+{
+    return m_sortKey.key([this]() { return m_sortTitle.isEmpty() ? helper::appendArticle(m_name) : m_sortTitle; });
+}
+
 QVector<ImageType> Movie::imageTypes()
 {
     return {ImageType::MoviePoster,
@@ -1101,7 +1125,10 @@ MovieDuplicate Movie::duplicateProperties(Movie* movie) const
     MovieDuplicate md;
     md.imdbId = movie->imdbId().isValid() && movie->imdbId() == imdbId();
     md.tmdbId = movie->tmdbId().isValid() && movie->tmdbId() == tmdbId();
-    md.title = !movie->name().isEmpty() && movie->name() == name();
+    // Same title comparison as used by MovieDuplicateIndex
+    const QString titleKey = MovieDuplicateIndex::keysFor(MovieDuplicateIndex::movieData(*this)).title;
+    md.title = !titleKey.isEmpty()
+               && titleKey == MovieDuplicateIndex::keysFor(MovieDuplicateIndex::movieData(*movie)).title;
 
     return md;
 }
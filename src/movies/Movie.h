@@ -7,6 +7,7 @@
 #include "data/StreamDetails.h"
 #include "data/Subtitle.h"
 #include "data/TmdbId.h"
+#include "globals/CachedSortKey.h"
 #include "globals/Globals.h"
 #include "movies/MovieController.h"
 #include "movies/MovieCrew.h"
@@ -88,6 +89,8 @@ public:
     QString nfoContent() const;
     int databaseId() const;
     bool syncNeeded() const;
+    /// \brief Whether there is a "<movie>-trailer.*" file next to the movie.
+    /// \details The value is cached, see updateHasLocalTrailer(); it does not access the disk.
     bool hasLocalTrailer() const;
     QDateTime dateAdded() const;
     mediaelch::ResumeTime resumeTime() const;
@@ -135,6 +138,9 @@ public:
     void setSyncNeeded(bool syncNeeded);
     void setDateAdded(QDateTime date);
     void setResumeTime(mediaelch::ResumeTime time);
+    void setHasLocalTrailer(bool hasTrailer);
+    /// \brief Lists the movie's directory and updates hasLocalTrailer().
+    void updateHasLocalTrailer();
 
     void removeActor(Actor* actor);
     void removeCountry(QString* country);
@@ -152,7 +158,12 @@ public:
     void setDiscType(DiscType type);
 
     static bool lessThan(Movie* a, Movie* b);
+    /// \brief Collation key of the sort title or, if there is none, of the name.
+    /// \details Cached until the name or sort title changes; used by MovieProxyModel.
+    const QCollatorSortKey& sortKey() const;
     static QVector<ImageType> imageTypes();
+    /// \brief Whether the given file name is a local trailer of a movie file with the given base name.
+    static bool isLocalTrailerOf(const QString& movieBaseName, const QString& fileName);
 
     QVector<Subtitle*> subtitles() const;
     void setSubtitles(const QVector<Subtitle*>& subtitles);
@@ -207,6 +218,8 @@ private:
     bool m_syncNeeded = false;
     bool m_streamDetailsLoaded = false;
     bool m_hasDuplicates = false;
+    bool m_hasLocalTrailer = false;
+    CachedSortKey m_sortKey;
     StreamDetails* m_streamDetails;
     QDateTime m_fileLastModified;
     QString m_nfoContent;
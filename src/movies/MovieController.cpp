@@ -6,12 +6,15 @@
 #include <QtCore/qmath.h>
 #include <chrono>
 
+#include "data/DatabaseRecord.h"
 #include "data/ImageCache.h"
+#include "data/MediaInfoIndexer.h"
 #include "file/NameFormatter.h"
 #include "globals/DownloadManager.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "media_centers/MediaCenterInterface.h"
+#include "media_centers/SaveQueue.h"
 #include "movies/Movie.h"
 #include "scrapers/movie/MovieScraper.h"
 #include "scrapers/movie/custom/CustomMovieScraper.h"
@@ -46,13 +49,32 @@ MovieController::MovieController(Movie* parent) :
 }
 
 bool MovieController::saveData(MediaCenterInterface* mediaCenterInterface)
+{
+    prepareSave();
+    bool saved = mediaCenterInterface->saveMovie(m_movie);
+    qCDebug(generic) << "[MovieController] Saved movie? =>" << saved;
+    onSaved(saved);
+    return saved;
+}
+
+int MovieController::saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue)
+{
+    prepareSave();
+    mediaelch::SaveJob job;
+    const bool created = mediaCenterInterface->createSaveJob(m_movie, job);
+    onSaved(created);
+    return created ? queue.enqueue(std::move(job)) : -1;
+}
+
+void MovieController::prepareSave()
 {
     if (!m_movie->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
         loadStreamDetailsFromFile();
     }
-    bool saved = mediaCenterInterface->saveMovie(m_movie);
+}
 
-    qCDebug(generic) << "[MovieController] Saved movie? =>" << saved;
+void MovieController::onSaved(bool saved)
+{
     if (!m_infoLoaded) {
         m_infoLoaded = saved;
     }
@@ -63,7 +85,6 @@ bool MovieController::saveData(MediaCenterInterface* mediaCenterInterface)
     for (Subtitle* subtitle : m_movie->subtitles()) {
         subtitle->setChanged(false);
     }
-    return saved;
 }
 
 bool MovieController::loadData(MediaCenterInterface* mediaCenterInterface, bool force, bool reloadFromNfo)
@@ -136,6 +157,17 @@ bool MovieController::loadData(MediaCenterInterface* mediaCenterInterface, bool
     return infoLoaded;
 }
 
+bool MovieController::loadDataFromRecord(const QByteArray& record)
+{
+    m_movie->blockSignals(true);
+    const bool infoLoaded = mediaelch::deserializeMovieRecord(record, *m_movie);
+    m_infoLoaded = infoLoaded;
+    m_infoFromNfoLoaded = false;
+    m_movie->setChanged(false);
+    m_movie->blockSignals(false);
+    return infoLoaded;
+}
+
 void MovieController::loadData(QHash<mediaelch::scraper::MovieScraper*, mediaelch::scraper::MovieIdentifier> ids,
     mediaelch::scraper::MovieScraper* scraperInterface,
     QSet<MovieScraperInfo> infos)
@@ -155,10 +187,15 @@ void MovieController::loadData(QHash<mediaelch::scraper::MovieScraper*, mediaelc
 }
 
 void MovieController::loadStreamDetailsFromFile()
+{
+    applyStreamDetails(mediaelch::MediaInfoIndexer::load(m_movie->streamDetails()->files()));
+}
+
+void MovieController::applyStreamDetails(const StreamDetails::Values& values)
 {
     using namespace std::chrono;
     using namespace std::chrono_literals;
-    m_movie->streamDetails()->loadStreamDetails();
+    m_movie->streamDetails()->setValues(values);
     seconds runtime =
         seconds(m_movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds).toInt());
     if (runtime > 0s) {
@@ -417,6 +454,11 @@ void MovieController::abortDownloads()
     m_downloadManager->abortDownloads();
 }
 
+void MovieController::setDownloadPriority(mediaelch::network::DownloadScheduler::Priority priority)
+{
+    m_downloadManager->setPriority(priority);
+}
+
 void MovieController::setLoadsLeft(QVector<ScraperData> loadsLeft)
 {
     m_loadDoneFired = false;
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "data/StreamDetails.h"
 #include "globals/DownloadManagerElement.h"
 #include "globals/Poster.h"
 #include "globals/ScraperInfos.h"
+#include "network/DownloadScheduler.h"
 #include "scrapers/ScraperError.h"
 #include "scrapers/movie/MovieIdentifier.h"
 
@@ -16,6 +18,7 @@ class MediaCenterInterface;
 class Movie;
 
 namespace mediaelch {
+class SaveQueue;
 namespace scraper {
 class MovieScraper;
 }
@@ -31,6 +34,11 @@ public:
     /// \param mediaCenterInterface MediaCenterInterface to use for saving
     /// \return Saving was successful or not
     bool saveData(MediaCenterInterface* mediaCenterInterface);
+    /// \brief   Saves the movie in a worker thread of the given queue.
+    /// \details The movie is updated as if saveData() was successful.
+    /// \return  ID of the save job, see SaveQueue::sigJobFinished(), or -1 if the
+    ///          movie cannot be saved.
+    int saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue);
 
     /// \brief Loads the movies infos with the given MediaCenterInterface
     /// \param mediaCenterInterface MediaCenterInterface to use for loading
@@ -38,6 +46,10 @@ public:
     /// \return Loading was successful or not
     bool loadData(MediaCenterInterface* mediaCenterInterface, bool force = false, bool reloadFromNfo = true);
 
+    /// \brief Loads the movies infos from a database record, see mediaelch::deserializeMovieRecord()
+    /// \return Loading was successful or not. If not, loadData() has to be used.
+    bool loadDataFromRecord(const QByteArray& record);
+
     /// \brief Loads the movies info from a scraper
     /// \param ids Id of the movie within the given ScraperInterface
     /// \param scraperInterface ScraperInterface to use for loading
@@ -47,6 +59,9 @@ public:
         QSet<MovieScraperInfo> infos);
 
     void loadStreamDetailsFromFile();
+    /// \brief Sets stream details loaded by MediaInfoIndexer, e.g. in the background, and
+    ///        updates the runtime like loadStreamDetailsFromFile().
+    void applyStreamDetails(const StreamDetails::Values& values);
 
     /// \brief Called when a ScraperInterface has finished loading
     ///        Emits the loaded signal
@@ -65,6 +80,8 @@ public:
     void loadImage(ImageType type, QUrl url);
     void loadImages(ImageType type, QVector<QUrl> urls);
     void abortDownloads();
+    /// \brief Priority of the movie's image downloads, e.g. higher while it is shown.
+    void setDownloadPriority(mediaelch::network::DownloadScheduler::Priority priority);
     void setLoadsLeft(QVector<ScraperData> loadsLeft);
     void removeFromLoadsLeft(ScraperData load);
     void setInfosToLoad(QSet<MovieScraperInfo> infos);
@@ -89,6 +106,9 @@ private slots:
     void onDownloadFinished(DownloadManagerElement elem);
 
 private:
+    void prepareSave();
+    void onSaved(bool saved);
+
     Movie* m_movie;
     bool m_infoLoaded;
     bool m_infoFromNfoLoaded;
@@ -0,0 +1,309 @@
+#include "movies/MovieDuplicateIndex.h"
+
+#include "globals/Meta.h"
+#include "movies/Movie.h"
+
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+namespace {
+
+void insertIntoGroup(QHash<QString, QVector<Movie*>>& groups, const QString& key, Movie* movie)
+{
+    if (!key.isEmpty()) {
+        groups[key].append(movie);
+    }
+}
+
+void removeFromGroup(QHash<QString, QVector<Movie*>>& groups,
+    const QString& key,
+    Movie* movie,
+    QSet<Movie*>& affected)
+{
+    if (key.isEmpty()) {
+        return;
+    }
+    auto group = groups.find(key);
+    if (group == groups.end()) {
+        return;
+    }
+    group->removeOne(movie);
+    if (group->isEmpty()) {
+        groups.erase(group);
+        return;
+    }
+    for (Movie* other : asConst(*group)) {
+        affected.insert(other);
+    }
+}
+
+bool hasOtherMovies(const QHash<QString, QVector<Movie*>>& groups, const QString& key)
+{
+    if (key.isEmpty()) {
+        return false;
+    }
+    auto group = groups.constFind(key);
+    return group != groups.constEnd() && group->size() > 1;
+}
+
+} // namespace
+
+MovieDuplicateIndex::MovieDuplicateIndex(QObject* parent) : QObject(parent)
+{
+}
+
+void MovieDuplicateIndex::rebuild(const QVector<Movie*>& movies)
+{
+    // Movie objects must only be accessed in the GUI thread; copy the data
+    // that is needed to build the index.  This is cheap compared to grouping.
+    QVector<MovieData> data;
+    data.reserve(movies.size());
+    for (Movie* movie : movies) {
+        data.append(movieData(*movie));
+    }
+
+    ++m_generation;
+    m_isRebuilding = true;
+    m_pendingChanged.clear();
+    m_pendingRemoved.clear();
+
+    const quint64 generation = m_generation;
+    auto* watcher = new QFutureWatcher<Groups>(this);
+    connect(watcher, &QFutureWatcher<Groups>::finished, this, [this, watcher, generation]() {
+        onIndexBuilt(generation, watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([data]() { return buildIndex(data); }));
+}
+
+void MovieDuplicateIndex::onIndexBuilt(quint64 generation, Groups groups)
+{
+    if (generation != m_generation) {
+        // clear() or rebuild() was called in the meantime.
+        return;
+    }
+
+    m_groups = std::move(groups);
+    m_isRebuilding = false;
+
+    // Apply all changes that happened while the index was built.
+    QSet<Movie*> affected;
+    for (Movie* movie : asConst(m_pendingRemoved)) {
+        removeKeys(movie, affected);
+    }
+    for (Movie* movie : asConst(m_pendingChanged)) {
+        removeKeys(movie, affected);
+        insertKeys(movie, keysFor(movieData(*movie)));
+    }
+    m_pendingChanged.clear();
+    m_pendingRemoved.clear();
+
+    QSet<Movie*> all;
+    all.reserve(m_groups.keys.size());
+    for (auto it = m_groups.keys.constBegin(); it != m_groups.keys.constEnd(); ++it) {
+        all.insert(it.key());
+    }
+    updateDuplicateFlags(all);
+
+    emit sigRebuilt();
+}
+
+void MovieDuplicateIndex::addMovie(Movie* movie)
+{
+    if (m_isRebuilding) {
+        m_pendingRemoved.remove(movie);
+        m_pendingChanged.insert(movie);
+    }
+    QSet<Movie*> affected;
+    removeKeys(movie, affected);
+    const Keys keys = keysFor(movieData(*movie));
+    insertKeys(movie, keys);
+    groupsOf(movie, keys, affected);
+    updateDuplicateFlags(affected);
+}
+
+void MovieDuplicateIndex::removeMovie(Movie* movie)
+{
+    if (m_isRebuilding) {
+        m_pendingChanged.remove(movie);
+        m_pendingRemoved.insert(movie);
+    }
+    QSet<Movie*> affected;
+    removeKeys(movie, affected);
+    updateDuplicateFlags(affected);
+}
+
+void MovieDuplicateIndex::updateMovie(Movie* movie)
+{
+    if (m_isRebuilding) {
+        // The movie may have changed after its data was copied for the rebuild.
+        m_pendingChanged.insert(movie);
+    }
+    auto existing = m_groups.keys.constFind(movie);
+    if (existing == m_groups.keys.constEnd()) {
+        // Not part of the index, e.g. because it was never added.
+        return;
+    }
+    const Keys keys = keysFor(movieData(*movie));
+    if (keys == *existing) {
+        return;
+    }
+    addMovie(movie);
+}
+
+void MovieDuplicateIndex::clear()
+{
+    ++m_generation;
+    m_isRebuilding = false;
+    m_pendingChanged.clear();
+    m_pendingRemoved.clear();
+    m_groups = Groups{};
+}
+
+QVector<Movie*> MovieDuplicateIndex::duplicatesOf(Movie* movie) const
+{
+    QVector<Movie*> result{movie};
+    auto keys = m_groups.keys.constFind(movie);
+    if (keys == m_groups.keys.constEnd()) {
+        return result;
+    }
+
+    QSet<Movie*> seen{movie};
+    const auto appendGroup = [&](const QHash<QString, QVector<Movie*>>& groups, const QString& key) {
+        if (key.isEmpty()) {
+            return;
+        }
+        for (Movie* other : groups.value(key)) {
+            if (!seen.contains(other)) {
+                seen.insert(other);
+                result.append(other);
+            }
+        }
+    };
+    appendGroup(m_groups.byImdbId, keys->imdbId);
+    appendGroup(m_groups.byTmdbId, keys->tmdbId);
+    appendGroup(m_groups.byTitle, keys->title);
+    return result;
+}
+
+bool MovieDuplicateIndex::hasDuplicates(Movie* movie) const
+{
+    auto keys = m_groups.keys.constFind(movie);
+    if (keys == m_groups.keys.constEnd()) {
+        return false;
+    }
+    return hasOtherMovies(m_groups.byImdbId, keys->imdbId)    //
+           || hasOtherMovies(m_groups.byTmdbId, keys->tmdbId) //
+           || hasOtherMovies(m_groups.byTitle, keys->title);
+}
+
+MovieDuplicateIndex::MovieData MovieDuplicateIndex::movieData(const Movie& movie)
+{
+    MovieData data;
+    data.movie = const_cast<Movie*>(&movie);
+    if (movie.imdbId().isValid()) {
+        data.imdbId = movie.imdbId().toString();
+    }
+    if (movie.tmdbId().isValid()) {
+        data.tmdbId = movie.tmdbId().toString();
+    }
+    data.name = movie.name();
+    data.year = movie.released().isValid() ? movie.released().year() : 0;
+    return data;
+}
+
+MovieDuplicateIndex::Keys MovieDuplicateIndex::keysFor(const MovieData& data)
+{
+    Keys keys;
+    keys.imdbId = data.imdbId;
+    keys.tmdbId = data.tmdbId;
+    keys.title = titleKey(data.name, data.year);
+    return keys;
+}
+
+MovieDuplicateIndex::Groups MovieDuplicateIndex::buildIndex(const QVector<MovieData>& movies)
+{
+    Groups groups;
+    groups.keys.reserve(movies.size());
+    for (const MovieData& data : movies) {
+        const Keys keys = keysFor(data);
+        groups.keys.insert(data.movie, keys);
+        insertIntoGroup(groups.byImdbId, keys.imdbId, data.movie);
+        insertIntoGroup(groups.byTmdbId, keys.tmdbId, data.movie);
+        insertIntoGroup(groups.byTitle, keys.title, data.movie);
+    }
+    return groups;
+}
+
+QString MovieDuplicateIndex::normalizedTitle(const QString& title)
+{
+    // Decompose characters so that diacritics become separate marks that are dropped below.
+    const QString decomposed = title.normalized(QString::NormalizationForm_KD);
+    QString normalized;
+    normalized.reserve(decomposed.size());
+    for (const QChar c : decomposed) {
+        if (c.isLetterOrNumber()) {
+            normalized.append(c.toCaseFolded());
+        }
+    }
+    if (normalized.isEmpty()) {
+        // Titles without any letters or digits are compared as they are.
+        return title.trimmed();
+    }
+    return normalized;
+}
+
+QString MovieDuplicateIndex::titleKey(const QString& title, int year)
+{
+    const QString normalized = normalizedTitle(title);
+    if (normalized.isEmpty()) {
+        return {};
+    }
+    return QStringLiteral("%1|%2").arg(normalized).arg(year);
+}
+
+void MovieDuplicateIndex::insertKeys(Movie* movie, const Keys& keys)
+{
+    m_groups.keys.insert(movie, keys);
+    insertIntoGroup(m_groups.byImdbId, keys.imdbId, movie);
+    insertIntoGroup(m_groups.byTmdbId, keys.tmdbId, movie);
+    insertIntoGroup(m_groups.byTitle, keys.title, movie);
+}
+
+void MovieDuplicateIndex::removeKeys(Movie* movie, QSet<Movie*>& affected)
+{
+    auto keys = m_groups.keys.find(movie);
+    if (keys == m_groups.keys.end()) {
+        return;
+    }
+    removeFromGroup(m_groups.byImdbId, keys->imdbId, movie, affected);
+    removeFromGroup(m_groups.byTmdbId, keys->tmdbId, movie, affected);
+    removeFromGroup(m_groups.byTitle, keys->title, movie, affected);
+    m_groups.keys.erase(keys);
+}
+
+void MovieDuplicateIndex::groupsOf(Movie* movie, const Keys& keys, QSet<Movie*>& result) const
+{
+    result.insert(movie);
+    const auto insertGroup = [&result](const QHash<QString, QVector<Movie*>>& groups, const QString& key) {
+        if (key.isEmpty()) {
+            return;
+        }
+        for (Movie* other : groups.value(key)) {
+            result.insert(other);
+        }
+    };
+    insertGroup(m_groups.byImdbId, keys.imdbId);
+    insertGroup(m_groups.byTmdbId, keys.tmdbId);
+    insertGroup(m_groups.byTitle, keys.title);
+}
+
+void MovieDuplicateIndex::updateDuplicateFlags(const QSet<Movie*>& movies)
+{
+    for (Movie* movie : movies) {
+        // Movies that were removed from the index must not be accessed anymore.
+        if (m_groups.keys.contains(movie)) {
+            movie->setHasDuplicates(hasDuplicates(movie));
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+class Movie;
+
+/// \brief Index of movies that share an IMDb ID, TMDb ID or title+year.
+///
+/// Movies are grouped by each of their keys.  A movie has duplicates if any of
+/// its groups contains another movie.  The index is built in a background
+/// thread using rebuild() and is updated incrementally using addMovie(),
+/// removeMovie() and updateMovie().  Movie::hasDuplicates() is kept in sync.
+class MovieDuplicateIndex : public QObject
+{
+    Q_OBJECT
+public:
+    /// \brief Duplicate keys of a single movie. Empty keys are not indexed.
+    struct Keys
+    {
+        QString imdbId;
+        QString tmdbId;
+        /// \brief Normalized title and release year, see titleKey().
+        QString title;
+
+        bool operator==(const Keys& other) const
+        {
+            return imdbId == other.imdbId && tmdbId == other.tmdbId && title == other.title;
+        }
+        bool operator!=(const Keys& other) const { return !(*this == other); }
+    };
+
+    /// \brief Raw movie data that can be turned into Keys in another thread.
+    struct MovieData
+    {
+        Movie* movie = nullptr;
+        QString imdbId;
+        QString tmdbId;
+        QString name;
+        int year = 0;
+    };
+
+    /// \brief Result of buildIndex(). Movies are stored in the order of the input.
+    struct Groups
+    {
+        QHash<Movie*, Keys> keys;
+        QHash<QString, QVector<Movie*>> byImdbId;
+        QHash<QString, QVector<Movie*>> byTmdbId;
+        QHash<QString, QVector<Movie*>> byTitle;
+    };
+
+public:
+    explicit MovieDuplicateIndex(QObject* parent = nullptr);
+    ~MovieDuplicateIndex() override = default;
+
+    /// \brief Rebuilds the whole index from the given movies in a background thread.
+    /// \details sigRebuilt() is emitted once the index is ready.  Changes that are
+    ///          reported while the index is rebuilt are applied afterwards.
+    void rebuild(const QVector<Movie*>& movies);
+    bool isRebuilding() const { return m_isRebuilding; }
+
+    void addMovie(Movie* movie);
+    void removeMovie(Movie* movie);
+    /// \brief Re-indexes the movie if one of its keys has changed.
+    void updateMovie(Movie* movie);
+    void clear();
+
+    /// \brief All movies that share at least one key with the given movie.
+    /// \details The given movie is the first entry. If it has no duplicates,
+    ///          only the movie itself is returned.
+    QVector<Movie*> duplicatesOf(Movie* movie) const;
+    bool hasDuplicates(Movie* movie) const;
+
+    static MovieData movieData(const Movie& movie);
+    static Keys keysFor(const MovieData& data);
+    /// \brief Groups the given movies by their keys. Does not access any Movie object.
+    static Groups buildIndex(const QVector<MovieData>& movies);
+
+    /// \brief Lowercase title without diacritics, punctuation and whitespace.
+    static QString normalizedTitle(const QString& title);
+    /// \brief Key used to compare titles: normalized title and year, or an empty
+    ///        string if the title is empty.
+    static QString titleKey(const QString& title, int year);
+
+signals:
+    void sigRebuilt();
+
+private:
+    void onIndexBuilt(quint64 generation, Groups groups);
+    void insertKeys(Movie* movie, const Keys& keys);
+    /// \brief Removes the movie from all groups. Affected movies are added to the given set.
+    void removeKeys(Movie* movie, QSet<Movie*>& affected);
+    void updateDuplicateFlags(const QSet<Movie*>& movies);
+    void groupsOf(Movie* movie, const Keys& keys, QSet<Movie*>& result) const;
+
+    Groups m_groups;
+    bool m_isRebuilding = false;
+    /// \brief Incremented by clear() and rebuild() to discard outdated results.
+    quint64 m_generation = 0;
+    /// \brief Movies that were added or changed during a rebuild.
+    QSet<Movie*> m_pendingChanged;
+    /// \brief Movies that were removed during a rebuild.
+    QSet<Movie*> m_pendingRemoved;
+};
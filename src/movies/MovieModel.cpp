@@ -15,6 +15,7 @@ MovieModel::MovieModel(QObject* parent) :
     QAbstractItemModel(parent), m_newIcon(QIcon(":/img/star_blue.png")), m_syncIcon(QIcon(":/img/reload_orange.png"))
 #endif
 {
+    m_duplicateIndex = new MovieDuplicateIndex(this);
 #ifndef Q_OS_WIN
     auto* font = new MyIconFont(this);
     font->initFontAwesome();
@@ -29,6 +30,7 @@ void MovieModel::addMovie(Movie* movie)
     m_movies.append(movie);
     endInsertRows();
     connect(movie, &Movie::sigChanged, this, &MovieModel::onMovieChanged, Qt::UniqueConnection);
+    m_duplicateIndex->addMovie(movie);
 }
 
 void MovieModel::addMovies(const QVector<Movie*>& movies)
@@ -39,6 +41,27 @@ void MovieModel::addMovies(const QVector<Movie*>& movies)
         connect(movie, &Movie::sigChanged, this, &MovieModel::onMovieChanged, Qt::UniqueConnection);
     }
     endInsertRows();
+    // Bulk inserts happen when loading the library; build the index in one pass.
+    m_duplicateIndex->rebuild(m_movies);
+}
+
+void MovieModel::removeMovie(Movie* movie)
+{
+    const int row = m_movies.indexOf(movie);
+    if (row < 0) {
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row);
+    m_movies.removeAt(row);
+    endRemoveRows();
+    m_duplicateIndex->removeMovie(movie);
+    emit sigMovieRemoved(movie);
+    movie->deleteLater();
+}
+
+void MovieModel::updateMovie(Movie* movie)
+{
+    onMovieChanged(movie);
 }
 
 /**
@@ -48,6 +71,7 @@ void MovieModel::addMovies(const QVector<Movie*>& movies)
  */
 void MovieModel::onMovieChanged(Movie* movie)
 {
+    m_duplicateIndex->updateMovie(movie);
     const QModelIndex index = createIndex(m_movies.indexOf(movie), 0);
     emit dataChanged(index, index);
 }
@@ -271,6 +295,7 @@ void MovieModel::clear()
         return;
     }
     beginRemoveRows(QModelIndex(), 0, m_movies.size() - 1);
+    m_duplicateIndex->clear();
     for (Movie* movie : asConst(m_movies)) {
         movie->deleteLater();
     }
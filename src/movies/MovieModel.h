@@ -1,6 +1,7 @@
 #pragma once
 
 #include "movies/Movie.h"
+#include "movies/MovieDuplicateIndex.h"
 
 #include <QAbstractItemModel>
 #include <QIcon>
@@ -58,19 +59,31 @@ public:
     Movie* movie(int row);
     void addMovie(Movie* movie);
     void addMovies(const QVector<Movie*>& movies);
+    /// \brief Removes the movie from the model and deletes it (deleteLater).
+    void removeMovie(Movie* movie);
+    /// \brief Notify views that the given movie's data has changed.
+    void updateMovie(Movie* movie);
     void update();
     void clear();
     int countNewMovies();
 
+    /// \brief Index of duplicate movies; kept up to date when movies are added, removed or changed.
+    MovieDuplicateIndex* duplicateIndex() { return m_duplicateIndex; }
+
     static int mediaStatusToColumn(MediaStatusColumn column);
     static QString mediaStatusToText(MediaStatusColumn column);
     static MediaStatusColumn columnToMediaStatus(int column);
 
+signals:
+    /// \brief Emitted by removeMovie() before the movie is deleted. Views must no longer use it.
+    void sigMovieRemoved(Movie* movie);
+
 private slots:
     void onMovieChanged(Movie* movie);
 
 private:
     QVector<Movie*> m_movies;
+    MovieDuplicateIndex* m_duplicateIndex = nullptr;
     QIcon m_newIcon;
     QIcon m_syncIcon;
 };
@@ -31,50 +31,50 @@ bool MovieProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceP
         }
     }
 
-    return !(m_filterDuplicates && !movies.at(sourceRow)->hasDuplicates());
+    // Movie::hasDuplicates() is kept up to date by MovieModel's MovieDuplicateIndex.
+    return !(m_filterDuplicates && !movie->hasDuplicates());
 }
 
 bool MovieProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
-    const QString leftTitle = sourceModel()->data(left, MovieModel::SortTitleRole).toString();
-    const QString rightTitle = sourceModel()->data(right, MovieModel::SortTitleRole).toString();
-    const int cmp = QString::localeAwareCompare(leftTitle, rightTitle);
+    // Called very often when sorting; access the movies directly instead of using QVariant roles.
+    auto* model = static_cast<MovieModel*>(sourceModel());
+    const Movie* leftMovie = model->movie(left.row());
+    const Movie* rightMovie = model->movie(right.row());
+    if (leftMovie == nullptr || rightMovie == nullptr) {
+        return leftMovie == nullptr && rightMovie != nullptr;
+    }
+
+    // The sort keys are cached per movie, so that this is a simple comparison.
+    const int cmp = leftMovie->sortKey().compare(rightMovie->sortKey());
 
     switch (m_sortBy) {
     case SortBy::Name: return (cmp < 0);
 
-    case SortBy::Added:
-        return sourceModel()->data(left, MovieModel::FileLastModifiedRole).toDateTime()
-               >= sourceModel()->data(right, MovieModel::FileLastModifiedRole).toDateTime();
+    case SortBy::Added: return leftMovie->fileLastModified() >= rightMovie->fileLastModified();
 
     case SortBy::Seen:
-        if (sourceModel()->data(left, MovieModel::HasWatchedRole).toBool()
-            && !sourceModel()->data(right, MovieModel::HasWatchedRole).toBool()) {
+        if (leftMovie->watched() && !rightMovie->watched()) {
             return false;
         }
-        if (!sourceModel()->data(left, MovieModel::HasWatchedRole).toBool()
-            && sourceModel()->data(right, MovieModel::HasWatchedRole).toBool()) {
+        if (!leftMovie->watched() && rightMovie->watched()) {
             return true;
         }
         // Otherwise sort by name because both are either seen or not.
         break;
 
     case SortBy::Year:
-        if (sourceModel()->data(left, MovieModel::ReleasedRole).toDate().year()
-            != sourceModel()->data(right, MovieModel::ReleasedRole).toDate().year()) {
-            return sourceModel()->data(left, MovieModel::ReleasedRole).toDate().year()
-                   >= sourceModel()->data(right, MovieModel::ReleasedRole).toDate().year();
+        if (leftMovie->released().year() != rightMovie->released().year()) {
+            return leftMovie->released().year() >= rightMovie->released().year();
         }
         // Otherwise sort by name because both have the same year.
         break;
 
     case SortBy::New:
-        if (sourceModel()->data(left, MovieModel::InfoLoadedRole).toBool()
-            && !sourceModel()->data(right, MovieModel::InfoLoadedRole).toBool()) {
+        if (leftMovie->controller()->infoLoaded() && !rightMovie->controller()->infoLoaded()) {
             return false;
         }
-        if (!sourceModel()->data(left, MovieModel::InfoLoadedRole).toBool()
-            && sourceModel()->data(right, MovieModel::InfoLoadedRole).toBool()) {
+        if (!leftMovie->controller()->infoLoaded() && rightMovie->controller()->infoLoaded()) {
             return true;
         }
         // Otherwise sort by name because both are new or not.
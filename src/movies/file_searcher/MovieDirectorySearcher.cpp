@@ -1,6 +1,7 @@
 #include "MovieDirectorySearcher.h"
 
 #include "data/Database.h"
+#include "file/DirectoryManifest.h"
 #include "file/FilenameUtils.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
@@ -8,9 +9,37 @@
 #include "file/FilenameUtils.h"
 
 #include <QMutexLocker>
+#include <QSet>
 #include <QtConcurrent>
+#include <algorithm>
 #include <memory>
 
+namespace {
+
+/// \brief Multiple MovieDiskLoaders may run in parallel. SQLite only supports one
+///        writer at a time, so we serialize all write transactions.
+QMutex s_databaseWriteMutex;
+
+/// \brief Loads the details of movies from the database.
+/// \details Movies with a valid database record are already loaded, see
+///          Database::moviesInDirectory().  Only entries of older MediaElch
+///          versions need to be parsed.
+void loadMoviesFromDatabaseContent(const QVector<Movie*>& movies)
+{
+    QVector<Movie*> moviesToParse;
+    for (Movie* movie : movies) {
+        if (!movie->controller()->infoLoaded()) {
+            moviesToParse.append(movie);
+        }
+    }
+    QtConcurrent::blockingMap(moviesToParse,
+        [](Movie* movie) { //
+            movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), false, false);
+        });
+}
+
+} // namespace
+
 namespace mediaelch {
 
 void MovieLoaderStore::addMovie(Movie* movie)
@@ -80,7 +109,27 @@ void MovieDiskLoader::start()
 
     emit progress(this, 0, 0);
     emit progressText(this, "");
-    loadMovieContents();
+
+    // Only directories that were added or changed since the last scan are listed.
+    // Movies in all other directories are loaded from the database.
+    const DirectoryPath rootDir(m_dir.path);
+    const DirectoryManifest previousManifest = m_db->movieDirectoryManifest(rootDir);
+    m_directoryDiff = diffDirectoryTree(rootDir.toString(), previousManifest, [this]() { return isAborted(); });
+    m_isFirstScan = previousManifest.isEmpty();
+
+    if (isAborted()) {
+        emit finished(this);
+        return;
+    }
+
+    QStringList directories = m_directoryDiff.changedDirs;
+    if (!m_isFirstScan) {
+        directories = loadUnchangedMovies();
+        qCInfo(c_movie) << "[Movie] Directories changed since last scan:" << directories.size() << "of"
+                        << m_directoryDiff.current.size();
+    }
+
+    loadMovieContents(directories);
 
     if (isAborted()) {
         emit finished(this);
@@ -107,109 +156,190 @@ void MovieDiskLoader::abort()
     m_aborted.store(true);
 }
 
-void MovieDiskLoader::loadMovieContents()
+QStringList MovieDiskLoader::loadUnchangedMovies()
 {
-    QDirIterator it(m_dir.path.path(),
-        m_filter.filters(),
-        QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files,
-        QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+    const QVector<Movie*> movies = m_db->moviesInDirectory(DirectoryPath(m_dir.path), nullptr);
 
-    QString lastDir;
+    // Directories of movies that are reloaded from disk; removed directories are included
+    // so that their movies are removed from the database.
+    QSet<QString> outdatedDirs;
+    for (const QString& dir : asConst(m_directoryDiff.changedDirs)) {
+        outdatedDirs.insert(dir);
+    }
+    for (const QString& dir : asConst(m_directoryDiff.removedDirs)) {
+        outdatedDirs.insert(dir);
+    }
 
-    while (it.hasNext()) {
-        if (isAborted()) {
-            return;
+    // A movie is outdated if its directory changed. The NFO and images of BluRay and DVD
+    // structures are stored in the parent directory, which must then be rescanned as well.
+    // Because other movies may be stored in that parent directory, repeat until no
+    // further directories are added.
+    QVector<bool> isOutdated(movies.size(), false);
+    bool hasNewDirs = true;
+    while (hasNewDirs) {
+        hasNewDirs = false;
+        for (int i = 0; i < movies.size(); ++i) {
+            const Movie* movie = movies.at(i);
+            if (isOutdated.at(i) || movie->files().isEmpty()) {
+                isOutdated[i] = true;
+                continue;
+            }
+            const QString movieDir = movie->files().first().dir().toString();
+            const QString discDir = movieDir.left(movieDir.lastIndexOf('/'));
+            const bool isDisc = movie->discType() != DiscType::Single;
+            if (!outdatedDirs.contains(movieDir) && !(isDisc && outdatedDirs.contains(discDir))) {
+                continue;
+            }
+            isOutdated[i] = true;
+            hasNewDirs = hasNewDirs || !outdatedDirs.contains(movieDir) || (isDisc && !outdatedDirs.contains(discDir));
+            outdatedDirs.insert(movieDir);
+            if (isDisc) {
+                outdatedDirs.insert(discDir);
+            }
         }
-        it.next();
+    }
 
-        QString dirName = it.fileInfo().dir().dirName();
-        QString fileName = it.fileName(); // may actually be a directory name
+    QVector<Movie*> unchangedMovies;
+    for (int i = 0; i < movies.size(); ++i) {
+        if (isOutdated.at(i)) {
+            m_outdatedMovieIds.append(movies.at(i)->databaseId());
+            delete movies.at(i);
+        } else {
+            unchangedMovies.append(movies.at(i));
+        }
+    }
 
-        const bool isFile = it.fileInfo().isFile();
-        const bool isDir = it.fileInfo().isDir();
-        bool isSpecialDir = false; // set to true for DVD or BluRay Structure
+    m_updatedDirectories = outdatedDirs.values();
 
-        if (isFile && Settings::instance()->advanced()->isFileExcluded(fileName)) {
-            continue;
-        }
+    if (m_skipUnchangedMovies) {
+        qDeleteAll(unchangedMovies);
+        unchangedMovies.clear();
+    }
 
-        // TODO: If there is a BluRay structure then the directory filter may not work
-        // because BDMV's parent directory is not listed.
-        if ((isDir && Settings::instance()->advanced()->isFolderExcluded(fileName))
-            || Settings::instance()->advanced()->isFolderExcluded(dirName)) {
-            continue;
-        }
+    loadMoviesFromDatabaseContent(unchangedMovies);
 
-        // Skips Extras files
-        if (isFile
-            && (fileName.contains("-trailer", Qt::CaseInsensitive)            //
-                || fileName.contains("-sample", Qt::CaseInsensitive)          //
-                || fileName.contains("-behindthescenes", Qt::CaseInsensitive) //
-                || fileName.contains("-deleted", Qt::CaseInsensitive)         //
-                || fileName.contains("-featurette", Qt::CaseInsensitive)      //
-                || fileName.contains("-interview", Qt::CaseInsensitive)       //
-                || fileName.contains("-scene", Qt::CaseInsensitive)           //
-                || fileName.contains("-short", Qt::CaseInsensitive))) {
-            continue;
-        }
+    if (isAborted()) {
+        qDeleteAll(unchangedMovies);
+        return {};
+    }
 
-        // Skip actors folder and all files inside it
-        if (QString::compare(".actors", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+    m_store->addMovies(unchangedMovies);
 
-        // Skip extras folder and all files inside it
-        if (QString::compare("extras", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
+    QStringList directories;
+    for (const QString& dir : asConst(outdatedDirs)) {
+        if (m_directoryDiff.current.contains(dir)) {
+            directories.append(dir);
         }
+    }
+    return directories;
+}
 
-        // Skip extra fanarts folder and all files inside it
-        if (QString::compare("extrafanart", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+void MovieDiskLoader::loadMovieContents(const QStringList& directories)
+{
+    QString lastDir;
 
-        // Skip extra thumbs folder and all files inside it
-        if (QString::compare("extrathumbs", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+    for (const QString& directory : directories) {
+        QDirIterator it(directory, m_filter.filters(), QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files);
+        while (it.hasNext()) {
+            if (isAborted()) {
+                return;
+            }
+            it.next();
 
-        // Skip BluRay backup folder
-        if (QString::compare("backup", dirName, Qt::CaseInsensitive) == 0
-            && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+            QString dirName = it.fileInfo().dir().dirName();
+            QString fileName = it.fileName(); // may actually be a directory name
+
+            const bool isFile = it.fileInfo().isFile();
+            const bool isDir = it.fileInfo().isDir();
+            bool isSpecialDir = false; // set to true for DVD or BluRay Structure
+
+            if (isFile && Settings::instance()->advanced()->isFileExcluded(fileName)) {
+                continue;
+            }
 
-        if (isFile && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
-            QDir bluRayDir(it.fileInfo().dir());
-            if (QString::compare(bluRayDir.dirName(), "BDMV", Qt::CaseInsensitive) == 0) {
-                bluRayDir.cdUp();
+            // TODO: If there is a BluRay structure then the directory filter may not work
+            // because BDMV's parent directory is not listed.
+            if ((isDir && Settings::instance()->advanced()->isFolderExcluded(fileName))
+                || Settings::instance()->advanced()->isFolderExcluded(dirName)) {
+                continue;
             }
-            m_bluRayDirectories << bluRayDir.path();
-            isSpecialDir = true;
-        }
-        if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
-            QDir videoDir(it.fileInfo().dir());
-            if (QString::compare(videoDir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0) {
-                videoDir.cdUp();
+
+            // Trailers are not movies, but they are remembered for Movie::hasLocalTrailer().
+            if (isFile && fileName.contains("-trailer", Qt::CaseInsensitive)) {
+                m_trailerFiles[it.fileInfo().path()].append(fileName);
+                continue;
             }
-            m_dvdDirectories << videoDir.path();
-            isSpecialDir = true;
-        }
 
-        const QString dirPath = it.fileInfo().path();
-        if (!m_contents.contains(dirPath)) {
-            m_contents.insert(dirPath, {});
-        }
-        if (isFile || isSpecialDir) {
-            m_contents[dirPath].append(it.filePath());
-            m_lastModifications.insert(it.filePath(), it.fileInfo().lastModified());
-        }
+            // Skips Extras files
+            if (isFile
+                && (fileName.contains("-sample", Qt::CaseInsensitive)             //
+                    || fileName.contains("-behindthescenes", Qt::CaseInsensitive) //
+                    || fileName.contains("-deleted", Qt::CaseInsensitive)         //
+                    || fileName.contains("-featurette", Qt::CaseInsensitive)      //
+                    || fileName.contains("-interview", Qt::CaseInsensitive)       //
+                    || fileName.contains("-scene", Qt::CaseInsensitive)           //
+                    || fileName.contains("-short", Qt::CaseInsensitive))) {
+                continue;
+            }
 
-        if (dirName != lastDir) {
-            lastDir = dirName;
-            // TODO: Use SignalThrottler
-            if (m_contents.count() % 40 == 0) {
-                emit progressText(this, dirName);
+            // Skip actors folder and all files inside it
+            if (QString::compare(".actors", dirName, Qt::CaseInsensitive) == 0) {
+                continue;
+            }
+
+            // Skip extras folder and all files inside it
+            if (QString::compare("extras", dirName, Qt::CaseInsensitive) == 0) {
+                continue;
+            }
+
+            // Skip extra fanarts folder and all files inside it
+            if (QString::compare("extrafanart", dirName, Qt::CaseInsensitive) == 0) {
+                continue;
+            }
+
+            // Skip extra thumbs folder and all files inside it
+            if (QString::compare("extrathumbs", dirName, Qt::CaseInsensitive) == 0) {
+                continue;
+            }
+
+            // Skip BluRay backup folder
+            if (QString::compare("backup", dirName, Qt::CaseInsensitive) == 0
+                && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
+                continue;
+            }
+
+            if (isFile && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
+                QDir bluRayDir(it.fileInfo().dir());
+                if (QString::compare(bluRayDir.dirName(), "BDMV", Qt::CaseInsensitive) == 0) {
+                    bluRayDir.cdUp();
+                }
+                m_bluRayDirectories << bluRayDir.path();
+                isSpecialDir = true;
+            }
+            if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
+                QDir videoDir(it.fileInfo().dir());
+                if (QString::compare(videoDir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0) {
+                    videoDir.cdUp();
+                }
+                m_dvdDirectories << videoDir.path();
+                isSpecialDir = true;
+            }
+
+            const QString dirPath = it.fileInfo().path();
+            if (!m_contents.contains(dirPath)) {
+                m_contents.insert(dirPath, {});
+            }
+            if (isFile || isSpecialDir) {
+                m_contents[dirPath].append(it.filePath());
+                m_lastModifications.insert(it.filePath(), it.fileInfo().lastModified());
+            }
+
+            if (dirName != lastDir) {
+                lastDir = dirName;
+                // TODO: Use SignalThrottler
+                if (m_contents.count() % 40 == 0) {
+                    emit progressText(this, dirName);
+                }
             }
         }
     }
@@ -265,6 +395,7 @@ void MovieDiskLoader::createMovie(QStringList files)
 
         movie->setChanged(false);
         movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
+        movie->setHasLocalTrailer(hasLocalTrailer(files.first()));
         if (discType == DiscType::Single) {
             QFileInfo mFi(files.first());
             const QList<QFileInfo> subFiles = mFi.dir().entryInfoList(
@@ -342,6 +473,7 @@ void MovieDiskLoader::createMovie(QStringList files)
             movie->setInSeparateFolder(m_dir.separateFolders);
             movie->setFileLastModified(m_lastModifications.value(it.value().at(0)));
             movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
+            movie->setHasLocalTrailer(hasLocalTrailer(stackedFiles.first()));
 
             // As this method is called in parallel, we may be in another thread.
             movie->moveToThread(thread());
@@ -359,6 +491,19 @@ void MovieDiskLoader::createMovie(QStringList files)
     }
 }
 
+bool MovieDiskLoader::hasLocalTrailer(const QString& movieFile) const
+{
+    const QFileInfo fi(movieFile);
+    const auto trailers = m_trailerFiles.constFind(fi.path());
+    if (trailers == m_trailerFiles.constEnd()) {
+        return false;
+    }
+    const QString baseName = fi.completeBaseName();
+    return std::any_of(trailers->cbegin(), trailers->cend(), [&baseName](const QString& trailer) { //
+        return Movie::isLocalTrailerOf(baseName, trailer);
+    });
+}
+
 void MovieDiskLoader::storeAndAddToDatabase()
 {
     if (isAborted()) {
@@ -368,15 +513,28 @@ void MovieDiskLoader::storeAndAddToDatabase()
     emit progress(this, 0, 0);
     emit progressText(this, tr("Storing movies in database..."));
 
+    QMutexLocker databaseLock(&s_databaseWriteMutex);
     m_db->transaction();
+    if (m_isFirstScan) {
+        // There may be entries of an older MediaElch version without a directory manifest.
+        m_db->clearMoviesInDirectory(DirectoryPath(m_dir.path));
+    }
+    for (int idMovie : asConst(m_outdatedMovieIds)) {
+        m_db->removeMovie(idMovie);
+    }
+    if (m_directoryDiff.hasChanges()) {
+        m_db->setMovieDirectoryManifest(DirectoryPath(m_dir.path), m_directoryDiff.current);
+    }
     for (Movie* movie : asConst(m_movies)) {
-        // See also: Use https://stackoverflow.com/a/47473949/1603627
-        // We do this in just one thread.
         movie->setLabel(m_db->getLabel(movie->files()));
-        m_db->addMovie(movie, DirectoryPath(m_dir.path));
-        m_store->addMovie(movie);
     }
+    // See also: Use https://stackoverflow.com/a/47473949/1603627
+    // We do this in just one thread.
+    m_db->addMovies(m_movies, DirectoryPath(m_dir.path));
     m_db->commit();
+    for (Movie* movie : asConst(m_movies)) {
+        m_store->addMovie(movie);
+    }
     m_movies.clear();
 }
 
@@ -400,10 +558,7 @@ void MovieDatabaseLoader::start()
     }
 
     // Note, this takes less than a few seconds. No need to check whether we're aborted or not.
-    QtConcurrent::blockingMap(movies,
-        [](Movie* movie) { //
-            movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), false, false);
-        });
+    loadMoviesFromDatabaseContent(movies);
 
     if (isAborted()) {
         emit finished(this);
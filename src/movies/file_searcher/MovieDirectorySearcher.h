@@ -1,5 +1,6 @@
 #pragma once
 
+#include "file/DirectoryManifest.h"
 #include "file/FileFilter.h"
 #include "globals/Globals.h"
 
@@ -54,6 +55,8 @@ public:
     virtual void abort() = 0;
     /// \brief Thread-safe way to check whether the MovieLoader was aborted.
     virtual bool isAborted() = 0;
+    /// \brief Store that loaded movies are added to.
+    MovieLoaderStore* store() const { return m_store; }
 
 signals:
     void progress(MovieLoader* job, int processed, int total);
@@ -70,7 +73,12 @@ protected:
 /// \brief Creates a thread and moves the worker to it. Auto deletes thread when worker is finished.
 QThread* createAutoDeleteThreadWithMovieLoader(MovieLoader* worker, QObject* threadParent);
 
-/// \brief Load movies from disk.
+/// \brief   Load movies from disk.
+/// \details The directory tree is compared to the manifest stored during the last
+///          scan. Only new or changed directories are listed and their movies are
+///          recreated. Movies in unchanged directories are loaded from the database.
+///          If there is no manifest, e.g. after the database was cleared, all
+///          directories are scanned.
 class MovieDiskLoader : public MovieLoader
 {
     Q_OBJECT
@@ -78,14 +86,30 @@ public:
     MovieDiskLoader(SettingsDir dir, MovieLoaderStore& store, FileFilter filter, QObject* parent = nullptr);
     ~MovieDiskLoader() override;
 
+    /// \brief   Do not add movies of unchanged directories to the store.
+    /// \details Used to update movies that are already part of the MovieModel.
+    void setSkipUnchangedMovies(bool skip) { m_skipUnchangedMovies = skip; }
+    /// \brief True if there was no manifest and all directories were scanned.
+    /// \details Only valid after the loader has finished.
+    bool isFullScan() const { return m_isFirstScan; }
+    /// \brief   Directories whose movies were reloaded or removed.
+    /// \details Only valid after the loader has finished.
+    QStringList updatedDirectories() const { return m_updatedDirectories; }
+
 public:
     void start() override;
     void abort() override;
     bool isAborted() override { return m_aborted.load(); }
 
 private:
-    void loadMovieContents();
+    /// \brief   Load all movies from the database that are not affected by changed directories.
+    /// \details Returns all directories that need to be scanned.
+    QStringList loadUnchangedMovies();
+    /// \brief Collect movie files in the given directories (not recursive).
+    void loadMovieContents(const QStringList& directories);
     void createMovie(QStringList files);
+    /// \brief Whether a trailer for the given movie file was found by loadMovieContents().
+    bool hasLocalTrailer(const QString& movieFile) const;
     /// \brief Store all loaded movies into the MovieLoaderStore and database.
     void storeAndAddToDatabase();
 
@@ -99,11 +123,20 @@ private:
     std::atomic_int m_processed{0};
     int m_approxTotal{0};
 
+    DirectoryManifestDiff m_directoryDiff;
+    /// \brief True if there is no manifest for the directory, i.e. it was never scanned.
+    bool m_isFirstScan = true;
+    QVector<int> m_outdatedMovieIds;
+    QStringList m_updatedDirectories;
+    bool m_skipUnchangedMovies = false;
+
     // TODO: Streamline, e.g. use one vector of directories with DiscType tags
     QHash<QString, QDateTime> m_lastModifications;
     QStringList m_bluRayDirectories;
     QStringList m_dvdDirectories;
     QMap<QString, QStringList> m_contents;
+    /// \brief File names of trailers per directory.
+    QHash<QString, QStringList> m_trailerFiles;
 };
 
 /// \brief Load movies from database
@@ -9,14 +9,16 @@
 
 #include <QApplication>
 #include <QDirIterator>
+#include <QSet>
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include <QStorageInfo>
 #include <QtConcurrent>
+#include <algorithm>
 
 namespace mediaelch {
 
-MovieFileSearcher::MovieFileSearcher(QObject* parent) :
-    QObject(parent), m_store{new MovieLoaderStore(this)}, m_aborted{false}
+MovieFileSearcher::MovieFileSearcher(QObject* parent) : QObject(parent), m_aborted{false}
 {
     connect(this, &MovieFileSearcher::started, this, [this]() { m_reloadTimer.start(); });
     connect(this, &MovieFileSearcher::finished, this, [this]() {
@@ -54,6 +56,7 @@ void MovieFileSearcher::reload(bool reloadFromDisk)
 
     qCInfo(c_movie) << "[Movies] Start reloading movies from" << (reloadFromDisk ? "disk" : "cache");
 
+    abortUpdate();
     m_aborted = false;
     m_running = true;
 
@@ -78,10 +81,16 @@ void MovieFileSearcher::reload(bool reloadFromDisk)
         return;
     }
 
+    m_directoryQueues.clear();
+    m_directoryCount = 0;
+    m_finishedDirectoryCount = 0;
+    m_finishedProgress = 0;
+
     for (SettingsDir movieDir : asConst(m_directories)) {
         if (!movieDir.disabled) {
             movieDir.autoReload = movieDir.autoReload || reloadFromDisk;
-            m_directoryQueue.enqueue(std::move(movieDir));
+            m_directoryQueues[deviceOf(movieDir)].enqueue(std::move(movieDir));
+            ++m_directoryCount;
         }
     }
 
@@ -90,28 +99,188 @@ void MovieFileSearcher::reload(bool reloadFromDisk)
 
 void MovieFileSearcher::onDirectoryLoaded(MovieLoader* job)
 {
-    // There is always only one job. Ensure that we don't mix up anything.
-    Q_ASSERT(job == m_currentJob);
-    m_currentJob = nullptr;
     job->deleteLater();
 
-    if (m_aborted || job->isAborted()) {
-        // To avoid changes to the model, _after_ the users aborts, don't add any
-        // movies to the model.
-        m_store->clear();
+    if (!m_jobs.contains(job) || m_aborted || job->isAborted()) {
+        // Job of an aborted reload.  To avoid changes to the model, _after_ the
+        // users aborts, don't add any movies to the model.
+        m_jobs.remove(job);
+        discardStore(job);
+        return;
+    }
+
+    const JobState state = m_jobs.take(job);
+    ++m_finishedDirectoryCount;
+    // Each finished directory counts at least as one unit.
+    m_finishedProgress += std::max(1, state.maxTotal);
 
-    } else {
-        // Note: This file searcher is the parent of all movies, but the model
-        //       handles them.
-        Manager::instance()->movieModel()->addMovies(m_store->takeAll(this));
-        loadNext();
+    // Note: This file searcher is the parent of all movies, but the model
+    //       handles them.
+    Manager::instance()->movieModel()->addMovies(job->store()->takeAll(this));
+    job->store()->deleteLater();
+    loadNext();
+}
+
+bool MovieFileSearcher::updateDirectory(const DirectoryPath& path)
+{
+    if (isRunning()) {
+        return false;
+    }
+
+    const auto dir = std::find_if(m_directories.cbegin(), m_directories.cend(), [&path](const SettingsDir& d) {
+        return !d.disabled && DirectoryPath(d.path) == path;
+    });
+    if (dir == m_directories.cend()) {
+        qCDebug(c_movie) << "[Movies] Not a movie directory, nothing to update:" << path;
+        return true;
     }
+
+    qCInfo(c_movie) << "[Movies] Updating movies in directory:" << path;
+
+    auto* loader = new MovieDiskLoader(*dir, *newStore(), Settings::instance()->advanced()->movieFilters(), nullptr);
+    loader->setSkipUnchangedMovies(true);
+    m_updateJob = loader;
+    m_updateDirectory = path;
+
+    QThread* thread = mediaelch::createAutoDeleteThreadWithMovieLoader(loader, this);
+    connect(loader, &MovieLoader::finished, this, &MovieFileSearcher::onDirectoryUpdated);
+    thread->start(QThread::LowPriority);
+    return true;
+}
+
+void MovieFileSearcher::onDirectoryUpdated(MovieLoader* job)
+{
+    job->deleteLater();
+
+    if (job != m_updateJob || job->isAborted()) {
+        // Job was aborted, e.g. by reload().
+        if (job == m_updateJob) {
+            m_updateJob = nullptr;
+        }
+        discardStore(job);
+        return;
+    }
+    m_updateJob = nullptr;
+
+    auto* loader = static_cast<MovieDiskLoader*>(job);
+    const bool isFullScan = loader->isFullScan();
+    const QStringList updatedDirectories = loader->updatedDirectories();
+    QSet<QString> updatedDirs;
+    for (const QString& dir : updatedDirectories) {
+        updatedDirs.insert(dir);
+    }
+
+    QHash<QString, Movie*> newMovies;
+    QVector<Movie*> addedMovies;
+    const QVector<Movie*> loadedMovies = job->store()->takeAll(this);
+    job->store()->deleteLater();
+    for (Movie* movie : loadedMovies) {
+        if (movie->files().isEmpty()) {
+            addedMovies.append(movie);
+        } else {
+            newMovies.insert(movie->files().first().toString(), movie);
+        }
+    }
+
+    // Match the reloaded movies with the ones in the model. Existing movie objects are kept
+    // because they may be shown or edited at the moment.
+    MovieModel* model = Manager::instance()->movieModel();
+    QVector<Movie*> removedMovies;
+    int updatedCount = 0;
+    const QVector<Movie*> movies = model->movies();
+    for (Movie* movie : movies) {
+        if (movie->files().isEmpty() || !m_updateDirectory.isParentFolderOf(movie->files().first().dir())) {
+            continue;
+        }
+        const QString movieDir = movie->files().first().dir().toString();
+        const QString discDir = movieDir.left(movieDir.lastIndexOf('/'));
+        const bool isDisc = movie->discType() != DiscType::Single;
+        if (!isFullScan && !updatedDirs.contains(movieDir) && !(isDisc && updatedDirs.contains(discDir))) {
+            continue;
+        }
+
+        Movie* newMovie = newMovies.take(movie->files().first().toString());
+        if (newMovie == nullptr) {
+            removedMovies.append(movie);
+            continue;
+        }
+
+        movie->setDatabaseId(newMovie->databaseId());
+        // Set by the disk loader only, loadData() does not touch them.
+        movie->setHasLocalTrailer(newMovie->hasLocalTrailer());
+        movie->setFileLastModified(newMovie->fileLastModified());
+        if (!movie->hasChanged()) {
+            movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
+        }
+        model->updateMovie(movie);
+        delete newMovie;
+        ++updatedCount;
+    }
+
+    for (Movie* movie : asConst(removedMovies)) {
+        model->removeMovie(movie);
+    }
+    addedMovies.append(newMovies.values().toVector());
+    if (!addedMovies.isEmpty()) {
+        model->addMovies(addedMovies);
+    }
+
+    qCInfo(c_movie) << "[Movies] Updated directory" << m_updateDirectory << "| added:" << addedMovies.size()
+                    << "| removed:" << removedMovies.size() << "| updated:" << updatedCount;
+    emit directoryUpdated(m_updateDirectory);
+}
+
+void MovieFileSearcher::abortUpdate()
+{
+    if (m_updateJob != nullptr) {
+        // The job still emits finished() which is handled in onDirectoryUpdated().
+        m_updateJob->abort();
+        m_updateJob = nullptr;
+    }
+}
+
+MovieLoaderStore* MovieFileSearcher::newStore()
+{
+    return new MovieLoaderStore(this);
+}
+
+void MovieFileSearcher::discardStore(MovieLoader* job)
+{
+    // The job does not use its store anymore once it has finished.
+    job->store()->clear();
+    job->store()->deleteLater();
 }
 
 void MovieFileSearcher::onProgress(MovieLoader* job, int processed, int total)
 {
-    Q_UNUSED(job)
-    emit progress(processed, total, Constants::MovieFileSearcherProgressMessageId);
+    auto it = m_jobs.find(job);
+    if (it == m_jobs.end()) {
+        return;
+    }
+    it->processed = processed;
+    it->total = total;
+    it->maxTotal = std::max({it->maxTotal, processed, total});
+    emitProgress();
+}
+
+void MovieFileSearcher::emitProgress()
+{
+    // If only one job is running, forward its progress as is. This keeps the
+    // "indeterminate" state (total == 0) of a single job.
+    if (m_jobs.size() == 1 && m_finishedProgress == 0) {
+        const JobState& state = m_jobs.cbegin().value();
+        emit progress(state.processed, state.total, Constants::MovieFileSearcherProgressMessageId);
+        return;
+    }
+
+    int current = m_finishedProgress;
+    int max = m_finishedProgress;
+    for (const JobState& state : asConst(m_jobs)) {
+        // A job that reports 0/0 after it has reported progress is storing its movies.
+        current += state.total > 0 || state.processed > 0 ? state.processed : state.maxTotal;
+        max += state.maxTotal;
+    }
+    emit progress(current, max, Constants::MovieFileSearcherProgressMessageId);
 }
 
 void MovieFileSearcher::onProgressText(MovieLoader* job, QString text)
@@ -129,39 +298,56 @@ void MovieFileSearcher::loadNext()
 
     Q_ASSERT(m_running);
 
-    if (m_directoryQueue.isEmpty()) {
-        emit finished();
-        return;
-    }
+    const int maxJobs = Settings::instance()->advanced()->maxParallelDirectoryScans();
 
-    Q_ASSERT(m_store != nullptr);
+    for (auto queue = m_directoryQueues.begin(); queue != m_directoryQueues.end() && m_jobs.size() < maxJobs;) {
+        const QString& device = queue.key();
+        const bool deviceBusy = std::any_of(
+            m_jobs.cbegin(), m_jobs.cend(), [&device](const JobState& state) { return state.device == device; });
+        if (deviceBusy) {
+            ++queue;
+            continue;
+        }
 
-    SettingsDir dir = m_directoryQueue.dequeue();
+        SettingsDir dir = queue->dequeue();
 
-    QString currentStatus = tr("Searching for movies...");
-    const size_t active = std::count_if(
-        m_directories.cbegin(), m_directories.cend(), [](const SettingsDir& dir) { return !dir.disabled; });
-    if (active > 1) {
-        const size_t finished = active - m_directoryQueue.size();
-        currentStatus += QStringLiteral(" (%1/%2)").arg(QString::number(finished), QString::number(active));
-    }
-    emit statusChanged(currentStatus);
+        MovieLoader* loader = nullptr;
+        if (dir.autoReload) {
+            loader = new MovieDiskLoader(dir, *newStore(), Settings::instance()->advanced()->movieFilters(), nullptr);
+        } else {
+            loader = new MovieDatabaseLoader(dir, *newStore(), nullptr);
+        }
+
+        JobState state;
+        state.device = device;
+        m_jobs.insert(loader, state);
 
-    MovieLoader* loader = nullptr;
-    if (dir.autoReload) {
-        loader = new MovieDiskLoader(dir, *m_store, Settings::instance()->advanced()->movieFilters(), nullptr);
-    } else {
-        loader = new MovieDatabaseLoader(dir, *m_store, nullptr);
+        if (queue->isEmpty()) {
+            queue = m_directoryQueues.erase(queue);
+        } else {
+            ++queue;
+        }
+
+        QThread* thread = mediaelch::createAutoDeleteThreadWithMovieLoader(loader, this);
+        connect(loader, &MovieLoader::finished, this, &MovieFileSearcher::onDirectoryLoaded);
+        connect(loader, &MovieLoader::progress, this, &MovieFileSearcher::onProgress);
+        connect(loader, &MovieLoader::progressText, this, &MovieFileSearcher::onProgressText);
+        thread->start(QThread::HighPriority);
     }
 
-    QThread* thread = mediaelch::createAutoDeleteThreadWithMovieLoader(loader, this);
-    connect(loader, &MovieLoader::finished, this, &MovieFileSearcher::onDirectoryLoaded);
-    connect(loader, &MovieLoader::progress, this, &MovieFileSearcher::onProgress);
-    connect(loader, &MovieLoader::progressText, this, &MovieFileSearcher::onProgressText);
+    if (m_jobs.isEmpty()) {
+        Q_ASSERT(m_directoryQueues.isEmpty());
+        m_running = false;
+        emit finished();
+        return;
+    }
 
-    Q_ASSERT(m_currentJob == nullptr);
-    m_currentJob = loader;
-    thread->start(QThread::HighPriority);
+    QString currentStatus = tr("Searching for movies...");
+    if (m_directoryCount > 1) {
+        currentStatus += QStringLiteral(" (%1/%2)").arg(
+            QString::number(m_finishedDirectoryCount + m_jobs.size()), QString::number(m_directoryCount));
+    }
+    emit statusChanged(currentStatus);
 }
 
 void MovieFileSearcher::abort(bool quiet)
@@ -171,12 +357,25 @@ void MovieFileSearcher::abort(bool quiet)
     }
     m_aborted = true;
     m_running = false;
-    m_directoryQueue.clear();
+    m_directoryQueues.clear();
+    abortUpdate();
 
-    if (m_currentJob != nullptr) {
-        m_currentJob->abort();
+    // Jobs still emit finished() which is handled in onDirectoryLoaded().  Their stores
+    // are discarded there because they may still add movies until then.
+    for (auto it = m_jobs.cbegin(); it != m_jobs.cend(); ++it) {
+        it.key()->abort();
+    }
+    m_jobs.clear();
+}
+
+QString MovieFileSearcher::deviceOf(const SettingsDir& dir)
+{
+    const QStorageInfo storage(dir.path);
+    if (storage.isValid() && !storage.device().isEmpty()) {
+        return QString::fromUtf8(storage.device());
     }
-    m_store->clear();
+    // Unknown device: Treat the directory as independent.
+    return dir.path.absolutePath();
 }
 
 } // namespace mediaelch
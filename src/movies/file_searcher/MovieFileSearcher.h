@@ -6,6 +6,7 @@
 #include <QDir>
 #include <QElapsedTimer>
 #include <QHash>
+#include <QMap>
 #include <QObject>
 #include <QQueue>
 #include <QTime>
@@ -14,6 +15,7 @@
 
 namespace mediaelch {
 
+class MovieDiskLoader;
 class MovieLoader;
 class MovieLoaderStore;
 
@@ -34,9 +36,15 @@ public:
 
     /// \brief Sets the directories to scan for movies. Not readable directories are skipped.
     void setMovieDirectories(const QVector<SettingsDir>& directories);
+    /// \brief True if a reload or an update of a single directory is in progress.
+    bool isRunning() const { return m_running || m_updateJob != nullptr; }
 
 public slots:
     void reload(bool reloadFromDisk);
+    /// \brief   Rescan the given movie directory and update only changed movies in the model.
+    /// \details Movies that are part of the model are kept if their files still exist.
+    ///          Returns false if a reload or another update is in progress.
+    bool updateDirectory(const mediaelch::DirectoryPath& path);
     void abort(bool quiet = false);
 
 signals:
@@ -47,23 +55,61 @@ signals:
     void progressText(QString text);
 
     void finished();
+    /// \brief Emitted after updateDirectory() has updated the model.
+    void directoryUpdated(mediaelch::DirectoryPath path);
 
 private slots:
     void onDirectoryLoaded(MovieLoader* job);
+    void onDirectoryUpdated(MovieLoader* job);
     void onProgress(MovieLoader* job, int processed, int total);
     void onProgressText(MovieLoader* job, QString text);
 
 private:
+    /// \brief Start loaders for queued directories until the concurrency limit is reached.
     void loadNext();
+    /// \brief Abort a running updateDirectory() job.
+    void abortUpdate();
+    /// \brief Emit the combined progress of all finished and running jobs.
+    void emitProgress();
+    /// \brief   Store for a new job.
+    /// \details Each job has its own store: An aborted job may still add movies
+    ///          while the jobs of a new reload are running.
+    MovieLoaderStore* newStore();
+    /// \brief Deletes the movies that are left in the job's store and the store itself.
+    static void discardStore(MovieLoader* job);
+    /// \brief Returns an identifier for the device (disk, network share) of the given directory.
+    static QString deviceOf(const SettingsDir& dir);
+
+    struct JobState
+    {
+        QString device;
+        int processed = 0;
+        int total = 0;
+        /// \brief Largest progress reported by the job.  Loaders report 0/0 while
+        ///        storing their movies, which must not reset the combined progress.
+        int maxTotal = 0;
+    };
 
 private:
     QVector<SettingsDir> m_directories;
     QElapsedTimer m_reloadTimer;
 
-    /// \brief Directories that need to be scanned.
-    QQueue<SettingsDir> m_directoryQueue;
-    MovieLoaderStore* m_store = nullptr;
-    MovieLoader* m_currentJob = nullptr;
+    /// \brief Directories that need to be scanned, grouped by device.
+    /// \details Directories on the same device are scanned one after another
+    ///          to avoid seeking on spinning disks.  Independent devices are
+    ///          scanned concurrently.
+    QMap<QString, QQueue<SettingsDir>> m_directoryQueues;
+    /// \brief Currently running jobs.
+    QHash<MovieLoader*, JobState> m_jobs;
+
+    /// \brief Job of updateDirectory(); there is at most one at a time.
+    MovieDiskLoader* m_updateJob = nullptr;
+    mediaelch::DirectoryPath m_updateDirectory;
+
+    int m_directoryCount = 0;
+    int m_finishedDirectoryCount = 0;
+    /// \brief Sum of the maximum totals of all finished jobs, used for the combined progress.
+    int m_finishedProgress = 0;
 
     bool m_running = false;
     bool m_aborted = false;
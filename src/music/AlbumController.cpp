@@ -4,6 +4,7 @@
 #include "globals/DownloadManager.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
+#include "media_centers/SaveQueue.h"
 #include "music/Album.h"
 #include "scrapers/image/FanartTvMusic.h"
 #include "scrapers/music/MusicScraper.h"
@@ -61,6 +62,20 @@ bool AlbumController::loadData(MediaCenterInterface* mediaCenterInterface, bool
 bool AlbumController::saveData(MediaCenterInterface* mediaCenterInterface)
 {
     bool saved = mediaCenterInterface->saveAlbum(m_album);
+    onSaved(saved);
+    return saved;
+}
+
+int AlbumController::saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue)
+{
+    mediaelch::SaveJob job;
+    const bool created = mediaCenterInterface->createSaveJob(m_album, job);
+    onSaved(created);
+    return created ? queue.enqueue(std::move(job)) : -1;
+}
+
+void AlbumController::onSaved(bool saved)
+{
     if (!m_infoLoaded) {
         m_infoLoaded = saved;
     }
@@ -70,7 +85,6 @@ bool AlbumController::saveData(MediaCenterInterface* mediaCenterInterface)
     if (saved) {
         emit sigSaved(m_album);
     }
-    return saved;
 }
 
 bool AlbumController::infoLoaded() const
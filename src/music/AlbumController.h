@@ -12,6 +12,7 @@ class DownloadManager;
 class MediaCenterInterface;
 
 namespace mediaelch {
+class SaveQueue;
 namespace scraper {
 class MusicScraper;
 }
@@ -25,6 +26,8 @@ public:
     ~AlbumController() override;
 
     bool saveData(MediaCenterInterface* mediaCenterInterface);
+    /// \brief Saves the album in a worker thread of the given queue; see MovieController::saveDataInBackground().
+    int saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue);
     bool loadData(MediaCenterInterface* mediaCenterInterface, bool force = false, bool reloadFromNfo = true);
     void loadData(MusicBrainzId id,
         MusicBrainzId id2,
@@ -59,6 +62,8 @@ private slots:
     void onFanartLoadDone(Album* album, QMap<ImageType, QVector<Poster>> posters);
 
 private:
+    void onSaved(bool saved);
+
     Album* m_album;
     bool m_infoLoaded;
     bool m_infoFromNfoLoaded;
@@ -6,6 +6,7 @@
 #include "globals/Manager.h"
 #include "log/Log.h"
 #include "media_centers/MediaCenterInterface.h"
+#include "media_centers/SaveQueue.h"
 #include "music/Artist.h"
 #include "scrapers/image/FanartTvMusic.h"
 #include "scrapers/music/MusicScraper.h"
@@ -61,6 +62,20 @@ bool ArtistController::loadData(MediaCenterInterface* mediaCenterInterface, bool
 bool ArtistController::saveData(MediaCenterInterface* mediaCenterInterface)
 {
     bool saved = mediaCenterInterface->saveArtist(m_artist);
+    onSaved(saved);
+    return saved;
+}
+
+int ArtistController::saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue)
+{
+    mediaelch::SaveJob job;
+    const bool created = mediaCenterInterface->createSaveJob(m_artist, job);
+    onSaved(created);
+    return created ? queue.enqueue(std::move(job)) : -1;
+}
+
+void ArtistController::onSaved(bool saved)
+{
     if (!m_infoLoaded) {
         m_infoLoaded = saved;
     }
@@ -70,7 +85,6 @@ bool ArtistController::saveData(MediaCenterInterface* mediaCenterInterface)
     if (saved) {
         emit sigSaved(m_artist);
     }
-    return saved;
 }
 
 bool ArtistController::infoFromNfoLoaded() const
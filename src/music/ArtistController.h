@@ -12,6 +12,7 @@ class DownloadManager;
 class MediaCenterInterface;
 
 namespace mediaelch {
+class SaveQueue;
 namespace scraper {
 class MusicScraper;
 }
@@ -25,6 +26,8 @@ public:
     ~ArtistController() override = default;
 
     bool saveData(MediaCenterInterface* mediaCenterInterface);
+    /// \brief Saves the artist in a worker thread of the given queue; see MovieController::saveDataInBackground().
+    int saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue);
     bool loadData(MediaCenterInterface* mediaCenterInterface, bool force = false, bool reloadFromNfo = true);
     void loadData(MusicBrainzId id, mediaelch::scraper::MusicScraper* scraperInterface, QSet<MusicScraperInfo> infos);
 
@@ -56,6 +59,8 @@ private slots:
     void onFanartLoadDone(Artist* artist, QMap<ImageType, QVector<Poster>> posters);
 
 private:
+    void onSaved(bool saved);
+
     Artist* m_artist;
     bool m_infoLoaded;
     bool m_infoFromNfoLoaded;
@@ -9,6 +9,7 @@
 #include <QDirIterator>
 #include <QFileInfo>
 #include <QtConcurrent>
+#include <algorithm>
 
 MusicFileSearcher::MusicFileSearcher(QObject* parent) :
     QObject(parent), m_progressMessageId{Constants::MusicFileSearcherProgressMessageId}, m_aborted{false}
@@ -39,6 +40,7 @@ void MusicFileSearcher::setMusicDirectories(QVector<SettingsDir> directories)
 void MusicFileSearcher::reload(bool force)
 {
     m_aborted = false;
+    m_running = true;
 
     emit searchStarted(tr("Searching for Music..."));
     Manager::instance()->musicModel()->clear();
@@ -85,25 +87,8 @@ void MusicFileSearcher::reload(bool force)
                 artists.append(artist);
                 artistPaths.insert(artist, mediaelch::DirectoryPath(dir.path));
 
-                QDirIterator itAlbums(it.filePath(), QDir::NoDotAndDotDot | QDir::Dirs, QDirIterator::FollowSymlinks);
-                while (itAlbums.hasNext()) {
-                    itAlbums.next();
-
-                    if (Settings::instance()->advanced()->isFolderExcluded(itAlbums.fileInfo().dir().dirName())) {
-                        continue;
-                    }
-
-                    if (itAlbums.fileInfo().baseName() == "extrafanart") {
-                        continue;
-                    }
-                    if (itAlbums.fileInfo().baseName() == "extrathumbs") {
-                        continue;
-                    }
-
-                    auto* album = new Album(mediaelch::DirectoryPath(itAlbums.filePath()), this);
-                    album->setTitle(itAlbums.fileInfo().baseName());
-                    album->setArtistObj(artist);
-                    artist->addAlbum(album);
+                const QVector<Album*> albumsOfArtist = scanAlbums(artist);
+                for (Album* album : albumsOfArtist) {
                     albums.append(album);
                     albumPaths.insert(album, mediaelch::DirectoryPath(dir.path));
                 }
@@ -132,6 +117,7 @@ void MusicFileSearcher::reload(bool force)
     for (Artist* artist : artists) {
         if (m_aborted) {
             Manager::instance()->database()->commit();
+            m_running = false;
             return;
         }
         artist->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
@@ -144,6 +130,7 @@ void MusicFileSearcher::reload(bool force)
     for (Album* album : albums) {
         if (m_aborted) {
             Manager::instance()->database()->commit();
+            m_running = false;
             return;
         }
         album->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
@@ -175,11 +162,101 @@ void MusicFileSearcher::reload(bool force)
         artistItem->appendChild(album);
     }
 
+    m_running = false;
     if (!m_aborted) {
         emit musicLoaded();
     }
 }
 
+bool MusicFileSearcher::reloadArtist(const mediaelch::DirectoryPath& artistDir)
+{
+    if (m_running) {
+        return false;
+    }
+
+    const auto root = std::find_if(m_directories.cbegin(), m_directories.cend(), [&artistDir](const SettingsDir& d) {
+        const mediaelch::DirectoryPath rootDir(d.path);
+        return !d.disabled && rootDir != artistDir && rootDir.isParentFolderOf(artistDir);
+    });
+    if (root == m_directories.cend()) {
+        qCDebug(generic) << "[MusicFileSearcher] Not an artist directory, nothing to reload:" << artistDir;
+        return true;
+    }
+
+    m_aborted = false;
+    m_running = true;
+
+    MusicModel* model = Manager::instance()->musicModel();
+    Database* database = Manager::instance()->database();
+
+    const QVector<Artist*> artists = model->artists();
+    const auto oldArtist = std::find_if(artists.cbegin(), artists.cend(), [&artistDir](Artist* artist) { //
+        return artist->path() == artistDir;
+    });
+    if (oldArtist != artists.cend()) {
+        model->removeArtist(*oldArtist);
+        const auto oldAlbums = (*oldArtist)->albums();
+        for (Album* album : oldAlbums) {
+            album->deleteLater();
+        }
+        (*oldArtist)->deleteLater();
+    }
+    database->clearArtistInDirectory(artistDir);
+
+    const QFileInfo artistInfo(artistDir.toString());
+    if (artistInfo.isDir()) {
+        auto* artist = new Artist(artistDir, this);
+        artist->setName(artistInfo.baseName());
+        const QVector<Album*> albums = scanAlbums(artist);
+
+        database->transaction();
+        artist->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
+        database->add(artist, mediaelch::DirectoryPath(root->path));
+        for (Album* album : albums) {
+            album->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
+            database->add(album, mediaelch::DirectoryPath(root->path));
+        }
+        database->commit();
+
+        MusicModelItem* artistItem = model->appendChild(artist);
+        for (Album* album : albums) {
+            artistItem->appendChild(album);
+        }
+    }
+
+    qCInfo(generic) << "[MusicFileSearcher] Reloaded artist:" << artistDir;
+    m_running = false;
+    emit musicLoaded();
+    return true;
+}
+
+QVector<Album*> MusicFileSearcher::scanAlbums(Artist* artist)
+{
+    QVector<Album*> albums;
+    QDirIterator itAlbums(artist->path().toString(), QDir::NoDotAndDotDot | QDir::Dirs, QDirIterator::FollowSymlinks);
+    while (itAlbums.hasNext()) {
+        itAlbums.next();
+
+        if (Settings::instance()->advanced()->isFolderExcluded(itAlbums.fileInfo().dir().dirName())) {
+            continue;
+        }
+
+        if (itAlbums.fileInfo().baseName() == "extrafanart") {
+            continue;
+        }
+        if (itAlbums.fileInfo().baseName() == "extrathumbs") {
+            continue;
+        }
+
+        auto* album = new Album(mediaelch::DirectoryPath(itAlbums.filePath()), this);
+        album->setTitle(itAlbums.fileInfo().baseName());
+        album->setArtistObj(artist);
+        artist->addAlbum(album);
+        albums.append(album);
+    }
+    return albums;
+}
+
 void MusicFileSearcher::abort()
 {
     m_aborted = true;
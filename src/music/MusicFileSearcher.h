@@ -15,8 +15,14 @@ public:
     ~MusicFileSearcher() override = default;
 
     void setMusicDirectories(QVector<SettingsDir> directories);
+    bool isRunning() const { return m_running; }
     static Artist* loadArtistData(Artist* artist);
     static Album* loadAlbumData(Album* album);
+    /// \brief Reloads the artist in the given directory and its albums from disk.
+    /// \details The artist is removed from the model and database and, if its directory
+    ///          still exists, scanned again. Other artists are not touched.
+    /// \return False if the searcher is running and the artist has to be reloaded later.
+    bool reloadArtist(const mediaelch::DirectoryPath& artistDir);
 
 public slots:
     void reload(bool force);
@@ -29,7 +35,11 @@ signals:
     void currentDir(QString);
 
 private:
+    /// \brief Creates albums for all album directories of the given artist.
+    QVector<Album*> scanAlbums(Artist* artist);
+
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
     bool m_aborted;
+    bool m_running = false;
 };
@@ -0,0 +1,268 @@
+#include "network/DownloadScheduler.h"
+
+#include "log/Log.h"
+#include "network/NetworkReplyWatcher.h"
+#include "network/NetworkRequest.h"
+
+#include <algorithm>
+
+namespace mediaelch {
+namespace network {
+
+constexpr int DownloadScheduler::DEFAULT_MAX_PARALLEL_DOWNLOADS;
+constexpr int DownloadScheduler::MAX_RETRIES;
+
+DownloadScheduler* DownloadScheduler::instance()
+{
+    static auto* s_instance = [] {
+        auto* network = new NetworkManager();
+        // Bulk downloads must not delay requests the user is waiting for, e.g. image previews.
+        network->setPriority(QNetworkRequest::LowPriority);
+        return new DownloadScheduler(network);
+    }();
+    return s_instance;
+}
+
+DownloadScheduler::DownloadScheduler(NetworkManager* network, QObject* parent) : QObject(parent), m_network{network}
+{
+}
+
+DownloadScheduler::~DownloadScheduler()
+{
+    for (QObject* client : m_clients.keys()) {
+        disconnect(client, &QObject::destroyed, this, nullptr);
+    }
+}
+
+DownloadScheduler::Id DownloadScheduler::enqueue(const QUrl& url,
+    Priority priority,
+    QObject* client,
+    FinishedCallback callback)
+{
+    Request request;
+    request.id = ++m_lastId;
+    request.client = client;
+    request.priority = priority;
+    request.callback = std::move(callback);
+    addClient(client);
+
+    auto it = m_downloads.find(url);
+    if (it != m_downloads.end()) {
+        qCDebug(generic) << "[DownloadScheduler] Already downloading:" << url;
+        it->requests.push_back(std::move(request));
+        if (priority < it->priority) {
+            it->priority = priority;
+            if (it->reply == nullptr) {
+                pushToQueue(url, priority);
+            }
+        }
+        return m_lastId;
+    }
+
+    Download download;
+    download.priority = priority;
+    download.requests.push_back(std::move(request));
+    m_downloads.insert(url, std::move(download));
+    pushToQueue(url, priority);
+
+    startDownloads();
+    return m_lastId;
+}
+
+void DownloadScheduler::cancel(QObject* client)
+{
+    if (!m_clients.contains(client)) {
+        return;
+    }
+
+    const auto isClient = [client](const Request& request) { return request.client == client; };
+
+    QVector<QNetworkReply*> repliesToAbort;
+    for (auto it = m_downloads.begin(); it != m_downloads.end();) {
+        QVector<Request>& requests = it->requests;
+        requests.erase(std::remove_if(requests.begin(), requests.end(), isClient), requests.end());
+        if (!requests.isEmpty()) {
+            ++it;
+            continue;
+        }
+        if (it->reply != nullptr) {
+            repliesToAbort.push_back(it->reply);
+        }
+        it = m_downloads.erase(it);
+    }
+    m_delivering.erase(std::remove_if(m_delivering.begin(), m_delivering.end(), isClient), m_delivering.end());
+
+    m_clients.remove(client);
+    disconnect(client, &QObject::destroyed, this, nullptr);
+
+    // Aborting emits "finished", which must not find the download anymore.
+    for (QNetworkReply* reply : repliesToAbort) {
+        reply->abort();
+    }
+}
+
+void DownloadScheduler::setPriority(QObject* client, Priority priority)
+{
+    if (!m_clients.contains(client)) {
+        return;
+    }
+
+    for (auto it = m_downloads.begin(); it != m_downloads.end(); ++it) {
+        bool isAffected = false;
+        Priority highest = Priority::Bulk;
+        for (Request& request : it->requests) {
+            if (request.client == client) {
+                request.priority = priority;
+                isAffected = true;
+            }
+            highest = std::min(highest, request.priority);
+        }
+        if (isAffected && it->priority != highest) {
+            it->priority = highest;
+            if (it->reply == nullptr) {
+                pushToQueue(it.key(), highest);
+            }
+        }
+    }
+}
+
+void DownloadScheduler::setMaxParallelDownloads(int maxParallelDownloads)
+{
+    m_maxParallelDownloads = std::max(1, maxParallelDownloads);
+    startDownloads();
+}
+
+int DownloadScheduler::maxParallelDownloads() const
+{
+    return m_maxParallelDownloads;
+}
+
+int DownloadScheduler::queuedCount() const
+{
+    return m_downloads.size() - m_runningCount;
+}
+
+int DownloadScheduler::runningCount() const
+{
+    return m_runningCount;
+}
+
+void DownloadScheduler::startDownloads()
+{
+    while (m_runningCount < m_maxParallelDownloads) {
+        bool started = false;
+        for (int priority = 0; priority < static_cast<int>(m_queues.size()) && !started; ++priority) {
+            QQueue<QUrl>& queue = m_queues[priority];
+            while (!queue.isEmpty()) {
+                const QUrl url = queue.dequeue();
+                auto it = m_downloads.find(url);
+                if (it == m_downloads.end() || it->reply != nullptr || static_cast<int>(it->priority) != priority) {
+                    continue;
+                }
+                startDownload(url, *it);
+                started = true;
+                break;
+            }
+        }
+        if (!started) {
+            return;
+        }
+    }
+}
+
+void DownloadScheduler::startDownload(const QUrl& url, Download& download)
+{
+    qCDebug(generic) << "[DownloadScheduler] Start download | Running:" << m_runningCount << "|" << url;
+    QNetworkReply* reply = m_network->getWithWatcher(requestWithDefaults(url));
+    download.reply = reply;
+    ++m_runningCount;
+    connect(reply, &QNetworkReply::finished, this, [this, url, reply]() { onDownloadFinished(url, reply); });
+}
+
+void DownloadScheduler::onDownloadFinished(const QUrl& url, QNetworkReply* reply)
+{
+    --m_runningCount;
+    reply->deleteLater();
+
+    auto it = m_downloads.find(url);
+    if (it == m_downloads.end() || it->reply != reply) {
+        // Cancelled
+        startDownloads();
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError && reply->property(NetworkReplyWatcher::TIMEOUT_PROP).toBool()) {
+        ++it->retries;
+        qCWarning(generic) << "[DownloadScheduler] Download timed out:" << url;
+        if (it->retries < MAX_RETRIES) {
+            qCDebug(generic) << "[DownloadScheduler] Re-enqueuing the download, tries:" << it->retries << "/"
+                             << MAX_RETRIES;
+            it->reply = nullptr;
+            pushToQueue(url, it->priority, true);
+            startDownloads();
+            return;
+        }
+        qCDebug(generic) << "[DownloadScheduler] Giving up on this file, tried" << MAX_RETRIES << "times";
+    }
+
+    Result result;
+    result.url = url;
+    result.error = reply->error();
+    if (result.error == QNetworkReply::NoError) {
+        result.data = reply->readAll();
+    } else {
+        result.errorString = reply->errorString();
+        qCWarning(generic) << "[DownloadScheduler] Network Error:" << result.errorString << "|" << url;
+    }
+
+    m_delivering = std::move(it->requests);
+    m_downloads.erase(it);
+
+    // Callbacks may enqueue or cancel downloads.
+    while (!m_delivering.isEmpty()) {
+        const Request request = m_delivering.takeFirst();
+        releaseClient(request.client);
+        request.callback(request.id, result);
+    }
+
+    startDownloads();
+    if (m_downloads.isEmpty()) {
+        emit sigIdle();
+    }
+}
+
+void DownloadScheduler::pushToQueue(const QUrl& url, Priority priority, bool front)
+{
+    QQueue<QUrl>& queue = m_queues[static_cast<int>(priority)];
+    if (front) {
+        queue.prepend(url);
+    } else {
+        queue.enqueue(url);
+    }
+}
+
+void DownloadScheduler::addClient(QObject* client)
+{
+    auto it = m_clients.find(client);
+    if (it != m_clients.end()) {
+        ++it.value();
+        return;
+    }
+    m_clients.insert(client, 1);
+    connect(client, &QObject::destroyed, this, [this, client]() { cancel(client); });
+}
+
+void DownloadScheduler::releaseClient(QObject* client)
+{
+    auto it = m_clients.find(client);
+    if (it == m_clients.end()) {
+        return;
+    }
+    if (--it.value() == 0) {
+        m_clients.erase(it);
+        disconnect(client, &QObject::destroyed, this, nullptr);
+    }
+}
+
+} // namespace network
+} // namespace mediaelch
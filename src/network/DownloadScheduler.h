@@ -0,0 +1,124 @@
+#pragma once
+
+#include "network/NetworkManager.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QNetworkReply>
+#include <QObject>
+#include <QQueue>
+#include <QString>
+#include <QUrl>
+#include <QVector>
+#include <array>
+#include <functional>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief   Downloads the files of all DownloadManagers with a global concurrency limit.
+/// \details Downloads are started by priority class and in the order they were enqueued.
+///          Identical URLs are only downloaded once, even if requested by different clients:
+///          all of them receive the data.  Timed out downloads are retried.
+///
+///          Not thread-safe: must only be used in the main thread.
+class DownloadScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Priority
+    {
+        /// \brief Images of the item that is shown to the user.
+        Visible = 0,
+        Normal = 1,
+        /// \brief Downloads of multi-scrape dialogs and other batch operations.
+        Bulk = 2
+    };
+
+    struct Result
+    {
+        QUrl url;
+        QByteArray data;
+        QNetworkReply::NetworkError error = QNetworkReply::NoError;
+        QString errorString;
+    };
+
+    using Id = quint64;
+    using FinishedCallback = std::function<void(Id, const Result&)>;
+
+    static constexpr int DEFAULT_MAX_PARALLEL_DOWNLOADS = 8;
+    static constexpr int MAX_RETRIES = 3;
+
+    /// \brief The scheduler used by all DownloadManagers.
+    static DownloadScheduler* instance();
+
+public:
+    /// \param network Used for all downloads; must outlive the scheduler.
+    explicit DownloadScheduler(NetworkManager* network, QObject* parent = nullptr);
+    ~DownloadScheduler() override;
+
+    /// \brief Enqueues a download of the given URL for the client.
+    /// \details The callback is called once the download has finished, also if it failed.
+    ///          It is not called if the download is cancelled or the client is destroyed.
+    /// \return Id that is passed to the callback.
+    Id enqueue(const QUrl& url, Priority priority, QObject* client, FinishedCallback callback);
+    /// \brief Cancels all downloads of the client.  Downloads that are shared with other
+    ///        clients continue.
+    void cancel(QObject* client);
+    /// \brief Changes the priority of all queued downloads of the client.
+    void setPriority(QObject* client, Priority priority);
+
+    void setMaxParallelDownloads(int maxParallelDownloads);
+    int maxParallelDownloads() const;
+
+    /// \brief Number of downloads (unique URLs) that are waiting.
+    int queuedCount() const;
+    /// \brief Number of downloads that are currently running.
+    int runningCount() const;
+
+signals:
+    /// \brief Emitted when the last download has finished.
+    void sigIdle();
+
+private:
+    struct Request
+    {
+        Id id = 0;
+        QObject* client = nullptr;
+        Priority priority = Priority::Normal;
+        FinishedCallback callback;
+    };
+
+    struct Download
+    {
+        /// \brief Highest priority of all requests.
+        Priority priority = Priority::Normal;
+        int retries = 0;
+        QNetworkReply* reply = nullptr;
+        QVector<Request> requests;
+    };
+
+    void startDownloads();
+    void startDownload(const QUrl& url, Download& download);
+    void onDownloadFinished(const QUrl& url, QNetworkReply* reply);
+    /// \brief Adds the URL to the queue of its priority.  Entries of downloads that were
+    ///        cancelled, started or moved to another queue are skipped in startDownloads().
+    void pushToQueue(const QUrl& url, Priority priority, bool front = false);
+    void addClient(QObject* client);
+    void releaseClient(QObject* client);
+
+    NetworkManager* m_network;
+    int m_maxParallelDownloads = DEFAULT_MAX_PARALLEL_DOWNLOADS;
+    Id m_lastId = 0;
+    int m_runningCount = 0;
+    QHash<QUrl, Download> m_downloads;
+    std::array<QQueue<QUrl>, 3> m_queues;
+    /// \brief Number of requests per client.
+    QHash<QObject*, int> m_clients;
+    /// \brief Requests of a finished download whose callbacks are being called.
+    QVector<Request> m_delivering;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,108 @@
+#include "network/HostBackoff.h"
+
+#include "log/Log.h"
+#include "network/HttpStatusCodes.h"
+
+#include <QDateTime>
+#include <QMutexLocker>
+#include <algorithm>
+
+namespace mediaelch {
+namespace network {
+
+constexpr std::chrono::milliseconds HostBackoff::INITIAL_DELAY;
+constexpr std::chrono::milliseconds HostBackoff::MAX_DELAY;
+
+HostBackoff& HostBackoff::instance()
+{
+    static HostBackoff s_instance;
+    return s_instance;
+}
+
+HostBackoff::HostBackoff()
+{
+    m_clock.start();
+}
+
+void HostBackoff::reportReply(const QNetworkReply& reply)
+{
+    const QString host = reply.url().host();
+    if (host.isEmpty()) {
+        return;
+    }
+    const int status = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == static_cast<int>(HttpStatusCode::TooManyRequests)) {
+        reportTooManyRequests(host, parseRetryAfter(reply.rawHeader("Retry-After")));
+    } else if (reply.error() == QNetworkReply::NoError) {
+        reportSuccess(host);
+    }
+}
+
+void HostBackoff::reportTooManyRequests(const QString& host, std::chrono::milliseconds retryAfter)
+{
+    QMutexLocker locker(&m_mutex);
+    State& state = m_hosts[host];
+    std::chrono::milliseconds delay = retryAfter;
+    if (delay.count() <= 0) {
+        delay = INITIAL_DELAY * (1 << std::min(state.consecutiveBackoffs, 6));
+    }
+    delay = std::min(delay, MAX_DELAY);
+    ++state.consecutiveBackoffs;
+    state.until = std::max(state.until, m_clock.elapsed() + delay.count());
+
+    qCWarning(generic) << "[HostBackoff] Too many requests to" << host << "| waiting" << delay.count() << "ms";
+}
+
+void HostBackoff::reportSuccess(const QString& host)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_hosts.find(host);
+    if (it != m_hosts.end()) {
+        it->consecutiveBackoffs = 0;
+    }
+}
+
+std::chrono::milliseconds HostBackoff::remaining(const QStringList& hosts) const
+{
+    QMutexLocker locker(&m_mutex);
+    const qint64 now = m_clock.elapsed();
+    qint64 until = now;
+    if (hosts.isEmpty()) {
+        for (const State& state : m_hosts) {
+            until = std::max(until, state.until);
+        }
+    } else {
+        for (const QString& host : hosts) {
+            until = std::max(until, m_hosts.value(host).until);
+        }
+    }
+    return std::chrono::milliseconds(until - now);
+}
+
+void HostBackoff::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_hosts.clear();
+}
+
+std::chrono::milliseconds HostBackoff::parseRetryAfter(const QByteArray& header)
+{
+    const QByteArray value = header.trimmed();
+    if (value.isEmpty()) {
+        return std::chrono::milliseconds(0);
+    }
+    bool ok = false;
+    const int seconds = value.toInt(&ok);
+    if (ok) {
+        return std::chrono::milliseconds(std::max(0, seconds) * 1000LL);
+    }
+    // e.g. "Wed, 21 Oct 2015 07:28:00 GMT"
+    const QDateTime date = QDateTime::fromString(QString::fromLatin1(value), Qt::RFC2822Date);
+    if (!date.isValid()) {
+        return std::chrono::milliseconds(0);
+    }
+    return std::chrono::milliseconds(std::max(0LL, QDateTime::currentDateTimeUtc().msecsTo(date)));
+}
+
+} // namespace network
+} // namespace mediaelch
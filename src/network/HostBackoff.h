@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QNetworkReply>
+#include <QString>
+#include <QStringList>
+#include <chrono>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief   Remembers which hosts asked us to slow down.
+/// \details If a host answers with "429 Too Many Requests", no new work for that host should be
+///          started until the time in the response's "Retry-After" header has passed.  Without
+///          that header, the delay doubles for each further 429 response, starting at one second.
+///          All NetworkManager instances report their replies to the same HostBackoff.
+class HostBackoff
+{
+public:
+    static HostBackoff& instance();
+
+    HostBackoff();
+
+    /// \brief Reports a finished reply. Only 429 responses start a backoff.
+    void reportReply(const QNetworkReply& reply);
+    /// \brief Starts a backoff for the given host. If retryAfter is zero, the delay is doubled
+    ///        for each consecutive report.
+    void reportTooManyRequests(const QString& host, std::chrono::milliseconds retryAfter);
+    /// \brief Resets the delay doubling for the host. A running backoff is kept.
+    void reportSuccess(const QString& host);
+    /// \brief Time until requests to all given hosts may be sent again.
+    ///        If the list is empty, all known hosts are checked.
+    std::chrono::milliseconds remaining(const QStringList& hosts = {}) const;
+    void clear();
+
+    /// \brief Parses a "Retry-After" header which is either in seconds or an HTTP date.
+    ///        Returns zero if the header is missing or invalid.
+    static std::chrono::milliseconds parseRetryAfter(const QByteArray& header);
+
+public:
+    static constexpr std::chrono::milliseconds INITIAL_DELAY{1000};
+    static constexpr std::chrono::milliseconds MAX_DELAY{60000};
+
+private:
+    struct State
+    {
+        /// \brief Time of m_clock until which the host should not be contacted.
+        qint64 until = 0;
+        int consecutiveBackoffs = 0;
+    };
+
+    mutable QMutex m_mutex;
+    QElapsedTimer m_clock;
+    QHash<QString, State> m_hosts;
+};
+
+} // namespace network
+} // namespace mediaelch
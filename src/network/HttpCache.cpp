@@ -0,0 +1,207 @@
+#include "network/HttpCache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QNetworkDiskCache>
+#include <QStandardPaths>
+#include <QUrlQuery>
+#include <memory>
+
+namespace {
+
+/// \brief Query item that stores the cache key in the URLs of entries.
+const char* const CACHE_KEY_QUERY_ITEM = "mediaelch-cache-key";
+
+/// \brief Guards the shared disk cache and its directory.
+QMutex s_cacheMutex;
+QString s_directory;
+
+QString directoryLocked()
+{
+    if (s_directory.isEmpty()) {
+        return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QDir::separator() + "network";
+    }
+    return s_directory;
+}
+
+/// \brief The disk cache of all HttpCache objects.  s_cacheMutex must be locked.
+QNetworkDiskCache& sharedCache()
+{
+    // Never used by QNetworkAccessManager directly, so it does not matter in which thread
+    // it is created.  Entries are written right away; there is nothing to flush on exit.
+    static std::unique_ptr<QNetworkDiskCache> cache;
+    if (cache == nullptr) {
+        cache = std::make_unique<QNetworkDiskCache>();
+        cache->setCacheDirectory(directoryLocked());
+        cache->setMaximumCacheSize(mediaelch::network::HttpCache::MAX_CACHE_SIZE);
+    }
+    return *cache;
+}
+
+/// \brief Removes directives from the Cache-Control header that prevent using a fresh entry.
+QByteArray withoutRevalidation(const QByteArray& cacheControl)
+{
+    QList<QByteArray> directives;
+    for (const QByteArray& directive : cacheControl.split(',')) {
+        const QByteArray name = directive.trimmed().toLower();
+        if (name != "no-cache" && name != "must-revalidate" && !name.startsWith("max-age")) {
+            directives << directive.trimmed();
+        }
+    }
+    return directives.join(", ");
+}
+
+} // namespace
+
+namespace mediaelch {
+namespace network {
+
+constexpr qint64 HttpCache::MAX_CACHE_SIZE;
+
+void HttpCache::setDirectory(const QString& directory)
+{
+    QMutexLocker locker(&s_cacheMutex);
+    s_directory = directory;
+    sharedCache().setCacheDirectory(directoryLocked());
+}
+
+QString HttpCache::directory()
+{
+    QMutexLocker locker(&s_cacheMutex);
+    return directoryLocked();
+}
+
+std::chrono::seconds HttpCache::timeToLive(const QString& host)
+{
+    using namespace std::chrono_literals;
+    // Scraped details rarely change.  Keep them for a day so that scraping the library
+    // again (e.g. after a crash) does not download everything again.
+    static const QHash<QString, std::chrono::seconds> timeToLive{
+        {"api.themoviedb.org", 24h},
+        {"www.imdb.com", 24h},
+        {"api.thetvdb.com", 24h},
+        {"api.tvmaze.com", 24h},
+        {"webservice.fanart.tv", 24h},
+        // Music details change even less often.
+        {"musicbrainz.org", 24h * 7},
+        {"www.theaudiodb.com", 24h * 7},
+        {"www.allmusic.com", 24h * 7},
+        {"api.discogs.com", 24h * 7},
+    };
+    return timeToLive.value(host.toLower(), 0s);
+}
+
+QString HttpCache::cacheKey(const QNetworkRequest& request)
+{
+    if (request.hasRawHeader("Accept-Language")) {
+        // Responses depend on the language, e.g. for IMDb.
+        return "lang=" + QString::fromLatin1(request.rawHeader("Accept-Language"));
+    }
+    return QString();
+}
+
+QUrl HttpCache::cacheUrl(const QUrl& url, const QString& cacheKey)
+{
+    if (cacheKey.isEmpty()) {
+        return url;
+    }
+    QUrl key = url;
+    QUrlQuery query(key);
+    query.addQueryItem(CACHE_KEY_QUERY_ITEM, cacheKey);
+    key.setQuery(query);
+    return key;
+}
+
+QNetworkCacheMetaData HttpCache::withTimeToLive(QNetworkCacheMetaData metaData)
+{
+    const std::chrono::seconds ttl = timeToLive(metaData.url().host());
+    if (!metaData.saveToDisk() || ttl.count() <= 0) {
+        return metaData;
+    }
+
+    const QDateTime expiration = QDateTime::currentDateTimeUtc().addSecs(ttl.count());
+    if (!metaData.expirationDate().isValid() || metaData.expirationDate() < expiration) {
+        metaData.setExpirationDate(expiration);
+    }
+
+    QNetworkCacheMetaData::RawHeaderList headers = metaData.rawHeaders();
+    for (auto& header : headers) {
+        if (header.first.toLower() == "cache-control") {
+            header.second = withoutRevalidation(header.second);
+        }
+    }
+    metaData.setRawHeaders(headers);
+    return metaData;
+}
+
+HttpCache::HttpCache(QString cacheKey, QObject* parent) : QAbstractNetworkCache(parent), m_cacheKey{std::move(cacheKey)}
+{
+}
+
+QNetworkCacheMetaData HttpCache::metaData(const QUrl& url)
+{
+    QMutexLocker locker(&s_cacheMutex);
+    QNetworkCacheMetaData metaData = sharedCache().metaData(cacheUrl(url, m_cacheKey));
+    if (metaData.isValid()) {
+        // QNetworkAccessManager passes it to updateMetaData() after a revalidation.
+        metaData.setUrl(url);
+    }
+    return metaData;
+}
+
+void HttpCache::updateMetaData(const QNetworkCacheMetaData& metaData)
+{
+    // Called after a successful revalidation ("304 Not Modified").
+    QNetworkCacheMetaData updated = withTimeToLive(metaData);
+    updated.setUrl(cacheUrl(metaData.url(), m_cacheKey));
+    QMutexLocker locker(&s_cacheMutex);
+    sharedCache().updateMetaData(updated);
+}
+
+QIODevice* HttpCache::data(const QUrl& url)
+{
+    // QNetworkDiskCache returns a copy of the entry's data, so the entry may be removed
+    // by another thread while the device is read.
+    QMutexLocker locker(&s_cacheMutex);
+    return sharedCache().data(cacheUrl(url, m_cacheKey));
+}
+
+bool HttpCache::remove(const QUrl& url)
+{
+    QMutexLocker locker(&s_cacheMutex);
+    return sharedCache().remove(cacheUrl(url, m_cacheKey));
+}
+
+qint64 HttpCache::cacheSize() const
+{
+    QMutexLocker locker(&s_cacheMutex);
+    return sharedCache().cacheSize();
+}
+
+QIODevice* HttpCache::prepare(const QNetworkCacheMetaData& metaData)
+{
+    QNetworkCacheMetaData prepared = withTimeToLive(metaData);
+    prepared.setUrl(cacheUrl(metaData.url(), m_cacheKey));
+    // The returned device is only written by the calling thread; it is
+    // added to the index in insert().
+    QMutexLocker locker(&s_cacheMutex);
+    return sharedCache().prepare(prepared);
+}
+
+void HttpCache::insert(QIODevice* device)
+{
+    QMutexLocker locker(&s_cacheMutex);
+    sharedCache().insert(device);
+}
+
+void HttpCache::clear()
+{
+    QMutexLocker locker(&s_cacheMutex);
+    sharedCache().clear();
+}
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QAbstractNetworkCache>
+#include <QNetworkCacheMetaData>
+#include <QNetworkRequest>
+#include <QString>
+#include <QUrl>
+#include <chrono>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief   HTTP cache of a QNetworkAccessManager.  All instances share one disk cache.
+/// \details Each QNetworkAccessManager needs its own cache object, but QNetworkDiskCache
+///          keeps the index and the total size of its entries in memory.  Several instances
+///          on the same directory would neither enforce the size limit nor notice entries
+///          that another instance removed.  Therefore all HttpCache objects forward to a
+///          single QNetworkDiskCache and calls are serialized.  A response downloaded by one
+///          scraper can be used by all others, in all threads and after a restart.
+///
+///          Responses of known providers are kept for at least timeToLive() even if the
+///          server asks for revalidation.  Stale entries are revalidated using their
+///          "ETag" and "Last-Modified" headers.
+///
+///          Entries are stored by URL.  Responses that also depend on a request header such
+///          as "Accept-Language" must be requested through a QNetworkAccessManager whose
+///          cache was created with the request's cacheKey(), see RequestDispatcher.
+class HttpCache : public QAbstractNetworkCache
+{
+public:
+    static constexpr qint64 MAX_CACHE_SIZE = 250LL * 1024 * 1024;
+
+    /// \brief Sets the directory of the shared disk cache.
+    static void setDirectory(const QString& directory);
+    static QString directory();
+
+    /// \brief How long responses of the given host are used without revalidation.
+    ///        Zero if the server's headers shall be used.
+    static std::chrono::seconds timeToLive(const QString& host);
+
+    /// \brief Key of the request headers that the response depends on, e.g. "lang=de-DE".
+    ///        Empty if the response only depends on the URL.
+    static QString cacheKey(const QNetworkRequest& request);
+    /// \brief URL under which a response for the given request URL and cacheKey() is stored.
+    static QUrl cacheUrl(const QUrl& url, const QString& cacheKey);
+    /// \brief Applies the host's timeToLive() to the given meta data.
+    static QNetworkCacheMetaData withTimeToLive(QNetworkCacheMetaData metaData);
+
+public:
+    /// \param cacheKey Stored with all entries of this cache, see cacheKey(QNetworkRequest).
+    explicit HttpCache(QString cacheKey = {}, QObject* parent = nullptr);
+    ~HttpCache() override = default;
+
+    const QString& cacheKey() const { return m_cacheKey; }
+
+    QNetworkCacheMetaData metaData(const QUrl& url) override;
+    void updateMetaData(const QNetworkCacheMetaData& metaData) override;
+    QIODevice* data(const QUrl& url) override;
+    bool remove(const QUrl& url) override;
+    qint64 cacheSize() const override;
+    QIODevice* prepare(const QNetworkCacheMetaData& metaData) override;
+    void insert(QIODevice* device) override;
+    void clear() override;
+
+private:
+    QString m_cacheKey;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,140 @@
+#include "network/ImagePreviewDownloader.h"
+
+#include "log/Log.h"
+#include "network/NetworkRequest.h"
+
+#include <QBuffer>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QtConcurrent>
+
+namespace {
+
+/// \brief Maximum number of parallel downloads.
+constexpr int MAX_DOWNLOADS = 8;
+/// \brief Maximum number of parallel downloads from the same host.
+constexpr int MAX_DOWNLOADS_PER_HOST = 4;
+
+} // namespace
+
+namespace mediaelch {
+namespace network {
+
+ImagePreviewDownloader::ImagePreviewDownloader(NetworkManager* network, QObject* parent) :
+    QObject(parent), m_network{network}
+{
+}
+
+ImagePreviewDownloader::~ImagePreviewDownloader()
+{
+    abortAll();
+}
+
+void ImagePreviewDownloader::download(int id, QUrl url)
+{
+    m_queue.push_back({id, std::move(url)});
+    startDownloads();
+}
+
+void ImagePreviewDownloader::abortAll()
+{
+    ++m_generation;
+    m_queue.clear();
+    m_downloadsPerHost.clear();
+    m_decodingCount = 0;
+    const QSet<QNetworkReply*> replies = m_replies;
+    m_replies.clear();
+    for (QNetworkReply* reply : replies) {
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
+}
+
+bool ImagePreviewDownloader::isIdle() const
+{
+    return m_queue.empty() && m_replies.isEmpty() && m_decodingCount == 0;
+}
+
+QImage ImagePreviewDownloader::decodeImage(QByteArray data, int maxWidth)
+{
+    QBuffer buffer(&data);
+    QImageReader reader(&buffer);
+    const QSize size = reader.size();
+    if (maxWidth > 0 && size.isValid() && size.width() > maxWidth) {
+        // Decoders such as JPEG can scale while decoding which is much faster than scaling afterwards.
+        reader.setScaledSize(QSize(maxWidth, qMax(1, size.height() * maxWidth / size.width())));
+    }
+    QImage image = reader.read();
+    if (maxWidth > 0 && image.width() > maxWidth) {
+        // The image's size was unknown before decoding.
+        image = image.scaledToWidth(maxWidth, Qt::SmoothTransformation);
+    }
+    return image;
+}
+
+void ImagePreviewDownloader::startDownloads()
+{
+    auto it = m_queue.begin();
+    while (it != m_queue.end() && m_replies.size() < MAX_DOWNLOADS) {
+        const QString host = it->url.host();
+        if (m_downloadsPerHost.value(host) >= MAX_DOWNLOADS_PER_HOST) {
+            ++it;
+            continue;
+        }
+        const int id = it->id;
+        QNetworkReply* reply = m_network->getWithWatcher(requestWithDefaults(it->url));
+        it = m_queue.erase(it);
+
+        m_replies.insert(reply);
+        ++m_downloadsPerHost[host];
+        connect(reply, &QNetworkReply::finished, this, [this, reply, id, host]() { //
+            onDownloadFinished(reply, id, host);
+        });
+    }
+}
+
+void ImagePreviewDownloader::onDownloadFinished(QNetworkReply* reply, int id, const QString& host)
+{
+    reply->deleteLater();
+    m_replies.remove(reply);
+    if (--m_downloadsPerHost[host] <= 0) {
+        m_downloadsPerHost.remove(host);
+    }
+
+    if (reply->error() != QNetworkReply::NoError) {
+        qCWarning(generic) << "[ImagePreviewDownloader] Network Error:" << reply->errorString() << "|" << reply->url();
+        emit sigError(id, reply->url(), reply->errorString());
+    } else {
+        ++m_decodingCount;
+        const int generation = m_generation;
+        auto* watcher = new QFutureWatcher<QImage>(this);
+        connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, id, generation]() {
+            watcher->deleteLater();
+            if (generation == m_generation) {
+                --m_decodingCount;
+                onDecoded(id, watcher->result());
+            }
+        });
+        watcher->setFuture(QtConcurrent::run(&ImagePreviewDownloader::decodeImage, reply->readAll(), m_maxWidth));
+    }
+
+    startDownloads();
+    checkFinished();
+}
+
+void ImagePreviewDownloader::onDecoded(int id, const QImage& image)
+{
+    emit sigImageLoaded(id, image);
+    checkFinished();
+}
+
+void ImagePreviewDownloader::checkFinished()
+{
+    if (isIdle()) {
+        emit sigFinished();
+    }
+}
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "network/NetworkManager.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QUrl>
+#include <deque>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief   Downloads preview images in parallel and decodes them in worker threads.
+/// \details At most a few downloads are run at the same time and fewer per host so that
+///          image providers are not flooded.  Images are decoded using QImageReader and
+///          scaled down to the maximum width while decoding.  sigImageLoaded() is emitted
+///          for each image as soon as it is ready, not in the order of download().
+class ImagePreviewDownloader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImagePreviewDownloader(NetworkManager* network, QObject* parent = nullptr);
+    ~ImagePreviewDownloader() override;
+
+    /// \brief Images wider than the given width are scaled down while decoding.
+    void setMaxWidth(int width) { m_maxWidth = width; }
+    /// \brief Enqueues the download. The ID is passed to sigImageLoaded() or sigError().
+    void download(int id, QUrl url);
+    /// \brief Aborts all downloads. No signals are emitted for them.
+    void abortAll();
+    bool isIdle() const;
+
+    /// \brief Decodes the image and scales it down to maxWidth if it is wider.
+    static QImage decodeImage(QByteArray data, int maxWidth);
+
+signals:
+    void sigImageLoaded(int id, QImage image);
+    void sigError(int id, QUrl url, QString errorString);
+    /// \brief Emitted once all enqueued downloads are finished.
+    void sigFinished();
+
+private:
+    struct Download
+    {
+        int id;
+        QUrl url;
+    };
+
+    void startDownloads();
+    void onDownloadFinished(QNetworkReply* reply, int id, const QString& host);
+    void onDecoded(int id, const QImage& image);
+    void checkFinished();
+
+    NetworkManager* m_network = nullptr;
+    int m_maxWidth = 0;
+    std::deque<Download> m_queue;
+    QSet<QNetworkReply*> m_replies;
+    QHash<QString, int> m_downloadsPerHost;
+    int m_decodingCount = 0;
+    /// \brief Incremented by abortAll() so that results of running decoders are ignored.
+    int m_generation = 0;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -1,42 +1,85 @@
 #include "network/NetworkManager.h"
 
 #include "network/NetworkReplyWatcher.h"
+#include "network/RequestDispatcher.h"
+
+namespace {
+
+/// \brief Property of replies that stores the NetworkManager that sent the request.
+const char* const OWNER_PROPERTY = "mediaelchNetworkManager";
+
+} // namespace
 
 namespace mediaelch {
 namespace network {
 
 NetworkManager::NetworkManager(QObject* parent) : QObject(parent)
 {
-    // Mapping of important signals
-    // clang-format off
-    connect(&m_qnam, &QNetworkAccessManager::authenticationRequired, this, &NetworkManager::authenticationRequired, Qt::UniqueConnection);
-    connect(&m_qnam, &QNetworkAccessManager::finished,               this, &NetworkManager::finished,               Qt::UniqueConnection);
-    // clang-format on
+    // Mapping of important signals: All managers of a thread share one QNetworkAccessManager,
+    // so only replies of this manager are forwarded.
+    QNetworkAccessManager* qnam = RequestDispatcher::instance().threadManager();
+    connect(qnam,
+        &QNetworkAccessManager::authenticationRequired,
+        this,
+        [this](QNetworkReply* reply, QAuthenticator* auth) {
+            if (isOwnReply(reply)) {
+                emit authenticationRequired(reply, auth);
+            }
+        });
+    connect(qnam, &QNetworkAccessManager::finished, this, [this](QNetworkReply* reply) {
+        if (isOwnReply(reply)) {
+            emit finished(reply);
+        }
+    });
+}
+
+void NetworkManager::setPriority(QNetworkRequest::Priority priority)
+{
+    m_priority = priority;
+}
+
+QNetworkRequest::Priority NetworkManager::priority() const
+{
+    return m_priority;
 }
 
 QNetworkReply* NetworkManager::get(const QNetworkRequest& request)
 {
-    return m_qnam.get(request);
+    return adopt(RequestDispatcher::instance().get(request, m_priority));
 }
 
 QNetworkReply* NetworkManager::getWithWatcher(const QNetworkRequest& request)
 {
-    QNetworkReply* reply = m_qnam.get(request);
+    QNetworkReply* reply = get(request);
     new NetworkReplyWatcher(this, reply);
     return reply;
 }
 
 QNetworkReply* NetworkManager::post(const QNetworkRequest& request, const QByteArray& data)
 {
-    return m_qnam.post(request, data);
+    return adopt(RequestDispatcher::instance().post(request, data, m_priority));
 }
 
 QNetworkReply* NetworkManager::postWithWatcher(const QNetworkRequest& request, const QByteArray& data)
 {
-    QNetworkReply* reply = m_qnam.post(request, data);
+    QNetworkReply* reply = post(request, data);
     new NetworkReplyWatcher(this, reply);
     return reply;
 }
 
+QNetworkReply* NetworkManager::adopt(QNetworkReply* reply)
+{
+    reply->setProperty(OWNER_PROPERTY, QVariant::fromValue(static_cast<QObject*>(this)));
+    // Pending requests are aborted when their manager is destroyed, as with an own
+    // QNetworkAccessManager.
+    reply->setParent(this);
+    return reply;
+}
+
+bool NetworkManager::isOwnReply(QNetworkReply* reply) const
+{
+    return reply->property(OWNER_PROPERTY).value<QObject*>() == this;
+}
+
 } // namespace network
 } // namespace mediaelch
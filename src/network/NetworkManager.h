@@ -10,7 +10,9 @@
 namespace mediaelch {
 namespace network {
 
-/// \brief Wrapper around QNetworkAccessManager that adds timeout mechanisms and logging.
+/// \brief   Wrapper around QNetworkAccessManager that adds timeout mechanisms and logging.
+/// \details Requests are sent through the RequestDispatcher, i.e. all NetworkManagers of a
+///          thread share their connections.  Must be used in the thread it was created in.
 class NetworkManager : public QObject
 {
     Q_OBJECT
@@ -19,6 +21,11 @@ public:
     ~NetworkManager() override = default;
 
 public:
+    /// \brief Priority of all requests of this manager. Requests with a higher priority
+    ///        are sent first if all connections to a host are in use.
+    void setPriority(QNetworkRequest::Priority priority);
+    QNetworkRequest::Priority priority() const;
+
     QNetworkReply* get(const QNetworkRequest& request);
     QNetworkReply* getWithWatcher(const QNetworkRequest& request);
 
@@ -30,7 +37,11 @@ signals:
     void finished(QNetworkReply* reply);
 
 private:
-    QNetworkAccessManager m_qnam;
+    /// \brief Marks the reply as sent by this manager and takes ownership.
+    QNetworkReply* adopt(QNetworkReply* reply);
+    bool isOwnReply(QNetworkReply* reply) const;
+
+    QNetworkRequest::Priority m_priority = QNetworkRequest::NormalPriority;
 };
 
 } // namespace network
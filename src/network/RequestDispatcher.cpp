@@ -0,0 +1,158 @@
+#include "network/RequestDispatcher.h"
+
+#include "network/HostBackoff.h"
+#include "network/HttpCache.h"
+
+#include <QMutexLocker>
+#include <memory>
+
+namespace mediaelch {
+namespace network {
+
+double RequestDispatcher::HostStatistics::averageLatencyMs() const
+{
+    const int sent = requestCount - cacheHits;
+    return sent > 0 ? static_cast<double>(totalLatencyMs) / sent : 0.0;
+}
+
+double RequestDispatcher::HostStatistics::bytesPerSecond() const
+{
+    return totalDurationMs > 0 ? static_cast<double>(networkBytes) * 1000.0 / totalDurationMs : 0.0;
+}
+
+RequestDispatcher& RequestDispatcher::instance()
+{
+    static RequestDispatcher s_instance;
+    return s_instance;
+}
+
+RequestDispatcher::RequestDispatcher()
+{
+    m_clock.start();
+}
+
+QNetworkAccessManager* RequestDispatcher::threadManager()
+{
+    if (!m_managers.hasLocalData()) {
+        auto* manager = new QNetworkAccessManager();
+        manager->setCache(new HttpCache(QString(), manager));
+        // Remember hosts that answered with "429 Too Many Requests"; see ScrapeScheduler.
+        QObject::connect(manager, &QNetworkAccessManager::finished, [](QNetworkReply* reply) {
+            HostBackoff::instance().reportReply(*reply);
+        });
+        m_managers.setLocalData(manager);
+    }
+    return m_managers.localData();
+}
+
+QNetworkAccessManager* RequestDispatcher::managerFor(const QNetworkRequest& request)
+{
+    QNetworkAccessManager* manager = threadManager();
+    const QString cacheKey = HttpCache::cacheKey(request);
+    if (cacheKey.isEmpty()) {
+        return manager;
+    }
+
+    // Caches only get the URL of a request.  Responses that depend on a request header are
+    // therefore requested through a child manager whose cache stores the key with all entries.
+    auto* keyManager = manager->findChild<QNetworkAccessManager*>(cacheKey, Qt::FindDirectChildrenOnly);
+    if (keyManager == nullptr) {
+        keyManager = new QNetworkAccessManager(manager);
+        keyManager->setObjectName(cacheKey);
+        keyManager->setCache(new HttpCache(cacheKey, keyManager));
+        // NetworkManager and HostBackoff only listen to the thread's manager.
+        QObject::connect(keyManager, &QNetworkAccessManager::finished, manager, &QNetworkAccessManager::finished);
+        QObject::connect(keyManager,
+            &QNetworkAccessManager::authenticationRequired,
+            manager,
+            &QNetworkAccessManager::authenticationRequired,
+            Qt::DirectConnection);
+    }
+    return keyManager;
+}
+
+QNetworkReply* RequestDispatcher::get(QNetworkRequest request, QNetworkRequest::Priority priority)
+{
+    QNetworkAccessManager* manager = managerFor(request);
+    return track(manager->get(prepare(std::move(request), priority)));
+}
+
+QNetworkReply* RequestDispatcher::post(QNetworkRequest request,
+    const QByteArray& data,
+    QNetworkRequest::Priority priority)
+{
+    QNetworkAccessManager* manager = managerFor(request);
+    return track(manager->post(prepare(std::move(request), priority), data));
+}
+
+QHash<QString, RequestDispatcher::HostStatistics> RequestDispatcher::statistics() const
+{
+    QMutexLocker locker(&m_statisticsMutex);
+    return m_statistics;
+}
+
+void RequestDispatcher::resetStatistics()
+{
+    QMutexLocker locker(&m_statisticsMutex);
+    m_statistics.clear();
+}
+
+void RequestDispatcher::addToStatistics(const QString& host,
+    qint64 latencyMs,
+    qint64 durationMs,
+    qint64 bytesReceived,
+    bool hasError,
+    bool fromCache)
+{
+    QMutexLocker locker(&m_statisticsMutex);
+    HostStatistics& statistics = m_statistics[host];
+    ++statistics.requestCount;
+    if (hasError) {
+        ++statistics.errorCount;
+    }
+    if (fromCache) {
+        ++statistics.cacheHits;
+        statistics.cachedBytes += bytesReceived;
+    } else {
+        statistics.networkBytes += bytesReceived;
+        statistics.totalLatencyMs += latencyMs;
+        statistics.totalDurationMs += durationMs;
+    }
+}
+
+QNetworkRequest RequestDispatcher::prepare(QNetworkRequest request, QNetworkRequest::Priority priority)
+{
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    // Default in Qt6
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+#endif
+    request.setPriority(priority);
+    return request;
+}
+
+QNetworkReply* RequestDispatcher::track(QNetworkReply* reply)
+{
+    const qint64 startTime = m_clock.elapsed();
+    auto headerTime = std::make_shared<qint64>(-1);
+
+    QObject::connect(reply, &QNetworkReply::metaDataChanged, reply, [this, headerTime]() {
+        if (*headerTime < 0) {
+            *headerTime = m_clock.elapsed();
+        }
+    });
+    // Connected before the caller can connect, so the data is not read, yet.
+    QObject::connect(reply, &QNetworkReply::finished, reply, [this, reply, startTime, headerTime]() {
+        const qint64 endTime = m_clock.elapsed();
+        const qint64 latency = (*headerTime < 0 ? endTime : *headerTime) - startTime;
+        addToStatistics(reply->url().host(),
+            latency,
+            endTime - startTime,
+            reply->bytesAvailable(),
+            reply->error() != QNetworkReply::NoError,
+            reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool());
+    });
+    return reply;
+}
+
+} // namespace network
+} // namespace mediaelch
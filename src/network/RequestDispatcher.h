@@ -0,0 +1,92 @@
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QString>
+#include <QThreadStorage>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief   Sends the requests of all NetworkManagers of a thread over one QNetworkAccessManager.
+/// \details Each QNetworkAccessManager has its own connection pool.  Sharing one per thread
+///          lets all scrapers, downloads and dialogs reuse connections (and with them TLS
+///          sessions) to the same host.  The pool limits the number of connections per host
+///          for the whole thread and queues further requests by their priority, so that
+///          interactive requests are sent before bulk downloads.  HTTP/2 is enabled so that
+///          requests to the same host can share a single connection.
+///
+///          Requests whose responses depend on a header such as "Accept-Language" are sent
+///          over a child manager of the thread's manager, one per HttpCache::cacheKey().  Its
+///          signals are forwarded to the thread's manager.
+///
+///          The dispatcher also installs the HttpCache, reports replies to HostBackoff and
+///          collects per-host statistics.
+class RequestDispatcher
+{
+public:
+    struct HostStatistics
+    {
+        int requestCount = 0;
+        int errorCount = 0;
+        /// \brief Requests that were answered by the HttpCache without contacting the host.
+        int cacheHits = 0;
+        /// \brief Bytes received from the host.
+        qint64 networkBytes = 0;
+        /// \brief Bytes read from the HttpCache.
+        qint64 cachedBytes = 0;
+        /// \brief Sum of the times until the response headers were received, of requests
+        ///        that were sent to the host.
+        qint64 totalLatencyMs = 0;
+        /// \brief Sum of the times until the requests were finished, of requests that were
+        ///        sent to the host.
+        qint64 totalDurationMs = 0;
+
+        /// \brief Average time until the response headers were received in milliseconds.
+        double averageLatencyMs() const;
+        /// \brief Bytes received from the host per second while requests were running.
+        ///        Cached bytes are excluded because cache hits have no duration.
+        double bytesPerSecond() const;
+    };
+
+    static RequestDispatcher& instance();
+
+    RequestDispatcher();
+
+    /// \brief The QNetworkAccessManager of the calling thread. Deleted when the thread exits.
+    QNetworkAccessManager* threadManager();
+
+    QNetworkReply* get(QNetworkRequest request, QNetworkRequest::Priority priority);
+    QNetworkReply* post(QNetworkRequest request, const QByteArray& data, QNetworkRequest::Priority priority);
+
+    /// \brief Statistics of all threads by host.
+    QHash<QString, HostStatistics> statistics() const;
+    void resetStatistics();
+
+    /// \brief Adds a finished request to the host's statistics.
+    void addToStatistics(const QString& host,
+        qint64 latencyMs,
+        qint64 durationMs,
+        qint64 bytesReceived,
+        bool hasError,
+        bool fromCache);
+
+private:
+    /// \brief The thread's manager or its child for the request's HttpCache::cacheKey().
+    QNetworkAccessManager* managerFor(const QNetworkRequest& request);
+    QNetworkRequest prepare(QNetworkRequest request, QNetworkRequest::Priority priority);
+    QNetworkReply* track(QNetworkReply* reply);
+
+    QThreadStorage<QNetworkAccessManager*> m_managers;
+    QElapsedTimer m_clock;
+    mutable QMutex m_statisticsMutex;
+    QHash<QString, HostStatistics> m_statistics;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,149 @@
+#include "scrapers/ScrapeScheduler.h"
+
+#include "network/HostBackoff.h"
+#include "scrapers/image/FanartTv.h"
+#include "scrapers/image/TMDbImages.h"
+#include "scrapers/movie/custom/CustomMovieScraper.h"
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+#include "scrapers/tv_show/custom/CustomTvScraper.h"
+#include "scrapers/tv_show/imdb/ImdbTv.h"
+#include "scrapers/tv_show/thetvdb/TheTvDb.h"
+#include "scrapers/tv_show/tmdb/TmdbTv.h"
+#include "scrapers/tv_show/tvmaze/TvMaze.h"
+
+#include <algorithm>
+
+namespace mediaelch {
+namespace scraper {
+
+ScrapeScheduler::Limits ScrapeScheduler::limitsForScraper(const QString& identifier)
+{
+    using namespace std::chrono_literals;
+
+    // Loading a single item sends several requests, so these limits are well below the
+    // documented request limits of the APIs.
+    const Limits tmdb{4, 250ms, {"api.themoviedb.org"}};
+    const Limits imdb{2, 1000ms, {"www.imdb.com"}};
+    const Limits fanartTv{4, 250ms, {"webservice.fanart.tv"}};
+    const Limits theTvDb{4, 250ms, {"api.thetvdb.com"}};
+    // TVmaze allows 20 calls every 10 seconds.
+    const Limits tvMaze{2, 500ms, {"api.tvmaze.com"}};
+
+    if (identifier == TmdbMovie::ID || identifier == TmdbTv::ID || identifier == TMDbImages::ID) {
+        return tmdb;
+    }
+    if (identifier == ImdbMovie::ID || identifier == ImdbTv::ID) {
+        return imdb;
+    }
+    if (identifier == FanartTv::ID) {
+        return fanartTv;
+    }
+    if (identifier == TheTvDb::ID) {
+        return theTvDb;
+    }
+    if (identifier == TvMaze::ID) {
+        return tvMaze;
+    }
+    if (identifier == CustomMovieScraper::ID || identifier == CustomTvScraper::ID) {
+        // Custom scrapers may use any other scraper; the default limits have no hosts
+        // which means that a backoff of any host pauses scraping.
+        return combine(combine(tmdb, imdb), Limits{});
+    }
+    return Limits{};
+}
+
+ScrapeScheduler::Limits ScrapeScheduler::combine(const Limits& a, const Limits& b)
+{
+    Limits limits;
+    limits.maxParallelItems = std::min(a.maxParallelItems, b.maxParallelItems);
+    limits.minInterval = std::max(a.minInterval, b.minInterval);
+    if (!a.hosts.isEmpty() && !b.hosts.isEmpty()) {
+        limits.hosts = a.hosts + b.hosts;
+        limits.hosts.removeDuplicates();
+    }
+    return limits;
+}
+
+ScrapeScheduler::ScrapeScheduler(QObject* parent) : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &ScrapeScheduler::startItems);
+}
+
+void ScrapeScheduler::start(int itemCount, StartFunction startItem)
+{
+    m_timer.stop();
+    m_sinceLastStart.invalidate();
+    m_runningItems.clear();
+    m_startItem = std::move(startItem);
+    m_itemCount = itemCount;
+    m_nextItem = 0;
+    m_finishedCount = 0;
+    m_running = true;
+    startItems();
+}
+
+void ScrapeScheduler::finishItem(int index)
+{
+    if (!m_runningItems.remove(index)) {
+        return;
+    }
+    if (!m_running) {
+        return;
+    }
+    ++m_finishedCount;
+    emit sigItemFinished(index);
+    // Items are often finished from within a scraper's signal; do not start the next one
+    // in the same call stack.
+    scheduleStart(std::chrono::milliseconds(0));
+}
+
+void ScrapeScheduler::cancel()
+{
+    m_running = false;
+    m_timer.stop();
+}
+
+void ScrapeScheduler::startItems()
+{
+    while (m_running && m_nextItem < m_itemCount && m_runningItems.size() < m_limits.maxParallelItems) {
+        const std::chrono::milliseconds backoff = network::HostBackoff::instance().remaining(m_limits.hosts);
+        if (backoff.count() > 0) {
+            scheduleStart(backoff);
+            return;
+        }
+        if (m_sinceLastStart.isValid()) {
+            const qint64 wait = m_limits.minInterval.count() - m_sinceLastStart.elapsed();
+            if (wait > 0) {
+                scheduleStart(std::chrono::milliseconds(wait));
+                return;
+            }
+        }
+
+        const int index = m_nextItem++;
+        m_runningItems.insert(index);
+        emit sigItemStarted(index);
+        if (m_startItem(index)) {
+            m_sinceLastStart.start();
+        } else if (m_runningItems.remove(index)) {
+            ++m_finishedCount;
+            emit sigItemFinished(index);
+        }
+    }
+
+    if (m_running && m_nextItem >= m_itemCount && m_runningItems.isEmpty()) {
+        m_running = false;
+        emit sigFinished();
+    }
+}
+
+void ScrapeScheduler::scheduleStart(std::chrono::milliseconds delay)
+{
+    if (!m_timer.isActive() || m_timer.remainingTime() > delay.count()) {
+        m_timer.start(static_cast<int>(delay.count()));
+    }
+}
+
+} // namespace scraper
+} // namespace mediaelch
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <chrono>
+#include <functional>
+
+namespace mediaelch {
+namespace scraper {
+
+/// \brief   Scrapes several items at the same time while respecting rate limits.
+/// \details Items are identified by their index.  The scheduler calls the given start function
+///          for up to Limits::maxParallelItems items at once, starting at most one item per
+///          Limits::minInterval.  Each started item must be finished by calling finishItem().
+///          No new items are started while one of the scraper's hosts asked us to back off
+///          (see network::HostBackoff).  Items are started in order.
+///
+/// \example
+///   scheduler.setLimits(ScrapeScheduler::limitsForScraper(scraper->meta().identifier));
+///   scheduler.start(items.size(), [&](int index) { return scrapeItem(index); });
+///   // In some slot, once the item is fully loaded:
+///   scheduler.finishItem(index);
+class ScrapeScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Limits
+    {
+        /// \brief Number of items that are scraped at the same time.
+        int maxParallelItems = 2;
+        /// \brief Minimum time between starting two items.
+        std::chrono::milliseconds minInterval{500};
+        /// \brief Hosts the scraper sends requests to. Empty if unknown.
+        QStringList hosts;
+    };
+
+    /// \brief Limits for the scraper with the given identifier, e.g. TmdbMovie::ID.
+    static Limits limitsForScraper(const QString& identifier);
+    /// \brief Limits that satisfy both a and b, e.g. for a scraper that also loads Fanart.tv images.
+    static Limits combine(const Limits& a, const Limits& b);
+
+    /// \brief Starts the item with the given index. Returns false if the item was skipped,
+    ///        in which case it is finished immediately and does not count against the rate limit.
+    using StartFunction = std::function<bool(int index)>;
+
+public:
+    explicit ScrapeScheduler(QObject* parent = nullptr);
+    ~ScrapeScheduler() override = default;
+
+    void setLimits(Limits limits) { m_limits = std::move(limits); }
+    const Limits& limits() const { return m_limits; }
+
+    void start(int itemCount, StartFunction startItem);
+    /// \brief Marks the item as finished so that the next one can be started.
+    ///        Finishing an item that is not running has no effect.
+    void finishItem(int index);
+    /// \brief Does not start any further items. sigFinished() is not emitted.
+    void cancel();
+
+    bool isRunning() const { return m_running; }
+    /// \brief Indexes of items that were started but not finished, yet.
+    const QSet<int>& runningItems() const { return m_runningItems; }
+    int finishedCount() const { return m_finishedCount; }
+    int itemCount() const { return m_itemCount; }
+
+signals:
+    void sigItemStarted(int index);
+    void sigItemFinished(int index);
+    /// \brief Emitted once all items are finished.
+    void sigFinished();
+
+private:
+    void startItems();
+    void scheduleStart(std::chrono::milliseconds delay);
+
+    Limits m_limits;
+    StartFunction m_startItem;
+    QTimer m_timer;
+    QElapsedTimer m_sinceLastStart;
+    QSet<int> m_runningItems;
+    int m_itemCount = 0;
+    int m_nextItem = 0;
+    int m_finishedCount = 0;
+    bool m_running = false;
+};
+
+} // namespace scraper
+} // namespace mediaelch
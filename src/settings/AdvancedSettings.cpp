@@ -173,6 +173,16 @@ mediaelch::ThumbnailDimensions AdvancedSettings::episodeThumbnailDimensions() co
     return m_episodeThumbnailDimensions;
 }
 
+int AdvancedSettings::maxParallelDirectoryScans() const
+{
+    return m_maxParallelDirectoryScans;
+}
+
+bool AdvancedSettings::watchLibrary() const
+{
+    return m_watchLibrary;
+}
+
 bool AdvancedSettings::isFileExcluded(QString file) const
 {
     for (const auto& pattern : m_excludePatterns) {
@@ -258,6 +268,8 @@ QDebug operator<<(QDebug dbg, const AdvancedSettings& settings)
     out << "        width:               " << settings.m_episodeThumbnailDimensions.width << nl;
     out << "        height:              " << settings.m_episodeThumbnailDimensions.height << nl;
     out << "    bookletCut:              " << settings.m_bookletCut << nl;
+    out << "    maxParallelDirScans:     " << settings.m_maxParallelDirectoryScans << nl;
+    out << "    watchLibrary:            " << (settings.m_watchLibrary ? "true" : "false") << nl;
     out << "    useFirstStudioOnly:      " << (settings.m_useFirstStudioOnly ? "true" : "false") << nl;
     out << "    exclude patterns:        " << nl;
     printExcludePatterns(settings.m_excludePatterns);
@@ -99,6 +99,11 @@ public:
     int bookletCut() const;
     bool writeThumbUrlsToNfo() const;
     mediaelch::ThumbnailDimensions episodeThumbnailDimensions() const;
+    /// \brief Maximum number of media directories that are scanned at the same time.
+    /// \details Directories on the same device are always scanned one after another.
+    int maxParallelDirectoryScans() const;
+    /// \brief Whether media directories are watched for changes while MediaElch is running.
+    bool watchLibrary() const;
 
     bool isFileExcluded(QString file) const;
     bool isFolderExcluded(QString dir) const;
@@ -134,6 +139,8 @@ private:
     bool m_forceCache = false;
     bool m_portableMode = false;
     int m_bookletCut = 2;
+    int m_maxParallelDirectoryScans = 4;
+    bool m_watchLibrary = true;
     bool m_writeThumbUrlsToNfo = true;
     bool m_useFirstStudioOnly = false;
     bool m_userDefined = false;
@@ -123,6 +123,13 @@ void AdvancedSettingsXmlReader::parseSettings(const QString& xmlSource)
         } else if (m_xml.name() == QLatin1String("bookletCut")) {
             expectInt(m_settings.m_bookletCut);
 
+        } else if (m_xml.name() == QLatin1String("maxParallelDirectoryScans")) {
+            const auto inRange = [](int count) { return count >= 1 && count <= 32; };
+            expectIntChecked(m_settings.m_maxParallelDirectoryScans, inRange);
+
+        } else if (m_xml.name() == QLatin1String("watchLibrary")) {
+            expectBool(m_settings.m_watchLibrary);
+
         } else if (m_xml.name() == QLatin1String("sorttokens")) {
             loadSortTokens();
 
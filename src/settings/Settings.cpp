@@ -1,5 +1,6 @@
 #include "Settings.h"
 
+#include "globals/CachedSortKey.h"
 #include "globals/Manager.h"
 #include "globals/ScraperInfos.h"
 #include "renamer/RenamerDialog.h"
@@ -26,6 +27,7 @@ static constexpr char KEY_DONATED[] = "Donated";
 
 static constexpr char KEY_CSV_EXPORT_SEPARATOR[] = "CsvExport/Separator";
 static constexpr char KEY_CSV_EXPORT_REPLACEMENT[] = "CsvExport/Replacement";
+static constexpr char KEY_CSV_EXPORT_COMPRESS[] = "CsvExport/Compress";
 static constexpr char KEY_CSV_EXPORT_TYPES[] = "CsvExport/Types";
 static constexpr char KEY_CSV_EXPORT_MOVIE_FIELDS[] = "CsvExport/MovieFields";
 static constexpr char KEY_CSV_EXPORT_TV_SHOW_FIELDS[] = "CsvExport/TvShowFields";
@@ -353,6 +355,7 @@ void Settings::loadSettings()
 
     m_csvExportSeparator = settings()->value(KEY_CSV_EXPORT_SEPARATOR).toString();
     m_csvExportReplacement = settings()->value(KEY_CSV_EXPORT_REPLACEMENT).toString();
+    m_csvExportCompress = settings()->value(KEY_CSV_EXPORT_COMPRESS, false).toBool();
     m_csvExportTypes = settings()->value(KEY_CSV_EXPORT_TYPES).toString().split(",", ElchSplitBehavior::SkipEmptyParts);
     m_csvExportMovieFields =
         settings()->value(KEY_CSV_EXPORT_MOVIE_FIELDS).toString().split(",", ElchSplitBehavior::SkipEmptyParts);
@@ -614,6 +617,11 @@ QString Settings::csvExportReplacement()
     return m_csvExportReplacement;
 }
 
+bool Settings::csvExportCompress() const
+{
+    return m_csvExportCompress;
+}
+
 QStringList Settings::csvExportTypes()
 {
     return m_csvExportTypes;
@@ -817,6 +825,12 @@ void Settings::setCsvExportReplacement(QString replacement)
     settings()->setValue(KEY_CSV_EXPORT_REPLACEMENT, replacement);
 }
 
+void Settings::setCsvExportCompress(bool compress)
+{
+    m_csvExportCompress = compress;
+    settings()->setValue(KEY_CSV_EXPORT_COMPRESS, compress);
+}
+
 void Settings::setCsvExportTypes(QStringList exportTypes)
 {
     m_csvExportTypes = exportTypes;
@@ -1127,6 +1141,8 @@ bool Settings::ignoreArticlesWhenSorting() const
 void Settings::setIgnoreArticlesWhenSorting(bool ignore)
 {
     m_ignoreArticlesWhenSorting = ignore;
+    // Sort keys depend on this setting.
+    CachedSortKey::invalidateAll();
 }
 
 void Settings::setMovieSetArtworkType(MovieSetArtworkType type)
@@ -1340,6 +1356,24 @@ mediaelch::DirectoryPath Settings::imageCacheDir()
     return mediaelch::DirectoryPath(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
 }
 
+mediaelch::DirectoryPath Settings::networkCacheDir()
+{
+    if (advanced()->portableMode()) {
+        return mediaelch::DirectoryPath(applicationDir() + QDir::separator() + "network_cache");
+    }
+    return mediaelch::DirectoryPath(
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QDir::separator() + "network");
+}
+
+mediaelch::DirectoryPath Settings::exportImageCacheDir()
+{
+    if (advanced()->portableMode()) {
+        return mediaelch::DirectoryPath(applicationDir() + QDir::separator() + "export_cache");
+    }
+    return mediaelch::DirectoryPath(
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QDir::separator() + "export_images");
+}
+
 mediaelch::DirectoryPath Settings::exportTemplatesDir()
 {
     if (advanced()->portableMode()) {
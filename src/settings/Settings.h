@@ -54,6 +54,7 @@ public:
 
     QString csvExportSeparator();
     QString csvExportReplacement();
+    bool csvExportCompress() const;
     QStringList csvExportTypes();
     QStringList csvExportMovieFields();
     QStringList csvExportTvShowFields();
@@ -101,6 +102,8 @@ public:
     bool multiScrapeSaveEach() const;
     mediaelch::DirectoryPath databaseDir();
     mediaelch::DirectoryPath imageCacheDir();
+    mediaelch::DirectoryPath networkCacheDir();
+    mediaelch::DirectoryPath exportImageCacheDir();
     mediaelch::DirectoryPath exportTemplatesDir();
     bool showAdultScrapers() const;
     QString startupSection();
@@ -130,6 +133,7 @@ public:
 
     void setCsvExportSeparator(QString separator);
     void setCsvExportReplacement(QString replacement);
+    void setCsvExportCompress(bool compress);
     void setCsvExportTypes(QStringList types);
     void setCsvExportMovieFields(QStringList fields);
     void setCsvExportTvShowFields(QStringList fields);
@@ -223,6 +227,7 @@ private:
 
     QString m_csvExportSeparator;
     QString m_csvExportReplacement;
+    bool m_csvExportCompress = false;
     QStringList m_csvExportTypes;
     QStringList m_csvExportMovieFields;
     QStringList m_csvExportTvShowFields;
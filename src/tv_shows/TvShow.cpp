@@ -12,9 +12,11 @@
 #include "globals/Manager.h"
 #include "log/Log.h"
 #include "media_centers/MediaCenterInterface.h"
+#include "media_centers/SaveQueue.h"
 #include "scrapers/tv_show/ShowMerger.h"
 #include "scrapers/tv_show/TvScraper.h"
 #include "scrapers/tv_show/thetvdb/TheTvDb.h"
+#include "tv_shows/EpisodeMap.h"
 #include "tv_shows/model/EpisodeModelItem.h"
 #include "tv_shows/model/SeasonModelItem.h"
 #include "tv_shows/model/TvShowModelItem.h"
@@ -230,6 +232,20 @@ bool TvShow::loadData(MediaCenterInterface* mediaCenterInterface, bool reloadFro
 bool TvShow::saveData(MediaCenterInterface* mediaCenterInterface)
 {
     bool saved = mediaCenterInterface->saveTvShow(this);
+    onSaved(saved);
+    return saved;
+}
+
+int TvShow::saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue)
+{
+    mediaelch::SaveJob job;
+    const bool created = mediaCenterInterface->createSaveJob(this, job);
+    onSaved(created);
+    return created ? queue.enqueue(std::move(job)) : -1;
+}
+
+void TvShow::onSaved(bool saved)
+{
     if (!m_infoLoaded) {
         m_infoLoaded = saved;
     }
@@ -238,7 +254,6 @@ bool TvShow::saveData(MediaCenterInterface* mediaCenterInterface)
     setChanged(false);
     clearImages();
     clearExtraFanartData();
-    return saved;
 }
 
 void TvShow::scrapeData(mediaelch::scraper::TvScraper* scraper,
@@ -386,6 +401,12 @@ QString TvShow::title() const
     return m_title;
 }
 
+const QCollatorSortKey& TvShow::sortKey() const
+{
+    // Unlike movies, shows are sorted by their plain title; "ignore articles" does not apply.
+    return m_sortKey.key([this]() { return m_title; });
+}
+
 /**
  * \property TvShow::showTitle
  * \brief The title of the show
@@ -777,6 +798,7 @@ QStringList TvShow::tags() const
 void TvShow::setTitle(const QString& title)
 {
     m_title = title.trimmed();
+    m_sortKey.invalidate();
     setChanged(true);
 }
 
@@ -1412,6 +1434,13 @@ bool TvShow::hideSpecialsInMissingEpisodes() const
 
 void TvShow::fillMissingEpisodes()
 {
+    // Index all existing episodes once so that each missing episode is looked up
+    // in logarithmic time instead of searching through all episodes.
+    mediaelch::EpisodeMap existingEpisodes;
+    for (TvShowEpisode* episode : asConst(m_episodes)) {
+        existingEpisodes.insert({episode->seasonNumber(), episode->episodeNumber()}, episode);
+    }
+
     QVector<TvShowEpisode*> episodes = Manager::instance()->database()->showsEpisodes(this);
     for (TvShowEpisode* episode : episodes) {
         if (episode == nullptr) {
@@ -1419,16 +1448,8 @@ void TvShow::fillMissingEpisodes()
             continue;
         }
 
-        bool found = false;
-        for (int i = 0, n = m_episodes.count(); i < n; ++i) {
-            if (m_episodes[i]->seasonNumber() == episode->seasonNumber()
-                && m_episodes[i]->episodeNumber() == episode->episodeNumber()) {
-                found = true;
-                break;
-            }
-        }
-
-        if (found) {
+        const auto key = qMakePair(episode->seasonNumber(), episode->episodeNumber());
+        if (existingEpisodes.contains(key)) {
             episode->deleteLater();
             continue;
         }
@@ -1438,9 +1459,13 @@ void TvShow::fillMissingEpisodes()
             continue;
         }
 
-        episode->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false, false);
+        // Parsing the episode's NFO content is deferred until its season is shown,
+        // see loadMissingEpisodes().
         episode->setIsDummy(true);
         episode->setInfosLoaded(true);
+        episode->setChanged(false);
+        existingEpisodes.insert(key, episode);
+        m_unloadedDummyEpisodes.append(episode);
         addEpisode(episode);
     }
 
@@ -1452,11 +1477,34 @@ void TvShow::clearMissingEpisodes()
 {
     const auto isDummyEpisode = [](TvShowEpisode* episode) { return episode->isDummy(); };
     m_episodes.erase(std::remove_if(m_episodes.begin(), m_episodes.end(), isDummyEpisode), m_episodes.end());
+    m_unloadedDummyEpisodes.clear();
 
     Manager::instance()->tvShowModel()->updateShow(this);
     TvShowFilesWidget::instance().renewModel(true);
 }
 
+void TvShow::loadMissingEpisodes(SeasonNumber season)
+{
+    if (m_unloadedDummyEpisodes.isEmpty()) {
+        return;
+    }
+
+    const auto isOtherSeason = [season](TvShowEpisode* episode) { return episode->seasonNumber() != season; };
+    const auto toLoad =
+        std::stable_partition(m_unloadedDummyEpisodes.begin(), m_unloadedDummyEpisodes.end(), isOtherSeason);
+
+    for (auto it = toLoad; it != m_unloadedDummyEpisodes.end(); ++it) {
+        TvShowEpisode* episode = *it;
+        if (episode->hasChanged()) {
+            // Details were set in the meantime, e.g. by a scraper; don't overwrite them.
+            continue;
+        }
+        episode->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false, false);
+        episode->setInfosLoaded(true);
+    }
+    m_unloadedDummyEpisodes.erase(toLoad, m_unloadedDummyEpisodes.end());
+}
+
 QDebug operator<<(QDebug dbg, const TvShow& show)
 {
     QDebugStateSaver saver(dbg);
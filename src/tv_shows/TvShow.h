@@ -5,6 +5,7 @@
 #include "data/Rating.h"
 #include "data/TmdbId.h"
 #include "file/Path.h"
+#include "globals/CachedSortKey.h"
 #include "globals/Globals.h"
 #include "globals/Poster.h"
 #include "scrapers/tv_show/ShowIdentifier.h"
@@ -25,6 +26,7 @@ class MediaCenterInterface;
 class TvShowModelItem;
 
 namespace mediaelch {
+class SaveQueue;
 namespace scraper {
 class TvScraper;
 }
@@ -44,6 +46,8 @@ public:
 
     /// \brief Main title of the show.
     QString title() const;
+    /// \brief Collation key of the title; cached until the title changes. Used by TvShowProxyModel.
+    const QCollatorSortKey& sortKey() const;
     /// \brief Alternate title of the show.
     /// \details Some Kodi skins may display this title instead of title().
     ///          Unused by MediaElch except for reading/writing the XML tag.
@@ -165,6 +169,8 @@ public:
 
     bool loadData(MediaCenterInterface* mediaCenterInterface, bool reloadFromNfo = true);
     bool saveData(MediaCenterInterface* mediaCenterInterface);
+    /// \brief Saves the show in a worker thread of the given queue; see MovieController::saveDataInBackground().
+    int saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue);
     void scrapeData(mediaelch::scraper::TvScraper* scraper,
         const mediaelch::scraper::ShowIdentifier& id,
         const mediaelch::Locale& locale,
@@ -175,6 +181,10 @@ public:
     void clearImages();
     void fillMissingEpisodes();
     void clearMissingEpisodes();
+    /// \brief   Loads the details of missing episodes of the given season.
+    /// \details fillMissingEpisodes() only creates the dummy episodes. Their details
+    ///          are loaded once the season is shown, e.g. expanded in the TV show view.
+    void loadMissingEpisodes(SeasonNumber season);
 
     // Images
     void removeImage(ImageType type, SeasonNumber season = SeasonNumber::NoSeason);
@@ -218,9 +228,14 @@ signals:
     void sigChanged(TvShow*);
 
 private:
+    void onSaved(bool saved);
+
     QVector<TvShowEpisode*> m_episodes;
+    /// \brief Dummy episodes whose details were not loaded yet, see loadMissingEpisodes().
+    QVector<TvShowEpisode*> m_unloadedDummyEpisodes;
     mediaelch::DirectoryPath m_dir;
     QString m_title;
+    CachedSortKey m_sortKey;
     QString m_showTitle;
     QString m_originalTitle;
     QString m_sortTitle;
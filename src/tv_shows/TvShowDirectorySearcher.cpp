@@ -0,0 +1,353 @@
+#include "TvShowDirectorySearcher.h"
+
+#include "data/Database.h"
+#include "globals/Helper.h"
+#include "globals/Manager.h"
+#include "log/Log.h"
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
+#include "tv_shows/TvShowFileSearcher.h"
+
+#include <QDir>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QtConcurrent>
+#include <memory>
+
+namespace {
+
+/// \brief Minimum time in milliseconds between two showsAvailable() signals.
+/// \details The model is updated in the GUI thread; updating it for each show
+///          can be expensive if there are hundreds of shows.
+constexpr qint64 BATCH_INTERVAL_MS = 250;
+
+} // namespace
+
+namespace mediaelch {
+
+void TvShowLoaderStore::addShow(TvShow* show)
+{
+    // Episodes are children of the show and are moved as well.
+    show->setParent(nullptr);
+    show->moveToThread(thread());
+    show->setParent(this);
+
+    QMutexLocker locker(&m_lock);
+    m_shows.append(show);
+}
+
+QVector<TvShow*> TvShowLoaderStore::takeAll(QObject* parent)
+{
+    QMutexLocker locker(&m_lock);
+    QVector<TvShow*> shows = std::move(m_shows);
+    m_shows = {};
+    locker.unlock();
+
+    for (TvShow* show : asConst(shows)) {
+        show->setParent(parent);
+    }
+    return shows;
+}
+
+void TvShowLoaderStore::clear()
+{
+    QMutexLocker locker(&m_lock);
+    qDeleteAll(m_shows);
+    m_shows.clear();
+}
+
+void TvShowLoader::storeShow(TvShow* show)
+{
+    m_store->addShow(show);
+    m_hasPendingShows = true;
+    if (!m_lastBatch.isValid() || m_lastBatch.elapsed() > BATCH_INTERVAL_MS) {
+        flushShows();
+    }
+}
+
+void TvShowLoader::flushShows()
+{
+    if (!m_hasPendingShows) {
+        return;
+    }
+    m_hasPendingShows = false;
+    m_lastBatch.start();
+    emit showsAvailable(this);
+}
+
+TvShowDiskLoader::TvShowDiskLoader(SettingsDir dir, TvShowLoaderStore& store, QObject* parent) :
+    TvShowLoader(&store, parent), m_dir{std::move(dir)}, m_db{Database::newConnection(this)}
+{
+}
+
+TvShowDiskLoader::~TvShowDiskLoader()
+{
+    delete m_db;
+}
+
+void TvShowDiskLoader::start()
+{
+    qCInfo(generic) << "[TvShowLoader] Scanning directory:" << QDir::toNativeSeparators(m_dir.path.path());
+
+    emit progress(this, 0, 0);
+    emit progressText(this, "");
+
+    scanShows();
+
+    if (isAborted()) {
+        emit finished(this);
+        return;
+    }
+
+    m_processed = 0;
+    m_total = 0;
+    for (const QVector<QStringList>& episodes : asConst(m_contents)) {
+        m_total += episodes.size();
+    }
+    emit progress(this, m_processed, m_total);
+
+    for (auto it = m_contents.cbegin(); it != m_contents.cend(); ++it) {
+        if (isAborted()) {
+            break;
+        }
+        createShow(it.key(), it.value());
+    }
+
+    flushShows();
+    emit progressText(this, "");
+    emit finished(this);
+}
+
+void TvShowDiskLoader::scanShows()
+{
+    const DirectoryPath rootDir(m_dir.path);
+
+    if (m_showDir.isValid()) {
+        QVector<QStringList> showContents;
+        scanTvShowDir(m_showDir, showContents);
+        m_contents.insert(m_showDir.toString(), showContents);
+        return;
+    }
+
+    QDir dir(rootDir.toString());
+    const QStringList tvShows = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& cDir : tvShows) {
+        if (isAborted()) {
+            return;
+        }
+
+        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
+            continue;
+        }
+
+        emit progressText(this, cDir);
+
+        QVector<QStringList> showContents;
+        scanTvShowDir(rootDir.subDir(cDir), showContents);
+        m_contents.insert((dir.path() + '/' + cDir), showContents);
+    }
+}
+
+/**
+ * \brief Scans the given path for TV show files.
+ * Results are in a list which contains a QStringList for every episode.
+ * \param path Path to scan
+ * \param contents List of contents
+ */
+void TvShowDiskLoader::scanTvShowDir(const DirectoryPath& path, QVector<QStringList>& contents)
+{
+    QDir dir(path.toString());
+    for (const QString& cDir : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (isAborted()) {
+            return;
+        }
+
+        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
+            continue;
+        }
+
+        // Skip "Extras" folder
+        if (QString::compare(cDir, "Extras", Qt::CaseInsensitive) == 0
+            || QString::compare(cDir, ".actors", Qt::CaseInsensitive) == 0
+            || QString::compare(cDir, "extrafanarts", Qt::CaseInsensitive) == 0) {
+            continue;
+        }
+
+        // Handle DVD
+        if (helper::isDvd(path.subDir(cDir))) {
+            contents.append(QStringList() << (path.toString() + "/" + cDir + "/VIDEO_TS/VIDEO_TS.IFO"));
+            continue;
+        }
+        if (helper::isDvd(path.subDir(cDir), true)) {
+            contents.append(QStringList() << (path.toString() + "/" + cDir + "/VIDEO_TS.IFO"));
+            continue;
+        }
+
+        // Handle BluRay
+        if (helper::isBluRay(path.subDir(cDir))) {
+            contents.append(QStringList() << (path.toString() + "/" + cDir + "/BDMV/index.bdmv"));
+            continue;
+        }
+        scanTvShowDir(path.subDir(cDir), contents);
+    }
+
+    QStringList files;
+    const QStringList entries = Settings::instance()->advanced()->tvShowFilters().files(QDir(path.toString()));
+    for (const QString& file : entries) {
+        if (Settings::instance()->advanced()->isFileExcluded(file)) {
+            continue;
+        }
+        // Skip Trailers and Sample files
+        if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive)) {
+            continue;
+        }
+        files.append(file);
+    }
+    files.sort();
+
+    QRegularExpression rx("((?:part|cd)[\\s_]*)(\\d+)", QRegularExpression::CaseInsensitiveOption);
+    for (int i = 0, n = files.size(); i < n; i++) {
+        if (isAborted()) {
+            return;
+        }
+
+        QStringList tvShowFiles;
+        QString file = files.at(i);
+        if (file.isEmpty()) {
+            continue;
+        }
+
+        tvShowFiles << (path.toString() + '/' + file);
+
+        QRegularExpressionMatch match = rx.match(file);
+        int pos = match.capturedStart(0);
+        if (pos != -1) {
+            QString left = file.left(pos) + match.captured(1);
+            QString right = file.mid(pos + match.captured(1).size() + match.captured(2).size());
+            for (int x = 0; x < n; x++) {
+                QString subFile = files.at(x);
+                if (subFile != file) {
+                    if (subFile.startsWith(left) && subFile.endsWith(right)) {
+                        tvShowFiles << (path.toString() + '/' + subFile);
+                        files[x] = ""; // set an empty file name, this way we can skip this file in the main loop
+                    }
+                }
+            }
+        }
+        if (tvShowFiles.count() > 0) {
+            contents.append(tvShowFiles);
+        }
+    }
+}
+
+void TvShowDiskLoader::createShow(const QString& showDir, const QVector<QStringList>& contents)
+{
+    const DirectoryPath path(m_dir.path);
+
+    auto* show = new TvShow(DirectoryPath(showDir), nullptr);
+    show->loadData(Manager::instance()->mediaCenterInterfaceTvShow());
+    emit progressText(this, show->title());
+
+    m_db->transaction();
+    m_db->add(show, path);
+
+    QVector<TvShowEpisode*> episodes;
+    for (const QStringList& files : contents) {
+        SeasonNumber seasonNumber = TvShowFileSearcher::getSeasonNumber(files);
+        QVector<EpisodeNumber> episodeNumbers = TvShowFileSearcher::getEpisodeNumbers(files);
+        for (const EpisodeNumber& episodeNumber : episodeNumbers) {
+            auto* episode = new TvShowEpisode(files, show);
+            episode->setSeason(seasonNumber);
+            episode->setEpisode(episodeNumber);
+            episodes.append(episode);
+        }
+    }
+
+    // Can be blocking as this class should NOT be run in the GUI thread.
+    QtConcurrent::blockingMap(episodes, [](TvShowEpisode* episode) { //
+        TvShowFileSearcher::reloadEpisodeData(episode);
+    });
+
+    m_db->addEpisodes(episodes, path, show->databaseId());
+    m_db->commit();
+    for (TvShowEpisode* episode : asConst(episodes)) {
+        show->addEpisode(episode);
+    }
+
+    m_processed += contents.size();
+    emit progress(this, m_processed, m_total);
+
+    if (isAborted()) {
+        delete show;
+        return;
+    }
+
+    storeShow(show);
+}
+
+void TvShowDatabaseLoader::start()
+{
+    qCInfo(generic) << "[TvShowLoader] Loading entries from database for directory:"
+                    << QDir::toNativeSeparators(m_dir.path.path());
+
+    emit progress(this, 0, 0);
+    emit progressText(this, "");
+
+    std::unique_ptr<Database> db(Database::newConnection(nullptr));
+    QVector<TvShow*> shows = db->showsInDirectory(DirectoryPath(m_dir.path), nullptr);
+
+    const int total = shows.size();
+    int processed = 0;
+    for (TvShow* show : asConst(shows)) {
+        if (isAborted()) {
+            delete show;
+            continue;
+        }
+
+        show->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false);
+
+        QVector<TvShowEpisode*> episodes = db->episodes(show->databaseId());
+        // Set the show first so that the episode is a child of the show.
+        for (TvShowEpisode* episode : asConst(episodes)) {
+            episode->setShow(show);
+        }
+        // Episodes with a valid database record are already loaded.
+        QVector<TvShowEpisode*> episodesToParse;
+        for (TvShowEpisode* episode : asConst(episodes)) {
+            if (!episode->infoLoaded()) {
+                episodesToParse.append(episode);
+            }
+        }
+        QtConcurrent::blockingMap(episodesToParse, [](TvShowEpisode* episode) { //
+            TvShowFileSearcher::loadEpisodeData(episode);
+        });
+        for (TvShowEpisode* episode : asConst(episodes)) {
+            show->addEpisode(episode);
+        }
+
+        emit progress(this, ++processed, total);
+        if (processed % 20 == 0) {
+            emit progressText(this, show->title());
+        }
+        storeShow(show);
+    }
+
+    flushShows();
+    emit progressText(this, "");
+    emit finished(this);
+}
+
+QThread* createAutoDeleteThreadWithTvShowLoader(TvShowLoader* worker, QObject* threadParent)
+{
+    QThread* thread = new QThread(threadParent);
+    Q_ASSERT(thread != nullptr);
+    worker->moveToThread(thread);
+
+    // Startup & delete setup
+    QObject::connect(thread, &QThread::started, worker, &TvShowLoader::start);
+    QObject::connect(worker, &TvShowLoader::finished, thread, &QThread::quit);
+    QObject::connect(thread, &QThread::finished, thread, &QThread::deleteLater);
+    return thread;
+}
+
+} // namespace mediaelch
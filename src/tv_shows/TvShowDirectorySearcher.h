@@ -0,0 +1,138 @@
+#pragma once
+
+#include "file/Path.h"
+#include "globals/Globals.h"
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+
+class Database;
+class TvShow;
+
+namespace mediaelch {
+
+/// \brief   Thread safe store for TV shows.
+/// \details An instance of this class must be provided when using any TvShowLoader.
+///          All TvShowLoaders move their newly created shows (including their
+///          episodes) into a store.
+class TvShowLoaderStore : public QObject
+{
+    Q_OBJECT
+public:
+    TvShowLoaderStore(QObject* parent = nullptr) : QObject(parent) {}
+    ~TvShowLoaderStore() override = default;
+
+    void addShow(TvShow* show);
+
+    QVector<TvShow*> takeAll(QObject* parent);
+    /// \brief Clear and delete all stored shows.
+    void clear();
+
+private:
+    QVector<TvShow*> m_shows;
+    QMutex m_lock;
+};
+
+/// \brief Interface for loading TV shows.
+class TvShowLoader : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TvShowLoader(TvShowLoaderStore* store, QObject* parent = nullptr) : QObject(parent), m_store{store} {}
+    ~TvShowLoader() override = default;
+
+public:
+    virtual void start() = 0;
+    /// \brief   Thread-safe way to abort the TvShowLoader.
+    /// \details Implementations must ensure that this method can be called from
+    ///          any thread, i.e. this function must be thread safe.
+    ///          Furthermore, the finished() signal MUST still be emitted.
+    void abort() { m_aborted.store(true); }
+    /// \brief Thread-safe way to check whether the TvShowLoader was aborted.
+    bool isAborted() { return m_aborted.load(); }
+    /// \brief Store that loaded shows are moved into.
+    TvShowLoaderStore* store() const { return m_store; }
+
+signals:
+    /// \brief Progress in number of episodes (disk) or shows (database).
+    void progress(TvShowLoader* job, int processed, int total);
+    /// \brief   A translated string representing the current loading state.
+    /// \details For example the currently scanned directory.
+    void progressText(TvShowLoader* job, QString text);
+    /// \brief   New shows were moved into the store.
+    /// \details Emitted in batches so that the model can be filled while
+    ///          the loader is still running.
+    void showsAvailable(TvShowLoader* job);
+    void finished(TvShowLoader* job);
+
+protected:
+    /// \brief Move the show into the store and notify listeners (throttled).
+    void storeShow(TvShow* show);
+    /// \brief Emit showsAvailable() if there are shows that were not announced, yet.
+    void flushShows();
+
+    TvShowLoaderStore* m_store = nullptr;
+
+private:
+    std::atomic_bool m_aborted{false};
+    QElapsedTimer m_lastBatch;
+    bool m_hasPendingShows = false;
+};
+
+/// \brief Creates a thread and moves the worker to it. Auto deletes thread when worker is finished.
+QThread* createAutoDeleteThreadWithTvShowLoader(TvShowLoader* worker, QObject* threadParent);
+
+/// \brief Load TV shows and their episodes from disk.
+class TvShowDiskLoader : public TvShowLoader
+{
+    Q_OBJECT
+public:
+    TvShowDiskLoader(SettingsDir dir, TvShowLoaderStore& store, QObject* parent = nullptr);
+    ~TvShowDiskLoader() override;
+
+    /// \brief Only load the TV show in the given directory instead of all
+    ///        shows in the SettingsDir.
+    void setShowDirectory(DirectoryPath showDir) { m_showDir = std::move(showDir); }
+
+public:
+    void start() override;
+
+private:
+    void scanShows();
+    void scanTvShowDir(const DirectoryPath& path, QVector<QStringList>& contents);
+    void createShow(const QString& showDir, const QVector<QStringList>& contents);
+
+private:
+    SettingsDir m_dir;
+    DirectoryPath m_showDir;
+    Database* m_db = nullptr;
+    /// \brief Map of show directories and their respective episode files.
+    QMap<QString, QVector<QStringList>> m_contents;
+    int m_processed = 0;
+    int m_total = 0;
+};
+
+/// \brief Load TV shows and their episodes from the database.
+class TvShowDatabaseLoader : public TvShowLoader
+{
+    Q_OBJECT
+public:
+    TvShowDatabaseLoader(SettingsDir dir, TvShowLoaderStore& store, QObject* parent = nullptr) :
+        TvShowLoader(&store, parent), m_dir{std::move(dir)}
+    {
+    }
+    ~TvShowDatabaseLoader() override = default;
+
+    void start() override;
+
+private:
+    SettingsDir m_dir;
+};
+
+} // namespace mediaelch
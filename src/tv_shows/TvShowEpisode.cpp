@@ -1,8 +1,10 @@
 #include "TvShowEpisode.h"
 
+#include "data/DatabaseRecord.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
 #include "media_centers/MediaCenterInterface.h"
+#include "media_centers/SaveQueue.h"
 #include "scrapers/tv_show/ShowMerger.h"
 #include "scrapers/tv_show/TvScraper.h"
 #include "settings/Settings.h"
@@ -157,6 +159,15 @@ bool TvShowEpisode::loadData(MediaCenterInterface* mediaCenterInterface, bool re
     return infoLoaded;
 }
 
+bool TvShowEpisode::loadDataFromRecord(const QByteArray& record)
+{
+    const bool infoLoaded = mediaelch::deserializeEpisodeRecord(record, *this);
+    m_infoLoaded = infoLoaded;
+    m_infoFromNfoLoaded = false;
+    setChanged(false);
+    return infoLoaded;
+}
+
 /**
  * \brief Tries to load streamdetails from the file
  */
@@ -167,6 +178,13 @@ void TvShowEpisode::loadStreamDetailsFromFile()
     setChanged(true);
 }
 
+void TvShowEpisode::applyStreamDetails(const StreamDetails::Values& values)
+{
+    m_streamDetails->setValues(values);
+    setStreamDetailsLoaded(true);
+    setChanged(true);
+}
+
 /**
  * \brief Save data using a MediaCenterInterface
  * \param mediaCenterInterface MediaCenterInterface to use
@@ -179,13 +197,29 @@ bool TvShowEpisode::saveData(MediaCenterInterface* mediaCenterInterface)
     }
     bool saved = mediaCenterInterface->saveTvShowEpisode(this);
     qCDebug(generic) << "Saving episode" << (saved ? "successful" : "not successful");
+    onSaved(saved);
+    return saved;
+}
+
+int TvShowEpisode::saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue)
+{
+    if (!streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
+        loadStreamDetailsFromFile();
+    }
+    mediaelch::SaveJob job;
+    const bool created = mediaCenterInterface->createSaveJob(this, job);
+    onSaved(created);
+    return created ? queue.enqueue(std::move(job)) : -1;
+}
+
+void TvShowEpisode::onSaved(bool saved)
+{
     if (!m_infoLoaded) {
         m_infoLoaded = saved;
     }
     setSyncNeeded(true);
     setChanged(false);
     clearImages();
-    return saved;
 }
 
 void TvShowEpisode::scrapeData(mediaelch::scraper::TvScraper* scraper,
@@ -29,6 +29,7 @@ class TvShow;
 class EpisodeModelItem;
 
 namespace mediaelch {
+class SaveQueue;
 namespace scraper {
 class TvScraper;
 }
@@ -137,13 +138,20 @@ public:
     void removeActor(Actor* actor);
 
     bool loadData(MediaCenterInterface* mediaCenterInterface, bool reloadFromNfo, bool forceReload);
+    /// \brief Load data from a database record, see mediaelch::deserializeEpisodeRecord()
+    /// \return Loading was successful. If not, loadData() has to be used.
+    bool loadDataFromRecord(const QByteArray& record);
     bool saveData(MediaCenterInterface* mediaCenterInterface);
+    /// \brief Saves the episode in a worker thread of the given queue; see MovieController::saveDataInBackground().
+    int saveDataInBackground(MediaCenterInterface* mediaCenterInterface, mediaelch::SaveQueue& queue);
     void scrapeData(mediaelch::scraper::TvScraper* scraper,
         mediaelch::Locale locale,
         const mediaelch::scraper::ShowIdentifier& showIdentifier,
         SeasonOrder order,
         const QSet<EpisodeScraperInfo>& infosToLoad);
     void loadStreamDetailsFromFile();
+    /// \brief Sets stream details loaded by MediaInfoIndexer; see MovieController::applyStreamDetails().
+    void applyStreamDetails(const StreamDetails::Values& values);
     void clearImages();
     QSet<EpisodeScraperInfo> infosToLoad();
 
@@ -167,6 +175,7 @@ signals:
 
 private:
     void initCounter();
+    void onSaved(bool saved);
 
 private:
     mediaelch::FileList m_files;
@@ -1,11 +1,7 @@
 #include "TvShowFileSearcher.h"
 
-#include <QApplication>
 #include <QFileInfo>
-#include <QSqlError>
-#include <QSqlQuery>
-#include <QSqlRecord>
-#include <QtConcurrent/QtConcurrentMap>
+#include <QRegularExpression>
 
 #include "globals/Helper.h"
 #include "globals/Manager.h"
@@ -17,7 +13,9 @@
 #include "tv_shows/model/TvShowModelItem.h"
 
 TvShowFileSearcher::TvShowFileSearcher(QObject* parent) :
-    QObject(parent), m_progressMessageId{Constants::TvShowSearcherProgressMessageId}, m_aborted{false}
+    QObject(parent),
+    m_progressMessageId{Constants::TvShowSearcherProgressMessageId},
+    m_aborted{false}
 {
 }
 
@@ -43,37 +41,41 @@ void TvShowFileSearcher::setTvShowDirectories(QVector<SettingsDir> directories)
 }
 
 /// \brief Starts the scan process
+/// \details Each directory is loaded in its own thread, one after another.
+///          Shows are added to the model in batches while loading.
 void TvShowFileSearcher::reload(bool force)
 {
+    if (m_running) {
+        qCCritical(generic) << "[TvShowFileSearcher] Search already in progress";
+        return;
+    }
+
     qCInfo(generic) << "[TvShowFileSearcher] Reload TV shows, clear database:" << force;
     m_aborted = false;
+    m_running = true;
+    m_loadedShows.clear();
 
     clearOldTvShows(force);
 
     emit searchStarted(tr("Searching for TV Shows..."));
+    emit progress(0, 0, m_progressMessageId);
 
-    auto files = readTvShowContent(force);
-
-    emit currentDir("");
-
-    emit searchStarted(tr("Loading TV Shows..."));
-    int episodeCounter = 0;
-    const int episodeSum = database().episodeCount();
-
-    QVector<TvShow*> dbShows = getShowsFromDatabase(force);
-    setupShows(files, episodeCounter, episodeSum);
-    setupShowsFromDatabase(dbShows, episodeCounter, episodeSum);
-
-    for (TvShow* show : Manager::instance()->tvShowModel()->tvShows()) {
-        if (show->showMissingEpisodes()) {
-            show->fillMissingEpisodes();
+    for (const SettingsDir& dir : asConst(m_directories)) {
+        if (dir.disabled) {
+            continue;
+        }
+        // Do we need to reload shows from disk?
+        // If there are no shows in the database for the directory, reload
+        // all shows regardless of forceReload.
+        const bool fromDisk =
+            force || dir.autoReload || database().showCount(mediaelch::DirectoryPath(dir.path)) == 0;
+        if (fromDisk) {
+            m_directoriesFromDisk.insert(dir.path.path());
         }
+        m_directoryQueue.enqueue(dir);
     }
 
-    qCDebug(generic) << "[TvShowFileSearcher] Searching for TV shows done";
-    if (!m_aborted) {
-        emit tvShowsLoaded();
-    }
+    loadNext();
 }
 
 TvShowEpisode* TvShowFileSearcher::loadEpisodeData(TvShowEpisode* episode)
@@ -84,216 +86,180 @@ TvShowEpisode* TvShowFileSearcher::loadEpisodeData(TvShowEpisode* episode)
 
 void TvShowFileSearcher::reloadEpisodes(const mediaelch::DirectoryPath& showDir)
 {
+    if (m_running) {
+        qCCritical(generic) << "[TvShowFileSearcher] Search already in progress";
+        return;
+    }
+
+    m_aborted = false;
+    m_running = true;
+    m_loadedShows.clear();
+
     database().clearTvShowInDirectory(showDir);
     emit searchStarted(tr("Searching for Episodes..."));
 
     // remove old show object
     for (TvShow* s : Manager::instance()->tvShowModel()->tvShows()) {
-        if (m_aborted) {
-            return;
-        }
-
         if (s->dir() == showDir) {
             Manager::instance()->tvShowModel()->removeShow(s);
             break;
         }
     }
 
-    // get path
-    mediaelch::DirectoryPath path;
+    // get the TV show directory that contains the show
     int index = -1;
     for (int i = 0, n = m_directories.count(); i < n; ++i) {
-        if (m_aborted) {
-            return;
-        }
-
         if (showDir.toString().startsWith(m_directories[i].path.path())) {
             if (index == -1 || m_directories[index].path.path().length() < m_directories[i].path.path().length()) {
                 index = i;
             }
         }
     }
+    SettingsDir dir;
     if (index != -1) {
-        path = mediaelch::DirectoryPath(m_directories[index].path);
+        dir = m_directories[index];
     }
 
-    // search for contents
-    QVector<QStringList> contents;
-    scanTvShowDir(path, showDir, contents);
-    auto* show = new TvShow(showDir, this);
-    show->loadData(Manager::instance()->mediaCenterInterfaceTvShow());
-    database().add(show, path);
+    auto* loader = new mediaelch::TvShowDiskLoader(dir, *newStore(), nullptr);
+    loader->setShowDirectory(showDir);
+    startLoader(loader);
+}
 
-    emit searchStarted(tr("Loading Episodes..."));
-    emit currentDir(show->title());
+TvShowEpisode* TvShowFileSearcher::reloadEpisodeData(TvShowEpisode* episode)
+{
+    episode->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), true, true);
+    return episode;
+}
 
-    int episodeCounter = 0;
-    int episodeSum = contents.count();
+void TvShowFileSearcher::abort()
+{
+    m_aborted = true;
+    m_running = false;
+    m_directoryQueue.clear();
+    m_directoriesFromDisk.clear();
+    m_loadedShows.clear();
+
+    if (m_currentJob != nullptr) {
+        // The job still emits finished() which is handled in onDirectoryLoaded().
+        m_currentJob->abort();
+        m_currentJob = nullptr;
+    }
+}
 
-    QVector<TvShowEpisode*> episodes;
-    for (const QStringList& files : contents) {
-        if (m_aborted) {
-            return;
-        }
-        SeasonNumber seasonNumber = getSeasonNumber(files);
-        QVector<EpisodeNumber> episodeNumbers = getEpisodeNumbers(files);
-        for (const EpisodeNumber& episodeNumber : episodeNumbers) {
-            auto* episode = new TvShowEpisode(files, show);
-            episode->setSeason(seasonNumber);
-            episode->setEpisode(episodeNumber);
-            episodes.append(episode);
-        }
+void TvShowFileSearcher::loadNext()
+{
+    if (m_aborted) {
+        // no signal because aborted
+        return;
     }
 
-    QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::reloadEpisodeData);
+    Q_ASSERT(m_running);
 
-    for (TvShowEpisode* episode : episodes) {
-        database().add(episode, path, show->databaseId());
-        show->addEpisode(episode);
-        emit progress(++episodeCounter, episodeSum, m_progressMessageId);
-        QApplication::processEvents();
+    if (m_directoryQueue.isEmpty()) {
+        finishReload();
+        return;
     }
 
-    Manager::instance()->tvShowModel()->appendShow(show);
+    const SettingsDir dir = m_directoryQueue.dequeue();
 
-    emit tvShowsLoaded();
+    mediaelch::TvShowLoader* loader = nullptr;
+    if (m_directoriesFromDisk.remove(dir.path.path())) {
+        loader = new mediaelch::TvShowDiskLoader(dir, *newStore(), nullptr);
+    } else {
+        loader = new mediaelch::TvShowDatabaseLoader(dir, *newStore(), nullptr);
+    }
+    startLoader(loader);
 }
 
-TvShowEpisode* TvShowFileSearcher::reloadEpisodeData(TvShowEpisode* episode)
+mediaelch::TvShowLoaderStore* TvShowFileSearcher::newStore()
 {
-    episode->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), true, true);
-    return episode;
+    // Each job has its own store: An aborted job may still add shows while the
+    // job of a new reload is running.
+    return new mediaelch::TvShowLoaderStore(this);
 }
 
-/**
- * \brief Scans a dir for TV show files
- * \param path Directory to scan
- */
-void TvShowFileSearcher::getTvShows(const mediaelch::DirectoryPath& path, QMap<QString, QVector<QStringList>>& contents)
+void TvShowFileSearcher::startLoader(mediaelch::TvShowLoader* loader)
 {
-    QDir dir(path.toString());
-    QStringList tvShows = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    for (const QString& cDir : tvShows) {
-        if (m_aborted) {
-            return;
-        }
+    using namespace mediaelch;
 
-        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
-            continue;
-        }
+    QThread* thread = createAutoDeleteThreadWithTvShowLoader(loader, this);
+    connect(loader, &TvShowLoader::showsAvailable, this, &TvShowFileSearcher::onShowsAvailable);
+    connect(loader, &TvShowLoader::finished, this, &TvShowFileSearcher::onDirectoryLoaded);
+    connect(loader, &TvShowLoader::progress, this, &TvShowFileSearcher::onProgress);
+    connect(loader, &TvShowLoader::progressText, this, &TvShowFileSearcher::onProgressText);
 
-        QVector<QStringList> tvShowContents;
-        scanTvShowDir(path, path.subDir(cDir), tvShowContents);
-        contents.insert((dir.path() + '/' + cDir), tvShowContents);
-    }
+    Q_ASSERT(m_currentJob == nullptr);
+    m_currentJob = loader;
+    thread->start();
 }
 
-/**
- * \brief Scans the given path for TV show files.
- * Results are in a list which contains a QStringList for every episode.
- * \param startPath Scanning started at this path
- * \param path Path to scan
- * \param contents List of contents
- */
-void TvShowFileSearcher::scanTvShowDir(const mediaelch::DirectoryPath& startPath,
-    const mediaelch::DirectoryPath& path,
-    QVector<QStringList>& contents)
+void TvShowFileSearcher::onShowsAvailable(mediaelch::TvShowLoader* job)
 {
-    emit currentDir(path.toString().mid(startPath.toString().length()));
-
-    QDir dir(path.toString());
-    for (const QString& cDir : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
-        if (m_aborted) {
-            return;
-        }
-
-        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
-            continue;
-        }
-
-        // Skip "Extras" folder
-        if (QString::compare(cDir, "Extras", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, ".actors", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, "extrafanarts", Qt::CaseInsensitive) == 0) {
-            continue;
-        }
-
-        // Handle DVD
-        if (helper::isDvd(path.subDir(cDir))) {
-            contents.append(QStringList() << (path.toString() + "/" + cDir + "/VIDEO_TS/VIDEO_TS.IFO"));
-            continue;
-        }
-        if (helper::isDvd(path.subDir(cDir), true)) {
-            contents.append(QStringList() << (path.toString() + "/" + cDir + "/VIDEO_TS.IFO"));
-            continue;
-        }
-
-        // Handle BluRay
-        if (helper::isBluRay(path.subDir(cDir))) {
-            contents.append(QStringList() << (path.toString() + "/" + cDir + "/BDMV/index.bdmv"));
-            continue;
-        }
-        scanTvShowDir(startPath, path.subDir(cDir), contents);
+    if (m_aborted || job->isAborted() || job != m_currentJob) {
+        // To avoid changes to the model, _after_ the users aborts, don't add any
+        // shows to the model.  Only the job's own store is cleared.
+        job->store()->clear();
+        return;
     }
 
-    QStringList files;
-    QStringList entries = getFiles(path);
-    for (const QString& file : entries) {
-        if (Settings::instance()->advanced()->isFileExcluded(file)) {
-            continue;
-        }
-        // Skip Trailers and Sample files
-        if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive)) {
-            continue;
-        }
-        files.append(file);
+    // Note: This file searcher is the parent of all shows, but the model
+    //       handles them.
+    const QVector<TvShow*> shows = job->store()->takeAll(this);
+    for (TvShow* show : shows) {
+        Manager::instance()->tvShowModel()->appendShow(show);
     }
-    files.sort();
+    m_loadedShows.append(shows);
+}
 
-    QRegularExpression rx("((?:part|cd)[\\s_]*)(\\d+)", QRegularExpression::CaseInsensitiveOption);
-    for (int i = 0, n = files.size(); i < n; i++) {
-        if (m_aborted) {
-            return;
-        }
+void TvShowFileSearcher::onDirectoryLoaded(mediaelch::TvShowLoader* job)
+{
+    if (job != m_currentJob) {
+        // The job was aborted and a new reload may have been started in the meantime.
+        // The job does not use its store anymore once it has finished.
+        job->store()->clear();
+        job->store()->deleteLater();
+        job->deleteLater();
+        return;
+    }
+    m_currentJob = nullptr;
 
-        QStringList tvShowFiles;
-        QString file = files.at(i);
-        if (file.isEmpty()) {
-            continue;
-        }
+    // The showsAvailable() signal is emitted before finished() and queued
+    // connections keep their order. Take remaining shows nonetheless.
+    onShowsAvailable(job);
+    job->store()->deleteLater();
+    job->deleteLater();
 
-        tvShowFiles << (path.toString() + '/' + file);
-
-        QRegularExpressionMatch match = rx.match(file);
-        int pos = match.capturedStart(0);
-        if (pos != -1) {
-            QString left = file.left(pos) + match.captured(1);
-            QString right = file.mid(pos + match.captured(1).size() + match.captured(2).size());
-            for (int x = 0; x < n; x++) {
-                QString subFile = files.at(x);
-                if (subFile != file) {
-                    if (subFile.startsWith(left) && subFile.endsWith(right)) {
-                        tvShowFiles << (path.toString() + '/' + subFile);
-                        files[x] = ""; // set an empty file name, this way we can skip this file in the main loop
-                    }
-                }
-            }
-        }
-        if (tvShowFiles.count() > 0) {
-            contents.append(tvShowFiles);
-        }
+    if (!m_aborted && !job->isAborted()) {
+        loadNext();
     }
 }
 
-/// Get a list of files in a directory
-QStringList TvShowFileSearcher::getFiles(const mediaelch::DirectoryPath& path)
+void TvShowFileSearcher::onProgress(mediaelch::TvShowLoader* job, int processed, int total)
 {
-    return Settings::instance()->advanced()->tvShowFilters().files(QDir(path.toString()));
+    Q_UNUSED(job)
+    emit progress(processed, total, m_progressMessageId);
 }
 
-void TvShowFileSearcher::abort()
+void TvShowFileSearcher::onProgressText(mediaelch::TvShowLoader* job, QString text)
 {
-    m_aborted = true;
+    Q_UNUSED(job)
+    emit currentDir(text);
+}
+
+void TvShowFileSearcher::finishReload()
+{
+    emit currentDir("");
+
+    for (TvShow* show : asConst(m_loadedShows)) {
+        if (show->showMissingEpisodes()) {
+            show->fillMissingEpisodes();
+        }
+    }
+    m_loadedShows.clear();
+    m_running = false;
+
+    qCDebug(generic) << "[TvShowFileSearcher] Searching for TV shows done";
+    emit tvShowsLoaded();
 }
 
 SeasonNumber TvShowFileSearcher::getSeasonNumber(QStringList files)
@@ -449,150 +415,3 @@ void TvShowFileSearcher::clearOldTvShows(bool forceClear)
         }
     }
 }
-
-void TvShowFileSearcher::setupShowsFromDatabase(QVector<TvShow*>& dbShows, int episodeCounter, int episodeSum)
-{
-    for (TvShow* show : dbShows) {
-        if (m_aborted) {
-            return;
-        }
-
-        show->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false);
-
-        QVector<TvShowEpisode*> episodes = database().episodes(show->databaseId());
-        QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::loadEpisodeData);
-        for (TvShowEpisode* episode : episodes) {
-            if (episode == nullptr) {
-                continue;
-            }
-            episode->setShow(show);
-            show->addEpisode(episode);
-            emit progress(++episodeCounter, episodeSum, m_progressMessageId);
-            if (episodeCounter % 1000 == 0) {
-                emit currentDir("");
-            }
-        }
-
-        Manager::instance()->tvShowModel()->appendShow(show);
-    }
-}
-
-void TvShowFileSearcher::setupShows(QMap<QString, QVector<QStringList>>& contents, int& episodeCounter, int episodeSum)
-{
-    QMapIterator<QString, QVector<QStringList>> it(contents);
-    while (it.hasNext()) {
-        it.next();
-        episodeSum += it.value().size();
-    }
-    it.toFront();
-
-    // Setup shows
-    while (it.hasNext()) {
-        if (m_aborted) {
-            return;
-        }
-
-        it.next();
-
-        // get path
-        mediaelch::DirectoryPath path;
-        int index = -1;
-        for (int i = 0, n = m_directories.count(); i < n; ++i) {
-            if (it.key().startsWith(m_directories[i].path.path())) {
-                if (index == -1) {
-                    index = i;
-                } else if (m_directories[index].path.path().length() < m_directories[i].path.path().length()) {
-                    index = i;
-                }
-            }
-        }
-        if (index != -1) {
-            path = mediaelch::DirectoryPath(m_directories[index].path);
-        }
-
-        auto* show = new TvShow(mediaelch::DirectoryPath(it.key()), this);
-        show->loadData(Manager::instance()->mediaCenterInterfaceTvShow());
-        emit currentDir(show->title());
-        database().add(show, path);
-
-        database().transaction();
-        QVector<TvShowEpisode*> episodes;
-
-        // Setup episodes list
-        for (const QStringList& files : it.value()) {
-            SeasonNumber seasonNumber = getSeasonNumber(files);
-            QVector<EpisodeNumber> episodeNumbers = getEpisodeNumbers(files);
-            for (const EpisodeNumber& episodeNumber : episodeNumbers) {
-                auto* episode = new TvShowEpisode(files, show);
-                episode->setSeason(seasonNumber);
-                episode->setEpisode(episodeNumber);
-                episodes.append(episode);
-            }
-        }
-
-        // Load episodes data
-        QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::reloadEpisodeData);
-
-        // Add episodes to model
-        for (TvShowEpisode* episode : asConst(episodes)) {
-            database().add(episode, path, show->databaseId());
-            show->addEpisode(episode);
-            emit progress(++episodeCounter, episodeSum, m_progressMessageId);
-        }
-
-        database().commit();
-        Manager::instance()->tvShowModel()->appendShow(show);
-    }
-
-    emit currentDir("");
-}
-
-QMap<QString, QVector<QStringList>> TvShowFileSearcher::readTvShowContent(bool forceReload)
-{
-    QMap<QString, QVector<QStringList>> contents;
-    for (const SettingsDir& dir : asConst(m_directories)) {
-        if (m_aborted) {
-            break;
-        }
-        if (dir.disabled) {
-            continue;
-        }
-        // Do we need to reload shows from disk?
-        if (dir.autoReload || forceReload) {
-            getTvShows(mediaelch::DirectoryPath(dir.path), contents);
-            continue;
-        }
-        // TODO: Check if necessary?
-        // If there are no shows in the database for the directory, reload
-        // all shows regardless of forceReload.
-        const int showsFromDatabase = database().showCount(mediaelch::DirectoryPath(dir.path));
-        if (showsFromDatabase == 0) {
-            getTvShows(mediaelch::DirectoryPath(dir.path), contents);
-            continue;
-        }
-    }
-    return contents;
-}
-
-
-QVector<TvShow*> TvShowFileSearcher::getShowsFromDatabase(bool forceReload)
-{
-    if (forceReload) {
-        return {};
-    }
-
-    QVector<TvShow*> dbShows;
-    for (const SettingsDir& dir : asConst(m_directories)) {
-        if (dir.autoReload) { // Those directories are not read from database.
-            continue;
-        }
-        if (dir.disabled) {
-            continue;
-        }
-        QVector<TvShow*> showsFromDatabase = database().showsInDirectory(mediaelch::DirectoryPath(dir.path));
-        if (!showsFromDatabase.isEmpty()) {
-            dbShows.append(showsFromDatabase);
-        }
-    }
-    return dbShows;
-}
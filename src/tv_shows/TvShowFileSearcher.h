@@ -1,10 +1,14 @@
 #pragma once
 
 #include "file/Path.h"
+#include "tv_shows/TvShowDirectorySearcher.h"
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QDir>
 #include <QObject>
+#include <QQueue>
+#include <QSet>
+#include <QVector>
 
 class Database;
 
@@ -13,11 +17,14 @@ class TvShowFileSearcher : public QObject
     Q_OBJECT
 public:
     explicit TvShowFileSearcher(QObject* parent = nullptr);
+    ~TvShowFileSearcher() override = default;
+
     void setTvShowDirectories(QVector<SettingsDir> directories);
     static SeasonNumber getSeasonNumber(QStringList files);
     static QVector<EpisodeNumber> getEpisodeNumbers(QStringList files);
     static TvShowEpisode* loadEpisodeData(TvShowEpisode* episode);
     static TvShowEpisode* reloadEpisodeData(TvShowEpisode* episode);
+    bool isRunning() const { return m_running; }
 
 public slots:
     void reload(bool force);
@@ -30,23 +37,35 @@ signals:
     void tvShowsLoaded();
     void currentDir(QString);
 
-private:
-    QVector<SettingsDir> m_directories;
-    int m_progressMessageId;
-    void getTvShows(const mediaelch::DirectoryPath& path, QMap<QString, QVector<QStringList>>& contents);
-    void scanTvShowDir(const mediaelch::DirectoryPath& startPath,
-        const mediaelch::DirectoryPath& path,
-        QVector<QStringList>& contents);
-    QStringList getFiles(const mediaelch::DirectoryPath& path);
-    bool m_aborted;
+private slots:
+    void onShowsAvailable(mediaelch::TvShowLoader* job);
+    void onDirectoryLoaded(mediaelch::TvShowLoader* job);
+    void onProgress(mediaelch::TvShowLoader* job, int processed, int total);
+    void onProgressText(mediaelch::TvShowLoader* job, QString text);
 
 private:
     Database& database();
 
     void clearOldTvShows(bool forceClear);
-    /// \brief Get a map of TV show paths and their respective files in the show folder.
-    QMap<QString, QVector<QStringList>> readTvShowContent(bool forceReload);
-    QVector<TvShow*> getShowsFromDatabase(bool forceReload);
-    void setupShows(QMap<QString, QVector<QStringList>>& contents, int& episodeCounter, int episodeSum);
-    void setupShowsFromDatabase(QVector<TvShow*>& dbShows, int episodeCounter, int episodeSum);
+    void loadNext();
+    mediaelch::TvShowLoaderStore* newStore();
+    void startLoader(mediaelch::TvShowLoader* loader);
+    /// \brief Called when all directories are loaded.
+    void finishReload();
+
+private:
+    QVector<SettingsDir> m_directories;
+    int m_progressMessageId;
+
+    /// \brief Directories that need to be scanned.
+    QQueue<SettingsDir> m_directoryQueue;
+    /// \brief Directories in m_directoryQueue that must be loaded from disk.
+    QSet<QString> m_directoriesFromDisk;
+    /// \brief Shows that were added to the model during the current reload.
+    QVector<TvShow*> m_loadedShows;
+
+    mediaelch::TvShowLoader* m_currentJob = nullptr;
+
+    bool m_running = false;
+    bool m_aborted;
 };
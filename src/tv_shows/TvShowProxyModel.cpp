@@ -2,84 +2,170 @@
 
 #include "globals/Globals.h"
 #include "globals/Manager.h"
+#include "tv_shows/TvShowModel.h"
 #include "tv_shows/model/EpisodeModelItem.h"
 #include "tv_shows/model/SeasonModelItem.h"
+#include "tv_shows/model/TvShowModelItem.h"
+
+#include <QElapsedTimer>
+
+namespace {
+
+/// \brief Time to wait for further input before a new filter is evaluated.
+constexpr int FILTER_DEBOUNCE_MS = 150;
+/// \brief Time that may be spent evaluating shows before control is returned to the event loop.
+constexpr int FILTER_BATCH_MS = 15;
+
+} // namespace
 
 TvShowProxyModel::TvShowProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
 {
+    m_debounceTimer.setSingleShot(true);
+    m_debounceTimer.setInterval(FILTER_DEBOUNCE_MS);
+    connect(&m_debounceTimer, &QTimer::timeout, this, &TvShowProxyModel::startFiltering);
 }
 
-/**
- * \brief Checks if a row accepts the filter. Checks the first column of our model (TV Show name)
- */
-/*
-bool TvShowProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+void TvShowProxyModel::setSourceModel(QAbstractItemModel* model)
 {
-    Q_UNUSED(sourceParent);
-    QVector<TvShow*> shows = Manager::instance()->tvShowModel()->tvShows();
-    if (sourceRow < 0 || sourceRow >= shows.count())
-        return true;
-
-    TvShow *show = shows.at(sourceRow);
-    for (Filter *filter: m_filters) {
-        if (!filter->accepts(show))
-            return false;
+    if (sourceModel() != nullptr) {
+        sourceModel()->disconnect(this);
+    }
+    m_acceptedItems.clear();
+    m_pendingItems.clear();
+
+    // Connect before QSortFilterProxyModel does, so that cached results are dropped
+    // before the proxy model re-evaluates changed rows.
+    if (model != nullptr) {
+        connect(model, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex& topLeft) {
+            invalidateShow(topLeft);
+        });
+        connect(model, &QAbstractItemModel::rowsInserted, this, [this](const QModelIndex& parent) {
+            invalidateShow(parent);
+        });
+        connect(model,
+            &QAbstractItemModel::rowsAboutToBeRemoved,
+            this,
+            [this](const QModelIndex& parent, int first, int last) {
+                if (parent.isValid()) {
+                    invalidateShow(parent);
+                    return;
+                }
+                for (int row = first; row <= last; ++row) {
+                    invalidateShow(sourceModel()->index(row, 0));
+                }
+            });
+        connect(model, &QAbstractItemModel::modelAboutToBeReset, this, [this]() {
+            m_acceptedItems.clear();
+            m_pendingItems.clear();
+        });
     }
 
-    return true;
+    QSortFilterProxyModel::setSourceModel(model);
 }
-*/
 
 bool TvShowProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
 {
-    if (filterAcceptsRowItself(source_row, source_parent)) {
+    if (m_treeFilter.isEmpty()) {
         return true;
     }
-
-    // accept if any of the parents is accepted on it's own merits
-    QModelIndex parent = source_parent;
-    while (parent.isValid()) {
-        if (filterAcceptsRowItself(parent.row(), parent.parent())) {
-            return true;
-        }
-        parent = parent.parent();
+    const QModelIndex index = sourceModel()->index(source_row, 0, source_parent);
+    const TvShowModelItem* show = showItemOf(index);
+    if (show == nullptr) {
+        return true;
     }
+    const auto& model = static_cast<const TvShowModel&>(*sourceModel());
+    return acceptedItemsOf(*show).contains(&model.getItem(index));
+}
 
-    // accept if any of the children is accepted on it's own merits
-    return hasAcceptedChildren(source_row, source_parent);
+void TvShowProxyModel::setFilter(QVector<Filter*> filters, QString text)
+{
+    m_filters = std::move(filters);
+    m_filterText = std::move(text);
+
+    // Filter objects are owned and modified by the filter widget; copy their terms.
+    m_pendingFilter = TvShowTreeFilter::fromFilters(m_filters, m_filterText);
+    m_pendingItems.clear();
+    ++m_filterGeneration;
+
+    if (m_pendingFilter.isEmpty()) {
+        // Removing the filter is cheap; do it right away.
+        m_debounceTimer.stop();
+        m_treeFilter = m_pendingFilter;
+        m_acceptedItems.clear();
+        invalidateFilter();
+        return;
+    }
+    m_debounceTimer.start();
 }
 
-bool TvShowProxyModel::filterAcceptsRowItself(int sourceRow, const QModelIndex& sourceParent) const
+void TvShowProxyModel::startFiltering()
 {
-    return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+    m_nextShowRow = 0;
+    m_pendingItems.clear();
+    filterNextShows(++m_filterGeneration);
 }
 
-bool TvShowProxyModel::hasAcceptedChildren(int source_row, const QModelIndex& source_parent) const
+void TvShowProxyModel::filterNextShows(quint64 generation)
 {
-    QModelIndex item = sourceModel()->index(source_row, 0, source_parent);
-    if (!item.isValid()) {
-        // qCDebug(generic) << "item invalid" << source_parent << source_row;
-        return false;
+    if (generation != m_filterGeneration || sourceModel() == nullptr) {
+        // Cancelled by a newer filter.
+        return;
     }
 
-    // check if there are children
-    int childCount = item.model()->rowCount(item);
-    if (childCount == 0) {
-        return false;
-    }
+    const auto& model = static_cast<const TvShowModel&>(*sourceModel());
+    const int showCount = model.rowCount();
 
-    for (int i = 0; i < childCount; ++i) {
-        if (filterAcceptsRowItself(i, item)) {
-            return true;
-        }
-        // recursive call -> NOTICE that this is depth-first searching, you're probably better off with breadth first
-        // search...
-        if (hasAcceptedChildren(i, item)) {
-            return true;
+    QElapsedTimer timer;
+    timer.start();
+    while (m_nextShowRow < showCount && timer.elapsed() < FILTER_BATCH_MS) {
+        const auto* show = dynamic_cast<const TvShowModelItem*>(&model.getItem(model.index(m_nextShowRow, 0)));
+        if (show != nullptr) {
+            m_pendingItems.insert(show, m_pendingFilter.acceptedItems(*show));
         }
+        ++m_nextShowRow;
+    }
+
+    if (m_nextShowRow < showCount) {
+        QTimer::singleShot(0, this, [this, generation]() { filterNextShows(generation); });
+        return;
+    }
+
+    m_treeFilter = m_pendingFilter;
+    m_acceptedItems = std::move(m_pendingItems);
+    m_pendingItems.clear();
+    invalidateFilter();
+}
+
+const TvShowModelItem* TvShowProxyModel::showItemOf(const QModelIndex& sourceIndex) const
+{
+    if (!sourceIndex.isValid()) {
+        return nullptr;
+    }
+    QModelIndex showIndex = sourceIndex;
+    while (showIndex.parent().isValid()) {
+        showIndex = showIndex.parent();
+    }
+    const auto& model = static_cast<const TvShowModel&>(*sourceModel());
+    return dynamic_cast<const TvShowModelItem*>(&model.getItem(showIndex));
+}
+
+const TvShowProxyModel::AcceptedItems& TvShowProxyModel::acceptedItemsOf(const TvShowModelItem& show) const
+{
+    auto items = m_acceptedItems.find(&show);
+    if (items == m_acceptedItems.end()) {
+        // New or changed show; evaluate it with the current filter.
+        items = m_acceptedItems.insert(&show, m_treeFilter.acceptedItems(show));
     }
+    return *items;
+}
 
-    return false;
+void TvShowProxyModel::invalidateShow(const QModelIndex& sourceIndex)
+{
+    const TvShowModelItem* show = showItemOf(sourceIndex);
+    if (show != nullptr) {
+        m_acceptedItems.remove(show);
+        m_pendingItems.remove(show);
+    }
 }
 
 /// \brief Sort function for the TV show model. Sorts TV shows by name.
@@ -109,14 +195,10 @@ bool TvShowProxyModel::lessThan(const QModelIndex& left, const QModelIndex& righ
         if (!leftNew && rightNew) {
             return false;
         }
+        // The sort keys are cached per show, so that this is a simple comparison.
+        return leftItem.tvShow()->sortKey().compare(rightItem.tvShow()->sortKey()) < 0;
     }
 
     return (
         QString::localeAwareCompare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString()) < 0);
 }
-
-void TvShowProxyModel::setFilter(QVector<Filter*> filters, QString text)
-{
-    m_filters = std::move(filters);
-    m_filterText = std::move(text);
-}
@@ -1,9 +1,22 @@
 #pragma once
 
 #include "globals/Filter.h"
+#include "tv_shows/TvShowTreeFilter.h"
 
+#include <QHash>
+#include <QSet>
 #include <QSortFilterProxyModel>
+#include <QTimer>
 
+class TvShowBaseModelItem;
+class TvShowModelItem;
+
+/// \brief   Sort and filter model for the TV show tree.
+/// \details Filters are evaluated once per show using TvShowTreeFilter and the
+///          result is cached until the show changes.  Changing the filter is
+///          debounced and the shows are evaluated in small batches, so that the
+///          UI stays responsive while the user types.  A new filter cancels the
+///          evaluation of the previous one.
 class TvShowProxyModel : public QSortFilterProxyModel
 {
     Q_OBJECT
@@ -11,14 +24,34 @@ class TvShowProxyModel : public QSortFilterProxyModel
 public:
     explicit TvShowProxyModel(QObject* parent = nullptr);
     void setFilter(QVector<Filter*> filters, QString text);
+    void setSourceModel(QAbstractItemModel* sourceModel) override;
 
 protected:
     bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
-    bool filterAcceptsRowItself(int sourceRow, const QModelIndex& sourceParent) const;
-    bool hasAcceptedChildren(int source_row, const QModelIndex& source_parent) const;
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
 
 private:
+    using AcceptedItems = QSet<const TvShowBaseModelItem*>;
+
+    void startFiltering();
+    void filterNextShows(quint64 generation);
+    const TvShowModelItem* showItemOf(const QModelIndex& sourceIndex) const;
+    const AcceptedItems& acceptedItemsOf(const TvShowModelItem& show) const;
+    void invalidateShow(const QModelIndex& sourceIndex);
+
     QVector<Filter*> m_filters;
     QString m_filterText;
+
+    /// \brief Filter that is currently applied to the view.
+    TvShowTreeFilter m_treeFilter;
+    /// \brief Accepted items per show for m_treeFilter. Shows are evaluated on demand if missing.
+    mutable QHash<const TvShowModelItem*, AcceptedItems> m_acceptedItems;
+
+    /// \brief Filter that is being evaluated and its results so far.
+    TvShowTreeFilter m_pendingFilter;
+    QHash<const TvShowModelItem*, AcceptedItems> m_pendingItems;
+    int m_nextShowRow = 0;
+    /// \brief Incremented for each new filter to cancel the evaluation of outdated ones.
+    quint64 m_filterGeneration = 0;
+    QTimer m_debounceTimer;
 };
@@ -0,0 +1,70 @@
+#include "tv_shows/TvShowTreeFilter.h"
+
+#include "globals/Filter.h"
+#include "tv_shows/model/EpisodeModelItem.h"
+#include "tv_shows/model/SeasonModelItem.h"
+#include "tv_shows/model/TvShowModelItem.h"
+
+TvShowTreeFilter::TvShowTreeFilter(QStringList terms)
+{
+    terms.removeAll(QString{});
+    terms.removeDuplicates();
+    m_terms = terms.mid(0, MAX_TERMS);
+    for (int i = 0; i < m_terms.size(); ++i) {
+        m_allTerms |= (TermMask(1) << i);
+    }
+}
+
+TvShowTreeFilter TvShowTreeFilter::fromFilters(const QVector<Filter*>& filters, const QString& text)
+{
+    QStringList terms;
+    for (const Filter* filter : filters) {
+        terms << filter->shortText();
+    }
+    if (terms.isEmpty()) {
+        terms << text;
+    }
+    return TvShowTreeFilter(terms);
+}
+
+TvShowTreeFilter::TermMask TvShowTreeFilter::matches(const QString& text) const
+{
+    TermMask mask = 0;
+    for (int i = 0; i < m_terms.size(); ++i) {
+        if (text.contains(m_terms.at(i), Qt::CaseInsensitive)) {
+            mask |= (TermMask(1) << i);
+        }
+    }
+    return mask;
+}
+
+QSet<const TvShowBaseModelItem*> TvShowTreeFilter::acceptedItems(const TvShowModelItem& show) const
+{
+    QSet<const TvShowBaseModelItem*> accepted;
+    const TermMask showMask = matches(show.data(0).toString());
+    bool showAccepted = (showMask == m_allTerms);
+
+    for (const SeasonModelItem* season : show.seasons()) {
+        const TermMask seasonMask = showMask | matches(season->data(0).toString());
+        const bool seasonMatches = (seasonMask == m_allTerms);
+        bool seasonAccepted = seasonMatches;
+
+        for (const EpisodeModelItem* episode : season->episodes()) {
+            // If the season is accepted on its own merits, all its episodes are as well.
+            if (seasonMatches || (seasonMask | matches(episode->data(0).toString())) == m_allTerms) {
+                accepted.insert(episode);
+                seasonAccepted = true;
+            }
+        }
+
+        if (seasonAccepted) {
+            accepted.insert(season);
+            showAccepted = true;
+        }
+    }
+
+    if (showAccepted) {
+        accepted.insert(&show);
+    }
+    return accepted;
+}
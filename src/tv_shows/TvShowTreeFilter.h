@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class Filter;
+class TvShowBaseModelItem;
+class TvShowModelItem;
+
+/// \brief   Evaluates filter terms for all items of a TV show in a single pass.
+/// \details Each term is matched once per show, season and episode against the
+///          text shown in the tree.  The result is stored as a bitset per item.
+///          Bitsets are OR'ed along the path from the show to the episode, so that
+///          a term may be matched by an item or any of its parents.  An item is
+///          accepted if its path matches all terms, if its parent is accepted on
+///          its own merits or if any of its children is accepted.
+///
+///          The filter copies the terms and can therefore be used after the
+///          Filter objects have changed.
+class TvShowTreeFilter
+{
+public:
+    /// \brief Bitset of matched terms. Only the first MAX_TERMS terms are used.
+    using TermMask = quint64;
+    static constexpr int MAX_TERMS = 64;
+
+    TvShowTreeFilter() = default;
+    explicit TvShowTreeFilter(QStringList terms);
+
+    /// \brief Filter that uses the short texts of the given filters or, if there
+    ///        are none, the text that is entered in the filter widget.
+    static TvShowTreeFilter fromFilters(const QVector<Filter*>& filters, const QString& text);
+
+    /// \brief True if there are no terms, i.e. all items are accepted.
+    bool isEmpty() const { return m_terms.isEmpty(); }
+    const QStringList& terms() const { return m_terms; }
+
+    /// \brief Terms that are contained in the given text (case insensitive).
+    TermMask matches(const QString& text) const;
+
+    /// \brief All accepted items of the given show, including the show itself.
+    QSet<const TvShowBaseModelItem*> acceptedItems(const TvShowModelItem& show) const;
+
+private:
+    QStringList m_terms;
+    TermMask m_allTerms = 0;
+};
@@ -9,6 +9,7 @@
 #include <QLabel>
 #include <QMenu>
 #include <QModelIndex>
+#include <QPointer>
 #include <QWidget>
 
 namespace Ui {
@@ -72,7 +73,7 @@ private slots:
 private:
     Ui::ConcertFilesWidget* ui;
     ConcertProxyModel* m_concertProxyModel;
-    Concert* m_lastConcert;
+    QPointer<Concert> m_lastConcert;
     QModelIndex m_lastModelIndex;
     QMenu* m_contextMenu = nullptr;
     AlphabeticalList* m_alphaList;
@@ -97,6 +97,13 @@ ConcertWidget::ConcertWidget(QWidget* parent) : QWidget(parent), ui(new Ui::Conc
     m_savingWidget->setMovie(m_loadingMovie);
     m_savingWidget->hide();
 
+    connect(
+        Manager::instance()->saveQueue(), &mediaelch::SaveQueue::sigJobFinished, this, &ConcertWidget::onConcertSaved);
+    connect(Manager::instance()->concertModel(),
+        &ConcertModel::sigConcertRemoved,
+        this,
+        &ConcertWidget::onConcertRemoved);
+
     connect(ui->fanarts,
         elchOverload<QByteArray>(&ImageGallery::sigRemoveImage),
         this,
@@ -443,24 +450,17 @@ void ConcertWidget::onSaveInformation()
     setDisabledTrue();
     m_savingWidget->show();
 
-    if (concerts.count() == 1) {
-        m_concert->controller()->saveData(Manager::instance()->mediaCenterInterfaceConcert());
-        m_concert->controller()->loadData(Manager::instance()->mediaCenterInterfaceConcert(), true);
-        updateConcertInfo();
-        NotificationBox::instance()->showSuccess(tr("<b>\"%1\"</b> Saved").arg(m_concert->title()));
-    } else {
-        for (Concert* concert : concerts) {
-            if (concert->hasChanged()) {
-                concert->controller()->saveData(Manager::instance()->mediaCenterInterfaceConcert());
-                concert->controller()->loadData(Manager::instance()->mediaCenterInterfaceConcert(), true);
-                if (m_concert == concert) {
-                    updateConcertInfo();
-                }
-            }
-        }
-        NotificationBox::instance()->showSuccess(tr("Concerts Saved"));
+    if (concerts.count() > 1) {
+        ui->buttonRevert->setVisible(false);
+        saveConcertsInBackground(concerts, tr("Concerts Saved"));
+        return;
     }
 
+    m_concert->controller()->saveData(Manager::instance()->mediaCenterInterfaceConcert());
+    m_concert->controller()->loadData(Manager::instance()->mediaCenterInterfaceConcert(), true);
+    updateConcertInfo();
+    NotificationBox::instance()->showSuccess(tr("<b>\"%1\"</b> Saved").arg(m_concert->title()));
+
     setEnabledTrue();
     m_savingWidget->hide();
     ui->buttonRevert->setVisible(false);
@@ -473,20 +473,61 @@ void ConcertWidget::onSaveAll()
 {
     setDisabledTrue();
     m_savingWidget->show();
+    ui->buttonRevert->setVisible(false);
+    saveConcertsInBackground(Manager::instance()->concertModel()->concerts(), tr("All Concerts Saved"));
+}
 
-    for (Concert* concert : Manager::instance()->concertModel()->concerts()) {
-        if (concert->hasChanged()) {
-            concert->controller()->saveData(Manager::instance()->mediaCenterInterfaceConcert());
-            concert->controller()->loadData(Manager::instance()->mediaCenterInterfaceConcert(), true);
-            if (m_concert == concert) {
-                updateConcertInfo();
-            }
+void ConcertWidget::saveConcertsInBackground(const QVector<Concert*>& concerts, const QString& successMessage)
+{
+    m_saveSuccessMessage = successMessage;
+    for (Concert* concert : concerts) {
+        if (!concert->hasChanged()) {
+            continue;
+        }
+        const int jobId = concert->controller()->saveDataInBackground(
+            Manager::instance()->mediaCenterInterfaceConcert(), *Manager::instance()->saveQueue());
+        if (jobId >= 0) {
+            m_savingConcerts.insert(jobId, concert);
+        }
+    }
+    if (m_savingConcerts.isEmpty()) {
+        onAllConcertsSaved();
+    }
+}
+
+void ConcertWidget::onConcertSaved(int jobId, bool success)
+{
+    if (!m_savingConcerts.contains(jobId)) {
+        return;
+    }
+    QPointer<Concert> concert = m_savingConcerts.take(jobId);
+    if (success && !concert.isNull()) {
+        // Reload the NFO that was just written.
+        concert->controller()->loadData(Manager::instance()->mediaCenterInterfaceConcert(), true);
+        if (m_concert == concert) {
+            updateConcertInfo();
         }
     }
+    if (m_savingConcerts.isEmpty()) {
+        onAllConcertsSaved();
+    }
+}
+
+void ConcertWidget::onConcertRemoved(Concert* concert)
+{
+    if (concert != m_concert) {
+        return;
+    }
+    m_concert = nullptr;
+    clear();
+    setDisabledTrue();
+}
+
+void ConcertWidget::onAllConcertsSaved()
+{
     setEnabledTrue();
     m_savingWidget->hide();
-    NotificationBox::instance()->showSuccess(tr("All Concerts Saved"));
-    ui->buttonRevert->setVisible(false);
+    NotificationBox::instance()->showSuccess(m_saveSuccessMessage);
 }
 
 /**
@@ -3,6 +3,7 @@
 #include "concerts/Concert.h"
 
 #include <QContextMenuEvent>
+#include <QHash>
 #include <QLabel>
 #include <QMenu>
 #include <QPointer>
@@ -74,11 +75,20 @@ private slots:
     void onExtraFanartDropped(QUrl imageUrl);
 
     void updateImage(ImageType imageType, ClosableImage* image);
+    void onConcertSaved(int jobId, bool success);
+    void onConcertRemoved(Concert* concert);
 
 private:
+    /// \brief Saves all changed concerts in background threads, see mediaelch::SaveQueue.
+    void saveConcertsInBackground(const QVector<Concert*>& concerts, const QString& successMessage);
+    void onAllConcertsSaved();
+
     Ui::ConcertWidget* ui;
     QPointer<Concert> m_concert = nullptr;
     QMovie* m_loadingMovie;
     QLabel* m_savingWidget;
+    /// \brief Concerts that are saved in the background, by their SaveQueue job ID.
+    QHash<int, QPointer<Concert>> m_savingConcerts;
+    QString m_saveSuccessMessage;
     void updateImages(QVector<ImageType> images);
 };
@@ -106,6 +106,7 @@ void CsvExportDialog::onExport()
     if (QRegularExpression("[,;|\t\\s-]").match(ui->replacement->currentText()).hasMatch()) {
         replacement = ui->replacement->currentData(Qt::UserRole).toString();
     }
+    m_compress = ui->checkCompress->isChecked();
 
     // Get user's directory where to store the file
     QString location = QFileDialog::getExistingDirectory(this, tr("Export directory"), QDir::homePath());
@@ -237,6 +238,7 @@ void CsvExportDialog::saveSettings()
 {
     m_settings.setCsvExportSeparator(ui->separator->currentData().toString());
     m_settings.setCsvExportReplacement(ui->replacement->currentData().toString());
+    m_settings.setCsvExportCompress(ui->checkCompress->isChecked());
     {
         QStringList mediaToExport;
         if (ui->checkMovies->isChecked()) {
@@ -514,6 +516,7 @@ void CsvExportDialog::loadSettings()
         index = index < 0 ? 0 : index;
         ui->separator->setCurrentIndex(index);
     }
+    ui->checkCompress->setChecked(m_settings.csvExportCompress());
     const QStringList& mediaToExport = m_settings.csvExportTypes();
     if (!mediaToExport.isEmpty()) {
         ui->checkMovies->setChecked(mediaToExport.contains("movies"));
@@ -527,7 +530,8 @@ void CsvExportDialog::loadSettings()
 
 bool CsvExportDialog::openFileOrPrintError(QFile& file)
 {
-    if (!file.open(QFile::WriteOnly | QFile::Text)) {
+    // Compressed files are binary; line endings are handled by the gzip device.
+    if (!file.open(m_compress ? QIODevice::OpenMode(QFile::WriteOnly) : QFile::WriteOnly | QFile::Text)) {
         ui->lblMessage->setErrorMessage(tr("Export failed. File could not be opened for writing."));
         qCInfo(generic) << "[CsvExport] Failed: Could not open file";
         return false;
@@ -535,9 +539,10 @@ bool CsvExportDialog::openFileOrPrintError(QFile& file)
     return true;
 }
 
-bool CsvExportDialog::checkTextStreamStatus(QTextStream& stream)
+bool CsvExportDialog::checkWriteStatus(QTextStream& stream, QFile& file)
 {
-    if (stream.status() != QTextStream::Ok) {
+    // Compressed data is written to the file when the gzip device is closed.
+    if (stream.status() != QTextStream::Ok || file.error() != QFileDevice::NoError) {
         ui->lblMessage->setErrorMessage(tr("Export failed. Could not write to CSV file."));
         qCInfo(generic) << "[CsvExport] Failed";
         return false;
@@ -552,8 +557,8 @@ QString CsvExportDialog::exportFilePath(const QDir& dir, const QString& filename
 
 QString CsvExportDialog::defaultCsvFileName(const QString& type) const
 {
-    return QStringLiteral("MediaElch_%1_%2.csv") //
-        .arg(type, QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss"));
+    return QStringLiteral("MediaElch_%1_%2.csv%3") //
+        .arg(type, QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss"), m_compress ? ".gz" : "");
 }
 
 void CsvExportDialog::toggleMediaDetails(QListWidget* widget, bool isChecked)
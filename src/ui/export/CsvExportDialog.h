@@ -1,6 +1,7 @@
 #pragma once
 
 #include "export/CsvExport.h"
+#include "export/GzipDevice.h"
 
 #include <QDialog>
 #include <QDir>
@@ -70,7 +71,12 @@ private:
         if (!isOpen) {
             return;
         }
-        QTextStream out(&file);
+        mediaelch::GzipDevice gzip(&file);
+        if (m_compress) {
+            // Text mode keeps the platform's line endings inside the archive.
+            gzip.open(QIODevice::WriteOnly | QIODevice::Text);
+        }
+        QTextStream out(m_compress ? static_cast<QIODevice*>(&gzip) : &file);
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
         // Default in Qt6
         out.setCodec("UTF-8");
@@ -80,12 +86,13 @@ private:
         callback(out);
         // flush before closing the file or the data won't be written
         out.flush();
+        gzip.close();
         file.close();
-        m_shouldAbort = !checkTextStreamStatus(out);
+        m_shouldAbort = !checkWriteStatus(out, file);
     }
 
     bool openFileOrPrintError(QFile& file);
-    bool checkTextStreamStatus(QTextStream& stream);
+    bool checkWriteStatus(QTextStream& stream, QFile& file);
     QString exportFilePath(const QDir& dir, const QString& filename) const;
     QString defaultCsvFileName(const QString& type) const;
     void toggleMediaDetails(QListWidget* widget, bool isChecked);
@@ -94,4 +101,5 @@ private:
     Ui::CsvExportDialog* ui;
     Settings& m_settings;
     bool m_shouldAbort = false;
+    bool m_compress = false;
 };
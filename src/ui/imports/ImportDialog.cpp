@@ -34,6 +34,7 @@ ImportDialog::ImportDialog(QWidget* parent) : QDialog(parent), ui(new Ui::Import
     m_timer.setInterval(500);
 
     m_posterDownloadManager = new DownloadManager(this);
+    m_posterDownloadManager->setPriority(mediaelch::network::DownloadScheduler::Priority::Visible);
     connect(m_posterDownloadManager,
         &DownloadManager::sigDownloadFinished,
         this,
@@ -663,6 +664,7 @@ void ImportDialog::onMovingFilesFinished()
         m_movie->controller()->loadStreamDetailsFromFile();
         m_movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
         m_movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
+        m_movie->updateHasLocalTrailer();
         Manager::instance()->database()->addMovie(m_movie, mediaelch::DirectoryPath(importDir()));
         Manager::instance()->database()->commit();
         Manager::instance()->movieModel()->addMovie(m_movie);
@@ -78,6 +78,9 @@ void AboutDialog::setDeveloperDetails()
                << "Data dir: "
                << QDir::toNativeSeparators(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation))
                << "<br>"
+               << "Network cache dir: " << Settings::instance()->networkCacheDir().toNativePathString() << "<br>"
+               << "Export image cache dir: " << Settings::instance()->exportImageCacheDir().toNativePathString()
+               << "<br>"
                << "Qt Translation Path: "
                << QDir::toNativeSeparators(QLibraryInfo::location(QLibraryInfo::TranslationsPath)) //
                << "<br><br>";
@@ -50,7 +50,12 @@ FileScannerDialog::FileScannerDialog(QWidget* parent) : QDialog(parent), ui(new
     connect(manager->musicFileSearcher(),   &MusicFileSearcher::searchStarted,   ui->status, &QLabel::setText);
     // clang-format on
 
+    // The file searchers are also used by the LibraryWatcher for background updates.
+    // Only react to them if the dialog is actually scanning.
     connect(manager->movieFileSearcher(), &MovieFileSearcher::finished, [this]() {
+        if (!isVisible()) {
+            return;
+        }
         if (m_reloadType != ReloadType::All) {
             accept();
         } else {
@@ -58,6 +63,9 @@ FileScannerDialog::FileScannerDialog(QWidget* parent) : QDialog(parent), ui(new
         }
     });
     connect(manager->tvShowFileSearcher(), &TvShowFileSearcher::tvShowsLoaded, [this]() {
+        if (!isVisible()) {
+            return;
+        }
         if (m_reloadType != ReloadType::All) {
             accept();
         } else {
@@ -65,13 +73,20 @@ FileScannerDialog::FileScannerDialog(QWidget* parent) : QDialog(parent), ui(new
         }
     });
     connect(manager->concertFileSearcher(), &ConcertFileSearcher::concertsLoaded, [this]() {
+        if (!isVisible()) {
+            return;
+        }
         if (m_reloadType != ReloadType::All) {
             accept();
         } else {
             onStartMusicScanner();
         }
     });
-    connect(manager->musicFileSearcher(), &MusicFileSearcher::musicLoaded, this, &FileScannerDialog::accept);
+    connect(manager->musicFileSearcher(), &MusicFileSearcher::musicLoaded, this, [this]() {
+        if (isVisible()) {
+            accept();
+        }
+    });
 }
 
 /**
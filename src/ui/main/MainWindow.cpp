@@ -7,6 +7,7 @@
 #include "globals/Helper.h"
 #include "globals/ImageDialog.h"
 #include "globals/ImagePreviewDialog.h"
+#include "globals/LibraryWatcher.h"
 #include "globals/Manager.h"
 #include "log/Log.h"
 #include "media_centers/MediaCenterInterface.h"
@@ -105,6 +106,7 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
     m_fileScannerDialog = new FileScannerDialog(this);
     m_xbmcSync = new KodiSync(Settings::instance()->kodiSettings(), this);
     m_renamer = new RenamerDialog(this);
+    m_libraryWatcher = new mediaelch::LibraryWatcher(this);
     setupToolbar();
 
     NotificationBox::instance(this)->reposition(this->size());
@@ -213,6 +215,7 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
     connect(Manager::instance()->tvShowFileSearcher(), &TvShowFileSearcher::tvShowsLoaded, [this]() { ui->tvShowFilesWidget->renewModel(true); });
     connect(Manager::instance()->tvShowFileSearcher(), &TvShowFileSearcher::tvShowsLoaded, this, &MainWindow::updateTvShows);
     connect(m_fileScannerDialog,                       &QDialog::accepted,                 this, &MainWindow::setNewMarks);
+    connect(m_fileScannerDialog,                       &QDialog::accepted,                 m_libraryWatcher, &mediaelch::LibraryWatcher::updateDirectories);
     connect(ui->downloadsWidget,                       &DownloadsWidget::sigScanFinished,  this, &MainWindow::setNewMarks);
 
     connect(m_xbmcSync, &KodiSync::sigTriggerReload, this, &MainWindow::onTriggerReloadAll);
@@ -221,6 +224,7 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
     connect(m_renamer, &RenamerDialog::sigFilesRenamed, this, &MainWindow::onFilesRenamed);
 
     connect(m_settingsWindow, &SettingsWindow::sigSaved, this, &MainWindow::onRenewModels, Qt::QueuedConnection);
+    connect(m_settingsWindow, &SettingsWindow::sigSaved, m_libraryWatcher, &mediaelch::LibraryWatcher::updateDirectories, Qt::QueuedConnection);
 
     connect(ui->setsWidget,            &SetsWidget::sigJumpToMovie,          this, &MainWindow::onJumpToMovie);
     connect(ui->certificationWidget,   &CertificationWidget::sigJumpToMovie, this, &MainWindow::onJumpToMovie);
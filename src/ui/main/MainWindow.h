@@ -19,6 +19,10 @@ namespace Ui {
 class MainWindow;
 }
 
+namespace mediaelch {
+class LibraryWatcher;
+}
+
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -81,6 +85,7 @@ private:
     FileScannerDialog* m_fileScannerDialog = nullptr;
     KodiSync* m_xbmcSync = nullptr;
     RenamerDialog* m_renamer = nullptr;
+    mediaelch::LibraryWatcher* m_libraryWatcher = nullptr;
     QAction* m_actionSearch = nullptr;
     QAction* m_actionSave = nullptr;
     QAction* m_actionXbmc = nullptr;
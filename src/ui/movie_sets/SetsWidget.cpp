@@ -42,6 +42,7 @@ SetsWidget::SetsWidget(QWidget* parent) : QWidget(parent), ui(new Ui::SetsWidget
     m_loadingMovie = new QMovie(":/img/spinner.gif", QByteArray(), this);
     m_loadingMovie->start();
     m_downloadManager = new DownloadManager(this);
+    m_downloadManager->setPriority(mediaelch::network::DownloadScheduler::Priority::Visible);
 
     // clang-format off
     connect(ui->sets,                  &QTableWidget::itemSelectionChanged,   this, &SetsWidget::onSetSelected);
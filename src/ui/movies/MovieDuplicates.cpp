@@ -6,6 +6,7 @@
 #include "globals/MessageIds.h"
 #include "log/Log.h"
 #include "movies/Movie.h"
+#include "movies/MovieModel.h"
 #include "movies/MovieProxyModel.h"
 #include "ui/movies/MovieDuplicateItem.h"
 #include "ui/notifications/NotificationBox.h"
@@ -54,6 +55,10 @@ MovieDuplicates::MovieDuplicates(QWidget* parent) : QWidget(parent), ui(new Ui::
     connect(ui->btnDetect,                &QPushButton::clicked,                this, &MovieDuplicates::detectDuplicates);
     connect(ui->movies->selectionModel(), &QItemSelectionModel::currentChanged, this, &MovieDuplicates::onItemActivated);
     // clang-format on
+    connect(Manager::instance()->movieModel()->duplicateIndex(),
+        &MovieDuplicateIndex::sigRebuilt,
+        this,
+        &MovieDuplicates::onDuplicatesDetected);
 }
 
 MovieDuplicates::~MovieDuplicates()
@@ -68,35 +73,21 @@ void MovieDuplicates::detectDuplicates()
 
     ui->duplicates->clear();
     ui->duplicates->setRowCount(0);
-    m_duplicateMovies.clear();
+    ui->btnDetect->setEnabled(false);
 
-    int counter = 0;
-    int movieCount = Manager::instance()->movieModel()->movies().count();
     NotificationBox::instance()->showProgressBar(
         tr("Detecting duplicate movies..."), Constants::MovieDuplicatesProgressMessageId);
-    NotificationBox::instance()->progressBarProgress(0, movieCount, Constants::MovieDuplicatesProgressMessageId);
-
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
-        ++counter;
-        QApplication::processEvents();
-
-        NotificationBox::instance()->progressBarProgress(
-            counter, movieCount, Constants::MovieDuplicatesProgressMessageId);
-        movie->setHasDuplicates(false);
-
-        QVector<Movie*> dups{movie};
-        for (Movie* subMovie : Manager::instance()->movieModel()->movies()) {
-            if (movie != subMovie && subMovie->isDuplicate(movie)) {
-                dups.append(subMovie);
-            }
-        }
-        if (dups.count() > 1) {
-            m_duplicateMovies.insert(movie, dups);
-            movie->setHasDuplicates(true);
-        }
-    }
+    NotificationBox::instance()->progressBarProgress(0, 0, Constants::MovieDuplicatesProgressMessageId);
+
+    // The index is built in a background thread, see onDuplicatesDetected().
+    MovieModel* model = Manager::instance()->movieModel();
+    model->duplicateIndex()->rebuild(model->movies());
+}
 
+void MovieDuplicates::onDuplicatesDetected()
+{
     NotificationBox::instance()->hideProgressBar(Constants::MovieDuplicatesProgressMessageId);
+    ui->btnDetect->setEnabled(true);
 }
 
 void MovieDuplicates::onItemActivated(QModelIndex /*index*/, QModelIndex /*previous*/)
@@ -106,14 +97,15 @@ void MovieDuplicates::onItemActivated(QModelIndex /*index*/, QModelIndex /*previ
         return;
     }
 
-    if (!m_duplicateMovies.contains(movie)) {
+    const QVector<Movie*> duplicates = Manager::instance()->movieModel()->duplicateIndex()->duplicatesOf(movie);
+    if (duplicates.size() < 2) {
         return;
     }
 
     ui->duplicates->clear();
     ui->duplicates->setRowCount(0);
 
-    for (Movie* dup : asConst(m_duplicateMovies[movie])) {
+    for (Movie* dup : duplicates) {
         auto* item = new MovieDuplicateItem(ui->duplicates);
         item->setMovie(dup, dup == movie);
         item->setDuplicateProperties(movie->duplicateProperties(dup));
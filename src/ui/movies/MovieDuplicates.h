@@ -1,8 +1,6 @@
 #pragma once
 
-#include <QMap>
 #include <QModelIndex>
-#include <QVector>
 #include <QWidget>
 
 namespace Ui {
@@ -26,6 +24,7 @@ signals:
 
 private slots:
     void detectDuplicates();
+    void onDuplicatesDetected();
     void onItemActivated(QModelIndex /*index*/, QModelIndex /*previous*/);
 
     void showContextMenu(QPoint point);
@@ -41,6 +40,4 @@ private:
     Ui::MovieDuplicates* ui;
     MovieProxyModel* m_movieProxyModel;
     QMenu* m_contextMenu = nullptr;
-
-    QMap<Movie*, QVector<Movie*>> m_duplicateMovies;
 };
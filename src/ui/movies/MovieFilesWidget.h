@@ -7,6 +7,7 @@
 #include <QMenu>
 #include <QModelIndex>
 #include <QMouseEvent>
+#include <QPointer>
 #include <QResizeEvent>
 #include <QWidget>
 
@@ -81,7 +82,8 @@ private slots:
 private:
     Ui::MovieFilesWidget* ui;
     MovieProxyModel* m_movieProxyModel;
-    Movie* m_lastMovie;
+    /// \brief Guarded; movies may be removed by MovieFileSearcher::updateDirectory().
+    QPointer<Movie> m_lastMovie;
     QModelIndex m_lastModelIndex;
     static MovieFilesWidget* m_instance;
     QMenu* m_contextMenu = nullptr;
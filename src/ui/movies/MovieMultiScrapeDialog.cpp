@@ -2,6 +2,7 @@
 #include "ui_MovieMultiScrapeDialog.h"
 
 #include "globals/Manager.h"
+#include "scrapers/image/FanartTv.h"
 #include "scrapers/movie/custom/CustomMovieScraper.h"
 #include "scrapers/movie/imdb/ImdbMovie.h"
 #include "scrapers/movie/tmdb/TmdbMovie.h"
@@ -68,6 +69,11 @@ MovieMultiScrapeDialog::MovieMultiScrapeDialog(QWidget* parent) : QDialog(parent
         elchOverload<int>(&QComboBox::currentIndexChanged),
         this,
         &MovieMultiScrapeDialog::setCheckBoxesEnabled);
+
+    using mediaelch::scraper::ScrapeScheduler;
+    connect(&m_scheduler, &ScrapeScheduler::sigItemStarted, this, &MovieMultiScrapeDialog::onMovieStarted);
+    connect(&m_scheduler, &ScrapeScheduler::sigItemFinished, this, &MovieMultiScrapeDialog::onMovieFinished);
+    connect(&m_scheduler, &ScrapeScheduler::sigFinished, this, &MovieMultiScrapeDialog::onScrapingFinished);
 }
 
 MovieMultiScrapeDialog::~MovieMultiScrapeDialog()
@@ -77,7 +83,8 @@ MovieMultiScrapeDialog::~MovieMultiScrapeDialog()
 
 int MovieMultiScrapeDialog::exec()
 {
-    m_queue.clear();
+    m_scheduler.cancel();
+    m_ids.clear();
     ui->movieCounter->setVisible(false);
     ui->comboScraper->setEnabled(true);
     ui->btnCancel->setVisible(true);
@@ -112,10 +119,13 @@ void MovieMultiScrapeDialog::accept()
 void MovieMultiScrapeDialog::reject()
 {
     m_executed = false;
-    if (m_currentMovie != nullptr) {
-        m_queue.clear();
-        m_currentMovie->controller()->abortDownloads();
+    m_scheduler.cancel();
+    // Copy: Aborting may finish the movie and with that change the running items.
+    const QSet<int> runningItems = m_scheduler.runningItems();
+    for (int index : runningItems) {
+        m_movies.at(index)->controller()->abortDownloads();
     }
+    m_ids.clear();
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyImdb->isChecked());
     Settings::instance()->setMultiScrapeSaveEach(ui->chkAutoSave->isChecked());
     Settings::instance()->saveSettings();
@@ -147,12 +157,27 @@ void MovieMultiScrapeDialog::onStartScraping()
     m_isTmdb = m_scraperInterface->meta().identifier == TmdbMovie::ID;
     m_isImdb = m_scraperInterface->meta().identifier == ImdbMovie::ID;
 
-    m_queue.append(m_movies.toList());
+    ScrapeScheduler::Limits limits = ScrapeScheduler::limitsForScraper(m_scraperInterface->meta().identifier);
+    // The MovieController loads images from Fanart.tv that the scraper does not provide itself.
+    const QSet<MovieScraperInfo> fanartTvInfos{MovieScraperInfo::Backdrop,
+        MovieScraperInfo::Poster,
+        MovieScraperInfo::ClearArt,
+        MovieScraperInfo::CdArt,
+        MovieScraperInfo::Logo,
+        MovieScraperInfo::Banner,
+        MovieScraperInfo::Thumb};
+    for (MovieScraperInfo info : asConst(m_infosToLoad)) {
+        if (fanartTvInfos.contains(info) && !m_scraperInterface->scraperNativelySupports().contains(info)) {
+            limits = ScrapeScheduler::combine(limits, ScrapeScheduler::limitsForScraper(FanartTv::ID));
+            break;
+        }
+    }
+    m_scheduler.setLimits(limits);
 
-    ui->movieCounter->setText(QString("0/%1").arg(m_queue.count()));
+    ui->movieCounter->setText(QString("0/%1").arg(m_movies.count()));
     ui->movieCounter->setVisible(true);
     ui->progressAll->setMaximum(m_movies.count());
-    scrapeNext();
+    m_scheduler.start(m_movies.count(), [this](int index) { return scrapeMovie(m_movies.at(index)); });
 }
 
 void MovieMultiScrapeDialog::onScrapingFinished()
@@ -175,89 +200,98 @@ void MovieMultiScrapeDialog::onScrapingFinished()
     ui->btnStartScraping->setVisible(false);
 }
 
-void MovieMultiScrapeDialog::scrapeNext()
+void MovieMultiScrapeDialog::onMovieStarted(int index)
 {
-    using namespace mediaelch::scraper;
+    m_currentMovie = m_movies.at(index);
+    ui->movie->setText(m_currentMovie->name().trimmed());
+    ui->progressMovie->setValue(0);
+}
 
-    if (!isExecuted()) {
-        return;
-    }
+void MovieMultiScrapeDialog::onMovieFinished()
+{
+    ui->movieCounter->setText(QString("%1/%2").arg(m_scheduler.finishedCount()).arg(m_movies.count()));
+    ui->progressAll->setValue(m_scheduler.finishedCount());
+}
 
-    if ((m_currentMovie != nullptr) && ui->chkAutoSave->isChecked()) {
-        m_currentMovie->controller()->saveData(Manager::instance()->mediaCenterInterface());
-    }
+bool MovieMultiScrapeDialog::scrapeMovie(Movie* movie)
+{
+    using namespace mediaelch::scraper;
 
-    if (m_queue.isEmpty()) {
-        onScrapingFinished();
-        return;
+    if (!isExecuted()) {
+        return false;
     }
 
-    m_currentMovie = m_queue.dequeue();
-
-    ui->movie->setText(m_currentMovie->name().trimmed());
-    ui->movieCounter->setText(QString("%1/%2").arg(m_movies.count() - m_queue.count()).arg(m_movies.count()));
-
-    ui->progressAll->setValue(ui->progressAll->maximum() - m_queue.size() - 1);
-    ui->progressMovie->setValue(0);
-
     if (ui->chkOnlyImdb->isChecked()
-        && ((!m_currentMovie->imdbId().isValid() && m_isImdb)
-            || (!m_currentMovie->tmdbId().isValid() && !m_currentMovie->imdbId().isValid() && m_isTmdb)
-            || (!m_currentMovie->imdbId().isValid() && !m_currentMovie->tmdbId().isValid()
+        && ((!movie->imdbId().isValid() && m_isImdb)
+            || (!movie->tmdbId().isValid() && !movie->imdbId().isValid() && m_isTmdb)
+            || (!movie->imdbId().isValid() && !movie->tmdbId().isValid()
                 && m_scraperInterface->meta().identifier == CustomMovieScraper::ID))) {
-        scrapeNext();
-        return;
+        return false;
     }
 
-    connect(m_currentMovie->controller(),
+    connect(movie->controller(),
         &MovieController::sigLoadDone,
         this,
-        &MovieMultiScrapeDialog::scrapeNext,
+        &MovieMultiScrapeDialog::onLoadDone,
         Qt::UniqueConnection);
-    connect(m_currentMovie->controller(),
+    connect(movie->controller(),
         &MovieController::sigDownloadProgress,
         this,
         &MovieMultiScrapeDialog::onProgress,
         Qt::UniqueConnection);
 
-    m_currentIds.clear();
+    m_ids.insert(movie, {});
 
-    if (m_isImdb && m_currentMovie->imdbId().isValid()) {
-        loadMovieData(m_currentMovie, m_currentMovie->imdbId());
-        return;
+    if (m_isImdb && movie->imdbId().isValid()) {
+        loadMovieData(movie, movie->imdbId());
+        return true;
     }
-    if (m_isTmdb && m_currentMovie->tmdbId().isValid()) {
-        loadMovieData(m_currentMovie, m_currentMovie->tmdbId());
-        return;
+    if (m_isTmdb && movie->tmdbId().isValid()) {
+        loadMovieData(movie, movie->tmdbId());
+        return true;
     }
-    if (m_isTmdb && m_currentMovie->imdbId().isValid()) {
-        loadMovieData(m_currentMovie, m_currentMovie->imdbId());
-        return;
+    if (m_isTmdb && movie->imdbId().isValid()) {
+        loadMovieData(movie, movie->imdbId());
+        return true;
     }
 
-    MovieSearchJob::Config config;
-    config.includeAdult = Settings::instance()->showAdultScrapers();
-    // FIXME config.locale =
-    config.query = m_currentMovie->name();
-    config.query = config.query.replace(".", " ");
-
     MovieScraper* scraperForSearchJob = m_scraperInterface;
+    QString query = movie->name();
 
     if (m_scraperInterface->meta().identifier == CustomMovieScraper::ID) {
         scraperForSearchJob = CustomMovieScraper::instance()->titleScraper();
         const QString& titleScraper = scraperForSearchJob->meta().identifier;
 
-        if ((titleScraper == ImdbMovie::ID || titleScraper == TmdbMovie::ID) && m_currentMovie->imdbId().isValid()) {
-            config.query = m_currentMovie->imdbId().toString();
+        if ((titleScraper == ImdbMovie::ID || titleScraper == TmdbMovie::ID) && movie->imdbId().isValid()) {
+            query = movie->imdbId().toString();
 
-        } else if (titleScraper == TmdbMovie::ID && m_currentMovie->tmdbId().isValid()) {
-            config.query = m_currentMovie->tmdbId().withPrefix();
+        } else if (titleScraper == TmdbMovie::ID && movie->tmdbId().isValid()) {
+            query = movie->tmdbId().withPrefix();
         }
     }
 
-    auto* searchJob = m_scraperInterface->search(config);
-    searchJob->setProperty("scraper", QVariant::fromValue(scraperForSearchJob));
-    connect(searchJob, &MovieSearchJob::sigFinished, this, &MovieMultiScrapeDialog::onSearchFinished);
+    // The custom movie scraper forwards the search to its title scraper.
+    startSearch(movie, m_scraperInterface, scraperForSearchJob, query);
+    return true;
+}
+
+void MovieMultiScrapeDialog::startSearch(Movie* movie,
+    mediaelch::scraper::MovieScraper* scraper,
+    mediaelch::scraper::MovieScraper* resultScraper,
+    QString query)
+{
+    using namespace mediaelch::scraper;
+
+    MovieSearchJob::Config config;
+    config.includeAdult = Settings::instance()->showAdultScrapers();
+    // FIXME config.locale =
+    config.query = query.replace(".", " ");
+
+    auto* searchJob = scraper->search(config);
+    searchJob->setProperty("scraper", QVariant::fromValue(resultScraper));
+    connect(searchJob, &MovieSearchJob::sigFinished, this, [this, movie](MovieSearchJob* job) { //
+        onSearchFinished(job, movie);
+    });
     searchJob->start();
 }
 
@@ -277,80 +311,90 @@ void MovieMultiScrapeDialog::loadMovieData(Movie* movie, TmdbId id)
     movie->controller()->loadData(ids, m_scraperInterface, m_infosToLoad);
 }
 
-void MovieMultiScrapeDialog::onSearchFinished(mediaelch::scraper::MovieSearchJob* searchJob)
+void MovieMultiScrapeDialog::onSearchFinished(mediaelch::scraper::MovieSearchJob* searchJob, Movie* movie)
 {
     using namespace mediaelch::scraper;
 
     auto dls = makeDeleteLaterScope(searchJob);
 
-    if (!isExecuted()) {
+    if (!isExecuted() || !m_ids.contains(movie)) {
         return;
     }
 
     if (searchJob->hasError()) {
         // TODO: Show the error
-        scrapeNext();
+        finishMovie(movie);
         return;
     }
 
     if (searchJob->results().isEmpty()) {
-        scrapeNext();
+        finishMovie(movie);
         return;
     }
 
+    QHash<MovieScraper*, MovieIdentifier>& ids = m_ids[movie];
+
     if (m_scraperInterface->meta().identifier == CustomMovieScraper::ID) {
         if (!searchJob->property("scraper").isValid()) {
             qCCritical(generic) << "[MovieMultiScraperDialog] Could not get scraper from search job! Invalid QVariant";
-            scrapeNext();
+            finishMovie(movie);
             return;
         }
         auto* scraper = searchJob->property("scraper").value<MovieScraper*>();
         if (scraper == nullptr) {
             qCCritical(generic)
                 << "[MovieMultiScraperDialog] Could not get scraper from search job! Scraper is nullptr";
-            scrapeNext();
+            finishMovie(movie);
             return;
         }
-        m_currentIds.insert(scraper, searchJob->results().first().identifier);
+        ids.insert(scraper, searchJob->results().first().identifier);
         const QVector<MovieScraper*>& searchScrapers =
-            CustomMovieScraper::instance()->scrapersNeedSearch(m_infosToLoad, m_currentIds);
+            CustomMovieScraper::instance()->scrapersNeedSearch(m_infosToLoad, ids);
 
         if (!searchScrapers.isEmpty()) {
-            MovieSearchJob::Config config;
-            // FIXME config.locale = TODO
-            config.includeAdult = Settings::instance()->showAdultScrapers();
-            config.query = m_currentMovie->name();
-            config.query = config.query.replace(".", " ");
-
-            if ((searchScrapers.first()->meta().identifier == TmdbMovie::ID
-                    || searchScrapers.first()->meta().identifier == ImdbMovie::ID)
-                && m_currentMovie->imdbId().isValid()) {
-                config.query = m_currentMovie->imdbId().toString();
-
-            } else if (searchScrapers.first()->meta().identifier == TmdbMovie::ID
-                       && m_currentMovie->tmdbId().isValid()) {
-                config.query = m_currentMovie->tmdbId().toString();
-            }
+            MovieScraper* nextScraper = searchScrapers.first();
+            QString query = movie->name();
 
-            auto* nextSearchJob = searchScrapers.first()->search(config);
-            nextSearchJob->setProperty("scraper", QVariant::fromValue(searchScrapers.first()));
-            connect(nextSearchJob, &MovieSearchJob::sigFinished, this, &MovieMultiScrapeDialog::onSearchFinished);
-            nextSearchJob->start();
+            if ((nextScraper->meta().identifier == TmdbMovie::ID || nextScraper->meta().identifier == ImdbMovie::ID)
+                && movie->imdbId().isValid()) {
+                query = movie->imdbId().toString();
 
+            } else if (nextScraper->meta().identifier == TmdbMovie::ID && movie->tmdbId().isValid()) {
+                query = movie->tmdbId().toString();
+            }
+
+            startSearch(movie, nextScraper, nextScraper, query);
             return;
         }
     } else {
-        m_currentIds.insert(m_scraperInterface, searchJob->results().first().identifier);
+        ids.insert(m_scraperInterface, searchJob->results().first().identifier);
     }
 
-    m_currentMovie->controller()->loadData(m_currentIds, m_scraperInterface, m_infosToLoad);
+    movie->controller()->loadData(ids, m_scraperInterface, m_infosToLoad);
 }
 
-void MovieMultiScrapeDialog::onProgress(Movie* movie, int current, int maximum)
+void MovieMultiScrapeDialog::onLoadDone(Movie* movie)
+{
+    if (!isExecuted() || !m_ids.contains(movie)) {
+        // Not scraped by this dialog, e.g. scraped later on using the movie widget.
+        return;
+    }
+    if (ui->chkAutoSave->isChecked()) {
+        movie->controller()->saveDataInBackground(
+            Manager::instance()->mediaCenterInterface(), *Manager::instance()->saveQueue());
+    }
+    finishMovie(movie);
+}
+
+void MovieMultiScrapeDialog::finishMovie(Movie* movie)
 {
-    Q_UNUSED(movie);
+    m_ids.remove(movie);
+    m_scheduler.finishItem(m_movies.indexOf(movie));
+}
 
-    if (!isExecuted()) {
+void MovieMultiScrapeDialog::onProgress(Movie* movie, int current, int maximum)
+{
+    if (!isExecuted() || movie != m_currentMovie) {
         return;
     }
     ui->progressMovie->setValue(maximum - current);
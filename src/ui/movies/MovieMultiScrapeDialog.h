@@ -2,11 +2,12 @@
 
 #include "globals/ScraperResult.h"
 #include "movies/Movie.h"
+#include "scrapers/ScrapeScheduler.h"
 #include "scrapers/movie/MovieIdentifier.h"
 
 #include <QDialog>
+#include <QHash>
 #include <QPointer>
-#include <QQueue>
 
 namespace Ui {
 class MovieMultiScrapeDialog;
@@ -36,8 +37,9 @@ public slots:
 private slots:
     void onStartScraping();
     void onScrapingFinished();
-    void onSearchFinished(mediaelch::scraper::MovieSearchJob* searchJob);
-    void scrapeNext();
+    void onMovieStarted(int index);
+    void onMovieFinished();
+    void onLoadDone(Movie* movie);
     void onProgress(Movie* movie, int current, int maximum);
     void onChkToggled();
     void onChkAllToggled();
@@ -46,15 +48,26 @@ private slots:
 private:
     Ui::MovieMultiScrapeDialog* ui = nullptr;
     QVector<Movie*> m_movies;
-    QQueue<Movie*> m_queue;
+    /// \brief The most recently started movie. Its progress is shown.
     QPointer<Movie> m_currentMovie;
     mediaelch::scraper::MovieScraper* m_scraperInterface = nullptr;
-    QHash<mediaelch::scraper::MovieScraper*, mediaelch::scraper::MovieIdentifier> m_currentIds;
+    mediaelch::scraper::ScrapeScheduler m_scheduler;
+    /// \brief IDs found so far for each movie that is being scraped.
+    QHash<Movie*, QHash<mediaelch::scraper::MovieScraper*, mediaelch::scraper::MovieIdentifier>> m_ids;
     bool m_isImdb = false;
     bool m_isTmdb = false;
     bool m_executed = false;
     QSet<MovieScraperInfo> m_infosToLoad;
+
+    bool scrapeMovie(Movie* movie);
+    /// \brief Searches using the given scraper. The result is stored for resultScraper.
+    void startSearch(Movie* movie,
+        mediaelch::scraper::MovieScraper* scraper,
+        mediaelch::scraper::MovieScraper* resultScraper,
+        QString query);
+    void onSearchFinished(mediaelch::scraper::MovieSearchJob* searchJob, Movie* movie);
     void loadMovieData(Movie* movie, ImdbId id);
     void loadMovieData(Movie* movie, TmdbId id);
+    void finishMovie(Movie* movie);
     bool isExecuted() const;
 };
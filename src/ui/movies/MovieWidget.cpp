@@ -66,6 +66,7 @@ MovieWidget::MovieWidget(QWidget* parent) : QWidget(parent), ui(new Ui::MovieWid
     ui->labelThumb->setFont(font);
 
     m_movie = nullptr;
+    connect(Manager::instance()->movieModel(), &MovieModel::sigMovieRemoved, this, &MovieWidget::onMovieRemoved);
 
     ui->poster->setDefaultPixmap(QPixmap(":/img/placeholders/poster.png"));
     ui->backdrop->setDefaultPixmap(QPixmap(":/img/placeholders/fanart.png"));
@@ -153,6 +154,8 @@ MovieWidget::MovieWidget(QWidget* parent) : QWidget(parent), ui(new Ui::MovieWid
     m_savingWidget->setMovie(m_loadingMovie);
     m_savingWidget->hide();
 
+    connect(Manager::instance()->saveQueue(), &mediaelch::SaveQueue::sigJobFinished, this, &MovieWidget::onMovieSaved);
+
     ui->btnImdb->setIcon(style()->standardIcon(QStyle::SP_ArrowRight));
     ui->btnTmdb->setIcon(style()->standardIcon(QStyle::SP_ArrowRight));
     ui->btnImdb->setText(QLatin1String(""));
@@ -366,6 +369,11 @@ void MovieWidget::setMovie(Movie* movie)
             movie->setRuntime(duration_cast<minutes>(durationInSeconds));
         }
     }
+    if (m_movie != nullptr && m_movie != movie) {
+        m_movie->controller()->setDownloadPriority(mediaelch::network::DownloadScheduler::Priority::Normal);
+    }
+    // Images of the shown movie are downloaded before those of other movies.
+    movie->controller()->setDownloadPriority(mediaelch::network::DownloadScheduler::Priority::Visible);
     m_movie = movie;
     updateMovieInfo();
 
@@ -886,36 +894,18 @@ void MovieWidget::saveInformation()
     }
 
     m_savingWidget->show();
+    ui->buttonRevert->setVisible(false);
     if (movies.count() > 1) {
-        int counter = 0;
-        const int moviesToSave = movies.count();
-
-        NotificationBox::instance()->showProgressBar(tr("Saving movies..."), Constants::MovieWidgetProgressMessageId);
-        NotificationBox::instance()->progressBarProgress(0, moviesToSave, Constants::MovieWidgetProgressMessageId);
-        QApplication::processEvents();
-        for (Movie* movie : movies) {
-            if (movie->hasChanged()) {
-                counter++;
-                NotificationBox::instance()->progressBarProgress(
-                    counter, moviesToSave, Constants::MovieWidgetProgressMessageId);
-                QApplication::processEvents();
-                movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
-                movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
-                if (m_movie == movie) {
-                    updateMovieInfo();
-                }
-            }
-        }
-        NotificationBox::instance()->hideProgressBar(Constants::MovieWidgetProgressMessageId);
-        NotificationBox::instance()->showSuccess(tr("Movies Saved"));
-    } else {
-        const int id = NotificationBox::instance()->showMessage(tr("Saving movie..."));
-        m_movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
-        m_movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
-        updateMovieInfo();
-        NotificationBox::instance()->removeMessage(id);
-        NotificationBox::instance()->showSuccess(tr("<b>\"%1\"</b> Saved").arg(m_movie->name()));
+        saveMoviesInBackground(movies, tr("Movies Saved"));
+        return;
     }
+
+    const int id = NotificationBox::instance()->showMessage(tr("Saving movie..."));
+    m_movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
+    m_movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
+    updateMovieInfo();
+    NotificationBox::instance()->removeMessage(id);
+    NotificationBox::instance()->showSuccess(tr("<b>\"%1\"</b> Saved").arg(m_movie->name()));
     setEnabledTrue();
     m_savingWidget->hide();
     ui->buttonRevert->setVisible(false);
@@ -929,38 +919,71 @@ void MovieWidget::saveAll()
     qCDebug(generic) << "[Movies] Save all movies";
     setDisabledTrue();
     m_savingWidget->show();
+    ui->buttonRevert->setVisible(false);
+    saveMoviesInBackground(Manager::instance()->movieModel()->movies(), tr("All Movies Saved"));
+}
 
-    int counter = 0;
-    int moviesToSave = 0;
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
+void MovieWidget::saveMoviesInBackground(const QVector<Movie*>& movies, const QString& successMessage)
+{
+    // Changes are written to disk in worker threads. The widget stays disabled
+    // until all movies are saved and reloaded, see onMovieSaved().
+    m_moviesToSave = 0;
+    m_moviesSaved = 0;
+    m_saveSuccessMessage = successMessage;
+    for (Movie* movie : movies) {
         if (movie->hasChanged()) {
-            moviesToSave++;
+            m_moviesToSave++;
         }
     }
 
     NotificationBox::instance()->showProgressBar(tr("Saving movies..."), Constants::MovieWidgetProgressMessageId);
-    NotificationBox::instance()->progressBarProgress(0, moviesToSave, Constants::MovieWidgetProgressMessageId);
-    QApplication::processEvents();
+    NotificationBox::instance()->progressBarProgress(0, m_moviesToSave, Constants::MovieWidgetProgressMessageId);
 
-    const auto movies = Manager::instance()->movieModel()->movies();
     for (Movie* movie : movies) {
-        if (movie->hasChanged()) {
-            counter++;
-            NotificationBox::instance()->progressBarProgress(
-                counter, moviesToSave, Constants::MovieWidgetProgressMessageId);
-            QApplication::processEvents();
-            movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
-            movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
-            if (m_movie == movie) {
-                updateMovieInfo();
-            }
+        if (!movie->hasChanged()) {
+            continue;
+        }
+        const int jobId = movie->controller()->saveDataInBackground(
+            Manager::instance()->mediaCenterInterface(), *Manager::instance()->saveQueue());
+        if (jobId < 0) {
+            m_moviesSaved++;
+        } else {
+            m_savingMovies.insert(jobId, movie);
         }
     }
+
+    if (m_savingMovies.isEmpty()) {
+        onAllMoviesSaved();
+    }
+}
+
+void MovieWidget::onMovieSaved(int jobId, bool success)
+{
+    if (!m_savingMovies.contains(jobId)) {
+        return;
+    }
+    QPointer<Movie> movie = m_savingMovies.take(jobId);
+    m_moviesSaved++;
+    NotificationBox::instance()->progressBarProgress(
+        m_moviesSaved, m_moviesToSave, Constants::MovieWidgetProgressMessageId);
+    if (success && !movie.isNull()) {
+        // Reload the NFO that was just written.
+        movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
+        if (m_movie == movie) {
+            updateMovieInfo();
+        }
+    }
+    if (m_savingMovies.isEmpty()) {
+        onAllMoviesSaved();
+    }
+}
+
+void MovieWidget::onAllMoviesSaved()
+{
     setEnabledTrue();
     m_savingWidget->hide();
     NotificationBox::instance()->hideProgressBar(Constants::MovieWidgetProgressMessageId);
-    NotificationBox::instance()->showSuccess(tr("All Movies Saved"));
-    ui->buttonRevert->setVisible(false);
+    NotificationBox::instance()->showSuccess(m_saveSuccessMessage);
 }
 
 /// \brief Revert changes for current movie
@@ -1429,6 +1452,17 @@ void MovieWidget::onExtraFanartDropped(QUrl imageUrl)
     ui->buttonRevert->setVisible(true);
 }
 
+/// \brief Deselects the movie if it was removed from the model, e.g. by LibraryWatcher.
+void MovieWidget::onMovieRemoved(Movie* movie)
+{
+    if (movie != m_movie) {
+        return;
+    }
+    m_movie = nullptr;
+    clear();
+    setDisabledTrue();
+}
+
 void MovieWidget::onInsertYoutubeLink()
 {
     if (Settings::instance()->useYoutubePluginUrls()) {
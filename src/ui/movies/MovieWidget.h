@@ -3,6 +3,7 @@
 #include "movies/Movie.h"
 
 #include <QCompleter>
+#include <QHash>
 #include <QLabel>
 #include <QMenu>
 #include <QMutex>
@@ -58,6 +59,7 @@ private slots:
     void onImageDropped(ImageType imageType, QUrl imageUrl);
     void onCaptureImage(ImageType type);
     void onExtraFanartDropped(QUrl imageUrl);
+    void onMovieRemoved(Movie* movie);
 
     void onChooseImage();
     void onDeleteImage();
@@ -113,14 +115,24 @@ private slots:
     void onRemoveExtraFanart(QByteArray image);
     void onAddExtraFanart();
 
+    void onMovieSaved(int jobId, bool success);
+
 private:
     void updateImage(ImageType imageType, ClosableImage* image);
+    /// \brief Saves all changed movies in background threads, see mediaelch::SaveQueue.
+    void saveMoviesInBackground(const QVector<Movie*>& movies, const QString& successMessage);
+    void onAllMoviesSaved();
 
 private:
     Ui::MovieWidget* ui;
     QPointer<Movie> m_movie;
     QMovie* m_loadingMovie;
     QLabel* m_savingWidget;
+    /// \brief Movies that are saved in the background, by their SaveQueue job ID.
+    QHash<int, QPointer<Movie>> m_savingMovies;
+    int m_moviesToSave = 0;
+    int m_moviesSaved = 0;
+    QString m_saveSuccessMessage;
     QVector<QWidget*> m_streamDetailsWidgets;
     QVector<QVector<QLineEdit*>> m_streamDetailsAudio;
     QVector<QVector<QLineEdit*>> m_streamDetailsSubtitles;
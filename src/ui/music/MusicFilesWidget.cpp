@@ -17,6 +17,9 @@ MusicFilesWidget::MusicFilesWidget(QWidget* parent) : QWidget(parent), ui(new Ui
 
     m_proxyModel = new MusicProxyModel(this);
     m_proxyModel->setSourceModel(Manager::instance()->musicModel());
+    // Connected before the view's selection model so that a removed selection is not moved to another row.
+    connect(m_proxyModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &MusicFilesWidget::onRowsAboutToBeRemoved);
+    connect(m_proxyModel, &QAbstractItemModel::rowsInserted, this, &MusicFilesWidget::onRowsInserted);
     ui->music->setModel(m_proxyModel);
     ui->music->sortByColumn(0, Qt::AscendingOrder);
     ui->music->setAttribute(Qt::WA_MacShowFocusRect, false);
@@ -129,6 +132,9 @@ void MusicFilesWidget::setFilter(QVector<Filter*> filters, QString text)
 
 void MusicFilesWidget::onItemSelected(QModelIndex index)
 {
+    if (index.isValid()) {
+        m_removedSelectionDir.clear();
+    }
     QModelIndex sourceIndex = m_proxyModel->mapToSource(index);
     if (Manager::instance()->musicModel()->getItem(sourceIndex)->type() == MusicType::Artist) {
         emit sigArtistSelected(Manager::instance()->musicModel()->getItem(sourceIndex)->artist());
@@ -137,6 +143,51 @@ void MusicFilesWidget::onItemSelected(QModelIndex index)
     }
 }
 
+void MusicFilesWidget::onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last)
+{
+    const QModelIndex current = ui->music->currentIndex();
+    bool isRemoved = false;
+    for (QModelIndex index = current; index.isValid(); index = index.parent()) {
+        if (index.parent() == parent && index.row() >= first && index.row() <= last) {
+            isRemoved = true;
+            break;
+        }
+    }
+    if (!isRemoved) {
+        return;
+    }
+
+    MusicModelItem* item = Manager::instance()->musicModel()->getItem(m_proxyModel->mapToSource(current));
+    Artist* artist = nullptr;
+    if (item != nullptr && item->type() == MusicType::Artist) {
+        artist = item->artist();
+    } else if (item != nullptr && item->type() == MusicType::Album && item->album() != nullptr) {
+        artist = item->album()->artistObj();
+    }
+    m_removedSelectionDir = (artist != nullptr) ? artist->path().toString() : QString();
+    ui->music->selectionModel()->clearSelection();
+    ui->music->selectionModel()->clearCurrentIndex();
+    emit sigNothingSelected();
+}
+
+void MusicFilesWidget::onRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    if (m_removedSelectionDir.isEmpty() || parent.isValid()) {
+        return;
+    }
+    for (int row = first; row <= last; ++row) {
+        const QModelIndex index = m_proxyModel->index(row, 0);
+        MusicModelItem* item = Manager::instance()->musicModel()->getItem(m_proxyModel->mapToSource(index));
+        if (item != nullptr && item->artist() != nullptr
+            && item->artist()->path().toString() == m_removedSelectionDir) {
+            m_removedSelectionDir.clear();
+            ui->music->selectionModel()->setCurrentIndex(
+                index, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+            return;
+        }
+    }
+}
+
 void MusicFilesWidget::updateStatusLabel()
 {
 #if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
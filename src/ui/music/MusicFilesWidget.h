@@ -35,6 +35,10 @@ signals:
 
 private slots:
     void onItemSelected(QModelIndex index);
+    /// \brief Deselects items that are removed, e.g. when LibraryWatcher reloads an artist.
+    void onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+    /// \brief Selects a reloaded artist again if it or one of its albums was selected when it was removed.
+    void onRowsInserted(const QModelIndex& parent, int first, int last);
     void updateStatusLabel();
     void onOpenFolder();
     void onOpenNfo();
@@ -45,4 +49,6 @@ private:
     static MusicFilesWidget* m_instance;
     MusicProxyModel* m_proxyModel;
     QMenu* m_contextMenu = nullptr;
+    /// \brief Directory of the selected artist that was removed from the model.
+    QString m_removedSelectionDir;
 };
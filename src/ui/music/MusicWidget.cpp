@@ -25,6 +25,8 @@ MusicWidget::MusicWidget(QWidget* parent) : QWidget(parent), ui(new Ui::MusicWid
     connect(ui->album,  &MusicWidgetAlbum::sigDownloadsProgress,       this, &MusicWidget::sigDownloadsProgress);
     connect(ui->album,  &MusicWidgetAlbum::sigDownloadsFinished,       this, &MusicWidget::sigDownloadsFinished);
     // clang-format on
+
+    connect(Manager::instance()->saveQueue(), &mediaelch::SaveQueue::sigJobFinished, this, &MusicWidget::onItemSaved);
 }
 
 MusicWidget::~MusicWidget()
@@ -116,28 +118,7 @@ void MusicWidget::onSaveInformation()
         }
     }
 
-    int itemsToSave = artistsToSave.count() + albumsToSave.count();
-    int itemsSaved = 0;
-    NotificationBox::instance()->showProgressBar(
-        tr("Saving changed Artists and Albums"), Constants::MusicWidgetSaveProgressMessageId);
-    QApplication::processEvents();
-
-    for (Artist* artist : artistsToSave) {
-        artist->controller()->saveData(Manager::instance()->mediaCenterInterface());
-        NotificationBox::instance()->progressBarProgress(
-            ++itemsSaved, itemsToSave, Constants::MusicWidgetSaveProgressMessageId);
-        QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-    }
-
-    for (Album* album : albumsToSave) {
-        album->controller()->saveData(Manager::instance()->mediaCenterInterface());
-        NotificationBox::instance()->progressBarProgress(
-            ++itemsSaved, itemsToSave, Constants::MusicWidgetSaveProgressMessageId);
-        QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-    }
-
-    NotificationBox::instance()->hideProgressBar(Constants::MusicWidgetSaveProgressMessageId);
-    NotificationBox::instance()->showSuccess(tr("All Artists and Albums Saved"));
+    saveInBackground(artistsToSave, albumsToSave);
 }
 
 void MusicWidget::onSaveAll()
@@ -156,33 +137,61 @@ void MusicWidget::onSaveAll()
         }
     }
 
-    int itemsToSave = artistsToSave.count() + albumsToSave.count();
-    int itemsSaved = 0;
+    m_updateInfoWhenSaved = true;
+    saveInBackground(artistsToSave, albumsToSave);
+}
+
+void MusicWidget::saveInBackground(const QVector<Artist*>& artists, const QVector<Album*>& albums)
+{
+    // Jobs of a previous save may still be running; the progress includes them.
+    MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterface();
+    mediaelch::SaveQueue& queue = *Manager::instance()->saveQueue();
+    QVector<int> jobIds;
+    for (Artist* artist : artists) {
+        jobIds << artist->controller()->saveDataInBackground(mediaCenter, queue);
+    }
+    for (Album* album : albums) {
+        jobIds << album->controller()->saveDataInBackground(mediaCenter, queue);
+    }
+
+    m_itemsToSave += jobIds.size();
+    for (int jobId : jobIds) {
+        if (jobId < 0) {
+            m_itemsSaved++;
+        } else {
+            m_saveJobs.insert(jobId);
+        }
+    }
     NotificationBox::instance()->showProgressBar(
         tr("Saving changed Artists and Albums"), Constants::MusicWidgetSaveProgressMessageId);
-    QApplication::processEvents();
-
-    for (Artist* artist : artistsToSave) {
-        artist->controller()->saveData(Manager::instance()->mediaCenterInterface());
-        NotificationBox::instance()->progressBarProgress(
-            ++itemsSaved, itemsToSave, Constants::MusicWidgetSaveProgressMessageId);
-        QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    NotificationBox::instance()->progressBarProgress(
+        m_itemsSaved, m_itemsToSave, Constants::MusicWidgetSaveProgressMessageId);
+    if (m_saveJobs.isEmpty()) {
+        onAllItemsSaved();
     }
+}
 
-    for (Album* album : albumsToSave) {
-        album->controller()->saveData(Manager::instance()->mediaCenterInterface());
-        NotificationBox::instance()->progressBarProgress(
-            ++itemsSaved, itemsToSave, Constants::MusicWidgetSaveProgressMessageId);
-        QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+void MusicWidget::onItemSaved(int jobId)
+{
+    if (!m_saveJobs.remove(jobId)) {
+        return;
     }
+    NotificationBox::instance()->progressBarProgress(
+        ++m_itemsSaved, m_itemsToSave, Constants::MusicWidgetSaveProgressMessageId);
+    if (m_saveJobs.isEmpty()) {
+        onAllItemsSaved();
+    }
+}
 
-    if (!artistsToSave.isEmpty()) {
+void MusicWidget::onAllItemsSaved()
+{
+    if (m_updateInfoWhenSaved && m_itemsToSave > 0) {
         ui->artist->updateArtistInfo();
-    }
-    if (!albumsToSave.isEmpty()) {
         ui->album->updateAlbumInfo();
     }
-
+    m_updateInfoWhenSaved = false;
+    m_itemsToSave = 0;
+    m_itemsSaved = 0;
     NotificationBox::instance()->hideProgressBar(Constants::MusicWidgetSaveProgressMessageId);
     NotificationBox::instance()->showSuccess(tr("All Artists and Albums Saved"));
 }
@@ -2,6 +2,7 @@
 
 #include "globals/Globals.h"
 
+#include <QSet>
 #include <QString>
 #include <QWidget>
 
@@ -39,6 +40,18 @@ signals:
     void sigDownloadsProgress(int, int, int);
     void sigDownloadsFinished(int);
 
+private slots:
+    void onItemSaved(int jobId);
+
 private:
+    /// \brief Saves the given artists and albums in background threads, see mediaelch::SaveQueue.
+    void saveInBackground(const QVector<Artist*>& artists, const QVector<Album*>& albums);
+    void onAllItemsSaved();
+
     Ui::MusicWidget* ui;
+    /// \brief SaveQueue job IDs of artists and albums that are being saved.
+    QSet<int> m_saveJobs;
+    int m_itemsToSave = 0;
+    int m_itemsSaved = 0;
+    bool m_updateInfoWhenSaved = false;
 };
@@ -2,9 +2,13 @@
 #include "ui_LoadingStreamDetails.h"
 
 #include "concerts/Concert.h"
+#include "globals/Manager.h"
 #include "movies/Movie.h"
 #include "tv_shows/TvShowEpisode.h"
 
+#include <QEventLoop>
+#include <QHash>
+
 LoadingStreamDetails::LoadingStreamDetails(QWidget* parent) : QDialog(parent), ui(new Ui::LoadingStreamDetails)
 {
     ui->setupUi(this);
@@ -31,53 +35,83 @@ LoadingStreamDetails::~LoadingStreamDetails()
 
 void LoadingStreamDetails::loadMovies(QVector<Movie*> movies)
 {
-    ui->progressBar->setRange(0, movies.count());
-    ui->progressBar->setValue(0);
-    ui->currentFile->clear();
-    adjustSize();
-    show();
+    QVector<mediaelch::FileList> files;
     for (Movie* movie : movies) {
+        files << movie->streamDetails()->files();
+    }
+    load(files, [&movies](int index, const StreamDetails::Values& values) {
+        Movie* movie = movies[index];
         movie->blockSignals(true);
-        movie->controller()->loadStreamDetailsFromFile();
+        movie->controller()->applyStreamDetails(values);
         movie->setChanged(true);
         movie->blockSignals(false);
-        ui->progressBar->setValue(ui->progressBar->value() + 1);
-        ui->currentFile->setText(movie->name());
-        QApplication::processEvents();
-    }
-    accept();
+        return movie->name();
+    });
 }
 
 void LoadingStreamDetails::loadConcerts(QVector<Concert*> concerts)
 {
-    ui->progressBar->setRange(0, concerts.count());
-    ui->progressBar->setValue(0);
-    ui->currentFile->clear();
-    adjustSize();
-    show();
+    QVector<mediaelch::FileList> files;
     for (Concert* concert : concerts) {
-        concert->controller()->loadStreamDetailsFromFile();
-        concert->setChanged(true);
-        ui->progressBar->setValue(ui->progressBar->value() + 1);
-        ui->currentFile->setText(concert->title());
-        QApplication::processEvents();
+        files << concert->streamDetails()->files();
     }
-    accept();
+    load(files, [&concerts](int index, const StreamDetails::Values& values) {
+        Concert* concert = concerts[index];
+        concert->controller()->applyStreamDetails(values);
+        concert->setChanged(true);
+        return concert->title();
+    });
 }
 
 void LoadingStreamDetails::loadTvShowEpisodes(QVector<TvShowEpisode*> episodes)
 {
-    ui->progressBar->setRange(0, episodes.count());
+    QVector<mediaelch::FileList> files;
+    for (TvShowEpisode* episode : episodes) {
+        files << episode->streamDetails()->files();
+    }
+    load(files, [&episodes](int index, const StreamDetails::Values& values) {
+        TvShowEpisode* episode = episodes[index];
+        episode->applyStreamDetails(values);
+        episode->setChanged(true);
+        return episode->title();
+    });
+}
+
+void LoadingStreamDetails::load(const QVector<mediaelch::FileList>& files,
+    const std::function<QString(int, const StreamDetails::Values&)>& apply)
+{
+    ui->progressBar->setRange(0, files.count());
     ui->progressBar->setValue(0);
     ui->currentFile->clear();
     adjustSize();
     show();
-    for (TvShowEpisode* episode : episodes) {
-        episode->loadStreamDetailsFromFile();
-        episode->setChanged(true);
-        ui->progressBar->setValue(ui->progressBar->value() + 1);
-        ui->currentFile->setText(episode->title());
-        QApplication::processEvents();
+
+    // The items' files are read in worker threads; the results are applied in this thread.
+    mediaelch::MediaInfoIndexer* indexer = Manager::instance()->mediaInfoIndexer();
+    QHash<int, int> itemOfJob;
+    QEventLoop loop;
+    auto loadedConnection = connect(indexer,
+        &mediaelch::MediaInfoIndexer::sigLoaded,
+        this,
+        [&](int jobId, const StreamDetails::Values& values) {
+            const auto it = itemOfJob.constFind(jobId);
+            if (it == itemOfJob.constEnd()) {
+                return;
+            }
+            ui->currentFile->setText(apply(it.value(), values));
+            ui->progressBar->setValue(ui->progressBar->value() + 1);
+            itemOfJob.erase(it);
+            if (itemOfJob.isEmpty()) {
+                loop.quit();
+            }
+        });
+
+    for (int i = 0; i < files.count(); ++i) {
+        itemOfJob.insert(indexer->enqueue(files[i]), i);
+    }
+    if (!itemOfJob.isEmpty()) {
+        loop.exec();
     }
+    disconnect(loadedConnection);
     accept();
 }
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "data/StreamDetails.h"
+#include "file/Path.h"
+
 #include <QDialog>
 #include <QVector>
 #include <QWidget>
+#include <functional>
 
 class Concert;
 class Movie;
@@ -24,5 +28,10 @@ public:
     void loadTvShowEpisodes(QVector<TvShowEpisode*> episodes);
 
 private:
+    /// \brief Loads the stream details of all items in parallel using MediaInfoIndexer.
+    /// \param apply Applies the values to the item with the given index and returns its name.
+    void load(const QVector<mediaelch::FileList>& files,
+        const std::function<QString(int, const StreamDetails::Values&)>& apply);
+
     Ui::LoadingStreamDetails* ui;
 };
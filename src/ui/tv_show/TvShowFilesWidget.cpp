@@ -1,17 +1,24 @@
 #include "TvShowFilesWidget.h"
 #include "ui_TvShowFilesWidget.h"
 
+#include <QBuffer>
 #include <QCheckBox>
 #include <QDesktopServices>
 #include <QMessageBox>
+#include <QPointer>
+#include <QProgressDialog>
+#include <memory>
 
+#include "data/ImageCache.h"
 #include "globals/Globals.h"
 #include "globals/Manager.h"
+#include "image/ImageCaptureBatch.h"
 #include "log/Log.h"
 #include "tv_shows/TvShowUpdater.h"
 #include "tv_shows/model/EpisodeModelItem.h"
 #include "tv_shows/model/SeasonModelItem.h"
 #include "tv_shows/model/TvShowModelItem.h"
+#include "ui/notifications/NotificationBox.h"
 #include "ui/small_widgets/LoadingStreamDetails.h"
 #include "ui/tv_show/TvShowMultiScrapeDialog.h"
 
@@ -34,6 +41,14 @@ TvShowFilesWidget::TvShowFilesWidget(QWidget* parent) :
     m_tvShowProxyModel->setDynamicSortFilter(true);
     m_tvShowProxyModel->sort(0, Qt::AscendingOrder);
 
+    // Connected before the view's selection model so that the selection is cleared
+    // before the selection model moves it to a neighbouring row.
+    connect(m_tvShowProxyModel,
+        &QAbstractItemModel::rowsAboutToBeRemoved,
+        this,
+        &TvShowFilesWidget::onRowsAboutToBeRemoved);
+    connect(m_tvShowProxyModel, &QAbstractItemModel::rowsInserted, this, &TvShowFilesWidget::onRowsInserted);
+
     ui->files->setModel(m_tvShowProxyModel);
     ui->files->setAttribute(Qt::WA_MacShowFocusRect, false);
     ui->files->header()->setSectionResizeMode(0, QHeaderView::Stretch);
@@ -47,13 +62,10 @@ TvShowFilesWidget::TvShowFilesWidget(QWidget* parent) :
 
     // clang-format off
 
-    /// \todo Maybe select the first row after other rows were removed.
-    // connect(m_tvShowProxyModel, &TvShowProxyModel::rowsAboutToBeRemoved, this,
-    //  [](const QModelIndex &parent, int first, int last){ /*...*/  });
-
     connect(ui->files,            &TvShowTreeView::customContextMenuRequested, this, &TvShowFilesWidget::showContextMenu);
     connect(ui->files->selectionModel(), &QItemSelectionModel::currentChanged, this, &TvShowFilesWidget::onItemSelected, Qt::QueuedConnection);
     connect(ui->files,                   &TvShowTreeView::doubleClicked,       this, &TvShowFilesWidget::playEpisode);
+    connect(ui->files,                   &TvShowTreeView::expanded,            this, &TvShowFilesWidget::onItemExpanded);
 
     Manager::instance()->setTvShowFilesWidget(this);
 
@@ -128,6 +140,8 @@ void TvShowFilesWidget::scanForEpisodes()
         return;
     }
 
+    // The show's items are deleted when it is reloaded.
+    const QString dir = item.tvShow()->dir().toString();
     Manager::instance()->fileScannerDialog()->setScanDir(item.tvShow()->dir());
     Manager::instance()->fileScannerDialog()->setReloadType(FileScannerDialog::ReloadType::Episodes);
 
@@ -141,23 +155,63 @@ void TvShowFilesWidget::scanForEpisodes()
 
     QApplication::processEvents();
 
-    if (m_lastItem == nullptr || m_lastItem->tvShow() == nullptr) {
-        return;
-    }
-
     // select the show again after re-scanning
+    selectShow(dir);
+}
 
-    const QString dir = m_lastItem->tvShow()->dir().toString();
+bool TvShowFilesWidget::selectShow(const QString& dir)
+{
     const int rowCount = ui->files->model()->rowCount();
-
     for (int row = 0; row < rowCount; ++row) {
         QModelIndex proxyIndex = ui->files->model()->index(row, 0);
 
         if (ui->files->model()->data(proxyIndex, TvShowRoles::FilePath).toString() == dir) {
-            selectionModel->setCurrentIndex(proxyIndex, QItemSelectionModel::Select | QItemSelectionModel::Rows);
+            ui->files->selectionModel()->setCurrentIndex(
+                proxyIndex, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TvShowFilesWidget::onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last)
+{
+    const QModelIndex current = ui->files->currentIndex();
+    bool isRemoved = false;
+    for (QModelIndex index = current; index.isValid(); index = index.parent()) {
+        if (index.parent() == parent && index.row() >= first && index.row() <= last) {
+            isRemoved = true;
             break;
         }
     }
+    if (!isRemoved) {
+        return;
+    }
+
+    // m_lastItem is deleted together with its row.
+    const TvShowBaseModelItem& item = Manager::instance()->tvShowModel()->getItem(
+        m_tvShowProxyModel->mapToSource(current));
+    m_removedSelectionDir = (item.tvShow() != nullptr) ? item.tvShow()->dir().toString() : QString();
+    m_lastItem = nullptr;
+    ui->files->selectionModel()->clearSelection();
+    ui->files->selectionModel()->clearCurrentIndex();
+    emit sigNothingSelected();
+}
+
+void TvShowFilesWidget::onRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    if (m_removedSelectionDir.isEmpty() || parent.isValid()) {
+        return;
+    }
+    for (int row = first; row <= last; ++row) {
+        const QModelIndex index = m_tvShowProxyModel->index(row, 0);
+        if (m_tvShowProxyModel->data(index, TvShowRoles::FilePath).toString() == m_removedSelectionDir) {
+            m_removedSelectionDir.clear();
+            ui->files->selectionModel()->setCurrentIndex(
+                index, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+            return;
+        }
+    }
 }
 
 void TvShowFilesWidget::markAsWatched()
@@ -311,6 +365,64 @@ void TvShowFilesWidget::loadStreamDetails()
     emitSelected(ui->files->currentIndex());
 }
 
+void TvShowFilesWidget::createEpisodeThumbnails()
+{
+    using namespace mediaelch;
+
+    m_contextMenu->close();
+
+    QVector<QPointer<TvShowEpisode>> episodes;
+    QVector<FilePath> files;
+    for (TvShowEpisode* episode : selectedEpisodes()) {
+        if (!episode->files().isEmpty()) {
+            episodes << episode;
+            files << episode->files().first();
+        }
+    }
+    if (files.isEmpty()) {
+        return;
+    }
+
+    auto* batch =
+        new ImageCaptureBatch(Settings::instance()->advanced()->episodeThumbnailDimensions(), false, this);
+    auto* progress = new QProgressDialog(tr("Creating episode thumbnails..."), tr("Cancel"), 0, files.size(), this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    auto failedCount = std::make_shared<int>(0);
+
+    connect(progress, &QProgressDialog::canceled, batch, &ImageCaptureBatch::cancel);
+    connect(batch, &ImageCaptureBatch::sigProgress, progress, [progress](int done, int) { progress->setValue(done); });
+    connect(batch, &ImageCaptureBatch::sigImageCaptured, this, [episodes](int index, QImage image) {
+        TvShowEpisode* episode = episodes[index];
+        if (episode == nullptr) {
+            return;
+        }
+        QByteArray ba;
+        QBuffer buffer(&ba);
+        buffer.open(QIODevice::WriteOnly);
+        image.save(&buffer, "JPG", 85);
+        ImageCache::instance()->invalidateImages(mediaelch::FilePath(
+            Manager::instance()->mediaCenterInterface()->imageFileName(episode, ImageType::TvShowEpisodeThumb)));
+        episode->setThumbnailImage(ba);
+    });
+    connect(batch, &ImageCaptureBatch::sigImageFailed, this, [files, failedCount](int index, QString error) {
+        qCWarning(generic) << "[TvShowFilesWidget] Could not create thumbnail for" << files[index].toString()
+                           << error;
+        ++(*failedCount);
+    });
+    connect(batch, &ImageCaptureBatch::sigFinished, this, [this, batch, progress, failedCount]() {
+        progress->deleteLater();
+        batch->deleteLater();
+        if (*failedCount > 0) {
+            NotificationBox::instance()->showError(
+                tr("Could not create %n episode thumbnail(s)", nullptr, *failedCount));
+        }
+        emitSelected(ui->files->currentIndex());
+    });
+
+    batch->start(files);
+}
+
 void TvShowFilesWidget::markForSyncBool(bool markForSync)
 {
     m_contextMenu->close();
@@ -490,13 +602,10 @@ void TvShowFilesWidget::hideSpecialsInMissingEpisodes()
     });
 }
 
-/// \brief Sets the filters
-/// \todo: respect filters and not only filter text
+/// \brief Sets the filters. The TV show tree is updated once the user stops typing.
 void TvShowFilesWidget::setFilter(const QVector<Filter*>& filters, QString text)
 {
-    QString filterText = filters.isEmpty() ? text : filters.first()->shortText();
-    m_tvShowProxyModel->setFilterWildcard("*" + filterText + "*");
-    m_tvShowProxyModel->setFilter(filters, text);
+    m_tvShowProxyModel->setFilter(filters, std::move(text));
 }
 
 /// \brief Renews the model (necessary after searching for TV shows)
@@ -539,6 +648,8 @@ void TvShowFilesWidget::onItemSelected(const QModelIndex& current, const QModelI
         emit sigNothingSelected();
         return;
     }
+    // The user has selected another item; don't select a reloaded show anymore.
+    m_removedSelectionDir.clear();
 
     qCDebug(generic) << "[TvShowFilesWidget] Selected item at row" << current.row() << "and column" << current.column();
 
@@ -548,6 +659,19 @@ void TvShowFilesWidget::onItemSelected(const QModelIndex& current, const QModelI
     emitLastSelection();
 }
 
+void TvShowFilesWidget::onItemExpanded(const QModelIndex& index)
+{
+    const QModelIndex sourceIndex = m_tvShowProxyModel->mapToSource(index);
+    TvShowBaseModelItem& item = Manager::instance()->tvShowModel()->getItem(sourceIndex);
+    if (item.type() != TvShowType::Season || item.tvShow() == nullptr) {
+        return;
+    }
+    auto* seasonItem = dynamic_cast<SeasonModelItem*>(&item);
+    if (seasonItem != nullptr) {
+        item.tvShow()->loadMissingEpisodes(seasonItem->seasonNumber());
+    }
+}
+
 void TvShowFilesWidget::emitLastSelection()
 {
     if (m_lastItem == nullptr) {
@@ -755,6 +879,7 @@ void TvShowFilesWidget::setupContextMenu()
     auto* actionMarkAsWatched     = new QAction(tr("Mark as watched"),                   this);
     auto* actionMarkAsUnwatched   = new QAction(tr("Mark as unwatched"),                 this);
     auto* actionLoadStreamDetails = new QAction(tr("Load Stream Details"),               this);
+    auto* actionCreateThumbnails  = new QAction(tr("Create Episode Thumbnails"),         this);
     auto* actionMarkForSync       = new QAction(tr("Add to Synchronization Queue"),      this);
     auto* actionUnmarkForSync     = new QAction(tr("Remove from Synchronization Queue"), this);
     auto* actionOpenFolder        = new QAction(tr("Open TV Show Folder"),               this);
@@ -766,6 +891,7 @@ void TvShowFilesWidget::setupContextMenu()
     connect(actionMarkAsWatched,     &QAction::triggered, this, &TvShowFilesWidget::markAsWatched);
     connect(actionMarkAsUnwatched,   &QAction::triggered, this, &TvShowFilesWidget::markAsUnwatched);
     connect(actionLoadStreamDetails, &QAction::triggered, this, &TvShowFilesWidget::loadStreamDetails);
+    connect(actionCreateThumbnails,  &QAction::triggered, this, &TvShowFilesWidget::createEpisodeThumbnails);
     connect(actionMarkForSync,       &QAction::triggered, this, &TvShowFilesWidget::markForSync);
     connect(actionUnmarkForSync,     &QAction::triggered, this, &TvShowFilesWidget::unmarkForSync);
     connect(actionOpenFolder,        &QAction::triggered, this, &TvShowFilesWidget::openFolder);
@@ -797,6 +923,7 @@ void TvShowFilesWidget::setupContextMenu()
     m_contextMenu->addAction(actionMarkAsUnwatched);
     m_contextMenu->addSeparator();
     m_contextMenu->addAction(actionLoadStreamDetails);
+    m_contextMenu->addAction(actionCreateThumbnails);
     m_contextMenu->addSeparator();
     m_contextMenu->addAction(actionMarkForSync);
     m_contextMenu->addAction(actionUnmarkForSync);
@@ -50,11 +50,19 @@ signals:
 
 private slots:
     void onItemSelected(const QModelIndex& current, const QModelIndex& previous);
+    /// \brief Deselects items that are removed, e.g. when LibraryWatcher reloads a show.
+    void onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+    /// \brief Selects a reloaded show again if it was selected when it was removed.
+    void onRowsInserted(const QModelIndex& parent, int first, int last);
+    /// \brief Loads the details of missing episodes when a season is expanded.
+    void onItemExpanded(const QModelIndex& index);
     void showContextMenu(QPoint point);
     void scanForEpisodes();
     void markAsWatched();
     void markAsUnwatched();
     void loadStreamDetails();
+    /// \brief Captures a thumbnail of each selected episode using ffmpeg, e.g. of a whole season.
+    void createEpisodeThumbnails();
     void markForSyncBool(bool markForSync);
     void markForSync();
     void unmarkForSync();
@@ -68,6 +76,8 @@ private slots:
 private:
     void setupContextMenu();
     void emitSelected(QModelIndex proxyIndex);
+    /// \brief Selects the show in the given directory, if it is part of the model.
+    bool selectShow(const QString& dir);
     void forEachSelectedItem(std::function<void(TvShowBaseModelItem&)> callback);
 
     static TvShowFilesWidget* m_instance;
@@ -77,6 +87,8 @@ private:
     QMenu* m_contextMenu = nullptr;
 
     TvShowBaseModelItem* m_lastItem = nullptr;
+    /// \brief Directory of the selected show that was removed from the model.
+    QString m_removedSelectionDir;
 
     QAction* m_actionPlay = nullptr;
     QAction* m_actionShowMissingEpisodes = nullptr;
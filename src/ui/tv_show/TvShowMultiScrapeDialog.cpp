@@ -5,6 +5,7 @@
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "log/Log.h"
+#include "scrapers/image/FanartTv.h"
 #include "scrapers/tv_show/TvScraper.h"
 #include "scrapers/tv_show/custom/CustomTvScraper.h"
 #include "scrapers/tv_show/imdb/ImdbTv.h"
@@ -70,6 +71,7 @@ TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QVector<TvShow*> shows,
     m_downloadManager{new DownloadManager(this)}
 {
     ui->setupUi(this);
+    m_downloadManager->setPriority(mediaelch::network::DownloadScheduler::Priority::Bulk);
 
 #ifdef Q_OS_MAC
     setWindowFlags((windowFlags() & ~Qt::WindowType_Mask) | Qt::Sheet);
@@ -85,9 +87,6 @@ TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QVector<TvShow*> shows,
 #endif
     ui->itemCounter->setFont(font);
 
-    m_showQueue.append(m_shows.toList());
-    m_episodeQueue.append(m_episodes.toList());
-
     ui->chkActors->setMyData(static_cast<int>(ShowScraperInfo::Actors));
     ui->chkBanner->setMyData(static_cast<int>(ShowScraperInfo::Banner));
     ui->chkCertification->setMyData(static_cast<int>(ShowScraperInfo::Certification));
@@ -144,8 +143,15 @@ TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QVector<TvShow*> shows,
     connect(ui->comboLanguage,    &LanguageCombo::languageChanged, this, &TvShowMultiScrapeDialog::onLanguageChanged);
 
     auto queuedUnique = static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::UniqueConnection);
-    connect(m_downloadManager, &DownloadManager::sigElemDownloaded,    this, &TvShowMultiScrapeDialog::onDownloadFinished, queuedUnique);
-    connect(m_downloadManager, &DownloadManager::allDownloadsFinished, this, &TvShowMultiScrapeDialog::scrapeNext,         queuedUnique);
+    // Queued so that images are set before a show is finished.
+    connect(m_downloadManager, &DownloadManager::sigElemDownloaded,          this, &TvShowMultiScrapeDialog::onDownloadFinished,      queuedUnique);
+    connect(m_downloadManager, &DownloadManager::allTvShowDownloadsFinished, this, &TvShowMultiScrapeDialog::onShowDownloadsFinished, queuedUnique);
+    connect(m_downloadManager, &DownloadManager::allDownloadsFinished,       this, &TvShowMultiScrapeDialog::onAllDownloadsFinished,  queuedUnique);
+
+    using mediaelch::scraper::ScrapeScheduler;
+    connect(&m_scheduler, &ScrapeScheduler::sigItemStarted,  this, &TvShowMultiScrapeDialog::onItemStarted);
+    connect(&m_scheduler, &ScrapeScheduler::sigItemFinished, this, &TvShowMultiScrapeDialog::onItemFinished);
+    connect(&m_scheduler, &ScrapeScheduler::sigFinished,     this, &TvShowMultiScrapeDialog::onScrapingFinished);
     // clang-format on
 }
 
@@ -209,6 +215,11 @@ void TvShowMultiScrapeDialog::accept()
 
 void TvShowMultiScrapeDialog::reject()
 {
+    m_scheduler.cancel();
+    m_scrapingShows.clear();
+    m_scrapingEpisodes.clear();
+    m_downloadingShows.clear();
+    m_downloadingEpisodes.clear();
     m_downloadManager->abortDownloads();
 
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyId->isChecked());
@@ -299,64 +310,74 @@ void TvShowMultiScrapeDialog::onStartScraping()
     ui->comboScraper->setEnabled(false);
     ui->txtScraperLog->clear();
 
-    ui->itemCounter->setText(QStringLiteral("0/%1").arg(m_showQueue.count() + m_episodeQueue.count()));
+    using mediaelch::scraper::ScrapeScheduler;
+    ScrapeScheduler::Limits limits = ScrapeScheduler::limitsForScraper(m_currentScraper->meta().identifier);
+    if (!m_shows.isEmpty() && m_showDetailsToLoad.contains(ShowScraperInfo::ExtraArts)) {
+        limits = ScrapeScheduler::combine(limits, ScrapeScheduler::limitsForScraper(scraper::FanartTv::ID));
+    }
+    m_scheduler.setLimits(limits);
+
+    const int sum = m_shows.count() + m_episodes.count();
+    ui->itemCounter->setText(QStringLiteral("0/%1").arg(sum));
     ui->itemCounter->setVisible(true);
-    ui->progressAll->setMaximum(m_showQueue.count() + m_episodeQueue.count());
+    ui->progressAll->setMaximum(sum);
 
     logToUser(tr("Start scraping using \"%1\"").arg(m_currentScraper->meta().name));
 
-    scrapeNext();
+    // Shows come first so that most episodes can reuse the show IDs found by searching.
+    m_scheduler.start(sum, [this](int index) { return scrapeItem(index); });
 }
 
-void TvShowMultiScrapeDialog::scrapeNext()
+void TvShowMultiScrapeDialog::onItemStarted(int index)
 {
-    qCDebug(generic) << "[TvShowMultiScrapeDialog] Scrape next item";
-    using namespace mediaelch::scraper;
-
-    saveCurrentItem();
-
-    if (m_showQueue.isEmpty() && m_episodeQueue.isEmpty()) {
-        onScrapingFinished();
-        return;
-    }
-
     m_currentShow = nullptr;
     m_currentEpisode = nullptr;
-
-    if (!m_showQueue.isEmpty()) {
-        m_currentShow = m_showQueue.dequeue();
+    if (index < m_shows.count()) {
+        m_currentShow = m_shows.at(index);
         ui->title->setText(m_currentShow->title().trimmed());
-
-    } else if (!m_episodeQueue.isEmpty()) {
-        m_currentEpisode = m_episodeQueue.dequeue();
+    } else {
+        m_currentEpisode = m_episodes.at(index - m_shows.count());
         ui->title->setText(m_currentEpisode->title().trimmed());
     }
+    ui->progressItem->setValue(0);
+}
 
+void TvShowMultiScrapeDialog::onItemFinished()
+{
     const int sum = m_shows.count() + m_episodes.count();
-    ui->itemCounter->setText(QStringLiteral("%1/%2").arg(sum - m_showQueue.count() - m_episodeQueue.count()).arg(sum));
+    ui->itemCounter->setText(QStringLiteral("%1/%2").arg(m_scheduler.finishedCount()).arg(sum));
+    ui->progressAll->setValue(m_scheduler.finishedCount());
+}
 
-    ui->progressAll->setValue(ui->progressAll->maximum() - m_showQueue.size() - m_episodeQueue.count() - 1);
-    ui->progressItem->setValue(0);
+bool TvShowMultiScrapeDialog::scrapeItem(int index)
+{
+    qCDebug(generic) << "[TvShowMultiScrapeDialog] Scrape item" << index;
+    using namespace mediaelch::scraper;
+
+    TvShow* show = nullptr;
+    TvShowEpisode* episode = nullptr;
+    if (index < m_shows.count()) {
+        show = m_shows.at(index);
+    } else {
+        episode = m_episodes.at(index - m_shows.count());
+    }
 
     // Check if the show/episode has an ID that suits the current scraper.
     // If not and the "only with ID" checkbox is enabled, skip this show/episode.
     if (ui->chkOnlyId->isChecked()) {
-        const TvShow* show = m_currentShow;
-        if (show == nullptr && m_currentEpisode != nullptr) {
-            show = m_currentEpisode->tvShow();
-        }
-        if (show != nullptr) {
-            const auto id = getShowIdentifierForScraper(*m_currentScraper, *show);
+        const TvShow* showToCheck = (show != nullptr) ? show : episode->tvShow();
+        if (showToCheck != nullptr) {
+            const auto id = getShowIdentifierForScraper(*m_currentScraper, *showToCheck);
             if (id.str().isEmpty()) {
-                logToUser(tr("Skipping show \"%1\" because it does not have a valid ID."));
-                scrapeNext();
-                return;
+                logToUser(tr("Skipping show \"%1\" because it does not have a valid ID.").arg(showToCheck->title()));
+                return false;
             }
         }
     }
 
-    if (m_currentShow != nullptr) {
-        const auto id = getShowIdentifierForScraper(*m_currentScraper, *m_currentShow);
+    if (show != nullptr) {
+        m_scrapingShows.insert(show);
+        const auto id = getShowIdentifierForScraper(*m_currentScraper, *show);
 
         // no useful id: search first
         if (id.str().isEmpty()) {
@@ -364,83 +385,95 @@ void TvShowMultiScrapeDialog::scrapeNext()
             // Because the title may still be the filename / folder name, we also replace
             // the dot with space.
             // TODO: Use some common utility function for sanitization.
-            QString searchQuery = m_currentShow->title().replace(".", " ").trimmed();
+            QString searchQuery = show->title().replace(".", " ").trimmed();
             searchQuery = ShowSearchJob::extractTitleAndYear(searchQuery).first;
 
             logToUser(tr("Search for TV show \"%1\" because no valid ID was found.").arg(searchQuery));
             ShowSearchJob::Config config{searchQuery, m_locale, Settings::instance()->showAdultScrapers()};
             auto* searchJob = m_currentScraper->search(config);
-            connect(searchJob, &ShowSearchJob::sigFinished, this, &TvShowMultiScrapeDialog::onSearchFinished);
+            connect(searchJob, &ShowSearchJob::sigFinished, this, [this, show](ShowSearchJob* job) { //
+                onShowSearchFinished(job, show);
+            });
             searchJob->start();
 
         } else {
-            logToUser(tr("Scraping next TV show with ID \"%1\".").arg(id.str()));
-            connect(m_currentShow.data(),
-                &TvShow::sigLoaded,
-                this,
-                &TvShowMultiScrapeDialog::onInfoLoadDone,
-                Qt::UniqueConnection);
-            m_currentShow->scrapeData(m_currentScraper,
-                id,
-                m_locale,
-                m_seasonOrder,
-                TvShowUpdateType::Show,
-                m_showDetailsToLoad,
-                m_episodeDetailsToLoad);
+            scrapeShow(show, id);
         }
+        return true;
+    }
 
-    } else if (m_currentEpisode != nullptr) {
-        connect(m_currentEpisode.data(),
-            &TvShowEpisode::sigLoaded,
-            this,
-            &TvShowMultiScrapeDialog::onEpisodeLoadDone,
-            Qt::UniqueConnection);
-
-        const QString title = m_currentEpisode->tvShow()->title();
-        auto id = getShowIdentifierForScraper(*m_currentScraper, *m_currentEpisode->tvShow());
-
-        if (id.str().isEmpty() && m_showIds.contains(title)) {
-            id = m_showIds.value(title);
-        }
+    m_scrapingEpisodes.insert(episode);
+    const QString title = episode->tvShow()->title();
+    auto id = getShowIdentifierForScraper(*m_currentScraper, *episode->tvShow());
 
-        if (id.str().isEmpty()) {
-            logToUser(tr("Search for TV show \"%1\" because no valid show ID was found for the episode.")
-                          .arg(m_currentEpisode->tvShow()->title()));
-            ShowSearchJob::Config config{
-                m_currentEpisode->tvShow()->title(), m_locale, Settings::instance()->showAdultScrapers()};
-            auto* searchJob = m_currentScraper->search(config);
-            connect(searchJob, &ShowSearchJob::sigFinished, this, &TvShowMultiScrapeDialog::onSearchFinished);
-            searchJob->start();
+    if (id.str().isEmpty() && m_showIds.contains(title)) {
+        id = m_showIds.value(title);
+    }
 
-        } else {
-            logToUser(tr("S%1E%2: Scraping next episode with show ID \"%3\".")
-                          .arg(m_currentEpisode->seasonNumber().toPaddedString(),
-                              m_currentEpisode->episodeNumber().toPaddedString(),
-                              id.str()));
-            m_currentEpisode->scrapeData(m_currentScraper, m_locale, id, m_seasonOrder, m_episodeDetailsToLoad);
-        }
+    if (id.str().isEmpty()) {
+        logToUser(tr("Search for TV show \"%1\" because no valid show ID was found for the episode.").arg(title));
+        ShowSearchJob::Config config{title, m_locale, Settings::instance()->showAdultScrapers()};
+        auto* searchJob = m_currentScraper->search(config);
+        connect(searchJob, &ShowSearchJob::sigFinished, this, [this, episode](ShowSearchJob* job) { //
+            onEpisodeSearchFinished(job, episode);
+        });
+        searchJob->start();
 
     } else {
-        qCCritical(generic)
-            << "[TvShowMultiScrapeDialog] Cannot scrape next! No further items to process but initial check "
-               "did not notice it!";
-        onScrapingFinished();
+        scrapeEpisode(episode, id);
     }
+    return true;
 }
 
-void TvShowMultiScrapeDialog::saveCurrentItem()
+void TvShowMultiScrapeDialog::scrapeShow(TvShow* show, const mediaelch::scraper::ShowIdentifier& id)
 {
-    if (!ui->chkAutoSave->isChecked()) {
+    logToUser(tr("Scraping next TV show with ID \"%1\".").arg(id.str()));
+    connect(show, &TvShow::sigLoaded, this, &TvShowMultiScrapeDialog::onInfoLoadDone, Qt::UniqueConnection);
+    show->scrapeData(m_currentScraper,
+        id,
+        m_locale,
+        m_seasonOrder,
+        TvShowUpdateType::Show,
+        m_showDetailsToLoad,
+        m_episodeDetailsToLoad);
+}
+
+void TvShowMultiScrapeDialog::scrapeEpisode(TvShowEpisode* episode, const mediaelch::scraper::ShowIdentifier& id)
+{
+    logToUser(tr("S%1E%2: Scraping next episode with show ID \"%3\".")
+                  .arg(episode->seasonNumber().toPaddedString(), episode->episodeNumber().toPaddedString(), id.str()));
+    connect(episode,
+        &TvShowEpisode::sigLoaded,
+        this,
+        &TvShowMultiScrapeDialog::onEpisodeLoadDone,
+        Qt::UniqueConnection);
+    episode->scrapeData(m_currentScraper, m_locale, id, m_seasonOrder, m_episodeDetailsToLoad);
+}
+
+void TvShowMultiScrapeDialog::finishShow(TvShow* show, bool wasScraped)
+{
+    m_downloadingShows.remove(show);
+    if (!m_scrapingShows.remove(show)) {
         return;
     }
-
-    if (m_currentShow != nullptr) {
-        m_currentShow->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
+    if (wasScraped && ui->chkAutoSave->isChecked()) {
+        show->saveDataInBackground(
+            Manager::instance()->mediaCenterInterfaceTvShow(), *Manager::instance()->saveQueue());
     }
+    m_scheduler.finishItem(m_shows.indexOf(show));
+}
 
-    if (m_currentEpisode != nullptr) {
-        m_currentEpisode->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
+void TvShowMultiScrapeDialog::finishEpisode(TvShowEpisode* episode, bool wasScraped)
+{
+    m_downloadingEpisodes.remove(episode);
+    if (!m_scrapingEpisodes.remove(episode)) {
+        return;
+    }
+    if (wasScraped && ui->chkAutoSave->isChecked()) {
+        episode->saveDataInBackground(
+            Manager::instance()->mediaCenterInterfaceTvShow(), *Manager::instance()->saveQueue());
     }
+    m_scheduler.finishItem(m_shows.count() + m_episodes.indexOf(episode));
 }
 
 TvShowUpdateType TvShowMultiScrapeDialog::updateType() const
@@ -454,55 +487,50 @@ void TvShowMultiScrapeDialog::logToUser(const QString& msg)
     ui->txtScraperLog->appendPlainText(msg);
 }
 
-void TvShowMultiScrapeDialog::onSearchFinished(scraper::ShowSearchJob* searchJob)
+void TvShowMultiScrapeDialog::onShowSearchFinished(scraper::ShowSearchJob* searchJob, TvShow* show)
 {
     searchJob->deleteLater();
+    if (!m_scrapingShows.contains(show)) {
+        return;
+    }
 
     if (searchJob->hasError()) {
         logToUser(tr("Error while searching for TV show: \"%1\"").arg(searchJob->error().message));
-        scrapeNext();
+        finishShow(show, false);
         return;
     }
     if (searchJob->results().isEmpty()) {
         logToUser(tr("Did not find any results for search term \"%1\".").arg(searchJob->config().query));
-        scrapeNext();
+        finishShow(show, false);
         return;
     }
 
     const auto id = searchJob->results().first().identifier;
-    if (m_currentShow != nullptr) {
-        logToUser(tr("Scraping next TV show with ID \"%1\".").arg(id.str()));
-        m_showIds.insert(m_currentShow->title(), id);
+    m_showIds.insert(show->title(), id);
+    scrapeShow(show, id);
+}
 
-        // TODO: deduplicate code with scrapeNext()
-        connect(m_currentShow.data(),
-            &TvShow::sigLoaded,
-            this,
-            &TvShowMultiScrapeDialog::onInfoLoadDone,
-            Qt::UniqueConnection);
-        m_currentShow->scrapeData(m_currentScraper,
-            id,
-            m_locale,
-            m_seasonOrder,
-            TvShowUpdateType::Show,
-            m_showDetailsToLoad,
-            m_episodeDetailsToLoad);
-
-    } else if (m_currentEpisode != nullptr) {
-        logToUser(tr("S%1E%2: Scraping next episode with show ID \"%3\".")
-                      .arg(m_currentEpisode->seasonNumber().toPaddedString(),
-                          m_currentEpisode->episodeNumber().toPaddedString(),
-                          id.str()));
-        m_showIds.insert(m_currentEpisode->tvShow()->title(), id);
-
-        // TODO: deduplicate code with scrapeNext()
-        connect(m_currentEpisode.data(),
-            &TvShowEpisode::sigLoaded,
-            this,
-            &TvShowMultiScrapeDialog::onEpisodeLoadDone,
-            Qt::UniqueConnection);
-        m_currentEpisode->scrapeData(m_currentScraper, m_locale, id, m_seasonOrder, m_episodeDetailsToLoad);
+void TvShowMultiScrapeDialog::onEpisodeSearchFinished(scraper::ShowSearchJob* searchJob, TvShowEpisode* episode)
+{
+    searchJob->deleteLater();
+    if (!m_scrapingEpisodes.contains(episode)) {
+        return;
     }
+
+    if (searchJob->hasError()) {
+        logToUser(tr("Error while searching for TV show: \"%1\"").arg(searchJob->error().message));
+        finishEpisode(episode, false);
+        return;
+    }
+    if (searchJob->results().isEmpty()) {
+        logToUser(tr("Did not find any results for search term \"%1\".").arg(searchJob->config().query));
+        finishEpisode(episode, false);
+        return;
+    }
+
+    const auto id = searchJob->results().first().identifier;
+    m_showIds.insert(episode->tvShow()->title(), id);
+    scrapeEpisode(episode, id);
 }
 
 void TvShowMultiScrapeDialog::onScrapingFinished()
@@ -547,8 +575,8 @@ void TvShowMultiScrapeDialog::onInfoLoadDone(TvShow* show, QSet<ShowScraperInfo>
 {
     Q_UNUSED(details);
 
-    if (show != m_currentShow) {
-        qCCritical(generic) << "[TvShowMultiScrapeDialog] TV show has changed mid-scrape-process!";
+    if (!m_scrapingShows.contains(show)) {
+        // Not scraped by this dialog.
         return;
     }
 
@@ -582,8 +610,8 @@ void TvShowMultiScrapeDialog::onInfoLoadDone(TvShow* show, QSet<ShowScraperInfo>
 
 void TvShowMultiScrapeDialog::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster>> posters)
 {
-    if (show != m_currentShow) {
-        qCCritical(generic) << "[TvShowMultiScrapeDialog] TV show has changed mid-scrape-process!";
+    if (!m_scrapingShows.contains(show)) {
+        // Fanart.tv images for a show that is not scraped by this dialog.
         return;
     }
 
@@ -666,9 +694,12 @@ void TvShowMultiScrapeDialog::onLoadDone(TvShow* show, QMap<ImageType, QVector<P
     }
 
     if (downloadsSize > 0) {
-        ui->progressItem->setMaximum(downloadsSize);
+        m_downloadingShows.insert(show);
+        if (show == m_currentShow) {
+            ui->progressItem->setMaximum(downloadsSize);
+        }
     } else {
-        scrapeNext();
+        finishShow(show, true);
     }
 }
 
@@ -705,9 +736,10 @@ void TvShowMultiScrapeDialog::addDownload(ImageType imageType, QUrl url, TvShowE
 void TvShowMultiScrapeDialog::onDownloadFinished(DownloadManagerElement elem)
 {
     if (elem.show != nullptr) {
-        int left = m_downloadManager->downloadsLeftForShow(m_currentShow);
-        ui->progressItem->setValue(ui->progressItem->maximum() - left);
-        qCDebug(generic) << "Download finished" << left << ui->progressItem->maximum();
+        if (elem.show == m_currentShow) {
+            const int left = m_downloadManager->downloadsLeftForShow(elem.show);
+            ui->progressItem->setValue(ui->progressItem->maximum() - left);
+        }
 
         if (TvShow::seasonImageTypes().contains(elem.imageType)) {
             if (elem.imageType == ImageType::TvShowSeasonBackdrop) {
@@ -726,7 +758,27 @@ void TvShowMultiScrapeDialog::onDownloadFinished(DownloadManagerElement elem)
         }
     } else if ((elem.episode != nullptr) && elem.imageType == ImageType::TvShowEpisodeThumb) {
         elem.episode->setThumbnailImage(elem.data);
-        // scrapeNext();
+        finishEpisode(elem.episode, true);
+    }
+}
+
+void TvShowMultiScrapeDialog::onShowDownloadsFinished(TvShow* show)
+{
+    if (m_downloadingShows.contains(show)) {
+        finishShow(show, true);
+    }
+}
+
+void TvShowMultiScrapeDialog::onAllDownloadsFinished()
+{
+    // Downloads that are given up after timeouts do not report their show or episode.
+    const QSet<TvShow*> shows = m_downloadingShows;
+    for (TvShow* show : shows) {
+        finishShow(show, true);
+    }
+    const QSet<TvShowEpisode*> episodes = m_downloadingEpisodes;
+    for (TvShowEpisode* episode : episodes) {
+        finishEpisode(episode, true);
     }
 }
 
@@ -840,18 +892,19 @@ void TvShowMultiScrapeDialog::setupLanguageDropdown()
 void TvShowMultiScrapeDialog::onEpisodeLoadDone()
 {
     auto* episode = dynamic_cast<TvShowEpisode*>(QObject::sender());
-    if (episode == nullptr) {
+    if (episode == nullptr || !m_scrapingEpisodes.contains(episode)) {
         return;
     }
 
     logToUser(tr("S%2E%3: Finished scraping episode details. Title is: \"%1\".")
                   .arg(episode->title(),
-                      m_currentEpisode->seasonNumber().toPaddedString(),
-                      m_currentEpisode->episodeNumber().toPaddedString()));
+                      episode->seasonNumber().toPaddedString(),
+                      episode->episodeNumber().toPaddedString()));
 
     if (m_episodeDetailsToLoad.contains(EpisodeScraperInfo::Thumbnail) && !episode->thumbnail().isEmpty()) {
+        m_downloadingEpisodes.insert(episode);
         addDownload(ImageType::TvShowEpisodeThumb, episode->thumbnail(), episode);
     } else {
-        scrapeNext();
+        finishEpisode(episode, true);
     }
 }
@@ -1,13 +1,14 @@
 #pragma once
 
 #include "globals/DownloadManager.h"
+#include "scrapers/ScrapeScheduler.h"
 #include "scrapers/tv_show/TvScraper.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QDialog>
 #include <QPointer>
-#include <QQueue>
+#include <QSet>
 
 namespace Ui {
 class TvShowMultiScrapeDialog;
@@ -39,12 +40,14 @@ private slots:
     void onChkAllEpisodeInfosToggled();
     void onStartScraping();
     void onScrapingFinished();
-    void onSearchFinished(mediaelch::scraper::ShowSearchJob* searchJob);
-    void scrapeNext();
+    void onItemStarted(int index);
+    void onItemFinished();
     void onInfoLoadDone(TvShow* show, QSet<ShowScraperInfo> details);
     void onEpisodeLoadDone();
     void onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster>> posters);
     void onDownloadFinished(DownloadManagerElement elem);
+    void onShowDownloadsFinished(TvShow* show);
+    void onAllDownloadsFinished();
 
     void onScraperChanged(int index);
     void onLanguageChanged();
@@ -57,8 +60,14 @@ private:
     SeasonOrder m_seasonOrder = SeasonOrder::Aired;
     QSet<ShowScraperInfo> m_showDetailsToLoad;
     QSet<EpisodeScraperInfo> m_episodeDetailsToLoad;
-    QQueue<TvShow*> m_showQueue;
-    QQueue<TvShowEpisode*> m_episodeQueue;
+    mediaelch::scraper::ScrapeScheduler m_scheduler;
+    /// \brief Shows and episodes that are being scraped.
+    QSet<TvShow*> m_scrapingShows;
+    QSet<TvShowEpisode*> m_scrapingEpisodes;
+    /// \brief Shows and episodes whose images are being downloaded.
+    QSet<TvShow*> m_downloadingShows;
+    QSet<TvShowEpisode*> m_downloadingEpisodes;
+    /// \brief The most recently started item. Its progress is shown.
     QPointer<TvShow> m_currentShow = nullptr;
     QPointer<TvShowEpisode> m_currentEpisode = nullptr;
     mediaelch::scraper::TvScraper* m_currentScraper = nullptr;
@@ -71,7 +80,15 @@ private:
     void setupScraperDropdown();
     void setupSeasonOrderComboBox();
     void updateCheckBoxes();
-    void saveCurrentItem();
+
+    /// \brief Starts scraping the show or episode with the given index. Returns false if it is skipped.
+    bool scrapeItem(int index);
+    void scrapeShow(TvShow* show, const mediaelch::scraper::ShowIdentifier& id);
+    void scrapeEpisode(TvShowEpisode* episode, const mediaelch::scraper::ShowIdentifier& id);
+    void onShowSearchFinished(mediaelch::scraper::ShowSearchJob* searchJob, TvShow* show);
+    void onEpisodeSearchFinished(mediaelch::scraper::ShowSearchJob* searchJob, TvShowEpisode* episode);
+    void finishShow(TvShow* show, bool wasScraped);
+    void finishEpisode(TvShowEpisode* episode, bool wasScraped);
 
     TvShowUpdateType updateType() const;
 
@@ -26,6 +26,8 @@ TvShowWidget::TvShowWidget(QWidget* parent) : QWidget(parent), ui(new Ui::TvShow
     connect(ui->seasonWidget, &TvShowWidgetSeason::sigSetActionSaveEnabled,   this, &TvShowWidget::sigSetActionSaveEnabled);
     connect(ui->seasonWidget, &TvShowWidgetSeason::sigSetActionSearchEnabled, this, &TvShowWidget::sigSetActionSearchEnabled);
     // clang-format on
+
+    connect(Manager::instance()->saveQueue(), &mediaelch::SaveQueue::sigJobFinished, this, &TvShowWidget::onItemSaved);
 }
 
 TvShowWidget::~TvShowWidget()
@@ -151,34 +153,8 @@ void TvShowWidget::onSaveInformation()
         }
     }
 
-    const int itemsToSave = shows.count() + episodes.count();
-    int itemsSaved = 0;
-    NotificationBox::instance()->showProgressBar(
-        tr("Saving changed TV Shows and Episodes"), Constants::TvShowWidgetSaveProgressMessageId);
-    QApplication::processEvents();
-
-    for (int i = 0, n = shows.count(); i < n; ++i) {
-        itemsSaved++;
-        if (shows.at(i)->hasChanged()) {
-            shows.at(i)->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
-            NotificationBox::instance()->progressBarProgress(
-                itemsSaved, itemsToSave, Constants::TvShowWidgetSaveProgressMessageId);
-            QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        }
-    }
-
-    for (int i = 0, n = episodes.count(); i < n; ++i) {
-        itemsSaved++;
-        if (episodes.at(i)->hasChanged()) {
-            episodes.at(i)->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
-            NotificationBox::instance()->progressBarProgress(
-                itemsSaved, itemsToSave, Constants::TvShowWidgetSaveProgressMessageId);
-            QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        }
-    }
-
-    NotificationBox::instance()->hideProgressBar(Constants::TvShowWidgetSaveProgressMessageId);
-    NotificationBox::instance()->showSuccess(tr("TV Shows and Episodes Saved"));
+    m_saveSuccessMessage = tr("TV Shows and Episodes Saved");
+    saveInBackground(shows, episodes);
 }
 
 /**
@@ -187,44 +163,68 @@ void TvShowWidget::onSaveInformation()
 void TvShowWidget::onSaveAll()
 {
     qCDebug(generic) << "[TvShowWidget] Save all episodes";
-    QVector<TvShow*> shows = Manager::instance()->tvShowModel()->tvShows();
-    int episodesToSave = 0;
-    int episodesSaved = 0;
-    for (int i = 0, n = shows.count(); i < n; ++i) {
-        if (shows[i]->hasChanged()) {
-            episodesToSave++;
+    const QVector<TvShow*> shows = Manager::instance()->tvShowModel()->tvShows();
+    QVector<TvShowEpisode*> episodes;
+    for (TvShow* show : shows) {
+        episodes.append(show->episodes());
+    }
+    m_saveSuccessMessage = tr("All TV Shows and Episodes Saved");
+    saveInBackground(shows, episodes);
+}
+
+void TvShowWidget::saveInBackground(const QVector<TvShow*>& shows, const QVector<TvShowEpisode*>& episodes)
+{
+    // Jobs of a previous save may still be running; the progress includes them.
+    MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterfaceTvShow();
+    mediaelch::SaveQueue& queue = *Manager::instance()->saveQueue();
+    QVector<int> jobIds;
+    for (TvShow* show : shows) {
+        if (show->hasChanged()) {
+            jobIds << show->saveDataInBackground(mediaCenter, queue);
         }
-        for (int x = 0, y = shows[i]->episodes().count(); x < y; ++x) {
-            if (shows[i]->episodes().at(x)->hasChanged()) {
-                episodesToSave++;
-            }
+    }
+    for (TvShowEpisode* episode : episodes) {
+        if (episode->hasChanged()) {
+            jobIds << episode->saveDataInBackground(mediaCenter, queue);
+        }
+    }
+    qCDebug(generic) << "[TvShowWidget] Saving" << jobIds.size() << "shows and episodes";
+
+    m_itemsToSave += jobIds.size();
+    for (int jobId : jobIds) {
+        if (jobId < 0) {
+            m_itemsSaved++;
+        } else {
+            m_saveJobs.insert(jobId);
         }
     }
-    qCDebug(generic) << "episodesToSave=" << episodesToSave;
-
     NotificationBox::instance()->showProgressBar(
         tr("Saving changed TV Shows and Episodes"), Constants::TvShowWidgetSaveProgressMessageId);
-    QApplication::processEvents();
-
-    for (int i = 0, n = shows.count(); i < n; ++i) {
-        if (shows[i]->hasChanged()) {
-            qCDebug(generic) << "SAVING TV SHOW" << shows[i]->title();
-            shows[i]->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
-            NotificationBox::instance()->progressBarProgress(
-                ++episodesSaved, episodesToSave, Constants::TvShowWidgetSaveProgressMessageId);
-            QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        }
-        for (int x = 0, y = shows[i]->episodes().count(); x < y; ++x) {
-            if (shows[i]->episodes().at(x)->hasChanged()) {
-                shows[i]->episodes().at(x)->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
-                NotificationBox::instance()->progressBarProgress(
-                    ++episodesSaved, episodesToSave, Constants::TvShowWidgetSaveProgressMessageId);
-                QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-            }
-        }
+    NotificationBox::instance()->progressBarProgress(
+        m_itemsSaved, m_itemsToSave, Constants::TvShowWidgetSaveProgressMessageId);
+    if (m_saveJobs.isEmpty()) {
+        onAllItemsSaved();
+    }
+}
+
+void TvShowWidget::onItemSaved(int jobId)
+{
+    if (!m_saveJobs.remove(jobId)) {
+        return;
+    }
+    NotificationBox::instance()->progressBarProgress(
+        ++m_itemsSaved, m_itemsToSave, Constants::TvShowWidgetSaveProgressMessageId);
+    if (m_saveJobs.isEmpty()) {
+        onAllItemsSaved();
     }
+}
+
+void TvShowWidget::onAllItemsSaved()
+{
+    m_itemsToSave = 0;
+    m_itemsSaved = 0;
     NotificationBox::instance()->hideProgressBar(Constants::TvShowWidgetSaveProgressMessageId);
-    NotificationBox::instance()->showSuccess(tr("All TV Shows and Episodes Saved"));
+    NotificationBox::instance()->showSuccess(m_saveSuccessMessage);
 }
 
 /**
@@ -3,6 +3,7 @@
 #include "globals/Globals.h"
 #include "tv_shows/SeasonNumber.h"
 
+#include <QSet>
 #include <QWidget>
 
 namespace Ui {
@@ -44,6 +45,18 @@ signals:
     void sigDownloadsProgress(int, int, int);
     void sigDownloadsFinished(int);
 
+private slots:
+    void onItemSaved(int jobId);
+
 private:
+    /// \brief Saves all changed shows and episodes in background threads, see mediaelch::SaveQueue.
+    void saveInBackground(const QVector<TvShow*>& shows, const QVector<TvShowEpisode*>& episodes);
+    void onAllItemsSaved();
+
     Ui::TvShowWidget* ui;
+    /// \brief SaveQueue job IDs of shows and episodes that are being saved.
+    QSet<int> m_saveJobs;
+    int m_itemsToSave = 0;
+    int m_itemsSaved = 0;
+    QString m_saveSuccessMessage;
 };
@@ -11,6 +11,7 @@
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
 #include "image/ImageCapture.h"
+#include "tv_shows/TvShow.h"
 #include "ui/notifications/NotificationBox.h"
 #include "ui/tv_show/TvShowSearch.h"
 
@@ -60,6 +61,7 @@ TvShowWidgetEpisode::TvShowWidgetEpisode(QWidget* parent) :
     ui->thumbnail->setShowCapture(true);
 
     m_posterDownloadManager = new DownloadManager(this);
+    m_posterDownloadManager->setPriority(mediaelch::network::DownloadScheduler::Priority::Visible);
 
     connect(ui->name, &QLineEdit::textChanged, ui->episodeName, &QLabel::setText);
     connect(ui->buttonAddDirector, &QAbstractButton::clicked, this, &TvShowWidgetEpisode::onAddDirector);
@@ -326,8 +328,12 @@ void TvShowWidgetEpisode::onSetEnabled(bool enabled)
  */
 void TvShowWidgetEpisode::setEpisode(TvShowEpisode* episode)
 {
-    qCDebug(generic) << "Entered, episode=" << episode->title();
     m_episode = episode;
+    if (episode->isDummy() && episode->tvShow() != nullptr) {
+        // Details of missing episodes are loaded lazily.
+        episode->tvShow()->loadMissingEpisodes(episode->seasonNumber());
+    }
+    qCDebug(generic) << "Entered, episode=" << episode->title();
     if (!episode->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails() && !episode->isDummy()) {
         // Loading stream details als marks the episode as changed...
         // TODO: Refactor the "hasChanged" stuff...
@@ -41,6 +41,7 @@ TvShowWidgetSeason::TvShowWidgetSeason(QWidget* parent) :
     ui->thumb->setDefaultPixmap(QPixmap(":/img/placeholders/thumb.png"));
 
     m_downloadManager = new DownloadManager(this);
+    m_downloadManager->setPriority(mediaelch::network::DownloadScheduler::Priority::Visible);
 
     m_loadingMovie = new QMovie(":/img/spinner.gif", QByteArray(), this);
     m_loadingMovie->start();
@@ -96,6 +96,7 @@ TvShowWidgetTvShow::TvShowWidgetTvShow(QWidget* parent) :
     m_savingWidget->hide();
 
     m_posterDownloadManager = new DownloadManager(this);
+    m_posterDownloadManager->setPriority(mediaelch::network::DownloadScheduler::Priority::Visible);
 
     ui->poster->setImageType(ImageType::TvShowPoster);
     ui->backdrop->setImageType(ImageType::TvShowBackdrop);
@@ -0,0 +1,143 @@
+#include "test/test_helpers.h"
+
+#include "data/DatabaseRecord.h"
+#include "media_centers/kodi/EpisodeXmlReader.h"
+#include "media_centers/kodi/EpisodeXmlWriter.h"
+#include "media_centers/kodi/MovieXmlReader.h"
+#include "media_centers/kodi/MovieXmlWriter.h"
+#include "movies/Movie.h"
+#include "settings/Settings.h"
+#include "test/integration/resource_dir.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QXmlStreamReader>
+
+using namespace mediaelch;
+
+/// Reads the NFO file, stores the movie in a record, loads the record into a new
+/// movie and compares the NFO written for it with the one written for the original.
+static void checkMovieRecordRoundTrip(const QString& filename)
+{
+    CAPTURE(filename);
+    // Stream details require files, see "read details: stream details" in testKodi_v18_movie.cpp
+    const QStringList files{"/movies/Allegiant/Allegiant.mkv"};
+
+    Movie movie(files);
+    kodi::MovieXmlReader reader(movie);
+    QXmlStreamReader xml(getFileContent(filename));
+    reader.parse(xml);
+
+    const QByteArray record = serializeMovieRecord(movie);
+    Movie loadedMovie(files);
+    REQUIRE(deserializeMovieRecord(record, loadedMovie));
+
+    CHECK(loadedMovie.streamDetailsLoaded() == movie.streamDetailsLoaded());
+    CHECK(loadedMovie.streamDetails()->videoDetails() == movie.streamDetails()->videoDetails());
+    CHECK(loadedMovie.streamDetails()->audioDetails() == movie.streamDetails()->audioDetails());
+    CHECK(loadedMovie.streamDetails()->subtitleDetails() == movie.streamDetails()->subtitleDetails());
+
+    kodi::MovieXmlWriterGeneric expectedWriter(KodiVersion(18), movie);
+    const QString expected = expectedWriter.getMovieXml(true).trimmed();
+    kodi::MovieXmlWriterGeneric writer(KodiVersion(18), loadedMovie);
+    const QString actual = writer.getMovieXml(true).trimmed();
+    writeTempFile("record/" + filename, actual);
+    checkSameXml(expected, actual);
+}
+
+static void checkEpisodeRecordRoundTrip(const QString& filename)
+{
+    CAPTURE(filename);
+    const QString episodeContent = getFileContent(filename);
+
+    TvShowEpisode episode;
+    kodi::EpisodeXmlReader reader(episode);
+    QXmlStreamReader xml(episodeContent);
+    reader.parse(xml);
+
+    const QByteArray record = serializeEpisodeRecord(episode);
+    TvShowEpisode loadedEpisode;
+    REQUIRE(deserializeEpisodeRecord(record, loadedEpisode));
+
+    kodi::EpisodeXmlWriterGeneric writer(KodiVersion(18), {&loadedEpisode});
+    const QString actual = writer.getEpisodeXmlWithSingleRoot(true).trimmed();
+    writeTempFile("record/" + filename, actual);
+    checkSameXml(episodeContent, actual);
+}
+
+TEST_CASE("Database records", "[data][database]")
+{
+    // required for consistent test runs
+    Settings::instance()->setUsePlotForOutline(false);
+
+    SECTION("movie records contain all NFO details")
+    {
+        checkMovieRecordRoundTrip("movie/kodi_v18_movie_all.nfo");
+        checkMovieRecordRoundTrip("movie/kodi_v18_Alien_1979.nfo");
+        checkMovieRecordRoundTrip("movie/kodi_v18_Toy_Story_3_2010.nfo");
+    }
+
+    SECTION("movie records contain stream details")
+    {
+        Movie movie(QStringList{"/movies/Allegiant/Allegiant.mkv"});
+        kodi::MovieXmlReader reader(movie);
+        QXmlStreamReader xml(getFileContent("movie/kodi_v18_movie_all.nfo"));
+        reader.parse(xml);
+        REQUIRE(movie.streamDetailsLoaded());
+
+        Movie loadedMovie(QStringList{"/movies/Allegiant/Allegiant.mkv"});
+        REQUIRE(deserializeMovieRecord(serializeMovieRecord(movie), loadedMovie));
+        CHECK(loadedMovie.streamDetailsLoaded());
+        const auto* streamDetails = loadedMovie.streamDetails();
+        CHECK(streamDetails->videoDetails().value(StreamDetails::VideoDetails::Codec) == "h264");
+        CHECK(streamDetails->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds) == "5311");
+        REQUIRE(streamDetails->audioDetails().size() == 3);
+        CHECK(streamDetails->audioDetails().at(0).isEmpty());
+        CHECK(streamDetails->audioDetails().at(1).value(StreamDetails::AudioDetails::Language) == "eng");
+        CHECK(streamDetails->audioDetails().at(2).value(StreamDetails::AudioDetails::Channels) == "2");
+        REQUIRE(streamDetails->subtitleDetails().size() == 2);
+        CHECK(streamDetails->subtitleDetails().at(1).value(StreamDetails::SubtitleDetails::Language) == "eng");
+    }
+
+    SECTION("episode records contain all NFO details")
+    {
+        checkEpisodeRecordRoundTrip("show/kodi_v18_episode_American_Dad_S02E01.nfo");
+    }
+
+    SECTION("invalid records are not loaded")
+    {
+        Movie movie;
+        movie.setName("Unchanged");
+        CHECK_FALSE(deserializeMovieRecord(QByteArray(), movie));
+        CHECK_FALSE(deserializeMovieRecord(QByteArray("<movie></movie>"), movie));
+        CHECK(movie.name() == "Unchanged");
+
+        // Truncated records are detected.
+        QByteArray record = serializeMovieRecord(movie);
+        record.chop(4);
+        CHECK_FALSE(deserializeMovieRecord(record, movie));
+    }
+
+    SECTION("media info records contain all stream details")
+    {
+        StreamDetails::Values values;
+        values.video.insert(StreamDetails::VideoDetails::DurationInSeconds, "5400");
+        values.video.insert(StreamDetails::VideoDetails::Codec, "h264");
+        values.video.insert(StreamDetails::VideoDetails::Width, "1920");
+        values.audio.push_back({{StreamDetails::AudioDetails::Codec, "ac3"},
+            {StreamDetails::AudioDetails::Language, "eng"},
+            {StreamDetails::AudioDetails::Channels, "6"}});
+        values.audio.push_back({{StreamDetails::AudioDetails::Codec, "dts"}});
+        values.subtitles.push_back({{StreamDetails::SubtitleDetails::Language, "ger"}});
+
+        StreamDetails::Values loaded;
+        REQUIRE(deserializeMediaInfoRecord(serializeMediaInfoRecord(values), loaded));
+        CHECK(loaded.video == values.video);
+        CHECK(loaded.audio == values.audio);
+        CHECK(loaded.subtitles == values.subtitles);
+
+        QByteArray record = serializeMediaInfoRecord(values);
+        record.chop(4);
+        CHECK_FALSE(deserializeMediaInfoRecord(record, loaded));
+        CHECK_FALSE(deserializeMediaInfoRecord(QByteArray(), loaded));
+    }
+}
@@ -0,0 +1,64 @@
+#include "test/test_helpers.h"
+
+#include "data/Database.h"
+#include "data/MediaInfoIndexer.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+TEST_CASE("MediaInfoIndexer only stores successful reads", "[data][database]")
+{
+    // Do not touch the user's cache database.
+    QStandardPaths::setTestModeEnabled(true);
+    Database database;
+
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    const QString filePath = tempDir.path() + "/movie.mkv";
+    {
+        QFile file(filePath);
+        REQUIRE(file.open(QFile::WriteOnly));
+        file.write("not a video");
+    }
+    const QFileInfo fileInfo(filePath);
+    const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    int readCount = 0;
+    const auto failedRead = [&readCount](const QString&, StreamDetails::Values& values) {
+        ++readCount;
+        values = StreamDetails::Values();
+        return false;
+    };
+    const auto successfulRead = [&readCount](const QString&, StreamDetails::Values& values) {
+        ++readCount;
+        values = StreamDetails::Values();
+        values.video.insert(StreamDetails::VideoDetails::DurationInSeconds, "5400");
+        return true;
+    };
+
+    SECTION("failed reads are not stored")
+    {
+        StreamDetails::Values values = MediaInfoIndexer::loadFile(database, filePath, failedRead);
+        CHECK(values.video.isEmpty());
+        CHECK(database.mediaInfo(filePath, fileInfo.size(), lastModified).isEmpty());
+
+        // The file is read again, e.g. after libmediainfo was installed.
+        values = MediaInfoIndexer::loadFile(database, filePath, successfulRead);
+        CHECK(readCount == 2);
+        CHECK(values.video.value(StreamDetails::VideoDetails::DurationInSeconds) == "5400");
+    }
+
+    SECTION("successful reads are stored")
+    {
+        MediaInfoIndexer::loadFile(database, filePath, successfulRead);
+        CHECK_FALSE(database.mediaInfo(filePath, fileInfo.size(), lastModified).isEmpty());
+
+        const StreamDetails::Values values = MediaInfoIndexer::loadFile(database, filePath, failedRead);
+        CHECK(readCount == 1);
+        CHECK(values.video.value(StreamDetails::VideoDetails::DurationInSeconds) == "5400");
+    }
+}
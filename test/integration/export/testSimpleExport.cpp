@@ -49,8 +49,10 @@ TEST_CASE("Simple HTML export", "[export][simple]")
     exportTemplate.setDirectory(mediaelch::DirectoryPath(exportDir("simple")));
 
     std::atomic_bool cancelFlag{false};
+    // An empty directory disables the cache.
+    ExportImageCache imageCache("");
 
-    SimpleEngine engine(exportTemplate, tempDir("export/simple"), cancelFlag);
+    SimpleEngine engine(exportTemplate, tempDir("export/simple"), imageCache, cancelFlag);
     engine.exportMovies(fakeMovies());
 
     // just some basic checks
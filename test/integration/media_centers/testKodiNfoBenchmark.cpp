@@ -0,0 +1,100 @@
+#include "test/test_helpers.h"
+
+#include "media_centers/kodi/EpisodeXmlReader.h"
+#include "media_centers/kodi/MovieXmlReader.h"
+#include "movies/Movie.h"
+#include "test/integration/resource_dir.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QDomDocument>
+#include <QElapsedTimer>
+#include <QXmlStreamReader>
+
+#ifdef Q_OS_UNIX
+#    include <sys/resource.h>
+#endif
+
+// These benchmarks are hidden and not run by CTest.  Run each of them in its own
+// process so that the peak memory is not influenced by the other one, e.g.:
+//   ./mediaelch_test_integration --resource-dir ../test/resources "Kodi NFO benchmark: streaming"
+//   ./mediaelch_test_integration --resource-dir ../test/resources "Kodi NFO benchmark: DOM"
+
+namespace {
+
+constexpr int NFO_COUNT = 10000;
+
+/// \brief Peak resident set size of this process in KiB or -1 if unknown.
+long peakMemoryKiB()
+{
+#ifdef Q_OS_UNIX
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+#    ifdef Q_OS_MACOS
+    return usage.ru_maxrss / 1024; // bytes
+#    else
+    return usage.ru_maxrss; // KiB
+#    endif
+#else
+    return -1;
+#endif
+}
+
+/// \brief Parses a movie NFO and a multi-episode NFO NFO_COUNT/2 times each.
+template<class Callback>
+void runNfoBenchmark(const QString& name, Callback parseNfos)
+{
+    const QString movieContent = getFileContent("movie/kodi_v18_Alien_1979.nfo");
+    const QString episodeContent = getFileContent("show/kodi_v18_episode_American_Dad_S02E03-S02E04.nfo");
+
+    const long memoryBefore = peakMemoryKiB();
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < NFO_COUNT / 2; ++i) {
+        parseNfos(movieContent, episodeContent);
+    }
+
+    const qint64 elapsed = timer.elapsed();
+    const long memoryAfter = peakMemoryKiB();
+    WARN(name.toStdString() << ": " << elapsed << "ms for " << NFO_COUNT << " NFOs, peak memory: " << memoryAfter
+                            << "KiB (+" << (memoryAfter - memoryBefore) << "KiB)");
+}
+
+} // namespace
+
+TEST_CASE("Kodi NFO benchmark: streaming", "[.][benchmark][kodi][nfo]")
+{
+    runNfoBenchmark("QXmlStreamReader", [](const QString& movieContent, const QString& episodeContent) {
+        Movie movie;
+        QXmlStreamReader xml(movieContent);
+        mediaelch::kodi::MovieXmlReader(movie).parse(xml);
+        CHECK(movie.actors().size() == 10);
+
+        // The second episode of the file is selected like in KodiXml::loadTvShowEpisode().
+        TvShowEpisode episode;
+        episode.setSeason(SeasonNumber(2));
+        episode.setEpisode(EpisodeNumber(4));
+        CHECK(mediaelch::kodi::EpisodeXmlReader(episode).parseNfo(episodeContent));
+        CHECK(episode.actors().size() == 16);
+    });
+}
+
+TEST_CASE("Kodi NFO benchmark: DOM", "[.][benchmark][kodi][nfo]")
+{
+    // Reference: Only builds the documents that the NFO readers used before they were
+    // ported to QXmlStreamReader; reading the details is not included.
+    runNfoBenchmark("QDomDocument", [](const QString& movieContent, const QString& episodeContent) {
+        // Same objects as above so that only parsing differs.
+        Movie movie;
+        QDomDocument movieDoc;
+        movieDoc.setContent(movieContent);
+        CHECK(movieDoc.elementsByTagName("actor").size() == 10);
+
+        TvShowEpisode episode;
+        QDomDocument episodeDoc;
+        episodeDoc.setContent(mediaelch::kodi::EpisodeXmlReader::makeValidEpisodeXml(episodeContent));
+        CHECK(episodeDoc.elementsByTagName("episodedetails").size() == 2);
+    });
+}
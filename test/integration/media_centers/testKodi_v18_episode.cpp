@@ -7,7 +7,7 @@
 #include "tv_shows/TvShowEpisode.h"
 
 #include <QDateTime>
-#include <QDomDocument>
+#include <QXmlStreamReader>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -26,9 +26,9 @@ static void createAndCompareSingleEpisode(const QString& filename, Callback call
     QString episodeContent = getFileContent(filename);
 
     mediaelch::kodi::EpisodeXmlReader reader(episode);
-    QDomDocument doc;
-    doc.setContent(episodeContent);
-    reader.parseNfoDom(doc.elementsByTagName("episodedetails").at(0).toElement());
+    QXmlStreamReader xml(episodeContent);
+    reader.parse(xml);
+    CHECK_FALSE(xml.hasError());
 
     callback(episode);
 
@@ -47,17 +47,15 @@ static void createAndCompareMultiEpisode(const QString& filename, Callback callb
     QVector<TvShowEpisode*> episodesPointer;
     QString episodeContent = getFileContent(filename);
 
-    QDomDocument doc;
-    doc.setContent(episodeContent);
-    QDomNodeList detailTags = doc.elementsByTagName("episodedetails");
-
-    for (int i = 0; i < detailTags.size(); ++i) {
+    QXmlStreamReader xml(mediaelch::kodi::EpisodeXmlReader::makeValidEpisodeXml(episodeContent));
+    while (mediaelch::kodi::EpisodeXmlReader::readNextEpisodeDetails(xml)) {
         episodes.push_back(std::make_unique<TvShowEpisode>());
         episodesPointer.push_back(episodes.back().get());
 
         mediaelch::kodi::EpisodeXmlReader reader(*episodesPointer.last());
-        reader.parseNfoDom(detailTags.at(i).toElement());
+        reader.parseEpisodeDetails(xml);
     }
+    CHECK_FALSE(xml.hasError());
 
     callback(episodesPointer);
 
@@ -108,10 +106,8 @@ TEST_CASE("Episode XML writer for Kodi v18", "[data][tvshow][kodi][nfo]")
         CAPTURE(filename);
 
         EpisodeXmlReader reader(episode);
-
-        QDomDocument doc;
-        doc.setContent(episodeContent);
-        reader.parseNfoDom(doc.elementsByTagName("episodedetails").at(0).toElement());
+        QXmlStreamReader xml(episodeContent);
+        reader.parse(xml);
 
         mediaelch::kodi::EpisodeXmlWriterGeneric writer(mediaelch::KodiVersion(18), {&episode});
         QString actual = writer.getEpisodeXmlWithSingleRoot(true).trimmed();
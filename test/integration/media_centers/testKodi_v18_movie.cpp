@@ -6,7 +6,7 @@
 #include "test/integration/resource_dir.h"
 
 #include <QDateTime>
-#include <QDomDocument>
+#include <QXmlStreamReader>
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -23,9 +23,9 @@ static void createAndCompareMovie(const QString& filename, Callback callback)
     QString movieContent = getFileContent(filename);
 
     mediaelch::kodi::MovieXmlReader reader(movie);
-    QDomDocument doc;
-    doc.setContent(movieContent);
-    reader.parseNfoDom(doc);
+    QXmlStreamReader xml(movieContent);
+    reader.parse(xml);
+    CHECK_FALSE(xml.hasError());
 
     callback(movie);
 
@@ -78,6 +78,28 @@ TEST_CASE("Movie XML writer for Kodi v18", "[data][movie][kodi][nfo]")
         });
     }
 
+    SECTION("read details: stream details")
+    {
+        // requires files, see "Full movie details"
+        Movie movie(QStringList{"/movies/Allegiant/Allegiant.mkv"});
+        mediaelch::kodi::MovieXmlReader reader(movie);
+        QXmlStreamReader xml(getFileContent("movie/kodi_v18_movie_all.nfo"));
+        reader.parse(xml);
+        CHECK_FALSE(xml.hasError());
+
+        CHECK(movie.name() == "Allegiant");
+        CHECK(movie.streamDetailsLoaded());
+        const auto* streamDetails = movie.streamDetails();
+        CHECK(streamDetails->videoDetails().value(StreamDetails::VideoDetails::Codec) == "h264");
+        CHECK(streamDetails->videoDetails().value(StreamDetails::VideoDetails::Width) == "1920");
+        REQUIRE(streamDetails->audioDetails().size() == 3);
+        CHECK(streamDetails->audioDetails().at(0).isEmpty());
+        CHECK(streamDetails->audioDetails().at(1).value(StreamDetails::AudioDetails::Language) == "eng");
+        CHECK(streamDetails->audioDetails().at(2).value(StreamDetails::AudioDetails::Channels) == "2");
+        REQUIRE(streamDetails->subtitleDetails().size() == 2);
+        CHECK(streamDetails->subtitleDetails().at(1).value(StreamDetails::SubtitleDetails::Language) == "eng");
+    }
+
     SECTION("Full movie details")
     {
         // Taken from https://kodi.wiki/view/NFO_files/Movies#Sample_Movie_nfo_File
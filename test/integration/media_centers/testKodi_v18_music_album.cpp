@@ -6,7 +6,7 @@
 #include "test/integration/resource_dir.h"
 
 #include <QDateTime>
-#include <QDomDocument>
+#include <QXmlStreamReader>
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -23,9 +23,9 @@ static void createAndCompareAlbum(const QString& filename, Callback callback)
     QString albumContent = getFileContent(filename);
 
     mediaelch::kodi::AlbumXmlReader reader(album);
-    QDomDocument doc;
-    doc.setContent(albumContent);
-    reader.parseNfoDom(doc);
+    QXmlStreamReader xml(albumContent);
+    reader.parse(xml);
+    CHECK_FALSE(xml.hasError());
 
     callback(album);
 
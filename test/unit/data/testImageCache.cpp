@@ -0,0 +1,146 @@
+#include "test/test_helpers.h"
+
+#include "data/ImageCache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+namespace {
+
+void writeImage(const QString& fileName)
+{
+    QImage image(400, 200, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+    REQUIRE(image.save(fileName));
+}
+
+int blobCount(const QString& cacheDir)
+{
+    return QDir(cacheDir).entryList({"*.jpg", "*.png"}, QDir::Files).size();
+}
+
+} // namespace
+
+TEST_CASE("ImageCache stores thumbnails", "[data]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString cacheDir = dir.filePath("cache");
+    const QString source = dir.filePath("poster.png");
+    writeImage(source);
+
+    int origWidth = 0;
+    int origHeight = 0;
+
+    SECTION("miss")
+    {
+        ImageCache cache(DirectoryPath(cacheDir), ImageCache::DEFAULT_MAX_CACHE_SIZE);
+        const QImage img = cache.image(FilePath(source), 100, 100, origWidth, origHeight);
+        CHECK(img.size() == QSize(100, 50));
+        CHECK(origWidth == 400);
+        CHECK(origHeight == 200);
+        CHECK(blobCount(cacheDir) == 1);
+        CHECK(cache.cacheSize() > 0);
+        CHECK(cache.imageSize(FilePath(source)) == QSize(400, 200));
+
+        // Missing images are not cached.
+        CHECK(cache.image(FilePath(dir.filePath("missing.png")), 100, 100, origWidth, origHeight).isNull());
+        CHECK(blobCount(cacheDir) == 1);
+    }
+
+    SECTION("hit")
+    {
+        ImageCache cache(DirectoryPath(cacheDir), ImageCache::DEFAULT_MAX_CACHE_SIZE);
+        cache.image(FilePath(source), 100, 100, origWidth, origHeight);
+        const qint64 size = cache.cacheSize();
+
+        // The source is not read again, so a removed source can't be noticed
+        // until its modification time is checked again.
+        REQUIRE(QFile::remove(source));
+        origWidth = 0;
+        origHeight = 0;
+        const QImage img = cache.image(FilePath(source), 100, 100, origWidth, origHeight);
+        CHECK(img.size() == QSize(100, 50));
+        CHECK(origWidth == 400);
+        CHECK(origHeight == 200);
+        CHECK(cache.cacheSize() == size);
+        CHECK(blobCount(cacheDir) == 1);
+    }
+
+    SECTION("index is reused by the next instance")
+    {
+        qint64 size = 0;
+        {
+            ImageCache cache(DirectoryPath(cacheDir), ImageCache::DEFAULT_MAX_CACHE_SIZE);
+            cache.image(FilePath(source), 100, 100, origWidth, origHeight);
+            size = cache.cacheSize();
+        }
+        ImageCache cache(DirectoryPath(cacheDir), ImageCache::DEFAULT_MAX_CACHE_SIZE);
+        CHECK(cache.cacheSize() == size);
+        CHECK(blobCount(cacheDir) == 1);
+    }
+
+    SECTION("invalidateImages() removes all thumbnails of the image")
+    {
+        ImageCache cache(DirectoryPath(cacheDir), ImageCache::DEFAULT_MAX_CACHE_SIZE);
+        cache.image(FilePath(source), 100, 100, origWidth, origHeight);
+        cache.image(FilePath(source), 50, 50, origWidth, origHeight);
+        CHECK(blobCount(cacheDir) == 2);
+
+        cache.invalidateImages(FilePath(source));
+        CHECK(blobCount(cacheDir) == 0);
+        CHECK(cache.cacheSize() == 0);
+
+        // The next request reads the source again.
+        REQUIRE(QFile::remove(source));
+        CHECK(cache.image(FilePath(source), 100, 100, origWidth, origHeight).isNull());
+    }
+}
+
+TEST_CASE("ImageCache evicts least recently used thumbnails", "[data]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString first = dir.filePath("first.png");
+    const QString second = dir.filePath("second.png");
+    const QString third = dir.filePath("third.png");
+    writeImage(first);
+    writeImage(second);
+    writeImage(third);
+
+    int origWidth = 0;
+    int origHeight = 0;
+
+    // All sources are equal, so are the sizes of their thumbnails.
+    qint64 blobSize = 0;
+    {
+        ImageCache cache(DirectoryPath(dir.filePath("measure")), ImageCache::DEFAULT_MAX_CACHE_SIZE);
+        cache.image(FilePath(first), 100, 100, origWidth, origHeight);
+        blobSize = cache.cacheSize();
+    }
+    REQUIRE(blobSize > 0);
+
+    const QString cacheDir = dir.filePath("cache");
+    ImageCache cache(DirectoryPath(cacheDir), blobSize * 5 / 2);
+    cache.image(FilePath(first), 100, 100, origWidth, origHeight);
+    cache.image(FilePath(second), 100, 100, origWidth, origHeight);
+    // Cache hit: "second" is now the least recently used thumbnail.
+    cache.image(FilePath(first), 100, 100, origWidth, origHeight);
+    CHECK(cache.cacheSize() == 2 * blobSize);
+
+    cache.image(FilePath(third), 100, 100, origWidth, origHeight);
+    CHECK(cache.cacheSize() == 2 * blobSize);
+    CHECK(blobCount(cacheDir) == 2);
+
+    // Without their sources, only cached thumbnails can be returned.
+    REQUIRE(QFile::remove(first));
+    REQUIRE(QFile::remove(second));
+    REQUIRE(QFile::remove(third));
+    CHECK_FALSE(cache.image(FilePath(first), 100, 100, origWidth, origHeight).isNull());
+    CHECK(cache.image(FilePath(second), 100, 100, origWidth, origHeight).isNull());
+    CHECK_FALSE(cache.image(FilePath(third), 100, 100, origWidth, origHeight).isNull());
+}
@@ -0,0 +1,84 @@
+#include "test/test_helpers.h"
+
+#include "export/CompiledTemplate.h"
+
+using namespace mediaelch;
+
+TEST_CASE("CompiledTemplate replaces placeholders", "[export]")
+{
+    TemplateData data;
+    data.variables.insert("MOVIE.TITLE", "Alien");
+    data.variables.insert("MOVIE.YEAR", "1979");
+
+    SECTION("known placeholders")
+    {
+        const CompiledTemplate tpl("<h1>{{ MOVIE.TITLE }} ({{ MOVIE.YEAR }})</h1>{{ MOVIE.TITLE }}");
+        CHECK(tpl.render(data) == "<h1>Alien (1979)</h1>Alien");
+    }
+
+    SECTION("unknown placeholders are kept")
+    {
+        const CompiledTemplate tpl("{{ MOVIE.UNKNOWN }} {{ MOVIE.TITLE");
+        CHECK(tpl.render(data) == "{{ MOVIE.UNKNOWN }} {{ MOVIE.TITLE");
+    }
+
+    SECTION("values are not parsed again")
+    {
+        data.variables.insert("MOVIE.PLOT", "{{ MOVIE.TITLE }}");
+        CHECK(CompiledTemplate("{{ MOVIE.PLOT }}").render(data) == "{{ MOVIE.TITLE }}");
+    }
+}
+
+TEST_CASE("CompiledTemplate renders blocks", "[export]")
+{
+    TemplateData actor1;
+    actor1.variables.insert("ACTOR.NAME", "Sigourney Weaver");
+    TemplateData actor2;
+    actor2.variables.insert("ACTOR.NAME", "Tom Skerritt");
+
+    TemplateData data;
+    data.variables.insert("MOVIE.TITLE", "Alien");
+    data.blocks.insert("ACTORS", TemplateData::Block{{actor1, actor2}, " "});
+
+    SECTION("block items are trimmed and joined")
+    {
+        const CompiledTemplate tpl("{{ BEGIN_BLOCK_ACTORS }}\n  <li>{{ ACTOR.NAME }}</li>\n{{ END_BLOCK_ACTORS }}");
+        CHECK(tpl.render(data) == "<li>Sigourney Weaver</li> <li>Tom Skerritt</li>");
+        CHECK(tpl.containsBlock("ACTORS"));
+        CHECK_FALSE(tpl.containsBlock("TAGS"));
+    }
+
+    SECTION("placeholders of enclosing items can be used in blocks")
+    {
+        const CompiledTemplate tpl("{{ BEGIN_BLOCK_ACTORS }}{{ MOVIE.TITLE }}{{ END_BLOCK_ACTORS }}");
+        CHECK(tpl.render(data) == "Alien Alien");
+    }
+
+    SECTION("unknown blocks are kept")
+    {
+        const QString text = "{{ BEGIN_BLOCK_TAGS }}{{ TAG.NAME }}{{ END_BLOCK_TAGS }}";
+        CHECK(CompiledTemplate(text).render(data) == text);
+    }
+
+    SECTION("rendered blocks")
+    {
+        const CompiledTemplate tpl("<ul>{{ BEGIN_BLOCK_MOVIE }}{{ MOVIE.TITLE }}{{ END_BLOCK_MOVIE }}</ul>");
+        CHECK(tpl.block("MOVIE").render(data) == "Alien");
+
+        TemplateData list;
+        list.renderedBlocks.insert("MOVIE", "Alien\nAliens");
+        CHECK(tpl.render(list) == "<ul>Alien\nAliens</ul>");
+    }
+}
+
+TEST_CASE("CompiledTemplate resolves images", "[export]")
+{
+    TemplateData data;
+    data.images = [](const QString& type, const QSize& size, bool* isPlaceholderUsed) {
+        *isPlaceholderUsed = (type == "poster");
+        return QStringLiteral("movie_images/1-%1_%2x%3.jpg").arg(type).arg(size.width()).arg(size.height());
+    };
+
+    const CompiledTemplate tpl("{{ IMAGE.POSTER[100, 150] }} {{ IMAGE.unknown[10,10] }} {{ IMAGE.poster[0, 0] }}");
+    CHECK(tpl.render(data) == "movie_images/1-poster_100x150.jpg {{ IMAGE.unknown[10,10] }} {{ IMAGE.poster[0, 0] }}");
+}
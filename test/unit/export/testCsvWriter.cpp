@@ -0,0 +1,81 @@
+#include "test/test_helpers.h"
+
+#include "export/CsvWriter.h"
+
+#include <QStringList>
+#include <QTextStream>
+
+using namespace mediaelch;
+
+TEST_CASE("CsvWriter writes header and rows", "[export]")
+{
+    QString output;
+    QTextStream stream(&output);
+    CsvWriter<int> csv(stream, CsvFormat(";", " "));
+    csv.addColumn("number", [](const int& row) { return QString::number(row); });
+    csv.addColumn("text", [](const int& row) { return QStringLiteral("a;b\nc%1").arg(row); });
+
+    int rowsWritten = 0;
+    csv.writeHeader();
+    csv.writeRows({1, 2}, [&rowsWritten](const int&) { ++rowsWritten; });
+    stream.flush();
+
+    CHECK(output == "number;text\n1;a b\\nc1\n2;a b\\nc2\n");
+    CHECK(rowsWritten == 2);
+}
+
+TEST_CASE("CsvWriter escapes values", "[export]")
+{
+    const CsvFormat format(",", " ");
+    const auto escaped = [&format](const QString& text) {
+        QString out;
+        format.appendEscaped(out, text);
+        return out;
+    };
+
+    CHECK(escaped("Alien") == "Alien");
+    CHECK(escaped("Alien, Aliens") == "Alien  Aliens");
+    CHECK(escaped("=1+2") == "'=1+2");
+    CHECK(escaped("-1") == "'-1");
+    CHECK(escaped("a\r\nb") == "a\\nb");
+}
+
+TEST_CASE("CsvWriter keeps the order of rows across chunks", "[export]")
+{
+    constexpr int rowCount = CsvWriter<int>::CHUNK_SIZE * 3 + 7;
+    QVector<int> rows;
+    for (int i = 0; i < rowCount; ++i) {
+        rows << i;
+    }
+
+    QString output;
+    QTextStream stream(&output);
+    CsvWriter<int> csv(stream, CsvFormat("\t", " "));
+    csv.addColumn("number", [](const int& row) { return QString::number(row); });
+
+    QVector<int> writtenRows;
+    csv.writeRows(rows, [&writtenRows](const int& row) { writtenRows << row; });
+    stream.flush();
+
+    CHECK(writtenRows == rows);
+    const QStringList lines = output.split('\n', ElchSplitBehavior::SkipEmptyParts);
+    REQUIRE(lines.size() == rowCount);
+    for (int i = 0; i < rowCount; ++i) {
+        REQUIRE(lines[i] == QString::number(i));
+    }
+}
+
+TEST_CASE("CsvWriter without columns writes nothing", "[export]")
+{
+    QString output;
+    QTextStream stream(&output);
+    CsvWriter<int> csv(stream, CsvFormat("\t", " "));
+
+    int rowsWritten = 0;
+    csv.writeHeader();
+    csv.writeRows({1, 2, 3}, [&rowsWritten](const int&) { ++rowsWritten; });
+    stream.flush();
+
+    CHECK(output.isEmpty());
+    CHECK(rowsWritten == 3);
+}
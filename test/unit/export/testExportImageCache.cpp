@@ -0,0 +1,58 @@
+#include "test/test_helpers.h"
+
+#include "export/ExportImageCache.h"
+
+#include <QImage>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+static void writeImage(const QString& fileName, int width, int height)
+{
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+    REQUIRE(image.save(fileName));
+}
+
+TEST_CASE("ExportImageCache scales images", "[export]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString source = dir.filePath("poster.png");
+    writeImage(source, 400, 200);
+
+    CHECK(ExportImageCache::readScaled(source, QSize(100, 100)).size() == QSize(100, 50));
+    CHECK(ExportImageCache::readScaled(dir.filePath("missing.png"), QSize(100, 100)).isNull());
+}
+
+TEST_CASE("ExportImageCache reuses unchanged images", "[export]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString cacheDir = dir.filePath("cache");
+    const QString source = dir.filePath("poster.png");
+    writeImage(source, 400, 200);
+
+    {
+        ExportImageCache cache(cacheDir);
+        CHECK(cache.exportImage(source, QSize(100, 100), dir.filePath("a.png")) == ExportImageCache::Result::Encoded);
+        CHECK(QImage(dir.filePath("a.png")).size() == QSize(100, 50));
+        CHECK(cache.exportImage(source, QSize(50, 50), dir.filePath("b.png")) == ExportImageCache::Result::Encoded);
+        cache.save();
+    }
+
+    SECTION("the manifest is used by the next export")
+    {
+        ExportImageCache cache(cacheDir);
+        CHECK(cache.exportImage(source, QSize(100, 100), dir.filePath("c.png")) == ExportImageCache::Result::Reused);
+        CHECK(QImage(dir.filePath("c.png")).size() == QSize(100, 50));
+    }
+
+    SECTION("changed images are scaled again")
+    {
+        writeImage(source, 600, 200);
+        ExportImageCache cache(cacheDir);
+        CHECK(cache.exportImage(source, QSize(100, 100), dir.filePath("c.png")) == ExportImageCache::Result::Encoded);
+        CHECK(QImage(dir.filePath("c.png")).size() == QSize(100, 33));
+    }
+}
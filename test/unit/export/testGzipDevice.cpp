@@ -0,0 +1,101 @@
+#include "test/test_helpers.h"
+
+#include "export/GzipDevice.h"
+
+#include <QBuffer>
+
+using namespace mediaelch;
+
+namespace {
+
+quint32 readLittleEndian(const QByteArray& data, int pos)
+{
+    quint32 value = 0;
+    for (int i = 3; i >= 0; --i) {
+        value = (value << 8) | static_cast<quint8>(data[pos + i]);
+    }
+    return value;
+}
+
+void appendBigEndian(QByteArray& out, quint32 value)
+{
+    for (int i = 3; i >= 0; --i) {
+        out.append(static_cast<char>((value >> (8 * i)) & 0xFFU));
+    }
+}
+
+quint32 adler32(const QByteArray& data)
+{
+    quint32 a = 1;
+    quint32 b = 0;
+    for (const char c : data) {
+        a = (a + static_cast<quint8>(c)) % 65521U;
+        b = (b + a) % 65521U;
+    }
+    return (b << 16) | a;
+}
+
+/// \brief Checks the gzip member's header and trailer and decompresses it by converting
+///        it into the format of qUncompress().
+QByteArray gunzipMember(const QByteArray& member, const QByteArray& expected)
+{
+    REQUIRE(member.size() > 18);
+    CHECK(member.left(3) == QByteArray("\x1f\x8b\x08", 3));
+    CHECK(readLittleEndian(member, member.size() - 8) == GzipDevice::crc32(expected));
+    CHECK(readLittleEndian(member, member.size() - 4) == static_cast<quint32>(expected.size()));
+
+    QByteArray zlib;
+    appendBigEndian(zlib, static_cast<quint32>(expected.size()));
+    zlib.append("\x78\x9c", 2);
+    zlib.append(member.mid(10, member.size() - 18));
+    appendBigEndian(zlib, adler32(expected));
+    return qUncompress(zlib);
+}
+
+} // namespace
+
+TEST_CASE("GzipDevice computes gzip's CRC-32", "[export]")
+{
+    CHECK(GzipDevice::crc32("") == 0U);
+    CHECK(GzipDevice::crc32("123456789") == 0xCBF43926U);
+}
+
+TEST_CASE("GzipDevice writes gzip members", "[export]")
+{
+    QBuffer buffer;
+    REQUIRE(buffer.open(QIODevice::WriteOnly));
+
+    SECTION("small data is written on close")
+    {
+        const QByteArray data = "movie_title\tmovie_year\nAlien\t1979\n";
+        GzipDevice gzip(&buffer);
+        REQUIRE(gzip.open(QIODevice::WriteOnly));
+        CHECK(gzip.write(data) == data.size());
+        CHECK(buffer.data().isEmpty());
+        gzip.close();
+
+        CHECK(gunzipMember(buffer.data(), data) == data);
+    }
+
+    SECTION("large data is split into several members")
+    {
+        const QByteArray first(GzipDevice::MEMBER_SIZE, 'a');
+        const QByteArray second = "last line\n";
+        GzipDevice gzip(&buffer);
+        REQUIRE(gzip.open(QIODevice::WriteOnly));
+        gzip.write(first);
+        const int firstMemberSize = buffer.data().size();
+        CHECK(firstMemberSize > 0);
+        gzip.write(second);
+        gzip.close();
+
+        CHECK(gunzipMember(buffer.data().left(firstMemberSize), first) == first);
+        CHECK(gunzipMember(buffer.data().mid(firstMemberSize), second) == second);
+    }
+
+    SECTION("cannot be opened for reading")
+    {
+        GzipDevice gzip(&buffer);
+        CHECK_FALSE(gzip.open(QIODevice::ReadOnly));
+    }
+}
@@ -0,0 +1,77 @@
+#include "test/test_helpers.h"
+
+#include "file/DirectoryManifest.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThread>
+
+using namespace mediaelch;
+
+TEST_CASE("diffDirectoryTree", "[file]")
+{
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    const QString root = QDir::fromNativeSeparators(QDir::cleanPath(tempDir.path()));
+    QDir rootDir(root);
+    REQUIRE(rootDir.mkpath("Movies/Movie A"));
+    REQUIRE(rootDir.mkpath("Movies/Movie B"));
+
+    const DirectoryManifestDiff initial = diffDirectoryTree(root, {});
+
+    SECTION("all directories are changed if there is no manifest")
+    {
+        CHECK(initial.current.size() == 4);
+        CHECK(initial.changedDirs.size() == 4);
+        CHECK(initial.removedDirs.isEmpty());
+        CHECK(initial.current.contains(root + "/Movies/Movie A"));
+    }
+
+    SECTION("nothing changed")
+    {
+        const DirectoryManifestDiff diff = diffDirectoryTree(root, initial.current);
+        CHECK(diff.current.size() == 4);
+        CHECK_FALSE(diff.hasChanges());
+    }
+
+    SECTION("new and removed directories are detected")
+    {
+        // Some filesystems only have a timestamp resolution of a few milliseconds.
+        QThread::msleep(50);
+        REQUIRE(rootDir.mkpath("Movies/Movie C"));
+        REQUIRE(QDir(root + "/Movies/Movie B").removeRecursively());
+
+        const DirectoryManifestDiff diff = diffDirectoryTree(root, initial.current);
+        CHECK(diff.current.size() == 4);
+        CHECK(diff.changedDirs.contains(root + "/Movies"));
+        CHECK(diff.changedDirs.contains(root + "/Movies/Movie C"));
+        CHECK_FALSE(diff.changedDirs.contains(root + "/Movies/Movie A"));
+        CHECK(diff.removedDirs == QStringList{root + "/Movies/Movie B"});
+    }
+
+    SECTION("NFO and image files edited in place are detected")
+    {
+        const QString nfoPath = root + "/Movies/Movie A/movie.nfo";
+        QFile nfo(nfoPath);
+        REQUIRE(nfo.open(QFile::WriteOnly));
+        nfo.write("<movie><title>A</title></movie>");
+        nfo.close();
+        REQUIRE(QFile(root + "/Movies/Movie A/movie.mkv").open(QFile::WriteOnly));
+
+        const DirectoryManifestDiff before = diffDirectoryTree(root, initial.current);
+        CHECK(before.changedDirs == QStringList{root + "/Movies/Movie A"});
+        CHECK(before.current.value(root + "/Movies/Movie A").metadataFiles == QStringList{"movie.nfo"});
+        CHECK_FALSE(diffDirectoryTree(root, before.current).hasChanges());
+
+        // Same size, different content; the directory itself is unchanged.
+        QThread::msleep(50);
+        REQUIRE(nfo.open(QFile::ReadWrite));
+        nfo.write("<movie><title>B</title></movie>");
+        nfo.close();
+
+        const DirectoryManifestDiff after = diffDirectoryTree(root, before.current);
+        CHECK(after.changedDirs == QStringList{root + "/Movies/Movie A"});
+        CHECK(after.removedDirs.isEmpty());
+    }
+}
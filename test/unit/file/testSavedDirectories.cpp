@@ -0,0 +1,72 @@
+#include "test/test_helpers.h"
+
+#include "file/SavedDirectories.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThread>
+
+using namespace mediaelch;
+
+namespace {
+
+void writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    REQUIRE(file.open(QFile::WriteOnly));
+    file.write(content);
+}
+
+} // namespace
+
+TEST_CASE("SavedDirectories", "[file]")
+{
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    const QString root = QDir::fromNativeSeparators(QDir::cleanPath(tempDir.path()));
+    REQUIRE(QDir(root).mkpath("Movie A"));
+    REQUIRE(QDir(root).mkpath("Movie B"));
+    const QString movieA = root + "/Movie A";
+    const QString movieB = root + "/Movie B";
+
+    SavedDirectories::clear();
+
+    SECTION("unknown directories are kept")
+    {
+        CHECK(SavedDirectories::withoutOwnChanges({movieA, movieB}) == QStringList({movieA, movieB}));
+    }
+
+    SECTION("directories that were only changed by MediaElch are removed once")
+    {
+        writeFile(movieA + "/movie.nfo", "<movie/>");
+        SavedDirectories::add(movieA + "/movie.nfo");
+        writeFile(movieA + "/poster.jpg", "image");
+        SavedDirectories::add(movieA + "/poster.jpg");
+
+        CHECK(SavedDirectories::withoutOwnChanges({movieA, movieB}) == QStringList{movieB});
+        // Further changes are not caused by the saved item anymore.
+        CHECK(SavedDirectories::withoutOwnChanges({movieA}) == QStringList{movieA});
+    }
+
+    SECTION("changes made by others after saving are kept")
+    {
+        writeFile(movieA + "/movie.nfo", "<movie/>");
+        SavedDirectories::add(movieA + "/movie.nfo");
+
+        SECTION("new file")
+        {
+            // Some filesystems only have a timestamp resolution of a few milliseconds.
+            QThread::msleep(50);
+            writeFile(movieA + "/movie.mkv", "video");
+        }
+
+        SECTION("saved file edited in place")
+        {
+            QThread::msleep(50);
+            writeFile(movieA + "/movie.nfo", "<other>");
+        }
+
+        CHECK(SavedDirectories::withoutOwnChanges({movieA}) == QStringList{movieA});
+    }
+}
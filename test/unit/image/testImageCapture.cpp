@@ -0,0 +1,52 @@
+#include "test/test_helpers.h"
+
+#include "image/ImageCapture.h"
+
+using namespace mediaelch;
+
+TEST_CASE("ImageCapture seeks before opening the input", "[image]")
+{
+    const QStringList args = ImageCapture::ffmpegArguments(FilePath("/movies/Alien.mkv"), std::chrono::seconds(3725));
+
+    const int seek = args.indexOf("-ss");
+    const int input = args.indexOf("-i");
+    REQUIRE(seek >= 0);
+    REQUIRE(input > seek);
+    CHECK(args[seek + 1] == "3725");
+    CHECK(args.indexOf("-noaccurate_seek") < input);
+    // The frame is written to stdout instead of a temporary file.
+    CHECK(args.last() == "pipe:1");
+}
+
+TEST_CASE("ImageCapture scales captured images", "[image]")
+{
+    const QImage frame(1920, 1080, QImage::Format_RGB32);
+
+    SECTION("keeps the aspect ratio")
+    {
+        const QImage img = ImageCapture::scaleImage(frame, ThumbnailDimensions{400, 300}, false);
+        CHECK(img.width() == 400);
+        CHECK(img.height() == 225);
+    }
+
+    SECTION("crops from the center")
+    {
+        const QImage img = ImageCapture::scaleImage(frame, ThumbnailDimensions{400, 300}, true);
+        CHECK(img.width() == 400);
+        CHECK(img.height() == 300);
+    }
+
+    SECTION("does not scale if a dimension is 0")
+    {
+        const QImage img = ImageCapture::scaleImage(frame, ThumbnailDimensions{0, 300}, true);
+        CHECK(img.size() == frame.size());
+    }
+}
+
+TEST_CASE("ImageCapture picks a position inside the video", "[image]")
+{
+    CHECK(ImageCapture::randomPosition(std::chrono::seconds(0)).count() == 0);
+    for (int i = 0; i < 20; ++i) {
+        CHECK(ImageCapture::randomPosition(std::chrono::seconds(90)).count() < 90);
+    }
+}
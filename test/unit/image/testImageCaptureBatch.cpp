@@ -0,0 +1,34 @@
+#include "test/test_helpers.h"
+
+#include "image/ImageCaptureBatch.h"
+
+#include <QBuffer>
+#include <QImage>
+
+using namespace mediaelch;
+
+TEST_CASE("ImageCaptureBatch only uses images of successful ffmpeg processes", "[image]")
+{
+    QImage frame(320, 180, QImage::Format_RGB32);
+    frame.fill(Qt::darkGreen);
+    QByteArray jpeg;
+    QBuffer buffer(&jpeg);
+    REQUIRE(buffer.open(QIODevice::WriteOnly));
+    REQUIRE(frame.save(&buffer, "jpg"));
+    const QByteArray truncated = jpeg.left(jpeg.size() / 2);
+
+    CHECK(ImageCaptureBatch::hasImage(0, QProcess::NormalExit, jpeg));
+
+    SECTION("killed processes, e.g. after the timeout")
+    {
+        CHECK_FALSE(ImageCaptureBatch::hasImage(0, QProcess::CrashExit, truncated));
+        CHECK_FALSE(ImageCaptureBatch::hasImage(9, QProcess::CrashExit, truncated));
+        CHECK_FALSE(ImageCaptureBatch::hasImage(0, QProcess::CrashExit, jpeg));
+    }
+
+    SECTION("failed processes")
+    {
+        CHECK_FALSE(ImageCaptureBatch::hasImage(1, QProcess::NormalExit, truncated));
+        CHECK_FALSE(ImageCaptureBatch::hasImage(0, QProcess::NormalExit, QByteArray()));
+    }
+}
@@ -0,0 +1,97 @@
+#include "test/test_helpers.h"
+
+#include "data/Database.h"
+#include "media_centers/SaveJob.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QThread>
+
+using namespace mediaelch;
+
+namespace {
+
+QByteArray readFile(const QString& path)
+{
+    QFile file(path);
+    REQUIRE(file.open(QFile::ReadOnly));
+    return file.readAll();
+}
+
+void writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    REQUIRE(file.open(QFile::WriteOnly));
+    file.write(content);
+}
+
+} // namespace
+
+TEST_CASE("SaveJob finds numbers of extra fanarts", "[media_centers]")
+{
+    CHECK(SaveJob::extraFanartNumbers({}).isEmpty());
+    CHECK(SaveJob::extraFanartNumbers({"fanart1.jpg", "fanart3.jpg", "Fanart10.JPG"}) == QSet<int>{1, 3, 10});
+    CHECK(SaveJob::extraFanartNumbers({"fanart.jpg", "fanartx.jpg", "fanart0.jpg", "fanart2.png"}).isEmpty());
+    CHECK(SaveJob::extraFanartNumbers({"poster.jpg", "fanart2.jpg"}) == QSet<int>{2});
+}
+
+TEST_CASE("SaveJob only writes changed files", "[media_centers]")
+{
+    // Do not touch the user's cache database.
+    QStandardPaths::setTestModeEnabled(true);
+    Database database;
+
+    QTemporaryDir tempDir;
+    REQUIRE(tempDir.isValid());
+    const QString nfoPath = tempDir.path() + "/movie.nfo";
+    const QByteArray content = "<movie><title>A</title></movie>";
+
+    SaveJob job("Movie A");
+    job.writeNfo(nfoPath, content);
+    REQUIRE(job.run(database));
+    REQUIRE(readFile(nfoPath) == content);
+    const QDateTime written = QFileInfo(nfoPath).lastModified();
+
+    // Some filesystems only have a timestamp resolution of a few milliseconds.
+    QThread::msleep(50);
+
+    SECTION("unchanged files are not written again")
+    {
+        REQUIRE(job.run(database));
+        CHECK(QFileInfo(nfoPath).lastModified() == written);
+        CHECK(readFile(nfoPath) == content);
+    }
+
+    SECTION("files changed on disk are written again")
+    {
+        writeFile(nfoPath, "<movie><title>Changed by another tool</title></movie>");
+        REQUIRE(job.run(database));
+        CHECK(readFile(nfoPath) == content);
+    }
+
+    SECTION("files with the same size but a different content are written again")
+    {
+        const QByteArray sameSize = "<movie><title>B</title></movie>";
+        REQUIRE(sameSize.size() == content.size());
+        writeFile(nfoPath, sameSize);
+        REQUIRE(job.run(database));
+        CHECK(readFile(nfoPath) == content);
+    }
+
+    SECTION("files that already have the content are not written")
+    {
+        // E.g. written by another MediaElch installation; the hash is not in the database.
+        const QString otherPath = tempDir.path() + "/other.nfo";
+        writeFile(otherPath, content);
+        const QDateTime otherWritten = QFileInfo(otherPath).lastModified();
+        QThread::msleep(50);
+
+        SaveJob otherJob("Movie B");
+        otherJob.writeNfo(otherPath, content);
+        REQUIRE(otherJob.run(database));
+        CHECK(QFileInfo(otherPath).lastModified() == otherWritten);
+    }
+}
@@ -0,0 +1,79 @@
+#include "test/test_helpers.h"
+
+#include "movies/Movie.h"
+#include "movies/MovieDuplicateIndex.h"
+
+static void setMovie(Movie& movie, const QString& title, int year, const QString& imdbId = {})
+{
+    movie.setName(title);
+    movie.setReleased(QDate(year, 1, 1));
+    movie.setImdbId(ImdbId(imdbId));
+}
+
+TEST_CASE("MovieDuplicateIndex normalizes titles", "[movie][duplicates]")
+{
+    CHECK(MovieDuplicateIndex::normalizedTitle("Amélie") == "amelie");
+    CHECK(MovieDuplicateIndex::normalizedTitle("Alien: Covenant") == "aliencovenant");
+    CHECK(MovieDuplicateIndex::normalizedTitle("  WALL·E ") == "walle");
+    CHECK(MovieDuplicateIndex::normalizedTitle("...") == "...");
+
+    CHECK(MovieDuplicateIndex::titleKey("", 2000).isEmpty());
+    CHECK(MovieDuplicateIndex::titleKey("Alien", 1979) == MovieDuplicateIndex::titleKey("alien", 1979));
+    CHECK(MovieDuplicateIndex::titleKey("Alien", 1979) != MovieDuplicateIndex::titleKey("Alien", 1980));
+}
+
+TEST_CASE("MovieDuplicateIndex groups movies", "[movie][duplicates]")
+{
+    Movie alien;
+    Movie alienCopy;
+    Movie alienByImdbId;
+    Movie toyStory;
+    setMovie(alien, "Alien", 1979, "tt0078748");
+    setMovie(alienCopy, "alien", 1979);
+    setMovie(alienByImdbId, "Alien (Director's Cut)", 2003, "tt0078748");
+    setMovie(toyStory, "Toy Story", 1995, "tt0114709");
+
+    SECTION("built in one pass")
+    {
+        const QVector<MovieDuplicateIndex::MovieData> data{MovieDuplicateIndex::movieData(alien),
+            MovieDuplicateIndex::movieData(alienCopy),
+            MovieDuplicateIndex::movieData(alienByImdbId),
+            MovieDuplicateIndex::movieData(toyStory)};
+        const auto groups = MovieDuplicateIndex::buildIndex(data);
+
+        CHECK(groups.keys.size() == 4);
+        CHECK(groups.byImdbId.value("tt0078748") == QVector<Movie*>{&alien, &alienByImdbId});
+        CHECK(groups.byTitle.value(MovieDuplicateIndex::titleKey("Alien", 1979)) == QVector<Movie*>{&alien, &alienCopy});
+        CHECK(groups.byImdbId.value("tt0114709") == QVector<Movie*>{&toyStory});
+    }
+
+    SECTION("updated incrementally")
+    {
+        MovieDuplicateIndex index;
+        index.addMovie(&alien);
+        index.addMovie(&alienCopy);
+        index.addMovie(&alienByImdbId);
+        index.addMovie(&toyStory);
+
+        CHECK(alien.hasDuplicates());
+        CHECK(alienCopy.hasDuplicates());
+        CHECK(alienByImdbId.hasDuplicates());
+        CHECK_FALSE(toyStory.hasDuplicates());
+        CHECK(index.duplicatesOf(&alien) == QVector<Movie*>{&alien, &alienByImdbId, &alienCopy});
+        // Duplicates are not transitive.
+        CHECK(index.duplicatesOf(&alienCopy) == QVector<Movie*>{&alienCopy, &alien});
+
+        setMovie(alienCopy, "Toy Story", 1995);
+        index.updateMovie(&alienCopy);
+        CHECK(alienCopy.hasDuplicates());
+        CHECK(toyStory.hasDuplicates());
+        CHECK(index.duplicatesOf(&toyStory) == QVector<Movie*>{&toyStory, &alienCopy});
+
+        index.removeMovie(&alienCopy);
+        CHECK_FALSE(toyStory.hasDuplicates());
+        CHECK(index.duplicatesOf(&toyStory) == QVector<Movie*>{&toyStory});
+
+        index.removeMovie(&alienByImdbId);
+        CHECK_FALSE(alien.hasDuplicates());
+    }
+}
@@ -0,0 +1,91 @@
+#include "test/test_helpers.h"
+
+#include "network/DownloadScheduler.h"
+#include "network/NetworkManager.h"
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <memory>
+
+using namespace mediaelch::network;
+
+static QUrl createFile(const QTemporaryDir& dir, const QString& name)
+{
+    const QString path = dir.filePath(name);
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write(name.toUtf8());
+    return QUrl::fromLocalFile(path);
+}
+
+TEST_CASE("DownloadScheduler downloads files", "[network][download]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QUrl a = createFile(dir, "a.jpg");
+    const QUrl b = createFile(dir, "b.jpg");
+    const QUrl c = createFile(dir, "c.jpg");
+
+    NetworkManager network;
+    DownloadScheduler scheduler(&network);
+    QSignalSpy idleSpy(&scheduler, &DownloadScheduler::sigIdle);
+    QObject client;
+    QStringList finished;
+
+    const auto onFinished = [&finished](DownloadScheduler::Id, const DownloadScheduler::Result& result) {
+        finished << QString::fromUtf8(result.data);
+    };
+
+    SECTION("identical URLs are downloaded once")
+    {
+        QObject otherClient;
+        scheduler.enqueue(a, DownloadScheduler::Priority::Normal, &client, onFinished);
+        scheduler.enqueue(a, DownloadScheduler::Priority::Bulk, &otherClient, onFinished);
+        CHECK(scheduler.queuedCount() + scheduler.runningCount() == 1);
+
+        REQUIRE(idleSpy.wait());
+        CHECK(finished == QStringList({"a.jpg", "a.jpg"}));
+    }
+
+    SECTION("downloads are started by priority")
+    {
+        scheduler.setMaxParallelDownloads(1);
+        scheduler.enqueue(a, DownloadScheduler::Priority::Normal, &client, onFinished);
+        scheduler.enqueue(b, DownloadScheduler::Priority::Bulk, &client, onFinished);
+        scheduler.enqueue(c, DownloadScheduler::Priority::Visible, &client, onFinished);
+        CHECK(scheduler.runningCount() == 1);
+        CHECK(scheduler.queuedCount() == 2);
+
+        REQUIRE(idleSpy.wait());
+        CHECK(finished == QStringList({"a.jpg", "c.jpg", "b.jpg"}));
+    }
+
+    SECTION("priorities of queued downloads can be changed")
+    {
+        QObject otherClient;
+        scheduler.setMaxParallelDownloads(1);
+        scheduler.enqueue(a, DownloadScheduler::Priority::Normal, &client, onFinished);
+        scheduler.enqueue(b, DownloadScheduler::Priority::Normal, &client, onFinished);
+        scheduler.enqueue(c, DownloadScheduler::Priority::Normal, &otherClient, onFinished);
+        scheduler.setPriority(&otherClient, DownloadScheduler::Priority::Visible);
+
+        REQUIRE(idleSpy.wait());
+        CHECK(finished == QStringList({"a.jpg", "c.jpg", "b.jpg"}));
+    }
+
+    SECTION("downloads of destroyed clients are cancelled")
+    {
+        auto otherClient = std::make_unique<QObject>();
+        scheduler.setMaxParallelDownloads(1);
+        scheduler.enqueue(a, DownloadScheduler::Priority::Normal, &client, onFinished);
+        scheduler.enqueue(b, DownloadScheduler::Priority::Normal, otherClient.get(), onFinished);
+        scheduler.enqueue(c, DownloadScheduler::Priority::Normal, &client, onFinished);
+        otherClient.reset();
+        CHECK(scheduler.queuedCount() == 1);
+
+        REQUIRE(idleSpy.wait());
+        CHECK(finished == QStringList({"a.jpg", "c.jpg"}));
+    }
+}
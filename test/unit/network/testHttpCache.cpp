@@ -0,0 +1,96 @@
+#include "test/test_helpers.h"
+
+#include "network/HttpCache.h"
+
+#include <QTemporaryDir>
+#include <memory>
+
+using namespace mediaelch::network;
+
+TEST_CASE("HttpCache keys", "[network][cache]")
+{
+    const QUrl url("https://www.imdb.com/title/tt0111161/");
+
+    SECTION("requests without Accept-Language are stored by URL")
+    {
+        CHECK(HttpCache::cacheKey(QNetworkRequest(url)).isEmpty());
+        CHECK(HttpCache::cacheUrl(url, QString()) == url);
+    }
+
+    SECTION("the language is part of the key")
+    {
+        QNetworkRequest request(url);
+        request.setRawHeader("Accept-Language", "de-DE");
+        const QString key = HttpCache::cacheKey(request);
+        CHECK(key == "lang=de-DE");
+        CHECK(HttpCache::cacheUrl(url, key) != url);
+        CHECK(HttpCache::cacheUrl(url, key) != HttpCache::cacheUrl(url, "lang=en-US"));
+        CHECK_FALSE(HttpCache::cacheUrl(url, key).hasFragment());
+        // The request itself is not changed.
+        CHECK(request.url() == url);
+    }
+}
+
+TEST_CASE("HttpCache time to live", "[network][cache]")
+{
+    QNetworkCacheMetaData metaData;
+    metaData.setSaveToDisk(true);
+    metaData.setRawHeaders({{"Cache-Control", "no-cache, private, max-age=0"}});
+
+    SECTION("known providers are cached without revalidation")
+    {
+        metaData.setUrl(QUrl("https://api.themoviedb.org/3/movie/1"));
+        const QNetworkCacheMetaData result = HttpCache::withTimeToLive(metaData);
+        CHECK(result.expirationDate() > QDateTime::currentDateTimeUtc().addSecs(3600));
+        CHECK(result.rawHeaders().first().second == "private");
+    }
+
+    SECTION("other hosts keep the server's headers")
+    {
+        metaData.setUrl(QUrl("https://example.com/"));
+        const QNetworkCacheMetaData result = HttpCache::withTimeToLive(metaData);
+        CHECK_FALSE(result.expirationDate().isValid());
+        CHECK(result.rawHeaders() == metaData.rawHeaders());
+    }
+}
+
+TEST_CASE("HttpCache stores responses per key", "[network][cache]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    HttpCache::setDirectory(dir.path());
+    HttpCache german("lang=de");
+    HttpCache english("lang=en");
+    HttpCache plain;
+
+    const QUrl url("https://www.imdb.com/title/tt0111161/");
+
+    QNetworkCacheMetaData metaData;
+    metaData.setUrl(url);
+    metaData.setSaveToDisk(true);
+    QIODevice* device = german.prepare(metaData);
+    REQUIRE(device != nullptr);
+    device->write("Die Verurteilten");
+    german.insert(device);
+
+    CHECK(german.metaData(url).isValid());
+    CHECK(german.metaData(url).url() == url);
+    CHECK_FALSE(english.metaData(url).isValid());
+    CHECK_FALSE(plain.metaData(url).isValid());
+
+    std::unique_ptr<QIODevice> data(german.data(url));
+    REQUIRE(data != nullptr);
+    CHECK(data->readAll() == "Die Verurteilten");
+
+    SECTION("all caches share one index")
+    {
+        HttpCache otherThreadsCache("lang=de");
+        CHECK(otherThreadsCache.metaData(url).isValid());
+        CHECK(otherThreadsCache.cacheSize() == german.cacheSize());
+
+        CHECK(otherThreadsCache.remove(url));
+        CHECK_FALSE(german.metaData(url).isValid());
+    }
+
+    HttpCache::setDirectory(QString());
+}
@@ -0,0 +1,43 @@
+#include "test/test_helpers.h"
+
+#include "network/ImagePreviewDownloader.h"
+
+#include <QBuffer>
+
+using namespace mediaelch::network;
+
+static QByteArray encodedImage(int width, int height, const char* format)
+{
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    QByteArray data;
+    QBuffer buffer(&data);
+    image.save(&buffer, format);
+    return data;
+}
+
+TEST_CASE("ImagePreviewDownloader decodes images", "[network]")
+{
+    SECTION("wide images are scaled down")
+    {
+        const QImage image = ImagePreviewDownloader::decodeImage(encodedImage(400, 200, "PNG"), 100);
+        CHECK(image.size() == QSize(100, 50));
+    }
+
+    SECTION("small images are kept")
+    {
+        const QImage image = ImagePreviewDownloader::decodeImage(encodedImage(80, 120, "JPG"), 100);
+        CHECK(image.size() == QSize(80, 120));
+    }
+
+    SECTION("no maximum width")
+    {
+        const QImage image = ImagePreviewDownloader::decodeImage(encodedImage(400, 200, "PNG"), 0);
+        CHECK(image.size() == QSize(400, 200));
+    }
+
+    SECTION("invalid data")
+    {
+        CHECK(ImagePreviewDownloader::decodeImage("no image", 100).isNull());
+    }
+}
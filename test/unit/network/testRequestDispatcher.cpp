@@ -0,0 +1,71 @@
+#include "test/test_helpers.h"
+
+#include "network/HttpCache.h"
+#include "network/NetworkManager.h"
+#include "network/RequestDispatcher.h"
+
+#include <memory>
+
+using namespace mediaelch::network;
+
+TEST_CASE("RequestDispatcher shares connections", "[network]")
+{
+    RequestDispatcher& dispatcher = RequestDispatcher::instance();
+    CHECK(dispatcher.threadManager() == dispatcher.threadManager());
+}
+
+TEST_CASE("RequestDispatcher keeps the URL of requests with Accept-Language", "[network]")
+{
+    RequestDispatcher& dispatcher = RequestDispatcher::instance();
+    QNetworkRequest request(QUrl("http://127.0.0.1:1/title/tt0111161/"));
+    request.setRawHeader("Accept-Language", "de-DE");
+
+    std::unique_ptr<QNetworkReply> reply(dispatcher.get(request, QNetworkRequest::NormalPriority));
+    REQUIRE(reply != nullptr);
+    // Scrapers compare reply->url() with the URLs they requested.
+    CHECK(reply->url() == request.url());
+    CHECK(reply->request().url() == request.url());
+
+    // Responses are cached per language by the cache of the reply's manager.
+    auto* cache = dynamic_cast<HttpCache*>(reply->manager()->cache());
+    REQUIRE(cache != nullptr);
+    CHECK(cache->cacheKey() == "lang=de-DE");
+    CHECK(reply->manager() != dispatcher.threadManager());
+    reply->abort();
+}
+
+TEST_CASE("RequestDispatcher statistics", "[network]")
+{
+    RequestDispatcher& dispatcher = RequestDispatcher::instance();
+    dispatcher.resetStatistics();
+
+    dispatcher.addToStatistics("api.tvmaze.com", 100, 500, 2000, false, false);
+    dispatcher.addToStatistics("api.tvmaze.com", 300, 1500, 6000, true, false);
+    dispatcher.addToStatistics("api.tvmaze.com", 0, 0, 4000, false, true);
+
+    const auto statistics = dispatcher.statistics();
+    REQUIRE(statistics.contains("api.tvmaze.com"));
+    const RequestDispatcher::HostStatistics& tvmaze = statistics["api.tvmaze.com"];
+    CHECK(tvmaze.requestCount == 3);
+    CHECK(tvmaze.errorCount == 1);
+    CHECK(tvmaze.cacheHits == 1);
+    CHECK(tvmaze.networkBytes == 8000);
+    CHECK(tvmaze.cachedBytes == 4000);
+    // Cache hits are neither part of the latency nor of the throughput.
+    CHECK(tvmaze.averageLatencyMs() == Approx(200.0));
+    CHECK(tvmaze.bytesPerSecond() == Approx(4000.0));
+
+    CHECK(RequestDispatcher::HostStatistics{}.averageLatencyMs() == Approx(0.0));
+    CHECK(RequestDispatcher::HostStatistics{}.bytesPerSecond() == Approx(0.0));
+
+    dispatcher.resetStatistics();
+    CHECK(dispatcher.statistics().isEmpty());
+}
+
+TEST_CASE("NetworkManager priority", "[network]")
+{
+    NetworkManager network;
+    CHECK(network.priority() == QNetworkRequest::NormalPriority);
+    network.setPriority(QNetworkRequest::LowPriority);
+    CHECK(network.priority() == QNetworkRequest::LowPriority);
+}
@@ -0,0 +1,135 @@
+#include "test/test_helpers.h"
+
+#include "network/HostBackoff.h"
+#include "scrapers/ScrapeScheduler.h"
+#include "scrapers/movie/custom/CustomMovieScraper.h"
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+
+#include <QCoreApplication>
+#include <QSignalSpy>
+#include <QVector>
+
+using namespace mediaelch::scraper;
+using namespace std::chrono_literals;
+
+TEST_CASE("ScrapeScheduler limits", "[scraper][scheduler]")
+{
+    SECTION("combining limits uses the stricter values")
+    {
+        const auto tmdb = ScrapeScheduler::limitsForScraper(TmdbMovie::ID);
+        const auto imdb = ScrapeScheduler::limitsForScraper(ImdbMovie::ID);
+        const auto combined = ScrapeScheduler::combine(tmdb, imdb);
+
+        CHECK(combined.maxParallelItems == std::min(tmdb.maxParallelItems, imdb.maxParallelItems));
+        CHECK(combined.minInterval == std::max(tmdb.minInterval, imdb.minInterval));
+        CHECK(combined.hosts.size() == tmdb.hosts.size() + imdb.hosts.size());
+    }
+
+    SECTION("custom scrapers are limited by all hosts")
+    {
+        const auto custom = ScrapeScheduler::limitsForScraper(CustomMovieScraper::ID);
+        CHECK(custom.hosts.isEmpty());
+        CHECK(custom.maxParallelItems <= ScrapeScheduler::limitsForScraper(ImdbMovie::ID).maxParallelItems);
+    }
+}
+
+TEST_CASE("ScrapeScheduler runs items", "[scraper][scheduler]")
+{
+    mediaelch::network::HostBackoff::instance().clear();
+
+    ScrapeScheduler scheduler;
+    ScrapeScheduler::Limits limits;
+    limits.maxParallelItems = 2;
+    limits.minInterval = 0ms;
+    scheduler.setLimits(limits);
+
+    QVector<int> started;
+    QSignalSpy finishedSpy(&scheduler, &ScrapeScheduler::sigFinished);
+
+    SECTION("no more items than allowed run at the same time")
+    {
+        scheduler.start(5, [&](int index) {
+            started << index;
+            return true;
+        });
+        CHECK(started == QVector<int>{0, 1});
+
+        scheduler.finishItem(1);
+        // Starting the next item is deferred.
+        CHECK(started.size() == 2);
+        QCoreApplication::processEvents();
+        CHECK(started == QVector<int>{0, 1, 2});
+
+        scheduler.finishItem(0);
+        scheduler.finishItem(2);
+        QCoreApplication::processEvents();
+        CHECK(started == QVector<int>{0, 1, 2, 3, 4});
+        CHECK(finishedSpy.isEmpty());
+
+        scheduler.finishItem(3);
+        scheduler.finishItem(4);
+        QCoreApplication::processEvents();
+        CHECK(finishedSpy.count() == 1);
+        CHECK(scheduler.finishedCount() == 5);
+    }
+
+    SECTION("skipped items are finished immediately")
+    {
+        scheduler.start(4, [&](int index) {
+            started << index;
+            return index == 3;
+        });
+        CHECK(started == QVector<int>{0, 1, 2, 3});
+        CHECK(scheduler.runningItems() == QSet<int>{3});
+        CHECK(scheduler.finishedCount() == 3);
+    }
+
+    SECTION("cancelled schedulers do not start further items")
+    {
+        scheduler.start(3, [&](int index) {
+            started << index;
+            return true;
+        });
+        scheduler.cancel();
+        scheduler.finishItem(0);
+        QCoreApplication::processEvents();
+        CHECK(started == QVector<int>{0, 1});
+        CHECK(finishedSpy.isEmpty());
+    }
+}
+
+TEST_CASE("HostBackoff", "[network][scheduler]")
+{
+    using mediaelch::network::HostBackoff;
+
+    SECTION("Retry-After is parsed")
+    {
+        CHECK(HostBackoff::parseRetryAfter("120") == 120000ms);
+        CHECK(HostBackoff::parseRetryAfter("") == 0ms);
+        CHECK(HostBackoff::parseRetryAfter("invalid") == 0ms);
+    }
+
+    SECTION("only the reported host is backed off")
+    {
+        HostBackoff backoff;
+        backoff.reportTooManyRequests("api.example.com", 10000ms);
+
+        CHECK(backoff.remaining({"api.example.com"}) > 9000ms);
+        CHECK(backoff.remaining({"other.example.com"}) == 0ms);
+        CHECK(backoff.remaining() > 9000ms);
+    }
+
+    SECTION("delay doubles without Retry-After")
+    {
+        HostBackoff backoff;
+        backoff.reportTooManyRequests("api.example.com", 0ms);
+        const auto first = backoff.remaining();
+        backoff.reportTooManyRequests("api.example.com", 0ms);
+        const auto second = backoff.remaining();
+
+        CHECK(first <= HostBackoff::INITIAL_DELAY);
+        CHECK(second > HostBackoff::INITIAL_DELAY);
+        CHECK(second <= HostBackoff::MAX_DELAY);
+    }
+}
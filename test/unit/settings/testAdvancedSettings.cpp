@@ -29,6 +29,8 @@ TEST_CASE("Advanced Settings XML", "[settings]")
         CHECK(settings.forceCache() == defaults.forceCache());
         CHECK(settings.portableMode() == defaults.portableMode());
         CHECK(settings.episodeThumbnailDimensions() == defaults.episodeThumbnailDimensions());
+        CHECK(settings.maxParallelDirectoryScans() == defaults.maxParallelDirectoryScans());
+        CHECK(settings.watchLibrary() == defaults.watchLibrary());
         CHECK(messages.isEmpty());
     }
 
@@ -122,6 +124,20 @@ TEST_CASE("Advanced Settings XML", "[settings]")
         }
     }
 
+    SECTION("xml with invalid content: maxParallelDirectoryScans")
+    {
+        QString xml = addBaseXml(R"xml(
+            <maxParallelDirectoryScans>0</maxParallelDirectoryScans>
+        )xml");
+
+        const auto pair = AdvancedSettingsXmlReader::loadFromXml(xml);
+
+        CHECK(pair.first.maxParallelDirectoryScans() == AdvancedSettings().maxParallelDirectoryScans());
+        REQUIRE(pair.second.size() == 1);
+        CHECK(pair.second[0].type == AdvancedSettingsXmlReader::ParseErrorType::InvalidValue);
+        CHECK(pair.second[0].tag == "maxParallelDirectoryScans");
+    }
+
     SECTION("exclude patterns")
     {
         SECTION("invalid attribute value")
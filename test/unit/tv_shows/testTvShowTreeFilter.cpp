@@ -0,0 +1,73 @@
+#include "test/test_helpers.h"
+
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowModel.h"
+#include "tv_shows/TvShowTreeFilter.h"
+#include "tv_shows/model/EpisodeModelItem.h"
+#include "tv_shows/model/SeasonModelItem.h"
+#include "tv_shows/model/TvShowModelItem.h"
+
+static void addEpisode(TvShow& show, int season, int episode, const QString& title)
+{
+    auto* item = new TvShowEpisode({}, &show);
+    item->setSeason(SeasonNumber(season));
+    item->setEpisode(EpisodeNumber(episode));
+    item->setTitle(title);
+    show.addEpisode(item);
+}
+
+TEST_CASE("TvShowTreeFilter matches terms", "[tv][filter]")
+{
+    TvShowTreeFilter filter({"office", "", "S02", "office"});
+    CHECK(filter.terms() == QStringList{"office", "S02"});
+    CHECK(filter.matches("The Office") == 0b01);
+    CHECK(filter.matches("S02E01 The Office") == 0b11);
+    CHECK(filter.matches("Parks and Recreation") == 0);
+
+    CHECK(TvShowTreeFilter().isEmpty());
+    CHECK(TvShowTreeFilter::fromFilters({}, "").isEmpty());
+    CHECK(TvShowTreeFilter::fromFilters({}, "pilot").terms() == QStringList{"pilot"});
+}
+
+TEST_CASE("TvShowTreeFilter propagates acceptance", "[tv][filter]")
+{
+    TvShow show;
+    show.setTitle("The Office");
+    addEpisode(show, 1, 1, "Pilot");
+    addEpisode(show, 1, 2, "Diversity Day");
+    addEpisode(show, 2, 1, "The Dundies");
+
+    TvShowModel model;
+    model.appendShow(&show);
+    const auto& showItem = dynamic_cast<const TvShowModelItem&>(model.getItem(model.index(0, 0)));
+    REQUIRE(showItem.seasons().size() == 2);
+    const SeasonModelItem* season1 = showItem.seasons().at(0);
+    const SeasonModelItem* season2 = showItem.seasons().at(1);
+    const EpisodeModelItem* pilot = season1->episodes().at(0);
+    const EpisodeModelItem* diversityDay = season1->episodes().at(1);
+    const EpisodeModelItem* dundies = season2->episodes().at(0);
+
+    SECTION("show accepts all children")
+    {
+        const auto accepted = TvShowTreeFilter({"office"}).acceptedItems(showItem);
+        CHECK(accepted.size() == 6);
+    }
+
+    SECTION("episode accepts its parents")
+    {
+        const auto accepted = TvShowTreeFilter({"pilot"}).acceptedItems(showItem);
+        CHECK(accepted == QSet<const TvShowBaseModelItem*>{&showItem, season1, pilot});
+    }
+
+    SECTION("terms may be matched by parents")
+    {
+        const auto accepted = TvShowTreeFilter({"office", "dundies"}).acceptedItems(showItem);
+        CHECK(accepted == QSet<const TvShowBaseModelItem*>{&showItem, season2, dundies});
+        CHECK_FALSE(accepted.contains(diversityDay));
+    }
+
+    SECTION("nothing matches")
+    {
+        CHECK(TvShowTreeFilter({"pilot", "dundies"}).acceptedItems(showItem).isEmpty());
+    }
+}